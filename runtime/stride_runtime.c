@@ -0,0 +1,86 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+/*
+ * The runtime that native code calls into, for the operations the compiler
+ * doesn't generate inline. Objects that are compiled with the native or the C
+ * backend are linked against this library. The interpreter implements the same
+ * functions as builtins, in src/vm/Runtime.cpp, which they must stay in sync with.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Allocates zeroed memory for an object.
+ * Zero-sized objects still get a distinct address.
+ * The program is aborted if there is no memory left.
+ */
+void *__stride_allocate(uint64_t size)
+{
+    void *object = calloc(1, size == 0 ? 1 : size);
+    if ( object == NULL )
+    {
+        fputs("stride: out of memory\n", stderr);
+        abort();
+    }
+    return object;
+}
+
+/**
+ * Allocates an array of zeroed elements.
+ * @return The descriptor of the array, which refers to the elements at offset 0
+ *         and holds the length at offset 8.
+ */
+void *__stride_allocate_array(uint64_t length, uint64_t elementSize)
+{
+    uint64_t *descriptor = __stride_allocate(16);
+    descriptor[ 0 ] = (uint64_t) (uintptr_t) __stride_allocate(length * elementSize);
+    descriptor[ 1 ] = length;
+    return descriptor;
+}
+
+/**
+ * Returns a newly allocated string with the contents of both strings.
+ */
+char *__stride_string_concat(const char *left, const char *right)
+{
+    size_t leftLength = strlen(left);
+    size_t rightLength = strlen(right);
+    char *result = __stride_allocate(leftLength + rightLength + 1);
+    memcpy(result, left, leftLength);
+    memcpy(result + leftLength, right, rightLength);
+    return result;
+}
+
+/**
+ * Compares two strings by their contents.
+ * @return A negative value, zero or a positive value if the left string orders
+ *         before, the same as or after the right string.
+ */
+int32_t __stride_string_compare(const char *left, const char *right)
+{
+    return (int32_t) strcmp(left, right);
+}
+
+/**
+ * Raises an integer to a power, by squaring. The result wraps around in 64 bits.
+ * Negative exponents yield 1.
+ */
+int64_t __stride_power(int64_t base, int64_t exponent)
+{
+    uint64_t factor = (uint64_t) base;
+    uint64_t result = 1;
+    for ( ; exponent > 0; exponent >>= 1 )
+    {
+        if ( exponent & 1 )
+        {
+            result *= factor;
+        }
+        factor *= factor;
+    }
+    return (int64_t) result;
+}
@@ -0,0 +1,95 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <cctype>
+#include <cstdlib>
+#include "CompilerOptions.h"
+
+bool stride::parseCompilerOption(const std::string &option, std::string &flag,
+                                 std::variant<std::string, long int> &value)
+{
+    // '-O<level>' is short for '--optimize=<level>', and '-O' for '--optimize=1'.
+    if ( option.rfind("-O", 0) == 0 )
+    {
+        std::string level = option.substr(2);
+        if ( level.size() > 1 || ( !level.empty() && !isdigit(level[ 0 ])))
+        {
+            return false;
+        }
+        flag = "optimize";
+        value = level.empty() ? 1L : (long int) ( level[ 0 ] - '0' );
+        return true;
+    }
+
+    if ( option.rfind("--", 0) != 0 || option.size() == 2 )
+    {
+        return false;
+    }
+
+    size_t separator = option.find('=');
+    flag = option.substr(2, separator == std::string::npos ? std::string::npos : separator - 2);
+
+    if ( separator == std::string::npos )
+    {
+        value = 1L;
+        return true;
+    }
+
+    std::string text = option.substr(separator + 1);
+    char *end;
+    long int numericValue = strtol(text.c_str(), &end, 10);
+    if ( !text.empty() && *end == '\0' )
+    {
+        value = numericValue;
+    }
+    else
+    {
+        value = text;
+    }
+    return true;
+}
+
+bool stride::applyCompilerOptions(StrideFile &file, const std::vector<std::string> &options, std::ostream &err)
+{
+    for ( auto &option: options )
+    {
+        std::string flag;
+        std::variant<std::string, long int> value;
+        if ( !parseCompilerOption(option, flag, value))
+        {
+            err << "Unknown option: " << option << std::endl;
+            return false;
+        }
+        file.setCompilerFlag(flag, value);
+    }
+    return true;
+}
+
+bool stride::extractOption(std::vector<std::string> &arguments, const std::string &name, std::string &value)
+{
+    for ( auto argument = arguments.begin(); argument != arguments.end(); argument++ )
+    {
+        if ( argument->rfind("--" + name, 0) != 0 )
+        {
+            continue;
+        }
+
+        size_t nameEnd = 2 + name.size();
+        if ( argument->size() == nameEnd )
+        {
+            value.clear();
+        }
+        else if ( ( *argument )[ nameEnd ] == '=' )
+        {
+            value = argument->substr(nameEnd + 1);
+        }
+        else
+        {
+            continue;
+        }
+        arguments.erase(argument);
+        return true;
+    }
+    return false;
+}
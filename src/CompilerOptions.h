@@ -0,0 +1,42 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_COMPILEROPTIONS_H
+#define STRIDE_LANGUAGE_COMPILEROPTIONS_H
+
+#include <ostream>
+#include <string>
+#include <variant>
+#include <vector>
+#include "StrideFile.h"
+
+namespace stride
+{
+
+    /**
+     * Parses a single command line option.
+     * Options are provided as '--flag' or '--flag=value'. Flags without a value
+     * are set to 1, numeric values are stored as numbers, and all other values as strings.
+     * The optimization level is provided as '-O0' to '-O3', and stored as the 'optimize' flag.
+     * @return Whether the option is well-formed.
+     */
+    bool parseCompilerOption(const std::string &option, std::string &flag, std::variant<std::string, long int> &value);
+
+    /**
+     * Applies the provided options to a file, as compiler flags.
+     * Malformed options are reported to the provided stream.
+     * @return Whether all options were applied.
+     */
+    bool applyCompilerOptions(StrideFile &file, const std::vector<std::string> &options, std::ostream &err);
+
+    /**
+     * Removes an option from a list of command line arguments.
+     * @param name The name of the option, without leading dashes.
+     * @param value Set to the value of the option, if it has one.
+     * @return Whether the option was present.
+     */
+    bool extractOption(std::vector<std::string> &arguments, const std::string &name, std::string &value);
+}
+
+#endif //STRIDE_LANGUAGE_COMPILEROPTIONS_H
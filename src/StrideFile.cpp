@@ -5,7 +5,24 @@
 #include "StrideFile.h"
 #include "tokens/tokenizer.h"
 #include "syntax_tree/ASTNodes.h"
+#include "syntax_tree/ASTSerializer.h"
+#include "backend/CodeGenerator.h"
+#include "backend/CSourceGenerator.h"
+#include "cache/CompilationCache.h"
+#include "ir/IRGenerator.h"
+#include "ir/PassManager.h"
+#include "passes/ConstantFolding.h"
+#include "passes/SwitchLowering.h"
+#include "semantic/NameResolver.h"
+#include "semantic/LayoutEngine.h"
+#include "semantic/Monomorphizer.h"
+#include "semantic/TypeChecker.h"
+#include "vm/BytecodeCompiler.h"
+#include "vm/BytecodeSerializer.h"
+#include <algorithm>
+#include <cstdlib>
 #include <fstream>
+#include <iterator>
 #include <iostream>
 
 using namespace stride;
@@ -16,28 +33,485 @@ StrideFile::StrideFile(const char *path)
     std::ifstream file_in(*this->filePath);
     this->content = new std::string(( std::istreambuf_iterator<char>(file_in)),
                                     ( std::istreambuf_iterator<char>()));
+    this->diagnosticEngine = new error::DiagnosticEngine(this);
+    this->compilationCache = nullptr;
+    this->ownedCache = nullptr;
+    this->syntaxTree = nullptr;
+    this->bytecode = nullptr;
+    this->interpreting = false;
+    this->outputKey = 0;
 }
 
-void StrideFile::compile()
+cache::CompilationCache *StrideFile::getCompilationCache()
 {
-    std::string output_file_path = this->filePath->substr(0, this->filePath->find_last_of('.')).append(".asm");
+    if ( this->compilationCache != nullptr )
+    {
+        return this->compilationCache;
+    }
 
-    std::cout << "Compiling file \"" << this->filePath->c_str() << "\" to " << output_file_path << std::endl;
+    // Create a cache if a cache directory is configured.
+    if ( this->ownedCache == nullptr )
+    {
+        const char *environmentDirectory = this->environmentVariable("STRIDE_CACHE_DIR");
+        if ( this->hasCompilerFlag("cache-dir") &&
+             std::holds_alternative<std::string>(this->getCompilerFlag("cache-dir")))
+        {
+            this->ownedCache = new cache::CompilationCache(std::get<std::string>(this->getCompilerFlag("cache-dir")));
+        }
+        else if ( environmentDirectory != nullptr && environmentDirectory[ 0 ] != '\0' )
+        {
+            this->ownedCache = new cache::CompilationCache(environmentDirectory);
+        }
+    }
+    return this->ownedCache;
+}
 
-    auto tokens = stride::tokenize(this);
-    auto root = stride::ast::parser::parse(*tokens);
-    auto irCode = root->codegen();
+void StrideFile::setEnvironment(std::map<std::string, std::string> variables)
+{
+    this->environment = std::move(variables);
+}
 
-    // Write to output file
-    /*std::ofstream file_out(output_file_path);
-    file_out << (char *) irCode->value;
-    file_out.close();*/
+const std::map<std::string, std::string> &StrideFile::getEnvironment() const
+{
+    return this->environment;
+}
+
+const char *StrideFile::environmentVariable(const std::string &name) const
+{
+    auto variable = this->environment.find(name);
+    if ( variable == this->environment.end())
+    {
+        return getenv(name.c_str());
+    }
+    return variable->second.empty() ? nullptr : variable->second.c_str();
 }
 
-void StrideFile::interpret()
+ast::Node *StrideFile::parse()
 {
-    // TODO: Implement this function
-    throw std::runtime_error("Interpretation is not yet implemented.");
+    if ( this->syntaxTree != nullptr )
+    {
+        return this->syntaxTree;
+    }
+
+    cache::CompilationCache *cache = this->getCompilationCache();
+    uint64_t cacheKey = cache ? cache::CompilationCache::computeKey(*this) : 0;
+
+    try
+    {
+        // On a cache hit, lexing and parsing are skipped entirely.
+        ast::Node *root = cache ? cache->loadAST(cacheKey) : nullptr;
+
+        if ( root == nullptr )
+        {
+            std::vector<token_t> *cachedTokens = cache ? cache->loadTokens(cacheKey) : nullptr;
+            auto tokens = cachedTokens ? new TokenSet(cachedTokens, this) : stride::tokenize(this);
+
+            // Entries are only stored for error-free phases, so diagnostics
+            // are reported again on the next compilation.
+            if ( cache && !cachedTokens && !this->diagnosticEngine->hasErrors())
+            {
+                cache->storeTokens(cacheKey, tokens->getTokens());
+            }
+
+            root = stride::ast::parser::parse(*tokens);
+
+            if ( cache && !this->diagnosticEngine->hasErrors())
+            {
+                cache->storeAST(cacheKey, *root);
+            }
+        }
+        this->syntaxTree = root;
+    }
+    catch ( const error::FatalError & )
+    {
+        // The error is already recorded in the diagnostic engine.
+    }
+    catch ( const error::ParseError & )
+    {
+        // Raised outside a synchronization point, already recorded as well.
+    }
+    return this->syntaxTree;
+}
+
+bool StrideFile::build(std::ostream &out)
+{
+    std::string output_file_path = this->filePath->substr(0, this->filePath->find_last_of('.')).append(".o");
+
+    if ( !this->interpreting )
+    {
+        out << "Compiling file \"" << this->filePath->c_str() << "\" to " << output_file_path << std::endl;
+    }
+
+    // The object file is copied from the compilation cache instead, if the file, its imports and the flags didn't change.
+    uint64_t objectKey = 0;
+    if ( !this->interpreting && this->getCompilationCache() != nullptr )
+    {
+        objectKey = this->computeOutputKey();
+        if ( this->loadObject(objectKey, output_file_path))
+        {
+            return true;
+        }
+    }
+
+    ast::Node *root = this->parse();
+    if ( root == nullptr )
+    {
+        return false;
+    }
+
+    try
+    {
+        // Write the parsed syntax tree, if requested.
+        if ( this->hasCompilerFlag("emit-ast"))
+        {
+            auto flag = this->getCompilerFlag("emit-ast");
+            std::string astPath = std::holds_alternative<std::string>(flag) ?
+                                  std::get<std::string>(flag) :
+                                  this->filePath->substr(0, this->filePath->find_last_of('.')).append(".sast");
+
+            if ( !stride::ast::serialization::write(*root, astPath))
+            {
+                this->diagnosticEngine->report(error::WARNING, 0, 0, "Failed to write syntax tree to " + astPath);
+            }
+        }
+
+        semantic::SymbolTable symbols;
+        semantic::NameResolver resolver(*this, symbols);
+        resolver.run(*root);
+
+        // Folds constants in the types they're evaluated in, which are found through the resolved names.
+        passes::ConstantFolder folder(*this);
+        folder.run(*root);
+
+        semantic::TypeTable types;
+        semantic::TypeChecker checker(*this, symbols, types);
+        checker.run(*root);
+
+        semantic::Monomorphizer monomorphizer(*this, symbols, types, checker);
+        monomorphizer.run(*root);
+
+        // Prints the layout of all types, if requested with '--layout-report'.
+        semantic::LayoutEngine layouts(*this, types, checker, monomorphizer);
+        layouts.run(*root);
+        if ( this->hasCompilerFlag("layout-report"))
+        {
+            layouts.printReport(out);
+        }
+
+        // Prints how every switch statement is lowered, if requested with '--switch-report'.
+        passes::SwitchLowering switches(*this);
+        switches.run(*root);
+        if ( this->hasCompilerFlag("switch-report"))
+        {
+            switches.printReport(out);
+        }
+
+        // Prints the IR of the file, if requested with '--emit-ir'.
+        if ( !this->diagnosticEngine->hasErrors())
+        {
+            ir::Module module(this->path());
+            ir::IRGenerator generator(*this, checker, module);
+            root->codegen(generator);
+
+            // Optimizes the IR at the level set with '-O<level>'. '--pass-report' prints the time
+            // and effect of every pass, and '--verify-ir' checks the IR after every pass.
+            ir::PassManager passes;
+            passes.setVerifying(this->hasCompilerFlag("verify-ir"));
+            passes.addOptimizationPipeline(this->optimizationLevel());
+            if ( !passes.run(module))
+            {
+                this->diagnosticEngine->report(error::ERROR, 0, 0,
+                                               "Internal error: invalid IR " + passes.getVerificationError());
+            }
+            if ( this->hasCompilerFlag("pass-report"))
+            {
+                passes.printReport(out);
+            }
+            if ( this->hasCompilerFlag("emit-ir"))
+            {
+                module.print(out);
+            }
+
+            // Compiles the IR to bytecode instead, if the file is interpreted; '--emit-bytecode' prints it.
+            if ( this->interpreting )
+            {
+                if ( !this->diagnosticEngine->hasErrors())
+                {
+                    this->compileBytecode(module, layouts, out);
+                }
+                return !this->diagnosticEngine->hasErrors();
+            }
+
+            // Translates the IR to C11 if requested with '--emit-c', optionally with the path of the source.
+            // With '--backend=c', the C compiler in $CC compiles it to the object file instead of the native backend.
+            bool translatesToC = this->hasCompilerFlag("backend") &&
+                                 this->getCompilerFlag("backend") == std::variant<std::string, long int>("c");
+            if ( !this->diagnosticEngine->hasErrors() && ( translatesToC || this->hasCompilerFlag("emit-c")))
+            {
+                auto flag = this->hasCompilerFlag("emit-c") ? this->getCompilerFlag("emit-c") : 0L;
+                std::string sourcePath = std::holds_alternative<std::string>(flag) ?
+                                         std::get<std::string>(flag) :
+                                         this->filePath->substr(0, this->filePath->find_last_of('.')).append(".c");
+                std::ofstream c_out(sourcePath);
+                backend::CSourceGenerator(layouts).write(module, c_out);
+                c_out.close();
+                if ( !c_out )
+                {
+                    this->diagnosticEngine->report(error::ERROR, 0, 0, "Failed to write " + sourcePath);
+                }
+                else if ( translatesToC )
+                {
+                    this->compileSource(sourcePath, output_file_path);
+                }
+            }
+
+            // Compiles the IR to an x86-64 object file, which is written next to the source file.
+            // The assembly is written as well if requested with '--emit-asm', optionally with its path.
+            if ( !this->diagnosticEngine->hasErrors() && !translatesToC )
+            {
+                backend::CodeGenerator codeGenerator(layouts);
+                codeGenerator.run(module);
+                std::ofstream file_out(output_file_path, std::ios::binary);
+                codeGenerator.writeObject(file_out);
+                if ( !file_out )
+                {
+                    this->diagnosticEngine->report(error::ERROR, 0, 0, "Failed to write " + output_file_path);
+                }
+
+                if ( this->hasCompilerFlag("emit-asm"))
+                {
+                    auto flag = this->getCompilerFlag("emit-asm");
+                    std::string asmPath = std::holds_alternative<std::string>(flag) ?
+                                          std::get<std::string>(flag) :
+                                          this->filePath->substr(0, this->filePath->find_last_of('.')).append(".asm");
+                    std::ofstream asm_out(asmPath);
+                    codeGenerator.writeAssembly(asm_out);
+                    if ( !asm_out )
+                    {
+                        this->diagnosticEngine->report(error::ERROR, 0, 0, "Failed to write " + asmPath);
+                    }
+                }
+            }
+
+            if ( objectKey != 0 && !this->diagnosticEngine->hasErrors())
+            {
+                this->storeObject(objectKey, output_file_path);
+            }
+        }
+    }
+    catch ( const error::FatalError & )
+    {
+        // The error is already recorded in the diagnostic engine.
+    }
+
+    return !this->diagnosticEngine->hasErrors();
+}
+
+bool StrideFile::compile()
+{
+    bool success = this->build();
+
+    this->diagnosticEngine->render(std::cerr);
+
+    cache::CompilationCache *cache = this->getCompilationCache();
+    if ( cache && this->hasCompilerFlag("cache-stats"))
+    {
+        cache->getStatistics().print(std::cout);
+    }
+    return success;
+}
+
+/**
+ * Quotes a path for the shell.
+ */
+static std::string quoted(const std::string &path)
+{
+    std::string result = "'";
+    for ( char c: path )
+    {
+        result.append(c == '\'' ? "'\\''" : std::string(1, c));
+    }
+    return result + "'";
+}
+
+void StrideFile::compileSource(const std::string &sourcePath, const std::string &objectPath)
+{
+    // The C compiler optimizes at the level set with '-O<level>', or at -O2 if there's none.
+    const char *compiler = this->environmentVariable("CC");
+    int level = this->hasCompilerFlag("optimize") ? this->optimizationLevel() : 2;
+    std::string command = std::string(compiler != nullptr && *compiler ? compiler : "cc") + " -std=c11 -O" +
+                          std::to_string(level) + " -c " + quoted(sourcePath) + " -o " + quoted(objectPath);
+    if ( std::system(command.c_str()) != 0 )
+    {
+        this->diagnosticEngine->report(error::ERROR, 0, 0, "Failed to compile " + sourcePath + ": " + command);
+    }
+}
+
+void StrideFile::compileBytecode(ir::Module &module, semantic::LayoutEngine &layouts, std::ostream &out)
+{
+    try
+    {
+        delete this->bytecode;
+        this->bytecode = vm::BytecodeCompiler(layouts).compile(module).release();
+    }
+    catch ( const std::runtime_error &error )
+    {
+        this->bytecode = nullptr;
+        this->diagnosticEngine->report(error::ERROR, 0, 0, error.what());
+        return;
+    }
+    if ( this->hasCompilerFlag("emit-bytecode"))
+    {
+        this->bytecode->print(out);
+    }
+}
+
+/**
+ * Flags with which building the file prints reports or writes other files, so it can't be skipped.
+ */
+static const char *reportingFlags[] = {
+        "emit-asm",
+        "emit-ast",
+        "emit-c",
+        "emit-ir",
+        "layout-report",
+        "pass-report",
+        "switch-report",
+        "verify-ir"
+};
+
+bool StrideFile::canReuseOutput()
+{
+    for ( auto flag: reportingFlags )
+    {
+        if ( this->hasCompilerFlag(flag))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t StrideFile::computeOutputKey()
+{
+    // The output depends on the signatures of the imports, so their keys are covered as well.
+    std::vector<uint64_t> dependencies;
+    for ( auto import: this->imports )
+    {
+        dependencies.push_back(import->outputKey);
+    }
+    this->outputKey = cache::CompilationCache::computeKey(*this, dependencies);
+    return this->outputKey;
+}
+
+bool StrideFile::loadObject(uint64_t key, const std::string &objectPath)
+{
+    std::vector<uint8_t> buffer;
+    if ( !this->canReuseOutput() || !this->getCompilationCache()->load(key, cache::ARTIFACT_OBJECT, buffer))
+    {
+        return false;
+    }
+    std::ofstream object_out(objectPath, std::ios::binary);
+    object_out.write(reinterpret_cast<const char *>(buffer.data()), (std::streamsize) buffer.size());
+    return (bool) object_out;
+}
+
+void StrideFile::storeObject(uint64_t key, const std::string &objectPath)
+{
+    std::ifstream object_in(objectPath, std::ios::binary);
+    std::vector<uint8_t> buffer(( std::istreambuf_iterator<char>(object_in)), std::istreambuf_iterator<char>());
+    if ( object_in.good() || object_in.eof())
+    {
+        this->getCompilationCache()->store(key, cache::ARTIFACT_OBJECT, buffer);
+    }
+}
+
+bool StrideFile::loadBytecode(uint64_t key, std::ostream &out)
+{
+    if ( this->hasCompilerFlag("no-bytecode-cache") || !this->canReuseOutput())
+    {
+        return false;
+    }
+
+    cache::CompilationCache *cache = this->getCompilationCache();
+    std::vector<uint8_t> buffer;
+    std::unique_ptr<vm::serialization::BytecodeView> view;
+    if ( cache != nullptr )
+    {
+        if ( cache->load(key, cache::ARTIFACT_BYTECODE, buffer))
+        {
+            view.reset(vm::serialization::BytecodeView::fromBuffer(buffer.data(), buffer.size()));
+        }
+    }
+    else
+    {
+        std::string bytecodePath = this->filePath->substr(0, this->filePath->find_last_of('.')).append(".srb");
+        view.reset(vm::serialization::BytecodeView::open(bytecodePath));
+    }
+    if ( view == nullptr || view->header().sourceHash != key )
+    {
+        return false;
+    }
+
+    try
+    {
+        delete this->bytecode;
+        this->bytecode = vm::serialization::materialize(*view).release();
+    }
+    catch ( const std::exception & )
+    {
+        // Malformed bytecode is compiled again, and overwritten.
+        this->bytecode = nullptr;
+        return false;
+    }
+    if ( this->hasCompilerFlag("emit-bytecode"))
+    {
+        this->bytecode->print(out);
+    }
+    return true;
+}
+
+void StrideFile::storeBytecode(uint64_t key)
+{
+    if ( this->bytecode == nullptr || this->hasCompilerFlag("no-bytecode-cache"))
+    {
+        return;
+    }
+
+    cache::CompilationCache *cache = this->getCompilationCache();
+    if ( cache != nullptr )
+    {
+        cache->store(key, cache::ARTIFACT_BYTECODE, vm::serialization::serialize(*this->bytecode, key));
+    }
+    else
+    {
+        std::string bytecodePath = this->filePath->substr(0, this->filePath->find_last_of('.')).append(".srb");
+        vm::serialization::write(*this->bytecode, bytecodePath, key);
+    }
+}
+
+bool StrideFile::buildBytecode(std::ostream &out)
+{
+    // The key is computed before building, which may change the content of the file.
+    uint64_t key = this->computeOutputKey();
+    this->interpreting = true;
+    bool loaded = this->loadBytecode(key, out);
+    bool success = loaded || this->build(out);
+    this->interpreting = false;
+    if ( !success || this->bytecode == nullptr )
+    {
+        return false;
+    }
+    if ( !loaded )
+    {
+        this->storeBytecode(key);
+    }
+    return true;
+}
+
+const vm::BytecodeModule *StrideFile::getBytecode() const
+{
+    return this->bytecode;
 }
 
 void StrideFile::setCompilerFlag(std::string &flag, std::variant<std::string, long int> value)
@@ -50,6 +524,41 @@ std::variant<std::string, long int> StrideFile::getCompilerFlag(std::string flag
     return this->compilerFlags[ flag ];
 }
 
+int StrideFile::optimizationLevel() const
+{
+    auto flag = this->compilerFlags.find("optimize");
+    if ( flag == this->compilerFlags.end() || !std::holds_alternative<long int>(flag->second))
+    {
+        return OPTIMIZATION_LEVEL_DEFAULT;
+    }
+    return (int) std::clamp(std::get<long int>(flag->second), 0L, (long int) OPTIMIZATION_LEVEL_MAX);
+}
+
+bool StrideFile::hasCompilerFlag(const std::string &flag) const
+{
+    return this->compilerFlags.find(flag) != this->compilerFlags.end();
+}
+
+const std::map<std::string, std::variant<std::string, long int>> &StrideFile::getCompilerFlags() const
+{
+    return this->compilerFlags;
+}
+
+void StrideFile::setCompilationCache(cache::CompilationCache *cache)
+{
+    this->compilationCache = cache;
+}
+
+void StrideFile::setImports(std::vector<StrideFile *> files)
+{
+    this->imports = std::move(files);
+}
+
+const std::vector<StrideFile *> &StrideFile::getImports() const
+{
+    return this->imports;
+}
+
 std::string &StrideFile::path()
 {
     return *this->filePath;
@@ -60,8 +569,21 @@ std::string &StrideFile::getContent()
     return *this->content;
 }
 
+void StrideFile::replaceContent(int start, int length, const std::string &text)
+{
+    this->content->replace(start, length, text);
+}
+
+stride::error::DiagnosticEngine &StrideFile::diagnostics()
+{
+    return *this->diagnosticEngine;
+}
+
 StrideFile::~StrideFile()
 {
     delete this->content;
     delete this->filePath;
+    delete this->diagnosticEngine;
+    delete this->ownedCache;
+    delete this->bytecode;
 }
@@ -5,8 +5,43 @@
 #ifndef STRIDE_LANGUAGE_STRIDEFILE_H
 #define STRIDE_LANGUAGE_STRIDEFILE_H
 
+#include <iostream>
 #include <string>
 #include <map>
+#include <variant>
+#include <vector>
+#include "error/Diagnostics.h"
+
+/**
+ * Cached artifacts are keyed on the version, so it must change whenever the
+ * compiler produces different output for the same source.
+ */
+#define STRIDE_COMPILER_VERSION "0.2.0"
+
+namespace stride::cache
+{
+    class CompilationCache;
+}
+
+namespace stride::ast
+{
+    class Node;
+}
+
+namespace stride::ir
+{
+    class Module;
+}
+
+namespace stride::semantic
+{
+    class LayoutEngine;
+}
+
+namespace stride::vm
+{
+    class BytecodeModule;
+}
 
 namespace stride
 {
@@ -19,6 +54,80 @@ namespace stride
         std::string *content;
         std::string *filePath;
         std::map<std::string, std::variant<std::string, long int>> compilerFlags;
+        error::DiagnosticEngine *diagnosticEngine;
+        cache::CompilationCache *compilationCache;
+        cache::CompilationCache *ownedCache;
+        ast::Node *syntaxTree;
+
+        /**
+         * Environment variables that are used instead of those of the process.
+         */
+        std::map<std::string, std::string> environment;
+
+        /**
+         * The files this file imports, which are built before it.
+         */
+        std::vector<StrideFile *> imports;
+
+        /**
+         * The bytecode of the file, which build() compiles instead of an object file when the file is interpreted.
+         */
+        vm::BytecodeModule *bytecode;
+        bool interpreting;
+
+        /**
+         * The cache key of the object file or bytecode, which covers the keys of the imported files as well.
+         */
+        uint64_t outputKey;
+
+        /**
+         * Whether the output of a previous build can be used instead of building the file;
+         * not if building it prints reports or writes other files.
+         */
+        bool canReuseOutput();
+
+        /**
+         * Computes the cache key of the output of the file. The imports must be built first.
+         */
+        uint64_t computeOutputKey();
+
+        /**
+         * Writes the object file of the file from the compilation cache, if it was compiled from
+         * the same source, imports and flags before.
+         * @return Whether the object file was written, in which case building the file can be skipped.
+         */
+        bool loadObject(uint64_t key, const std::string &objectPath);
+
+        /**
+         * Stores the object file of the file in the compilation cache.
+         */
+        void storeObject(uint64_t key, const std::string &objectPath);
+
+        /**
+         * Compiles C source, translated with '--backend=c', to an object file with the C compiler.
+         * Failures are reported in the diagnostic engine.
+         */
+        void compileSource(const std::string &sourcePath, const std::string &objectPath);
+
+        /**
+         * Compiles the IR of the file to bytecode for the interpreter.
+         * Failures are reported in the diagnostic engine.
+         */
+        void compileBytecode(ir::Module &module, semantic::LayoutEngine &layouts, std::ostream &out);
+
+        /**
+         * Loads the bytecode of the file from the compilation cache, or from the '.srb' file next to it,
+         * if it was compiled from the same source with the same flags.
+         * @param key The cache key of the file, which the bytecode was stored with.
+         * @return Whether the bytecode was loaded, in which case building the file can be skipped.
+         */
+        bool loadBytecode(uint64_t key, std::ostream &out);
+
+        /**
+         * Stores the bytecode of the file in the compilation cache, or in the '.srb' file next to it.
+         * Failures are ignored; the file is compiled again on the next run.
+         */
+        void storeBytecode(uint64_t key);
 
     public:
 
@@ -36,6 +145,22 @@ namespace stride
          */
         std::string &getContent();
 
+        /**
+         * Replaces part of the content of the file, e.g. after an edit in an editor.
+         * The file on disk is not modified.
+         * @param start The index of the first character to replace.
+         * @param length The amount of characters to replace.
+         * @param text The text to insert in their place.
+         */
+        void replaceContent(int start, int length, const std::string &text);
+
+        /**
+         * Returns the diagnostic engine of the file.
+         * All errors and warnings that occur whilst compiling
+         * this file are collected here.
+         */
+        error::DiagnosticEngine &diagnostics();
+
         /**
          * Sets a compiler flag.
          * This will set a compiler flag that can be used to compile the file.
@@ -52,19 +177,101 @@ namespace stride
          */
         std::variant<std::string, long int> getCompilerFlag(std::string flag);
 
+        /**
+         * Checks whether a compiler flag is set.
+         * @param flag The flag to check.
+         * @return Whether the flag is set.
+         */
+        bool hasCompilerFlag(const std::string &flag) const;
+
+        /**
+         * Returns the optimization level, set with '-O<level>'; from 0, the default, to 3.
+         */
+        int optimizationLevel() const;
+
+        /**
+         * Returns all compiler flags that are set.
+         */
+        const std::map<std::string, std::variant<std::string, long int>> &getCompilerFlags() const;
+
+        /**
+         * Sets the compilation cache to use when compiling this file.
+         * The cache is not owned by the file. If no cache is set, a cache is
+         * created when the 'cache-dir' flag or the STRIDE_CACHE_DIR environment
+         * variable is set.
+         */
+        void setCompilationCache(cache::CompilationCache *cache);
+
+        /**
+         * Returns the cache to use for this file; the cache set by the caller,
+         * or a cache created from the configured cache directory.
+         * @return The cache, or nullptr if caching is disabled.
+         */
+        cache::CompilationCache *getCompilationCache();
+
+        /**
+         * Sets environment variables that are used instead of those of the process,
+         * e.g. those of the client of the compile server. Empty values count as unset.
+         */
+        void setEnvironment(std::map<std::string, std::string> variables);
+
+        [[nodiscard]] const std::map<std::string, std::string> &getEnvironment() const;
+
+        /**
+         * Returns the value of an environment variable, as set with setEnvironment(), or of the process otherwise.
+         * @return The value, or nullptr if the variable isn't set.
+         */
+        [[nodiscard]] const char *environmentVariable(const std::string &name) const;
+
+        /**
+         * Sets the files this file imports. Their functions are visible in this file,
+         * so they must be built before this file is.
+         */
+        void setImports(std::vector<StrideFile *> files);
+
+        [[nodiscard]] const std::vector<StrideFile *> &getImports() const;
+
+        /**
+         * Tokenizes and parses the file, if this hasn't happened yet.
+         * Errors are collected in the diagnostic engine of the file.
+         * @return The root of the syntax tree, or nullptr if parsing was aborted.
+         */
+        ast::Node *parse();
+
+        /**
+         * Runs all compilation phases of the file, without rendering
+         * the collected diagnostics.
+         * This allows callers that compile multiple files to decide when,
+         * and in what order, diagnostics are displayed.
+         * @param out The stream to write progress and reports to, e.g. those of '--emit-ir'.
+         * @return Whether the file compiled without errors.
+         */
+        bool build(std::ostream &out = std::cout);
+
         /**
          * Compiles the file.
          * This will read the file, compile it and write the output to a new
-         * executable file.x
+         * executable file.
+         * Errors that occur during compilation are collected and
+         * rendered once all phases that could run have finished.
+         * @return Whether the file compiled without errors.
+         */
+        bool compile();
+
+        /**
+         * Builds the file to bytecode for the interpreter, rather than to an object file.
+         * The bytecode is cached in the compilation cache, or in a '.srb' file next to the source,
+         * and loaded from there while the source, its imports and the flags don't change, unless
+         * '--no-bytecode-cache' is given. The imports must be built first.
+         * @param out The stream to write reports to, like build().
+         * @return Whether the file compiled without errors.
          */
-        void compile();
+        bool buildBytecode(std::ostream &out = std::cout);
 
         /**
-         * Interprets the file.
-         * This will read the file, compile it and interpret the output.
-         * This is not yet implemented.
+         * Returns the bytecode of the file, after buildBytecode() succeeded.
          */
-        void interpret();
+        [[nodiscard]] const vm::BytecodeModule *getBytecode() const;
 
     };
 }
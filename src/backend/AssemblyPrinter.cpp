@@ -0,0 +1,359 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include "AssemblyPrinter.h"
+
+using namespace stride::backend;
+
+static const char *CONDITION_NAMES[] = { "e", "ne", "l", "le", "g", "ge", "b", "be", "a", "ae", "p", "np" };
+
+static char suffixOf(uint8_t size)
+{
+    switch ( size )
+    {
+        case 1:
+            return 'b';
+        case 2:
+            return 'w';
+        case 4:
+            return 'l';
+        default:
+            return 'q';
+    }
+}
+
+/**
+ * Returns the suffix of scalar float instructions, 'ss' or 'sd'.
+ */
+static const char *floatSuffixOf(uint8_t size)
+{
+    return size == 4 ? "ss" : "sd";
+}
+
+void AssemblyPrinter::print(const MachineModule &module)
+{
+    this->out << "\t.file\t\"" << module.sourceName << "\"\n";
+    this->out << "\t.text\n";
+    for ( auto &function: module.functions )
+    {
+        this->printFunction(*function);
+    }
+
+    for ( auto &object: module.data )
+    {
+        this->printData(object);
+    }
+    for ( auto &[ symbol, size ]: module.commonSymbols )
+    {
+        this->out << "\t.comm\t" << symbol << "," << size << "," << size << "\n";
+    }
+    if ( !module.constructors.empty())
+    {
+        this->out << "\t.section\t.init_array,\"aw\"\n\t.balign\t8\n";
+        for ( auto &constructor: module.constructors )
+        {
+            this->out << "\t.quad\t" << constructor << "\n";
+        }
+    }
+    this->out << "\t.section\t.note.GNU-stack,\"\",@progbits\n";
+}
+
+void AssemblyPrinter::printFunction(const MachineFunction &function)
+{
+    this->out << "\n";
+    if ( function.exported )
+    {
+        this->out << "\t.globl\t" << function.symbol << "\n";
+    }
+    this->out << "\t.type\t" << function.symbol << ", @function\n";
+    this->out << "\t.p2align\t4\n";
+    this->out << function.symbol << ":\n";
+    for ( size_t i = 0; i < function.blocks.size(); i++ )
+    {
+        const MachineBlock &block = *function.blocks[ i ];
+        if ( i > 0 )
+        {
+            this->out << block.label << ":\n";
+        }
+        for ( auto &instruction: block.instructions )
+        {
+            this->printInstruction(*instruction);
+        }
+    }
+    this->out << "\t.size\t" << function.symbol << ", .-" << function.symbol << "\n";
+
+    // The tables hold the offsets of the targets from the table, which don't need relocations.
+    if ( !function.jumpTables.empty())
+    {
+        this->out << "\t.section\t.rodata\n";
+        for ( auto &table: function.jumpTables )
+        {
+            this->out << "\t.balign\t4\n" << table.label << ":\n";
+            for ( auto target: table.targets )
+            {
+                this->out << "\t.long\t" << target->label << "-" << table.label << "\n";
+            }
+        }
+        this->out << "\t.text\n";
+    }
+}
+
+void AssemblyPrinter::printOperand(const MachineOperand &operand)
+{
+    switch ( operand.kind )
+    {
+        case OPERAND_REGISTER:
+            if ( isVirtual(operand.reg))
+            {
+                this->out << "%v" << operand.reg - FIRST_VIRTUAL_REGISTER;
+            }
+            else
+            {
+                this->out << "%" << registerName((ERegister) operand.reg, operand.size);
+            }
+            break;
+        case OPERAND_IMMEDIATE:
+            this->out << "$" << operand.immediate;
+            break;
+        case OPERAND_MEMORY:
+            if ( !operand.symbol.empty())
+            {
+                this->out << operand.symbol;
+                if ( operand.external )
+                {
+                    this->out << "@GOTPCREL";
+                }
+                else if ( operand.immediate != 0 )
+                {
+                    this->out << "+" << operand.immediate;
+                }
+                this->out << "(%rip)";
+                break;
+            }
+            if ( operand.immediate != 0 )
+            {
+                this->out << operand.immediate;
+            }
+            this->out << "(";
+            if ( operand.reg != NO_REGISTER )
+            {
+                this->printOperand(MachineOperand::use(operand.reg, 8));
+            }
+            if ( operand.index != NO_REGISTER )
+            {
+                this->out << ",";
+                this->printOperand(MachineOperand::use(operand.index, 8));
+                this->out << "," << (int) operand.scale;
+            }
+            this->out << ")";
+            break;
+        case OPERAND_SYMBOL:
+            this->out << operand.symbol << ( operand.external ? "@PLT" : "" );
+            break;
+        case OPERAND_BLOCK:
+            this->out << operand.block->label;
+            break;
+    }
+}
+
+void AssemblyPrinter::printInstruction(const MachineInstruction &instruction)
+{
+    auto &operands = instruction.operands;
+    uint8_t size = operands.empty() ? 8 : operands.back().size;
+    std::string mnemonic;
+
+    switch ( instruction.opcode )
+    {
+        case MI_COPY:
+            mnemonic = classOf((ERegister) operands[ 0 ].reg) == CLASS_XMM ? "movaps" : "movq";
+            break;
+        case MI_MOV:
+            mnemonic = operands[ 0 ].kind == OPERAND_IMMEDIATE && ( operands[ 0 ].immediate < INT32_MIN ||
+                                                                    operands[ 0 ].immediate > INT32_MAX ) ?
+                       "movabsq" : std::string("mov") + suffixOf(size);
+            break;
+        case MI_MOVZX:
+        case MI_MOVSX:
+        {
+            // Moving 32 bits clears the upper half of the destination.
+            uint8_t from = operands[ 0 ].size;
+            if ( instruction.opcode == MI_MOVZX && from == 4 )
+            {
+                this->out << "\tmovl\t";
+                this->printOperand(operands[ 0 ]);
+                this->out << ", ";
+                MachineOperand destination = operands[ 1 ];
+                destination.size = 4;
+                this->printOperand(destination);
+                this->out << "\n";
+                return;
+            }
+            mnemonic = std::string(instruction.opcode == MI_MOVZX ? "movz" : "movs") + suffixOf(from) + suffixOf(size);
+            break;
+        }
+        case MI_LEA:
+            mnemonic = "leaq";
+            break;
+        case MI_ADD:
+            mnemonic = std::string("add") + suffixOf(size);
+            break;
+        case MI_SUB:
+            mnemonic = std::string("sub") + suffixOf(size);
+            break;
+        case MI_IMUL:
+            mnemonic = std::string("imul") + suffixOf(size);
+            break;
+        case MI_AND:
+            mnemonic = std::string("and") + suffixOf(size);
+            break;
+        case MI_OR:
+            mnemonic = std::string("or") + suffixOf(size);
+            break;
+        case MI_XOR:
+            mnemonic = std::string("xor") + suffixOf(size);
+            break;
+        case MI_SHL:
+            mnemonic = std::string("shl") + suffixOf(size);
+            break;
+        case MI_SHR:
+            mnemonic = std::string("shr") + suffixOf(size);
+            break;
+        case MI_SAR:
+            mnemonic = std::string("sar") + suffixOf(size);
+            break;
+        case MI_NEG:
+            mnemonic = std::string("neg") + suffixOf(size);
+            break;
+        case MI_NOT:
+            mnemonic = std::string("not") + suffixOf(size);
+            break;
+        case MI_CMP:
+            mnemonic = std::string("cmp") + suffixOf(size);
+            break;
+        case MI_TEST:
+            mnemonic = std::string("test") + suffixOf(size);
+            break;
+        case MI_SETCC:
+            mnemonic = std::string("set") + CONDITION_NAMES[ instruction.condition ];
+            break;
+        case MI_SIGN_EXTEND_ACCUMULATOR:
+            this->out << ( operands[ 0 ].size == 8 ? "\tcqto\n" : "\tcltd\n" );
+            return;
+        case MI_IDIV:
+            mnemonic = std::string("idiv") + suffixOf(size);
+            break;
+        case MI_DIV:
+            mnemonic = std::string("div") + suffixOf(size);
+            break;
+        case MI_MOVF:
+            mnemonic = std::string("mov") + floatSuffixOf(size);
+            break;
+        case MI_MOVQ:
+            mnemonic = "movq";
+            break;
+        case MI_ADDF:
+            mnemonic = std::string("add") + floatSuffixOf(size);
+            break;
+        case MI_SUBF:
+            mnemonic = std::string("sub") + floatSuffixOf(size);
+            break;
+        case MI_MULF:
+            mnemonic = std::string("mul") + floatSuffixOf(size);
+            break;
+        case MI_DIVF:
+            mnemonic = std::string("div") + floatSuffixOf(size);
+            break;
+        case MI_XORF:
+            mnemonic = "xorps";
+            break;
+        case MI_UCOMIF:
+            mnemonic = std::string("ucomi") + floatSuffixOf(size);
+            break;
+        case MI_CVTSI2F:
+            mnemonic = std::string("cvtsi2") + floatSuffixOf(size) + suffixOf(operands[ 0 ].size);
+            break;
+        case MI_CVTF2SI:
+            mnemonic = std::string("cvtt") + floatSuffixOf(operands[ 0 ].size) + "2si";
+            break;
+        case MI_CVTF2F:
+            mnemonic = std::string("cvt") + floatSuffixOf(operands[ 0 ].size) + "2" + floatSuffixOf(size);
+            break;
+        case MI_PUSH:
+            mnemonic = "pushq";
+            break;
+        case MI_POP:
+            mnemonic = "popq";
+            break;
+        case MI_CALL:
+            this->out << "\tcall\t";
+            if ( operands[ 0 ].isRegister())
+            {
+                this->out << "*";
+            }
+            this->printOperand(operands[ 0 ]);
+            this->out << "\n";
+            return;
+        case MI_LEAVE:
+            mnemonic = "leave";
+            break;
+        case MI_JMP:
+            mnemonic = "jmp";
+            break;
+        case MI_JCC:
+            mnemonic = std::string("j") + CONDITION_NAMES[ instruction.condition ];
+            break;
+        case MI_JMP_TABLE:
+            this->out << "\tjmp\t*";
+            this->printOperand(operands[ 0 ]);
+            this->out << "\n";
+            return;
+        case MI_RET:
+            mnemonic = "ret";
+            break;
+        case MI_UD2:
+            mnemonic = "ud2";
+            break;
+    }
+
+    this->out << "\t" << mnemonic;
+    for ( size_t i = 0; i < operands.size(); i++ )
+    {
+        this->out << ( i == 0 ? "\t" : ", " );
+        this->printOperand(operands[ i ]);
+    }
+    this->out << "\n";
+}
+
+void AssemblyPrinter::printData(const DataObject &object)
+{
+    bool isZero = object.bytes.empty() && object.reference.empty();
+    this->out << "\n\t.section\t" << ( object.readOnly ? ".rodata" : isZero ? ".bss" : ".data" ) << "\n";
+    if ( object.exported )
+    {
+        this->out << "\t.globl\t" << object.symbol << "\n";
+        this->out << "\t.type\t" << object.symbol << ", @object\n";
+        this->out << "\t.size\t" << object.symbol << ", " << object.size << "\n";
+    }
+    this->out << "\t.balign\t" << object.alignment << "\n";
+    this->out << object.symbol << ":\n";
+    if ( !object.reference.empty())
+    {
+        this->out << "\t.quad\t" << object.reference << "\n";
+    }
+    else if ( isZero )
+    {
+        this->out << "\t.zero\t" << object.size << "\n";
+    }
+    else
+    {
+        for ( size_t i = 0; i < object.bytes.size(); i++ )
+        {
+            this->out << ( i % 16 == 0 ? "\t.byte\t" : "," ) << (int) object.bytes[ i ];
+            if ( i % 16 == 15 || i + 1 == object.bytes.size())
+            {
+                this->out << "\n";
+            }
+        }
+    }
+}
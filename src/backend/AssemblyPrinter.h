@@ -0,0 +1,40 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_ASSEMBLYPRINTER_H
+#define STRIDE_LANGUAGE_ASSEMBLYPRINTER_H
+
+#include <ostream>
+#include "MachineIR.h"
+
+namespace stride::backend
+{
+
+    /**
+     * Prints a machine module as assembly in the AT&T syntax of the GNU assembler,
+     * for an ELF target. Functions of other units are called through the procedure
+     * linkage table, so the output can be linked as a position independent executable.
+     */
+    class AssemblyPrinter
+    {
+    private:
+        std::ostream &out;
+
+        void printFunction(const MachineFunction &function);
+
+        void printInstruction(const MachineInstruction &instruction);
+
+        void printOperand(const MachineOperand &operand);
+
+        void printData(const DataObject &object);
+
+    public:
+        explicit AssemblyPrinter(std::ostream &out) : out(out)
+        {}
+
+        void print(const MachineModule &module);
+    };
+}
+
+#endif //STRIDE_LANGUAGE_ASSEMBLYPRINTER_H
@@ -0,0 +1,801 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include "CSourceGenerator.h"
+#include "InstructionSelector.h"
+#include "../ir/IRGenerator.h"
+
+using namespace stride;
+using namespace stride::backend;
+
+/**
+ * The declarations every translated unit starts with. Common symbols and constructors aren't part
+ * of C11; other compilers than GCC and Clang need the module initializer to be called explicitly.
+ * Functions of other units are declared under an alias that's bound to their symbol, so the signature
+ * they're declared with in Stride doesn't conflict with that of a builtin of the same name.
+ */
+static const char *PRELUDE = R"(#include <stdint.h>
+
+#if defined(__GNUC__)
+#define STRIDE_COMMON __attribute__((common))
+#define STRIDE_CONSTRUCTOR __attribute__((constructor))
+#define STRIDE_UNREACHABLE() __builtin_trap()
+#define STRIDE_INFINITY __builtin_inf()
+#define STRIDE_NAN __builtin_nan("")
+#define STRIDE_STRING(text) #text
+#define STRIDE_SYMBOL(prefix, name) STRIDE_STRING(prefix) #name
+#define STRIDE_EXTERNAL(name) stride_external_##name
+#define STRIDE_LINK_NAME(name) __asm__(STRIDE_SYMBOL(__USER_LABEL_PREFIX__, name))
+#else
+#define STRIDE_COMMON
+#define STRIDE_CONSTRUCTOR
+#define STRIDE_UNREACHABLE() for ( ;; )
+#define STRIDE_INFINITY ( 1.0 / 0.0 )
+#define STRIDE_NAN ( 0.0 / 0.0 )
+#define STRIDE_EXTERNAL(name) name
+#define STRIDE_LINK_NAME(name)
+#endif
+)";
+
+/** The thrown value, stored zero extended, which a handler reads as the type it catches. */
+static const char *EXCEPTION_DECLARATIONS = R"(
+union stride_exception
+{
+    uint64_t bits;
+    uint8_t u8;
+    int8_t i8;
+    int16_t i16;
+    int32_t i32;
+    int64_t i64;
+    float f32;
+    double f64;
+    void *ptr;
+};
+
+STRIDE_COMMON union stride_exception )" EXCEPTION_VALUE_SYMBOL R"(;
+STRIDE_COMMON uint8_t )" EXCEPTION_FLAG_SYMBOL R"(;
+)";
+
+static const char *typeOf(ir::EIRType type)
+{
+    switch ( type )
+    {
+        case ir::IR_VOID:
+            return "void";
+        case ir::IR_BOOL:
+            return "uint8_t";
+        case ir::IR_I8:
+            return "int8_t";
+        case ir::IR_I16:
+            return "int16_t";
+        case ir::IR_I32:
+            return "int32_t";
+        case ir::IR_I64:
+            return "int64_t";
+        case ir::IR_F32:
+            return "float";
+        case ir::IR_F64:
+            return "double";
+        default:
+            return "void *";
+    }
+}
+
+/**
+ * Returns the unsigned type of the same width, for the operations that are unsigned.
+ */
+static const char *unsignedTypeOf(ir::EIRType type)
+{
+    switch ( type )
+    {
+        case ir::IR_BOOL:
+        case ir::IR_I8:
+            return "uint8_t";
+        case ir::IR_I16:
+            return "uint16_t";
+        case ir::IR_I32:
+            return "uint32_t";
+        case ir::IR_I64:
+            return "uint64_t";
+        default:
+            return "uintptr_t";
+    }
+}
+
+/**
+ * Returns the type that arithmetic wraps around in; signed overflow is undefined in C,
+ * and narrower unsigned types are promoted to int, which can overflow as well.
+ */
+static const char *wrappingTypeOf(ir::EIRType type)
+{
+    return ir::sizeOf(type) <= 4 ? "uint32_t" : "uint64_t";
+}
+
+static const char *exceptionMemberOf(ir::EIRType type)
+{
+    static const char *members[] = { "u8", "u8", "i8", "i16", "i32", "i64", "f32", "f64", "ptr" };
+    return members[ type ];
+}
+
+/**
+ * Declares a variable or function of a type, e.g. 'int32_t x' or 'void *x'.
+ */
+static std::string declare(const char *type, const std::string &name)
+{
+    std::string declaration = type;
+    return declaration.back() == '*' ? declaration + name : declaration + " " + name;
+}
+
+static std::string pointerTo(ir::EIRType type)
+{
+    std::string pointer = type == ir::IR_VOID ? "uint8_t" : typeOf(type);
+    return pointer.back() == '*' ? pointer + "*" : pointer + " *";
+}
+
+/**
+ * Returns the C identifier of a function or global; the symbol of the native backend, in which
+ * characters that C doesn't allow, such as the '.' of numbered overloads, are replaced by '_'.
+ */
+static std::string identifierOf(const std::string &name)
+{
+    std::string symbol = ir::mangle(name);
+    std::replace_if(symbol.begin(), symbol.end(), [](char c)
+    { return !std::isalnum((unsigned char) c) && c != '_'; }, '_');
+    return symbol;
+}
+
+static bool isExternal(const ir::Function &function)
+{
+    return function.external || function.blocks.empty();
+}
+
+/**
+ * Returns how a function is referred to in C; functions of other units by their alias.
+ */
+static std::string functionNameOf(const ir::Function &function)
+{
+    std::string identifier = identifierOf(function.name);
+    return isExternal(function) ? "STRIDE_EXTERNAL(" + identifier + ")" : identifier;
+}
+
+static std::string integerLiteral(ir::EIRType type, int64_t value)
+{
+    if ( type == ir::IR_PTR )
+    {
+        return value == 0 ? "( (void *) 0 )" : "( (void *) (uintptr_t) UINT64_C(" + std::to_string(value) + ") )";
+    }
+    if ( value == INT64_MIN )
+    {
+        return "INT64_MIN";
+    }
+    return type == ir::IR_I64 ? "INT64_C(" + std::to_string(value) + ")" : std::to_string(value);
+}
+
+/**
+ * Returns a float literal, written in hexadecimal so it's exact.
+ */
+static std::string floatLiteral(ir::EIRType type, double value)
+{
+    bool isSingle = type == ir::IR_F32;
+    if ( std::isnan(value))
+    {
+        return isSingle ? "( (float) STRIDE_NAN )" : "STRIDE_NAN";
+    }
+    if ( std::isinf(value))
+    {
+        std::string infinity = isSingle ? "(float) STRIDE_INFINITY" : "STRIDE_INFINITY";
+        return value < 0 ? "( -" + infinity + " )" : "( " + infinity + " )";
+    }
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%a%s", isSingle ? (double) (float) value : value, isSingle ? "f" : "");
+    return value < 0 ? "( " + std::string(buffer) + " )" : buffer;
+}
+
+/**
+ * Returns a string literal; characters that aren't printable are escaped in octal, and so is '?', which can start a trigraph.
+ */
+static std::string stringLiteral(const std::string &value)
+{
+    std::string literal = "\"";
+    for ( unsigned char c: value )
+    {
+        if ( c == '"' || c == '\\' )
+        {
+            literal.append("\\").push_back((char) c);
+        }
+        else if ( c < 0x20 || c >= 0x7F || c == '?' )
+        {
+            char escape[8];
+            std::snprintf(escape, sizeof(escape), "\\%03o", c);
+            literal.append(escape);
+        }
+        else
+        {
+            literal.push_back((char) c);
+        }
+    }
+    return literal + "\"";
+}
+
+static std::string valueName(const ir::Value *value)
+{
+    return "_v" + std::to_string(value->id);
+}
+
+static std::string labelOf(const ir::BasicBlock *block)
+{
+    return "_b" + std::to_string(block->id);
+}
+
+/**
+ * Returns the parameters of a function; functions of the runtime and of unknown units, which are
+ * variadic without parameters, have no prototype.
+ */
+static std::string parametersOf(const ir::Function &function, bool named)
+{
+    if ( function.variadic && function.arguments.empty())
+    {
+        return "()";
+    }
+    if ( function.arguments.empty())
+    {
+        return "(void)";
+    }
+    std::string parameters = "(";
+    for ( auto argument: function.arguments )
+    {
+        std::string name = named ? "_a" + std::to_string(argument->index) : "";
+        parameters.append(parameters.size() > 1 ? ", " : "").append(named ? declare(typeOf(argument->type), name) :
+                                                                    typeOf(argument->type));
+    }
+    return parameters + ( function.variadic ? ", ...)" : ")" );
+}
+
+std::string CSourceGenerator::stringName(const std::string &value)
+{
+    auto known = this->stringNames.find(value);
+    if ( known != this->stringNames.end())
+    {
+        return known->second;
+    }
+    std::string name = "_s" + std::to_string(this->stringNames.size());
+    this->strings << "static const char " << name << "[] = " << stringLiteral(value) << ";\n";
+    this->stringNames[ value ] = name;
+    return name;
+}
+
+std::string CSourceGenerator::expressionOf(ir::Value *value)
+{
+    switch ( value->kind )
+    {
+        case ir::VALUE_CONSTANT:
+        {
+            auto constant = static_cast<ir::Constant *>(value);
+            if ( constant->isString )
+            {
+                return "( (void *) " + this->stringName(constant->string) + " )";
+            }
+            return ir::isFloat(value->type) ? floatLiteral(value->type, constant->floating) :
+                   integerLiteral(value->type, constant->integer);
+        }
+        case ir::VALUE_UNDEFINED:
+            return integerLiteral(value->type, 0);
+        case ir::VALUE_ARGUMENT:
+            return "_a" + std::to_string(static_cast<ir::Argument *>(value)->index);
+        case ir::VALUE_GLOBAL:
+            return "( (void *) &" + identifierOf(static_cast<ir::Global *>(value)->name) + " )";
+        case ir::VALUE_FUNCTION:
+            return "( (void *) &" + functionNameOf(*static_cast<ir::Function *>(value)) + " )";
+        default:
+            return valueName(value);
+    }
+}
+
+std::string CSourceGenerator::expressionOf(ir::Value *value, ir::EIRType type)
+{
+    if ( value->type == type || type == ir::IR_VOID )
+    {
+        return this->expressionOf(value);
+    }
+    bool isPointer = value->type == ir::IR_PTR || type == ir::IR_PTR;
+    return std::string("( (") + typeOf(type) + ") " + ( isPointer ? "(uintptr_t) " : "" ) + this->expressionOf(value) +
+           " )";
+}
+
+// Module
+
+void CSourceGenerator::write(const ir::Module &module, std::ostream &out)
+{
+    this->exceptions = std::make_unique<ir::ExceptionAnalysis>(module);
+
+    std::ostringstream declarations;
+    std::ostringstream definitions;
+    for ( auto function: module.functions )
+    {
+        this->writeDeclaration(declarations, *function);
+    }
+    for ( auto function: module.functions )
+    {
+        if ( !function->external && !function->blocks.empty())
+        {
+            function->renumber();
+            this->writeFunction(definitions, *function);
+        }
+    }
+
+    // Globals are exported, like the ones of the native backend; without an initializer, they're zero.
+    std::ostringstream globals;
+    for ( auto global: module.globals )
+    {
+        globals << declare(typeOf(global->valueType == ir::IR_VOID ? ir::IR_BOOL : global->valueType),
+                           identifierOf(global->name));
+        ir::Constant *initializer = global->initializer;
+        if ( initializer != nullptr && initializer->isString )
+        {
+            globals << " = (void *) " << this->stringName(initializer->string);
+        }
+        else if ( initializer != nullptr )
+        {
+            globals << " = " << ( ir::isFloat(initializer->type) ? floatLiteral(global->valueType, initializer->floating) :
+                                  integerLiteral(global->valueType, initializer->integer));
+        }
+        globals << ";\n";
+    }
+
+    out << "/* Translated from " << module.name << " by the Stride compiler; compile as C11. */\n\n" << PRELUDE;
+    if ( module.getFunction(RUNTIME_ALLOCATE) == nullptr )
+    {
+        out << "\nvoid *" RUNTIME_ALLOCATE "(uint64_t size);\n";
+    }
+    if ( module.getFunction(RUNTIME_ALLOCATE_ARRAY) == nullptr )
+    {
+        out << "void *" RUNTIME_ALLOCATE_ARRAY "(uint64_t length, uint64_t elementSize);\n";
+    }
+    if ( module.getFunction("fmod") == nullptr )
+    {
+        out << "double fmod(double x, double y);\nfloat fmodf(float x, float y);\n";
+    }
+    if ( this->raisesExceptions )
+    {
+        out << EXCEPTION_DECLARATIONS;
+    }
+    out << "\n" << this->strings.str() << "\n" << globals.str() << "\n" << declarations.str() << definitions.str();
+}
+
+void CSourceGenerator::writeDeclaration(std::ostream &out, const ir::Function &function)
+{
+    if ( function.name == MODULE_INITIALIZER_NAME )
+    {
+        out << "STRIDE_CONSTRUCTOR static ";
+    }
+    out << declare(typeOf(function.returnType), functionNameOf(function)) << parametersOf(function, false);
+    if ( isExternal(function))
+    {
+        out << " STRIDE_LINK_NAME(" << identifierOf(function.name) << ")";
+    }
+    out << ";\n";
+}
+
+void CSourceGenerator::writeFunction(std::ostream &out, const ir::Function &source)
+{
+    this->function = &source;
+    out << "\n" << ( source.name == MODULE_INITIALIZER_NAME ? "static " : "" )
+        << declare(typeOf(source.returnType), identifierOf(source.name)) << parametersOf(source, true) << "\n{\n";
+    for ( auto block: source.blocks )
+    {
+        for ( auto instruction: block->instructions )
+        {
+            if ( instruction->type != ir::IR_VOID )
+            {
+                out << "    " << declare(typeOf(instruction->type), valueName(instruction)) << ";\n";
+            }
+        }
+    }
+
+    for ( auto block: source.blocks )
+    {
+        if ( !block->predecessors.empty())
+        {
+            out << labelOf(block) << ":\n";
+        }
+        for ( auto instruction: block->instructions )
+        {
+            if ( instruction->isTerminator())
+            {
+                this->writeTerminator(out, instruction);
+            }
+            else
+            {
+                this->writeInstruction(out, instruction);
+            }
+        }
+    }
+    out << "}\n";
+}
+
+// Instructions
+
+std::string CSourceGenerator::callOf(ir::Instruction *instruction)
+{
+    ir::Value *callee = instruction->operands[ 0 ];
+    std::string call = callee->kind == ir::VALUE_FUNCTION ?
+                       functionNameOf(*static_cast<ir::Function *>(callee)) :
+                       "( (" + declare(typeOf(instruction->type), "(*)()") + ") " + this->expressionOf(callee) + " )";
+    // Arguments are converted to the parameters of the callee, if it's known.
+    std::vector<ir::Argument *> parameters;
+    if ( callee->kind == ir::VALUE_FUNCTION )
+    {
+        parameters = static_cast<ir::Function *>(callee)->arguments;
+    }
+    call.append("(");
+    for ( size_t i = 1; i < instruction->operands.size(); i++ )
+    {
+        ir::Value *argument = instruction->operands[ i ];
+        call.append(i > 1 ? ", " : "").append(i <= parameters.size() ?
+                                             this->expressionOf(argument, parameters[ i - 1 ]->type) :
+                                             this->expressionOf(argument));
+    }
+    return call + ")";
+}
+
+void CSourceGenerator::writeInstruction(std::ostream &out, ir::Instruction *instruction)
+{
+    auto &operands = instruction->operands;
+    std::string result = "    " + valueName(instruction) + " = ";
+    const char *type = typeOf(instruction->type);
+    auto operand = [ & ](size_t index)
+    { return this->expressionOf(operands[ index ]); };
+
+    switch ( instruction->opcode )
+    {
+        case ir::OP_PHI:
+            // Assigned on the edges that lead to the block.
+            break;
+
+        case ir::OP_ADD:
+        case ir::OP_SUB:
+        case ir::OP_MUL:
+        {
+            static const char *operators[] = { "+", "-", "*" };
+            const char *wrapping = wrappingTypeOf(instruction->type);
+            out << result << "(" << type << ") ( (" << wrapping << ") " << operand(0) << " "
+                << operators[ instruction->opcode - ir::OP_ADD ] << " (" << wrapping << ") " << operand(1) << " );\n";
+            break;
+        }
+
+        case ir::OP_SDIV:
+        case ir::OP_SREM:
+            out << result << operand(0) << ( instruction->opcode == ir::OP_SDIV ? " / " : " % " ) << operand(1) << ";\n";
+            break;
+
+        case ir::OP_UDIV:
+        case ir::OP_UREM:
+        {
+            const char *unsignedType = unsignedTypeOf(instruction->type);
+            out << result << "(" << type << ") ( (" << unsignedType << ") " << operand(0)
+                << ( instruction->opcode == ir::OP_UDIV ? " / " : " % " ) << "(" << unsignedType << ") " << operand(1)
+                << " );\n";
+            break;
+        }
+
+        case ir::OP_FADD:
+        case ir::OP_FSUB:
+        case ir::OP_FMUL:
+        case ir::OP_FDIV:
+        {
+            static const char *operators[] = { "+", "-", "*", "/" };
+            out << result << operand(0) << " " << operators[ instruction->opcode - ir::OP_FADD ] << " " << operand(1)
+                << ";\n";
+            break;
+        }
+
+        case ir::OP_FREM:
+            out << result << ( instruction->type == ir::IR_F32 ? "fmodf(" : "fmod(" ) << operand(0) << ", "
+                << operand(1) << ");\n";
+            break;
+
+        case ir::OP_SHL:
+        case ir::OP_LSHR:
+        case ir::OP_ASHR:
+        {
+            // Shifting by the width or more is undefined; the count is masked, as x86-64 does.
+            std::string count = "( " + operand(1) + " & " + std::to_string(ir::sizeOf(instruction->type) * 8 - 1) + " )";
+            if ( instruction->opcode == ir::OP_SHL )
+            {
+                out << result << "(" << type << ") ( (" << wrappingTypeOf(instruction->type) << ") " << operand(0)
+                    << " << " << count << " );\n";
+            }
+            else if ( instruction->opcode == ir::OP_LSHR )
+            {
+                out << result << "(" << type << ") ( (" << unsignedTypeOf(instruction->type) << ") " << operand(0)
+                    << " >> " << count << " );\n";
+            }
+            else
+            {
+                out << result << "(" << type << ") ( " << operand(0) << " >> " << count << " );\n";
+            }
+            break;
+        }
+
+        case ir::OP_AND:
+        case ir::OP_OR:
+        case ir::OP_XOR:
+        {
+            const char *operators[] = { "&", "|", "^" };
+            out << result << "(" << type << ") ( " << operand(0) << " " << operators[ instruction->opcode - ir::OP_AND ]
+                << " " << operand(1) << " );\n";
+            break;
+        }
+
+        case ir::OP_ICMP:
+        case ir::OP_FCMP:
+        {
+            // Floats compare unordered only when they're not equal, as the native backend does.
+            static const char *operators[] = { "==", "!=", "<", "<=", ">", ">=", "<", "<=", ">", ">=" };
+            ir::EIRType operandType = operands[ 0 ]->type;
+            std::string cast;
+            if ( instruction->opcode == ir::OP_ICMP && instruction->predicate >= ir::PREDICATE_ULT )
+            {
+                cast = std::string("(") + unsignedTypeOf(operandType) + ") ";
+            }
+            else if ( instruction->opcode == ir::OP_ICMP && instruction->predicate >= ir::PREDICATE_LT &&
+                      operandType == ir::IR_PTR )
+            {
+                cast = "(intptr_t) ";
+            }
+            out << result << cast << operand(0) << " " << operators[ instruction->predicate ] << " " << cast
+                << operand(1) << ";\n";
+            break;
+        }
+
+        case ir::OP_TRUNC:
+        case ir::OP_ZEXT:
+        case ir::OP_SEXT:
+        case ir::OP_FPTRUNC:
+        case ir::OP_FPEXT:
+        case ir::OP_SITOFP:
+        case ir::OP_UITOFP:
+        case ir::OP_FPTOSI:
+        case ir::OP_FPTOUI:
+        {
+            ir::EIRType from = operands[ 0 ]->type;
+            std::string intermediate;
+            if ( from == ir::IR_PTR || instruction->type == ir::IR_PTR )
+            {
+                intermediate = "(uintptr_t) ";
+            }
+            else if ( instruction->opcode == ir::OP_ZEXT || instruction->opcode == ir::OP_UITOFP )
+            {
+                intermediate = std::string("(") + unsignedTypeOf(from) + ") ";
+            }
+            else if ( instruction->opcode == ir::OP_SEXT && from == ir::IR_BOOL )
+            {
+                intermediate = "(int8_t) ";
+            }
+            else if ( instruction->opcode == ir::OP_FPTOUI )
+            {
+                intermediate = std::string("(") + unsignedTypeOf(instruction->type) + ") ";
+            }
+
+            // Booleans are the lowest bit of the value they're truncated from.
+            if ( instruction->opcode == ir::OP_TRUNC && instruction->type == ir::IR_BOOL )
+            {
+                out << result << "(uint8_t) ( " << intermediate << operand(0) << " & 1 );\n";
+                break;
+            }
+            out << result << "(" << type << ") " << intermediate << operand(0) << ";\n";
+            break;
+        }
+
+        case ir::OP_LOAD:
+            if ( operands[ 0 ]->kind == ir::VALUE_GLOBAL &&
+                 static_cast<ir::Global *>(operands[ 0 ])->valueType == instruction->type )
+            {
+                out << result << identifierOf(static_cast<ir::Global *>(operands[ 0 ])->name) << ";\n";
+                break;
+            }
+            out << result << "*(" << pointerTo(instruction->type) << ") " << operand(0) << ";\n";
+            break;
+
+        case ir::OP_STORE:
+            if ( operands[ 0 ]->kind == ir::VALUE_GLOBAL &&
+                 static_cast<ir::Global *>(operands[ 0 ])->valueType == operands[ 1 ]->type )
+            {
+                out << "    " << identifierOf(static_cast<ir::Global *>(operands[ 0 ])->name) << " = " << operand(1)
+                    << ";\n";
+                break;
+            }
+            out << "    *(" << pointerTo(operands[ 1 ]->type) << ") " << operand(0) << " = " << operand(1) << ";\n";
+            break;
+
+        case ir::OP_FIELD_ADDRESS:
+            out << result << "(void *) ( (char *) " << operand(0) << " + " << this->layouts.fieldOffset(instruction->field)
+                << " );\n";
+            break;
+
+        case ir::OP_ALLOCATE:
+        {
+            // The arguments are assigned to the fields the type declares, in order of declaration.
+            const semantic::TypeLayout *layout = this->layouts.layoutOf(instruction->allocated);
+            uint32_t size = std::max(layout != nullptr ? layout->size : 0, 1u);
+            out << result << RUNTIME_ALLOCATE "(" << size << ");\n";
+            std::vector<const semantic::FieldLayout *> fields = this->layouts.declaredFields(instruction->allocated);
+            for ( size_t i = 0; i < operands.size() && i < fields.size(); i++ )
+            {
+                if ( fields[ i ]->size == ir::sizeOf(operands[ i ]->type))
+                {
+                    out << "    *(" << pointerTo(operands[ i ]->type) << ") ( (char *) " << valueName(instruction)
+                        << " + " << fields[ i ]->offset << " ) = " << operand(i) << ";\n";
+                }
+            }
+            break;
+        }
+
+        case ir::OP_ARRAY:
+        {
+            // The descriptor refers to the elements at offset 0.
+            uint32_t elementSize = std::max(ir::sizeOf(instruction->elementType), 1u);
+            out << result << RUNTIME_ALLOCATE_ARRAY "(" << operands.size() << ", " << elementSize << ");\n";
+            for ( size_t i = 0; i < operands.size(); i++ )
+            {
+                out << "    *(" << pointerTo(instruction->elementType) << ") ( *(char **) " << valueName(instruction)
+                    << " + " << i * elementSize << " ) = " << operand(i) << ";\n";
+            }
+            break;
+        }
+
+        case ir::OP_CALL:
+            out << ( instruction->type != ir::IR_VOID ? result : "    " ) << this->callOf(instruction) << ";\n";
+            if ( this->exceptions->mayThrow(operands[ 0 ]))
+            {
+                // Outside a try block, an exception returns from this function as well.
+                out << "    if ( " EXCEPTION_FLAG_SYMBOL " )\n    {\n        "
+                    << ( this->function->returnType == ir::IR_VOID ? "return;" : "return 0;" ) << "\n    }\n";
+                this->raisesExceptions = true;
+            }
+            break;
+
+        case ir::OP_LANDING_PAD:
+            out << result << EXCEPTION_VALUE_SYMBOL "." << exceptionMemberOf(instruction->type) << ";\n";
+            out << "    " EXCEPTION_FLAG_SYMBOL " = 0;\n";
+            this->raisesExceptions = true;
+            break;
+
+        default:
+            break;
+    }
+}
+
+void CSourceGenerator::writeRaise(std::ostream &out, ir::Value *value)
+{
+    out << "    " EXCEPTION_VALUE_SYMBOL ".bits = 0;\n";
+    out << "    " EXCEPTION_VALUE_SYMBOL "." << exceptionMemberOf(value->type) << " = " << this->expressionOf(value)
+        << ";\n";
+    out << "    " EXCEPTION_FLAG_SYMBOL " = 1;\n";
+    this->raisesExceptions = true;
+}
+
+void CSourceGenerator::writeEdge(std::ostream &out, const ir::BasicBlock *predecessor, const ir::BasicBlock *successor,
+                                 const char *indentation)
+{
+    std::vector<std::pair<ir::Instruction *, ir::Value *>> copies;
+    bool readsPhi = false;
+    for ( auto phi: successor->instructions )
+    {
+        if ( phi->opcode != ir::OP_PHI )
+        {
+            break;
+        }
+        auto incoming = std::find(phi->targets.begin(), phi->targets.end(), predecessor);
+        ir::Value *value = phi->operands[ incoming - phi->targets.begin() ];
+        if ( value != phi )
+        {
+            copies.emplace_back(phi, value);
+            readsPhi |= value->kind == ir::VALUE_INSTRUCTION &&
+                        static_cast<ir::Instruction *>(value)->opcode == ir::OP_PHI &&
+                        static_cast<ir::Instruction *>(value)->block == successor;
+        }
+    }
+
+    // Phi nodes are assigned at once; if one reads another, all values are copied to temporaries first.
+    if ( readsPhi )
+    {
+        out << indentation << "{\n";
+        for ( size_t i = 0; i < copies.size(); i++ )
+        {
+            out << indentation << "    " << declare(typeOf(copies[ i ].first->type), "_t" + std::to_string(i))
+                << " = " << this->expressionOf(copies[ i ].second, copies[ i ].first->type) << ";\n";
+        }
+        for ( size_t i = 0; i < copies.size(); i++ )
+        {
+            out << indentation << "    " << valueName(copies[ i ].first) << " = _t" << i << ";\n";
+        }
+        out << indentation << "}\n";
+    }
+    else
+    {
+        for ( auto &[ phi, value ]: copies )
+        {
+            out << indentation << valueName(phi) << " = " << this->expressionOf(value, phi->type) << ";\n";
+        }
+    }
+    out << indentation << "goto " << labelOf(successor) << ";\n";
+}
+
+void CSourceGenerator::writeTerminator(std::ostream &out, ir::Instruction *instruction)
+{
+    const ir::BasicBlock *block = instruction->block;
+    auto &operands = instruction->operands;
+    auto &targets = instruction->targets;
+    const char *unwind = this->function->returnType == ir::IR_VOID ? "return;" : "return 0;";
+
+    switch ( instruction->opcode )
+    {
+        case ir::OP_BRANCH:
+            this->writeEdge(out, block, targets[ 0 ], "    ");
+            break;
+
+        case ir::OP_CONDITIONAL_BRANCH:
+            out << "    if ( " << this->expressionOf(operands[ 0 ]) << " )\n    {\n";
+            this->writeEdge(out, block, targets[ 0 ], "        ");
+            out << "    }\n";
+            this->writeEdge(out, block, targets[ 1 ], "    ");
+            break;
+
+        case ir::OP_SWITCH:
+            out << "    switch ( " << this->expressionOf(operands[ 0 ]) << " )\n    {\n";
+            for ( size_t i = 1; i < operands.size(); i++ )
+            {
+                out << "        case " << this->expressionOf(operands[ i ]) << ":\n";
+                this->writeEdge(out, block, targets[ i ], "            ");
+            }
+            out << "        default:\n";
+            this->writeEdge(out, block, targets[ 0 ], "            ");
+            out << "    }\n";
+            break;
+
+        case ir::OP_RETURN:
+            if ( operands.empty())
+            {
+                out << "    return;\n";
+            }
+            else
+            {
+                out << "    return " << this->expressionOf(operands[ 0 ], this->function->returnType) << ";\n";
+            }
+            break;
+
+        case ir::OP_INVOKE:
+            out << ( instruction->type != ir::IR_VOID ? "    " + valueName(instruction) + " = " : "    " )
+                << this->callOf(instruction) << ";\n";
+            if ( this->exceptions->mayThrow(operands[ 0 ]))
+            {
+                out << "    if ( " EXCEPTION_FLAG_SYMBOL " )\n    {\n";
+                this->writeEdge(out, block, targets[ 1 ], "        ");
+                out << "    }\n";
+                this->raisesExceptions = true;
+            }
+            this->writeEdge(out, block, targets[ 0 ], "    ");
+            break;
+
+        case ir::OP_THROW:
+            this->writeRaise(out, operands[ 0 ]);
+            if ( targets.empty())
+            {
+                out << "    " << unwind << "\n";
+            }
+            else
+            {
+                this->writeEdge(out, block, targets[ 0 ], "    ");
+            }
+            break;
+
+        default:
+            out << "    STRIDE_UNREACHABLE();\n";
+            break;
+    }
+}
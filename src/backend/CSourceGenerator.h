@@ -0,0 +1,84 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_CSOURCEGENERATOR_H
+#define STRIDE_LANGUAGE_CSOURCEGENERATOR_H
+
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <unordered_map>
+#include "../ir/ExceptionAnalysis.h"
+#include "../ir/IR.h"
+#include "../semantic/LayoutEngine.h"
+
+namespace stride::backend
+{
+
+    /**
+     * Translates the IR of a module to portable C11, which a C compiler can optimize to native code.
+     *
+     * Functions and globals keep the symbols of the native backend, and objects keep the layout of
+     * the layout engine; fields are addressed by their offset, so units compiled either way can be
+     * linked together. Functions of other units that weren't declared with their parameters, such
+     * as the ones of the runtime, are declared without a prototype, so their arguments are promoted
+     * as the ones of variadic functions are.
+     *
+     * Every value becomes a local variable, and every block a label. Phi nodes are assigned on the
+     * edges that lead to their block. Exceptions are raised the way the native backend raises them,
+     * through the same flag and value, which are common symbols.
+     */
+    class CSourceGenerator
+    {
+    private:
+        semantic::LayoutEngine &layouts;
+        std::unique_ptr<ir::ExceptionAnalysis> exceptions;
+        std::unordered_map<std::string, std::string> stringNames;
+        std::ostringstream strings;
+        bool raisesExceptions = false;
+        const ir::Function *function = nullptr;
+
+        /**
+         * Returns the name of the constant array that holds a string, which is declared once.
+         */
+        std::string stringName(const std::string &value);
+
+        std::string expressionOf(ir::Value *value);
+
+        /**
+         * Returns a value converted to a type; the IR may use a value of another type where the
+         * native backend only needs its register, such as a caught exception that's returned.
+         */
+        std::string expressionOf(ir::Value *value, ir::EIRType type);
+
+        void writeDeclaration(std::ostream &out, const ir::Function &function);
+
+        void writeFunction(std::ostream &out, const ir::Function &function);
+
+        void writeInstruction(std::ostream &out, ir::Instruction *instruction);
+
+        void writeTerminator(std::ostream &out, ir::Instruction *instruction);
+
+        /**
+         * Assigns the phi nodes of a successor, and continues there.
+         */
+        void writeEdge(std::ostream &out, const ir::BasicBlock *predecessor, const ir::BasicBlock *successor,
+                       const char *indentation);
+
+        std::string callOf(ir::Instruction *instruction);
+
+        /**
+         * Stores the exception flag and value, before the thrown value continues at a handler or returns.
+         */
+        void writeRaise(std::ostream &out, ir::Value *value);
+
+    public:
+        explicit CSourceGenerator(semantic::LayoutEngine &layouts) : layouts(layouts)
+        {}
+
+        void write(const ir::Module &module, std::ostream &out);
+    };
+}
+
+#endif //STRIDE_LANGUAGE_CSOURCEGENERATOR_H
@@ -0,0 +1,43 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include "CodeGenerator.h"
+#include "AssemblyPrinter.h"
+#include "ElfWriter.h"
+#include "FrameLowering.h"
+#include "InstructionSelector.h"
+#include "LinearScanAllocator.h"
+#include "MachineCodeEncoder.h"
+
+using namespace stride::backend;
+
+CodeGenerator::CodeGenerator(semantic::LayoutEngine &layouts) :
+        layouts(layouts), allocator(std::make_unique<LinearScanAllocator>())
+{}
+
+void CodeGenerator::run(ir::Module &module)
+{
+    InstructionSelector selector(this->layouts, this->machineModule);
+    selector.run(module);
+    for ( auto &function: this->machineModule.functions )
+    {
+        this->allocator->allocate(*function);
+        lowerFrame(*function);
+    }
+}
+
+void CodeGenerator::writeAssembly(std::ostream &out) const
+{
+    AssemblyPrinter printer(out);
+    printer.print(this->machineModule);
+}
+
+void CodeGenerator::writeObject(std::ostream &out) const
+{
+    ObjectFile object;
+    MachineCodeEncoder encoder(object);
+    encoder.encode(this->machineModule);
+    ElfWriter writer(out);
+    writer.write(object);
+}
@@ -0,0 +1,56 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_CODEGENERATOR_H
+#define STRIDE_LANGUAGE_CODEGENERATOR_H
+
+#include <memory>
+#include <ostream>
+#include "MachineIR.h"
+#include "RegisterAllocator.h"
+#include "../ir/IR.h"
+#include "../semantic/LayoutEngine.h"
+
+namespace stride::backend
+{
+
+    /**
+     * Compiles the IR of a module to x86-64 machine code for the System V ABI.
+     *
+     * Instructions are selected with virtual registers, which the register
+     * allocator replaces; then the stack frame of every function is laid out.
+     * The result can be written as assembly for the GNU assembler, or encoded
+     * directly as a relocatable ELF object file, which needs no assembler.
+     *
+     * The code depends on the runtime for allocating objects and arrays,
+     * concatenating and comparing strings, and raising integers to a power.
+     */
+    class CodeGenerator
+    {
+    private:
+        semantic::LayoutEngine &layouts;
+        std::unique_ptr<RegisterAllocator> allocator;
+        MachineModule machineModule;
+
+    public:
+        explicit CodeGenerator(semantic::LayoutEngine &layouts);
+
+        void run(ir::Module &module);
+
+        [[nodiscard]] const MachineModule &getMachineModule() const
+        { return this->machineModule; }
+
+        /**
+         * Writes the machine code as assembly in the syntax of the GNU assembler.
+         */
+        void writeAssembly(std::ostream &out) const;
+
+        /**
+         * Writes the machine code as a relocatable ELF object file, which the output must be opened in binary for.
+         */
+        void writeObject(std::ostream &out) const;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_CODEGENERATOR_H
@@ -0,0 +1,269 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <unordered_map>
+#include "ElfWriter.h"
+
+using namespace stride::backend;
+
+#define SHT_PROGBITS 1
+#define SHT_SYMTAB 2
+#define SHT_STRTAB 3
+#define SHT_RELA 4
+#define SHT_NOBITS 8
+#define SHT_INIT_ARRAY 14
+
+#define SHF_WRITE 0x1
+#define SHF_ALLOC 0x2
+#define SHF_EXECINSTR 0x4
+#define SHF_INFO_LINK 0x40
+
+#define STB_LOCAL 0
+#define STB_GLOBAL 1
+#define STT_NOTYPE 0
+#define STT_OBJECT 1
+#define STT_FUNC 2
+#define STT_SECTION 3
+#define STT_FILE 4
+
+#define SHN_UNDEF 0
+#define SHN_ABS 0xFFF1
+#define SHN_COMMON 0xFFF2
+
+#define ELF_HEADER_SIZE 64
+#define SECTION_HEADER_SIZE 64
+#define SYMBOL_SIZE 24
+#define RELOCATION_SIZE 24
+
+namespace
+{
+    struct SectionHeader
+    {
+        std::string name;
+        uint32_t type;
+        uint64_t flags;
+        std::vector<uint8_t> bytes {};
+
+        /**
+         * The size of the section; the amount of bytes, unless it has none in the file.
+         */
+        uint64_t size = 0;
+        uint32_t link = 0;
+        uint32_t info = 0;
+        uint64_t alignment = 1;
+        uint64_t entrySize = 0;
+        uint64_t offset = 0;
+    };
+
+    /**
+     * The names and flags of the sections of an object file, in the order of ESectionKind.
+     */
+    struct SectionKind
+    {
+        const char *name;
+        uint32_t type;
+        uint64_t flags;
+    };
+
+    const SectionKind SECTION_KINDS[] = {
+            { ".text",       SHT_PROGBITS,   SHF_ALLOC | SHF_EXECINSTR },
+            { ".data",       SHT_PROGBITS,   SHF_ALLOC | SHF_WRITE },
+            { ".bss",        SHT_NOBITS,     SHF_ALLOC | SHF_WRITE },
+            { ".rodata",     SHT_PROGBITS,   SHF_ALLOC },
+            { ".init_array", SHT_INIT_ARRAY, SHF_ALLOC | SHF_WRITE }
+    };
+}
+
+/**
+ * Appends an integer of a size in bytes, in little endian order.
+ */
+static void put(std::vector<uint8_t> &bytes, uint64_t value, int size)
+{
+    for ( int i = 0; i < size; i++ )
+    {
+        bytes.push_back((uint8_t) ( value >> ( i * 8 )));
+    }
+}
+
+/**
+ * Appends a name to a string table, and returns its offset.
+ */
+static uint32_t addString(std::vector<uint8_t> &table, const std::string &string)
+{
+    auto offset = (uint32_t) table.size();
+    table.insert(table.end(), string.begin(), string.end());
+    table.push_back(0);
+    return offset;
+}
+
+static void putSymbol(std::vector<uint8_t> &table, uint32_t name, uint8_t bind, uint8_t type, uint16_t section,
+                      uint64_t value, uint64_t size)
+{
+    put(table, name, 4);
+    put(table, ( bind << 4 ) | type, 1);
+    put(table, 0, 1);
+    put(table, section, 2);
+    put(table, value, 8);
+    put(table, size, 8);
+}
+
+void ElfWriter::write(const ObjectFile &object)
+{
+    // The sections of the unit, followed by their relocations; the .text, .data and .bss sections are always there.
+    std::vector<SectionHeader> sections(1);
+    int32_t indices[SECTION_COUNT];
+    int32_t relocationIndices[SECTION_COUNT];
+    for ( int kind = 0; kind < SECTION_COUNT; kind++ )
+    {
+        const ObjectSection &section = object.sections[ kind ];
+        uint64_t size = kind == SECTION_BSS ? section.size : section.bytes.size();
+        indices[ kind ] = relocationIndices[ kind ] = -1;
+        if ( size == 0 && kind > SECTION_BSS )
+        {
+            continue;
+        }
+        indices[ kind ] = (int32_t) sections.size();
+        sections.push_back({ SECTION_KINDS[ kind ].name, SECTION_KINDS[ kind ].type, SECTION_KINDS[ kind ].flags,
+                             section.bytes, size });
+        sections.back().alignment = section.alignment;
+        sections.back().entrySize = kind == SECTION_INIT_ARRAY ? 8 : 0;
+        if ( !section.relocations.empty())
+        {
+            relocationIndices[ kind ] = (int32_t) sections.size();
+            sections.push_back({ std::string(".rela") + SECTION_KINDS[ kind ].name, SHT_RELA, SHF_INFO_LINK });
+        }
+    }
+    sections.push_back({ ".note.GNU-stack", SHT_PROGBITS, 0 });
+    auto symbolTableIndex = (uint32_t) sections.size();
+    sections.push_back({ ".symtab", SHT_SYMTAB, 0 });
+    sections.push_back({ ".strtab", SHT_STRTAB, 0 });
+    sections.push_back({ ".shstrtab", SHT_STRTAB, 0 });
+
+    // Local symbols precede the global ones; sh_info of the symbol table is the index of the first global one.
+    std::vector<uint8_t> symbols;
+    std::vector<uint8_t> strings = { 0 };
+    std::unordered_map<std::string, uint32_t> symbolIndices;
+    uint32_t sectionSymbols[SECTION_COUNT];
+    putSymbol(symbols, 0, STB_LOCAL, STT_NOTYPE, SHN_UNDEF, 0, 0);
+    putSymbol(symbols, addString(strings, object.sourceName), STB_LOCAL, STT_FILE, SHN_ABS, 0, 0);
+    for ( int kind = 0; kind < SECTION_COUNT; kind++ )
+    {
+        if ( indices[ kind ] >= 0 )
+        {
+            sectionSymbols[ kind ] = symbols.size() / SYMBOL_SIZE;
+            putSymbol(symbols, 0, STB_LOCAL, STT_SECTION, indices[ kind ], 0, 0);
+        }
+    }
+    uint32_t firstGlobal = 0;
+    for ( bool global: { false, true } )
+    {
+        firstGlobal = global ? symbols.size() / SYMBOL_SIZE : firstGlobal;
+        for ( auto &symbol: object.symbols )
+        {
+            if ( symbol.global != global )
+            {
+                continue;
+            }
+            uint16_t section = symbol.common ? SHN_COMMON :
+                               symbol.section == SECTION_UNDEFINED ? SHN_UNDEF : indices[ symbol.section ];
+            uint8_t type = symbol.section == SECTION_UNDEFINED && !symbol.common ? STT_NOTYPE :
+                           symbol.function ? STT_FUNC : STT_OBJECT;
+            symbolIndices[ symbol.name ] = symbols.size() / SYMBOL_SIZE;
+            putSymbol(symbols, addString(strings, symbol.name), global ? STB_GLOBAL : STB_LOCAL, type, section,
+                      symbol.value, symbol.size);
+        }
+    }
+    sections[ symbolTableIndex ].bytes = std::move(symbols);
+    sections[ symbolTableIndex ].link = symbolTableIndex + 1;
+    sections[ symbolTableIndex ].info = firstGlobal;
+    sections[ symbolTableIndex ].alignment = 8;
+    sections[ symbolTableIndex ].entrySize = SYMBOL_SIZE;
+    sections[ symbolTableIndex + 1 ].bytes = std::move(strings);
+
+    for ( int kind = 0; kind < SECTION_COUNT; kind++ )
+    {
+        if ( relocationIndices[ kind ] < 0 )
+        {
+            continue;
+        }
+        SectionHeader &header = sections[ relocationIndices[ kind ]];
+        for ( auto &relocation: object.sections[ kind ].relocations )
+        {
+            uint64_t symbol = relocation.symbol.empty() ? sectionSymbols[ relocation.section ] :
+                              symbolIndices.at(relocation.symbol);
+            put(header.bytes, relocation.offset, 8);
+            put(header.bytes, ( symbol << 32 ) | relocation.type, 8);
+            put(header.bytes, relocation.addend, 8);
+        }
+        header.link = symbolTableIndex;
+        header.info = indices[ kind ];
+        header.alignment = 8;
+        header.entrySize = RELOCATION_SIZE;
+    }
+
+    // The names of the sections, and their place in the file; the section headers are last.
+    std::vector<uint8_t> names = { 0 };
+    std::vector<uint32_t> nameOffsets(sections.size());
+    for ( size_t i = 1; i < sections.size(); i++ )
+    {
+        nameOffsets[ i ] = addString(names, sections[ i ].name);
+    }
+    sections.back().bytes = std::move(names);
+
+    uint64_t offset = ELF_HEADER_SIZE;
+    for ( size_t i = 1; i < sections.size(); i++ )
+    {
+        SectionHeader &section = sections[ i ];
+        if ( section.type != SHT_NOBITS )
+        {
+            section.size = section.bytes.size();
+        }
+        offset = ( offset + section.alignment - 1 ) / section.alignment * section.alignment;
+        section.offset = offset;
+        offset += section.type == SHT_NOBITS ? 0 : section.size;
+    }
+    uint64_t headersOffset = ( offset + 7 ) / 8 * 8;
+
+    std::vector<uint8_t> file = { 0x7F, 'E', 'L', 'F', 2, 1, 1, 0 }; // 64 bits, little endian, version 1, System V
+    put(file, 0, 8);
+    put(file, 1, 2);  // A relocatable file
+    put(file, 62, 2); // x86-64
+    put(file, 1, 4);
+    put(file, 0, 8);  // No entry point
+    put(file, 0, 8);  // No program headers
+    put(file, headersOffset, 8);
+    put(file, 0, 4);
+    put(file, ELF_HEADER_SIZE, 2);
+    put(file, 0, 2);
+    put(file, 0, 2);
+    put(file, SECTION_HEADER_SIZE, 2);
+    put(file, sections.size(), 2);
+    put(file, sections.size() - 1, 2); // The names of the sections are in the last one
+
+    for ( size_t i = 1; i < sections.size(); i++ )
+    {
+        if ( sections[ i ].type != SHT_NOBITS )
+        {
+            file.resize(sections[ i ].offset, 0);
+            file.insert(file.end(), sections[ i ].bytes.begin(), sections[ i ].bytes.end());
+        }
+    }
+    file.resize(headersOffset, 0);
+    put(file, 0, SECTION_HEADER_SIZE);
+    for ( size_t i = 1; i < sections.size(); i++ )
+    {
+        SectionHeader &section = sections[ i ];
+        put(file, nameOffsets[ i ], 4);
+        put(file, section.type, 4);
+        put(file, section.flags, 8);
+        put(file, 0, 8);
+        put(file, section.offset, 8);
+        put(file, section.size, 8);
+        put(file, section.link, 4);
+        put(file, section.info, 4);
+        put(file, section.alignment, 8);
+        put(file, section.entrySize, 8);
+    }
+    this->out.write(reinterpret_cast<const char *>(file.data()), (std::streamsize) file.size());
+}
@@ -0,0 +1,32 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_ELFWRITER_H
+#define STRIDE_LANGUAGE_ELFWRITER_H
+
+#include <ostream>
+#include "ObjectFile.h"
+
+namespace stride::backend
+{
+
+    /**
+     * Writes an object file as a relocatable ELF64 file for x86-64, as the GNU assembler would;
+     * the sections of the unit, with their relocations, and a symbol table in which the local
+     * symbols precede the global ones, as the format requires.
+     */
+    class ElfWriter
+    {
+    private:
+        std::ostream &out;
+
+    public:
+        explicit ElfWriter(std::ostream &out) : out(out)
+        {}
+
+        void write(const ObjectFile &object);
+    };
+}
+
+#endif //STRIDE_LANGUAGE_ELFWRITER_H
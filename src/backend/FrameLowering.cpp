@@ -0,0 +1,119 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include "FrameLowering.h"
+
+using namespace stride::backend;
+
+/** The stack is aligned to this many bytes at every call. */
+#define STACK_ALIGNMENT 16
+
+static int32_t alignUp(int32_t offset, int32_t alignment)
+{
+    return ( offset + alignment - 1 ) / alignment * alignment;
+}
+
+static std::unique_ptr<MachineInstruction> create(EMachineOpcode opcode, std::vector<MachineOperand> operands)
+{
+    return std::make_unique<MachineInstruction>(opcode, std::move(operands));
+}
+
+void stride::backend::lowerFrame(MachineFunction &function)
+{
+    // The frame pointer is saved by the prologue itself.
+    for ( auto &block: function.blocks )
+    {
+        for ( auto &instruction: block->instructions )
+        {
+            instruction->forEachDef([ & ](uint32_t reg)
+                                    {
+                                        if ( !isVirtual(reg) && reg != RBP && isCalleeSaved((ERegister) reg) &&
+                                             std::find(function.savedRegisters.begin(), function.savedRegisters.end(),
+                                                       (ERegister) reg) == function.savedRegisters.end())
+                                        {
+                                            function.savedRegisters.push_back((ERegister) reg);
+                                        }
+                                    });
+        }
+    }
+    std::vector<int32_t> saveSlots;
+    for ( size_t i = 0; i < function.savedRegisters.size(); i++ )
+    {
+        saveSlots.push_back(function.createSlot(8, 8));
+    }
+
+    // Slots are placed below the frame pointer, in order.
+    int32_t offset = 0;
+    for ( auto &slot: function.slots )
+    {
+        offset = alignUp(offset + (int32_t) slot.size, (int32_t) slot.alignment);
+        slot.offset = -offset;
+    }
+    function.frameSize = (uint32_t) alignUp(offset, STACK_ALIGNMENT);
+
+    for ( auto &block: function.blocks )
+    {
+        for ( auto &instruction: block->instructions )
+        {
+            for ( auto &operand: instruction->operands )
+            {
+                if ( operand.isMemory() && operand.slot >= 0 )
+                {
+                    operand.reg = RBP;
+                    operand.immediate += function.slots[ operand.slot ].offset;
+                    operand.slot = -1;
+                }
+            }
+        }
+    }
+
+    // The prologue.
+    std::vector<std::unique_ptr<MachineInstruction>> prologue;
+    prologue.push_back(create(MI_PUSH, { MachineOperand::use(RBP, 8) }));
+    prologue.push_back(create(MI_MOV, { MachineOperand::use(RSP, 8), MachineOperand::def(RBP, 8) }));
+    if ( function.frameSize > 0 )
+    {
+        prologue.push_back(create(MI_SUB, { MachineOperand::imm(function.frameSize, 8), MachineOperand::useDef(RSP, 8) }));
+    }
+    for ( size_t i = 0; i < function.savedRegisters.size(); i++ )
+    {
+        prologue.push_back(create(MI_MOV, { MachineOperand::use(function.savedRegisters[ i ], 8),
+                                            MachineOperand::memory(RBP, function.slots[ saveSlots[ i ]].offset, 8) }));
+    }
+    auto &entry = function.blocks.front()->instructions;
+    entry.insert(entry.begin(), std::make_move_iterator(prologue.begin()), std::make_move_iterator(prologue.end()));
+
+    for ( size_t b = 0; b < function.blocks.size(); b++ )
+    {
+        MachineBlock &block = *function.blocks[ b ];
+        std::vector<std::unique_ptr<MachineInstruction>> lowered;
+        for ( auto &instruction: block.instructions )
+        {
+            // The epilogues.
+            if ( instruction->opcode == MI_RET )
+            {
+                for ( size_t i = 0; i < function.savedRegisters.size(); i++ )
+                {
+                    lowered.push_back(create(MI_MOV, { MachineOperand::memory(RBP, function.slots[ saveSlots[ i ]].offset, 8),
+                                                       MachineOperand::def(function.savedRegisters[ i ], 8) }));
+                }
+                lowered.push_back(create(MI_LEAVE, {}));
+            }
+
+            // Jumps to the next block fall through.
+            if ( instruction->opcode == MI_JMP && b + 1 < function.blocks.size() &&
+                 instruction->operands[ 0 ].block == function.blocks[ b + 1 ].get())
+            {
+                continue;
+            }
+            if ( instruction->opcode == MI_COPY && instruction->operands[ 0 ].reg == instruction->operands[ 1 ].reg )
+            {
+                continue;
+            }
+            lowered.push_back(std::move(instruction));
+        }
+        block.instructions = std::move(lowered);
+    }
+}
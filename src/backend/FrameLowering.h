@@ -0,0 +1,26 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_FRAMELOWERING_H
+#define STRIDE_LANGUAGE_FRAMELOWERING_H
+
+#include "MachineIR.h"
+
+namespace stride::backend
+{
+
+    /**
+     * Lays out the stack frame of a function once its registers are allocated,
+     * and adds the prologue and epilogues.
+     *
+     * The frame pointer is kept in rbp; stack slots and the callee saved registers
+     * the function writes are stored below it, and the frame is padded to 16 bytes,
+     * so the stack is aligned at calls. Every return restores the saved registers
+     * and leaves the frame. Afterwards, jumps to the next block are removed, as are
+     * copies of a register to itself.
+     */
+    void lowerFrame(MachineFunction &function);
+}
+
+#endif //STRIDE_LANGUAGE_FRAMELOWERING_H
@@ -0,0 +1,1313 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include <cstring>
+#include "InstructionSelector.h"
+#include "../ir/Dominators.h"
+#include "../ir/IRGenerator.h"
+#include "../ir/Loops.h"
+#include "../passes/SwitchLowering.h"
+
+using namespace stride;
+using namespace stride::backend;
+
+static const ERegister INTEGER_ARGUMENTS[] = { RDI, RSI, RDX, RCX, R8, R9 };
+static const size_t INTEGER_ARGUMENT_COUNT = 6;
+static const size_t FLOAT_ARGUMENT_COUNT = 8;
+
+static uint8_t widthOf(ir::EIRType type)
+{
+    return (uint8_t) ir::sizeOf(type);
+}
+
+static ERegisterClass classFor(ir::EIRType type)
+{
+    return ir::isFloat(type) ? CLASS_XMM : CLASS_GPR;
+}
+
+static bool fitsImmediate(int64_t value)
+{
+    return value >= INT32_MIN && value <= INT32_MAX;
+}
+
+static bool isIntegerConstant(const ir::Value *value)
+{
+    return ( value->kind == ir::VALUE_CONSTANT && !static_cast<const ir::Constant *>(value)->isString &&
+             !ir::isFloat(value->type)) || ( value->kind == ir::VALUE_UNDEFINED && !ir::isFloat(value->type));
+}
+
+static int64_t integerOf(const ir::Value *value)
+{
+    return value->kind == ir::VALUE_CONSTANT ? static_cast<const ir::Constant *>(value)->integer : 0;
+}
+
+static ECondition conditionOf(ir::EPredicate predicate)
+{
+    static const ECondition conditions[] = { COND_E, COND_NE, COND_L, COND_LE, COND_G, COND_GE,
+                                             COND_B, COND_BE, COND_A, COND_AE };
+    return conditions[ predicate ];
+}
+
+/**
+ * Returns the predicate that holds when the operands are swapped.
+ */
+static ir::EPredicate swapped(ir::EPredicate predicate)
+{
+    switch ( predicate )
+    {
+        case ir::PREDICATE_LT:
+            return ir::PREDICATE_GT;
+        case ir::PREDICATE_LE:
+            return ir::PREDICATE_GE;
+        case ir::PREDICATE_GT:
+            return ir::PREDICATE_LT;
+        case ir::PREDICATE_GE:
+            return ir::PREDICATE_LE;
+        case ir::PREDICATE_ULT:
+            return ir::PREDICATE_UGT;
+        case ir::PREDICATE_ULE:
+            return ir::PREDICATE_UGE;
+        case ir::PREDICATE_UGT:
+            return ir::PREDICATE_ULT;
+        case ir::PREDICATE_UGE:
+            return ir::PREDICATE_ULE;
+        default:
+            return predicate;
+    }
+}
+
+static std::vector<uint8_t> bytesOf(uint64_t bits, uint32_t size)
+{
+    std::vector<uint8_t> bytes(size);
+    for ( uint32_t i = 0; i < size; i++ )
+    {
+        bytes[ i ] = (uint8_t) ( bits >> ( i * 8 ));
+    }
+    return bytes;
+}
+
+static uint64_t bitsOf(ir::EIRType type, double value)
+{
+    if ( type == ir::IR_F32 )
+    {
+        auto single = (float) value;
+        uint32_t bits;
+        std::memcpy(&bits, &single, sizeof(bits));
+        return bits;
+    }
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// Module
+
+void InstructionSelector::run(ir::Module &module)
+{
+    this->output.sourceName = module.name;
+    this->exceptions = std::make_unique<ir::ExceptionAnalysis>(module);
+    this->selectData(module);
+    for ( auto function: module.functions )
+    {
+        if ( !function->external && !function->blocks.empty())
+        {
+            function->renumber();
+            this->selectFunction(*function);
+        }
+    }
+    if ( this->raisesExceptions )
+    {
+        this->output.commonSymbols.emplace_back(EXCEPTION_VALUE_SYMBOL, 8);
+        this->output.commonSymbols.emplace_back(EXCEPTION_FLAG_SYMBOL, 1);
+    }
+}
+
+void InstructionSelector::selectData(const ir::Module &module)
+{
+    for ( auto global: module.globals )
+    {
+        DataObject object;
+        object.symbol = ir::mangle(global->name);
+        object.size = std::max(ir::sizeOf(global->valueType), 1u);
+        object.alignment = object.size;
+        object.exported = true;
+
+        ir::Constant *initializer = global->initializer;
+        if ( initializer != nullptr && initializer->isString )
+        {
+            object.reference = this->stringLabel(initializer->string);
+        }
+        else if ( initializer != nullptr && ir::isFloat(initializer->type))
+        {
+            object.bytes = bytesOf(bitsOf(initializer->type, initializer->floating), object.size);
+        }
+        else if ( initializer != nullptr && initializer->integer != 0 )
+        {
+            object.bytes = bytesOf((uint64_t) initializer->integer, object.size);
+        }
+        this->output.data.push_back(std::move(object));
+    }
+}
+
+std::string InstructionSelector::stringLabel(const std::string &value)
+{
+    auto known = this->stringLabels.find(value);
+    if ( known != this->stringLabels.end())
+    {
+        return known->second;
+    }
+    DataObject object;
+    object.symbol = ".Lstr." + std::to_string(this->stringLabels.size());
+    object.alignment = 1;
+    object.size = (uint32_t) value.size() + 1;
+    object.bytes.assign(value.begin(), value.end());
+    object.bytes.push_back(0);
+    object.readOnly = true;
+    this->stringLabels[ value ] = object.symbol;
+    this->output.data.push_back(object);
+    return object.symbol;
+}
+
+std::string InstructionSelector::constantLabel(ir::EIRType type, double value)
+{
+    uint64_t bits = bitsOf(type, value);
+    auto known = this->constantLabels.find({ type, bits });
+    if ( known != this->constantLabels.end())
+    {
+        return known->second;
+    }
+    DataObject object;
+    object.symbol = ".Lconst." + std::to_string(this->constantLabels.size());
+    object.size = widthOf(type);
+    object.alignment = object.size;
+    object.bytes = bytesOf(bits, object.size);
+    object.readOnly = true;
+    this->constantLabels[ { type, bits } ] = object.symbol;
+    this->output.data.push_back(object);
+    return object.symbol;
+}
+
+// Functions
+
+void InstructionSelector::selectFunction(const ir::Function &source)
+{
+    this->output.functions.push_back(std::make_unique<MachineFunction>(ir::mangle(source.name)));
+    this->machine = this->output.functions.back().get();
+    this->machine->exported = source.name != MODULE_INITIALIZER_NAME;
+    if ( !this->machine->exported )
+    {
+        this->output.constructors.push_back(this->machine->symbol);
+    }
+    this->function = &source;
+    this->unwind = nullptr;
+    this->currentDepth = 0;
+    this->registers.clear();
+    this->blocks.clear();
+    this->edges.clear();
+
+    // Every value that isn't a constant gets a register of its own, so values can be used before they're selected.
+    for ( auto argument: source.arguments )
+    {
+        this->registers[ argument ] = this->machine->createRegister(classFor(argument->type));
+    }
+    for ( auto block: source.blocks )
+    {
+        for ( auto instruction: block->instructions )
+        {
+            if ( instruction->type != ir::IR_VOID )
+            {
+                this->registers[ instruction ] = this->machine->createRegister(classFor(instruction->type));
+            }
+        }
+    }
+
+    // The arguments are moved out of the registers they're passed in, or loaded from above the return address.
+    this->current = this->createBlock("entry");
+    size_t integers = 0, floats = 0;
+    int64_t stackOffset = 16;
+    for ( auto argument: source.arguments )
+    {
+        uint32_t reg = this->registers[ argument ];
+        uint8_t size = widthOf(argument->type);
+        if ( ir::isFloat(argument->type) && floats < FLOAT_ARGUMENT_COUNT )
+        {
+            this->emit(MI_COPY, { MachineOperand::use(XMM0 + floats++, 8), MachineOperand::def(reg, 8) });
+        }
+        else if ( !ir::isFloat(argument->type) && integers < INTEGER_ARGUMENT_COUNT )
+        {
+            this->emit(MI_COPY, { MachineOperand::use(INTEGER_ARGUMENTS[ integers++ ], 8),
+                                  MachineOperand::def(reg, 8) });
+        }
+        else
+        {
+            this->emit(ir::isFloat(argument->type) ? MI_MOVF : MI_MOV,
+                       { MachineOperand::memory(RBP, stackOffset, size), MachineOperand::def(reg, size) });
+            stackOffset += 8;
+        }
+    }
+
+    ir::DominatorTree dominators(source);
+    ir::LoopInfo loops(source, dominators);
+    for ( auto block: source.blocks )
+    {
+        ir::Loop *loop = loops.loopOf(block);
+        this->currentDepth = loop != nullptr ? loop->depth : 0;
+        this->blocks[ block ] = this->createBlock(block->label);
+    }
+    this->jumpTo(this->blocks[ source.entry() ]);
+
+    for ( auto block: source.blocks )
+    {
+        this->current = this->blocks[ block ];
+        this->currentDepth = this->current->loopDepth;
+        for ( auto instruction: block->instructions )
+        {
+            if ( instruction->isTerminator())
+            {
+                this->selectTerminator(instruction);
+            }
+            else
+            {
+                this->selectInstruction(instruction);
+            }
+        }
+    }
+    this->machine->renumber();
+}
+
+MachineInstruction *InstructionSelector::emit(EMachineOpcode opcode, std::vector<MachineOperand> operands)
+{
+    return this->current->append(opcode, std::move(operands));
+}
+
+MachineBlock *InstructionSelector::createBlock(const std::string &name)
+{
+    MachineBlock *block = this->machine->createBlock(name);
+    block->loopDepth = this->currentDepth;
+    return block;
+}
+
+void InstructionSelector::jumpTo(MachineBlock *target)
+{
+    this->emit(MI_JMP, { MachineOperand::target(target) });
+    this->current->addSuccessor(target);
+}
+
+void InstructionSelector::branchTo(ECondition condition, MachineBlock *target)
+{
+    this->emit(MI_JCC, { MachineOperand::target(target) })->condition = condition;
+    this->current->addSuccessor(target);
+}
+
+// Operands
+
+uint32_t InstructionSelector::registerOf(ir::Value *value)
+{
+    auto known = this->registers.find(value);
+    if ( known != this->registers.end())
+    {
+        return known->second;
+    }
+
+    // Constants and addresses are materialized where they're used, which keeps their registers short-lived.
+    uint8_t size = widthOf(value->type);
+    uint32_t reg = this->machine->createRegister(classFor(value->type));
+    switch ( value->kind )
+    {
+        case ir::VALUE_CONSTANT:
+        case ir::VALUE_UNDEFINED:
+        {
+            auto constant = value->kind == ir::VALUE_CONSTANT ? static_cast<ir::Constant *>(value) : nullptr;
+            if ( constant != nullptr && constant->isString )
+            {
+                this->emit(MI_LEA, { MachineOperand::global(this->stringLabel(constant->string), 8),
+                                     MachineOperand::def(reg, 8) });
+            }
+            else if ( ir::isFloat(value->type))
+            {
+                std::string label = this->constantLabel(value->type, constant != nullptr ? constant->floating : 0);
+                this->emit(MI_MOVF, { MachineOperand::global(label, size), MachineOperand::def(reg, size) });
+            }
+            else
+            {
+                this->emit(MI_MOV, { MachineOperand::imm(integerOf(value), std::max<uint8_t>(size, 4)),
+                                     MachineOperand::def(reg, std::max<uint8_t>(size, 4)) });
+            }
+            break;
+        }
+        case ir::VALUE_GLOBAL:
+            this->emit(MI_LEA, { MachineOperand::global(ir::mangle(static_cast<ir::Global *>(value)->name), 8),
+                                 MachineOperand::def(reg, 8) });
+            break;
+        case ir::VALUE_FUNCTION:
+        {
+            // Functions of shared libraries are addressed through the global offset table.
+            auto callee = static_cast<ir::Function *>(value);
+            MachineOperand address = MachineOperand::global(ir::mangle(callee->name), 8);
+            address.external = callee->external;
+            this->emit(callee->external ? MI_MOV : MI_LEA, { address, MachineOperand::def(reg, 8) });
+            break;
+        }
+        default:
+            break;
+    }
+    return reg;
+}
+
+MachineOperand InstructionSelector::operandOf(ir::Value *value)
+{
+    if ( isIntegerConstant(value) && fitsImmediate(integerOf(value)))
+    {
+        return MachineOperand::imm(integerOf(value), widthOf(value->type));
+    }
+    return MachineOperand::use(this->registerOf(value), widthOf(value->type));
+}
+
+MachineOperand InstructionSelector::memoryAt(ir::Value *address, uint8_t size)
+{
+    if ( address->kind == ir::VALUE_GLOBAL )
+    {
+        return MachineOperand::global(ir::mangle(static_cast<ir::Global *>(address)->name), size);
+    }
+    if ( address->kind == ir::VALUE_INSTRUCTION && this->isFoldedAddress(static_cast<ir::Instruction *>(address)))
+    {
+        auto field = static_cast<ir::Instruction *>(address);
+        return MachineOperand::memory(this->registerOf(field->operands[ 0 ]), this->layouts.fieldOffset(field->field),
+                                      size);
+    }
+    return MachineOperand::memory(this->registerOf(address), 0, size);
+}
+
+void InstructionSelector::moveTo(uint32_t reg, ir::Value *value)
+{
+    if ( isIntegerConstant(value))
+    {
+        uint8_t size = std::max<uint8_t>(widthOf(value->type), 4);
+        this->emit(MI_MOV, { MachineOperand::imm(integerOf(value), size), MachineOperand::def(reg, size) });
+        return;
+    }
+    this->emit(MI_COPY, { MachineOperand::use(this->registerOf(value), 8), MachineOperand::def(reg, 8) });
+}
+
+bool InstructionSelector::isFoldedAddress(const ir::Instruction *instruction) const
+{
+    if ( instruction->opcode != ir::OP_FIELD_ADDRESS )
+    {
+        return false;
+    }
+    for ( auto user: instruction->users )
+    {
+        bool isAddress = ( user->opcode == ir::OP_LOAD ) ||
+                         ( user->opcode == ir::OP_STORE && user->operands[ 1 ] != instruction );
+        if ( !isAddress )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool InstructionSelector::isFusedComparison(const ir::Instruction *instruction) const
+{
+    // The comparison sets the flags the branch that directly follows it tests.
+    const ir::BasicBlock *block = instruction->block;
+    return instruction->opcode == ir::OP_ICMP && instruction->users.size() == 1 &&
+           instruction->users[ 0 ]->opcode == ir::OP_CONDITIONAL_BRANCH && instruction->users[ 0 ]->block == block &&
+           block->instructions.size() >= 2 && block->instructions[ block->instructions.size() - 2 ] == instruction;
+}
+
+// Instructions
+
+void InstructionSelector::selectInstruction(ir::Instruction *instruction)
+{
+    uint32_t result = instruction->type != ir::IR_VOID ? this->registers[ instruction ] : NO_REGISTER;
+    uint8_t size = widthOf(instruction->type);
+    auto &operands = instruction->operands;
+
+    switch ( instruction->opcode )
+    {
+        case ir::OP_PHI:
+            // Assigned by the copies at the end of the predecessors.
+            break;
+
+        case ir::OP_ADD:
+        case ir::OP_SUB:
+        case ir::OP_MUL:
+        case ir::OP_AND:
+        case ir::OP_OR:
+        case ir::OP_XOR:
+        {
+            static const EMachineOpcode opcodes[] = { MI_ADD, MI_SUB, MI_IMUL };
+            EMachineOpcode opcode = instruction->opcode == ir::OP_AND ? MI_AND :
+                                    instruction->opcode == ir::OP_OR ? MI_OR :
+                                    instruction->opcode == ir::OP_XOR ? MI_XOR :
+                                    opcodes[ instruction->opcode - ir::OP_ADD ];
+
+            // There's no multiplication of bytes that only writes its destination; the low byte of a wider one is the same.
+            uint8_t operationSize = opcode == MI_IMUL && size == 1 ? 4 : size;
+            this->moveTo(result, operands[ 0 ]);
+            MachineOperand source = this->operandOf(operands[ 1 ]);
+            source.size = operationSize;
+            this->emit(opcode, { source, MachineOperand::useDef(result, operationSize) });
+            break;
+        }
+
+        case ir::OP_SDIV:
+        case ir::OP_UDIV:
+        case ir::OP_SREM:
+        case ir::OP_UREM:
+        {
+            // The dividend is in rdx:rax; bytes and words are extended, so the remainder of a byte isn't in ah.
+            bool isSigned = instruction->opcode == ir::OP_SDIV || instruction->opcode == ir::OP_SREM;
+            uint8_t operationSize = std::max<uint8_t>(size, 4);
+            EMachineOpcode extend = isSigned ? MI_MOVSX : MI_MOVZX;
+            uint32_t divisor = this->registerOf(operands[ 1 ]);
+            if ( size < 4 )
+            {
+                uint32_t extended = this->machine->createRegister(CLASS_GPR);
+                this->emit(extend, { MachineOperand::use(divisor, size), MachineOperand::def(extended, 4) });
+                divisor = extended;
+                this->emit(extend, { MachineOperand::use(this->registerOf(operands[ 0 ]), size),
+                                     MachineOperand::def(RAX, 4) });
+            }
+            else
+            {
+                this->moveTo(RAX, operands[ 0 ]);
+            }
+            if ( isSigned )
+            {
+                this->emit(MI_SIGN_EXTEND_ACCUMULATOR, { MachineOperand::use(RAX, operationSize),
+                                                         MachineOperand::def(RDX, operationSize) });
+            }
+            else
+            {
+                this->emit(MI_MOV, { MachineOperand::imm(0, 4), MachineOperand::def(RDX, 4) });
+            }
+            MachineInstruction *division = this->emit(isSigned ? MI_IDIV : MI_DIV,
+                                                      { MachineOperand::use(divisor, operationSize) });
+            division->implicitUses = { RAX, RDX };
+            division->implicitDefs = { RAX, RDX };
+            bool isRemainder = instruction->opcode == ir::OP_SREM || instruction->opcode == ir::OP_UREM;
+            this->emit(MI_COPY, { MachineOperand::use(isRemainder ? RDX : RAX, 8), MachineOperand::def(result, 8) });
+            break;
+        }
+
+        case ir::OP_FADD:
+        case ir::OP_FSUB:
+        case ir::OP_FMUL:
+        case ir::OP_FDIV:
+        {
+            static const EMachineOpcode opcodes[] = { MI_ADDF, MI_SUBF, MI_MULF, MI_DIVF };
+            uint32_t right = this->registerOf(operands[ 1 ]);
+            this->moveTo(result, operands[ 0 ]);
+            this->emit(opcodes[ instruction->opcode - ir::OP_FADD ],
+                       { MachineOperand::use(right, size), MachineOperand::useDef(result, size) });
+            break;
+        }
+
+        case ir::OP_FREM:
+            this->emitCall(MachineOperand::function(size == 4 ? "fmodf" : "fmod", true), { operands[ 0 ], operands[ 1 ] },
+                           false, instruction->type, result);
+            break;
+
+        case ir::OP_SHL:
+        case ir::OP_LSHR:
+        case ir::OP_ASHR:
+        {
+            EMachineOpcode opcode = instruction->opcode == ir::OP_SHL ? MI_SHL :
+                                    instruction->opcode == ir::OP_LSHR ? MI_SHR : MI_SAR;
+            this->moveTo(result, operands[ 0 ]);
+            MachineOperand count = MachineOperand::use(RCX, 1);
+            if ( isIntegerConstant(operands[ 1 ]))
+            {
+                count = MachineOperand::imm(integerOf(operands[ 1 ]) & ( size * 8 - 1 ), 1);
+            }
+            else
+            {
+                this->moveTo(RCX, operands[ 1 ]);
+            }
+            this->emit(opcode, { count, MachineOperand::useDef(result, size) });
+            break;
+        }
+
+        case ir::OP_ICMP:
+        case ir::OP_FCMP:
+            if ( !this->isFusedComparison(instruction))
+            {
+                this->selectComparison(instruction, result);
+            }
+            break;
+
+        case ir::OP_TRUNC:
+        case ir::OP_ZEXT:
+        case ir::OP_SEXT:
+        case ir::OP_FPTRUNC:
+        case ir::OP_FPEXT:
+        case ir::OP_SITOFP:
+        case ir::OP_UITOFP:
+        case ir::OP_FPTOSI:
+        case ir::OP_FPTOUI:
+            this->selectConversion(instruction, result);
+            break;
+
+        case ir::OP_LOAD:
+            this->emit(ir::isFloat(instruction->type) ? MI_MOVF : MI_MOV,
+                       { this->memoryAt(operands[ 0 ], size), MachineOperand::def(result, size) });
+            break;
+
+        case ir::OP_STORE:
+        {
+            ir::Value *value = operands[ 1 ];
+            uint8_t valueSize = widthOf(value->type);
+            if ( ir::isFloat(value->type))
+            {
+                uint32_t source = this->registerOf(value);
+                this->emit(MI_MOVF, { MachineOperand::use(source, valueSize), this->memoryAt(operands[ 0 ], valueSize) });
+            }
+            else
+            {
+                MachineOperand source = this->operandOf(value);
+                this->emit(MI_MOV, { source, this->memoryAt(operands[ 0 ], valueSize) });
+            }
+            break;
+        }
+
+        case ir::OP_FIELD_ADDRESS:
+            if ( !this->isFoldedAddress(instruction))
+            {
+                this->emit(MI_LEA, { MachineOperand::memory(this->registerOf(operands[ 0 ]),
+                                                            this->layouts.fieldOffset(instruction->field), 8),
+                                     MachineOperand::def(result, 8) });
+            }
+            break;
+
+        case ir::OP_ALLOCATE:
+        {
+            // The arguments are assigned to the fields the type declares, in order of declaration.
+            const semantic::TypeLayout *layout = this->layouts.layoutOf(instruction->allocated);
+            uint32_t objectSize = std::max(layout != nullptr ? layout->size : 0, 1u);
+            ir::Module &module = *this->function->module;
+            this->emitCall(MachineOperand::function(RUNTIME_ALLOCATE, true), { module.integer(ir::IR_I64, objectSize) },
+                           false, ir::IR_PTR, result);
+            std::vector<const semantic::FieldLayout *> fields = this->layouts.declaredFields(instruction->allocated);
+            for ( size_t i = 0; i < operands.size() && i < fields.size(); i++ )
+            {
+                uint8_t valueSize = widthOf(operands[ i ]->type);
+                if ( fields[ i ]->size != valueSize )
+                {
+                    continue;
+                }
+                MachineOperand field = MachineOperand::memory(result, fields[ i ]->offset, valueSize);
+                if ( ir::isFloat(operands[ i ]->type))
+                {
+                    this->emit(MI_MOVF, { MachineOperand::use(this->registerOf(operands[ i ]), valueSize), field });
+                }
+                else
+                {
+                    this->emit(MI_MOV, { this->operandOf(operands[ i ]), field });
+                }
+            }
+            break;
+        }
+
+        case ir::OP_ARRAY:
+        {
+            uint8_t elementSize = std::max<uint8_t>(widthOf(instruction->elementType), 1);
+            ir::Module &module = *this->function->module;
+            this->emitCall(MachineOperand::function(RUNTIME_ALLOCATE_ARRAY, true),
+                           { module.integer(ir::IR_I64, (int64_t) operands.size()),
+                             module.integer(ir::IR_I64, elementSize) }, false, ir::IR_PTR, result);
+            if ( operands.empty())
+            {
+                break;
+            }
+            uint32_t elements = this->machine->createRegister(CLASS_GPR);
+            this->emit(MI_MOV, { MachineOperand::memory(result, 0, 8), MachineOperand::def(elements, 8) });
+            for ( size_t i = 0; i < operands.size(); i++ )
+            {
+                MachineOperand element = MachineOperand::memory(elements, (int64_t) ( i * elementSize ), elementSize);
+                if ( ir::isFloat(operands[ i ]->type))
+                {
+                    this->emit(MI_MOVF, { MachineOperand::use(this->registerOf(operands[ i ]), elementSize), element });
+                }
+                else
+                {
+                    MachineOperand value = this->operandOf(operands[ i ]);
+                    value.size = elementSize;
+                    this->emit(MI_MOV, { value, element });
+                }
+            }
+            break;
+        }
+
+        case ir::OP_CALL:
+        {
+            ir::Value *callee = operands[ 0 ];
+            std::vector<ir::Value *> arguments(operands.begin() + 1, operands.end());
+            if ( callee->kind == ir::VALUE_FUNCTION )
+            {
+                auto target = static_cast<ir::Function *>(callee);
+                this->emitCall(MachineOperand::function(ir::mangle(target->name), target->external), arguments,
+                               target->variadic, instruction->type, result);
+            }
+            else
+            {
+                this->emitCall(MachineOperand::use(this->registerOf(callee), 8), arguments, true, instruction->type,
+                               result);
+            }
+            if ( this->exceptions->mayThrow(callee))
+            {
+                // Outside a try block, an exception returns from this function as well.
+                this->emitExceptionCheck(this->unwindBlock());
+                MachineBlock *continuation = this->createBlock("call.cont");
+                this->jumpTo(continuation);
+                this->current = continuation;
+            }
+            break;
+        }
+
+        case ir::OP_LANDING_PAD:
+            this->emit(ir::isFloat(instruction->type) ? MI_MOVF : MI_MOV,
+                       { MachineOperand::global(EXCEPTION_VALUE_SYMBOL, size), MachineOperand::def(result, size) });
+            this->emit(MI_MOV, { MachineOperand::imm(0, 1), MachineOperand::global(EXCEPTION_FLAG_SYMBOL, 1) });
+            this->raisesExceptions = true;
+            break;
+
+        default:
+            break;
+    }
+}
+
+void InstructionSelector::selectComparison(ir::Instruction *instruction, uint32_t result)
+{
+    if ( instruction->opcode == ir::OP_ICMP )
+    {
+        ECondition condition = this->emitIntegerComparison(instruction);
+        this->emit(MI_SETCC, { MachineOperand::def(result, 1) })->condition = condition;
+        return;
+    }
+
+    // Comparisons with NaN are unordered, which sets the parity flag; only 'not equal' holds then.
+    // 'Above' doesn't hold for unordered floats either, so 'less than' compares the other way around.
+    uint8_t size = widthOf(instruction->operands[ 0 ]->type);
+    uint32_t left = this->registerOf(instruction->operands[ 0 ]);
+    uint32_t right = this->registerOf(instruction->operands[ 1 ]);
+    auto compare = [ & ](uint32_t first, uint32_t second)
+    {
+        this->emit(MI_UCOMIF, { MachineOperand::use(second, size), MachineOperand::use(first, size) });
+    };
+    auto set = [ & ](ECondition condition, uint32_t reg)
+    {
+        this->emit(MI_SETCC, { MachineOperand::def(reg, 1) })->condition = condition;
+    };
+    switch ( instruction->predicate )
+    {
+        case ir::PREDICATE_EQ:
+        case ir::PREDICATE_NE:
+        {
+            bool isEqual = instruction->predicate == ir::PREDICATE_EQ;
+            uint32_t parity = this->machine->createRegister(CLASS_GPR);
+            compare(left, right);
+            set(isEqual ? COND_E : COND_NE, result);
+            set(isEqual ? COND_NP : COND_P, parity);
+            this->emit(isEqual ? MI_AND : MI_OR, { MachineOperand::use(parity, 1), MachineOperand::useDef(result, 1) });
+            break;
+        }
+        case ir::PREDICATE_GT:
+        case ir::PREDICATE_UGT:
+            compare(left, right);
+            set(COND_A, result);
+            break;
+        case ir::PREDICATE_GE:
+        case ir::PREDICATE_UGE:
+            compare(left, right);
+            set(COND_AE, result);
+            break;
+        case ir::PREDICATE_LT:
+        case ir::PREDICATE_ULT:
+            compare(right, left);
+            set(COND_A, result);
+            break;
+        default:
+            compare(right, left);
+            set(COND_AE, result);
+            break;
+    }
+}
+
+ECondition InstructionSelector::emitIntegerComparison(ir::Instruction *instruction)
+{
+    // Only the second operand can be an immediate.
+    ir::Value *left = instruction->operands[ 0 ];
+    ir::Value *right = instruction->operands[ 1 ];
+    ir::EPredicate predicate = instruction->predicate;
+    if ( isIntegerConstant(left) && !isIntegerConstant(right))
+    {
+        std::swap(left, right);
+        predicate = swapped(predicate);
+    }
+    MachineOperand source = this->operandOf(right);
+    this->emit(MI_CMP, { source, MachineOperand::use(this->registerOf(left), widthOf(left->type)) });
+    return conditionOf(predicate);
+}
+
+void InstructionSelector::selectConversion(ir::Instruction *instruction, uint32_t result)
+{
+    ir::Value *value = instruction->operands[ 0 ];
+    uint8_t from = widthOf(value->type);
+    uint8_t to = widthOf(instruction->type);
+
+    switch ( instruction->opcode )
+    {
+        case ir::OP_TRUNC:
+            // Narrower values are the low bytes of the register; booleans are the lowest bit.
+            this->moveTo(result, value);
+            if ( instruction->type == ir::IR_BOOL )
+            {
+                this->emit(MI_AND, { MachineOperand::imm(1, 1), MachineOperand::useDef(result, 1) });
+            }
+            break;
+
+        case ir::OP_ZEXT:
+        case ir::OP_SEXT:
+        {
+            if ( from == to )
+            {
+                this->moveTo(result, value);
+                break;
+            }
+            // Writing 32 bits clears the upper half, so zero extending those is a plain move.
+            EMachineOpcode opcode = instruction->opcode == ir::OP_ZEXT ? MI_MOVZX : MI_MOVSX;
+            this->emit(opcode, { MachineOperand::use(this->registerOf(value), from), MachineOperand::def(result, to) });
+            break;
+        }
+
+        case ir::OP_FPTRUNC:
+        case ir::OP_FPEXT:
+            this->emit(MI_CVTF2F, { MachineOperand::use(this->registerOf(value), from), MachineOperand::def(result, to) });
+            break;
+
+        case ir::OP_SITOFP:
+        {
+            uint32_t source = this->registerOf(value);
+            if ( from < 4 )
+            {
+                uint32_t extended = this->machine->createRegister(CLASS_GPR);
+                this->emit(MI_MOVSX, { MachineOperand::use(source, from), MachineOperand::def(extended, 4) });
+                source = extended;
+                from = 4;
+            }
+            this->emit(MI_CVTSI2F, { MachineOperand::use(source, from), MachineOperand::def(result, to) });
+            break;
+        }
+
+        case ir::OP_UITOFP:
+        {
+            uint32_t source = this->registerOf(value);
+            if ( from < 8 )
+            {
+                // Zero extended to 64 bits, the value is never negative as a signed integer.
+                uint32_t extended = this->machine->createRegister(CLASS_GPR);
+                this->emit(MI_MOVZX, { MachineOperand::use(source, from), MachineOperand::def(extended, 8) });
+                this->emit(MI_CVTSI2F, { MachineOperand::use(extended, 8), MachineOperand::def(result, to) });
+                break;
+            }
+
+            // Values with the highest bit set are halved, keeping the lowest bit for rounding, and doubled after.
+            MachineBlock *large = this->createBlock("utof.large");
+            MachineBlock *small = this->createBlock("utof.small");
+            MachineBlock *done = this->createBlock("utof.done");
+            this->emit(MI_TEST, { MachineOperand::use(source, 8), MachineOperand::use(source, 8) });
+            this->branchTo(COND_L, large);
+            this->jumpTo(small);
+
+            this->current = small;
+            this->emit(MI_CVTSI2F, { MachineOperand::use(source, 8), MachineOperand::def(result, to) });
+            this->jumpTo(done);
+
+            this->current = large;
+            uint32_t halved = this->machine->createRegister(CLASS_GPR);
+            uint32_t lowest = this->machine->createRegister(CLASS_GPR);
+            this->emit(MI_COPY, { MachineOperand::use(source, 8), MachineOperand::def(halved, 8) });
+            this->emit(MI_SHR, { MachineOperand::imm(1, 1), MachineOperand::useDef(halved, 8) });
+            this->emit(MI_COPY, { MachineOperand::use(source, 8), MachineOperand::def(lowest, 8) });
+            this->emit(MI_AND, { MachineOperand::imm(1, 8), MachineOperand::useDef(lowest, 8) });
+            this->emit(MI_OR, { MachineOperand::use(lowest, 8), MachineOperand::useDef(halved, 8) });
+            this->emit(MI_CVTSI2F, { MachineOperand::use(halved, 8), MachineOperand::def(result, to) });
+            this->emit(MI_ADDF, { MachineOperand::use(result, to), MachineOperand::useDef(result, to) });
+            this->jumpTo(done);
+            this->current = done;
+            break;
+        }
+
+        case ir::OP_FPTOSI:
+            this->emit(MI_CVTF2SI, { MachineOperand::use(this->registerOf(value), from),
+                                     MachineOperand::def(result, std::max<uint8_t>(to, 4)) });
+            break;
+
+        case ir::OP_FPTOUI:
+        {
+            uint32_t source = this->registerOf(value);
+            if ( to < 8 )
+            {
+                this->emit(MI_CVTF2SI, { MachineOperand::use(source, from), MachineOperand::def(result, 8) });
+                break;
+            }
+
+            // Values from 2^63 on don't fit a signed integer; they're converted less 2^63, which is added back.
+            uint32_t limit = this->machine->createRegister(CLASS_XMM);
+            this->emit(MI_MOVF, { MachineOperand::global(this->constantLabel(value->type, 9223372036854775808.0), from),
+                                  MachineOperand::def(limit, from) });
+            MachineBlock *large = this->createBlock("ftou.large");
+            MachineBlock *small = this->createBlock("ftou.small");
+            MachineBlock *done = this->createBlock("ftou.done");
+            this->emit(MI_UCOMIF, { MachineOperand::use(limit, from), MachineOperand::use(source, from) });
+            this->branchTo(COND_AE, large);
+            this->jumpTo(small);
+
+            this->current = small;
+            this->emit(MI_CVTF2SI, { MachineOperand::use(source, from), MachineOperand::def(result, 8) });
+            this->jumpTo(done);
+
+            this->current = large;
+            uint32_t reduced = this->machine->createRegister(CLASS_XMM);
+            uint32_t highest = this->machine->createRegister(CLASS_GPR);
+            this->emit(MI_COPY, { MachineOperand::use(source, 8), MachineOperand::def(reduced, 8) });
+            this->emit(MI_SUBF, { MachineOperand::use(limit, from), MachineOperand::useDef(reduced, from) });
+            this->emit(MI_CVTF2SI, { MachineOperand::use(reduced, from), MachineOperand::def(result, 8) });
+            this->emit(MI_MOV, { MachineOperand::imm(INT64_MIN, 8), MachineOperand::def(highest, 8) });
+            this->emit(MI_XOR, { MachineOperand::use(highest, 8), MachineOperand::useDef(result, 8) });
+            this->jumpTo(done);
+            this->current = done;
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+// Calls
+
+void InstructionSelector::emitCall(const MachineOperand &target, const std::vector<ir::Value *> &arguments,
+                                   bool variadic, ir::EIRType resultType, uint32_t result)
+{
+    std::vector<std::pair<ERegister, ir::Value *>> inRegisters;
+    std::vector<ir::Value *> onStack;
+    size_t integers = 0, floats = 0;
+    for ( auto argument: arguments )
+    {
+        if ( ir::isFloat(argument->type) && floats < FLOAT_ARGUMENT_COUNT )
+        {
+            inRegisters.emplace_back((ERegister) ( XMM0 + floats++ ), argument);
+        }
+        else if ( !ir::isFloat(argument->type) && integers < INTEGER_ARGUMENT_COUNT )
+        {
+            inRegisters.emplace_back(INTEGER_ARGUMENTS[ integers++ ], argument);
+        }
+        else
+        {
+            onStack.push_back(argument);
+        }
+    }
+
+    // The stack is aligned to 16 bytes at the call; arguments take 8 bytes each, pushed from last to first.
+    int64_t stackSize = (int64_t) ( onStack.size() + onStack.size() % 2 ) * 8;
+    if ( onStack.size() % 2 != 0 )
+    {
+        this->emit(MI_SUB, { MachineOperand::imm(8, 8), MachineOperand::useDef(RSP, 8) });
+    }
+    for ( auto argument = onStack.rbegin(); argument != onStack.rend(); argument++ )
+    {
+        if ( ir::isFloat(( *argument )->type))
+        {
+            uint8_t size = widthOf(( *argument )->type);
+            uint32_t value = this->registerOf(*argument);
+            if ( variadic && size == 4 )
+            {
+                // Floats passed to variadic functions are promoted to doubles.
+                uint32_t promoted = this->machine->createRegister(CLASS_XMM);
+                this->emit(MI_CVTF2F, { MachineOperand::use(value, 4), MachineOperand::def(promoted, 8) });
+                value = promoted;
+                size = 8;
+            }
+            this->emit(MI_SUB, { MachineOperand::imm(8, 8), MachineOperand::useDef(RSP, 8) });
+            this->emit(MI_MOVF, { MachineOperand::use(value, size), MachineOperand::memory(RSP, 0, size) });
+            continue;
+        }
+        MachineOperand value = this->operandOf(*argument);
+        value.size = 8;
+        this->emit(MI_PUSH, { value });
+    }
+
+    MachineInstruction call(MI_CALL, { target });
+    for ( auto &[ reg, argument ]: inRegisters )
+    {
+        if ( variadic && argument->type == ir::IR_F32 )
+        {
+            this->emit(MI_CVTF2F, { MachineOperand::use(this->registerOf(argument), 4), MachineOperand::def(reg, 8) });
+        }
+        else if ( ir::isFloat(argument->type) && argument->isConstant())
+        {
+            uint8_t size = widthOf(argument->type);
+            auto constant = argument->kind == ir::VALUE_CONSTANT ? static_cast<ir::Constant *>(argument) : nullptr;
+            this->emit(MI_MOVF, { MachineOperand::global(this->constantLabel(argument->type, constant != nullptr ?
+                                                                                            constant->floating : 0),
+                                                         size), MachineOperand::def(reg, size) });
+        }
+        else
+        {
+            this->moveTo(reg, argument);
+        }
+        call.implicitUses.push_back(reg);
+    }
+    if ( variadic )
+    {
+        // Variadic functions receive the number of vector registers that hold arguments in al.
+        this->emit(MI_MOV, { MachineOperand::imm((int64_t) floats, 4), MachineOperand::def(RAX, 4) });
+        call.implicitUses.push_back(RAX);
+    }
+
+    call.implicitDefs = { RAX, RCX, RDX, RSI, RDI, R8, R9, R10, R11 };
+    for ( uint32_t reg = XMM0; reg <= XMM15; reg++ )
+    {
+        call.implicitDefs.push_back((ERegister) reg);
+    }
+    this->current->instructions.push_back(std::make_unique<MachineInstruction>(std::move(call)));
+
+    if ( stackSize > 0 )
+    {
+        this->emit(MI_ADD, { MachineOperand::imm(stackSize, 8), MachineOperand::useDef(RSP, 8) });
+    }
+    if ( result != NO_REGISTER && resultType != ir::IR_VOID )
+    {
+        this->emit(MI_COPY, { MachineOperand::use(ir::isFloat(resultType) ? XMM0 : RAX, 8),
+                              MachineOperand::def(result, 8) });
+    }
+}
+
+void InstructionSelector::emitExceptionCheck(MachineBlock *handler)
+{
+    this->emit(MI_CMP, { MachineOperand::imm(0, 1), MachineOperand::global(EXCEPTION_FLAG_SYMBOL, 1) });
+    this->branchTo(COND_NE, handler);
+    this->raisesExceptions = true;
+}
+
+MachineBlock *InstructionSelector::unwindBlock()
+{
+    if ( this->unwind == nullptr )
+    {
+        this->unwind = this->machine->createBlock("unwind");
+        this->unwind->append(MI_RET, {});
+    }
+    return this->unwind;
+}
+
+// Control flow
+
+MachineBlock *InstructionSelector::edgeTarget(const ir::BasicBlock *predecessor, const ir::BasicBlock *successor)
+{
+    MachineBlock *target = this->blocks[ successor ];
+    if ( successor->instructions.empty() || successor->instructions[ 0 ]->opcode != ir::OP_PHI )
+    {
+        return target;
+    }
+    auto known = this->edges.find({ predecessor, successor });
+    if ( known != this->edges.end())
+    {
+        return known->second;
+    }
+
+    // The copies can't be placed at the end of a block that continues elsewhere as well.
+    const std::vector<ir::BasicBlock *> &successors = predecessor->successors();
+    bool isOnlySuccessor = std::all_of(successors.begin(), successors.end(), [ successor ](ir::BasicBlock *block)
+    { return block == successor; });
+    if ( isOnlySuccessor )
+    {
+        this->emitPhiCopies(predecessor, successor);
+        this->edges[ { predecessor, successor } ] = target;
+        return target;
+    }
+
+    MachineBlock *previous = this->current;
+    MachineBlock *edge = this->createBlock("edge");
+    edge->loopDepth = std::min(this->current->loopDepth, target->loopDepth);
+    this->current = edge;
+    this->emitPhiCopies(predecessor, successor);
+    this->jumpTo(target);
+    this->current = previous;
+    this->edges[ { predecessor, successor } ] = edge;
+    return edge;
+}
+
+void InstructionSelector::emitPhiCopies(const ir::BasicBlock *predecessor, const ir::BasicBlock *successor)
+{
+    std::vector<std::pair<uint32_t, ir::Value *>> copies;
+    bool readsPhi = false;
+    for ( auto phi: successor->instructions )
+    {
+        if ( phi->opcode != ir::OP_PHI )
+        {
+            break;
+        }
+        auto incoming = std::find(phi->targets.begin(), phi->targets.end(), predecessor);
+        ir::Value *value = phi->operands[ incoming - phi->targets.begin() ];
+        if ( value != phi )
+        {
+            copies.emplace_back(this->registers[ phi ], value);
+            readsPhi |= value->kind == ir::VALUE_INSTRUCTION &&
+                        static_cast<ir::Instruction *>(value)->opcode == ir::OP_PHI &&
+                        static_cast<ir::Instruction *>(value)->block == successor;
+        }
+    }
+
+    // Phi nodes are assigned at once; if one reads another, all values are copied to temporaries first.
+    if ( !readsPhi )
+    {
+        for ( auto &[ reg, value ]: copies )
+        {
+            this->moveTo(reg, value);
+        }
+        return;
+    }
+    std::vector<uint32_t> temporaries;
+    for ( auto &[ reg, value ]: copies )
+    {
+        temporaries.push_back(this->machine->createRegister(this->machine->registerClass(reg)));
+        this->moveTo(temporaries.back(), value);
+    }
+    for ( size_t i = 0; i < copies.size(); i++ )
+    {
+        this->emit(MI_COPY, { MachineOperand::use(temporaries[ i ], 8), MachineOperand::def(copies[ i ].first, 8) });
+    }
+}
+
+void InstructionSelector::selectTerminator(ir::Instruction *instruction)
+{
+    const ir::BasicBlock *block = instruction->block;
+    auto &operands = instruction->operands;
+    auto &targets = instruction->targets;
+
+    switch ( instruction->opcode )
+    {
+        case ir::OP_BRANCH:
+            this->jumpTo(this->edgeTarget(block, targets[ 0 ]));
+            break;
+
+        case ir::OP_CONDITIONAL_BRANCH:
+        {
+            MachineBlock *whenTrue = this->edgeTarget(block, targets[ 0 ]);
+            MachineBlock *whenFalse = targets[ 1 ] == targets[ 0 ] ? whenTrue : this->edgeTarget(block, targets[ 1 ]);
+            ir::Value *condition = operands[ 0 ];
+            if ( whenTrue == whenFalse || condition->isConstant())
+            {
+                this->jumpTo(integerOf(condition) != 0 ? whenTrue : whenFalse);
+                break;
+            }
+            ECondition jumpCondition = COND_NE;
+            if ( condition->kind == ir::VALUE_INSTRUCTION &&
+                 this->isFusedComparison(static_cast<ir::Instruction *>(condition)))
+            {
+                jumpCondition = this->emitIntegerComparison(static_cast<ir::Instruction *>(condition));
+            }
+            else
+            {
+                uint32_t reg = this->registerOf(condition);
+                this->emit(MI_TEST, { MachineOperand::use(reg, 1), MachineOperand::use(reg, 1) });
+            }
+            this->branchTo(jumpCondition, whenTrue);
+            this->jumpTo(whenFalse);
+            break;
+        }
+
+        case ir::OP_SWITCH:
+            this->selectSwitch(instruction);
+            break;
+
+        case ir::OP_RETURN:
+        {
+            MachineInstruction *ret;
+            if ( operands.empty())
+            {
+                ret = this->emit(MI_RET, {});
+            }
+            else
+            {
+                ERegister reg = ir::isFloat(operands[ 0 ]->type) ? XMM0 : RAX;
+                this->moveTo(reg, operands[ 0 ]);
+                ret = this->emit(MI_RET, {});
+                ret->implicitUses = { reg };
+            }
+            break;
+        }
+
+        case ir::OP_INVOKE:
+        {
+            ir::Value *callee = operands[ 0 ];
+            std::vector<ir::Value *> arguments(operands.begin() + 1, operands.end());
+            uint32_t result = instruction->type != ir::IR_VOID ? this->registers[ instruction ] : NO_REGISTER;
+            bool variadic = true;
+            MachineOperand target;
+            if ( callee->kind == ir::VALUE_FUNCTION )
+            {
+                auto function = static_cast<ir::Function *>(callee);
+                target = MachineOperand::function(ir::mangle(function->name), function->external);
+                variadic = function->variadic;
+            }
+            else
+            {
+                target = MachineOperand::use(this->registerOf(callee), 8);
+            }
+            this->emitCall(target, arguments, variadic, instruction->type, result);
+            if ( this->exceptions->mayThrow(callee))
+            {
+                this->emitExceptionCheck(this->edgeTarget(block, targets[ 1 ]));
+            }
+            this->jumpTo(this->edgeTarget(block, targets[ 0 ]));
+            break;
+        }
+
+        case ir::OP_THROW:
+        {
+            // The exception is stored zero extended, so it's the same however wide the handler reads it.
+            ir::Value *value = operands[ 0 ];
+            uint8_t size = widthOf(value->type);
+            this->emit(MI_MOV, { MachineOperand::imm(0, 8), MachineOperand::global(EXCEPTION_VALUE_SYMBOL, 8) });
+            if ( ir::isFloat(value->type))
+            {
+                this->emit(MI_MOVF, { MachineOperand::use(this->registerOf(value), size),
+                                      MachineOperand::global(EXCEPTION_VALUE_SYMBOL, size) });
+            }
+            else
+            {
+                this->emit(MI_MOV, { this->operandOf(value), MachineOperand::global(EXCEPTION_VALUE_SYMBOL, size) });
+            }
+            this->emit(MI_MOV, { MachineOperand::imm(1, 1), MachineOperand::global(EXCEPTION_FLAG_SYMBOL, 1) });
+            this->raisesExceptions = true;
+            this->jumpTo(targets.empty() ? this->unwindBlock() : this->edgeTarget(block, targets[ 0 ]));
+            break;
+        }
+
+        default:
+            this->emit(MI_UD2, {});
+            break;
+    }
+}
+
+void InstructionSelector::selectSwitch(ir::Instruction *instruction)
+{
+    const ir::BasicBlock *block = instruction->block;
+    ir::Value *value = instruction->operands[ 0 ];
+    uint8_t size = widthOf(value->type);
+    MachineBlock *otherwise = this->edgeTarget(block, instruction->targets[ 0 ]);
+    std::vector<std::pair<int64_t, MachineBlock *>> cases;
+    for ( size_t i = 1; i < instruction->operands.size(); i++ )
+    {
+        cases.emplace_back(integerOf(instruction->operands[ i ]), this->edgeTarget(block, instruction->targets[ i ]));
+    }
+    if ( cases.empty())
+    {
+        this->jumpTo(otherwise);
+        return;
+    }
+    std::sort(cases.begin(), cases.end(), [](auto &a, auto &b) { return a.first < b.first; });
+    uint32_t reg = this->registerOf(value);
+
+    // Dense cases index a table of jump targets, relative to the table, the same
+    // way the switch lowering decides it for the syntax tree.
+    int64_t lowest = cases.front().first;
+    auto range = (uint64_t) cases.back().first - (uint64_t) lowest + 1;
+    bool isDense = cases.size() >= SWITCH_MIN_JUMP_TABLE_ENTRIES && range <= SWITCH_MAX_JUMP_TABLE_ENTRIES &&
+                   cases.size() * 100 >= range * SWITCH_MIN_JUMP_TABLE_DENSITY && fitsImmediate(lowest);
+    if ( !isDense )
+    {
+        this->selectCases(reg, size, cases, 0, cases.size(), otherwise);
+        return;
+    }
+
+    uint32_t index = this->machine->createRegister(CLASS_GPR);
+    if ( size < 8 )
+    {
+        this->emit(MI_MOVSX, { MachineOperand::use(reg, size), MachineOperand::def(index, 8) });
+    }
+    else
+    {
+        this->emit(MI_COPY, { MachineOperand::use(reg, 8), MachineOperand::def(index, 8) });
+    }
+    if ( lowest != 0 )
+    {
+        this->emit(MI_SUB, { MachineOperand::imm(lowest, 8), MachineOperand::useDef(index, 8) });
+    }
+    this->emit(MI_CMP, { MachineOperand::imm((int64_t) range - 1, 8), MachineOperand::use(index, 8) });
+    this->branchTo(COND_A, otherwise);
+    MachineBlock *dispatch = this->createBlock("switch.table");
+    this->jumpTo(dispatch);
+    this->current = dispatch;
+
+    JumpTable table { ".L" + this->machine->symbol + ".table." + std::to_string(this->machine->jumpTables.size()),
+                      std::vector<MachineBlock *>(range, otherwise), dispatch };
+    for ( auto &[ caseValue, target ]: cases )
+    {
+        table.targets[ caseValue - lowest ] = target;
+    }
+    uint32_t base = this->machine->createRegister(CLASS_GPR);
+    uint32_t address = this->machine->createRegister(CLASS_GPR);
+    MachineOperand entry = MachineOperand::memory(base, 0, 4);
+    entry.index = index;
+    entry.scale = 4;
+    this->emit(MI_LEA, { MachineOperand::global(table.label, 8), MachineOperand::def(base, 8) });
+    this->emit(MI_MOVSX, { entry, MachineOperand::def(address, 8) });
+    this->emit(MI_ADD, { MachineOperand::use(base, 8), MachineOperand::useDef(address, 8) });
+    this->emit(MI_JMP_TABLE, { MachineOperand::use(address, 8) });
+    for ( auto target: table.targets )
+    {
+        this->current->addSuccessor(target);
+    }
+    this->machine->jumpTables.push_back(std::move(table));
+}
+
+void InstructionSelector::selectCases(uint32_t value, uint8_t size,
+                                      std::vector<std::pair<int64_t, MachineBlock *>> &cases,
+                                      size_t first, size_t last, MachineBlock *otherwise)
+{
+    auto compare = [ & ](int64_t caseValue)
+    {
+        MachineOperand operand = MachineOperand::imm(caseValue, size);
+        if ( !fitsImmediate(caseValue))
+        {
+            operand = MachineOperand::use(this->machine->createRegister(CLASS_GPR), 8);
+            this->emit(MI_MOV, { MachineOperand::imm(caseValue, 8), MachineOperand::def(operand.reg, 8) });
+        }
+        this->emit(MI_CMP, { operand, MachineOperand::use(value, size) });
+    };
+
+    // A few cases are compared in order; more are split in halves by a comparison with the middle case.
+    if ( last - first <= SWITCH_MAX_LINEAR_CLUSTERS )
+    {
+        for ( size_t i = first; i < last; i++ )
+        {
+            compare(cases[ i ].first);
+            this->branchTo(COND_E, cases[ i ].second);
+            if ( i + 1 < last )
+            {
+                MachineBlock *next = this->createBlock("switch.case");
+                this->jumpTo(next);
+                this->current = next;
+            }
+        }
+        this->jumpTo(otherwise);
+        return;
+    }
+    size_t middle = ( first + last ) / 2;
+    MachineBlock *lower = this->createBlock("switch.lower");
+    MachineBlock *upper = this->createBlock("switch.upper");
+    compare(cases[ middle ].first);
+    this->branchTo(COND_GE, upper);
+    this->jumpTo(lower);
+    this->current = lower;
+    this->selectCases(value, size, cases, first, middle, otherwise);
+    this->current = upper;
+    this->selectCases(value, size, cases, middle, last, otherwise);
+}
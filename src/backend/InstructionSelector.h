@@ -0,0 +1,158 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_INSTRUCTIONSELECTOR_H
+#define STRIDE_LANGUAGE_INSTRUCTIONSELECTOR_H
+
+#include <map>
+#include <unordered_map>
+#include "MachineIR.h"
+#include "../ir/ExceptionAnalysis.h"
+#include "../ir/IR.h"
+#include "../semantic/LayoutEngine.h"
+
+/** The value that's thrown, while an exception is raised. */
+#define EXCEPTION_VALUE_SYMBOL "__stride_exception"
+
+/** A byte that's set while an exception is raised, until it's caught. */
+#define EXCEPTION_FLAG_SYMBOL "__stride_unwinding"
+
+/** The runtime function that allocates zeroed memory for an object; <code>void *(uint64_t size)</code>. */
+#define RUNTIME_ALLOCATE "__stride_allocate"
+
+/**
+ * The runtime function that allocates an array; <code>void *(uint64_t length, uint64_t elementSize)</code>.
+ * It returns the array descriptor, which refers to the elements at offset 0 and holds the length at offset 8.
+ */
+#define RUNTIME_ALLOCATE_ARRAY "__stride_allocate_array"
+
+namespace stride::backend
+{
+
+    /**
+     * Selects x86-64 instructions for the IR of a module, with a virtual register per value.
+     *
+     * Calls follow the System V calling convention; the first six integer and
+     * eight float arguments are passed in registers, the others on the stack.
+     * Phi nodes become copies at the end of their predecessors; edges from a
+     * block with several successors to a block with phi nodes are split first.
+     *
+     * Exceptions don't unwind the stack. Throwing stores the exception and sets
+     * a flag, and continues at the handler, or returns. A call that may throw is
+     * followed by a check of the flag, which continues at the handler of an invoke,
+     * or returns from the calling function as well.
+     */
+    class InstructionSelector
+    {
+    private:
+        semantic::LayoutEngine &layouts;
+        MachineModule &output;
+
+        std::unique_ptr<ir::ExceptionAnalysis> exceptions;
+        std::unordered_map<std::string, std::string> stringLabels;
+        std::map<std::pair<int, uint64_t>, std::string> constantLabels;
+        bool raisesExceptions = false;
+
+        // The state of the function that is being selected.
+        const ir::Function *function = nullptr;
+        MachineFunction *machine = nullptr;
+        MachineBlock *current = nullptr;
+        MachineBlock *unwind = nullptr;
+        uint32_t currentDepth = 0;
+        std::unordered_map<const ir::Value *, uint32_t> registers;
+        std::unordered_map<const ir::BasicBlock *, MachineBlock *> blocks;
+        std::map<std::pair<const ir::BasicBlock *, const ir::BasicBlock *>, MachineBlock *> edges;
+
+        void selectData(const ir::Module &module);
+
+        std::string stringLabel(const std::string &value);
+
+        std::string constantLabel(ir::EIRType type, double value);
+
+        void selectFunction(const ir::Function &source);
+
+        void selectInstruction(ir::Instruction *instruction);
+
+        void selectTerminator(ir::Instruction *instruction);
+
+        MachineInstruction *emit(EMachineOpcode opcode, std::vector<MachineOperand> operands);
+
+        MachineBlock *createBlock(const std::string &name);
+
+        /**
+         * Returns the register of a value, materializing constants, globals and functions in a new one.
+         */
+        uint32_t registerOf(ir::Value *value);
+
+        /**
+         * Returns an immediate for integer constants that fit in 32 bits, or else the register of the value.
+         */
+        MachineOperand operandOf(ir::Value *value);
+
+        /**
+         * Returns the memory an address refers to, folding field offsets.
+         */
+        MachineOperand memoryAt(ir::Value *address, uint8_t size);
+
+        /**
+         * Moves a value to a register, physical or virtual.
+         */
+        void moveTo(uint32_t reg, ir::Value *value);
+
+        /**
+         * Calls a function with the provided arguments, and copies the result to a register, if it's provided.
+         */
+        void emitCall(const MachineOperand &target, const std::vector<ir::Value *> &arguments,
+                      bool variadic, ir::EIRType resultType, uint32_t result);
+
+        /**
+         * Jumps to the handler if the last call raised an exception.
+         */
+        void emitExceptionCheck(MachineBlock *handler);
+
+        MachineBlock *unwindBlock();
+
+        /**
+         * Returns the block an edge between two IR blocks continues at; the successor,
+         * or a new block with the copies of the phi nodes of the successor.
+         */
+        MachineBlock *edgeTarget(const ir::BasicBlock *predecessor, const ir::BasicBlock *successor);
+
+        void emitPhiCopies(const ir::BasicBlock *predecessor, const ir::BasicBlock *successor);
+
+        void jumpTo(MachineBlock *target);
+
+        void branchTo(ECondition condition, MachineBlock *target);
+
+        /**
+         * Compares the operands of an integer comparison.
+         * @return The condition that holds if the comparison is true.
+         */
+        ECondition emitIntegerComparison(ir::Instruction *instruction);
+
+        void selectComparison(ir::Instruction *instruction, uint32_t result);
+
+        void selectConversion(ir::Instruction *instruction, uint32_t result);
+
+        void selectSwitch(ir::Instruction *instruction);
+
+        void selectCases(uint32_t value, uint8_t size, std::vector<std::pair<int64_t, MachineBlock *>> &cases,
+                         size_t first, size_t last, MachineBlock *otherwise);
+
+        [[nodiscard]] bool isFoldedAddress(const ir::Instruction *instruction) const;
+
+        [[nodiscard]] bool isFusedComparison(const ir::Instruction *instruction) const;
+
+    public:
+        InstructionSelector(semantic::LayoutEngine &layouts, MachineModule &output) : layouts(layouts), output(output)
+        {}
+
+        /**
+         * Selects the instructions of every function of a module, and lays out its data.
+         */
+        void run(ir::Module &module);
+    };
+}
+
+#endif //STRIDE_LANGUAGE_INSTRUCTIONSELECTOR_H
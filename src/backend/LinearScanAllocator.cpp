@@ -0,0 +1,938 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include <numeric>
+#include "LinearScanAllocator.h"
+
+using namespace stride::backend;
+
+/** Uses in a loop weigh this many times as much as uses outside of it. */
+#define LOOP_WEIGHT 10.0f
+
+/** Loops nested deeper than this weigh as much as loops of this depth. */
+#define MAX_WEIGHTED_LOOP_DEPTH 6
+
+/**
+ * The registers that are allocated, in the order they're preferred in. The ones
+ * the callee may clobber come first, so the prologue needn't save them.
+ */
+static const std::vector<ERegister> ALLOCATABLE_GPRS = {
+        RAX, RCX, RDX, RSI, RDI, R8, R9, RBX, R12, R13, R14, R15
+};
+static const std::vector<ERegister> ALLOCATABLE_XMMS = {
+        XMM0, XMM1, XMM2, XMM3, XMM4, XMM5, XMM6, XMM7, XMM8, XMM9, XMM10, XMM11, XMM12, XMM13
+};
+
+static bool isAllocatable(uint32_t reg)
+{
+    return reg < REGISTER_COUNT && reg != RSP && reg != RBP &&
+           reg != SCRATCH_GPR_0 && reg != SCRATCH_GPR_1 && reg != SCRATCH_XMM_0 && reg != SCRATCH_XMM_1;
+}
+
+static const std::vector<ERegister> &allocatableRegisters(ERegisterClass registerClass)
+{
+    return registerClass == CLASS_XMM ? ALLOCATABLE_XMMS : ALLOCATABLE_GPRS;
+}
+
+/**
+ * Orders the unhandled intervals as a heap, of which the one that starts first is on top.
+ */
+static bool startsLater(const LiveInterval *first, const LiveInterval *second)
+{
+    return first->start() > second->start();
+}
+
+static void enqueue(std::vector<LiveInterval *> &unhandled, LiveInterval *interval)
+{
+    unhandled.push_back(interval);
+    std::push_heap(unhandled.begin(), unhandled.end(), startsLater);
+}
+
+static std::vector<LiveRange> unionOf(const std::vector<LiveRange> &first, const std::vector<LiveRange> &second)
+{
+    std::vector<LiveRange> all;
+    std::merge(first.begin(), first.end(), second.begin(), second.end(), std::back_inserter(all),
+               [](const LiveRange &a, const LiveRange &b)
+               { return a.from < b.from; });
+    std::vector<LiveRange> merged;
+    for ( auto &range: all )
+    {
+        if ( !merged.empty() && range.from <= merged.back().to )
+        {
+            merged.back().to = std::max(merged.back().to, range.to);
+            continue;
+        }
+        merged.push_back(range);
+    }
+    return merged;
+}
+
+/**
+ * Returns the first range that ends after a position.
+ */
+static std::vector<LiveRange>::const_iterator rangeAfter(const std::vector<LiveRange> &ranges, uint32_t position)
+{
+    return std::upper_bound(ranges.begin(), ranges.end(), position, [](uint32_t position, const LiveRange &range)
+    { return position < range.to; });
+}
+
+bool LiveInterval::covers(uint32_t position) const
+{
+    auto range = rangeAfter(this->ranges, position);
+    return range != this->ranges.end() && range->from <= position;
+}
+
+uint32_t LiveInterval::nextIntersection(const LiveInterval &other, uint32_t position) const
+{
+    auto first = rangeAfter(this->ranges, position);
+    auto second = rangeAfter(other.ranges, position);
+    while ( first != this->ranges.end() && second != other.ranges.end())
+    {
+        uint32_t from = std::max({ first->from, second->from, position });
+        if ( from < std::min(first->to, second->to))
+        {
+            return from;
+        }
+        if ( first->to < second->to )
+        {
+            first++;
+        }
+        else
+        {
+            second++;
+        }
+    }
+    return UINT32_MAX;
+}
+
+void LiveInterval::prependRange(uint32_t from, uint32_t to)
+{
+    // While the intervals are built, the ranges are stored from last to first.
+    if ( from >= to )
+    {
+        return;
+    }
+    if ( this->ranges.empty() || to < this->ranges.back().from )
+    {
+        this->ranges.push_back({ from, to });
+        return;
+    }
+    this->ranges.back().from = std::min(this->ranges.back().from, from);
+    this->ranges.back().to = std::max(this->ranges.back().to, to);
+}
+
+namespace
+{
+    /**
+     * Where a part of a virtual register is kept; a physical register, or else a stack slot.
+     */
+    struct Location
+    {
+        uint32_t reg = NO_REGISTER;
+        int32_t slot = -1;
+
+        bool operator==(const Location &other) const
+        { return this->reg == other.reg && this->slot == other.slot; }
+    };
+
+    struct Move
+    {
+        Location from;
+        Location to;
+        ERegisterClass registerClass;
+    };
+}
+
+static Location locationOf(const LiveInterval &part, const std::vector<int32_t> &slots)
+{
+    if ( part.assigned != NO_REGISTER )
+    {
+        return { part.assigned, -1 };
+    }
+    return { NO_REGISTER, slots[ part.reg - FIRST_VIRTUAL_REGISTER ] };
+}
+
+static void emitMove(std::vector<std::unique_ptr<MachineInstruction>> &out, const Move &move)
+{
+    EMachineOpcode opcode = move.registerClass == CLASS_XMM ? MI_MOVF : MI_MOV;
+    if ( move.from.reg != NO_REGISTER && move.to.reg != NO_REGISTER )
+    {
+        opcode = MI_COPY;
+    }
+    MachineOperand from = move.from.reg != NO_REGISTER ? MachineOperand::use(move.from.reg, 8)
+                                                       : MachineOperand::stackSlot(move.from.slot, 8);
+    MachineOperand to = move.to.reg != NO_REGISTER ? MachineOperand::def(move.to.reg, 8)
+                                                   : MachineOperand::stackSlot(move.to.slot, 8);
+    out.push_back(std::make_unique<MachineInstruction>(opcode, std::vector<MachineOperand> { from, to }));
+}
+
+/**
+ * Emits moves that happen at once, ordering them so that no location is written before it's read.
+ * Every part is kept in a location of its own, so the moves only form cycles of registers,
+ * which are broken with a scratch register.
+ */
+static void emitParallelMoves(std::vector<std::unique_ptr<MachineInstruction>> &out, std::vector<Move> moves)
+{
+    moves.erase(std::remove_if(moves.begin(), moves.end(), [](const Move &move)
+    { return move.from == move.to; }), moves.end());
+
+    while ( !moves.empty())
+    {
+        auto ready = std::find_if(moves.begin(), moves.end(), [ & ](const Move &move)
+        {
+            return std::none_of(moves.begin(), moves.end(), [ & ](const Move &other)
+            { return &other != &move && other.from == move.to; });
+        });
+        if ( ready == moves.end())
+        {
+            Move &move = moves.front();
+            Location scratch { move.registerClass == CLASS_XMM ? (uint32_t) SCRATCH_XMM_0 : (uint32_t) SCRATCH_GPR_0 };
+            emitMove(out, { move.from, scratch, move.registerClass });
+            move.from = scratch;
+            continue;
+        }
+        emitMove(out, *ready);
+        moves.erase(ready);
+    }
+}
+
+void LinearScanAllocator::allocate(MachineFunction &function)
+{
+    this->function = &function;
+    function.renumber();
+    this->numberInstructions();
+    this->computeLiveness();
+    this->buildIntervals();
+    this->coalesceCopies();
+    for ( auto &interval: this->intervals )
+    {
+        this->computeWeight(*interval);
+    }
+    this->scan();
+
+    std::vector<int32_t> slots(function.registerClasses.size(), -1);
+    for ( size_t i = 0; i < slots.size(); i++ )
+    {
+        for ( auto part: this->parts[ i ] )
+        {
+            if ( part->assigned == NO_REGISTER && !part->ranges.empty())
+            {
+                slots[ i ] = function.createSlot(8, 8);
+                break;
+            }
+        }
+    }
+    this->rewrite(slots);
+    this->resolveEdges(slots);
+}
+
+void LinearScanAllocator::numberInstructions()
+{
+    this->blockStarts.clear();
+    uint32_t position = 0;
+    for ( auto &block: this->function->blocks )
+    {
+        this->blockStarts.push_back(position);
+        position += 2 * (uint32_t) block->instructions.size();
+    }
+    this->blockStarts.push_back(position);
+}
+
+void LinearScanAllocator::computeLiveness()
+{
+    size_t count = this->function->registerClasses.size();
+    size_t blockCount = this->function->blocks.size();
+    std::vector<RegisterSet> uses(blockCount, RegisterSet(count));
+    std::vector<RegisterSet> defs(blockCount, RegisterSet(count));
+    for ( size_t b = 0; b < blockCount; b++ )
+    {
+        for ( auto &instruction: this->function->blocks[ b ]->instructions )
+        {
+            instruction->forEachUse([ & ](uint32_t reg)
+                                    {
+                                        if ( isVirtual(reg) && !defs[ b ].contains(reg - FIRST_VIRTUAL_REGISTER))
+                                        {
+                                            uses[ b ].insert(reg - FIRST_VIRTUAL_REGISTER);
+                                        }
+                                    });
+            instruction->forEachDef([ & ](uint32_t reg)
+                                    {
+                                        if ( isVirtual(reg))
+                                        {
+                                            defs[ b ].insert(reg - FIRST_VIRTUAL_REGISTER);
+                                        }
+                                    });
+        }
+    }
+
+    this->liveIn = std::move(uses);
+    bool changed = true;
+    while ( changed )
+    {
+        changed = false;
+        for ( size_t b = blockCount; b-- > 0; )
+        {
+            for ( auto successor: this->function->blocks[ b ]->successors )
+            {
+                changed |= this->liveIn[ b ].insertAll(this->liveIn[ successor->id ], defs[ b ]);
+            }
+        }
+    }
+}
+
+void LinearScanAllocator::buildIntervals()
+{
+    size_t count = this->function->registerClasses.size();
+    this->intervals.clear();
+    this->parts.assign(count, {});
+    for ( size_t i = 0; i < count; i++ )
+    {
+        auto interval = std::make_unique<LiveInterval>();
+        interval->reg = FIRST_VIRTUAL_REGISTER + (uint32_t) i;
+        interval->registerClass = this->function->registerClasses[ i ];
+        this->parts[ i ].push_back(interval.get());
+        this->intervals.push_back(std::move(interval));
+    }
+    this->fixed.assign(REGISTER_COUNT, {});
+    for ( uint32_t reg = 0; reg < REGISTER_COUNT; reg++ )
+    {
+        this->fixed[ reg ].reg = reg;
+        this->fixed[ reg ].registerClass = classOf((ERegister) reg);
+        this->fixed[ reg ].assigned = reg;
+    }
+
+    // The blocks are visited from last to first, and so are their instructions; a register is
+    // live from the start of the block, or its definition, up to its last use.
+    std::vector<bool> live(count);
+    for ( size_t b = this->function->blocks.size(); b-- > 0; )
+    {
+        MachineBlock &block = *this->function->blocks[ b ];
+        uint32_t from = this->blockStarts[ b ];
+        RegisterSet liveOut(count);
+        for ( auto successor: block.successors )
+        {
+            liveOut.insertAll(this->liveIn[ successor->id ]);
+        }
+        liveOut.forEach([ & ](size_t i)
+                        {
+                            live[ i ] = true;
+                            this->parts[ i ][ 0 ]->prependRange(from, this->blockStarts[ b + 1 ]);
+                        });
+
+        auto define = [ & ](LiveInterval &interval, std::vector<bool>::reference isLive, uint32_t position)
+        {
+            if ( isLive )
+            {
+                interval.ranges.back().from = position;
+            }
+            else
+            {
+                interval.prependRange(position, position + 1);
+            }
+            isLive = false;
+            if ( interval.uses.empty() || interval.uses.back() != position )
+            {
+                interval.uses.push_back(position);
+            }
+        };
+        auto use = [ & ](LiveInterval &interval, std::vector<bool>::reference isLive, uint32_t position)
+        {
+            if ( !isLive )
+            {
+                interval.prependRange(from, position + 1);
+            }
+            isLive = true;
+            if ( interval.uses.empty() || interval.uses.back() != position )
+            {
+                interval.uses.push_back(position);
+            }
+        };
+
+        // Physical registers are only live within a block.
+        std::vector<bool> physical(REGISTER_COUNT);
+        for ( size_t i = block.instructions.size(); i-- > 0; )
+        {
+            MachineInstruction &instruction = *block.instructions[ i ];
+            uint32_t position = from + 2 * (uint32_t) i;
+            instruction.forEachDef([ & ](uint32_t reg)
+                                   {
+                                       if ( isVirtual(reg))
+                                       {
+                                           define(*this->parts[ reg - FIRST_VIRTUAL_REGISTER ][ 0 ],
+                                                  live[ reg - FIRST_VIRTUAL_REGISTER ], position + 1);
+                                       }
+                                       else if ( isAllocatable(reg))
+                                       {
+                                           define(this->fixed[ reg ], physical[ reg ], position + 1);
+                                       }
+                                   });
+            instruction.forEachUse([ & ](uint32_t reg)
+                                   {
+                                       if ( isVirtual(reg))
+                                       {
+                                           use(*this->parts[ reg - FIRST_VIRTUAL_REGISTER ][ 0 ],
+                                               live[ reg - FIRST_VIRTUAL_REGISTER ], position);
+                                       }
+                                       else if ( isAllocatable(reg))
+                                       {
+                                           use(this->fixed[ reg ], physical[ reg ], position);
+                                       }
+                                   });
+        }
+
+        // The registers still live are the ones live at the start of the block.
+        this->liveIn[ b ].forEach([ & ](size_t i)
+                                  { live[ i ] = false; });
+    }
+
+    for ( auto &interval: this->intervals )
+    {
+        std::reverse(interval->ranges.begin(), interval->ranges.end());
+        std::reverse(interval->uses.begin(), interval->uses.end());
+    }
+    for ( auto &interval: this->fixed )
+    {
+        std::reverse(interval.ranges.begin(), interval.ranges.end());
+        std::reverse(interval.uses.begin(), interval.uses.end());
+    }
+}
+
+uint32_t LinearScanAllocator::representativeOf(uint32_t reg)
+{
+    uint32_t index = reg - FIRST_VIRTUAL_REGISTER;
+    while ( this->representatives[ index ] != index )
+    {
+        this->representatives[ index ] = this->representatives[ this->representatives[ index ]];
+        index = this->representatives[ index ];
+    }
+    return FIRST_VIRTUAL_REGISTER + index;
+}
+
+void LinearScanAllocator::coalesceCopies()
+{
+    size_t count = this->function->registerClasses.size();
+    this->representatives.resize(count);
+    std::iota(this->representatives.begin(), this->representatives.end(), 0);
+    this->hints.assign(count, {});
+
+    // Copies in loops are coalesced first, as they're executed most often.
+    std::vector<MachineBlock *> order;
+    for ( auto &block: this->function->blocks )
+    {
+        order.push_back(block.get());
+    }
+    std::stable_sort(order.begin(), order.end(), [](MachineBlock *first, MachineBlock *second)
+    { return first->loopDepth > second->loopDepth; });
+
+    for ( auto block: order )
+    {
+        for ( auto &instruction: block->instructions )
+        {
+            if ( instruction->opcode != MI_COPY )
+            {
+                continue;
+            }
+            uint32_t source = instruction->operands[ 0 ].reg;
+            uint32_t destination = instruction->operands[ 1 ].reg;
+            if ( !isVirtual(source) || !isVirtual(destination))
+            {
+                if ( isVirtual(source) && isAllocatable(destination))
+                {
+                    this->hints[ this->representativeOf(source) - FIRST_VIRTUAL_REGISTER ].push_back(destination);
+                }
+                else if ( isVirtual(destination) && isAllocatable(source))
+                {
+                    this->hints[ this->representativeOf(destination) - FIRST_VIRTUAL_REGISTER ].push_back(source);
+                }
+                continue;
+            }
+
+            uint32_t first = this->representativeOf(source) - FIRST_VIRTUAL_REGISTER;
+            uint32_t second = this->representativeOf(destination) - FIRST_VIRTUAL_REGISTER;
+            if ( first == second )
+            {
+                continue;
+            }
+            LiveInterval &kept = *this->parts[ first ][ 0 ];
+            LiveInterval &merged = *this->parts[ second ][ 0 ];
+            if ( kept.ranges.empty() || merged.ranges.empty())
+            {
+                continue;
+            }
+            if ( kept.nextIntersection(merged, std::max(kept.start(), merged.start())) != UINT32_MAX )
+            {
+                // The registers are live at once; they can only share a register if the other is free.
+                this->hints[ first ].push_back(FIRST_VIRTUAL_REGISTER + second);
+                this->hints[ second ].push_back(FIRST_VIRTUAL_REGISTER + first);
+                continue;
+            }
+            kept.ranges = unionOf(kept.ranges, merged.ranges);
+            std::vector<uint32_t> uses;
+            std::merge(kept.uses.begin(), kept.uses.end(), merged.uses.begin(), merged.uses.end(),
+                       std::back_inserter(uses));
+            kept.uses = std::move(uses);
+            merged.ranges.clear();
+            merged.uses.clear();
+            this->hints[ first ].insert(this->hints[ first ].end(), this->hints[ second ].begin(),
+                                        this->hints[ second ].end());
+            this->representatives[ second ] = first;
+        }
+    }
+
+    for ( auto &block: this->function->blocks )
+    {
+        for ( auto &instruction: block->instructions )
+        {
+            for ( auto &operand: instruction->operands )
+            {
+                if (( operand.isRegister() || operand.isMemory()) && isVirtual(operand.reg))
+                {
+                    operand.reg = this->representativeOf(operand.reg);
+                }
+                if ( operand.isMemory() && isVirtual(operand.index))
+                {
+                    operand.index = this->representativeOf(operand.index);
+                }
+            }
+        }
+    }
+}
+
+float LinearScanAllocator::depthWeightAt(uint32_t position) const
+{
+    // Empty blocks start where the next one does; the last block that starts there holds the position.
+    auto next = std::upper_bound(this->blockStarts.begin(), this->blockStarts.end() - 1, position);
+    uint32_t depth = this->function->blocks[ next - this->blockStarts.begin() - 1 ]->loopDepth;
+    float weight = 1;
+    for ( uint32_t i = 0; i < std::min<uint32_t>(depth, MAX_WEIGHTED_LOOP_DEPTH); i++ )
+    {
+        weight *= LOOP_WEIGHT;
+    }
+    return weight;
+}
+
+void LinearScanAllocator::computeWeight(LiveInterval &interval) const
+{
+    float cost = 0;
+    for ( auto position: interval.uses )
+    {
+        cost += this->depthWeightAt(position);
+    }
+    uint32_t length = 0;
+    for ( auto &range: interval.ranges )
+    {
+        length += range.to - range.from;
+    }
+    interval.weight = cost / (float) ( length / 2 + 1 );
+}
+
+LiveInterval *LinearScanAllocator::split(LiveInterval &interval, uint32_t position)
+{
+    auto rest = std::make_unique<LiveInterval>();
+    rest->reg = interval.reg;
+    rest->registerClass = interval.registerClass;
+
+    std::vector<LiveRange> kept;
+    for ( auto &range: interval.ranges )
+    {
+        if ( range.to <= position )
+        {
+            kept.push_back(range);
+        }
+        else if ( range.from >= position )
+        {
+            rest->ranges.push_back(range);
+        }
+        else
+        {
+            kept.push_back({ range.from, position });
+            rest->ranges.push_back({ position, range.to });
+        }
+    }
+    interval.ranges = std::move(kept);
+    auto firstUse = std::lower_bound(interval.uses.begin(), interval.uses.end(), position);
+    rest->uses.assign(firstUse, interval.uses.end());
+    interval.uses.erase(firstUse, interval.uses.end());
+    this->computeWeight(interval);
+    this->computeWeight(*rest);
+
+    LiveInterval *part = rest.get();
+    this->parts[ interval.reg - FIRST_VIRTUAL_REGISTER ].push_back(part);
+    this->intervals.push_back(std::move(rest));
+    return part;
+}
+
+void LinearScanAllocator::scan()
+{
+    std::vector<LiveInterval *> unhandled;
+    std::vector<LiveInterval *> active;
+    std::vector<LiveInterval *> inactive;
+    for ( auto &interval: this->intervals )
+    {
+        if ( !interval->ranges.empty())
+        {
+            unhandled.push_back(interval.get());
+        }
+    }
+    std::make_heap(unhandled.begin(), unhandled.end(), startsLater);
+    this->lastAssigned.assign(this->function->registerClasses.size(), NO_REGISTER);
+
+    while ( !unhandled.empty())
+    {
+        std::pop_heap(unhandled.begin(), unhandled.end(), startsLater);
+        LiveInterval *current = unhandled.back();
+        unhandled.pop_back();
+        uint32_t position = current->start();
+
+        // Intervals that ended are done with; the others are active while they're live, and inactive in their holes.
+        std::vector<LiveInterval *> stillActive;
+        std::vector<LiveInterval *> stillInactive;
+        for ( auto interval: active )
+        {
+            if ( interval->end() > position )
+            {
+                ( interval->covers(position) ? stillActive : stillInactive ).push_back(interval);
+            }
+        }
+        for ( auto interval: inactive )
+        {
+            if ( interval->end() > position )
+            {
+                ( interval->covers(position) ? stillActive : stillInactive ).push_back(interval);
+            }
+        }
+        active = std::move(stillActive);
+        inactive = std::move(stillInactive);
+
+        if ( !this->tryAllocateFree(*current, active, inactive, unhandled))
+        {
+            this->allocateBlocked(*current, active, inactive, unhandled);
+        }
+        if ( current->assigned != NO_REGISTER )
+        {
+            active.push_back(current);
+            this->lastAssigned[ current->reg - FIRST_VIRTUAL_REGISTER ] = current->assigned;
+        }
+    }
+}
+
+bool LinearScanAllocator::tryAllocateFree(LiveInterval &current, std::vector<LiveInterval *> &active,
+                                          std::vector<LiveInterval *> &inactive,
+                                          std::vector<LiveInterval *> &unhandled)
+{
+    const std::vector<ERegister> &registers = allocatableRegisters(current.registerClass);
+    uint32_t freeUntil[REGISTER_COUNT] = {};
+    for ( auto reg: registers )
+    {
+        freeUntil[ reg ] = this->fixed[ reg ].nextIntersection(current, current.start());
+    }
+    for ( auto interval: active )
+    {
+        freeUntil[ interval->assigned ] = 0;
+    }
+    for ( auto interval: inactive )
+    {
+        freeUntil[ interval->assigned ] = std::min(freeUntil[ interval->assigned ],
+                                                   interval->nextIntersection(current, current.start()));
+    }
+
+    // A register the interval is copied to or from is preferred, so the copy can be removed.
+    uint32_t end = current.end();
+    uint32_t chosen = NO_REGISTER;
+    for ( auto hint: this->hints[ current.reg - FIRST_VIRTUAL_REGISTER ] )
+    {
+        uint32_t reg = isVirtual(hint) ? this->lastAssigned[ this->representativeOf(hint) - FIRST_VIRTUAL_REGISTER ]
+                                       : hint;
+        if ( reg != NO_REGISTER && classOf((ERegister) reg) == current.registerClass && freeUntil[ reg ] >= end )
+        {
+            chosen = reg;
+            break;
+        }
+    }
+    for ( auto reg: registers )
+    {
+        if ( chosen == NO_REGISTER && freeUntil[ reg ] >= end )
+        {
+            chosen = reg;
+        }
+    }
+    if ( chosen == NO_REGISTER )
+    {
+        // No register is free for all of the interval; the one that's free the longest holds the first part.
+        for ( auto reg: registers )
+        {
+            if ( chosen == NO_REGISTER || freeUntil[ reg ] > freeUntil[ chosen ] )
+            {
+                chosen = reg;
+            }
+        }
+        uint32_t position = freeUntil[ chosen ] & ~1u;
+        if ( position <= current.start())
+        {
+            return false;
+        }
+        enqueue(unhandled, this->split(current, position));
+    }
+    current.assigned = chosen;
+    return true;
+}
+
+void LinearScanAllocator::allocateBlocked(LiveInterval &current, std::vector<LiveInterval *> &active,
+                                          std::vector<LiveInterval *> &inactive,
+                                          std::vector<LiveInterval *> &unhandled)
+{
+    const std::vector<ERegister> &registers = allocatableRegisters(current.registerClass);
+    uint32_t start = current.start();
+    uint32_t blockedFrom[REGISTER_COUNT] = {};
+    float costs[REGISTER_COUNT] = {};
+    for ( auto reg: registers )
+    {
+        blockedFrom[ reg ] = this->fixed[ reg ].nextIntersection(current, start);
+    }
+    for ( auto interval: active )
+    {
+        costs[ interval->assigned ] += interval->weight;
+    }
+    for ( auto interval: inactive )
+    {
+        if ( interval->nextIntersection(current, start) != UINT32_MAX )
+        {
+            costs[ interval->assigned ] += interval->weight;
+        }
+    }
+
+    // The intervals that are cheapest to spill give up their register, if they're cheaper than this one.
+    uint32_t chosen = NO_REGISTER;
+    for ( auto reg: registers )
+    {
+        if (( blockedFrom[ reg ] & ~1u ) > start && ( chosen == NO_REGISTER || costs[ reg ] < costs[ chosen ] ))
+        {
+            chosen = reg;
+        }
+    }
+    if ( chosen == NO_REGISTER || costs[ chosen ] >= current.weight )
+    {
+        this->spill(current, start, unhandled);
+        return;
+    }
+
+    for ( auto *list: { &active, &inactive } )
+    {
+        std::vector<LiveInterval *> kept;
+        for ( auto interval: *list )
+        {
+            if ( interval->assigned == chosen &&
+                 ( list == &active || interval->nextIntersection(current, start) != UINT32_MAX ))
+            {
+                this->spill(*interval, start, unhandled);
+                continue;
+            }
+            kept.push_back(interval);
+        }
+        *list = std::move(kept);
+    }
+    current.assigned = chosen;
+    if ( blockedFrom[ chosen ] < current.end())
+    {
+        enqueue(unhandled, this->split(current, blockedFrom[ chosen ] & ~1u));
+    }
+}
+
+void LinearScanAllocator::spill(LiveInterval &interval, uint32_t position, std::vector<LiveInterval *> &unhandled)
+{
+    // The part before the position keeps its register.
+    LiveInterval *spilled = &interval;
+    uint32_t at = position & ~1u;
+    if ( at > interval.start())
+    {
+        spilled = this->split(interval, at);
+    }
+    spilled->assigned = NO_REGISTER;
+
+    // From the next use on, the interval may find a register again.
+    for ( auto use: spilled->uses )
+    {
+        uint32_t next = use & ~1u;
+        if ( next > spilled->start())
+        {
+            if ( next < spilled->end())
+            {
+                enqueue(unhandled, this->split(*spilled, next));
+            }
+            break;
+        }
+    }
+}
+
+const LiveInterval *LinearScanAllocator::partAt(uint32_t reg, uint32_t position) const
+{
+    for ( auto part: this->parts[ reg - FIRST_VIRTUAL_REGISTER ] )
+    {
+        if ( part->covers(position))
+        {
+            return part;
+        }
+    }
+    return nullptr;
+}
+
+void LinearScanAllocator::rewrite(const std::vector<int32_t> &slots)
+{
+    // Where a part starts within a block, the value is moved from the part before it.
+    std::vector<std::vector<Move>> splitMoves(this->blockStarts.back() / 2);
+    for ( auto &interval: this->intervals )
+    {
+        if ( interval->ranges.empty())
+        {
+            continue;
+        }
+        uint32_t start = interval->start();
+        if ( start % 2 != 0 || std::binary_search(this->blockStarts.begin(), this->blockStarts.end(), start))
+        {
+            continue;
+        }
+        const LiveInterval *previous = this->partAt(interval->reg, start - 1);
+        if ( previous != nullptr && previous != interval.get())
+        {
+            splitMoves[ start / 2 ].push_back({ locationOf(*previous, slots), locationOf(*interval, slots),
+                                                interval->registerClass });
+        }
+    }
+
+    for ( size_t b = 0; b < this->function->blocks.size(); b++ )
+    {
+        MachineBlock &block = *this->function->blocks[ b ];
+        std::vector<std::unique_ptr<MachineInstruction>> rewritten;
+        for ( size_t i = 0; i < block.instructions.size(); i++ )
+        {
+            auto &instruction = block.instructions[ i ];
+            uint32_t position = this->blockStarts[ b ] + 2 * (uint32_t) i;
+            emitParallelMoves(rewritten, splitMoves[ position / 2 ]);
+
+            // Parts in a stack slot keep their virtual register, which is rewritten once they're all known.
+            auto locate = [ & ](uint32_t &reg, uint32_t at)
+            {
+                if ( isVirtual(reg))
+                {
+                    const LiveInterval *part = this->partAt(reg, at);
+                    if ( part != nullptr && part->assigned != NO_REGISTER )
+                    {
+                        reg = part->assigned;
+                    }
+                }
+            };
+            for ( auto &operand: instruction->operands )
+            {
+                if ( operand.isRegister())
+                {
+                    locate(operand.reg, operand.isUse ? position : position + 1);
+                }
+                else if ( operand.isMemory())
+                {
+                    locate(operand.reg, position);
+                    locate(operand.index, position);
+                }
+            }
+            if ( instruction->opcode == MI_COPY && instruction->operands[ 0 ].reg == instruction->operands[ 1 ].reg )
+            {
+                continue;
+            }
+            rewritten.push_back(std::move(instruction));
+        }
+        block.instructions = std::move(rewritten);
+        rewriteSpilled(*this->function, block, slots);
+    }
+}
+
+void LinearScanAllocator::resolveEdges(const std::vector<int32_t> &slots)
+{
+    size_t blockCount = this->function->blocks.size();
+    for ( size_t b = 0; b < blockCount; b++ )
+    {
+        MachineBlock *predecessor = this->function->blocks[ b ].get();
+        if ( this->blockStarts[ b ] == this->blockStarts[ b + 1 ] )
+        {
+            continue;
+        }
+        std::vector<MachineBlock *> successors = predecessor->successors;
+        for ( auto successor: successors )
+        {
+            // Registers that were coalesced are live as one.
+            std::vector<uint32_t> live;
+            this->liveIn[ successor->id ].forEach([ & ](size_t i)
+                                                  {
+                                                      live.push_back(this->representativeOf(
+                                                              FIRST_VIRTUAL_REGISTER + (uint32_t) i));
+                                                  });
+            std::sort(live.begin(), live.end());
+            live.erase(std::unique(live.begin(), live.end()), live.end());
+
+            std::vector<Move> moves;
+            for ( auto reg: live )
+            {
+                const LiveInterval *from = this->partAt(reg, this->blockStarts[ b + 1 ] - 1);
+                const LiveInterval *to = this->partAt(reg, this->blockStarts[ successor->id ]);
+                if ( from != nullptr && to != nullptr && from != to )
+                {
+                    moves.push_back({ locationOf(*from, slots), locationOf(*to, slots), from->registerClass });
+                }
+            }
+            std::vector<std::unique_ptr<MachineInstruction>> sequence;
+            emitParallelMoves(sequence, moves);
+            if ( sequence.empty())
+            {
+                continue;
+            }
+
+            // The moves are placed at the end of the predecessor, or the start of the successor, if the other
+            // block isn't left or entered in other ways; otherwise, they get a block of their own on the edge.
+            auto &instructions = predecessor->instructions;
+            auto terminator = std::find_if(instructions.begin(), instructions.end(),
+                                           [](const std::unique_ptr<MachineInstruction> &instruction)
+                                           { return instruction->isTerminator(); });
+            if ( predecessor->successors.size() == 1 && terminator != instructions.end() &&
+                 ( *terminator )->opcode != MI_JMP_TABLE )
+            {
+                instructions.insert(terminator, std::make_move_iterator(sequence.begin()),
+                                    std::make_move_iterator(sequence.end()));
+                continue;
+            }
+            if ( successor->predecessors.size() == 1 )
+            {
+                successor->instructions.insert(successor->instructions.begin(),
+                                               std::make_move_iterator(sequence.begin()),
+                                               std::make_move_iterator(sequence.end()));
+                continue;
+            }
+
+            MachineBlock *edge = this->function->createBlock("resolve");
+            edge->id = (uint32_t) this->function->blocks.size() - 1;
+            edge->loopDepth = std::min(predecessor->loopDepth, successor->loopDepth);
+            edge->instructions = std::move(sequence);
+            edge->append(MI_JMP, { MachineOperand::target(successor) });
+            edge->successors = { successor };
+            edge->predecessors = { predecessor };
+            for ( auto &instruction: instructions )
+            {
+                for ( auto &operand: instruction->operands )
+                {
+                    if ( operand.kind == OPERAND_BLOCK && operand.block == successor )
+                    {
+                        operand.block = edge;
+                    }
+                }
+            }
+            for ( auto &table: this->function->jumpTables )
+            {
+                if ( table.source == predecessor )
+                {
+                    std::replace(table.targets.begin(), table.targets.end(), successor, edge);
+                }
+            }
+            std::replace(predecessor->successors.begin(), predecessor->successors.end(), successor, edge);
+            std::replace(successor->predecessors.begin(), successor->predecessors.end(), predecessor, edge);
+        }
+    }
+}
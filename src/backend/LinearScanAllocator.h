@@ -0,0 +1,211 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_LINEARSCANALLOCATOR_H
+#define STRIDE_LANGUAGE_LINEARSCANALLOCATOR_H
+
+#include <bit>
+#include <memory>
+#include <vector>
+#include "RegisterAllocator.h"
+
+namespace stride::backend
+{
+
+    /**
+     * Positions in which a register is live, from 'from' up to, but not including, 'to'.
+     * Instructions are numbered in the order of the blocks; the instruction with number
+     * n reads its operands at position 2n, and writes them at position 2n + 1.
+     */
+    struct LiveRange
+    {
+        uint32_t from;
+        uint32_t to;
+    };
+
+    /**
+     * The positions in which a register is live, with the holes in which it isn't.
+     * Once a virtual register is split, every part of it is an interval of its own,
+     * with a location of its own; either a physical register, or its stack slot.
+     */
+    struct LiveInterval
+    {
+        uint32_t reg;
+        ERegisterClass registerClass;
+
+        /**
+         * The ranges in which the register is live, in order, without overlap.
+         */
+        std::vector<LiveRange> ranges;
+
+        /**
+         * The positions in which the register is read or written, in order.
+         */
+        std::vector<uint32_t> uses;
+
+        /**
+         * The cost of keeping the interval in its stack slot instead of a register,
+         * relative to the amount of positions it occupies a register for.
+         */
+        float weight = 0;
+        uint32_t assigned = NO_REGISTER;
+
+        [[nodiscard]] uint32_t start() const
+        { return this->ranges.front().from; }
+
+        [[nodiscard]] uint32_t end() const
+        { return this->ranges.back().to; }
+
+        [[nodiscard]] bool covers(uint32_t position) const;
+
+        /**
+         * Returns the first position from 'position' on in which both intervals are live, or UINT32_MAX.
+         */
+        [[nodiscard]] uint32_t nextIntersection(const LiveInterval &other, uint32_t position) const;
+
+        /**
+         * Adds a range while the intervals are built, from the last position to the first.
+         */
+        void prependRange(uint32_t from, uint32_t to);
+    };
+
+    /**
+     * A set of virtual registers, by their number from FIRST_VIRTUAL_REGISTER, stored as bits.
+     */
+    class RegisterSet
+    {
+    private:
+        std::vector<uint64_t> words;
+
+    public:
+        RegisterSet() = default;
+
+        explicit RegisterSet(size_t size) : words(( size + 63 ) / 64)
+        {}
+
+        [[nodiscard]] bool contains(size_t index) const
+        { return ( this->words[ index / 64 ] >> ( index % 64 )) & 1; }
+
+        void insert(size_t index)
+        { this->words[ index / 64 ] |= 1ULL << ( index % 64 ); }
+
+        void insertAll(const RegisterSet &other)
+        {
+            for ( size_t i = 0; i < this->words.size(); i++ )
+            {
+                this->words[ i ] |= other.words[ i ];
+            }
+        }
+
+        /**
+         * Adds the registers of a set that aren't in another, and returns whether any were new.
+         */
+        bool insertAll(const RegisterSet &other, const RegisterSet &excluded)
+        {
+            bool changed = false;
+            for ( size_t i = 0; i < this->words.size(); i++ )
+            {
+                uint64_t word = this->words[ i ] | ( other.words[ i ] & ~excluded.words[ i ] );
+                changed |= word != this->words[ i ];
+                this->words[ i ] = word;
+            }
+            return changed;
+        }
+
+        template<typename Callback>
+        void forEach(Callback callback) const
+        {
+            for ( size_t i = 0; i < this->words.size(); i++ )
+            {
+                for ( uint64_t word = this->words[ i ]; word != 0; word &= word - 1 )
+                {
+                    callback(i * 64 + std::countr_zero(word));
+                }
+            }
+        }
+    };
+
+    /**
+     * Allocates registers with the linear scan algorithm of Wimmer and Mössenböck,
+     * which handles large functions in about linear time, where graph coloring doesn't.
+     *
+     * Intervals are allocated in the order of their start. An interval gets the register
+     * that's free the longest, and is split where that register is needed again; if every
+     * register is taken, the intervals that are cheapest to keep in memory are spilled, where
+     * the cost of an interval is the sum of its uses, each weighted by the depth of the loop
+     * it's in, relative to the length of the interval. Copies between virtual registers whose
+     * intervals don't overlap, such as the copies of phi nodes, are coalesced beforehand.
+     *
+     * Afterwards, moves are inserted where parts of a split interval meet, and on the edges
+     * between blocks where a register is in different locations. Spilled registers are read
+     * and written through the scratch registers.
+     */
+    class LinearScanAllocator : public RegisterAllocator
+    {
+    private:
+        MachineFunction *function = nullptr;
+
+        /**
+         * The first position of every block, by their id, followed by the last position.
+         */
+        std::vector<uint32_t> blockStarts;
+        std::vector<RegisterSet> liveIn;
+
+        std::vector<std::unique_ptr<LiveInterval>> intervals;
+
+        /**
+         * The intervals of every virtual register; the intervals it was split into.
+         */
+        std::vector<std::vector<LiveInterval *>> parts;
+        std::vector<LiveInterval> fixed;
+
+        /**
+         * The register that every virtual register was coalesced into.
+         */
+        std::vector<uint32_t> representatives;
+
+        /**
+         * Registers that a virtual register is copied to or from, which it should preferably share.
+         */
+        std::vector<std::vector<uint32_t>> hints;
+        std::vector<uint32_t> lastAssigned;
+
+        void numberInstructions();
+
+        void computeLiveness();
+
+        void buildIntervals();
+
+        uint32_t representativeOf(uint32_t reg);
+
+        void coalesceCopies();
+
+        float depthWeightAt(uint32_t position) const;
+
+        void computeWeight(LiveInterval &interval) const;
+
+        LiveInterval *split(LiveInterval &interval, uint32_t position);
+
+        void scan();
+
+        bool tryAllocateFree(LiveInterval &current, std::vector<LiveInterval *> &active,
+                             std::vector<LiveInterval *> &inactive, std::vector<LiveInterval *> &unhandled);
+
+        void allocateBlocked(LiveInterval &current, std::vector<LiveInterval *> &active,
+                             std::vector<LiveInterval *> &inactive, std::vector<LiveInterval *> &unhandled);
+
+        void spill(LiveInterval &interval, uint32_t position, std::vector<LiveInterval *> &unhandled);
+
+        const LiveInterval *partAt(uint32_t reg, uint32_t position) const;
+
+        void rewrite(const std::vector<int32_t> &slots);
+
+        void resolveEdges(const std::vector<int32_t> &slots);
+
+    public:
+        void allocate(MachineFunction &function) override;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_LINEARSCANALLOCATOR_H
@@ -0,0 +1,722 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <bit>
+#include <unordered_set>
+#include "MachineCodeEncoder.h"
+
+using namespace stride::backend;
+
+/** The condition codes of jcc and setcc, in the order of ECondition. */
+static const uint8_t CONDITION_CODES[] = { 0x4, 0x5, 0xC, 0xE, 0xF, 0xD, 0x2, 0x6, 0x7, 0x3, 0xA, 0xB };
+
+/**
+ * Returns the number of a register in the fields of an instruction; the registers above 7 set a bit of the REX prefix.
+ */
+static uint8_t encodingOf(uint32_t reg)
+{
+    return reg >= XMM0 ? reg - XMM0 : reg;
+}
+
+/**
+ * Whether an operand is spl, bpl, sil or dil, which can only be addressed with a REX prefix;
+ * without one, their encoding is the one of ah, ch, dh and bh.
+ */
+static bool needsRex(const MachineOperand &operand)
+{
+    return operand.isRegister() && operand.size == 1 && operand.reg >= RSP && operand.reg <= RDI;
+}
+
+static bool fitsInt8(int64_t value)
+{
+    return value >= INT8_MIN && value <= INT8_MAX;
+}
+
+static void emitInteger(std::vector<uint8_t> &bytes, int64_t value, uint8_t size)
+{
+    for ( uint8_t i = 0; i < size; i++ )
+    {
+        bytes.push_back((uint8_t) ( value >> ( i * 8 )));
+    }
+}
+
+/**
+ * Encodes an instruction with a ModRM byte; [prefix] [REX] opcode ModRM [SIB] [displacement] [immediate].
+ * The prefix is the operand size prefix, or the one that selects the instruction. The reg field is a
+ * register, or the extension of the opcode; the r/m field is a register or memory operand.
+ */
+static void emitModRM(EncodedInstruction &encoded, uint8_t prefix, bool wide, std::initializer_list<uint8_t> opcode,
+                      uint8_t reg, const MachineOperand &rm, bool byteRegisters, uint8_t immediateSize = 0,
+                      int64_t immediate = 0)
+{
+    auto &bytes = encoded.bytes;
+    if ( prefix != 0 )
+    {
+        bytes.push_back(prefix);
+    }
+
+    uint8_t rex = 0x40 | ( wide ? 0x8 : 0 ) | ((( reg >> 3 ) & 1 ) << 2 );
+    if ( rm.isRegister())
+    {
+        rex |= ( encodingOf(rm.reg) >> 3 ) & 1;
+    }
+    else if ( rm.symbol.empty())
+    {
+        rex |= rm.index != NO_REGISTER ? (( rm.index >> 3 ) & 1 ) << 1 : 0;
+        rex |= rm.reg != NO_REGISTER ? ( rm.reg >> 3 ) & 1 : 0;
+    }
+    if ( rex != 0x40 || byteRegisters )
+    {
+        bytes.push_back(rex);
+    }
+    bytes.insert(bytes.end(), opcode);
+
+    reg = ( reg & 7 ) << 3;
+    int64_t fixup = -1;
+    if ( rm.isRegister())
+    {
+        bytes.push_back(0xC0 | reg | ( encodingOf(rm.reg) & 7 ));
+    }
+    else if ( !rm.symbol.empty())
+    {
+        // Relative to the instruction pointer; mod 00 with r/m 101.
+        bytes.push_back(reg | 0x5);
+        fixup = (int64_t) bytes.size();
+        encoded.fixups.push_back({ bytes.size(), rm.external ? RELOCATION_GOTPCREL : RELOCATION_PC32, rm.symbol,
+                                   rm.external ? 0 : rm.immediate });
+        emitInteger(bytes, 0, 4);
+    }
+    else if ( rm.reg == NO_REGISTER )
+    {
+        // An absolute address, or an index without a base; a SIB byte without a base, and a 32-bit displacement.
+        uint8_t index = rm.index == NO_REGISTER ? 4 : rm.index & 7;
+        bytes.push_back(reg | 0x4);
+        bytes.push_back(( std::countr_zero(rm.scale) << 6 ) | ( index << 3 ) | 0x5);
+        emitInteger(bytes, rm.immediate, 4);
+    }
+    else
+    {
+        // A base of rsp or r12 needs a SIB byte; one of rbp or r13 without a displacement means there's no base.
+        uint8_t base = rm.reg & 7;
+        bool hasSib = rm.index != NO_REGISTER || base == 4;
+        uint8_t mod = rm.immediate == 0 && base != 5 ? 0 : fitsInt8(rm.immediate) ? 1 : 2;
+        bytes.push_back(( mod << 6 ) | reg | ( hasSib ? 0x4 : base ));
+        if ( hasSib )
+        {
+            uint8_t index = rm.index == NO_REGISTER ? 4 : rm.index & 7;
+            bytes.push_back(( std::countr_zero(rm.scale) << 6 ) | ( index << 3 ) | base);
+        }
+        emitInteger(bytes, rm.immediate, mod == 0 ? 0 : mod == 1 ? 1 : 4);
+    }
+    emitInteger(bytes, immediate, immediateSize);
+
+    if ( fixup >= 0 )
+    {
+        encoded.fixups.back().addend -= (int64_t) bytes.size() - fixup;
+    }
+}
+
+/**
+ * Encodes an instruction that holds its register in the opcode; [prefix] [REX] opcode+reg [immediate].
+ */
+static void emitOpcodeRegister(EncodedInstruction &encoded, uint8_t prefix, bool wide, uint8_t opcode,
+                               const MachineOperand &reg, uint8_t immediateSize = 0, int64_t immediate = 0)
+{
+    auto &bytes = encoded.bytes;
+    if ( prefix != 0 )
+    {
+        bytes.push_back(prefix);
+    }
+    uint8_t rex = 0x40 | ( wide ? 0x8 : 0 ) | (( reg.reg >> 3 ) & 1 );
+    if ( rex != 0x40 || needsRex(reg))
+    {
+        bytes.push_back(rex);
+    }
+    bytes.push_back(opcode + ( reg.reg & 7 ));
+    emitInteger(bytes, immediate, immediateSize);
+}
+
+/**
+ * Returns the extension of the opcode of an arithmetic instruction in the reg field, which is also its
+ * opcode divided by eight; e.g. 0x01 for add, and 0x29 for sub.
+ */
+static uint8_t arithmeticExtensionOf(EMachineOpcode opcode)
+{
+    switch ( opcode )
+    {
+        case MI_ADD:
+            return 0;
+        case MI_OR:
+            return 1;
+        case MI_AND:
+            return 4;
+        case MI_SUB:
+            return 5;
+        case MI_XOR:
+            return 6;
+        default:
+            return 7;
+    }
+}
+
+void MachineCodeEncoder::encodeInstruction(const MachineInstruction &instruction, EncodedInstruction &encoded)
+{
+    auto &operands = instruction.operands;
+    uint8_t size = operands.empty() ? 8 : operands.back().size;
+    uint8_t sizePrefix = size == 2 ? 0x66 : 0;
+    uint8_t floatPrefix = size == 4 ? 0xF3 : 0xF2;
+    bool wide = size == 8;
+    static const MachineOperand none;
+    const MachineOperand &source = operands.empty() ? none : operands.front();
+    const MachineOperand &destination = operands.empty() ? source : operands.back();
+    bool byteRegisters = needsRex(source) || needsRex(destination);
+
+    switch ( instruction.opcode )
+    {
+        case MI_COPY:
+            if ( classOf((ERegister) source.reg) == CLASS_XMM )
+            {
+                emitModRM(encoded, 0, false, { 0x0F, 0x28 }, encodingOf(destination.reg), source, false);
+            }
+            else
+            {
+                emitModRM(encoded, 0, true, { 0x89 }, encodingOf(source.reg), destination, false);
+            }
+            break;
+
+        case MI_MOV:
+            if ( source.kind == OPERAND_IMMEDIATE && destination.isRegister())
+            {
+                // A 64-bit immediate that's sign extended from 32 bits is shorter than one of 64 bits.
+                if ( wide && ( source.immediate < INT32_MIN || source.immediate > INT32_MAX ))
+                {
+                    emitOpcodeRegister(encoded, 0, true, 0xB8, destination, 8, source.immediate);
+                }
+                else if ( wide )
+                {
+                    emitModRM(encoded, 0, true, { 0xC7 }, 0, destination, false, 4, source.immediate);
+                }
+                else
+                {
+                    emitOpcodeRegister(encoded, sizePrefix, false, size == 1 ? 0xB0 : 0xB8, destination, size,
+                                       source.immediate);
+                }
+            }
+            else if ( source.kind == OPERAND_IMMEDIATE )
+            {
+                emitModRM(encoded, sizePrefix, wide, { (uint8_t) ( size == 1 ? 0xC6 : 0xC7 ) }, 0, destination, false,
+                          std::min<uint8_t>(size, 4), source.immediate);
+            }
+            else if ( source.isRegister())
+            {
+                emitModRM(encoded, sizePrefix, wide, { (uint8_t) ( size == 1 ? 0x88 : 0x89 ) }, encodingOf(source.reg),
+                          destination, byteRegisters);
+            }
+            else
+            {
+                emitModRM(encoded, sizePrefix, wide, { (uint8_t) ( size == 1 ? 0x8A : 0x8B ) },
+                          encodingOf(destination.reg), source, byteRegisters);
+            }
+            break;
+
+        case MI_MOVZX:
+        case MI_MOVSX:
+        {
+            bool isZero = instruction.opcode == MI_MOVZX;
+            if ( source.size == 4 )
+            {
+                // Moving 32 bits clears the upper half of the destination; movslq sign extends them.
+                emitModRM(encoded, 0, !isZero, { (uint8_t) ( isZero ? 0x8B : 0x63 ) }, encodingOf(destination.reg),
+                          source, false);
+                break;
+            }
+            uint8_t opcode = ( isZero ? 0xB6 : 0xBE ) + ( source.size == 2 ? 1 : 0 );
+            emitModRM(encoded, sizePrefix, wide, { 0x0F, opcode }, encodingOf(destination.reg), source, byteRegisters);
+            break;
+        }
+
+        case MI_LEA:
+            emitModRM(encoded, 0, true, { 0x8D }, encodingOf(destination.reg), source, false);
+            break;
+
+        case MI_ADD:
+        case MI_SUB:
+        case MI_AND:
+        case MI_OR:
+        case MI_XOR:
+        case MI_CMP:
+        {
+            uint8_t extension = arithmeticExtensionOf(instruction.opcode);
+            bool isAccumulator = destination.isRegister() && destination.reg == RAX;
+            if ( source.kind == OPERAND_IMMEDIATE && isAccumulator && ( size == 1 || !fitsInt8(source.immediate)))
+            {
+                // The accumulator has forms without a ModRM byte, e.g. 0x05 for add.
+                emitOpcodeRegister(encoded, sizePrefix, wide, extension * 8 + ( size == 1 ? 4 : 5 ), destination,
+                                   std::min<uint8_t>(size, 4), source.immediate);
+            }
+            else if ( source.kind == OPERAND_IMMEDIATE )
+            {
+                if ( size == 1 )
+                {
+                    emitModRM(encoded, 0, false, { 0x80 }, extension, destination, byteRegisters, 1, source.immediate);
+                }
+                else if ( fitsInt8(source.immediate))
+                {
+                    emitModRM(encoded, sizePrefix, wide, { 0x83 }, extension, destination, false, 1, source.immediate);
+                }
+                else
+                {
+                    emitModRM(encoded, sizePrefix, wide, { 0x81 }, extension, destination, false,
+                              std::min<uint8_t>(size, 4), source.immediate);
+                }
+            }
+            else if ( source.isRegister())
+            {
+                emitModRM(encoded, sizePrefix, wide, { (uint8_t) ( extension * 8 + ( size == 1 ? 0 : 1 )) },
+                          encodingOf(source.reg), destination, byteRegisters);
+            }
+            else
+            {
+                emitModRM(encoded, sizePrefix, wide, { (uint8_t) ( extension * 8 + ( size == 1 ? 2 : 3 )) },
+                          encodingOf(destination.reg), source, byteRegisters);
+            }
+            break;
+        }
+
+        case MI_IMUL:
+            if ( source.kind == OPERAND_IMMEDIATE )
+            {
+                bool isShort = fitsInt8(source.immediate);
+                emitModRM(encoded, sizePrefix, wide, { (uint8_t) ( isShort ? 0x6B : 0x69 ) },
+                          encodingOf(destination.reg), destination, false, isShort ? 1 : std::min<uint8_t>(size, 4),
+                          source.immediate);
+            }
+            else
+            {
+                emitModRM(encoded, sizePrefix, wide, { 0x0F, 0xAF }, encodingOf(destination.reg), source, false);
+            }
+            break;
+
+        case MI_SHL:
+        case MI_SHR:
+        case MI_SAR:
+        {
+            uint8_t extension = instruction.opcode == MI_SHL ? 4 : instruction.opcode == MI_SHR ? 5 : 7;
+            uint8_t byteOffset = size == 1 ? 0 : 1;
+            if ( source.kind != OPERAND_IMMEDIATE )
+            {
+                // The count is in cl.
+                emitModRM(encoded, sizePrefix, wide, { (uint8_t) ( 0xD2 + byteOffset ) }, extension, destination,
+                          needsRex(destination));
+            }
+            else if ( source.immediate == 1 )
+            {
+                emitModRM(encoded, sizePrefix, wide, { (uint8_t) ( 0xD0 + byteOffset ) }, extension, destination,
+                          needsRex(destination));
+            }
+            else
+            {
+                emitModRM(encoded, sizePrefix, wide, { (uint8_t) ( 0xC0 + byteOffset ) }, extension, destination,
+                          needsRex(destination), 1, source.immediate);
+            }
+            break;
+        }
+
+        case MI_NEG:
+        case MI_NOT:
+        case MI_IDIV:
+        case MI_DIV:
+        {
+            uint8_t extension = instruction.opcode == MI_NEG ? 3 : instruction.opcode == MI_NOT ? 2 :
+                                instruction.opcode == MI_IDIV ? 7 : 6;
+            emitModRM(encoded, sizePrefix, wide, { (uint8_t) ( size == 1 ? 0xF6 : 0xF7 ) }, extension, destination,
+                      byteRegisters);
+            break;
+        }
+
+        case MI_TEST:
+            if ( source.kind == OPERAND_IMMEDIATE && destination.isRegister() && destination.reg == RAX )
+            {
+                emitOpcodeRegister(encoded, sizePrefix, wide, size == 1 ? 0xA8 : 0xA9, destination,
+                                   std::min<uint8_t>(size, 4), source.immediate);
+            }
+            else if ( source.kind == OPERAND_IMMEDIATE )
+            {
+                emitModRM(encoded, sizePrefix, wide, { (uint8_t) ( size == 1 ? 0xF6 : 0xF7 ) }, 0, destination,
+                          byteRegisters, std::min<uint8_t>(size, 4), source.immediate);
+            }
+            else if ( source.isRegister())
+            {
+                emitModRM(encoded, sizePrefix, wide, { (uint8_t) ( size == 1 ? 0x84 : 0x85 ) }, encodingOf(source.reg),
+                          destination, byteRegisters);
+            }
+            else
+            {
+                emitModRM(encoded, sizePrefix, wide, { (uint8_t) ( size == 1 ? 0x84 : 0x85 ) },
+                          encodingOf(destination.reg), source, byteRegisters);
+            }
+            break;
+
+        case MI_SETCC:
+            emitModRM(encoded, 0, false, { 0x0F, (uint8_t) ( 0x90 + CONDITION_CODES[ instruction.condition ] ) }, 0,
+                      destination, byteRegisters);
+            break;
+
+        case MI_SIGN_EXTEND_ACCUMULATOR:
+            if ( source.size == 8 )
+            {
+                encoded.bytes.push_back(0x48);
+            }
+            encoded.bytes.push_back(0x99);
+            break;
+
+        case MI_MOVF:
+            if ( destination.isMemory())
+            {
+                emitModRM(encoded, floatPrefix, false, { 0x0F, 0x11 }, encodingOf(source.reg), destination, false);
+            }
+            else
+            {
+                emitModRM(encoded, floatPrefix, false, { 0x0F, 0x10 }, encodingOf(destination.reg), source, false);
+            }
+            break;
+
+        case MI_MOVQ:
+            if ( destination.isRegister() && classOf((ERegister) destination.reg) == CLASS_XMM )
+            {
+                emitModRM(encoded, 0x66, true, { 0x0F, 0x6E }, encodingOf(destination.reg), source, false);
+            }
+            else
+            {
+                emitModRM(encoded, 0x66, true, { 0x0F, 0x7E }, encodingOf(source.reg), destination, false);
+            }
+            break;
+
+        case MI_ADDF:
+        case MI_SUBF:
+        case MI_MULF:
+        case MI_DIVF:
+        {
+            static const uint8_t opcodes[] = { 0x58, 0x5C, 0x59, 0x5E };
+            emitModRM(encoded, floatPrefix, false, { 0x0F, opcodes[ instruction.opcode - MI_ADDF ] },
+                      encodingOf(destination.reg), source, false);
+            break;
+        }
+
+        case MI_XORF:
+            emitModRM(encoded, 0, false, { 0x0F, 0x57 }, encodingOf(destination.reg), source, false);
+            break;
+
+        case MI_UCOMIF:
+            emitModRM(encoded, size == 8 ? 0x66 : 0, false, { 0x0F, 0x2E }, encodingOf(destination.reg), source,
+                      false);
+            break;
+
+        case MI_CVTSI2F:
+            emitModRM(encoded, floatPrefix, source.size == 8, { 0x0F, 0x2A }, encodingOf(destination.reg), source,
+                      false);
+            break;
+
+        case MI_CVTF2SI:
+            emitModRM(encoded, source.size == 4 ? 0xF3 : 0xF2, wide, { 0x0F, 0x2C }, encodingOf(destination.reg),
+                      source, false);
+            break;
+
+        case MI_CVTF2F:
+            emitModRM(encoded, source.size == 4 ? 0xF3 : 0xF2, false, { 0x0F, 0x5A }, encodingOf(destination.reg),
+                      source, false);
+            break;
+
+        case MI_PUSH:
+            if ( source.isRegister())
+            {
+                emitOpcodeRegister(encoded, 0, false, 0x50, source);
+            }
+            else if ( source.kind == OPERAND_IMMEDIATE )
+            {
+                bool isShort = fitsInt8(source.immediate);
+                encoded.bytes.push_back(isShort ? 0x6A : 0x68);
+                emitInteger(encoded.bytes, source.immediate, isShort ? 1 : 4);
+            }
+            else
+            {
+                emitModRM(encoded, 0, false, { 0xFF }, 6, source, false);
+            }
+            break;
+
+        case MI_POP:
+            if ( source.isRegister())
+            {
+                emitOpcodeRegister(encoded, 0, false, 0x58, source);
+            }
+            else
+            {
+                emitModRM(encoded, 0, false, { 0x8F }, 0, source, false);
+            }
+            break;
+
+        case MI_CALL:
+            if ( source.kind == OPERAND_SYMBOL )
+            {
+                encoded.bytes.push_back(0xE8);
+                encoded.fixups.push_back({ 1, RELOCATION_PLT32, source.symbol, -4 });
+                emitInteger(encoded.bytes, 0, 4);
+            }
+            else
+            {
+                emitModRM(encoded, 0, false, { 0xFF }, 2, source, false);
+            }
+            break;
+
+        case MI_LEAVE:
+            encoded.bytes.push_back(0xC9);
+            break;
+
+        case MI_JMP:
+        case MI_JCC:
+            encoded.target = source.block;
+            encoded.conditional = instruction.opcode == MI_JCC;
+            encoded.condition = instruction.condition;
+            break;
+
+        case MI_JMP_TABLE:
+            emitModRM(encoded, 0, false, { 0xFF }, 4, source, false);
+            break;
+
+        case MI_RET:
+            encoded.bytes.push_back(0xC3);
+            break;
+
+        case MI_UD2:
+            encoded.bytes.insert(encoded.bytes.end(), { 0x0F, 0x0B });
+            break;
+    }
+}
+
+/**
+ * Returns the size of an instruction, with its jump encoded as it currently is.
+ */
+static uint64_t sizeOf(const EncodedInstruction &encoded)
+{
+    if ( encoded.target == nullptr )
+    {
+        return encoded.bytes.size();
+    }
+    return !encoded.isNear ? 2 : encoded.conditional ? 6 : 5;
+}
+
+uint64_t MachineCodeEncoder::allocate(ESectionKind section, uint64_t size, uint32_t alignment)
+{
+    // Code is padded with nops, so the padding can be executed.
+    ObjectSection &target = this->object.sections[ section ];
+    target.alignment = std::max(target.alignment, alignment);
+    if ( section == SECTION_BSS )
+    {
+        uint64_t offset = ( target.size + alignment - 1 ) / alignment * alignment;
+        target.size = offset + size;
+        return offset;
+    }
+    uint64_t offset = ( target.bytes.size() + alignment - 1 ) / alignment * alignment;
+    target.bytes.resize(offset, section == SECTION_TEXT ? 0x90 : 0);
+    target.bytes.resize(offset + size, 0);
+    return offset;
+}
+
+void MachineCodeEncoder::addSymbol(const std::string &name, ESectionKind section, uint64_t value, uint64_t size,
+                                   bool global, bool function)
+{
+    this->definitions[ name ] = { section, value };
+    if ( !name.starts_with(".L"))
+    {
+        this->object.symbols.push_back({ name, section, value, size, global, function });
+    }
+}
+
+void MachineCodeEncoder::layoutData(const MachineModule &module)
+{
+    for ( auto &data: module.data )
+    {
+        bool isZero = data.bytes.empty() && data.reference.empty();
+        ESectionKind section = data.readOnly ? SECTION_RODATA : isZero ? SECTION_BSS : SECTION_DATA;
+        uint64_t size = !data.reference.empty() ? 8 : isZero ? data.size : data.bytes.size();
+        uint64_t offset = this->allocate(section, size, data.alignment);
+        if ( !data.reference.empty())
+        {
+            this->fixups[ section ].push_back({ offset, RELOCATION_ABSOLUTE_64, data.reference, 0 });
+        }
+        else if ( !isZero )
+        {
+            std::copy(data.bytes.begin(), data.bytes.end(), this->object.sections[ section ].bytes.begin() + offset);
+        }
+        this->addSymbol(data.symbol, section, offset, data.size, data.exported, false);
+    }
+
+    for ( auto &[ symbol, size ]: module.commonSymbols )
+    {
+        this->object.symbols.push_back({ symbol, SECTION_UNDEFINED, size, size, true, false, true });
+    }
+
+    for ( auto &constructor: module.constructors )
+    {
+        uint64_t offset = this->allocate(SECTION_INIT_ARRAY, 8, 8);
+        this->fixups[ SECTION_INIT_ARRAY ].push_back({ offset, RELOCATION_ABSOLUTE_64, constructor, 0 });
+    }
+
+    // The tables are filled in once the offsets of their targets are known.
+    for ( auto &function: module.functions )
+    {
+        for ( auto &table: function->jumpTables )
+        {
+            uint64_t offset = this->allocate(SECTION_RODATA, table.targets.size() * 4, 4);
+            this->addSymbol(table.label, SECTION_RODATA, offset, 0, false, false);
+        }
+    }
+}
+
+void MachineCodeEncoder::encodeFunction(const MachineFunction &function)
+{
+    std::vector<EncodedInstruction> code;
+    std::unordered_map<const MachineBlock *, size_t> blockStarts;
+    for ( auto &block: function.blocks )
+    {
+        blockStarts[ block.get() ] = code.size();
+        for ( auto &instruction: block->instructions )
+        {
+            code.emplace_back();
+            this->encodeInstruction(*instruction, code.back());
+        }
+    }
+
+    // Jumps only grow, so this ends once every one of them reaches its target.
+    uint64_t size = 0;
+    auto offsetOf = [ & ](const MachineBlock *block)
+    {
+        size_t start = blockStarts.at(block);
+        return start < code.size() ? code[ start ].offset : size;
+    };
+    for ( bool changed = true; changed; )
+    {
+        changed = false;
+        size = 0;
+        for ( auto &encoded: code )
+        {
+            encoded.offset = size;
+            size += sizeOf(encoded);
+        }
+        for ( auto &encoded: code )
+        {
+            if ( encoded.target != nullptr && !encoded.isNear &&
+                 !fitsInt8((int64_t) offsetOf(encoded.target) - (int64_t) ( encoded.offset + 2 )))
+            {
+                encoded.isNear = true;
+                changed = true;
+            }
+        }
+    }
+
+    uint64_t start = this->allocate(SECTION_TEXT, size, 16);
+    auto &bytes = this->object.sections[ SECTION_TEXT ].bytes;
+    for ( auto &encoded: code )
+    {
+        uint64_t offset = start + encoded.offset;
+        if ( encoded.target == nullptr )
+        {
+            std::copy(encoded.bytes.begin(), encoded.bytes.end(), bytes.begin() + offset);
+            for ( auto &fixup: encoded.fixups )
+            {
+                this->fixups[ SECTION_TEXT ].push_back({ offset + fixup.offset, fixup.type, fixup.symbol,
+                                                         fixup.addend });
+            }
+            continue;
+        }
+
+        int64_t displacement = (int64_t) offsetOf(encoded.target) - (int64_t) ( encoded.offset + sizeOf(encoded));
+        uint8_t condition = CONDITION_CODES[ encoded.condition ];
+        std::vector<uint8_t> jump;
+        if ( !encoded.isNear )
+        {
+            jump = { (uint8_t) ( encoded.conditional ? 0x70 + condition : 0xEB ) };
+            emitInteger(jump, displacement, 1);
+        }
+        else
+        {
+            jump = encoded.conditional ? std::vector<uint8_t> { 0x0F, (uint8_t) ( 0x80 + condition ) } :
+                   std::vector<uint8_t> { 0xE9 };
+            emitInteger(jump, displacement, 4);
+        }
+        std::copy(jump.begin(), jump.end(), bytes.begin() + offset);
+    }
+
+    for ( auto &block: function.blocks )
+    {
+        this->blockOffsets[ block.get() ] = start + offsetOf(block.get());
+    }
+    this->addSymbol(function.symbol, SECTION_TEXT, start, size, function.exported, true);
+
+    // The entries are the offsets of the targets from the table; the distance between the sections is up to the linker.
+    for ( auto &table: function.jumpTables )
+    {
+        uint64_t tableOffset = this->definitions.at(table.label).second;
+        for ( size_t i = 0; i < table.targets.size(); i++ )
+        {
+            this->object.sections[ SECTION_RODATA ].relocations.push_back(
+                    { tableOffset + i * 4, RELOCATION_PC32, "", SECTION_TEXT,
+                      (int64_t) ( this->blockOffsets.at(table.targets[ i ]) + i * 4 ) });
+        }
+    }
+}
+
+void MachineCodeEncoder::resolveFixups()
+{
+    std::unordered_set<std::string> known;
+    for ( auto &symbol: this->object.symbols )
+    {
+        known.insert(symbol.name);
+    }
+
+    for ( int section = 0; section < SECTION_COUNT; section++ )
+    {
+        ObjectSection &target = this->object.sections[ section ];
+        for ( auto &fixup: this->fixups[ section ] )
+        {
+            auto definition = this->definitions.find(fixup.symbol);
+            bool isDefined = definition != this->definitions.end() && fixup.type != RELOCATION_GOTPCREL;
+
+            // Relative addresses in the same section are known; the processor adds them to the end of the instruction.
+            if ( isDefined && fixup.type != RELOCATION_ABSOLUTE_64 && definition->second.first == section )
+            {
+                int64_t value = (int64_t) definition->second.second + fixup.addend - (int64_t) fixup.offset;
+                for ( int i = 0; i < 4; i++ )
+                {
+                    target.bytes[ fixup.offset + i ] = (uint8_t) ( value >> ( i * 8 ));
+                }
+                continue;
+            }
+            if ( isDefined )
+            {
+                ERelocationType type = fixup.type == RELOCATION_PLT32 ? RELOCATION_PC32 : fixup.type;
+                target.relocations.push_back({ fixup.offset, type, "", definition->second.first,
+                                               fixup.addend + (int64_t) definition->second.second });
+                continue;
+            }
+            target.relocations.push_back({ fixup.offset, fixup.type, fixup.symbol, SECTION_UNDEFINED, fixup.addend });
+            if ( known.insert(fixup.symbol).second )
+            {
+                this->object.symbols.push_back({ fixup.symbol, SECTION_UNDEFINED, 0, 0, true, false });
+            }
+        }
+    }
+}
+
+void MachineCodeEncoder::encode(const MachineModule &module)
+{
+    this->object.sourceName = module.sourceName;
+    this->object.sections[ SECTION_TEXT ].alignment = 16;
+    this->layoutData(module);
+    for ( auto &function: module.functions )
+    {
+        this->encodeFunction(*function);
+    }
+    this->resolveFixups();
+}
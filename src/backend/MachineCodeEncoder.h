@@ -0,0 +1,110 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_MACHINECODEENCODER_H
+#define STRIDE_LANGUAGE_MACHINECODEENCODER_H
+
+#include <unordered_map>
+#include "MachineIR.h"
+#include "ObjectFile.h"
+
+namespace stride::backend
+{
+
+    /**
+     * A place in the code of an instruction that refers to a symbol, which is filled in once
+     * every symbol of the unit is laid out; either by the encoder, or by the linker.
+     */
+    struct Fixup
+    {
+        uint64_t offset;
+        ERelocationType type;
+        std::string symbol;
+
+        /**
+         * Added to the address of the symbol; for relative fixups, this includes the distance
+         * from the fixup to the end of the instruction, which the processor is relative to.
+         */
+        int64_t addend;
+    };
+
+    /**
+     * The bytes of an instruction, or of a jump to a block, which is encoded once its distance is known.
+     */
+    struct EncodedInstruction
+    {
+        std::vector<uint8_t> bytes;
+        std::vector<Fixup> fixups;
+
+        /**
+         * The target of a jump, or null.
+         */
+        MachineBlock *target = nullptr;
+        bool conditional = false;
+        ECondition condition = COND_E;
+
+        /**
+         * Whether a jump needs a 32-bit displacement, because its target is beyond the reach of 8 bits.
+         */
+        bool isNear = false;
+        uint64_t offset = 0;
+    };
+
+    /**
+     * Encodes a machine module as x86-64 machine code, in the sections of an object file.
+     *
+     * Jumps are encoded with an 8-bit displacement where it reaches the target, like the GNU
+     * assembler does; all jumps start out short, and the ones that don't reach are widened,
+     * until none of them change. Calls and addresses of the unit itself are resolved in place;
+     * the others become relocations, with functions of other units called through the procedure
+     * linkage table, and their data addressed through the global offset table.
+     */
+    class MachineCodeEncoder
+    {
+    private:
+        ObjectFile &object;
+
+        /**
+         * The section and offset of every symbol the unit defines, including local labels.
+         */
+        std::unordered_map<std::string, std::pair<ESectionKind, uint64_t>> definitions;
+
+        /**
+         * The offset of every block in the code section.
+         */
+        std::unordered_map<const MachineBlock *, uint64_t> blockOffsets;
+
+        /**
+         * The fixups of every section, in which the offsets are relative to the section.
+         */
+        std::vector<Fixup> fixups[SECTION_COUNT];
+
+        uint64_t allocate(ESectionKind section, uint64_t size, uint32_t alignment);
+
+        void addSymbol(const std::string &name, ESectionKind section, uint64_t value, uint64_t size,
+                       bool global, bool function);
+
+        void layoutData(const MachineModule &module);
+
+        void encodeFunction(const MachineFunction &function);
+
+        void encodeInstruction(const MachineInstruction &instruction, EncodedInstruction &encoded);
+
+        void resolveFixups();
+
+    public:
+        explicit MachineCodeEncoder(ObjectFile &object) : object(object)
+        {}
+
+        void encode(const MachineModule &module);
+
+        /**
+         * Returns the offset of an encoded block in the code section.
+         */
+        [[nodiscard]] uint64_t blockOffset(const MachineBlock *block) const
+        { return this->blockOffsets.at(block); }
+    };
+}
+
+#endif //STRIDE_LANGUAGE_MACHINECODEENCODER_H
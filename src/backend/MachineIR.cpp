@@ -0,0 +1,210 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include "MachineIR.h"
+
+using namespace stride::backend;
+
+const char *stride::backend::registerName(ERegister reg, uint8_t size)
+{
+    static const char *names[16][4] = {
+            { "al",   "ax",   "eax",  "rax" },
+            { "cl",   "cx",   "ecx",  "rcx" },
+            { "dl",   "dx",   "edx",  "rdx" },
+            { "bl",   "bx",   "ebx",  "rbx" },
+            { "spl",  "sp",   "esp",  "rsp" },
+            { "bpl",  "bp",   "ebp",  "rbp" },
+            { "sil",  "si",   "esi",  "rsi" },
+            { "dil",  "di",   "edi",  "rdi" },
+            { "r8b",  "r8w",  "r8d",  "r8" },
+            { "r9b",  "r9w",  "r9d",  "r9" },
+            { "r10b", "r10w", "r10d", "r10" },
+            { "r11b", "r11w", "r11d", "r11" },
+            { "r12b", "r12w", "r12d", "r12" },
+            { "r13b", "r13w", "r13d", "r13" },
+            { "r14b", "r14w", "r14d", "r14" },
+            { "r15b", "r15w", "r15d", "r15" }
+    };
+    static const char *vectorNames[16] = {
+            "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7",
+            "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14", "xmm15"
+    };
+    if ( reg >= XMM0 )
+    {
+        return vectorNames[ reg - XMM0 ];
+    }
+    switch ( size )
+    {
+        case 1:
+            return names[ reg ][ 0 ];
+        case 2:
+            return names[ reg ][ 1 ];
+        case 4:
+            return names[ reg ][ 2 ];
+        default:
+            return names[ reg ][ 3 ];
+    }
+}
+
+bool stride::backend::isCalleeSaved(ERegister reg)
+{
+    return reg == RBX || reg == RBP || ( reg >= R12 && reg <= R15 );
+}
+
+ECondition stride::backend::invert(ECondition condition)
+{
+    // The conditions come in pairs that are each other's inverse.
+    switch ( condition )
+    {
+        case COND_L:
+            return COND_GE;
+        case COND_LE:
+            return COND_G;
+        case COND_G:
+            return COND_LE;
+        case COND_GE:
+            return COND_L;
+        case COND_B:
+            return COND_AE;
+        case COND_BE:
+            return COND_A;
+        case COND_A:
+            return COND_BE;
+        case COND_AE:
+            return COND_B;
+        default:
+            return (ECondition) ( condition ^ 1 );
+    }
+}
+
+MachineOperand MachineOperand::use(uint32_t reg, uint8_t size)
+{
+    MachineOperand operand;
+    operand.kind = OPERAND_REGISTER;
+    operand.reg = reg;
+    operand.size = size;
+    operand.isUse = true;
+    return operand;
+}
+
+MachineOperand MachineOperand::def(uint32_t reg, uint8_t size)
+{
+    MachineOperand operand;
+    operand.kind = OPERAND_REGISTER;
+    operand.reg = reg;
+    operand.size = size;
+    operand.isDef = true;
+    return operand;
+}
+
+MachineOperand MachineOperand::useDef(uint32_t reg, uint8_t size)
+{
+    MachineOperand operand = use(reg, size);
+    operand.isDef = true;
+    return operand;
+}
+
+MachineOperand MachineOperand::imm(int64_t value, uint8_t size)
+{
+    MachineOperand operand;
+    operand.kind = OPERAND_IMMEDIATE;
+    operand.immediate = value;
+    operand.size = size;
+    return operand;
+}
+
+MachineOperand MachineOperand::memory(uint32_t base, int64_t displacement, uint8_t size)
+{
+    MachineOperand operand;
+    operand.kind = OPERAND_MEMORY;
+    operand.reg = base;
+    operand.immediate = displacement;
+    operand.size = size;
+    return operand;
+}
+
+MachineOperand MachineOperand::stackSlot(int32_t slot, uint8_t size)
+{
+    MachineOperand operand;
+    operand.kind = OPERAND_MEMORY;
+    operand.slot = slot;
+    operand.size = size;
+    return operand;
+}
+
+MachineOperand MachineOperand::global(const std::string &symbol, uint8_t size)
+{
+    MachineOperand operand;
+    operand.kind = OPERAND_MEMORY;
+    operand.symbol = symbol;
+    operand.size = size;
+    return operand;
+}
+
+MachineOperand MachineOperand::function(const std::string &symbol, bool external)
+{
+    MachineOperand operand;
+    operand.kind = OPERAND_SYMBOL;
+    operand.symbol = symbol;
+    operand.external = external;
+    return operand;
+}
+
+MachineOperand MachineOperand::target(MachineBlock *block)
+{
+    MachineOperand operand;
+    operand.kind = OPERAND_BLOCK;
+    operand.block = block;
+    return operand;
+}
+
+MachineInstruction *MachineBlock::append(EMachineOpcode opcode, std::vector<MachineOperand> operands)
+{
+    this->instructions.push_back(std::make_unique<MachineInstruction>(opcode, std::move(operands)));
+    return this->instructions.back().get();
+}
+
+void MachineBlock::addSuccessor(MachineBlock *successor)
+{
+    if ( std::find(this->successors.begin(), this->successors.end(), successor) == this->successors.end())
+    {
+        this->successors.push_back(successor);
+    }
+}
+
+MachineBlock *MachineFunction::createBlock(const std::string &name)
+{
+    std::string label = ".L" + this->symbol + "." + name + "." + std::to_string(this->blocks.size());
+    this->blocks.push_back(std::make_unique<MachineBlock>(label));
+    return this->blocks.back().get();
+}
+
+uint32_t MachineFunction::createRegister(ERegisterClass registerClass)
+{
+    this->registerClasses.push_back(registerClass);
+    return FIRST_VIRTUAL_REGISTER + (uint32_t) this->registerClasses.size() - 1;
+}
+
+int32_t MachineFunction::createSlot(uint32_t size, uint32_t alignment)
+{
+    this->slots.push_back({ size, alignment });
+    return (int32_t) this->slots.size() - 1;
+}
+
+void MachineFunction::renumber()
+{
+    for ( size_t i = 0; i < this->blocks.size(); i++ )
+    {
+        this->blocks[ i ]->id = (uint32_t) i;
+        this->blocks[ i ]->predecessors.clear();
+    }
+    for ( auto &block: this->blocks )
+    {
+        for ( auto successor: block->successors )
+        {
+            successor->predecessors.push_back(block.get());
+        }
+    }
+}
@@ -0,0 +1,403 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_MACHINEIR_H
+#define STRIDE_LANGUAGE_MACHINEIR_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/** Registers from this number on are virtual; the ones below are x86-64 registers. */
+#define FIRST_VIRTUAL_REGISTER 64
+
+/** The registers an allocator keeps free, to load and store the operands it spilled. */
+#define SCRATCH_GPR_0 stride::backend::R10
+#define SCRATCH_GPR_1 stride::backend::R11
+#define SCRATCH_XMM_0 stride::backend::XMM14
+#define SCRATCH_XMM_1 stride::backend::XMM15
+
+namespace stride::backend
+{
+
+    /**
+     * The x86-64 registers, in the order of their encoding.
+     */
+    enum ERegister : uint32_t
+    {
+        RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI, R8, R9, R10, R11, R12, R13, R14, R15,
+        XMM0, XMM1, XMM2, XMM3, XMM4, XMM5, XMM6, XMM7,
+        XMM8, XMM9, XMM10, XMM11, XMM12, XMM13, XMM14, XMM15,
+        REGISTER_COUNT,
+        NO_REGISTER = UINT32_MAX
+    };
+
+    enum ERegisterClass : uint8_t
+    {
+        CLASS_GPR, // General purpose registers; integers, booleans and references
+        CLASS_XMM  // Vector registers, of which the lowest lane holds a float
+    };
+
+    [[nodiscard]] inline bool isVirtual(uint32_t reg)
+    { return reg != NO_REGISTER && reg >= FIRST_VIRTUAL_REGISTER; }
+
+    [[nodiscard]] inline ERegisterClass classOf(ERegister reg)
+    { return reg >= XMM0 ? CLASS_XMM : CLASS_GPR; }
+
+    /**
+     * Returns the name of a physical register, for an access of a size in bytes, e.g. 'eax'.
+     */
+    const char *registerName(ERegister reg, uint8_t size);
+
+    /**
+     * Whether a register keeps its value across calls, in the System V calling convention.
+     */
+    bool isCalleeSaved(ERegister reg);
+
+    enum ECondition : uint8_t
+    {
+        COND_E, COND_NE,
+        COND_L, COND_LE, COND_G, COND_GE, // Signed
+        COND_B, COND_BE, COND_A, COND_AE, // Unsigned, and floats compared with ucomis
+        COND_P, COND_NP                   // Whether floats were unordered
+    };
+
+    /**
+     * Returns the condition that holds when another one doesn't.
+     */
+    ECondition invert(ECondition condition);
+
+    enum EMachineOpcode : uint8_t
+    {
+        MI_COPY,    // Copies a register to another of the same class; a candidate for coalescing
+        MI_MOV,     // Moves an immediate, register or memory operand; also to memory
+        MI_MOVZX,   // Zero extends the size of the source to the size of the destination
+        MI_MOVSX,   // Sign extends the size of the source to the size of the destination
+        MI_LEA,
+        MI_ADD, MI_SUB, MI_IMUL, MI_AND, MI_OR, MI_XOR, MI_SHL, MI_SHR, MI_SAR,
+        MI_NEG, MI_NOT,
+        MI_CMP, MI_TEST,
+        MI_SETCC,
+        MI_SIGN_EXTEND_ACCUMULATOR, // cltd or cqto; sign extends operand 0, the accumulator, into operand 1
+        MI_IDIV, MI_DIV,            // Divide rdx:rax, leaving the quotient in rax and the remainder in rdx
+        MI_MOVF,                    // Moves a float between registers and memory
+        MI_MOVQ,                    // Moves the bits of a float to or from a general purpose register
+        MI_ADDF, MI_SUBF, MI_MULF, MI_DIVF, MI_XORF,
+        MI_UCOMIF,
+        MI_CVTSI2F, // Converts a signed integer of the size of the source to a float
+        MI_CVTF2SI, // Truncates a float to a signed integer of the size of the destination
+        MI_CVTF2F,  // Converts a float to the size of the destination
+        MI_PUSH, MI_POP,
+        MI_CALL,
+        MI_LEAVE,
+
+        // Terminators
+        MI_JMP,
+        MI_JCC,
+        MI_JMP_TABLE, // Jumps to the address in operand 0; the targets are the successors of the block
+        MI_RET,
+        MI_UD2
+    };
+
+    enum EOperandKind : uint8_t
+    {
+        OPERAND_REGISTER,
+        OPERAND_IMMEDIATE,
+        OPERAND_MEMORY,
+        OPERAND_SYMBOL,   // The target of a call
+        OPERAND_BLOCK     // The target of a jump
+    };
+
+    class MachineBlock;
+
+    /**
+     * An operand of a machine instruction.
+     *
+     * Memory is addressed relative to a base register, a stack slot, or a symbol,
+     * which is addressed relative to the instruction pointer. Stack slots are
+     * given an offset from the frame pointer when the frame is laid out.
+     */
+    struct MachineOperand
+    {
+        EOperandKind kind = OPERAND_IMMEDIATE;
+
+        /**
+         * The size in bytes of the value that's read or written.
+         */
+        uint8_t size = 8;
+
+        /**
+         * Whether the instruction reads and writes register operands.
+         */
+        bool isUse = false;
+        bool isDef = false;
+
+        /**
+         * The register, or the base register of memory operands.
+         */
+        uint32_t reg = NO_REGISTER;
+        uint32_t index = NO_REGISTER;
+        uint8_t scale = 1;
+
+        /**
+         * The immediate, or the displacement of memory operands.
+         */
+        int64_t immediate = 0;
+
+        /**
+         * The stack slot of memory operands, or -1.
+         */
+        int32_t slot = -1;
+
+        /**
+         * The symbol of symbol operands, and of memory relative to the instruction pointer.
+         */
+        std::string symbol;
+        bool external = false;
+
+        MachineBlock *block = nullptr;
+
+        static MachineOperand use(uint32_t reg, uint8_t size);
+
+        static MachineOperand def(uint32_t reg, uint8_t size);
+
+        static MachineOperand useDef(uint32_t reg, uint8_t size);
+
+        static MachineOperand imm(int64_t value, uint8_t size);
+
+        static MachineOperand memory(uint32_t base, int64_t displacement, uint8_t size);
+
+        static MachineOperand stackSlot(int32_t slot, uint8_t size);
+
+        static MachineOperand global(const std::string &symbol, uint8_t size);
+
+        static MachineOperand function(const std::string &symbol, bool external);
+
+        static MachineOperand target(MachineBlock *block);
+
+        [[nodiscard]] bool isRegister() const
+        { return this->kind == OPERAND_REGISTER; }
+
+        [[nodiscard]] bool isMemory() const
+        { return this->kind == OPERAND_MEMORY; }
+    };
+
+    /**
+     * An x86-64 instruction. The operands are in the order of the AT&T syntax; the destination is last.
+     */
+    class MachineInstruction
+    {
+    public:
+        EMachineOpcode opcode;
+        ECondition condition = COND_E;
+        std::vector<MachineOperand> operands;
+
+        /**
+         * Physical registers that are read or written without being an operand,
+         * such as the arguments and the registers a call clobbers.
+         */
+        std::vector<ERegister> implicitUses;
+        std::vector<ERegister> implicitDefs;
+
+        MachineInstruction(EMachineOpcode opcode, std::vector<MachineOperand> operands) :
+                opcode(opcode), operands(std::move(operands))
+        {}
+
+        [[nodiscard]] bool isTerminator() const
+        { return this->opcode >= MI_JMP; }
+
+        /**
+         * Calls the function for every register this instruction reads, including the
+         * registers memory operands are addressed with, and the implicit uses.
+         */
+        template<typename Callback>
+        void forEachUse(Callback callback) const
+        {
+            for ( auto &operand: this->operands )
+            {
+                if ( operand.isRegister() && operand.isUse )
+                {
+                    callback(operand.reg);
+                }
+                if ( operand.isMemory())
+                {
+                    if ( operand.reg != NO_REGISTER )
+                    {
+                        callback(operand.reg);
+                    }
+                    if ( operand.index != NO_REGISTER )
+                    {
+                        callback(operand.index);
+                    }
+                }
+            }
+            for ( auto reg: this->implicitUses )
+            {
+                callback((uint32_t) reg);
+            }
+        }
+
+        /**
+         * Calls the function for every register this instruction writes.
+         */
+        template<typename Callback>
+        void forEachDef(Callback callback) const
+        {
+            for ( auto &operand: this->operands )
+            {
+                if ( operand.isRegister() && operand.isDef )
+                {
+                    callback(operand.reg);
+                }
+            }
+            for ( auto reg: this->implicitDefs )
+            {
+                callback((uint32_t) reg);
+            }
+        }
+    };
+
+    class MachineFunction;
+
+    class MachineBlock
+    {
+    public:
+        std::string label;
+        uint32_t id = 0;
+
+        /**
+         * The amount of loops the block is in.
+         */
+        uint32_t loopDepth = 0;
+        std::vector<std::unique_ptr<MachineInstruction>> instructions;
+        std::vector<MachineBlock *> successors;
+        std::vector<MachineBlock *> predecessors;
+
+        explicit MachineBlock(std::string label) : label(std::move(label))
+        {}
+
+        MachineInstruction *append(EMachineOpcode opcode, std::vector<MachineOperand> operands);
+
+        void addSuccessor(MachineBlock *successor);
+    };
+
+    /**
+     * A slot in the stack frame; a spilled register, or memory a function addresses itself.
+     */
+    struct StackSlot
+    {
+        uint32_t size;
+        uint32_t alignment;
+
+        /**
+         * The offset from the frame pointer, known once the frame is laid out.
+         */
+        int32_t offset = 0;
+    };
+
+    /**
+     * A table of the blocks a switch can jump to, stored as offsets from the table.
+     */
+    struct JumpTable
+    {
+        std::string label;
+        std::vector<MachineBlock *> targets;
+
+        /**
+         * The block that jumps through the table.
+         */
+        MachineBlock *source = nullptr;
+    };
+
+    class MachineFunction
+    {
+    public:
+        std::string symbol;
+        bool exported = true;
+        std::vector<std::unique_ptr<MachineBlock>> blocks;
+
+        /**
+         * The class and size of every virtual register, by its number from FIRST_VIRTUAL_REGISTER.
+         */
+        std::vector<ERegisterClass> registerClasses;
+        std::vector<StackSlot> slots;
+        std::vector<JumpTable> jumpTables;
+
+        /**
+         * The callee saved registers the function writes, which the prologue saves.
+         */
+        std::vector<ERegister> savedRegisters;
+
+        /**
+         * The size of the frame below the frame pointer, once it's laid out.
+         */
+        uint32_t frameSize = 0;
+
+        explicit MachineFunction(std::string symbol) : symbol(std::move(symbol))
+        {}
+
+        MachineBlock *createBlock(const std::string &name);
+
+        uint32_t createRegister(ERegisterClass registerClass);
+
+        [[nodiscard]] ERegisterClass registerClass(uint32_t reg) const
+        {
+            return isVirtual(reg) ? this->registerClasses[ reg - FIRST_VIRTUAL_REGISTER ] : classOf((ERegister) reg);
+        }
+
+        int32_t createSlot(uint32_t size, uint32_t alignment);
+
+        /**
+         * Numbers the blocks in order, and recomputes their predecessors from their successors.
+         */
+        void renumber();
+    };
+
+    /**
+     * Data that's stored in the object file; a global variable, a string or a float constant.
+     */
+    struct DataObject
+    {
+        std::string symbol;
+        uint32_t alignment;
+        uint32_t size;
+
+        /**
+         * The contents, or no bytes if the object is zero. Objects that aren't
+         * read-only and are zero are placed in the zero initialized section.
+         */
+        std::vector<uint8_t> bytes;
+
+        /**
+         * If set, the object is the address of this symbol.
+         */
+        std::string reference;
+        bool readOnly = false;
+        bool exported = false;
+    };
+
+    /**
+     * The machine code and data of a compilation unit.
+     */
+    class MachineModule
+    {
+    public:
+        std::string sourceName;
+        std::vector<std::unique_ptr<MachineFunction>> functions;
+        std::vector<DataObject> data;
+
+        /**
+         * Symbols that are defined by every unit that uses them, and merged when linked.
+         */
+        std::vector<std::pair<std::string, uint32_t>> commonSymbols;
+
+        /**
+         * Functions that run before the entry point, such as the module initializer.
+         */
+        std::vector<std::string> constructors;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_MACHINEIR_H
@@ -0,0 +1,95 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_OBJECTFILE_H
+#define STRIDE_LANGUAGE_OBJECTFILE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace stride::backend
+{
+
+    enum ESectionKind : int8_t
+    {
+        SECTION_UNDEFINED = -1, // Symbols of other units
+        SECTION_TEXT,
+        SECTION_DATA,
+        SECTION_BSS,
+        SECTION_RODATA,
+        SECTION_INIT_ARRAY,
+        SECTION_COUNT
+    };
+
+    /**
+     * The kinds of relocation; their values are the ones of the x86-64 System V ABI.
+     */
+    enum ERelocationType : uint32_t
+    {
+        RELOCATION_ABSOLUTE_64 = 1, // The address of the symbol
+        RELOCATION_PC32 = 2,        // The address of the symbol, relative to the relocated place
+        RELOCATION_PLT32 = 4,       // The procedure linkage table entry of a function, relative to the place
+        RELOCATION_GOTPCREL = 9     // The global offset table entry of a symbol, relative to the place
+    };
+
+    /**
+     * A place in a section that's filled in by the linker, with the address of a symbol plus
+     * the addend. Relocations against a symbol of the unit itself refer to the section it's
+     * in instead, so local symbols needn't be in the symbol table.
+     */
+    struct Relocation
+    {
+        uint64_t offset;
+        ERelocationType type;
+
+        /**
+         * The symbol, if it's defined by another unit, otherwise empty.
+         */
+        std::string symbol;
+        ESectionKind section = SECTION_UNDEFINED;
+        int64_t addend = 0;
+    };
+
+    struct ObjectSection
+    {
+        std::vector<uint8_t> bytes;
+
+        /**
+         * The size of the zero initialized section, which has no bytes in the file.
+         */
+        uint64_t size = 0;
+        uint32_t alignment = 1;
+        std::vector<Relocation> relocations;
+    };
+
+    struct ObjectSymbol
+    {
+        std::string name;
+        ESectionKind section = SECTION_UNDEFINED;
+        uint64_t value = 0;
+        uint64_t size = 0;
+        bool global = false;
+        bool function = false;
+
+        /**
+         * Common symbols are merged by the linker; their value is their alignment.
+         */
+        bool common = false;
+    };
+
+    /**
+     * The machine code and data of a compilation unit, as sections with their
+     * symbols and relocations, independent of the format of object files.
+     */
+    class ObjectFile
+    {
+    public:
+        std::string sourceName;
+        ObjectSection sections[SECTION_COUNT];
+        std::vector<ObjectSymbol> symbols;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_OBJECTFILE_H
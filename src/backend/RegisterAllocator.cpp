@@ -0,0 +1,111 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include "RegisterAllocator.h"
+
+using namespace stride::backend;
+
+void stride::backend::rewriteSpilled(MachineFunction &function, MachineBlock &block, const std::vector<int32_t> &slots)
+{
+    auto isSpilled = [ & ](uint32_t reg)
+    {
+        return isVirtual(reg) && slots[ reg - FIRST_VIRTUAL_REGISTER ] >= 0;
+    };
+    auto slotOf = [ & ](uint32_t reg)
+    {
+        return slots[ reg - FIRST_VIRTUAL_REGISTER ];
+    };
+
+    std::vector<std::unique_ptr<MachineInstruction>> rewritten;
+    for ( auto &instruction: block.instructions )
+    {
+        // Registers that are read get a scratch register first; the instruction reads them before it writes,
+        // so a register that's only written can share the scratch register of one that's read.
+        std::vector<std::pair<uint32_t, ERegister>> assigned;
+        ERegister scratch[2][2] = {{ SCRATCH_GPR_0, SCRATCH_GPR_1 },
+                                   { SCRATCH_XMM_0, SCRATCH_XMM_1 }};
+        size_t used[2] = { 0, 0 };
+        auto assign = [ & ](uint32_t reg)
+        {
+            for ( auto &[ spilled, physical ]: assigned )
+            {
+                if ( spilled == reg )
+                {
+                    return physical;
+                }
+            }
+            ERegisterClass registerClass = function.registerClass(reg);
+            ERegister physical = scratch[ registerClass ][ std::min<size_t>(used[ registerClass ]++, 1) ];
+            assigned.emplace_back(reg, physical);
+            return physical;
+        };
+
+        std::vector<uint32_t> reads;
+        instruction->forEachUse([ & ](uint32_t reg)
+                                {
+                                    if ( isSpilled(reg) && std::find(reads.begin(), reads.end(), reg) == reads.end())
+                                    {
+                                        reads.push_back(reg);
+                                    }
+                                });
+        for ( auto reg: reads )
+        {
+            ERegister physical = assign(reg);
+            EMachineOpcode load = classOf(physical) == CLASS_XMM ? MI_MOVF : MI_MOV;
+            rewritten.push_back(std::make_unique<MachineInstruction>(
+                    load, std::vector<MachineOperand> { MachineOperand::stackSlot(slotOf(reg), 8),
+                                                        MachineOperand::def(physical, 8) }));
+        }
+
+        std::vector<uint32_t> writes;
+        instruction->forEachDef([ & ](uint32_t reg)
+                                {
+                                    if ( isSpilled(reg) && std::find(writes.begin(), writes.end(), reg) == writes.end())
+                                    {
+                                        writes.push_back(reg);
+                                    }
+                                });
+        std::vector<std::pair<uint32_t, ERegister>> stores;
+        for ( auto reg: writes )
+        {
+            stores.emplace_back(reg, assign(reg));
+        }
+
+        for ( auto &operand: instruction->operands )
+        {
+            if (( operand.isRegister() || operand.isMemory()) && isSpilled(operand.reg))
+            {
+                operand.reg = assign(operand.reg);
+            }
+            if ( operand.isMemory() && isSpilled(operand.index))
+            {
+                operand.index = assign(operand.index);
+            }
+        }
+        rewritten.push_back(std::move(instruction));
+
+        for ( auto &[ reg, physical ]: stores )
+        {
+            EMachineOpcode store = classOf(physical) == CLASS_XMM ? MI_MOVF : MI_MOV;
+            rewritten.push_back(std::make_unique<MachineInstruction>(
+                    store, std::vector<MachineOperand> { MachineOperand::use(physical, 8),
+                                                         MachineOperand::stackSlot(slotOf(reg), 8) }));
+        }
+    }
+    block.instructions = std::move(rewritten);
+}
+
+void StackSlotAllocator::allocate(MachineFunction &function)
+{
+    std::vector<int32_t> slots;
+    for ( size_t i = 0; i < function.registerClasses.size(); i++ )
+    {
+        slots.push_back(function.createSlot(8, 8));
+    }
+    for ( auto &block: function.blocks )
+    {
+        rewriteSpilled(function, *block, slots);
+    }
+}
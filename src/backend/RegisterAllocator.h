@@ -0,0 +1,45 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_REGISTERALLOCATOR_H
+#define STRIDE_LANGUAGE_REGISTERALLOCATOR_H
+
+#include "MachineIR.h"
+
+namespace stride::backend
+{
+
+    /**
+     * Replaces the virtual registers of a function by physical registers and stack slots.
+     * Physical registers the instruction selector placed are kept. The scratch registers
+     * are reserved for the allocator, to load and store the registers it spilled.
+     */
+    class RegisterAllocator
+    {
+    public:
+        virtual ~RegisterAllocator() = default;
+
+        virtual void allocate(MachineFunction &function) = 0;
+    };
+
+    /**
+     * Keeps every virtual register in a stack slot of its own. Every instruction
+     * loads the registers it reads into scratch registers, and stores the ones
+     * it writes back to their slot. This is slow, but trivially correct.
+     */
+    class StackSlotAllocator : public RegisterAllocator
+    {
+    public:
+        void allocate(MachineFunction &function) override;
+    };
+
+    /**
+     * Rewrites the virtual registers of an instruction that are kept in stack slots,
+     * loading and storing them through the scratch registers of their class.
+     * @param slots The stack slot of every virtual register, or -1 if it's not spilled.
+     */
+    void rewriteSpilled(MachineFunction &function, MachineBlock &block, const std::vector<int32_t> &slots);
+}
+
+#endif //STRIDE_LANGUAGE_REGISTERALLOCATOR_H
@@ -0,0 +1,410 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+#include "CompilationCache.h"
+#include "Hash.h"
+#include "../StrideFile.h"
+#include "../syntax_tree/ASTSerializer.h"
+
+#define TOKEN_CACHE_MAGIC "STOK"
+#define TOKEN_CACHE_VERSION 1
+
+using namespace stride::cache;
+
+/**
+ * Compiler flags that don't influence the compilation output,
+ * and are therefore excluded from the cache key.
+ */
+static const char *nonSemanticFlags[] = {
+        "cache-dir",
+        "cache-stats",
+        "emit-ast",
+        "emit-bytecode",
+        "import-path",
+        "jobs",
+        "no-bytecode-cache",
+        "no-jit"
+};
+
+static const char *artifactNames[] = {
+        "tokens",
+        "sast",
+        "o",
+        "srb"
+};
+
+typedef struct
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t count;
+    uint32_t stringDataSize;
+} token_cache_header_t;
+
+typedef struct
+{
+    uint32_t type;
+    uint32_t index;
+    uint32_t offset;
+    uint32_t length;
+} token_cache_record_t;
+
+CacheStatistics::CacheStatistics()
+{
+    for ( int i = 0; i < ARTIFACT_COUNT; i++ )
+    {
+        hits[ i ] = 0;
+        misses[ i ] = 0;
+        stores[ i ] = 0;
+    }
+}
+
+void CacheStatistics::print(std::ostream &out) const
+{
+    out << "Compilation cache statistics:" << std::endl;
+    for ( int i = 0; i < ARTIFACT_COUNT; i++ )
+    {
+        unsigned int hitCount = hits[ i ], missCount = misses[ i ];
+        if ( hitCount + missCount + stores[ i ] == 0 )
+        {
+            continue;
+        }
+        out << "  " << artifactNames[ i ] << ": " << hitCount << " hits, " << missCount << " misses, "
+            << stores[ i ] << " stored" << std::endl;
+    }
+}
+
+CompilationCache::CompilationCache(std::string directory) :
+        directory(std::move(directory)),
+        memoryCapacity(0),
+        memoryUsage(0)
+{
+    if ( !this->directory.empty())
+    {
+        std::error_code error;
+        std::filesystem::create_directories(this->directory, error);
+    }
+}
+
+void CompilationCache::setMemoryCapacity(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(this->memoryMutex);
+    this->memoryCapacity = bytes;
+
+    while ( this->memoryUsage > this->memoryCapacity )
+    {
+        auto entry = this->memoryEntries.find(this->memoryRecency.back());
+        this->memoryUsage -= entry->second.data->size();
+        this->memoryEntries.erase(entry);
+        this->memoryRecency.pop_back();
+    }
+}
+
+std::shared_ptr<const std::vector<uint8_t>> CompilationCache::loadFromMemory(uint64_t key, EArtifact artifact)
+{
+    std::lock_guard<std::mutex> lock(this->memoryMutex);
+    auto entry = this->memoryEntries.find({ key, artifact });
+    if ( entry == this->memoryEntries.end())
+    {
+        return nullptr;
+    }
+
+    // Move the entry to the front, marking it as most recently used.
+    this->memoryRecency.splice(this->memoryRecency.begin(), this->memoryRecency, entry->second.recency);
+    return entry->second.data;
+}
+
+void CompilationCache::storeInMemory(uint64_t key, EArtifact artifact,
+                                     std::shared_ptr<const std::vector<uint8_t>> data)
+{
+    std::lock_guard<std::mutex> lock(this->memoryMutex);
+    if ( data->size() > this->memoryCapacity || this->memoryEntries.count({ key, artifact }))
+    {
+        return;
+    }
+
+    // Entries are shared, so evicting an entry that's still being read is safe.
+    while ( this->memoryUsage + data->size() > this->memoryCapacity )
+    {
+        auto entry = this->memoryEntries.find(this->memoryRecency.back());
+        this->memoryUsage -= entry->second.data->size();
+        this->memoryEntries.erase(entry);
+        this->memoryRecency.pop_back();
+    }
+
+    this->memoryRecency.push_front({ key, artifact });
+    this->memoryUsage += data->size();
+    this->memoryEntries[ { key, artifact } ] = { std::move(data), this->memoryRecency.begin() };
+}
+
+uint64_t CompilationCache::computeKey(stride::StrideFile &file, const std::vector<uint64_t> &dependencies)
+{
+    Hasher hasher;
+    hasher.update(std::string_view(file.getContent()));
+    hasher.update(std::string_view(STRIDE_COMPILER_VERSION));
+    for ( auto dependency: dependencies )
+    {
+        hasher.update(dependency);
+    }
+
+    // Flags are stored in an ordered map, so the key doesn't depend on the order
+    // in which they were provided.
+    for ( auto &[ flag, value ]: file.getCompilerFlags())
+    {
+        bool semantic = true;
+        for ( auto excluded: nonSemanticFlags )
+        {
+            semantic &= flag != excluded;
+        }
+        if ( !semantic )
+        {
+            continue;
+        }
+
+        hasher.update(std::string_view(flag));
+        if ( std::holds_alternative<std::string>(value))
+        {
+            hasher.update(std::string_view(std::get<std::string>(value)));
+        }
+        else
+        {
+            hasher.update((uint64_t) std::get<long int>(value));
+        }
+    }
+    return hasher.digest();
+}
+
+std::string CompilationCache::artifactPath(uint64_t key, EArtifact artifact) const
+{
+    char name[ 32 ];
+    snprintf(name, sizeof(name), "%016llx", (unsigned long long) key);
+
+    // Spread the entries over subdirectories, so no single directory grows too large.
+    return this->directory + "/" + std::string(name, 2) + "/" + name + "." + artifactNames[ artifact ];
+}
+
+std::shared_ptr<const std::vector<uint8_t>> CompilationCache::readArtifact(uint64_t key, EArtifact artifact)
+{
+    if ( auto data = this->loadFromMemory(key, artifact))
+    {
+        return data;
+    }
+    if ( this->directory.empty())
+    {
+        return nullptr;
+    }
+
+    std::ifstream file_in(this->artifactPath(key, artifact), std::ios::binary | std::ios::ate);
+    if ( !file_in )
+    {
+        return nullptr;
+    }
+
+    auto size = (size_t) file_in.tellg();
+    auto data = std::make_shared<std::vector<uint8_t>>(size);
+    file_in.seekg(0);
+    if ( !file_in.read(reinterpret_cast<char *>(data->data()), (std::streamsize) size))
+    {
+        return nullptr;
+    }
+
+    if ( this->memoryCapacity > 0 )
+    {
+        this->storeInMemory(key, artifact, data);
+    }
+    return data;
+}
+
+bool CompilationCache::writeArtifact(uint64_t key, EArtifact artifact, const std::vector<uint8_t> &data)
+{
+    if ( this->memoryCapacity > 0 )
+    {
+        this->storeInMemory(key, artifact, std::make_shared<const std::vector<uint8_t>>(data));
+    }
+    if ( this->directory.empty())
+    {
+        this->statistics.stores[ artifact ]++;
+        return true;
+    }
+
+    std::string path = this->artifactPath(key, artifact);
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+    // Write to a temporary file first, so concurrent compilations never
+    // observe a partially written entry. The name is unique per thread, as
+    // modules with identical content share a key.
+    std::string temporaryPath = path + "." + std::to_string(getpid()) + "-" +
+                                std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    std::ofstream file_out(temporaryPath, std::ios::binary | std::ios::trunc);
+    if ( !file_out )
+    {
+        return false;
+    }
+    file_out.write(reinterpret_cast<const char *>(data.data()), (std::streamsize) data.size());
+    file_out.close();
+
+    if ( !file_out || rename(temporaryPath.c_str(), path.c_str()) != 0 )
+    {
+        unlink(temporaryPath.c_str());
+        return false;
+    }
+    this->statistics.stores[ artifact ]++;
+    return true;
+}
+
+bool CompilationCache::load(uint64_t key, EArtifact artifact, std::vector<uint8_t> &dst)
+{
+    auto data = this->readArtifact(key, artifact);
+    ( data ? this->statistics.hits : this->statistics.misses )[ artifact ]++;
+    if ( data )
+    {
+        dst = *data;
+    }
+    return data != nullptr;
+}
+
+void CompilationCache::store(uint64_t key, EArtifact artifact, const std::vector<uint8_t> &data)
+{
+    this->writeArtifact(key, artifact, data);
+}
+
+std::vector<token_t> *CompilationCache::loadTokens(uint64_t key)
+{
+    auto buffer = this->readArtifact(key, ARTIFACT_TOKENS);
+    if ( buffer == nullptr || buffer->size() < sizeof(token_cache_header_t))
+    {
+        this->statistics.misses[ ARTIFACT_TOKENS ]++;
+        return nullptr;
+    }
+
+    const std::vector<uint8_t> &data = *buffer;
+    token_cache_header_t header;
+    memcpy(&header, data.data(), sizeof(header));
+
+    size_t recordsSize = (size_t) header.count * sizeof(token_cache_record_t);
+    if ( memcmp(header.magic, TOKEN_CACHE_MAGIC, 4) != 0 ||
+         header.version != TOKEN_CACHE_VERSION ||
+         sizeof(header) + recordsSize + header.stringDataSize > data.size())
+    {
+        this->statistics.misses[ ARTIFACT_TOKENS ]++;
+        return nullptr;
+    }
+
+    auto records = reinterpret_cast<const token_cache_record_t *>(data.data() + sizeof(header));
+    auto stringData = reinterpret_cast<const char *>(data.data() + sizeof(header) + recordsSize);
+
+    auto tokens = new std::vector<token_t>();
+    tokens->reserve(header.count);
+    for ( uint32_t i = 0; i < header.count; i++ )
+    {
+        auto &record = records[ i ];
+        if ((uint64_t) record.offset + record.length > header.stringDataSize || record.type >= TOKEN_COUNT )
+        {
+            for ( auto &token: *tokens )
+            {
+                free(token.value);
+            }
+            delete tokens;
+            this->statistics.misses[ ARTIFACT_TOKENS ]++;
+            return nullptr;
+        }
+
+        token_t token;
+        token.type = (token_type_t) record.type;
+        token.index = (int) record.index;
+        token.value = (char *) malloc(record.length + 1);
+        memcpy(token.value, stringData + record.offset, record.length);
+        token.value[ record.length ] = '\0';
+        tokens->push_back(token);
+    }
+
+    this->statistics.hits[ ARTIFACT_TOKENS ]++;
+    return tokens;
+}
+
+void CompilationCache::storeTokens(uint64_t key, const std::vector<token_t> &tokens)
+{
+    std::vector<token_cache_record_t> records;
+    std::string stringData;
+    records.reserve(tokens.size());
+
+    for ( auto &token: tokens )
+    {
+        uint32_t length = (uint32_t) strlen(token.value);
+        records.push_back({ (uint32_t) token.type, (uint32_t) token.index, (uint32_t) stringData.size(), length });
+        stringData.append(token.value, length);
+    }
+
+    token_cache_header_t header {};
+    memcpy(header.magic, TOKEN_CACHE_MAGIC, 4);
+    header.version = TOKEN_CACHE_VERSION;
+    header.count = (uint32_t) records.size();
+    header.stringDataSize = (uint32_t) stringData.size();
+
+    std::vector<uint8_t> data(sizeof(header) + records.size() * sizeof(token_cache_record_t) + stringData.size());
+    memcpy(data.data(), &header, sizeof(header));
+    memcpy(data.data() + sizeof(header), records.data(), records.size() * sizeof(token_cache_record_t));
+    memcpy(data.data() + sizeof(header) + records.size() * sizeof(token_cache_record_t),
+           stringData.data(), stringData.size());
+
+    this->writeArtifact(key, ARTIFACT_TOKENS, data);
+}
+
+stride::ast::Node *CompilationCache::loadAST(uint64_t key)
+{
+    // Files are mapped directly, unless the tree is kept in memory.
+    std::shared_ptr<const std::vector<uint8_t>> buffer;
+    ast::serialization::ASTView *view;
+    if ( this->memoryCapacity > 0 || this->directory.empty())
+    {
+        buffer = this->readArtifact(key, ARTIFACT_AST);
+        view = buffer ? ast::serialization::ASTView::fromBuffer(buffer->data(), buffer->size()) : nullptr;
+    }
+    else
+    {
+        view = ast::serialization::ASTView::open(this->artifactPath(key, ARTIFACT_AST));
+    }
+
+    if ( view == nullptr || view->header().sourceHash != key )
+    {
+        delete view;
+        this->statistics.misses[ ARTIFACT_AST ]++;
+        return nullptr;
+    }
+
+    ast::Node *root;
+    try
+    {
+        root = ast::serialization::materialize(*view);
+    }
+    catch ( const std::exception & )
+    {
+        root = nullptr;
+    }
+    delete view;
+
+    ( root ? this->statistics.hits : this->statistics.misses )[ ARTIFACT_AST ]++;
+    return root;
+}
+
+void CompilationCache::storeAST(uint64_t key, stride::ast::Node &root)
+{
+    this->writeArtifact(key, ARTIFACT_AST, ast::serialization::serialize(root, key));
+}
+
+const CacheStatistics &CompilationCache::getStatistics() const
+{
+    return this->statistics;
+}
+
+const std::string &CompilationCache::getDirectory() const
+{
+    return this->directory;
+}
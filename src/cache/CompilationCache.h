@@ -0,0 +1,154 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_COMPILATIONCACHE_H
+#define STRIDE_LANGUAGE_COMPILATIONCACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "../tokens/token.h"
+#include "../syntax_tree/ASTNodes.h"
+
+namespace stride
+{
+    class StrideFile;
+}
+
+namespace stride::cache
+{
+
+    /**
+     * Artifacts that can be stored per source file.
+     * Every artifact is stored in its own file in the cache directory.
+     */
+    enum EArtifact
+    {
+        ARTIFACT_TOKENS,
+        ARTIFACT_AST,
+        ARTIFACT_OBJECT,
+        ARTIFACT_BYTECODE,
+        ARTIFACT_COUNT
+    };
+
+    /**
+     * Hit and miss counters per artifact.
+     */
+    struct CacheStatistics
+    {
+        std::atomic<unsigned int> hits[ARTIFACT_COUNT];
+        std::atomic<unsigned int> misses[ARTIFACT_COUNT];
+        std::atomic<unsigned int> stores[ARTIFACT_COUNT];
+
+        CacheStatistics();
+
+        /**
+         * Prints the statistics in a human readable form.
+         */
+        void print(std::ostream &out) const;
+    };
+
+    /**
+     * Persistent cache of compilation artifacts.
+     * Entries are keyed by a hash of the source content, the compiler version
+     * and the compiler flags that influence the output, so stale entries are
+     * never returned; they simply stop being looked up.
+     *
+     * Optionally, recently used entries are also kept in memory, which is used
+     * by long running processes such as the compile server.
+     */
+    class CompilationCache
+    {
+    private:
+        typedef std::pair<uint64_t, EArtifact> memory_key_t;
+
+        struct MemoryEntry
+        {
+            std::shared_ptr<const std::vector<uint8_t>> data;
+            std::list<memory_key_t>::iterator recency;
+        };
+
+        std::string directory;
+        CacheStatistics statistics;
+
+        /**
+         * In-memory entries, with the least recently used key at the back of the list.
+         */
+        std::mutex memoryMutex;
+        std::map<memory_key_t, MemoryEntry> memoryEntries;
+        std::list<memory_key_t> memoryRecency;
+        size_t memoryCapacity;
+        size_t memoryUsage;
+
+        [[nodiscard]] std::string artifactPath(uint64_t key, EArtifact artifact) const;
+
+        std::shared_ptr<const std::vector<uint8_t>> readArtifact(uint64_t key, EArtifact artifact);
+
+        bool writeArtifact(uint64_t key, EArtifact artifact, const std::vector<uint8_t> &data);
+
+        std::shared_ptr<const std::vector<uint8_t>> loadFromMemory(uint64_t key, EArtifact artifact);
+
+        void storeInMemory(uint64_t key, EArtifact artifact, std::shared_ptr<const std::vector<uint8_t>> data);
+
+    public:
+
+        /**
+         * Creates a cache that stores its entries in the provided directory.
+         * The directory is created if it doesn't exist yet.
+         * If the directory is empty, entries are only kept in memory.
+         */
+        explicit CompilationCache(std::string directory);
+
+        /**
+         * Sets the maximum amount of bytes of entries kept in memory.
+         * The least recently used entries are evicted first.
+         * A capacity of 0, the default, disables the in-memory cache.
+         */
+        void setMemoryCapacity(size_t bytes);
+
+        /**
+         * Computes the cache key of a source file.
+         * Flags that don't influence the compilation output, such as the
+         * cache flags themselves, are excluded from the key.
+         * @param dependencies The keys of the files the output depends on, e.g. those it imports.
+         */
+        static uint64_t computeKey(StrideFile &file, const std::vector<uint64_t> &dependencies = {});
+
+        /**
+         * Looks up the token stream of a file.
+         * @return The tokens, or nullptr on a miss.
+         */
+        std::vector<token_t> *loadTokens(uint64_t key);
+
+        void storeTokens(uint64_t key, const std::vector<token_t> &tokens);
+
+        /**
+         * Looks up the syntax tree of a file.
+         * @return The root of the tree, or nullptr on a miss.
+         */
+        ast::Node *loadAST(uint64_t key);
+
+        void storeAST(uint64_t key, ast::Node &root);
+
+        /**
+         * Looks up a raw artifact, e.g. intermediate representation or output.
+         * @return Whether the artifact was found.
+         */
+        bool load(uint64_t key, EArtifact artifact, std::vector<uint8_t> &dst);
+
+        void store(uint64_t key, EArtifact artifact, const std::vector<uint8_t> &data);
+
+        [[nodiscard]] const CacheStatistics &getStatistics() const;
+
+        [[nodiscard]] const std::string &getDirectory() const;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_COMPILATIONCACHE_H
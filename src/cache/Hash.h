@@ -0,0 +1,99 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_HASH_H
+#define STRIDE_LANGUAGE_HASH_H
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace stride::cache
+{
+
+    /**
+     * Incremental 64-bit hash function.
+     * Input is consumed in blocks of 8 bytes, each of which is mixed into the
+     * state with a multiply-xorshift round. This is not a cryptographic hash;
+     * it's used to key caches on source content.
+     */
+    class Hasher
+    {
+    private:
+        static constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+        static constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+
+        uint64_t state;
+        uint64_t length;
+
+        static uint64_t mix(uint64_t value)
+        {
+            value ^= value >> 33;
+            value *= PRIME_2;
+            value ^= value >> 29;
+            value *= PRIME_1;
+            value ^= value >> 32;
+            return value;
+        }
+
+    public:
+
+        explicit Hasher(uint64_t seed = 0) : state(seed ^ PRIME_1), length(0)
+        {}
+
+        Hasher &update(const void *data, size_t size)
+        {
+            auto bytes = static_cast<const uint8_t *>(data);
+            length += size;
+
+            for ( ; size >= 8; bytes += 8, size -= 8 )
+            {
+                uint64_t block;
+                memcpy(&block, bytes, 8);
+                state = mix(state ^ ( block * PRIME_1 )) * PRIME_2;
+            }
+
+            if ( size > 0 )
+            {
+                uint64_t block = 0;
+                memcpy(&block, bytes, size);
+                state = mix(state ^ ( block * PRIME_2 ) ^ size) * PRIME_1;
+            }
+            return *this;
+        }
+
+        Hasher &update(std::string_view value)
+        {
+            // Include the length, so consecutive strings can't collide by shifting characters.
+            uint64_t size = value.size();
+            update(&size, sizeof(size));
+            return update(value.data(), value.size());
+        }
+
+        Hasher &update(uint64_t value)
+        {
+            return update(&value, sizeof(value));
+        }
+
+        [[nodiscard]] uint64_t digest() const
+        {
+            return mix(state ^ length);
+        }
+    };
+
+    /**
+     * Hashes a single buffer.
+     */
+    inline uint64_t hash(const void *data, size_t size, uint64_t seed = 0)
+    {
+        return Hasher(seed).update(data, size).digest();
+    }
+
+    inline uint64_t hash(std::string_view value, uint64_t seed = 0)
+    {
+        return Hasher(seed).update(value.data(), value.size()).digest();
+    }
+}
+
+#endif //STRIDE_LANGUAGE_HASH_H
@@ -0,0 +1,75 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "CompileClient.h"
+#include "Protocol.h"
+
+std::optional<int> stride::daemon::forwardToServer(const std::string &socketPath,
+                                                   const std::vector<std::string> &arguments,
+                                                   std::ostream &out, std::ostream &err)
+{
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    if ( socketPath.size() >= sizeof(address.sun_path))
+    {
+        return std::nullopt;
+    }
+    memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    int connection = socket(AF_UNIX, SOCK_STREAM, 0);
+    if ( connection < 0 )
+    {
+        return std::nullopt;
+    }
+    if ( connect(connection, (sockaddr *) &address, sizeof(address)) != 0 )
+    {
+        close(connection);
+        return std::nullopt;
+    }
+
+    std::error_code error;
+    std::string workingDirectory = std::filesystem::current_path(error).string();
+
+    daemon_request_header_t request {};
+    memcpy(request.magic, DAEMON_REQUEST_MAGIC, 4);
+    request.version = DAEMON_PROTOCOL_VERSION;
+    request.argumentCount = (uint32_t) arguments.size() + 1;
+    request.environmentCount = (uint32_t) forwardedEnvironment().size();
+
+    bool sent = writeAll(connection, &request, sizeof(request)) && writeString(connection, workingDirectory);
+    for ( size_t i = 0; sent && i < arguments.size(); i++ )
+    {
+        sent = writeString(connection, arguments[ i ]);
+    }
+    for ( size_t i = 0; sent && i < forwardedEnvironment().size(); i++ )
+    {
+        const char *value = getenv(forwardedEnvironment()[ i ].c_str());
+        sent = writeString(connection, forwardedEnvironment()[ i ]) && writeString(connection, value ? value : "");
+    }
+
+    daemon_response_header_t response;
+    std::string standardOutput, standardError;
+    bool received = sent &&
+                    readAll(connection, &response, sizeof(response)) &&
+                    memcmp(response.magic, DAEMON_RESPONSE_MAGIC, 4) == 0 &&
+                    response.version == DAEMON_PROTOCOL_VERSION &&
+                    readString(connection, standardOutput) &&
+                    readString(connection, standardError);
+    close(connection);
+
+    if ( !received )
+    {
+        return std::nullopt;
+    }
+
+    out << standardOutput << std::flush;
+    err << standardError << std::flush;
+    return response.exitCode;
+}
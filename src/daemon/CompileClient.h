@@ -0,0 +1,30 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_COMPILECLIENT_H
+#define STRIDE_LANGUAGE_COMPILECLIENT_H
+
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace stride::daemon
+{
+
+    /**
+     * Forwards command line arguments to a compile server.
+     * The working directory of the calling process is sent along, so relative
+     * paths are resolved the same way as when compiling locally.
+     * @param socketPath The socket the server listens on.
+     * @param arguments The command line arguments, without the program name.
+     * @param out The stream to write the standard output of the compilation to.
+     * @param err The stream to write the standard error of the compilation to.
+     * @return The exit code of the compilation, or nothing if no server could be reached.
+     */
+    std::optional<int> forwardToServer(const std::string &socketPath, const std::vector<std::string> &arguments,
+                                       std::ostream &out, std::ostream &err);
+}
+
+#endif //STRIDE_LANGUAGE_COMPILECLIENT_H
@@ -0,0 +1,330 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <csignal>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "CompileServer.h"
+#include "Protocol.h"
+#include "../CompilerOptions.h"
+#include "../modules/ModuleScheduler.h"
+
+#define ACCEPT_POLL_INTERVAL_MS 200
+
+using namespace stride::daemon;
+
+/**
+ * Flags with a path as value. Relative paths are resolved against
+ * the working directory of the client, not that of the server.
+ */
+static const char *pathFlags[] = {
+        "cache-dir",
+        "emit-asm",
+        "emit-ast",
+        "emit-c",
+        "import-path"
+};
+
+/**
+ * Fills in the address of a Unix domain socket.
+ * @return Whether the path fits in the address.
+ */
+static bool socketAddress(const std::string &path, sockaddr_un &address)
+{
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if ( path.size() >= sizeof(address.sun_path))
+    {
+        return false;
+    }
+    memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+/**
+ * Resolves every path in a ':' separated list against the provided directory.
+ */
+static std::string resolvePaths(const std::string &paths, const std::filesystem::path &directory)
+{
+    std::string resolved;
+    size_t start = 0;
+    while ( start <= paths.size())
+    {
+        size_t end = paths.find(':', start);
+        if ( end == std::string::npos )
+        {
+            end = paths.size();
+        }
+        if ( end > start )
+        {
+            std::filesystem::path path(paths.substr(start, end - start));
+            if ( !resolved.empty())
+            {
+                resolved.push_back(':');
+            }
+            resolved.append(( path.is_relative() ? directory / path : path ).string());
+        }
+        start = end + 1;
+    }
+    return resolved;
+}
+
+CompileServer::CompileServer(std::string socketPath, unsigned int workerCount, size_t memoryCapacity) :
+        socketPath(std::move(socketPath)),
+        listenDescriptor(-1),
+        running(false),
+        workers(workerCount),
+        memoryCapacity(memoryCapacity)
+{}
+
+CompileServer::~CompileServer()
+{
+    this->stop();
+    this->workers.wait();
+
+    if ( this->listenDescriptor >= 0 )
+    {
+        close(this->listenDescriptor);
+        unlink(this->socketPath.c_str());
+    }
+}
+
+bool CompileServer::start(std::ostream &err)
+{
+    sockaddr_un address {};
+    if ( !socketAddress(this->socketPath, address))
+    {
+        err << "Socket path is too long: " << this->socketPath << std::endl;
+        return false;
+    }
+
+    // Refuse to take over the socket of a server that is still running.
+    int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+    if ( probe >= 0 && connect(probe, (sockaddr *) &address, sizeof(address)) == 0 )
+    {
+        close(probe);
+        err << "A compile server is already listening on " << this->socketPath << std::endl;
+        return false;
+    }
+    if ( probe >= 0 )
+    {
+        close(probe);
+    }
+    unlink(this->socketPath.c_str());
+
+    // Requests can point the compiler at arbitrary files, so only the owner may connect. The socket
+    // is created with these permissions, as other users could connect between binding and a chmod.
+    this->listenDescriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+    mode_t previousMask = umask(S_IRWXG | S_IRWXO);
+    bool bound = this->listenDescriptor >= 0 &&
+                 bind(this->listenDescriptor, (sockaddr *) &address, sizeof(address)) == 0;
+    umask(previousMask);
+    if ( !bound || listen(this->listenDescriptor, SOMAXCONN) != 0 )
+    {
+        err << "Failed to listen on " << this->socketPath << ": " << strerror(errno) << std::endl;
+        if ( this->listenDescriptor >= 0 )
+        {
+            close(this->listenDescriptor);
+            this->listenDescriptor = -1;
+        }
+        return false;
+    }
+
+    // A client that disconnects early must not terminate the server.
+    signal(SIGPIPE, SIG_IGN);
+
+    this->running = true;
+    return true;
+}
+
+void CompileServer::serve()
+{
+    while ( this->running )
+    {
+        // Poll with a timeout, so a stop request is noticed without a new connection.
+        pollfd descriptor { this->listenDescriptor, POLLIN, 0 };
+        if ( poll(&descriptor, 1, ACCEPT_POLL_INTERVAL_MS) <= 0 )
+        {
+            continue;
+        }
+
+        int connection = accept(this->listenDescriptor, nullptr, nullptr);
+        if ( connection < 0 )
+        {
+            continue;
+        }
+        this->workers.submit([ this, connection ]
+                             {
+                                 try
+                                 {
+                                     this->handle(connection);
+                                 }
+                                 catch ( ... )
+                                 {
+                                     // The client gets no response, but the other requests are unaffected.
+                                 }
+                                 close(connection);
+                             });
+    }
+}
+
+void CompileServer::stop()
+{
+    this->running = false;
+}
+
+stride::cache::CompilationCache *CompileServer::getCache(const std::string &directory)
+{
+    std::lock_guard<std::mutex> lock(this->cachesMutex);
+    auto &cache = this->caches[ directory ];
+    if ( cache == nullptr )
+    {
+        cache = std::make_unique<cache::CompilationCache>(directory);
+        cache->setMemoryCapacity(this->memoryCapacity);
+    }
+    return cache.get();
+}
+
+void CompileServer::handle(int connection)
+{
+    daemon_request_header_t request;
+    if ( !readAll(connection, &request, sizeof(request)) ||
+         memcmp(request.magic, DAEMON_REQUEST_MAGIC, 4) != 0 ||
+         request.version != DAEMON_PROTOCOL_VERSION ||
+         request.argumentCount == 0 || request.argumentCount > DAEMON_MAX_ARGUMENT_COUNT ||
+         request.environmentCount > DAEMON_MAX_ENVIRONMENT_COUNT )
+    {
+        return;
+    }
+
+    std::string workingDirectory;
+    std::vector<std::string> arguments(request.argumentCount - 1);
+    if ( !readString(connection, workingDirectory))
+    {
+        return;
+    }
+    for ( auto &argument: arguments )
+    {
+        if ( !readString(connection, argument))
+        {
+            return;
+        }
+    }
+
+    // Only the variables that influence the compilation are used; the others are those of the server.
+    std::map<std::string, std::string> environment;
+    for ( auto &name: forwardedEnvironment())
+    {
+        environment[ name ] = "";
+    }
+    for ( uint32_t i = 0; i < request.environmentCount; i++ )
+    {
+        std::string name, value;
+        if ( !readString(connection, name) || !readString(connection, value))
+        {
+            return;
+        }
+        if ( environment.count(name))
+        {
+            environment[ name ] = value;
+        }
+    }
+
+    std::ostringstream out, err;
+    int exitCode;
+    std::string value;
+    if ( extractOption(arguments, "stop-server", value))
+    {
+        out << "Compile server on " << this->socketPath << " stopped." << std::endl;
+        exitCode = 0;
+        this->stop();
+    }
+    else
+    {
+        // A request that makes the compiler throw fails on its own, rather than taking down the server.
+        try
+        {
+            exitCode = this->compile(workingDirectory, arguments, environment, out, err);
+        }
+        catch ( const std::exception &exception )
+        {
+            err << "Internal compiler error: " << exception.what() << std::endl;
+            exitCode = 1;
+        }
+    }
+
+    daemon_response_header_t response {};
+    memcpy(response.magic, DAEMON_RESPONSE_MAGIC, 4);
+    response.version = DAEMON_PROTOCOL_VERSION;
+    response.exitCode = exitCode;
+
+    // If the client disconnected in the meantime, there's no one left to report to.
+    if ( writeAll(connection, &response, sizeof(response)) && writeString(connection, out.str()))
+    {
+        writeString(connection, err.str());
+    }
+}
+
+int CompileServer::compile(const std::string &workingDirectory, std::vector<std::string> arguments,
+                           std::map<std::string, std::string> environment, std::ostream &out, std::ostream &err)
+{
+    if ( arguments.empty())
+    {
+        err << "No input file provided" << std::endl;
+        return 1;
+    }
+
+    std::filesystem::path directory(workingDirectory);
+    std::filesystem::path inputPath(arguments.back());
+    arguments.pop_back();
+
+    // Like the path flags, relative paths in the environment are relative to the client.
+    for ( auto name: { "STRIDE_CACHE_DIR", "STRIDE_PATH" } )
+    {
+        if ( !environment[ name ].empty())
+        {
+            environment[ name ] = resolvePaths(environment[ name ], directory);
+        }
+    }
+    StrideFile file(( inputPath.is_relative() ? directory / inputPath : inputPath ).c_str());
+    file.setEnvironment(std::move(environment));
+    if ( !applyCompilerOptions(file, arguments, err))
+    {
+        return 1;
+    }
+    if ( file.hasCompilerFlag("interpret"))
+    {
+        err << "The compile server doesn't run programs; interpret " << file.path() << " without '--remote'." << std::endl;
+        return 1;
+    }
+
+    for ( auto flag: pathFlags )
+    {
+        if ( file.hasCompilerFlag(flag) && std::holds_alternative<std::string>(file.getCompilerFlag(flag)))
+        {
+            std::string name = flag;
+            file.setCompilerFlag(name, resolvePaths(std::get<std::string>(file.getCompilerFlag(flag)), directory));
+        }
+    }
+
+    std::string cacheDirectory;
+    if ( file.hasCompilerFlag("cache-dir") && std::holds_alternative<std::string>(file.getCompilerFlag("cache-dir")))
+    {
+        cacheDirectory = std::get<std::string>(file.getCompilerFlag("cache-dir"));
+    }
+    else if ( file.environmentVariable("STRIDE_CACHE_DIR") != nullptr )
+    {
+        cacheDirectory = file.environmentVariable("STRIDE_CACHE_DIR");
+    }
+    file.setCompilationCache(this->getCache(cacheDirectory));
+
+    return modules::compileProgram(file, out, err) ? 0 : 1;
+}
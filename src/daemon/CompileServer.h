@@ -0,0 +1,94 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_COMPILESERVER_H
+#define STRIDE_LANGUAGE_COMPILESERVER_H
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "../cache/CompilationCache.h"
+#include "../modules/ThreadPool.h"
+
+#define DAEMON_DEFAULT_MEMORY_CAPACITY (256u << 20)
+
+namespace stride::daemon
+{
+
+    /**
+     * Long running compiler process, which accepts compile requests
+     * over a Unix domain socket.
+     * Compared to starting a compiler per file, the server only pays for process
+     * startup and the compilation of the token patterns once, and keeps
+     * recently used tokens and syntax trees in memory between requests.
+     * Requests are handled concurrently.
+     */
+    class CompileServer
+    {
+    private:
+        std::string socketPath;
+        int listenDescriptor;
+        std::atomic<bool> running;
+        modules::ThreadPool workers;
+        size_t memoryCapacity;
+
+        /**
+         * One cache per cache directory. Requests without a cache
+         * directory share a cache that is only kept in memory.
+         */
+        std::mutex cachesMutex;
+        std::map<std::string, std::unique_ptr<cache::CompilationCache>> caches;
+
+        cache::CompilationCache *getCache(const std::string &directory);
+
+        /**
+         * Reads a request from a connection, compiles it,
+         * and writes the response.
+         */
+        void handle(int connection);
+
+        /**
+         * Compiles the program described by a request.
+         * @param arguments The command line arguments, the last of which is the input file.
+         * @param environment The environment variables of the client that influence the compilation.
+         * @return The exit code of the compilation.
+         */
+        int compile(const std::string &workingDirectory, std::vector<std::string> arguments,
+                    std::map<std::string, std::string> environment, std::ostream &out, std::ostream &err);
+
+    public:
+
+        /**
+         * @param socketPath The path of the socket to listen on.
+         * @param workerCount The amount of requests that are handled concurrently.
+         * 0 selects one per hardware thread.
+         * @param memoryCapacity The amount of bytes of cache entries kept in memory.
+         */
+        CompileServer(std::string socketPath, unsigned int workerCount, size_t memoryCapacity);
+
+        ~CompileServer();
+
+        /**
+         * Binds the socket.
+         * Fails if another server is already listening on it; a socket file left
+         * behind by a server that is no longer running is replaced.
+         * @return Whether the server is ready to accept requests.
+         */
+        bool start(std::ostream &err);
+
+        /**
+         * Accepts requests until the server is stopped, either by calling
+         * <code>stop</code>, or by a client sending a shutdown request.
+         */
+        void serve();
+
+        void stop();
+    };
+}
+
+#endif //STRIDE_LANGUAGE_COMPILESERVER_H
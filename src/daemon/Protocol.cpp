@@ -0,0 +1,81 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <cerrno>
+#include <cstdlib>
+#include <unistd.h>
+#include "Protocol.h"
+
+std::string stride::daemon::defaultSocketPath()
+{
+    const char *runtimeDirectory = getenv("XDG_RUNTIME_DIR");
+    if ( runtimeDirectory != nullptr && runtimeDirectory[ 0 ] != '\0' )
+    {
+        return std::string(runtimeDirectory) + "/stride.sock";
+    }
+    return "/tmp/stride-" + std::to_string(getuid()) + ".sock";
+}
+
+const std::vector<std::string> &stride::daemon::forwardedEnvironment()
+{
+    static const std::vector<std::string> names = { "CC", "STRIDE_CACHE_DIR", "STRIDE_PATH" };
+    return names;
+}
+
+bool stride::daemon::writeAll(int fd, const void *data, size_t size)
+{
+    auto bytes = static_cast<const uint8_t *>(data);
+    while ( size > 0 )
+    {
+        ssize_t written = write(fd, bytes, size);
+        if ( written < 0 && errno == EINTR )
+        {
+            continue;
+        }
+        if ( written <= 0 )
+        {
+            return false;
+        }
+        bytes += written;
+        size -= (size_t) written;
+    }
+    return true;
+}
+
+bool stride::daemon::readAll(int fd, void *data, size_t size)
+{
+    auto bytes = static_cast<uint8_t *>(data);
+    while ( size > 0 )
+    {
+        ssize_t received = read(fd, bytes, size);
+        if ( received < 0 && errno == EINTR )
+        {
+            continue;
+        }
+        if ( received <= 0 )
+        {
+            return false;
+        }
+        bytes += received;
+        size -= (size_t) received;
+    }
+    return true;
+}
+
+bool stride::daemon::writeString(int fd, const std::string &value)
+{
+    auto length = (uint32_t) value.size();
+    return writeAll(fd, &length, sizeof(length)) && writeAll(fd, value.data(), value.size());
+}
+
+bool stride::daemon::readString(int fd, std::string &value)
+{
+    uint32_t length;
+    if ( !readAll(fd, &length, sizeof(length)) || length > DAEMON_MAX_STRING_LENGTH )
+    {
+        return false;
+    }
+    value.resize(length);
+    return readAll(fd, value.data(), length);
+}
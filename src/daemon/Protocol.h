@@ -0,0 +1,91 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_PROTOCOL_H
+#define STRIDE_LANGUAGE_PROTOCOL_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Wire format between the compile server and its clients.
+ *
+ * A client sends a single request, after which the server replies with a
+ * single response and closes the connection:
+ * <ul>
+ *  <li>request: daemon_request_header_t, followed by <code>argumentCount</code>
+ *      strings. The first string is the working directory of the client,
+ *      the others are the command line arguments. These are followed by
+ *      <code>environmentCount</code> pairs of strings; the name and value of the
+ *      environment variables of the client that influence the compilation.
+ *      Variables the client doesn't set are sent with an empty value.</li>
+ *  <li>response: daemon_response_header_t, followed by the standard output
+ *      and the standard error of the compilation.</li>
+ * </ul>
+ * Every string is encoded as its length (uint32_t), followed by its characters.
+ * All integers are in the byte order of the machine, as both ends run on the same host.
+ */
+#define DAEMON_REQUEST_MAGIC "SCRQ"
+#define DAEMON_RESPONSE_MAGIC "SCRS"
+#define DAEMON_PROTOCOL_VERSION 2
+
+/**
+ * Upper bound of the size of a single string, to reject garbage early.
+ */
+#define DAEMON_MAX_STRING_LENGTH (64u << 20)
+
+/**
+ * Upper bounds of the amount of arguments and environment variables of a request.
+ */
+#define DAEMON_MAX_ARGUMENT_COUNT 4096u
+#define DAEMON_MAX_ENVIRONMENT_COUNT 64u
+
+typedef struct
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t argumentCount;
+    uint32_t environmentCount;
+} daemon_request_header_t;
+
+typedef struct
+{
+    char magic[4];
+    uint32_t version;
+    int32_t exitCode;
+} daemon_response_header_t;
+
+namespace stride::daemon
+{
+
+    /**
+     * Returns the socket path used when none is provided;
+     * a per-user socket in $XDG_RUNTIME_DIR, or in /tmp.
+     */
+    std::string defaultSocketPath();
+
+    /**
+     * The environment variables that a client forwards to the compile server.
+     */
+    const std::vector<std::string> &forwardedEnvironment();
+
+    /**
+     * Writes all bytes to a file descriptor, retrying on partial writes.
+     * @return Whether all bytes were written.
+     */
+    bool writeAll(int fd, const void *data, size_t size);
+
+    /**
+     * Reads exactly the provided amount of bytes from a file descriptor.
+     * @return Whether all bytes were read before the connection was closed.
+     */
+    bool readAll(int fd, void *data, size_t size);
+
+    bool writeString(int fd, const std::string &value);
+
+    bool readString(int fd, std::string &value);
+}
+
+#endif //STRIDE_LANGUAGE_PROTOCOL_H
@@ -0,0 +1,194 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include "Diagnostics.h"
+#include "../StrideFile.h"
+
+#define ANSI_BOLD_WHITE "\033[1;38m"
+#define ANSI_DARK_RED "\033[31m"
+#define ANSI_YELLOW "\033[33m"
+#define ANSI_CYAN "\033[36m"
+#define ANSI_RESET "\033[0m"
+#define ANSI_BG_RED_WHITE "\033[101;38m"
+
+#define DEFAULT_ERROR_LIMIT 100
+
+using namespace stride::error;
+
+/**
+ * Computes the line, column and line content of the provided source index.
+ */
+void getFaultyLineInfo(const char *source, int index, int &line, int &column, std::string &lineContent)
+{
+    line = 1;
+    column = 1;
+    int sourceLength = (int) strlen(source);
+    index = std::clamp(index, 0, sourceLength);
+    int start = index;
+    int end = index;
+    while ( start > 0 && source[ start - 1 ] != '\n' )
+    {
+        start--;
+    }
+    while ( end < sourceLength && source[ end ] != '\n' )
+    {
+        end++;
+    }
+    lineContent = std::string(source + start, end - start);
+    for ( int i = 0; i < index; i++ )
+    {
+        if ( source[ i ] == '\n' )
+        {
+            line++;
+            column = 1;
+        }
+        else
+        {
+            column++;
+        }
+    }
+}
+
+const char *severityLabel(ESeverity severity)
+{
+    switch ( severity )
+    {
+        case NOTE:
+            return ANSI_CYAN "note" ANSI_RESET;
+        case WARNING:
+            return ANSI_YELLOW "warning" ANSI_RESET;
+        case ERROR:
+            return ANSI_DARK_RED "error" ANSI_RESET;
+        default:
+            return ANSI_DARK_RED "fatal error" ANSI_RESET;
+    }
+}
+
+DiagnosticEngine::DiagnosticEngine(stride::StrideFile *source) :
+        source(source),
+        diagnostics(),
+        severityCounts { 0, 0, 0, 0 },
+        errorLimit(DEFAULT_ERROR_LIMIT)
+{}
+
+void DiagnosticEngine::report(ESeverity severity, int index, int length, std::string message)
+{
+    this->diagnostics.push_back({ severity, index, length, std::move(message) });
+    this->severityCounts[ severity ]++;
+
+    if ( severity == FATAL )
+    {
+        throw FatalError(this->diagnostics.back().message);
+    }
+
+    if ( severity == ERROR && this->errorLimit > 0 && this->severityCounts[ ERROR ] >= this->errorLimit )
+    {
+        this->diagnostics.push_back({ FATAL, index, 0, "Too many errors emitted, stopping now." });
+        this->severityCounts[ FATAL ]++;
+        throw FatalError("Too many errors emitted.");
+    }
+}
+
+bool DiagnosticEngine::hasErrors() const
+{
+    return this->severityCounts[ ERROR ] > 0 || this->severityCounts[ FATAL ] > 0;
+}
+
+unsigned int DiagnosticEngine::count(ESeverity severity) const
+{
+    return this->severityCounts[ severity ];
+}
+
+const std::vector<Diagnostic> &DiagnosticEngine::getDiagnostics() const
+{
+    return this->diagnostics;
+}
+
+void DiagnosticEngine::setErrorLimit(unsigned int limit)
+{
+    this->errorLimit = limit;
+}
+
+void DiagnosticEngine::clear()
+{
+    this->diagnostics.clear();
+    std::fill(std::begin(this->severityCounts), std::end(this->severityCounts), 0);
+}
+
+void DiagnosticEngine::applyEdit(int start, int end, int delta)
+{
+    std::vector<Diagnostic> kept;
+    std::fill(std::begin(this->severityCounts), std::end(this->severityCounts), 0);
+
+    for ( auto &diagnostic: this->diagnostics )
+    {
+        if ( diagnostic.index >= start && diagnostic.index < end )
+        {
+            continue;
+        }
+        if ( diagnostic.index >= end )
+        {
+            diagnostic.index += delta;
+        }
+        this->severityCounts[ diagnostic.severity ]++;
+        kept.push_back(std::move(diagnostic));
+    }
+    this->diagnostics = std::move(kept);
+}
+
+void DiagnosticEngine::render(std::ostream &out) const
+{
+    if ( this->diagnostics.empty())
+    {
+        return;
+    }
+
+    // Sort by position, but keep the order of reporting for diagnostics
+    // that point to the same location.
+    std::vector<const Diagnostic *> sorted;
+    sorted.reserve(this->diagnostics.size());
+    for ( auto &diagnostic: this->diagnostics )
+    {
+        sorted.push_back(&diagnostic);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Diagnostic *a, const Diagnostic *b)
+    {
+        return a->index < b->index;
+    });
+
+    const char *content = this->source->getContent().c_str();
+
+    for ( auto diagnostic: sorted )
+    {
+        int line, column;
+        std::string lineContent;
+        getFaultyLineInfo(content, diagnostic->index, line, column, lineContent);
+        int lineNumberDigitsLength = (int) std::to_string(line).length();
+        int padding = std::max(5 - lineNumberDigitsLength, 1);
+
+        // Highlight the faulty part of the line
+        int highlightStart = std::min(column - 1, (int) lineContent.length());
+        int highlightLength = std::clamp(diagnostic->length, 0, (int) lineContent.length() - highlightStart);
+        lineContent.insert(highlightStart + highlightLength, ANSI_RESET);
+        lineContent.insert(highlightStart, ANSI_BG_RED_WHITE);
+
+        out << std::endl << std::setw(padding + lineNumberDigitsLength) << ""
+            << "╭─[ " << this->source->path() << ":" << line << ":" << column << " ] " << std::endl;
+        out << std::setw(padding + lineNumberDigitsLength) << "" << "·" << std::endl;
+        out << line << std::setw(padding) << "" << "│ " << lineContent << std::endl;
+        out << std::setw(padding + lineNumberDigitsLength) << "" << "·" << std::endl;
+        out << std::setw(padding + lineNumberDigitsLength) << "" << "·   "
+            << severityLabel(diagnostic->severity) << ": " << diagnostic->message << std::endl;
+    }
+
+    unsigned int errors = this->severityCounts[ ERROR ];
+    unsigned int warnings = this->severityCounts[ WARNING ];
+    out << std::endl << ANSI_BOLD_WHITE
+        << errors << ( errors == 1 ? " error" : " errors" ) << " and "
+        << warnings << ( warnings == 1 ? " warning" : " warnings" )
+        << " generated for " << this->source->path() << "." << ANSI_RESET << std::endl;
+}
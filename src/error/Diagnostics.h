@@ -0,0 +1,138 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_DIAGNOSTICS_H
+#define STRIDE_LANGUAGE_DIAGNOSTICS_H
+
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace stride
+{
+    class StrideFile;
+}
+
+namespace stride::error
+{
+
+    enum ESeverity
+    {
+        NOTE,
+        WARNING,
+        ERROR,
+        FATAL
+    };
+
+    /**
+     * A single diagnostic message.
+     * Only the raw source index is stored; line and column information
+     * is computed when the diagnostic is rendered.
+     */
+    struct Diagnostic
+    {
+        ESeverity severity;
+        int index;
+        int length;
+        std::string message;
+    };
+
+    /**
+     * Thrown after an error has been reported while parsing.
+     * The parser catches this at the nearest synchronization point,
+     * skips the faulty tokens and continues with the next statement.
+     */
+    class ParseError : public std::runtime_error
+    {
+    public:
+        explicit ParseError(const std::string &message) : std::runtime_error(message)
+        {}
+    };
+
+    /**
+     * Thrown when the error limit of a diagnostic engine is exceeded.
+     * This is not caught by the parser, and stops the compilation of the file.
+     */
+    class FatalError : public std::runtime_error
+    {
+    public:
+        explicit FatalError(const std::string &message) : std::runtime_error(message)
+        {}
+    };
+
+    /**
+     * Collects the diagnostics of a single source file.
+     * Diagnostics are stored when they are reported, and are only
+     * rendered when <code>render</code> is called, usually at the end of
+     * the compilation of the file.
+     */
+    class DiagnosticEngine
+    {
+    private:
+        StrideFile *source;
+        std::vector<Diagnostic> diagnostics;
+        unsigned int severityCounts[4];
+        unsigned int errorLimit;
+
+    public:
+
+        explicit DiagnosticEngine(StrideFile *source);
+
+        /**
+         * Reports a diagnostic.
+         * If the number of errors exceeds the error limit,
+         * a FatalError is thrown.
+         * @param severity The severity of the diagnostic.
+         * @param index The source index the diagnostic refers to.
+         * @param length The amount of characters to highlight.
+         * @param message The message to display.
+         */
+        void report(ESeverity severity, int index, int length, std::string message);
+
+        /**
+         * Whether any errors were reported.
+         */
+        [[nodiscard]] bool hasErrors() const;
+
+        /**
+         * Returns the amount of reported diagnostics of the provided severity.
+         */
+        [[nodiscard]] unsigned int count(ESeverity severity) const;
+
+        /**
+         * Returns all reported diagnostics, in order of reporting.
+         */
+        [[nodiscard]] const std::vector<Diagnostic> &getDiagnostics() const;
+
+        /**
+         * Sets the maximum amount of errors before compilation is aborted.
+         * A limit of 0 means there is no limit.
+         */
+        void setErrorLimit(unsigned int limit);
+
+        /**
+         * Renders all diagnostics to the provided stream,
+         * sorted by their position in the source file.
+         */
+        void render(std::ostream &out) const;
+
+        /**
+         * Removes all reported diagnostics.
+         */
+        void clear();
+
+        /**
+         * Updates the diagnostics after part of the source was replaced.
+         * Diagnostics within the replaced range are removed, as that range is
+         * checked again; diagnostics after it are moved by the change in length.
+         * @param start The index of the first replaced character.
+         * @param end The index after the last replaced character, before the edit.
+         * @param delta The difference in length between the new and the old text.
+         */
+        void applyEdit(int start, int end, int delta);
+    };
+}
+
+#endif //STRIDE_LANGUAGE_DIAGNOSTICS_H
@@ -7,10 +7,21 @@
 
 #include <vector>
 #include "../StrideFile.h"
+#include "Diagnostics.h"
 
 namespace stride::error
 {
-    void error(StrideFile &file, int index, int tokenLength, const char *message, ...);
+    /**
+     * Reports an error to the diagnostic engine of the file,
+     * and throws a ParseError to unwind to the nearest synchronization point.
+     */
+    [[noreturn]] void error(StrideFile &file, int index, int tokenLength, const char *message, ...);
+
+    /**
+     * Reports a warning to the diagnostic engine of the file.
+     * Unlike errors, warnings do not interrupt parsing.
+     */
+    void warning(StrideFile &file, int index, int tokenLength, const char *message, ...);
 }
 
 #endif //STRIDE_LANGUAGE_AST_ERROR_HANDLING_H
@@ -0,0 +1,124 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include "AliasAnalysis.h"
+
+using namespace stride::ir;
+
+AliasInfo::AliasInfo(const Function &function)
+{
+    for ( auto block: function.blocks )
+    {
+        for ( auto instruction: block->instructions )
+        {
+            if ( instruction->opcode != OP_ALLOCATE )
+            {
+                continue;
+            }
+            bool escapes = false;
+            for ( auto user: instruction->users )
+            {
+                if ( user->opcode != OP_FIELD_ADDRESS || user->operands[ 0 ] != instruction )
+                {
+                    escapes = true;
+                    break;
+                }
+            }
+            if ( !escapes )
+            {
+                this->localAllocations.insert(instruction);
+            }
+        }
+    }
+}
+
+std::pair<const Value *, stride::ast::Node *> AliasInfo::locationOf(const Value *address)
+{
+    if ( address->kind == VALUE_INSTRUCTION )
+    {
+        auto instruction = static_cast<const Instruction *>(address);
+        if ( instruction->opcode == OP_FIELD_ADDRESS )
+        {
+            return { instruction->operands[ 0 ], instruction->field };
+        }
+    }
+    return { address, nullptr };
+}
+
+bool AliasInfo::isIdentifiedObject(const Value *object) const
+{
+    return object->kind == VALUE_GLOBAL ||
+           ( object->kind == VALUE_INSTRUCTION && static_cast<const Instruction *>(object)->opcode == OP_ALLOCATE );
+}
+
+EAliasResult AliasInfo::alias(const Value *first, const Value *second) const
+{
+    if ( first == second )
+    {
+        return MUST_ALIAS;
+    }
+    auto [ firstObject, firstField ] = locationOf(first);
+    auto [ secondObject, secondField ] = locationOf(second);
+
+    if ( firstField != nullptr && secondField != nullptr )
+    {
+        if ( firstField != secondField )
+        {
+            return NO_ALIAS;
+        }
+        if ( firstObject == secondObject )
+        {
+            return MUST_ALIAS;
+        }
+        return this->isIdentifiedObject(firstObject) && this->isIdentifiedObject(secondObject) ?
+               NO_ALIAS : MAY_ALIAS;
+    }
+
+    // Globals aren't fields of objects, and distinct objects don't overlap.
+    if ( ( firstField != nullptr && secondObject->kind == VALUE_GLOBAL ) ||
+         ( secondField != nullptr && firstObject->kind == VALUE_GLOBAL ))
+    {
+        return NO_ALIAS;
+    }
+    if ( firstField == nullptr && secondField == nullptr &&
+         this->isIdentifiedObject(firstObject) && this->isIdentifiedObject(secondObject))
+    {
+        return NO_ALIAS;
+    }
+    return MAY_ALIAS;
+}
+
+bool AliasInfo::mayWrite(const Instruction *instruction, const Value *address) const
+{
+    switch ( instruction->opcode )
+    {
+        case OP_STORE:
+            return this->alias(instruction->operands[ 0 ], address) != NO_ALIAS;
+        case OP_CALL:
+        case OP_INVOKE:
+        case OP_ALLOCATE:
+            // Called functions and constructors can't reach allocations that don't escape.
+            return this->localAllocations.count(locationOf(address).first) == 0;
+        default:
+            return false;
+    }
+}
+
+bool AliasInfo::mayRead(const Instruction *instruction, const Value *address) const
+{
+    switch ( instruction->opcode )
+    {
+        case OP_LOAD:
+            return this->alias(instruction->operands[ 0 ], address) != NO_ALIAS;
+        case OP_CALL:
+        case OP_INVOKE:
+        case OP_ALLOCATE:
+        case OP_RETURN:
+        case OP_THROW:
+            // Memory is observable once the function is left.
+            return this->localAllocations.count(locationOf(address).first) == 0;
+        default:
+            return false;
+    }
+}
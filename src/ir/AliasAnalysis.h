@@ -0,0 +1,59 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_ALIASANALYSIS_H
+#define STRIDE_LANGUAGE_ALIASANALYSIS_H
+
+#include <unordered_set>
+#include "IR.h"
+
+namespace stride::ir
+{
+
+    enum EAliasResult
+    {
+        NO_ALIAS,   // The addresses never refer to the same memory
+        MAY_ALIAS,
+        MUST_ALIAS  // The addresses always refer to the same memory
+    };
+
+    /**
+     * Answers whether two addresses may refer to the same memory.
+     *
+     * Addresses are described by the object they're in and the field they refer to.
+     * Distinct globals and allocations are distinct objects, and distinct fields
+     * never overlap. Allocations that don't escape the function, i.e. that are only
+     * used to address their fields, can't be accessed by the functions it calls.
+     */
+    class AliasInfo
+    {
+    private:
+        std::unordered_set<const Value *> localAllocations;
+
+        /**
+         * The object an address is in, and the field, or nullptr if it's the object itself.
+         */
+        static std::pair<const Value *, ast::Node *> locationOf(const Value *address);
+
+        [[nodiscard]] bool isIdentifiedObject(const Value *object) const;
+
+    public:
+
+        explicit AliasInfo(const Function &function);
+
+        [[nodiscard]] EAliasResult alias(const Value *first, const Value *second) const;
+
+        /**
+         * Whether an instruction may modify the memory at an address.
+         */
+        [[nodiscard]] bool mayWrite(const Instruction *instruction, const Value *address) const;
+
+        /**
+         * Whether an instruction may read the memory at an address.
+         */
+        [[nodiscard]] bool mayRead(const Instruction *instruction, const Value *address) const;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_ALIASANALYSIS_H
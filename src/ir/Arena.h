@@ -0,0 +1,98 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_ARENA_H
+#define STRIDE_LANGUAGE_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/** The size of the chunks an arena allocates from. Larger objects get a chunk of their own. */
+#define ARENA_CHUNK_SIZE ( 64 * 1024 )
+
+namespace stride::ir
+{
+
+    /**
+     * Bump allocator for objects that live as long as the arena.
+     *
+     * Objects are placed one after the other in large chunks, so creating one
+     * is a pointer increment, and objects created after each other are close
+     * in memory. Nothing is freed individually; objects that aren't trivially
+     * destructible are destroyed in reverse order of creation when the arena is.
+     */
+    class Arena
+    {
+    private:
+        std::vector<std::unique_ptr<uint8_t[]>> chunks;
+        uint8_t *cursor = nullptr;
+        size_t remaining = 0;
+        size_t allocated = 0;
+        std::vector<std::pair<void *, void (*)(void *)>> destructors;
+
+    public:
+
+        Arena() = default;
+
+        Arena(const Arena &) = delete;
+
+        Arena &operator=(const Arena &) = delete;
+
+        ~Arena()
+        {
+            for ( auto it = this->destructors.rbegin(); it != this->destructors.rend(); ++it )
+            {
+                it->second(it->first);
+            }
+        }
+
+        /**
+         * Allocates uninitialized memory with the provided alignment.
+         */
+        void *allocate(size_t size, size_t alignment)
+        {
+            size_t padding = -(uintptr_t) this->cursor & ( alignment - 1 );
+            if ( this->cursor == nullptr || padding + size > this->remaining )
+            {
+                size_t chunkSize = std::max<size_t>(ARENA_CHUNK_SIZE, size + alignment);
+                this->chunks.emplace_back(new uint8_t[chunkSize]);
+                this->cursor = this->chunks.back().get();
+                this->remaining = chunkSize;
+                padding = -(uintptr_t) this->cursor & ( alignment - 1 );
+            }
+            void *memory = this->cursor + padding;
+            this->cursor += padding + size;
+            this->remaining -= padding + size;
+            this->allocated += size;
+            return memory;
+        }
+
+        /**
+         * Constructs an object in the arena.
+         */
+        template<typename T, typename... Args>
+        T *create(Args &&... args)
+        {
+            T *object = new(this->allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            if constexpr ( !std::is_trivially_destructible_v<T> )
+            {
+                this->destructors.emplace_back(object, [](void *pointer) { static_cast<T *>(pointer)->~T(); });
+            }
+            return object;
+        }
+
+        /**
+         * Returns the amount of bytes allocated for objects, excluding alignment padding.
+         */
+        [[nodiscard]] size_t bytesAllocated() const
+        { return this->allocated; }
+    };
+}
+
+#endif //STRIDE_LANGUAGE_ARENA_H
@@ -0,0 +1,150 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include "Dominators.h"
+
+using namespace stride::ir;
+
+DominatorTree::DominatorTree(const Function &function)
+{
+    size_t blockCount = function.blocks.size();
+    this->orderIndex.assign(blockCount, -1);
+    this->immediateDominators.assign(blockCount, nullptr);
+    this->dominatedChildren.resize(blockCount);
+    if ( function.blocks.empty())
+    {
+        return;
+    }
+
+    // Postorder, with an explicit stack of blocks and their next successor.
+    std::vector<bool> visited(blockCount, false);
+    std::vector<std::pair<BasicBlock *, size_t>> stack = { { function.entry(), 0 } };
+    visited[ function.entry()->id ] = true;
+    while ( !stack.empty())
+    {
+        auto &[ block, next ] = stack.back();
+        const std::vector<BasicBlock *> &successors = block->successors();
+        if ( next < successors.size())
+        {
+            BasicBlock *successor = successors[ next++ ];
+            if ( !visited[ successor->id ] )
+            {
+                visited[ successor->id ] = true;
+                stack.emplace_back(successor, 0);
+            }
+            continue;
+        }
+        this->order.push_back(block);
+        stack.pop_back();
+    }
+    std::reverse(this->order.begin(), this->order.end());
+    for ( size_t i = 0; i < this->order.size(); i++ )
+    {
+        this->orderIndex[ this->order[ i ]->id ] = (int32_t) i;
+    }
+
+    // Walks up from two blocks until they meet; blocks later in reverse postorder are deeper.
+    auto intersect = [ this ](BasicBlock *first, BasicBlock *second)
+    {
+        while ( first != second )
+        {
+            while ( this->orderIndex[ first->id ] > this->orderIndex[ second->id ] )
+            {
+                first = this->immediateDominators[ first->id ];
+            }
+            while ( this->orderIndex[ second->id ] > this->orderIndex[ first->id ] )
+            {
+                second = this->immediateDominators[ second->id ];
+            }
+        }
+        return first;
+    };
+
+    BasicBlock *entry = function.entry();
+    this->immediateDominators[ entry->id ] = entry;
+    for ( bool changed = true; changed; )
+    {
+        changed = false;
+        for ( size_t i = 1; i < this->order.size(); i++ )
+        {
+            BasicBlock *block = this->order[ i ];
+            BasicBlock *dominator = nullptr;
+            for ( auto predecessor: block->predecessors )
+            {
+                if ( this->orderIndex[ predecessor->id ] < 0 ||
+                     this->immediateDominators[ predecessor->id ] == nullptr )
+                {
+                    continue;
+                }
+                dominator = dominator == nullptr ? predecessor : intersect(predecessor, dominator);
+            }
+            if ( dominator != this->immediateDominators[ block->id ] )
+            {
+                this->immediateDominators[ block->id ] = dominator;
+                changed = true;
+            }
+        }
+    }
+    this->immediateDominators[ entry->id ] = nullptr;
+
+    for ( size_t i = 1; i < this->order.size(); i++ )
+    {
+        BasicBlock *block = this->order[ i ];
+        this->dominatedChildren[ this->immediateDominators[ block->id ]->id ].push_back(block);
+    }
+}
+
+BasicBlock *DominatorTree::immediateDominator(const BasicBlock *block) const
+{
+    return this->isReachable(block) ? this->immediateDominators[ block->id ] : nullptr;
+}
+
+const std::vector<BasicBlock *> &DominatorTree::children(const BasicBlock *block) const
+{
+    return this->dominatedChildren[ block->id ];
+}
+
+bool DominatorTree::dominates(const BasicBlock *dominator, const BasicBlock *block) const
+{
+    if ( !this->isReachable(dominator) || !this->isReachable(block))
+    {
+        return false;
+    }
+    // Dominators precede the blocks they dominate in reverse postorder.
+    while ( block != nullptr && this->orderIndex[ block->id ] > this->orderIndex[ dominator->id ] )
+    {
+        block = this->immediateDominators[ block->id ];
+    }
+    return block == dominator;
+}
+
+bool DominatorTree::dominates(const Value *definition, const Instruction *user, size_t operand) const
+{
+    if ( definition->kind != VALUE_INSTRUCTION )
+    {
+        return true;
+    }
+    auto instruction = static_cast<const Instruction *>(definition);
+    if ( user->opcode == OP_PHI )
+    {
+        return this->dominates(instruction->block, user->targets[ operand ]);
+    }
+    if ( instruction->block != user->block )
+    {
+        return this->dominates(instruction->block, user->block);
+    }
+    for ( auto current: user->block->instructions )
+    {
+        if ( current == instruction )
+        {
+            return true;
+        }
+        if ( current == user )
+        {
+            return false;
+        }
+    }
+    return false;
+}
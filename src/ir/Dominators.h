@@ -0,0 +1,68 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_DOMINATORS_H
+#define STRIDE_LANGUAGE_DOMINATORS_H
+
+#include "IR.h"
+
+namespace stride::ir
+{
+
+    /**
+     * The dominator tree of a function. A block dominates another if every path
+     * from the entry to the other block passes through it.
+     *
+     * The tree is computed with the iterative algorithm of Cooper, Harvey and
+     * Kennedy, "A Simple, Fast Dominance Algorithm". Blocks are indexed by their
+     * id, so the function must be renumbered before the tree is computed.
+     */
+    class DominatorTree
+    {
+    private:
+        std::vector<BasicBlock *> order;
+
+        // Indexed by block id; -1 for blocks that can't be reached from the entry.
+        std::vector<int32_t> orderIndex;
+        std::vector<BasicBlock *> immediateDominators;
+        std::vector<std::vector<BasicBlock *>> dominatedChildren;
+
+    public:
+
+        explicit DominatorTree(const Function &function);
+
+        /**
+         * Returns the blocks that are reachable from the entry, in reverse postorder.
+         * Every block precedes its successors, other than along back edges.
+         */
+        [[nodiscard]] const std::vector<BasicBlock *> &reversePostOrder() const
+        { return this->order; }
+
+        [[nodiscard]] bool isReachable(const BasicBlock *block) const
+        { return block->id < this->orderIndex.size() && this->orderIndex[ block->id ] >= 0; }
+
+        /**
+         * Returns the closest block that strictly dominates a block, or nullptr for the entry.
+         */
+        [[nodiscard]] BasicBlock *immediateDominator(const BasicBlock *block) const;
+
+        /**
+         * Returns the blocks a block is the immediate dominator of.
+         */
+        [[nodiscard]] const std::vector<BasicBlock *> &children(const BasicBlock *block) const;
+
+        /**
+         * Whether a block dominates another. Blocks dominate themselves.
+         */
+        [[nodiscard]] bool dominates(const BasicBlock *dominator, const BasicBlock *block) const;
+
+        /**
+         * Whether the value of a definition is available at an instruction.
+         * Phi nodes use their operands at the end of the corresponding predecessor.
+         */
+        [[nodiscard]] bool dominates(const Value *definition, const Instruction *user, size_t operand) const;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_DOMINATORS_H
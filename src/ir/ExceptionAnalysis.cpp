@@ -0,0 +1,49 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include "ExceptionAnalysis.h"
+
+using namespace stride::ir;
+
+ExceptionAnalysis::ExceptionAnalysis(const Module &module)
+{
+    for ( auto function: module.functions )
+    {
+        if ( function->external && function->declaration == nullptr &&
+             function->name.compare(0, 9, "__stride_") != 0 && function->name != "pow" )
+        {
+            this->throwingFunctions.insert(function);
+        }
+    }
+
+    bool changed = true;
+    while ( changed )
+    {
+        changed = false;
+        for ( auto function: module.functions )
+        {
+            if ( function->external || this->throwingFunctions.count(function) > 0 )
+            {
+                continue;
+            }
+            for ( auto block: function->blocks )
+            {
+                for ( auto instruction: block->instructions )
+                {
+                    if (( instruction->opcode == OP_THROW && instruction->targets.empty()) ||
+                        ( instruction->opcode == OP_CALL && this->mayThrow(instruction->operands[ 0 ])))
+                    {
+                        this->throwingFunctions.insert(function);
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+}
+
+bool ExceptionAnalysis::mayThrow(const Value *callee) const
+{
+    return callee->kind != VALUE_FUNCTION || this->throwingFunctions.count(static_cast<const Function *>(callee)) > 0;
+}
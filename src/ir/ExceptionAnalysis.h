@@ -0,0 +1,35 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_EXCEPTIONANALYSIS_H
+#define STRIDE_LANGUAGE_EXCEPTIONANALYSIS_H
+
+#include <unordered_set>
+#include "IR.h"
+
+namespace stride::ir
+{
+
+    /**
+     * Finds the functions of a module that may raise an exception to their caller; those
+     * that throw without catching, or call a function that does outside a try block.
+     * Functions of other compilation units may throw; the runtime and C functions don't.
+     * Backends only check for an exception after calls of these.
+     */
+    class ExceptionAnalysis
+    {
+    private:
+        std::unordered_set<const Function *> throwingFunctions;
+
+    public:
+        explicit ExceptionAnalysis(const Module &module);
+
+        /**
+         * Whether calling a value may raise an exception; functions that are called through their address may.
+         */
+        [[nodiscard]] bool mayThrow(const Value *callee) const;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_EXCEPTIONANALYSIS_H
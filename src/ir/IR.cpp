@@ -0,0 +1,453 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include <iomanip>
+#include "IR.h"
+#include "../syntax_tree/node_types/definitions/NVariableDeclaration.h"
+
+using namespace stride::ir;
+
+const char *stride::ir::typeName(EIRType type)
+{
+    static const char *names[] = { "void", "bool", "i8", "i16", "i32", "i64", "f32", "f64", "ptr" };
+    return names[ type ];
+}
+
+uint32_t stride::ir::sizeOf(EIRType type)
+{
+    static const uint32_t sizes[] = { 0, 1, 1, 2, 4, 8, 4, 8, 8 };
+    return sizes[ type ];
+}
+
+std::string stride::ir::mangle(const std::string &name)
+{
+    if ( name.find("::") == std::string::npos )
+    {
+        return name;
+    }
+    std::string symbol;
+    size_t start = 0;
+    size_t separator;
+    while (( separator = name.find("::", start)) != std::string::npos )
+    {
+        symbol.append("__").append(name, start, separator - start);
+        start = separator + 2;
+    }
+    return symbol.append("__").append(name, start, std::string::npos);
+}
+
+const char *stride::ir::opcodeName(EOpcode opcode)
+{
+    static const char *names[] = {
+            "phi",
+            "add", "sub", "mul", "sdiv", "udiv", "srem", "urem",
+            "fadd", "fsub", "fmul", "fdiv", "frem",
+            "shl", "lshr", "ashr", "and", "or", "xor",
+            "icmp", "fcmp",
+            "trunc", "zext", "sext", "fptrunc", "fpext", "sitofp", "uitofp", "fptosi", "fptoui",
+            "load", "store", "field", "allocate", "array", "call", "landingpad",
+            "br", "condbr", "switch", "ret", "invoke", "throw", "unreachable"
+    };
+    return names[ opcode ];
+}
+
+const char *stride::ir::predicateName(EPredicate predicate)
+{
+    static const char *names[] = { "eq", "ne", "lt", "le", "gt", "ge", "ult", "ule", "ugt", "uge" };
+    return names[ predicate ];
+}
+
+void Value::replaceAllUsesWith(Value *replacement)
+{
+    // Users are moved, since replacing an operand updates the list of users.
+    std::vector<Instruction *> previousUsers = std::move(this->users);
+    this->users.clear();
+    for ( auto user: previousUsers )
+    {
+        for ( size_t i = 0; i < user->operands.size(); i++ )
+        {
+            if ( user->operands[ i ] == this )
+            {
+                user->operands[ i ] = replacement;
+                replacement->users.push_back(user);
+            }
+        }
+    }
+}
+
+/**
+ * Removes a single use of a value by an instruction.
+ */
+static void removeUse(Value *value, Instruction *user)
+{
+    auto use = std::find(value->users.begin(), value->users.end(), user);
+    if ( use != value->users.end())
+    {
+        value->users.erase(use);
+    }
+}
+
+void Instruction::addOperand(Value *value)
+{
+    this->operands.push_back(value);
+    value->users.push_back(this);
+}
+
+void Instruction::setOperand(size_t index, Value *value)
+{
+    removeUse(this->operands[ index ], this);
+    this->operands[ index ] = value;
+    value->users.push_back(this);
+}
+
+void Instruction::dropOperands()
+{
+    for ( auto operand: this->operands )
+    {
+        removeUse(operand, this);
+    }
+    this->operands.clear();
+}
+
+void Instruction::addIncoming(Value *value, BasicBlock *predecessor)
+{
+    this->addOperand(value);
+    this->targets.push_back(predecessor);
+}
+
+void Instruction::moveBefore(Instruction *position)
+{
+    auto current = std::find(this->block->instructions.begin(), this->block->instructions.end(), this);
+    this->block->instructions.erase(current);
+    this->block = position->block;
+    auto target = std::find(this->block->instructions.begin(), this->block->instructions.end(), position);
+    this->block->instructions.insert(target, this);
+}
+
+bool Instruction::hasSideEffects() const
+{
+    switch ( this->opcode )
+    {
+        case OP_STORE:
+        case OP_ALLOCATE:
+        case OP_CALL:
+        case OP_LANDING_PAD:
+            return true;
+        default:
+            return this->isTerminator();
+    }
+}
+
+const std::vector<BasicBlock *> &BasicBlock::successors() const
+{
+    static const std::vector<BasicBlock *> none;
+    Instruction *terminator = this->terminator();
+    return terminator != nullptr ? terminator->targets : none;
+}
+
+void BasicBlock::erase(Instruction *instruction)
+{
+    instruction->dropOperands();
+    auto position = std::find(this->instructions.begin(), this->instructions.end(), instruction);
+    if ( position != this->instructions.end())
+    {
+        this->instructions.erase(position);
+    }
+    instruction->block = nullptr;
+}
+
+void BasicBlock::removePredecessor(BasicBlock *predecessor)
+{
+    auto edge = std::find(this->predecessors.begin(), this->predecessors.end(), predecessor);
+    if ( edge == this->predecessors.end())
+    {
+        return;
+    }
+    this->predecessors.erase(edge);
+
+    for ( auto instruction: this->instructions )
+    {
+        if ( instruction->opcode != OP_PHI )
+        {
+            break;
+        }
+        auto incoming = std::find(instruction->targets.begin(), instruction->targets.end(), predecessor);
+        if ( incoming != instruction->targets.end())
+        {
+            size_t index = incoming - instruction->targets.begin();
+            removeUse(instruction->operands[ index ], instruction);
+            instruction->operands.erase(instruction->operands.begin() + (long) index);
+            instruction->targets.erase(incoming);
+        }
+    }
+}
+
+void BasicBlock::replacePredecessor(BasicBlock *from, BasicBlock *to)
+{
+    std::replace(this->predecessors.begin(), this->predecessors.end(), from, to);
+    for ( auto instruction: this->instructions )
+    {
+        if ( instruction->opcode != OP_PHI )
+        {
+            break;
+        }
+        std::replace(instruction->targets.begin(), instruction->targets.end(), from, to);
+    }
+}
+
+void Function::renumber()
+{
+    uint32_t next = 0;
+    for ( auto argument: this->arguments )
+    {
+        argument->id = next++;
+    }
+    for ( size_t i = 0; i < this->blocks.size(); i++ )
+    {
+        this->blocks[ i ]->id = (uint32_t) i;
+        for ( auto instruction: this->blocks[ i ]->instructions )
+        {
+            instruction->id = next++;
+        }
+    }
+    this->valueCount = next;
+}
+
+size_t Function::instructionCount() const
+{
+    size_t count = 0;
+    for ( auto block: this->blocks )
+    {
+        count += block->instructions.size();
+    }
+    return count;
+}
+
+Constant *Module::integer(EIRType type, int64_t value)
+{
+    Constant *&constant = this->integerConstants[ { type, value } ];
+    if ( constant == nullptr )
+    {
+        constant = this->valueArena.create<Constant>(type);
+        constant->integer = value;
+    }
+    return constant;
+}
+
+Constant *Module::floating(EIRType type, double value)
+{
+    Constant *&constant = this->floatConstants[ { type, value } ];
+    if ( constant == nullptr )
+    {
+        constant = this->valueArena.create<Constant>(type);
+        constant->floating = value;
+    }
+    return constant;
+}
+
+Constant *Module::string(const std::string &value)
+{
+    Constant *&constant = this->stringConstants[ value ];
+    if ( constant == nullptr )
+    {
+        constant = this->valueArena.create<Constant>(IR_PTR);
+        constant->string = value;
+        constant->isString = true;
+    }
+    return constant;
+}
+
+Value *Module::undefined(EIRType type)
+{
+    Value *&value = this->undefinedValues[ type ];
+    if ( value == nullptr )
+    {
+        value = this->valueArena.create<Value>(VALUE_UNDEFINED, type);
+    }
+    return value;
+}
+
+Function *Module::createFunction(const std::string &functionName, EIRType returnType, ast::Node *declaration)
+{
+    std::string unique = functionName;
+    for ( int suffix = 1; this->functionsByName.count(unique) > 0; suffix++ )
+    {
+        unique = functionName + "." + std::to_string(suffix);
+    }
+    auto function = this->valueArena.create<Function>(unique, returnType, declaration);
+    function->module = this;
+    this->functions.push_back(function);
+    this->functionsByName[ unique ] = function;
+    return function;
+}
+
+Function *Module::getFunction(const std::string &functionName) const
+{
+    auto function = this->functionsByName.find(functionName);
+    return function != this->functionsByName.end() ? function->second : nullptr;
+}
+
+Global *Module::createGlobal(const std::string &globalName, EIRType valueType, ast::Node *declaration)
+{
+    auto global = this->valueArena.create<Global>(globalName, valueType, declaration);
+    this->globals.push_back(global);
+    return global;
+}
+
+/**
+ * Prints a reference to a value, e.g. '%3', '@main' or '12'.
+ */
+static void printValue(std::ostream &out, const Value *value)
+{
+    switch ( value->kind )
+    {
+        case VALUE_CONSTANT:
+        {
+            auto constant = static_cast<const Constant *>(value);
+            if ( constant->isString )
+            {
+                out << std::quoted(constant->string);
+            }
+            else if ( isFloat(constant->type))
+            {
+                out << std::setprecision(17) << constant->floating;
+            }
+            else if ( constant->type == IR_BOOL )
+            {
+                out << ( constant->integer != 0 ? "true" : "false" );
+            }
+            else
+            {
+                out << constant->integer;
+            }
+        }
+            break;
+        case VALUE_UNDEFINED:
+            out << "undef";
+            break;
+        case VALUE_GLOBAL:
+            out << "@" << static_cast<const Global *>(value)->name;
+            break;
+        case VALUE_FUNCTION:
+            out << "@" << static_cast<const Function *>(value)->name;
+            break;
+        default:
+            out << "%" << value->id;
+            break;
+    }
+}
+
+static void printBlockName(std::ostream &out, const BasicBlock *block)
+{
+    out << block->label << "." << block->id;
+}
+
+static void printInstruction(std::ostream &out, const Instruction *instruction)
+{
+    out << "    ";
+    if ( instruction->type != IR_VOID )
+    {
+        out << "%" << instruction->id << " = ";
+    }
+    out << opcodeName(instruction->opcode);
+    if ( instruction->opcode == OP_ICMP || instruction->opcode == OP_FCMP )
+    {
+        out << " " << predicateName(instruction->predicate) << " " << typeName(instruction->operands[ 0 ]->type);
+    }
+    else if ( instruction->type != IR_VOID )
+    {
+        out << " " << typeName(instruction->type);
+    }
+    if ( instruction->opcode == OP_FIELD_ADDRESS )
+    {
+        out << " ." << *dynamic_cast<NVariableDeclaration *>(instruction->field)->getVariableName();
+    }
+
+    const char *separator = " ";
+    if ( instruction->opcode == OP_PHI )
+    {
+        for ( size_t i = 0; i < instruction->operands.size(); i++ )
+        {
+            out << separator << "[ ";
+            printValue(out, instruction->operands[ i ]);
+            out << ", ";
+            printBlockName(out, instruction->targets[ i ]);
+            out << " ]";
+            separator = ", ";
+        }
+        out << std::endl;
+        return;
+    }
+    for ( auto operand: instruction->operands )
+    {
+        out << separator;
+        printValue(out, operand);
+        separator = ", ";
+    }
+    for ( auto target: instruction->targets )
+    {
+        out << separator;
+        printBlockName(out, target);
+        separator = ", ";
+    }
+    out << std::endl;
+}
+
+void stride::ir::printFunction(std::ostream &out, const Function *function)
+{
+    out << ( function->external ? "declare " : "define " ) << typeName(function->returnType)
+        << " @" << function->name << "(";
+    for ( size_t i = 0; i < function->arguments.size(); i++ )
+    {
+        out << ( i > 0 ? ", " : "" ) << typeName(function->arguments[ i ]->type) << " %" << function->arguments[ i ]->id;
+    }
+    out << ( function->variadic ? function->arguments.empty() ? "..." : ", ..." : "" ) << ")";
+    if ( function->external )
+    {
+        out << std::endl;
+        return;
+    }
+    out << " {" << std::endl;
+    for ( auto block: function->blocks )
+    {
+        printBlockName(out, block);
+        out << ":";
+        if ( !block->predecessors.empty())
+        {
+            out << "    ; from";
+            for ( auto predecessor: block->predecessors )
+            {
+                out << " ";
+                printBlockName(out, predecessor);
+            }
+        }
+        out << std::endl;
+        for ( auto instruction: block->instructions )
+        {
+            printInstruction(out, instruction);
+        }
+    }
+    out << "}" << std::endl;
+}
+
+void Module::print(std::ostream &out) const
+{
+    out << "; module " << this->name << std::endl;
+    for ( auto global: this->globals )
+    {
+        out << "@" << global->name << " = global " << typeName(global->valueType);
+        if ( global->initializer != nullptr )
+        {
+            out << " ";
+            printValue(out, global->initializer);
+        }
+        out << std::endl;
+    }
+    for ( auto function: this->functions )
+    {
+        out << std::endl;
+        printFunction(out, function);
+    }
+}
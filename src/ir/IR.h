@@ -0,0 +1,411 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_IR_H
+#define STRIDE_LANGUAGE_IR_H
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Arena.h"
+#include "../syntax_tree/ASTNodes.h"
+
+namespace stride::semantic
+{
+    struct Type;
+}
+
+namespace stride::ir
+{
+
+    /**
+     * The machine type of a value.
+     * Signedness isn't part of the type; operations that depend on it,
+     * such as division and comparison, have a signed and an unsigned variant.
+     */
+    enum EIRType : uint8_t
+    {
+        IR_VOID,
+        IR_BOOL,
+        IR_I8,
+        IR_I16,
+        IR_I32,
+        IR_I64,
+        IR_F32,
+        IR_F64,
+        IR_PTR  // References; strings, arrays, class instances, functions
+    };
+
+    /**
+     * Returns the name of a type, e.g. 'i32'.
+     */
+    const char *typeName(EIRType type);
+
+    /**
+     * Returns the size of a type in bytes.
+     */
+    uint32_t sizeOf(EIRType type);
+
+    /**
+     * Returns the symbol of a function or global, mangled as identifiers in the syntax tree are.
+     * Names in a module, such as 'io::print', become '__io__print'; other names are kept.
+     */
+    std::string mangle(const std::string &name);
+
+    [[nodiscard]] inline bool isFloat(EIRType type)
+    { return type == IR_F32 || type == IR_F64; }
+
+    [[nodiscard]] inline bool isInteger(EIRType type)
+    { return type >= IR_BOOL && type <= IR_I64; }
+
+    enum EValueKind
+    {
+        VALUE_CONSTANT,
+        VALUE_UNDEFINED, // A value that's read before it's assigned
+        VALUE_ARGUMENT,
+        VALUE_GLOBAL,    // The address of a global variable
+        VALUE_FUNCTION,  // The address of a function
+        VALUE_INSTRUCTION
+    };
+
+    enum EOpcode
+    {
+        OP_PHI,
+
+        OP_ADD, OP_SUB, OP_MUL, OP_SDIV, OP_UDIV, OP_SREM, OP_UREM,
+        OP_FADD, OP_FSUB, OP_FMUL, OP_FDIV, OP_FREM,
+        OP_SHL, OP_LSHR, OP_ASHR, OP_AND, OP_OR, OP_XOR,
+        OP_ICMP, OP_FCMP,
+
+        OP_TRUNC, OP_ZEXT, OP_SEXT, OP_FPTRUNC, OP_FPEXT, OP_SITOFP, OP_UITOFP, OP_FPTOSI, OP_FPTOUI,
+
+        OP_LOAD,          // Loads a value of the instruction's type from an address
+        OP_STORE,         // Stores operand 1 at address operand 0
+        OP_FIELD_ADDRESS, // The address of a field of the object operand 0 refers to
+        OP_ALLOCATE,      // Creates an instance of a class or structure, with the operands as arguments
+        OP_ARRAY,         // Creates an array of the operands
+        OP_CALL,          // Calls operand 0 with the remaining operands
+        OP_LANDING_PAD,   // The exception that's caught; the first instruction of a handler
+
+        // Terminators
+        OP_BRANCH,             // Continues at target 0
+        OP_CONDITIONAL_BRANCH, // Continues at target 0 if operand 0 is true, otherwise at target 1
+        OP_SWITCH,             // Continues at the target of the case operand 0 equals, or at target 0
+        OP_RETURN,
+        OP_INVOKE,             // Calls like OP_CALL; continues at target 0, or at target 1 if the call throws
+        OP_THROW,              // Throws operand 0 to target 0, or out of the function if there's no target
+        OP_UNREACHABLE
+    };
+
+    /**
+     * Returns the name of an opcode, e.g. 'add'.
+     */
+    const char *opcodeName(EOpcode opcode);
+
+    /**
+     * The comparison of OP_ICMP and OP_FCMP. The unprefixed orderings
+     * are signed for integers, and ordered for floats.
+     */
+    enum EPredicate : uint8_t
+    {
+        PREDICATE_EQ, PREDICATE_NE,
+        PREDICATE_LT, PREDICATE_LE, PREDICATE_GT, PREDICATE_GE,
+        PREDICATE_ULT, PREDICATE_ULE, PREDICATE_UGT, PREDICATE_UGE
+    };
+
+    const char *predicateName(EPredicate predicate);
+
+    class Instruction;
+
+    class BasicBlock;
+
+    class Function;
+
+    class Module;
+
+    /**
+     * A value in SSA form; it's defined once, and can be used by any number of instructions.
+     */
+    class Value
+    {
+    public:
+        EValueKind kind;
+        EIRType type;
+
+        /**
+         * The number of arguments and instructions, dense within their function.
+         * Analyses can use this to index arrays, rather than hash maps.
+         */
+        uint32_t id = 0;
+
+        /**
+         * The instructions that use this value, once per operand.
+         */
+        std::vector<Instruction *> users;
+
+        Value(EValueKind kind, EIRType type) : kind(kind), type(type)
+        {}
+
+        virtual ~Value() = default;
+
+        /**
+         * Replaces every use of this value by another value.
+         */
+        void replaceAllUsesWith(Value *replacement);
+
+        [[nodiscard]] bool isConstant() const
+        { return this->kind == VALUE_CONSTANT || this->kind == VALUE_UNDEFINED; }
+    };
+
+    /**
+     * A constant. Only the field that corresponds to the type is used;
+     * booleans and integers are stored in 'integer', sign extended.
+     */
+    class Constant : public Value
+    {
+    public:
+        int64_t integer = 0;
+        double floating = 0;
+
+        /**
+         * The contents of string constants, which are of type IR_PTR.
+         */
+        std::string string;
+        bool isString = false;
+
+        explicit Constant(EIRType type) : Value(VALUE_CONSTANT, type)
+        {}
+    };
+
+    class Argument : public Value
+    {
+    public:
+        Function *function;
+        uint32_t index;
+        std::string name;
+
+        Argument(Function *function, uint32_t index, EIRType type, std::string name) :
+                Value(VALUE_ARGUMENT, type), function(function), index(index), name(std::move(name))
+        {}
+    };
+
+    /**
+     * A global variable. As a value, it's the address of the variable.
+     */
+    class Global : public Value
+    {
+    public:
+        std::string name;
+        EIRType valueType;
+
+        /**
+         * The initial value, or nullptr if it's zero.
+         * Values that aren't constant are assigned by the module initializer.
+         */
+        Constant *initializer = nullptr;
+        ast::Node *declaration;
+
+        Global(std::string name, EIRType valueType, ast::Node *declaration) :
+                Value(VALUE_GLOBAL, IR_PTR), name(std::move(name)), valueType(valueType), declaration(declaration)
+        {}
+    };
+
+    /**
+     * An instruction. The meaning of the operands and targets depends on the opcode.
+     * Phi nodes have an operand per predecessor, with the predecessor at the same index
+     * in the targets. Terminators list their successors in the targets.
+     */
+    class Instruction : public Value
+    {
+    public:
+        EOpcode opcode;
+        EPredicate predicate = PREDICATE_EQ;
+        BasicBlock *block = nullptr;
+        std::vector<Value *> operands;
+        std::vector<BasicBlock *> targets;
+
+        /**
+         * The type that's allocated, or the element type of arrays.
+         */
+        const semantic::Type *allocated = nullptr;
+
+        /**
+         * The machine type of the elements of OP_ARRAY.
+         */
+        EIRType elementType = IR_VOID;
+
+        /**
+         * The declaration of the field of OP_FIELD_ADDRESS.
+         */
+        ast::Node *field = nullptr;
+
+        Instruction(EOpcode opcode, EIRType type) : Value(VALUE_INSTRUCTION, type), opcode(opcode)
+        {}
+
+        void addOperand(Value *value);
+
+        void setOperand(size_t index, Value *value);
+
+        /**
+         * Removes all operands, so this instruction no longer uses them.
+         */
+        void dropOperands();
+
+        /**
+         * Adds an incoming value to a phi node.
+         */
+        void addIncoming(Value *value, BasicBlock *predecessor);
+
+        /**
+         * Moves this instruction in front of another one, possibly in another block.
+         */
+        void moveBefore(Instruction *position);
+
+        [[nodiscard]] bool isTerminator() const
+        { return this->opcode >= OP_BRANCH; }
+
+        /**
+         * Whether the instruction may have an effect besides its result;
+         * it may not be removed if its result is unused.
+         */
+        [[nodiscard]] bool hasSideEffects() const;
+    };
+
+    class BasicBlock
+    {
+    public:
+        Function *function;
+        uint32_t id = 0;
+        std::string label;
+        std::vector<Instruction *> instructions;
+        std::vector<BasicBlock *> predecessors;
+
+        BasicBlock(Function *function, std::string label) : function(function), label(std::move(label))
+        {}
+
+        /**
+         * Returns the terminator, or nullptr if the block isn't terminated yet.
+         */
+        [[nodiscard]] Instruction *terminator() const
+        {
+            return !this->instructions.empty() && this->instructions.back()->isTerminator() ?
+                   this->instructions.back() : nullptr;
+        }
+
+        [[nodiscard]] const std::vector<BasicBlock *> &successors() const;
+
+        /**
+         * Removes an instruction from this block and drops its operands.
+         */
+        void erase(Instruction *instruction);
+
+        /**
+         * Removes one edge from a predecessor, and the value every phi node receives along it.
+         */
+        void removePredecessor(BasicBlock *predecessor);
+
+        /**
+         * Replaces a predecessor by another block, in the predecessors and in the phi nodes.
+         */
+        void replacePredecessor(BasicBlock *from, BasicBlock *to);
+    };
+
+    class Function : public Value
+    {
+    public:
+        std::string name;
+        EIRType returnType;
+        std::vector<Argument *> arguments;
+        std::vector<BasicBlock *> blocks;
+        ast::Node *declaration;
+        Module *module = nullptr;
+
+        /**
+         * Whether the function is defined in another compilation unit. These have no blocks.
+         */
+        bool external = false;
+        bool variadic = false;
+
+        /**
+         * The amount of ids given to arguments and instructions.
+         */
+        uint32_t valueCount = 0;
+
+        Function(std::string name, EIRType returnType, ast::Node *declaration) :
+                Value(VALUE_FUNCTION, IR_PTR), name(std::move(name)), returnType(returnType), declaration(declaration)
+        {}
+
+        [[nodiscard]] BasicBlock *entry() const
+        { return this->blocks.empty() ? nullptr : this->blocks.front(); }
+
+        /**
+         * Numbers the arguments, instructions and blocks densely, from zero, in order.
+         * This is needed after instructions or blocks were removed.
+         */
+        void renumber();
+
+        [[nodiscard]] size_t instructionCount() const;
+    };
+
+    /**
+     * The IR of a compilation unit. All values are allocated in its arena,
+     * and live as long as the module does.
+     */
+    class Module
+    {
+    private:
+        Arena valueArena;
+        std::map<std::pair<int, int64_t>, Constant *> integerConstants;
+        std::map<std::pair<int, double>, Constant *> floatConstants;
+        std::unordered_map<std::string, Constant *> stringConstants;
+        std::unordered_map<int, Value *> undefinedValues;
+        std::unordered_map<std::string, Function *> functionsByName;
+
+    public:
+        std::string name;
+        std::vector<Function *> functions;
+        std::vector<Global *> globals;
+
+        explicit Module(std::string name) : name(std::move(name))
+        {}
+
+        [[nodiscard]] Arena &arena()
+        { return this->valueArena; }
+
+        Constant *integer(EIRType type, int64_t value);
+
+        Constant *floating(EIRType type, double value);
+
+        Constant *string(const std::string &value);
+
+        Value *undefined(EIRType type);
+
+        /**
+         * Creates a function. Names of functions that were already created get a numeric suffix.
+         */
+        Function *createFunction(const std::string &name, EIRType returnType, ast::Node *declaration);
+
+        /**
+         * Returns the function with the provided name, or nullptr if there is none.
+         */
+        [[nodiscard]] Function *getFunction(const std::string &name) const;
+
+        Global *createGlobal(const std::string &name, EIRType valueType, ast::Node *declaration);
+
+        /**
+         * Prints the module in a textual form, e.g. <code>%3 = add i32 %1, %2</code>.
+         */
+        void print(std::ostream &out) const;
+    };
+
+    /**
+     * Prints a single function.
+     */
+    void printFunction(std::ostream &out, const Function *function);
+}
+
+#endif //STRIDE_LANGUAGE_IR_H
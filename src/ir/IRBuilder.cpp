@@ -0,0 +1,181 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include "IRBuilder.h"
+
+using namespace stride::ir;
+
+void IRBuilder::beginFunction(Function *target, const std::vector<std::pair<EIRType, std::string>> &arguments)
+{
+    this->function = target;
+    this->block = nullptr;
+    for ( auto &[ type, name ]: arguments )
+    {
+        auto argument = this->module.arena().create<Argument>(target, (uint32_t) target->arguments.size(), type, name);
+        argument->id = target->valueCount++;
+        target->arguments.push_back(argument);
+    }
+}
+
+BasicBlock *IRBuilder::createBlock(const std::string &label)
+{
+    return this->module.arena().create<BasicBlock>(this->function, label);
+}
+
+void IRBuilder::appendBlock(BasicBlock *target)
+{
+    target->id = (uint32_t) this->function->blocks.size();
+    this->function->blocks.push_back(target);
+}
+
+Instruction *IRBuilder::create(EOpcode opcode, EIRType type, const std::vector<Value *> &operands)
+{
+    auto instruction = this->module.arena().create<Instruction>(opcode, type);
+    instruction->id = this->function->valueCount++;
+    instruction->block = this->block;
+    for ( auto operand: operands )
+    {
+        instruction->addOperand(operand);
+    }
+    this->block->instructions.push_back(instruction);
+    return instruction;
+}
+
+Instruction *IRBuilder::terminate(EOpcode opcode, const std::vector<Value *> &operands,
+                                  const std::vector<BasicBlock *> &targets)
+{
+    Instruction *instruction = this->create(opcode, IR_VOID, operands);
+    instruction->targets = targets;
+    for ( auto target: targets )
+    {
+        target->predecessors.push_back(this->block);
+    }
+    return instruction;
+}
+
+Instruction *IRBuilder::phi(BasicBlock *target, EIRType type)
+{
+    auto instruction = this->module.arena().create<Instruction>(OP_PHI, type);
+    instruction->id = this->function->valueCount++;
+    instruction->block = target;
+
+    // Phi nodes precede all other instructions of their block.
+    auto position = target->instructions.begin();
+    while ( position != target->instructions.end() && ( *position )->opcode == OP_PHI )
+    {
+        ++position;
+    }
+    target->instructions.insert(position, instruction);
+    return instruction;
+}
+
+Instruction *IRBuilder::binary(EOpcode opcode, Value *left, Value *right)
+{
+    return this->create(opcode, left->type, { left, right });
+}
+
+Instruction *IRBuilder::compare(EPredicate predicate, Value *left, Value *right)
+{
+    Instruction *instruction = this->create(isFloat(left->type) ? OP_FCMP : OP_ICMP, IR_BOOL, { left, right });
+    instruction->predicate = predicate;
+    return instruction;
+}
+
+Instruction *IRBuilder::convert(EOpcode opcode, Value *value, EIRType type)
+{
+    return this->create(opcode, type, { value });
+}
+
+Instruction *IRBuilder::load(Value *address, EIRType type)
+{
+    return this->create(OP_LOAD, type, { address });
+}
+
+Instruction *IRBuilder::store(Value *address, Value *value)
+{
+    return this->create(OP_STORE, IR_VOID, { address, value });
+}
+
+Instruction *IRBuilder::fieldAddress(Value *object, ast::Node *field)
+{
+    Instruction *instruction = this->create(OP_FIELD_ADDRESS, IR_PTR, { object });
+    instruction->field = field;
+    return instruction;
+}
+
+Instruction *IRBuilder::allocate(const semantic::Type *type, const std::vector<Value *> &arguments)
+{
+    Instruction *instruction = this->create(OP_ALLOCATE, IR_PTR, arguments);
+    instruction->allocated = type;
+    return instruction;
+}
+
+Instruction *IRBuilder::array(const semantic::Type *element, EIRType elementType, const std::vector<Value *> &elements)
+{
+    Instruction *instruction = this->create(OP_ARRAY, IR_PTR, elements);
+    instruction->allocated = element;
+    instruction->elementType = elementType;
+    return instruction;
+}
+
+Instruction *IRBuilder::call(Value *callee, const std::vector<Value *> &arguments, EIRType type)
+{
+    Instruction *instruction = this->create(OP_CALL, type, { callee });
+    for ( auto argument: arguments )
+    {
+        instruction->addOperand(argument);
+    }
+    return instruction;
+}
+
+Instruction *IRBuilder::landingPad()
+{
+    return this->create(OP_LANDING_PAD, IR_PTR, {});
+}
+
+Instruction *IRBuilder::branch(BasicBlock *target)
+{
+    return this->terminate(OP_BRANCH, {}, { target });
+}
+
+Instruction *IRBuilder::conditionalBranch(Value *condition, BasicBlock *whenTrue, BasicBlock *whenFalse)
+{
+    return this->terminate(OP_CONDITIONAL_BRANCH, { condition }, { whenTrue, whenFalse });
+}
+
+Instruction *IRBuilder::switchOn(Value *value, BasicBlock *otherwise, const std::vector<Value *> &values,
+                                 const std::vector<BasicBlock *> &targets)
+{
+    std::vector<Value *> operands = { value };
+    operands.insert(operands.end(), values.begin(), values.end());
+    std::vector<BasicBlock *> successors = { otherwise };
+    successors.insert(successors.end(), targets.begin(), targets.end());
+    return this->terminate(OP_SWITCH, operands, successors);
+}
+
+Instruction *IRBuilder::ret(Value *value)
+{
+    return this->terminate(OP_RETURN, value != nullptr ? std::vector<Value *> { value } : std::vector<Value *> {}, {});
+}
+
+Instruction *IRBuilder::invoke(Value *callee, const std::vector<Value *> &arguments, EIRType type,
+                               BasicBlock *normal, BasicBlock *handler)
+{
+    std::vector<Value *> operands = { callee };
+    operands.insert(operands.end(), arguments.begin(), arguments.end());
+    Instruction *instruction = this->terminate(OP_INVOKE, operands, { normal, handler });
+    instruction->type = type;
+    return instruction;
+}
+
+Instruction *IRBuilder::throwValue(Value *exception, BasicBlock *handler)
+{
+    return this->terminate(OP_THROW, { exception },
+                           handler != nullptr ? std::vector<BasicBlock *> { handler } : std::vector<BasicBlock *> {});
+}
+
+Instruction *IRBuilder::unreachable()
+{
+    return this->terminate(OP_UNREACHABLE, {}, {});
+}
@@ -0,0 +1,115 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_IRBUILDER_H
+#define STRIDE_LANGUAGE_IRBUILDER_H
+
+#include "IR.h"
+
+namespace stride::ir
+{
+
+    /**
+     * Creates instructions at the end of a basic block.
+     * Instructions are numbered in order of creation. Terminators
+     * register their block as a predecessor of their targets.
+     */
+    class IRBuilder
+    {
+    private:
+        Module &module;
+        Function *function = nullptr;
+        BasicBlock *block = nullptr;
+
+        Instruction *create(EOpcode opcode, EIRType type, const std::vector<Value *> &operands);
+
+        Instruction *terminate(EOpcode opcode, const std::vector<Value *> &operands,
+                               const std::vector<BasicBlock *> &targets);
+
+    public:
+
+        explicit IRBuilder(Module &module) : module(module)
+        {}
+
+        /**
+         * Adds the arguments of a function, and starts adding blocks to it.
+         */
+        void beginFunction(Function *target, const std::vector<std::pair<EIRType, std::string>> &arguments);
+
+        [[nodiscard]] Function *getFunction() const
+        { return this->function; }
+
+        /**
+         * Creates a block of the current function. The block isn't part of the
+         * function until it's appended, so blocks that are never reached can be dropped.
+         */
+        BasicBlock *createBlock(const std::string &label);
+
+        /**
+         * Appends a block to the end of the current function.
+         */
+        void appendBlock(BasicBlock *target);
+
+        void setInsertPoint(BasicBlock *target)
+        { this->block = target; }
+
+        [[nodiscard]] BasicBlock *getInsertPoint() const
+        { return this->block; }
+
+        /**
+         * Whether the current block ends with a terminator, so no instructions can be added.
+         */
+        [[nodiscard]] bool isTerminated() const
+        { return this->block == nullptr || this->block->terminator() != nullptr; }
+
+        /**
+         * Creates an empty phi node at the start of a block.
+         */
+        Instruction *phi(BasicBlock *target, EIRType type);
+
+        Instruction *binary(EOpcode opcode, Value *left, Value *right);
+
+        Instruction *compare(EPredicate predicate, Value *left, Value *right);
+
+        /**
+         * Converts a value to another type, with a conversion opcode such as OP_SEXT.
+         */
+        Instruction *convert(EOpcode opcode, Value *value, EIRType type);
+
+        Instruction *load(Value *address, EIRType type);
+
+        Instruction *store(Value *address, Value *value);
+
+        Instruction *fieldAddress(Value *object, ast::Node *field);
+
+        Instruction *allocate(const semantic::Type *type, const std::vector<Value *> &arguments);
+
+        Instruction *array(const semantic::Type *element, EIRType elementType, const std::vector<Value *> &elements);
+
+        Instruction *call(Value *callee, const std::vector<Value *> &arguments, EIRType type);
+
+        Instruction *landingPad();
+
+        Instruction *branch(BasicBlock *target);
+
+        Instruction *conditionalBranch(Value *condition, BasicBlock *whenTrue, BasicBlock *whenFalse);
+
+        /**
+         * Creates a switch; the values are constants, each with the block at the same index.
+         */
+        Instruction *switchOn(Value *value, BasicBlock *otherwise, const std::vector<Value *> &values,
+                              const std::vector<BasicBlock *> &targets);
+
+        Instruction *ret(Value *value);
+
+        Instruction *invoke(Value *callee, const std::vector<Value *> &arguments, EIRType type,
+                            BasicBlock *normal, BasicBlock *handler);
+
+        Instruction *throwValue(Value *exception, BasicBlock *handler);
+
+        Instruction *unreachable();
+    };
+}
+
+#endif //STRIDE_LANGUAGE_IRBUILDER_H
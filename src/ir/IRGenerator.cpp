@@ -0,0 +1,1352 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include "IRGenerator.h"
+#include "../syntax_tree/NodeProperties.h"
+#include "../syntax_tree/node_types/definitions/NArray.h"
+#include "../syntax_tree/node_types/definitions/NBinaryOperation.h"
+#include "../syntax_tree/node_types/definitions/NClassDeclaration.h"
+#include "../syntax_tree/node_types/definitions/NConditionalStatement.h"
+#include "../syntax_tree/node_types/definitions/NDoWhileLoop.h"
+#include "../syntax_tree/node_types/definitions/NForLoop.h"
+#include "../syntax_tree/node_types/definitions/NFunctionCall.h"
+#include "../syntax_tree/node_types/definitions/NFunctionDeclaration.h"
+#include "../syntax_tree/node_types/definitions/NModuleDeclaration.h"
+#include "../syntax_tree/node_types/definitions/NReturnStatement.h"
+#include "../syntax_tree/node_types/definitions/NSwitchStatement.h"
+#include "../syntax_tree/node_types/definitions/NThrowStatement.h"
+#include "../syntax_tree/node_types/definitions/NTryCatchStatement.h"
+#include "../syntax_tree/node_types/definitions/NUnaryOperator.h"
+#include "../syntax_tree/node_types/definitions/NVariableDeclaration.h"
+
+using namespace stride;
+using namespace stride::ir;
+
+ir::Value *ast::Node::codegen(ir::IRGenerator &generator)
+{
+    return generator.generate(this);
+}
+
+IRGenerator::IRGenerator(StrideFile &file, const semantic::TypeChecker &checker, Module &module) :
+        file(file), checker(checker), module(module), builder(module)
+{}
+
+void IRGenerator::report(ast::Node *node, const std::string &message)
+{
+    int start = node != nullptr && node->hasSourceRange() ? node->getSourceStart() : 0;
+    int length = node != nullptr && node->hasSourceRange() ? node->getSourceEnd() - start : 0;
+    this->file.diagnostics().report(error::ERROR, start, length, message);
+}
+
+/**
+ * Returns the expression an expression node wraps, e.g. the '1' of '(1)'.
+ */
+static ast::Node *unwrap(ast::Node *node)
+{
+    while ( node != nullptr && node->getType() == ast::EXPRESSION && node->getChildCount() == 1 )
+    {
+        node = node->getChild(0);
+    }
+    return node;
+}
+
+EIRType IRGenerator::irTypeOf(const semantic::Type *type) const
+{
+    if ( type == nullptr )
+    {
+        return IR_VOID;
+    }
+    switch ( type->kind )
+    {
+        case semantic::TYPE_VOID:
+            return IR_VOID;
+        case semantic::TYPE_BOOL:
+            return IR_BOOL;
+        case semantic::TYPE_CHAR:
+            return IR_I8;
+        case semantic::TYPE_INTEGER:
+            return type->bits <= 8 ? IR_I8 : type->bits <= 16 ? IR_I16 : type->bits <= 32 ? IR_I32 : IR_I64;
+        case semantic::TYPE_FLOAT:
+            return type->bits <= 32 ? IR_F32 : IR_F64;
+        default:
+            return IR_PTR;
+    }
+}
+
+EIRType IRGenerator::irTypeOf(ast::Node *node) const
+{
+    switch ( node->getType())
+    {
+        case ast::VARIABLE_DECLARATION:
+            return this->irTypeOf(this->checker.typeOfDeclaration(node));
+        case ast::FUNCTION_DECLARATION:
+            return IR_PTR;
+        default:
+            return this->irTypeOf(this->checker.typeOf(node));
+    }
+}
+
+bool IRGenerator::isSigned(ast::Node *node) const
+{
+    const semantic::Type *type = this->checker.typeOf(node);
+    return type != nullptr && type->kind == semantic::TYPE_INTEGER && type->isSigned;
+}
+
+std::string IRGenerator::qualify(const std::string &name) const
+{
+    std::string qualified;
+    for ( auto &scope: this->scopeNames )
+    {
+        qualified.append(scope).append("::");
+    }
+    return qualified.append(name);
+}
+
+Value *IRGenerator::convert(Value *value, EIRType type, bool isSigned)
+{
+    if ( value->type == type || type == IR_VOID )
+    {
+        return value;
+    }
+    if ( isInteger(value->type) && isInteger(type))
+    {
+        if ( sizeOf(type) < sizeOf(value->type) || ( sizeOf(type) == sizeOf(value->type) && type == IR_BOOL ))
+        {
+            return this->builder.convert(OP_TRUNC, value, type);
+        }
+        return this->builder.convert(isSigned && value->type != IR_BOOL ? OP_SEXT : OP_ZEXT, value, type);
+    }
+    if ( isInteger(value->type) && isFloat(type))
+    {
+        return this->builder.convert(isSigned ? OP_SITOFP : OP_UITOFP, value, type);
+    }
+    if ( isFloat(value->type) && isInteger(type))
+    {
+        return this->builder.convert(isSigned ? OP_FPTOSI : OP_FPTOUI, value, type);
+    }
+    if ( isFloat(value->type) && isFloat(type))
+    {
+        return this->builder.convert(type == IR_F64 ? OP_FPEXT : OP_FPTRUNC, value, type);
+    }
+    return value;
+}
+
+Function *IRGenerator::runtimeFunction(const std::string &name, EIRType returnType)
+{
+    Function *function = this->module.getFunction(name);
+    if ( function == nullptr )
+    {
+        function = this->module.createFunction(name, returnType, nullptr);
+        function->external = true;
+        function->variadic = true;
+    }
+    return function;
+}
+
+Function *IRGenerator::importedFunction(NFunctionDeclaration *declaration, const std::string &name)
+{
+    Function *function = this->module.getFunction(name);
+    if ( function != nullptr )
+    {
+        return function;
+    }
+
+    // The builder is in the middle of a function, so the arguments are created here rather than by beginFunction.
+    const semantic::Type *type = this->checker.typeOfDeclaration(declaration);
+    function = this->module.createFunction(name, this->irTypeOf(type != nullptr ? type->element : nullptr), nullptr);
+    function->external = true;
+    for ( auto parameter: declaration->arguments )
+    {
+        if ( parameter->isVariadicParameter())
+        {
+            function->variadic = true;
+            continue;
+        }
+        auto argument = this->module.arena().create<Argument>(function, (uint32_t) function->arguments.size(),
+                                                              this->irTypeOf(parameter), *parameter->getVariableName());
+        argument->id = function->valueCount++;
+        function->arguments.push_back(argument);
+    }
+    return function;
+}
+
+/**
+ * Returns a mangled name as it's written in source, e.g. 'outer::function'.
+ */
+static std::string writtenName(const std::string &name)
+{
+    std::string written;
+    for ( auto &segment: ast::splitIdentifier(name))
+    {
+        written.append(written.empty() ? "" : "::").append(segment);
+    }
+    return written;
+}
+
+// SSA construction
+
+void IRGenerator::define(ast::Node *variable, BasicBlock *block, Value *value)
+{
+    this->definitions[ block ][ variable ] = value;
+}
+
+Value *IRGenerator::use(ast::Node *variable, BasicBlock *block)
+{
+    auto &blockDefinitions = this->definitions[ block ];
+    auto definition = blockDefinitions.find(variable);
+    if ( definition == blockDefinitions.end())
+    {
+        return this->useRecursive(variable, block);
+    }
+
+    // Definitions may refer to phi nodes that were removed since.
+    Value *value = definition->second;
+    for ( auto replaced = this->replacedPhis.find(value); replaced != this->replacedPhis.end();
+          replaced = this->replacedPhis.find(value))
+    {
+        value = replaced->second;
+    }
+    return value;
+}
+
+Value *IRGenerator::useRecursive(ast::Node *variable, BasicBlock *block)
+{
+    EIRType type = this->localTypes[ variable ];
+    Value *value;
+    if ( this->sealedBlocks.count(block) == 0 )
+    {
+        // Not all predecessors are known yet; the operands are added once they are.
+        Instruction *phi = this->builder.phi(block, type);
+        this->incompletePhis[ block ].emplace_back(variable, phi);
+        value = phi;
+    }
+    else if ( block->predecessors.size() == 1 )
+    {
+        value = this->use(variable, block->predecessors[ 0 ]);
+    }
+    else if ( block->predecessors.empty())
+    {
+        value = this->module.undefined(type);
+    }
+    else
+    {
+        // The phi node is defined first, so cycles through the predecessors end at it.
+        Instruction *phi = this->builder.phi(block, type);
+        this->define(variable, block, phi);
+        value = this->addPhiOperands(variable, phi);
+    }
+    this->define(variable, block, value);
+    return value;
+}
+
+Value *IRGenerator::addPhiOperands(ast::Node *variable, Instruction *phi)
+{
+    for ( auto predecessor: phi->block->predecessors )
+    {
+        phi->addIncoming(this->use(variable, predecessor), predecessor);
+    }
+    return this->removeTrivialPhi(phi);
+}
+
+Value *IRGenerator::removeTrivialPhi(Instruction *phi)
+{
+    Value *same = nullptr;
+    for ( auto operand: phi->operands )
+    {
+        if ( operand == same || operand == phi )
+        {
+            continue;
+        }
+        if ( same != nullptr )
+        {
+            // The phi node merges different values.
+            return phi;
+        }
+        same = operand;
+    }
+    if ( same == nullptr )
+    {
+        same = this->module.undefined(phi->type);
+    }
+
+    std::vector<Instruction *> users;
+    for ( auto user: phi->users )
+    {
+        if ( user != phi )
+        {
+            users.push_back(user);
+        }
+    }
+    phi->replaceAllUsesWith(same);
+    phi->block->erase(phi);
+    this->replacedPhis[ phi ] = same;
+
+    // Phi nodes that used this one may have become trivial as well. Those of unsealed
+    // blocks are incomplete, and are checked once their block is sealed.
+    for ( auto user: users )
+    {
+        if ( user->opcode == OP_PHI && user->block != nullptr && this->sealedBlocks.count(user->block) > 0 )
+        {
+            this->removeTrivialPhi(user);
+        }
+    }
+    return same;
+}
+
+void IRGenerator::seal(BasicBlock *block)
+{
+    auto incomplete = this->incompletePhis.find(block);
+    if ( incomplete != this->incompletePhis.end())
+    {
+        for ( auto &[ variable, phi ]: incomplete->second )
+        {
+            this->addPhiOperands(variable, phi);
+        }
+        this->incompletePhis.erase(incomplete);
+    }
+    this->sealedBlocks.insert(block);
+}
+
+void IRGenerator::enter(BasicBlock *block)
+{
+    if ( block == nullptr || block->predecessors.empty())
+    {
+        this->builder.setInsertPoint(nullptr);
+        return;
+    }
+    this->builder.appendBlock(block);
+    this->builder.setInsertPoint(block);
+}
+
+// Variables
+
+Value *IRGenerator::addressOf(ast::Node *variable)
+{
+    auto global = this->globals.find(variable);
+    if ( global != this->globals.end())
+    {
+        return global->second;
+    }
+    auto owner = this->fieldOwners.find(variable);
+    if ( owner != this->fieldOwners.end() && this->self != nullptr && owner->second == this->currentClass )
+    {
+        return this->builder.fieldAddress(this->self, variable);
+    }
+    return nullptr;
+}
+
+Value *IRGenerator::readVariable(ast::Node *variable)
+{
+    if ( this->localTypes.count(variable) > 0 )
+    {
+        return this->use(variable, this->builder.getInsertPoint());
+    }
+    Value *address = this->addressOf(variable);
+    if ( address != nullptr )
+    {
+        return this->builder.load(address, this->irTypeOf(variable));
+    }
+    return this->module.undefined(this->irTypeOf(variable));
+}
+
+void IRGenerator::writeVariable(ast::Node *variable, Value *value)
+{
+    if ( this->localTypes.count(variable) > 0 )
+    {
+        this->define(variable, this->builder.getInsertPoint(), value);
+        return;
+    }
+    Value *address = this->addressOf(variable);
+    if ( address != nullptr )
+    {
+        this->builder.store(address, value);
+    }
+}
+
+// Declarations
+
+void IRGenerator::declare(ast::Node *node)
+{
+    switch ( node->getType())
+    {
+        case ast::MODULE_DECLARATION:
+        {
+            auto module = dynamic_cast<NModuleDeclaration *>(node);
+            this->scopeNames.push_back(module->getModuleName());
+            if ( module->getBody() != nullptr )
+            {
+                this->declare(module->getBody());
+            }
+            this->scopeNames.pop_back();
+        }
+            break;
+
+        case ast::CLASS_DECLARATION:
+        {
+            auto declaration = dynamic_cast<NClassDeclaration *>(node);
+            if ( !declaration->getGenerics().empty() || declaration->getBody() == nullptr )
+            {
+                break;
+            }
+            ast::Node *enclosingClass = this->declaringClass;
+            this->declaringClass = declaration;
+            this->scopeNames.push_back(declaration->getClassName());
+            this->declare(declaration->getBody());
+            this->scopeNames.pop_back();
+            this->declaringClass = enclosingClass;
+        }
+            break;
+
+        case ast::FUNCTION_DECLARATION:
+        {
+            auto declaration = dynamic_cast<NFunctionDeclaration *>(node);
+            const semantic::Type *type = this->checker.typeOfDeclaration(declaration);
+            Function *function = this->module.createFunction(this->qualify(declaration->functionName->name),
+                                                             this->irTypeOf(type != nullptr ? type->element : nullptr),
+                                                             declaration);
+            function->external = declaration->external;
+
+            std::vector<std::pair<EIRType, std::string>> arguments;
+            if ( this->declaringClass != nullptr )
+            {
+                this->methodOwners[ declaration ] = this->declaringClass;
+                arguments.emplace_back(IR_PTR, "this");
+            }
+            for ( auto parameter: declaration->arguments )
+            {
+                if ( parameter->isVariadicParameter())
+                {
+                    function->variadic = true;
+                    continue;
+                }
+                arguments.emplace_back(this->irTypeOf(parameter), *parameter->getVariableName());
+            }
+            this->builder.beginFunction(function, arguments);
+            this->functions[ declaration ] = function;
+            this->pendingFunctions.push_back(declaration);
+        }
+            break;
+
+        case ast::VARIABLE_DECLARATION:
+        {
+            auto variable = dynamic_cast<NVariableDeclaration *>(node);
+            if ( this->declaringClass != nullptr )
+            {
+                this->fieldOwners[ variable ] = this->declaringClass;
+                break;
+            }
+            Global *global = this->module.createGlobal(this->qualify(*variable->getVariableName()),
+                                                       this->irTypeOf(variable), variable);
+            this->globals[ variable ] = global;
+
+            ast::Node *value = unwrap(variable->getValue());
+            if ( value == nullptr )
+            {
+                break;
+            }
+            auto literal = dynamic_cast<NLiteral *>(value);
+            if ( literal != nullptr && !std::holds_alternative<const char *>(literal->value) && isInteger(global->valueType))
+            {
+                global->initializer = this->module.integer(global->valueType, std::get<int64_t>(literal->value));
+            }
+            else if ( literal != nullptr && std::holds_alternative<double_t>(literal->value) && isFloat(global->valueType))
+            {
+                global->initializer = this->module.floating(global->valueType, std::get<double_t>(literal->value));
+            }
+            else if ( literal != nullptr && std::holds_alternative<const char *>(literal->value))
+            {
+                global->initializer = this->module.string(std::get<const char *>(literal->value));
+            }
+            else
+            {
+                this->pendingInitializers.push_back(variable);
+            }
+        }
+            break;
+
+        case ast::STRUCTURE_DECLARATION:
+        case ast::ENUMERABLE_DECLARATION:
+        case ast::IMPORT_STATEMENT:
+            break;
+
+        case ast::GENERIC:
+        case ast::BLOCK:
+            for ( size_t i = 0; i < node->getChildCount(); i++ )
+            {
+                this->declare(node->getChild(i));
+            }
+            break;
+
+        default:
+            // Statements outside of functions are executed by the module initializer.
+            if ( this->declaringClass == nullptr )
+            {
+                this->pendingInitializers.push_back(node);
+            }
+            break;
+    }
+}
+
+Value *IRGenerator::generate(ast::Node *node)
+{
+    if ( this->builder.getInsertPoint() != nullptr )
+    {
+        if ( dynamic_cast<NExpression *>(node) != nullptr )
+        {
+            return this->lowerExpression(node);
+        }
+        this->lowerStatement(node);
+        return nullptr;
+    }
+
+    this->declare(node);
+    for ( size_t i = 0; i < this->pendingFunctions.size(); i++ )
+    {
+        this->lowerFunction(this->pendingFunctions[ i ]);
+    }
+    this->pendingFunctions.clear();
+    this->lowerInitializer();
+    return nullptr;
+}
+
+/**
+ * Resets the state of the function that's lowered.
+ */
+#define RESET_FUNCTION_STATE()            \
+    this->handlers.clear();               \
+    this->definitions.clear();            \
+    this->incompletePhis.clear();         \
+    this->sealedBlocks.clear();           \
+    this->localTypes.clear();             \
+    this->replacedPhis.clear()
+
+void IRGenerator::lowerFunction(NFunctionDeclaration *declaration)
+{
+    Function *function = this->functions[ declaration ];
+    if ( function->external )
+    {
+        return;
+    }
+
+    RESET_FUNCTION_STATE();
+    this->builder.beginFunction(function, {});
+    this->returnType = function->returnType;
+    auto owner = this->methodOwners.find(declaration);
+    this->currentClass = owner != this->methodOwners.end() ? owner->second : nullptr;
+    this->self = this->currentClass != nullptr ? function->arguments[ 0 ] : nullptr;
+
+    BasicBlock *entry = this->builder.createBlock("entry");
+    this->builder.appendBlock(entry);
+    this->builder.setInsertPoint(entry);
+    this->seal(entry);
+
+    size_t argument = this->self != nullptr ? 1 : 0;
+    for ( auto parameter: declaration->arguments )
+    {
+        if ( parameter->isVariadicParameter())
+        {
+            continue;
+        }
+        this->localTypes[ parameter ] = this->irTypeOf(parameter);
+        this->define(parameter, entry, function->arguments[ argument++ ]);
+    }
+
+    if ( declaration->body != nullptr )
+    {
+        this->lowerBlock(declaration->body);
+    }
+    if ( this->builder.getInsertPoint() != nullptr && !this->builder.isTerminated())
+    {
+        this->builder.ret(this->returnType == IR_VOID ? nullptr : this->module.undefined(this->returnType));
+    }
+
+    function->renumber();
+    this->builder.setInsertPoint(nullptr);
+    this->self = nullptr;
+    this->currentClass = nullptr;
+}
+
+void IRGenerator::lowerInitializer()
+{
+    if ( this->pendingInitializers.empty())
+    {
+        return;
+    }
+
+    RESET_FUNCTION_STATE();
+    Function *function = this->module.createFunction(MODULE_INITIALIZER_NAME, IR_VOID, nullptr);
+    this->builder.beginFunction(function, {});
+    this->returnType = IR_VOID;
+    BasicBlock *entry = this->builder.createBlock("entry");
+    this->builder.appendBlock(entry);
+    this->builder.setInsertPoint(entry);
+    this->seal(entry);
+
+    for ( auto node: this->pendingInitializers )
+    {
+        if ( this->builder.getInsertPoint() == nullptr )
+        {
+            break;
+        }
+        auto global = this->globals.find(node);
+        if ( global != this->globals.end())
+        {
+            Value *value = this->lowerExpression(dynamic_cast<NVariableDeclaration *>(node)->getValue());
+            if ( value != nullptr && this->builder.getInsertPoint() != nullptr )
+            {
+                this->builder.store(global->second, value);
+            }
+            continue;
+        }
+        this->lowerStatement(node);
+    }
+    if ( this->builder.getInsertPoint() != nullptr && !this->builder.isTerminated())
+    {
+        this->builder.ret(nullptr);
+    }
+    function->renumber();
+    this->builder.setInsertPoint(nullptr);
+    this->pendingInitializers.clear();
+}
+
+// Statements
+
+void IRGenerator::lowerBlock(ast::Node *block)
+{
+    for ( size_t i = 0; i < block->getChildCount() && this->builder.getInsertPoint() != nullptr; i++ )
+    {
+        this->lowerStatement(block->getChild(i));
+    }
+}
+
+void IRGenerator::lowerStatement(ast::Node *node)
+{
+    switch ( node->getType())
+    {
+        case ast::VARIABLE_DECLARATION:
+        {
+            auto variable = dynamic_cast<NVariableDeclaration *>(node);
+            EIRType type = this->irTypeOf(variable);
+            Value *value = variable->getValue() != nullptr ? this->lowerExpression(variable->getValue()) : nullptr;
+            if ( this->builder.getInsertPoint() == nullptr )
+            {
+                break;
+            }
+            this->localTypes[ variable ] = type;
+            this->define(variable, this->builder.getInsertPoint(),
+                         value != nullptr ? value : this->module.undefined(type));
+        }
+            break;
+
+        case ast::BLOCK:
+            this->lowerBlock(node);
+            break;
+
+        case ast::CONDITIONAL_STATEMENT:
+            this->lowerConditional(node);
+            break;
+
+        case ast::WHILE_LOOP:
+        case ast::DO_WHILE_LOOP:
+        case ast::FOR_LOOP:
+            this->lowerLoop(dynamic_cast<NWhileLoop *>(node));
+            break;
+
+        case ast::SWITCH_STATEMENT:
+            this->lowerSwitch(dynamic_cast<NSwitchStatement *>(node));
+            break;
+
+        case ast::TRY_CATCH_CLAUSE:
+            this->lowerTryCatch(dynamic_cast<NTryCatchStatement *>(node));
+            break;
+
+        case ast::RETURN_STATEMENT:
+        {
+            auto statement = dynamic_cast<NReturnStatement *>(node);
+            Value *value = statement->getExpression() != nullptr ? this->lowerExpression(statement->getExpression()) : nullptr;
+            if ( this->builder.getInsertPoint() == nullptr )
+            {
+                break;
+            }
+            if ( value == nullptr && this->returnType != IR_VOID )
+            {
+                value = this->module.undefined(this->returnType);
+            }
+            this->builder.ret(this->returnType == IR_VOID ? nullptr : value);
+            this->builder.setInsertPoint(nullptr);
+        }
+            break;
+
+        case ast::THROW_STATEMENT:
+        {
+            auto statement = dynamic_cast<NThrowStatement *>(node);
+            Value *exception = statement->expression != nullptr ? this->lowerExpression(statement->expression) : nullptr;
+            if ( this->builder.getInsertPoint() == nullptr )
+            {
+                break;
+            }
+            this->builder.throwValue(exception != nullptr ? exception : this->module.undefined(IR_PTR),
+                                     this->handlers.empty() ? nullptr : this->handlers.back());
+            this->builder.setInsertPoint(nullptr);
+        }
+            break;
+
+        case ast::FUNCTION_DECLARATION:
+        case ast::CLASS_DECLARATION:
+        case ast::STRUCTURE_DECLARATION:
+        case ast::ENUMERABLE_DECLARATION:
+        case ast::MODULE_DECLARATION:
+        case ast::IMPORT_STATEMENT:
+            // Declarations are lowered by themselves.
+            break;
+
+        default:
+            this->lowerExpression(node);
+            break;
+    }
+}
+
+void IRGenerator::lowerConditional(ast::Node *node)
+{
+    auto statement = dynamic_cast<NConditionalStatement *>(node);
+    BasicBlock *then = this->builder.createBlock("if.then");
+    BasicBlock *otherwise = statement->getElse() != nullptr ? this->builder.createBlock("if.else") : nullptr;
+    BasicBlock *end = this->builder.createBlock("if.end");
+
+    this->lowerCondition(statement->getCondition(), then, otherwise != nullptr ? otherwise : end);
+
+    this->seal(then);
+    this->enter(then);
+    if ( statement->getThen() != nullptr && this->builder.getInsertPoint() != nullptr )
+    {
+        this->lowerBlock(statement->getThen());
+    }
+    if ( this->builder.getInsertPoint() != nullptr )
+    {
+        this->builder.branch(end);
+    }
+
+    if ( otherwise != nullptr )
+    {
+        this->seal(otherwise);
+        this->enter(otherwise);
+        if ( this->builder.getInsertPoint() != nullptr )
+        {
+            this->lowerBlock(statement->getElse());
+            if ( this->builder.getInsertPoint() != nullptr )
+            {
+                this->builder.branch(end);
+            }
+        }
+    }
+
+    this->seal(end);
+    this->enter(end);
+}
+
+void IRGenerator::lowerLoop(NWhileLoop *loop)
+{
+    if ( loop->getType() == ast::DO_WHILE_LOOP )
+    {
+        // The body runs before the condition is tested.
+        BasicBlock *body = this->builder.createBlock("do.body");
+        BasicBlock *condition = this->builder.createBlock("do.cond");
+        BasicBlock *end = this->builder.createBlock("do.end");
+        this->builder.branch(body);
+        this->enter(body);
+        if ( loop->body != nullptr )
+        {
+            this->lowerBlock(loop->body);
+        }
+        if ( this->builder.getInsertPoint() != nullptr )
+        {
+            this->builder.branch(condition);
+        }
+        this->seal(condition);
+        this->enter(condition);
+        if ( this->builder.getInsertPoint() != nullptr )
+        {
+            this->lowerCondition(loop->condition, body, end);
+        }
+        this->seal(body);
+        this->seal(end);
+        this->enter(end);
+        return;
+    }
+
+    auto forLoop = loop->getType() == ast::FOR_LOOP ? dynamic_cast<NForLoop *>(loop) : nullptr;
+    if ( forLoop != nullptr )
+    {
+        for ( auto initializer: forLoop->getInitializers())
+        {
+            this->lowerStatement(initializer);
+        }
+        if ( this->builder.getInsertPoint() == nullptr )
+        {
+            return;
+        }
+    }
+
+    // The header isn't sealed until the body branches back to it.
+    BasicBlock *header = this->builder.createBlock(forLoop != nullptr ? "for.cond" : "while.cond");
+    BasicBlock *body = this->builder.createBlock(forLoop != nullptr ? "for.body" : "while.body");
+    BasicBlock *end = this->builder.createBlock(forLoop != nullptr ? "for.end" : "while.end");
+    this->builder.branch(header);
+    this->enter(header);
+    if ( loop->condition != nullptr )
+    {
+        this->lowerCondition(loop->condition, body, end);
+    }
+    else if ( this->builder.getInsertPoint() != nullptr )
+    {
+        this->builder.branch(body);
+    }
+
+    this->seal(body);
+    this->enter(body);
+    if ( loop->body != nullptr && this->builder.getInsertPoint() != nullptr )
+    {
+        this->lowerBlock(loop->body);
+    }
+    if ( forLoop != nullptr && !forLoop->getIncrementors().empty() && this->builder.getInsertPoint() != nullptr )
+    {
+        BasicBlock *step = this->builder.createBlock("for.step");
+        this->builder.branch(step);
+        this->seal(step);
+        this->enter(step);
+        for ( auto incrementor: forLoop->getIncrementors())
+        {
+            this->lowerStatement(incrementor);
+        }
+    }
+    if ( this->builder.getInsertPoint() != nullptr )
+    {
+        this->builder.branch(header);
+    }
+
+    this->seal(header);
+    this->seal(end);
+    this->enter(end);
+}
+
+void IRGenerator::lowerSwitch(NSwitchStatement *statement)
+{
+    Value *value = statement->getExpression() != nullptr ? this->lowerExpression(statement->getExpression()) : nullptr;
+    if ( this->builder.getInsertPoint() == nullptr || value == nullptr )
+    {
+        return;
+    }
+
+    BasicBlock *end = this->builder.createBlock("switch.end");
+    BasicBlock *otherwise = statement->getDefaultCase() != nullptr ? this->builder.createBlock("switch.default") : end;
+    std::vector<BasicBlock *> caseBlocks;
+    std::vector<Value *> values;
+    std::vector<BasicBlock *> targets;
+    for ( auto switchCase: statement->getCases())
+    {
+        caseBlocks.push_back(this->builder.createBlock("switch.case"));
+        for ( auto caseValue: switchCase->values )
+        {
+            values.push_back(this->lowerExpression(caseValue));
+            targets.push_back(caseBlocks.back());
+        }
+    }
+    const semantic::Type *type = this->checker.typeOf(statement->getExpression());
+    if ( type != nullptr && type->kind == semantic::TYPE_STRING )
+    {
+        // Strings are compared by their contents, so their cases are tested one after the other.
+        for ( size_t i = 0; i < values.size() && this->builder.getInsertPoint() != nullptr; i++ )
+        {
+            Value *order = this->emitCall(this->runtimeFunction("__stride_string_compare", IR_I32),
+                                          { value, values[ i ] }, IR_I32);
+            BasicBlock *next = i + 1 < values.size() ? this->builder.createBlock("switch.test") : otherwise;
+            this->builder.conditionalBranch(
+                    this->builder.compare(PREDICATE_EQ, order, this->module.integer(IR_I32, 0)), targets[ i ], next);
+            if ( next != otherwise )
+            {
+                this->seal(next);
+                this->enter(next);
+            }
+        }
+        if ( values.empty())
+        {
+            this->builder.branch(otherwise);
+        }
+    }
+    else
+    {
+        this->builder.switchOn(value, otherwise, values, targets);
+    }
+
+    std::vector<std::pair<NSwitchCase *, BasicBlock *>> bodies;
+    for ( size_t i = 0; i < caseBlocks.size(); i++ )
+    {
+        bodies.emplace_back(statement->getCases()[ i ], caseBlocks[ i ]);
+    }
+    if ( statement->getDefaultCase() != nullptr )
+    {
+        bodies.emplace_back(statement->getDefaultCase(), otherwise);
+    }
+    for ( auto &[ switchCase, block ]: bodies )
+    {
+        this->seal(block);
+        this->enter(block);
+        if ( switchCase->body != nullptr && this->builder.getInsertPoint() != nullptr )
+        {
+            this->lowerBlock(switchCase->body);
+        }
+        if ( this->builder.getInsertPoint() != nullptr )
+        {
+            this->builder.branch(end);
+        }
+    }
+
+    this->seal(end);
+    this->enter(end);
+}
+
+void IRGenerator::lowerTryCatch(NTryCatchStatement *statement)
+{
+    BasicBlock *handler = this->builder.createBlock("catch");
+    BasicBlock *end = this->builder.createBlock("try.end");
+
+    // Calls and throws in the try block continue at the handler, which isn't sealed until they're all lowered.
+    this->handlers.push_back(handler);
+    if ( statement->getTryBlock() != nullptr )
+    {
+        this->lowerBlock(statement->getTryBlock());
+    }
+    if ( this->builder.getInsertPoint() != nullptr )
+    {
+        this->builder.branch(end);
+    }
+    this->handlers.pop_back();
+
+    this->seal(handler);
+    this->enter(handler);
+    if ( this->builder.getInsertPoint() != nullptr )
+    {
+        Instruction *exception = this->builder.landingPad();
+        if ( statement->getException() != nullptr )
+        {
+            this->localTypes[ statement->getException() ] = IR_PTR;
+            this->define(statement->getException(), handler, exception);
+        }
+        if ( statement->getCatchBlock() != nullptr )
+        {
+            this->lowerBlock(statement->getCatchBlock());
+        }
+        if ( this->builder.getInsertPoint() != nullptr )
+        {
+            this->builder.branch(end);
+        }
+    }
+
+    this->seal(end);
+    this->enter(end);
+}
+
+// Expressions
+
+void IRGenerator::lowerCondition(ast::Node *condition, BasicBlock *whenTrue, BasicBlock *whenFalse)
+{
+    ast::Node *node = unwrap(condition);
+    auto binary = dynamic_cast<NBinaryOperation *>(node);
+    if ( binary != nullptr && ( binary->operation == AND || binary->operation == OR ))
+    {
+        // The right operand is only evaluated if the left one doesn't decide the result.
+        BasicBlock *right = this->builder.createBlock(binary->operation == AND ? "and.rhs" : "or.rhs");
+        if ( binary->operation == AND )
+        {
+            this->lowerCondition(binary->left, right, whenFalse);
+        }
+        else
+        {
+            this->lowerCondition(binary->left, whenTrue, right);
+        }
+        this->seal(right);
+        this->enter(right);
+        if ( this->builder.getInsertPoint() != nullptr )
+        {
+            this->lowerCondition(binary->right, whenTrue, whenFalse);
+        }
+        return;
+    }
+    auto unary = dynamic_cast<NUnaryOperator *>(node);
+    if ( unary != nullptr && unary->operation == NEGATE )
+    {
+        this->lowerCondition(unary->expression.get(), whenFalse, whenTrue);
+        return;
+    }
+
+    Value *value = this->lowerExpression(node);
+    if ( this->builder.getInsertPoint() != nullptr )
+    {
+        this->builder.conditionalBranch(value != nullptr ? value : this->module.undefined(IR_BOOL), whenTrue, whenFalse);
+    }
+}
+
+Value *IRGenerator::lowerShortCircuit(ast::Node *node)
+{
+    BasicBlock *whenTrue = this->builder.createBlock("bool.true");
+    BasicBlock *whenFalse = this->builder.createBlock("bool.false");
+    BasicBlock *end = this->builder.createBlock("bool.end");
+    this->lowerCondition(node, whenTrue, whenFalse);
+    for ( auto block: { whenTrue, whenFalse } )
+    {
+        this->seal(block);
+        this->enter(block);
+        if ( this->builder.getInsertPoint() != nullptr )
+        {
+            this->builder.branch(end);
+        }
+    }
+    this->seal(end);
+    this->enter(end);
+    if ( this->builder.getInsertPoint() == nullptr )
+    {
+        return nullptr;
+    }
+
+    Instruction *phi = this->builder.phi(end, IR_BOOL);
+    for ( auto predecessor: end->predecessors )
+    {
+        phi->addIncoming(this->module.integer(IR_BOOL, predecessor == whenTrue), predecessor);
+    }
+    return phi;
+}
+
+Value *IRGenerator::emitCall(Value *callee, const std::vector<Value *> &arguments, EIRType type)
+{
+    if ( this->handlers.empty())
+    {
+        Instruction *call = this->builder.call(callee, arguments, type);
+        return type == IR_VOID ? nullptr : call;
+    }
+
+    // A call that may throw ends the block; an exception continues at the handler.
+    BasicBlock *normal = this->builder.createBlock("invoke.cont");
+    Instruction *invoke = this->builder.invoke(callee, arguments, type, normal, this->handlers.back());
+    this->seal(normal);
+    this->enter(normal);
+    return type == IR_VOID ? nullptr : invoke;
+}
+
+Value *IRGenerator::lowerCall(NFunctionCall *call)
+{
+    std::vector<Value *> arguments;
+    auto method = call->declaration != nullptr ? this->methodOwners.find(call->declaration) : this->methodOwners.end();
+    if ( method != this->methodOwners.end())
+    {
+        arguments.push_back(this->self != nullptr ? this->self : this->module.undefined(IR_PTR));
+    }
+    for ( auto argument: call->arguments )
+    {
+        Value *value = this->lowerExpression(argument);
+        if ( this->builder.getInsertPoint() == nullptr )
+        {
+            return nullptr;
+        }
+        arguments.push_back(value != nullptr ? value : this->module.undefined(IR_PTR));
+    }
+
+    EIRType type = this->irTypeOf(call);
+    ast::Node *declaration = call->declaration;
+    if ( declaration != nullptr && ( declaration->getType() == ast::CLASS_DECLARATION ||
+                                     declaration->getType() == ast::STRUCTURE_DECLARATION ))
+    {
+        return this->builder.allocate(this->checker.typeOf(call), arguments);
+    }
+
+    Value *callee;
+    if ( declaration != nullptr && this->functions.count(declaration) > 0 )
+    {
+        callee = this->functions[ declaration ];
+    }
+    else if ( declaration != nullptr && declaration->getType() == ast::VARIABLE_DECLARATION )
+    {
+        callee = this->readVariable(declaration);
+    }
+    else if ( declaration != nullptr && declaration->getType() == ast::FUNCTION_DECLARATION )
+    {
+        // A function of an imported file.
+        callee = this->importedFunction(dynamic_cast<NFunctionDeclaration *>(declaration),
+                                        writtenName(*call->functionName));
+    }
+    else
+    {
+        // A function of another compilation unit.
+        callee = this->runtimeFunction(writtenName(*call->functionName), type);
+    }
+    return this->emitCall(callee, arguments, type);
+}
+
+Value *IRGenerator::lowerArithmetic(int operation, Value *left, Value *right, ast::Node *operand)
+{
+    bool isSignedOperand = this->isSigned(operand);
+    bool isFloatOperand = isFloat(left->type);
+    const semantic::Type *type = this->checker.typeOf(operand);
+
+    switch ( operation )
+    {
+        case ADD:
+            if ( type != nullptr && type->kind == semantic::TYPE_STRING )
+            {
+                return this->emitCall(this->runtimeFunction("__stride_string_concat", IR_PTR), { left, right }, IR_PTR);
+            }
+            return this->builder.binary(isFloatOperand ? OP_FADD : OP_ADD, left, right);
+        case SUBTRACT:
+            return this->builder.binary(isFloatOperand ? OP_FSUB : OP_SUB, left, right);
+        case MULTIPLY:
+            return this->builder.binary(isFloatOperand ? OP_FMUL : OP_MUL, left, right);
+        case DIVIDE:
+            return this->builder.binary(isFloatOperand ? OP_FDIV : isSignedOperand ? OP_SDIV : OP_UDIV, left, right);
+        case MODULO:
+            return this->builder.binary(isFloatOperand ? OP_FREM : isSignedOperand ? OP_SREM : OP_UREM, left, right);
+        case SHIFT_LEFT:
+            return this->builder.binary(OP_SHL, left, right);
+        case SHIFT_RIGHT:
+            return this->builder.binary(isSignedOperand ? OP_ASHR : OP_LSHR, left, right);
+        case BITWISE_AND:
+            return this->builder.binary(OP_AND, left, right);
+        case BITWISE_OR:
+            return this->builder.binary(OP_OR, left, right);
+        case XOR:
+            return this->builder.binary(OP_XOR, left, right);
+        case POWER:
+        {
+            // Powers are computed by the runtime, in 64 bits.
+            EIRType wide = isFloatOperand ? IR_F64 : IR_I64;
+            Value *result = this->emitCall(
+                    this->runtimeFunction(isFloatOperand ? "pow" : "__stride_power", wide),
+                    { this->convert(left, wide, isSignedOperand), this->convert(right, wide, isSignedOperand) }, wide);
+            return result != nullptr ? this->convert(result, left->type, isSignedOperand) : nullptr;
+        }
+        default:
+            return this->module.undefined(left->type);
+    }
+}
+
+/**
+ * Returns the operation of a compound assignment, e.g. ADD for ADD_ASSIGN,
+ * or -1 if the operator isn't a compound assignment.
+ */
+static int compoundOperation(EBinaryOperator operation)
+{
+    switch ( operation )
+    {
+        case ADD_ASSIGN: return ADD;
+        case SUBTRACT_ASSIGN: return SUBTRACT;
+        case MULTIPLY_ASSIGN: return MULTIPLY;
+        case POWER_ASSIGN: return POWER;
+        case DIVIDE_ASSIGN: return DIVIDE;
+        case MODULO_ASSIGN: return MODULO;
+        case SHIFT_LEFT_ASSIGN: return SHIFT_LEFT;
+        case SHIFT_RIGHT_ASSIGN: return SHIFT_RIGHT;
+        case AND_ASSIGN: return BITWISE_AND;
+        case OR_ASSIGN: return BITWISE_OR;
+        case XOR_ASSIGN: return XOR;
+        default: return -1;
+    }
+}
+
+Value *IRGenerator::lowerBinary(NBinaryOperation *binary)
+{
+    if ( binary->operation == AND || binary->operation == OR )
+    {
+        return this->lowerShortCircuit(binary);
+    }
+
+    if ( binary->isAssignment())
+    {
+        auto target = dynamic_cast<NIdentifier *>(unwrap(binary->left));
+        if ( target == nullptr || target->declaration == nullptr ||
+             target->declaration->getType() != ast::VARIABLE_DECLARATION )
+        {
+            this->report(binary, "Only variables can be assigned to.");
+            return nullptr;
+        }
+        int operation = compoundOperation(binary->operation);
+        Value *current = operation >= 0 ? this->lowerExpression(target) : nullptr;
+        Value *value = this->lowerExpression(binary->right);
+        if ( value == nullptr || this->builder.getInsertPoint() == nullptr )
+        {
+            return nullptr;
+        }
+        if ( operation >= 0 )
+        {
+            value = this->lowerArithmetic(operation, current, value, binary->left);
+            if ( value == nullptr )
+            {
+                return nullptr;
+            }
+        }
+        this->writeVariable(target->declaration, value);
+        return value;
+    }
+
+    Value *left = this->lowerExpression(binary->left);
+    Value *right = this->lowerExpression(binary->right);
+    if ( left == nullptr || right == nullptr || this->builder.getInsertPoint() == nullptr )
+    {
+        return nullptr;
+    }
+
+    if ( binary->isComparison())
+    {
+        bool isUnsigned = isInteger(left->type) && !this->isSigned(binary->left) && left->type != IR_BOOL;
+        const semantic::Type *type = this->checker.typeOf(binary->left);
+        if ( type != nullptr && type->kind == semantic::TYPE_STRING )
+        {
+            // Strings are compared by their contents.
+            Value *order = this->emitCall(this->runtimeFunction("__stride_string_compare", IR_I32), { left, right }, IR_I32);
+            if ( order == nullptr )
+            {
+                return nullptr;
+            }
+            left = order;
+            right = this->module.integer(IR_I32, 0);
+            isUnsigned = false;
+        }
+
+        EPredicate predicate;
+        switch ( binary->operation )
+        {
+            case EQUALS: predicate = PREDICATE_EQ; break;
+            case NOT_EQUALS: predicate = PREDICATE_NE; break;
+            case LESS_THAN: predicate = isUnsigned ? PREDICATE_ULT : PREDICATE_LT; break;
+            case LESS_THAN_EQUALS: predicate = isUnsigned ? PREDICATE_ULE : PREDICATE_LE; break;
+            case GREATER_THAN: predicate = isUnsigned ? PREDICATE_UGT : PREDICATE_GT; break;
+            default: predicate = isUnsigned ? PREDICATE_UGE : PREDICATE_GE; break;
+        }
+        return this->builder.compare(predicate, left, right);
+    }
+    return this->lowerArithmetic(binary->operation, left, right, binary->left);
+}
+
+Value *IRGenerator::lowerUnary(NUnaryOperator *unary)
+{
+    if ( unary->operation == NEGATE )
+    {
+        Value *operand = this->lowerExpression(unary->expression.get());
+        return operand != nullptr ? this->builder.binary(OP_XOR, operand, this->module.integer(IR_BOOL, 1)) : nullptr;
+    }
+    if ( unary->operation == BITWISE_NOT )
+    {
+        Value *operand = this->lowerExpression(unary->expression.get());
+        return operand != nullptr ? this->builder.binary(OP_XOR, operand, this->module.integer(operand->type, -1)) : nullptr;
+    }
+
+    auto target = dynamic_cast<NIdentifier *>(unwrap(unary->expression.get()));
+    if ( target == nullptr || target->declaration == nullptr || target->declaration->getType() != ast::VARIABLE_DECLARATION )
+    {
+        this->report(unary, "Only variables can be incremented or decremented.");
+        return nullptr;
+    }
+    Value *current = this->readVariable(target->declaration);
+    bool increment = unary->operation == INCREMENT_LHS || unary->operation == INCREMENT_RHS;
+    Value *updated = isFloat(current->type) ?
+                     this->builder.binary(increment ? OP_FADD : OP_FSUB, current, this->module.floating(current->type, 1)) :
+                     this->builder.binary(increment ? OP_ADD : OP_SUB, current, this->module.integer(current->type, 1));
+    this->writeVariable(target->declaration, updated);
+    return unary->operation == INCREMENT_LHS || unary->operation == DECREMENT_LHS ? updated : current;
+}
+
+Value *IRGenerator::lowerExpression(ast::Node *node)
+{
+    if ( node == nullptr || this->builder.getInsertPoint() == nullptr )
+    {
+        return nullptr;
+    }
+
+    switch ( node->getType())
+    {
+        case ast::EXPRESSION:
+        {
+            Value *value = nullptr;
+            for ( size_t i = 0; i < node->getChildCount(); i++ )
+            {
+                value = this->lowerExpression(node->getChild(i));
+            }
+            return value;
+        }
+
+        case ast::LITERAL:
+        {
+            auto literal = dynamic_cast<NLiteral *>(node);
+            EIRType type = this->irTypeOf(node);
+            if ( std::holds_alternative<const char *>(literal->value))
+            {
+                return this->module.string(std::get<const char *>(literal->value));
+            }
+            double numeric = std::holds_alternative<int64_t>(literal->value) ?
+                             (double) std::get<int64_t>(literal->value) : std::get<double_t>(literal->value);
+            if ( isFloat(type))
+            {
+                return this->module.floating(type, numeric);
+            }
+            return this->module.integer(type == IR_VOID || type == IR_PTR ? IR_I64 : type,
+                                        std::holds_alternative<int64_t>(literal->value) ?
+                                        std::get<int64_t>(literal->value) : (int64_t) numeric);
+        }
+
+        case ast::IDENTIFIER:
+        {
+            auto identifier = dynamic_cast<NIdentifier *>(node);
+            if ( identifier->declaration == nullptr )
+            {
+                std::vector<std::string> path = ast::splitIdentifier(identifier->name);
+                if ( path.size() == 1 && ( path[ 0 ] == "true" || path[ 0 ] == "false" ))
+                {
+                    return this->module.integer(IR_BOOL, path[ 0 ] == "true");
+                }
+                return this->module.undefined(this->irTypeOf(node));
+            }
+            auto function = this->functions.find(identifier->declaration);
+            if ( function != this->functions.end())
+            {
+                return function->second;
+            }
+            if ( identifier->declaration->getType() == ast::VARIABLE_DECLARATION )
+            {
+                return this->readVariable(identifier->declaration);
+            }
+            if ( identifier->declaration->getType() == ast::FUNCTION_DECLARATION )
+            {
+                return this->importedFunction(dynamic_cast<NFunctionDeclaration *>(identifier->declaration),
+                                              writtenName(identifier->name));
+            }
+            return this->module.undefined(this->irTypeOf(node));
+        }
+
+        case ast::BINARY_OPERATOR:
+            return this->lowerBinary(dynamic_cast<NBinaryOperation *>(node));
+
+        case ast::UNARY_OPERATOR:
+            return this->lowerUnary(dynamic_cast<NUnaryOperator *>(node));
+
+        case ast::FUNCTION_CALL:
+            return this->lowerCall(dynamic_cast<NFunctionCall *>(node));
+
+        case ast::ARRAY:
+        {
+            std::vector<Value *> elements;
+            for ( auto element: dynamic_cast<NArray *>(node)->elements )
+            {
+                Value *value = this->lowerExpression(element);
+                if ( value == nullptr || this->builder.getInsertPoint() == nullptr )
+                {
+                    return nullptr;
+                }
+                elements.push_back(value);
+            }
+            const semantic::Type *type = this->checker.typeOf(node);
+            const semantic::Type *element = type != nullptr ? type->element : nullptr;
+            return this->builder.array(element, this->irTypeOf(element), elements);
+        }
+
+        default:
+            return nullptr;
+    }
+}
@@ -0,0 +1,171 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_IRGENERATOR_H
+#define STRIDE_LANGUAGE_IRGENERATOR_H
+
+#include <unordered_map>
+#include <unordered_set>
+#include "IR.h"
+#include "IRBuilder.h"
+#include "../StrideFile.h"
+#include "../semantic/TypeChecker.h"
+
+/** The name of the function that assigns global variables that aren't constant. */
+#define MODULE_INITIALIZER_NAME "__initialize"
+
+class NFunctionDeclaration;
+class NVariableDeclaration;
+class NSwitchStatement;
+class NTryCatchStatement;
+class NBinaryOperation;
+class NUnaryOperator;
+class NFunctionCall;
+class NWhileLoop;
+
+namespace stride::ir
+{
+
+    /**
+     * Lowers the syntax tree of a file to IR.
+     *
+     * Local variables are converted to SSA form while the IR is generated, as described
+     * by Braun et al., "Simple and Efficient Construction of Static Single Assignment Form".
+     * The current value of every variable is tracked per block. Reading a variable in a
+     * block that doesn't assign it looks it up in the predecessors, placing a phi node
+     * where they differ. Blocks whose predecessors aren't all known yet, such as loop
+     * headers, get incomplete phi nodes that are completed once the block is sealed.
+     * Phi nodes whose operands are all the same value are removed.
+     *
+     * Global variables, and fields of the class a method belongs to, are loaded and
+     * stored through their address. Methods receive the object they're called on as
+     * their first argument. Calls in a try block continue at the catch block if they
+     * throw. Generic classes aren't lowered; their methods are specialized per
+     * instantiation.
+     */
+    class IRGenerator
+    {
+    private:
+        StrideFile &file;
+        const semantic::TypeChecker &checker;
+        Module &module;
+        IRBuilder builder;
+
+        std::unordered_map<ast::Node *, Function *> functions;
+        std::unordered_map<ast::Node *, Global *> globals;
+        std::unordered_map<ast::Node *, ast::Node *> fieldOwners;
+        std::unordered_map<ast::Node *, ast::Node *> methodOwners;
+        std::vector<std::string> scopeNames;
+        ast::Node *declaringClass = nullptr;
+        std::vector<NFunctionDeclaration *> pendingFunctions;
+        std::vector<ast::Node *> pendingInitializers;
+
+        // The state of the function that is being lowered.
+        ast::Node *currentClass = nullptr;
+        Value *self = nullptr;
+        EIRType returnType = IR_VOID;
+        std::vector<BasicBlock *> handlers;
+        std::unordered_map<BasicBlock *, std::unordered_map<ast::Node *, Value *>> definitions;
+        std::unordered_map<BasicBlock *, std::vector<std::pair<ast::Node *, Instruction *>>> incompletePhis;
+        std::unordered_set<BasicBlock *> sealedBlocks;
+        std::unordered_map<ast::Node *, EIRType> localTypes;
+        std::unordered_map<Value *, Value *> replacedPhis;
+
+        [[nodiscard]] EIRType irTypeOf(const semantic::Type *type) const;
+
+        [[nodiscard]] EIRType irTypeOf(ast::Node *node) const;
+
+        [[nodiscard]] bool isSigned(ast::Node *node) const;
+
+        std::string qualify(const std::string &name) const;
+
+        void declare(ast::Node *node);
+
+        void lowerFunction(NFunctionDeclaration *declaration);
+
+        void lowerInitializer();
+
+        void lowerStatement(ast::Node *node);
+
+        void lowerBlock(ast::Node *block);
+
+        void lowerConditional(ast::Node *node);
+
+        void lowerLoop(NWhileLoop *loop);
+
+        void lowerSwitch(NSwitchStatement *statement);
+
+        void lowerTryCatch(NTryCatchStatement *statement);
+
+        Value *lowerExpression(ast::Node *node);
+
+        Value *lowerBinary(NBinaryOperation *binary);
+
+        Value *lowerArithmetic(int operation, Value *left, Value *right, ast::Node *operand);
+
+        Value *lowerUnary(NUnaryOperator *unary);
+
+        Value *lowerCall(NFunctionCall *call);
+
+        Value *lowerShortCircuit(ast::Node *node);
+
+        /**
+         * Branches to one of two blocks, depending on a condition.
+         * Logical operators branch directly, rather than computing a boolean.
+         */
+        void lowerCondition(ast::Node *condition, BasicBlock *whenTrue, BasicBlock *whenFalse);
+
+        Value *emitCall(Value *callee, const std::vector<Value *> &arguments, EIRType type);
+
+        Function *runtimeFunction(const std::string &name, EIRType returnType);
+
+        /**
+         * Declares a function of an imported file, with the signature it's declared with.
+         * @param name The name the function is referred to by.
+         */
+        Function *importedFunction(NFunctionDeclaration *declaration, const std::string &name);
+
+        Value *convert(Value *value, EIRType type, bool isSigned);
+
+        Value *readVariable(ast::Node *variable);
+
+        void writeVariable(ast::Node *variable, Value *value);
+
+        Value *addressOf(ast::Node *variable);
+
+        // SSA construction
+        void define(ast::Node *variable, BasicBlock *block, Value *value);
+
+        Value *use(ast::Node *variable, BasicBlock *block);
+
+        Value *useRecursive(ast::Node *variable, BasicBlock *block);
+
+        Value *addPhiOperands(ast::Node *variable, Instruction *phi);
+
+        Value *removeTrivialPhi(Instruction *phi);
+
+        void seal(BasicBlock *block);
+
+        /**
+         * Continues adding instructions to a block, if it's reachable.
+         * Blocks without predecessors, such as the code after a return statement,
+         * aren't appended to the function, and nothing is lowered into them.
+         */
+        void enter(BasicBlock *block);
+
+        void report(ast::Node *node, const std::string &message);
+
+    public:
+
+        IRGenerator(StrideFile &file, const semantic::TypeChecker &checker, Module &module);
+
+        /**
+         * Lowers a node. For the root, this lowers every function and global variable in the tree.
+         * @return The value of an expression, or nullptr for other nodes.
+         */
+        Value *generate(ast::Node *node);
+    };
+}
+
+#endif //STRIDE_LANGUAGE_IRGENERATOR_H
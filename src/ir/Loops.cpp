@@ -0,0 +1,116 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include "Loops.h"
+
+using namespace stride::ir;
+
+BasicBlock *Loop::preheader() const
+{
+    BasicBlock *entering = nullptr;
+    for ( auto predecessor: this->header->predecessors )
+    {
+        if ( this->contains(predecessor))
+        {
+            continue;
+        }
+        if ( entering != nullptr && entering != predecessor )
+        {
+            return nullptr;
+        }
+        entering = predecessor;
+    }
+    if ( entering == nullptr || entering->successors().size() != 1 )
+    {
+        return nullptr;
+    }
+    return entering;
+}
+
+LoopInfo::LoopInfo(const Function &function, const DominatorTree &dominators)
+{
+    size_t blockCount = function.blocks.size();
+    this->innermost.assign(blockCount, nullptr);
+
+    // Every edge to a block that dominates its source is a back edge.
+    for ( auto header: dominators.reversePostOrder())
+    {
+        std::vector<BasicBlock *> latches;
+        for ( auto predecessor: header->predecessors )
+        {
+            if ( dominators.dominates(header, predecessor) &&
+                 std::find(latches.begin(), latches.end(), predecessor) == latches.end())
+            {
+                latches.push_back(predecessor);
+            }
+        }
+        if ( latches.empty())
+        {
+            continue;
+        }
+
+        auto loop = std::make_unique<Loop>(header);
+        loop->latches = latches;
+        loop->members.assign(blockCount, false);
+        loop->members[ header->id ] = true;
+        loop->blocks.push_back(header);
+
+        // The loop consists of every block that reaches a latch without passing the header.
+        std::vector<BasicBlock *> worklist = latches;
+        while ( !worklist.empty())
+        {
+            BasicBlock *block = worklist.back();
+            worklist.pop_back();
+            if ( loop->members[ block->id ] || !dominators.isReachable(block))
+            {
+                continue;
+            }
+            loop->members[ block->id ] = true;
+            loop->blocks.push_back(block);
+            worklist.insert(worklist.end(), block->predecessors.begin(), block->predecessors.end());
+        }
+        this->loopList.push_back(std::move(loop));
+    }
+
+    // Nested loops have fewer blocks than the loops they're nested in.
+    std::stable_sort(this->loopList.begin(), this->loopList.end(),
+                     [](const std::unique_ptr<Loop> &first, const std::unique_ptr<Loop> &second)
+                     { return first->blocks.size() < second->blocks.size(); });
+    for ( size_t i = 0; i < this->loopList.size(); i++ )
+    {
+        Loop *loop = this->loopList[ i ].get();
+        for ( auto block: loop->blocks )
+        {
+            if ( this->innermost[ block->id ] == nullptr )
+            {
+                this->innermost[ block->id ] = loop;
+            }
+        }
+        for ( size_t j = i + 1; j < this->loopList.size() && loop->parent == nullptr; j++ )
+        {
+            if ( this->loopList[ j ]->contains(loop->header))
+            {
+                loop->parent = this->loopList[ j ].get();
+                loop->parent->children.push_back(loop);
+            }
+        }
+        if ( loop->parent == nullptr )
+        {
+            this->outermost.push_back(loop);
+        }
+    }
+
+    // Depths are assigned from the outside in.
+    for ( size_t i = this->loopList.size(); i-- > 0; )
+    {
+        Loop *loop = this->loopList[ i ].get();
+        loop->depth = loop->parent != nullptr ? loop->parent->depth + 1 : 1;
+    }
+}
+
+Loop *LoopInfo::loopOf(const BasicBlock *block) const
+{
+    return block->id < this->innermost.size() ? this->innermost[ block->id ] : nullptr;
+}
@@ -0,0 +1,83 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_LOOPS_H
+#define STRIDE_LANGUAGE_LOOPS_H
+
+#include <memory>
+#include "Dominators.h"
+
+namespace stride::ir
+{
+
+    /**
+     * A natural loop; a header that dominates the latches, the blocks that branch back to it,
+     * and every block on a path from the header to a latch.
+     */
+    class Loop
+    {
+    public:
+        BasicBlock *header;
+        Loop *parent = nullptr;
+        std::vector<Loop *> children;
+        std::vector<BasicBlock *> blocks;
+        std::vector<BasicBlock *> latches;
+
+        /**
+         * The amount of loops this loop is nested in, plus one.
+         */
+        uint32_t depth = 1;
+
+        /**
+         * Whether a block is part of the loop, indexed by block id.
+         */
+        std::vector<bool> members;
+
+        explicit Loop(BasicBlock *header) : header(header)
+        {}
+
+        [[nodiscard]] bool contains(const BasicBlock *block) const
+        { return block->id < this->members.size() && this->members[ block->id ]; }
+
+        /**
+         * Returns the block that enters the loop, if it's the only predecessor
+         * of the header outside the loop and the header is its only successor.
+         * Code that's hoisted out of the loop is placed here.
+         */
+        [[nodiscard]] BasicBlock *preheader() const;
+    };
+
+    /**
+     * The natural loops of a function, and how they're nested.
+     */
+    class LoopInfo
+    {
+    private:
+        std::vector<std::unique_ptr<Loop>> loopList;
+        std::vector<Loop *> outermost;
+
+        // The innermost loop of every block, indexed by block id.
+        std::vector<Loop *> innermost;
+
+    public:
+
+        LoopInfo(const Function &function, const DominatorTree &dominators);
+
+        /**
+         * Returns all loops, with inner loops before the loops they're nested in.
+         */
+        [[nodiscard]] const std::vector<std::unique_ptr<Loop>> &loops() const
+        { return this->loopList; }
+
+        [[nodiscard]] const std::vector<Loop *> &topLevelLoops() const
+        { return this->outermost; }
+
+        /**
+         * Returns the innermost loop a block is part of, or nullptr.
+         */
+        [[nodiscard]] Loop *loopOf(const BasicBlock *block) const;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_LOOPS_H
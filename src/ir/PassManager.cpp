@@ -0,0 +1,245 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include "PassManager.h"
+#include "Verifier.h"
+#include "transforms/CommonSubexpressionElimination.h"
+#include "transforms/DeadCodeElimination.h"
+#include "transforms/Inliner.h"
+#include "transforms/InstSimplify.h"
+#include "transforms/LoadStoreElimination.h"
+#include "transforms/LoopInvariantCodeMotion.h"
+#include "transforms/SimplifyCFG.h"
+
+using namespace stride::ir;
+
+/** The largest callee, in instructions, that's inlined at -O2 and at -O3. */
+#define INLINE_THRESHOLD_O2 12
+#define INLINE_THRESHOLD_O3 40
+
+DominatorTree &AnalysisManager::dominators(const Function &function)
+{
+    std::unique_ptr<DominatorTree> &tree = this->dominatorTrees[ &function ];
+    if ( tree == nullptr )
+    {
+        tree = std::make_unique<DominatorTree>(function);
+        this->computed[ 0 ]++;
+    }
+    else
+    {
+        this->reused[ 0 ]++;
+    }
+    return *tree;
+}
+
+LoopInfo &AnalysisManager::loops(const Function &function)
+{
+    std::unique_ptr<LoopInfo> &info = this->loopInfos[ &function ];
+    if ( info == nullptr )
+    {
+        info = std::make_unique<LoopInfo>(function, this->dominators(function));
+        this->computed[ 1 ]++;
+    }
+    else
+    {
+        this->reused[ 1 ]++;
+    }
+    return *info;
+}
+
+AliasInfo &AnalysisManager::aliases(const Function &function)
+{
+    std::unique_ptr<AliasInfo> &info = this->aliasInfos[ &function ];
+    if ( info == nullptr )
+    {
+        info = std::make_unique<AliasInfo>(function);
+        this->computed[ 2 ]++;
+    }
+    else
+    {
+        this->reused[ 2 ]++;
+    }
+    return *info;
+}
+
+void AnalysisManager::invalidate(const Function &function, uint32_t preserved)
+{
+    if ( !( preserved & ANALYSIS_DOMINATORS ))
+    {
+        this->dominatorTrees.erase(&function);
+    }
+    if ( !( preserved & ANALYSIS_LOOPS ))
+    {
+        this->loopInfos.erase(&function);
+    }
+    if ( !( preserved & ANALYSIS_ALIASES ))
+    {
+        this->aliasInfos.erase(&function);
+    }
+}
+
+void AnalysisManager::invalidateAll()
+{
+    this->dominatorTrees.clear();
+    this->loopInfos.clear();
+    this->aliasInfos.clear();
+}
+
+void PassManager::add(std::unique_ptr<FunctionPass> pass)
+{
+    this->passes.push_back({ std::move(pass), nullptr, {} });
+}
+
+void PassManager::add(std::unique_ptr<ModulePass> pass)
+{
+    this->passes.push_back({ nullptr, std::move(pass), {} });
+}
+
+void PassManager::addOptimizationPipeline(int optimizationLevel)
+{
+    this->level = std::clamp(optimizationLevel, 0, OPTIMIZATION_LEVEL_MAX);
+    if ( this->level == 0 )
+    {
+        return;
+    }
+
+    // -O1 cleans up what the IR generator leaves behind.
+    if ( this->level == 1 )
+    {
+        this->add(std::make_unique<SimplifyCFG>());
+        this->add(std::make_unique<InstSimplify>());
+        this->add(std::make_unique<DeadCodeElimination>());
+        this->add(std::make_unique<SimplifyCFG>());
+        return;
+    }
+
+    // -O2 inlines small functions, and removes redundant computations and memory accesses.
+    // -O3 inlines larger functions, and repeats the pipeline on the result.
+    this->add(std::make_unique<SimplifyCFG>());
+    this->add(std::make_unique<InstSimplify>());
+    this->add(std::make_unique<Inliner>(this->level == 2 ? INLINE_THRESHOLD_O2 : INLINE_THRESHOLD_O3));
+    for ( int iteration = 0; iteration < this->level - 1; iteration++ )
+    {
+        this->add(std::make_unique<SimplifyCFG>());
+        this->add(std::make_unique<InstSimplify>());
+        this->add(std::make_unique<CommonSubexpressionElimination>());
+        this->add(std::make_unique<LoadStoreElimination>());
+        this->add(std::make_unique<LoopInvariantCodeMotion>());
+        this->add(std::make_unique<InstSimplify>());
+        this->add(std::make_unique<DeadCodeElimination>());
+    }
+    this->add(std::make_unique<SimplifyCFG>());
+}
+
+/**
+ * Counts the instructions and blocks of all functions of a module.
+ */
+static std::pair<size_t, size_t> measure(const Module &module)
+{
+    size_t instructions = 0, blocks = 0;
+    for ( auto function: module.functions )
+    {
+        instructions += function->instructionCount();
+        blocks += function->blocks.size();
+    }
+    return { instructions, blocks };
+}
+
+bool PassManager::verify(const Module &module, const PassEntry &entry)
+{
+    for ( auto function: module.functions )
+    {
+        std::string error;
+        if ( !verifyFunction(*function, error))
+        {
+            this->verificationError = "after " + std::string(entry.pass().name()) + ", in @" + function->name + ": " + error;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool PassManager::run(Module &module)
+{
+    using clock = std::chrono::steady_clock;
+
+    for ( auto &entry: this->passes )
+    {
+        PassStatistics &statistics = entry.statistics;
+        std::tie(statistics.instructionsBefore, statistics.blocksBefore) = measure(module);
+        auto start = clock::now();
+
+        if ( entry.functionPass != nullptr )
+        {
+            for ( auto function: module.functions )
+            {
+                if ( function->external || function->blocks.empty())
+                {
+                    continue;
+                }
+                statistics.functionCount++;
+                if ( entry.functionPass->run(*function, this->analysisManager))
+                {
+                    statistics.changedFunctions++;
+                    function->renumber();
+                    this->analysisManager.invalidate(*function, entry.functionPass->preservedAnalyses());
+                }
+            }
+        }
+        else if ( entry.modulePass->run(module, this->analysisManager))
+        {
+            statistics.changedFunctions++;
+            for ( auto function: module.functions )
+            {
+                function->renumber();
+            }
+            this->analysisManager.invalidateAll();
+        }
+
+        statistics.milliseconds = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+        this->totalMilliseconds += statistics.milliseconds;
+        std::tie(statistics.instructionsAfter, statistics.blocksAfter) = measure(module);
+
+        if ( this->verifying && !this->verify(module, entry))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PassManager::printReport(std::ostream &out) const
+{
+    static const char *analysisNames[] = { "dominators", "loops", "aliases" };
+
+    out << "Optimization pipeline -O" << this->level << ", " << this->passes.size() << " passes in "
+        << std::fixed << std::setprecision(3) << this->totalMilliseconds << " ms" << std::endl;
+    for ( size_t i = 0; i < this->passes.size(); i++ )
+    {
+        const PassStatistics &statistics = this->passes[ i ].statistics;
+        out << "  " << std::setw(2) << i + 1 << ". " << std::left << std::setw(24) << this->passes[ i ].pass().name()
+            << std::right << std::setw(9) << statistics.milliseconds << " ms   instructions "
+            << std::setw(6) << statistics.instructionsBefore << " -> " << std::setw(6) << statistics.instructionsAfter
+            << "   blocks " << std::setw(4) << statistics.blocksBefore << " -> " << std::setw(4) << statistics.blocksAfter;
+        if ( this->passes[ i ].functionPass != nullptr )
+        {
+            out << "   changed " << statistics.changedFunctions << " of " << statistics.functionCount << " functions";
+        }
+        else if ( statistics.changedFunctions > 0 )
+        {
+            out << "   changed the module";
+        }
+        out << std::endl;
+    }
+    out << "  analyses:";
+    for ( int i = 0; i < 3; i++ )
+    {
+        out << " " << analysisNames[ i ] << " " << this->analysisManager.computed[ i ] << " computed, "
+            << this->analysisManager.reused[ i ] << " reused" << ( i < 2 ? ";" : "" );
+    }
+    out << std::defaultfloat << std::endl;
+}
@@ -0,0 +1,195 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_PASSMANAGER_H
+#define STRIDE_LANGUAGE_PASSMANAGER_H
+
+#include <memory>
+#include <ostream>
+#include <unordered_map>
+#include "AliasAnalysis.h"
+#include "Dominators.h"
+#include "IR.h"
+#include "Loops.h"
+
+/** The optimization level when none is provided with '-O'. */
+#define OPTIMIZATION_LEVEL_DEFAULT 0
+#define OPTIMIZATION_LEVEL_MAX     3
+
+namespace stride::ir
+{
+
+    /**
+     * The analyses the pass manager caches, as flags.
+     */
+    enum EAnalysis : uint32_t
+    {
+        ANALYSIS_NONE       = 0,
+        ANALYSIS_DOMINATORS = 1 << 0,
+        ANALYSIS_LOOPS      = 1 << 1,
+        ANALYSIS_ALIASES    = 1 << 2,
+
+        // The analyses that only depend on the control flow graph.
+        ANALYSIS_CFG        = ANALYSIS_DOMINATORS | ANALYSIS_LOOPS,
+        ANALYSIS_ALL        = ANALYSIS_CFG | ANALYSIS_ALIASES
+    };
+
+    /**
+     * Computes analyses of functions on request, and keeps them until
+     * a pass changes the function in a way that invalidates them.
+     */
+    class AnalysisManager
+    {
+    private:
+        std::unordered_map<const Function *, std::unique_ptr<DominatorTree>> dominatorTrees;
+        std::unordered_map<const Function *, std::unique_ptr<LoopInfo>> loopInfos;
+        std::unordered_map<const Function *, std::unique_ptr<AliasInfo>> aliasInfos;
+
+    public:
+        /**
+         * How often an analysis was computed, and how often it was reused, indexed by the bit of its flag.
+         */
+        unsigned int computed[3] = { 0, 0, 0 };
+        unsigned int reused[3] = { 0, 0, 0 };
+
+        DominatorTree &dominators(const Function &function);
+
+        LoopInfo &loops(const Function &function);
+
+        AliasInfo &aliases(const Function &function);
+
+        /**
+         * Drops the analyses of a function, other than the preserved ones.
+         * @param preserved The analyses that are still valid, as EAnalysis flags.
+         */
+        void invalidate(const Function &function, uint32_t preserved);
+
+        void invalidateAll();
+    };
+
+    class Pass
+    {
+    public:
+        virtual ~Pass() = default;
+
+        /**
+         * Returns the name of the pass, as shown in the pass report.
+         */
+        [[nodiscard]] virtual const char *name() const = 0;
+
+        /**
+         * Returns the analyses that are still valid after the pass changed a function, as EAnalysis flags.
+         */
+        [[nodiscard]] virtual uint32_t preservedAnalyses() const
+        { return ANALYSIS_NONE; }
+    };
+
+    /**
+     * A pass that transforms one function at a time.
+     */
+    class FunctionPass : public Pass
+    {
+    public:
+        /**
+         * @return Whether the function was changed.
+         */
+        virtual bool run(Function &function, AnalysisManager &analyses) = 0;
+    };
+
+    /**
+     * A pass that transforms a module as a whole, e.g. across calls.
+     */
+    class ModulePass : public Pass
+    {
+    public:
+        /**
+         * @return Whether the module was changed.
+         */
+        virtual bool run(Module &module, AnalysisManager &analyses) = 0;
+    };
+
+    /**
+     * How a pass in the pipeline performed.
+     */
+    struct PassStatistics
+    {
+        double milliseconds = 0;
+        size_t instructionsBefore = 0;
+        size_t instructionsAfter = 0;
+        size_t blocksBefore = 0;
+        size_t blocksAfter = 0;
+        unsigned int changedFunctions = 0;
+        unsigned int functionCount = 0;
+    };
+
+    /**
+     * Runs an ordered list of passes over a module. Function passes run over every
+     * function before the next pass starts. Analyses are shared between passes,
+     * and dropped when a pass changes a function, unless it preserves them.
+     */
+    class PassManager
+    {
+    private:
+        struct PassEntry
+        {
+            std::unique_ptr<FunctionPass> functionPass;
+            std::unique_ptr<ModulePass> modulePass;
+            PassStatistics statistics;
+
+            [[nodiscard]] Pass &pass() const
+            {
+                return this->functionPass != nullptr ? (Pass &) *this->functionPass : (Pass &) *this->modulePass;
+            }
+        };
+
+        std::vector<PassEntry> passes;
+        AnalysisManager analysisManager;
+        int level = OPTIMIZATION_LEVEL_DEFAULT;
+        bool verifying = false;
+        std::string verificationError;
+        double totalMilliseconds = 0;
+
+        bool verify(const Module &module, const PassEntry &entry);
+
+    public:
+
+        void add(std::unique_ptr<FunctionPass> pass);
+
+        void add(std::unique_ptr<ModulePass> pass);
+
+        /**
+         * Adds the passes of an optimization level, from 0 to 3.
+         * Higher levels spend more time compiling, to produce faster code.
+         */
+        void addOptimizationPipeline(int optimizationLevel);
+
+        /**
+         * Checks the IR after every pass, to find passes that break it.
+         */
+        void setVerifying(bool verify)
+        { this->verifying = verify; }
+
+        /**
+         * Runs all passes.
+         * @return Whether the IR passed verification, if enabled.
+         */
+        bool run(Module &module);
+
+        /**
+         * Returns why verification failed.
+         */
+        [[nodiscard]] const std::string &getVerificationError() const
+        { return this->verificationError; }
+
+        [[nodiscard]] AnalysisManager &analyses()
+        { return this->analysisManager; }
+
+        /**
+         * Prints the time every pass took, and how it changed the size of the IR.
+         */
+        void printReport(std::ostream &out) const;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_PASSMANAGER_H
@@ -0,0 +1,140 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include <sstream>
+#include <unordered_set>
+#include "Dominators.h"
+#include "Verifier.h"
+
+using namespace stride::ir;
+
+/**
+ * Describes an instruction for an error message, e.g. '%3 (add) in entry.0'.
+ */
+static std::string describe(const Instruction *instruction)
+{
+    std::ostringstream description;
+    description << "%" << instruction->id << " (" << opcodeName(instruction->opcode) << ") in "
+                << instruction->block->label << "." << instruction->block->id;
+    return description.str();
+}
+
+bool stride::ir::verifyFunction(const Function &function, std::string &error)
+{
+    if ( function.external )
+    {
+        return true;
+    }
+    std::unordered_set<const BasicBlock *> blocks(function.blocks.begin(), function.blocks.end());
+    std::unordered_set<const Value *> definitions(function.arguments.begin(), function.arguments.end());
+
+    for ( auto block: function.blocks )
+    {
+        if ( block->function != &function )
+        {
+            error = "block " + block->label + " belongs to another function";
+            return false;
+        }
+        if ( block->terminator() == nullptr )
+        {
+            error = "block " + block->label + "." + std::to_string(block->id) + " isn't terminated";
+            return false;
+        }
+
+        // Every edge is listed once in the predecessors of its target.
+        for ( auto successor: block->successors())
+        {
+            if ( blocks.count(successor) == 0 )
+            {
+                error = describe(block->terminator()) + " branches to a block outside the function";
+                return false;
+            }
+            auto edges = std::count(block->successors().begin(), block->successors().end(), successor);
+            if ( std::count(successor->predecessors.begin(), successor->predecessors.end(), block) != edges )
+            {
+                error = describe(block->terminator()) + " isn't registered as predecessor of " +
+                        successor->label + "." + std::to_string(successor->id);
+                return false;
+            }
+        }
+
+        bool phisEnded = false;
+        for ( size_t i = 0; i < block->instructions.size(); i++ )
+        {
+            Instruction *instruction = block->instructions[ i ];
+            if ( instruction->block != block )
+            {
+                error = "an instruction of " + block->label + " refers to another block";
+                return false;
+            }
+            if ( instruction->isTerminator() != ( i + 1 == block->instructions.size()))
+            {
+                error = describe(instruction) + ( instruction->isTerminator() ? " is a terminator in the middle of its block"
+                                                                              : " ends its block" );
+                return false;
+            }
+            if ( instruction->opcode == OP_PHI )
+            {
+                if ( phisEnded )
+                {
+                    error = describe(instruction) + " follows an instruction that isn't a phi node";
+                    return false;
+                }
+                std::vector<BasicBlock *> incoming = instruction->targets;
+                std::vector<BasicBlock *> predecessors = block->predecessors;
+                std::sort(incoming.begin(), incoming.end());
+                std::sort(predecessors.begin(), predecessors.end());
+                if ( incoming != predecessors || instruction->operands.size() != instruction->targets.size())
+                {
+                    error = describe(instruction) + " doesn't have a value for every predecessor";
+                    return false;
+                }
+            }
+            else
+            {
+                phisEnded = true;
+            }
+            for ( auto operand: instruction->operands )
+            {
+                if ( std::find(operand->users.begin(), operand->users.end(), instruction) == operand->users.end())
+                {
+                    error = describe(instruction) + " isn't registered as user of its operand";
+                    return false;
+                }
+            }
+            definitions.insert(instruction);
+        }
+    }
+
+    // Definitions are checked once all blocks are known, since phi nodes may use later values.
+    DominatorTree dominators(function);
+    for ( auto block: function.blocks )
+    {
+        if ( !dominators.isReachable(block))
+        {
+            continue;
+        }
+        for ( auto instruction: block->instructions )
+        {
+            for ( size_t i = 0; i < instruction->operands.size(); i++ )
+            {
+                Value *operand = instruction->operands[ i ];
+                bool local = operand->kind == VALUE_INSTRUCTION || operand->kind == VALUE_ARGUMENT;
+                if ( local && definitions.count(operand) == 0 )
+                {
+                    error = describe(instruction) + " uses a value that isn't defined in the function";
+                    return false;
+                }
+                if ( !dominators.dominates(operand, instruction, i))
+                {
+                    error = describe(instruction) + " uses %" + std::to_string(operand->id) +
+                            ", which doesn't dominate it";
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,24 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_VERIFIER_H
+#define STRIDE_LANGUAGE_VERIFIER_H
+
+#include "IR.h"
+
+namespace stride::ir
+{
+
+    /**
+     * Checks the invariants of the IR of a function: every block ends with its only
+     * terminator, predecessors match the terminators that branch to a block, phi nodes
+     * start their block with a value per predecessor, uses are registered with the values
+     * they use, and every definition dominates its uses.
+     * @param error Set to a description of the first violation.
+     * @return Whether the function is well-formed.
+     */
+    bool verifyFunction(const Function &function, std::string &error);
+}
+
+#endif //STRIDE_LANGUAGE_VERIFIER_H
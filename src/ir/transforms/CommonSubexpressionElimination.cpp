@@ -0,0 +1,119 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include <map>
+#include "CommonSubexpressionElimination.h"
+
+using namespace stride::ir;
+
+namespace
+{
+    /**
+     * What an instruction computes; instructions with equal keys compute the same value.
+     */
+    struct ExpressionKey
+    {
+        EOpcode opcode;
+        EPredicate predicate;
+        EIRType type;
+        const void *field;
+        std::vector<Value *> operands;
+
+        bool operator<(const ExpressionKey &other) const
+        {
+            return std::tie(this->opcode, this->predicate, this->type, this->field, this->operands) <
+                   std::tie(other.opcode, other.predicate, other.type, other.field, other.operands);
+        }
+    };
+
+    /**
+     * Whether an instruction only depends on its operands, and may be replaced by an identical one.
+     */
+    bool isCandidate(const Instruction *instruction)
+    {
+        return ( instruction->opcode >= OP_ADD && instruction->opcode <= OP_FPTOUI ) ||
+               instruction->opcode == OP_FIELD_ADDRESS;
+    }
+
+    ExpressionKey keyOf(const Instruction *instruction)
+    {
+        ExpressionKey key { instruction->opcode, instruction->predicate, instruction->type, instruction->field,
+                            instruction->operands };
+        switch ( instruction->opcode )
+        {
+            case OP_ADD:
+            case OP_MUL:
+            case OP_AND:
+            case OP_OR:
+            case OP_XOR:
+                std::sort(key.operands.begin(), key.operands.end());
+                break;
+            default:
+                break;
+        }
+        return key;
+    }
+}
+
+bool CommonSubexpressionElimination::run(Function &function, AnalysisManager &analyses)
+{
+    DominatorTree &dominators = analyses.dominators(function);
+    std::map<ExpressionKey, Instruction *> available;
+    bool changed = false;
+
+    // Depth first through the dominator tree; the expressions a block adds are removed
+    // again once its subtree is done, so they're only visible to the blocks it dominates.
+    struct Frame
+    {
+        BasicBlock *block;
+        size_t nextChild;
+        std::vector<std::map<ExpressionKey, Instruction *>::iterator> added;
+    };
+    std::vector<Frame> stack;
+    stack.push_back({ function.entry(), 0, {}});
+    bool entered = false;
+    while ( !stack.empty())
+    {
+        Frame &frame = stack.back();
+        if ( !entered )
+        {
+            for ( size_t i = 0; i < frame.block->instructions.size(); )
+            {
+                Instruction *instruction = frame.block->instructions[ i ];
+                if ( !isCandidate(instruction))
+                {
+                    i++;
+                    continue;
+                }
+                auto [ position, inserted ] = available.emplace(keyOf(instruction), instruction);
+                if ( inserted )
+                {
+                    frame.added.push_back(position);
+                    i++;
+                    continue;
+                }
+                instruction->replaceAllUsesWith(position->second);
+                frame.block->erase(instruction);
+                changed = true;
+            }
+        }
+
+        const std::vector<BasicBlock *> &children = dominators.children(frame.block);
+        if ( frame.nextChild < children.size())
+        {
+            BasicBlock *child = children[ frame.nextChild++ ];
+            stack.push_back({ child, 0, {}});
+            entered = false;
+            continue;
+        }
+        for ( auto position: frame.added )
+        {
+            available.erase(position);
+        }
+        stack.pop_back();
+        entered = true;
+    }
+    return changed;
+}
@@ -0,0 +1,31 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_COMMONSUBEXPRESSIONELIMINATION_H
+#define STRIDE_LANGUAGE_COMMONSUBEXPRESSIONELIMINATION_H
+
+#include "../PassManager.h"
+
+namespace stride::ir
+{
+
+    /**
+     * Replaces computations by an identical computation that dominates them.
+     * The dominator tree is walked depth first, with a scope of the available
+     * expressions per block, so only dominating expressions are reused.
+     */
+    class CommonSubexpressionElimination : public FunctionPass
+    {
+    public:
+        [[nodiscard]] const char *name() const override
+        { return "cse"; }
+
+        [[nodiscard]] uint32_t preservedAnalyses() const override
+        { return ANALYSIS_CFG; }
+
+        bool run(Function &function, AnalysisManager &analyses) override;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_COMMONSUBEXPRESSIONELIMINATION_H
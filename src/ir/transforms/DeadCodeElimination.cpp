@@ -0,0 +1,56 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <unordered_set>
+#include "DeadCodeElimination.h"
+
+using namespace stride::ir;
+
+bool DeadCodeElimination::run(Function &function, AnalysisManager &)
+{
+    std::unordered_set<Instruction *> live;
+    std::vector<Instruction *> worklist;
+    for ( auto block: function.blocks )
+    {
+        for ( auto instruction: block->instructions )
+        {
+            if ( instruction->hasSideEffects())
+            {
+                live.insert(instruction);
+                worklist.push_back(instruction);
+            }
+        }
+    }
+    while ( !worklist.empty())
+    {
+        Instruction *instruction = worklist.back();
+        worklist.pop_back();
+        for ( auto operand: instruction->operands )
+        {
+            if ( operand->kind == VALUE_INSTRUCTION && live.insert(static_cast<Instruction *>(operand)).second )
+            {
+                worklist.push_back(static_cast<Instruction *>(operand));
+            }
+        }
+    }
+
+    // Dead instructions may use each other, so all are detached before any is removed.
+    std::vector<Instruction *> dead;
+    for ( auto block: function.blocks )
+    {
+        for ( auto instruction: block->instructions )
+        {
+            if ( live.count(instruction) == 0 )
+            {
+                instruction->dropOperands();
+                dead.push_back(instruction);
+            }
+        }
+    }
+    for ( auto instruction: dead )
+    {
+        instruction->block->erase(instruction);
+    }
+    return !dead.empty();
+}
@@ -0,0 +1,31 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_DEADCODEELIMINATION_H
+#define STRIDE_LANGUAGE_DEADCODEELIMINATION_H
+
+#include "../PassManager.h"
+
+namespace stride::ir
+{
+
+    /**
+     * Removes instructions whose results aren't needed. Instructions with side effects
+     * are live, as are the operands of live instructions; all others are removed,
+     * including phi nodes that only use each other.
+     */
+    class DeadCodeElimination : public FunctionPass
+    {
+    public:
+        [[nodiscard]] const char *name() const override
+        { return "dce"; }
+
+        [[nodiscard]] uint32_t preservedAnalyses() const override
+        { return ANALYSIS_CFG; }
+
+        bool run(Function &function, AnalysisManager &analyses) override;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_DEADCODEELIMINATION_H
@@ -0,0 +1,189 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include <unordered_map>
+#include "Inliner.h"
+
+using namespace stride::ir;
+
+/**
+ * Whether a function calls itself directly.
+ */
+static bool isRecursive(const Function *function)
+{
+    for ( auto block: function->blocks )
+    {
+        for ( auto instruction: block->instructions )
+        {
+            if (( instruction->opcode == OP_CALL || instruction->opcode == OP_INVOKE ) &&
+                instruction->operands[ 0 ] == function )
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Replaces a call by the body of the called function.
+ */
+static void inlineCall(Module &module, Instruction *call, Function *callee)
+{
+    BasicBlock *block = call->block;
+    Function *caller = block->function;
+    Arena &arena = module.arena();
+
+    // The instructions after the call continue in a block of their own.
+    auto continuation = arena.create<BasicBlock>(caller, "inline.cont");
+    auto position = std::find(block->instructions.begin(), block->instructions.end(), call);
+    continuation->instructions.assign(position + 1, block->instructions.end());
+    block->instructions.erase(position + 1, block->instructions.end());
+    for ( auto instruction: continuation->instructions )
+    {
+        instruction->block = continuation;
+    }
+    for ( auto successor: continuation->successors())
+    {
+        successor->replacePredecessor(block, continuation);
+    }
+
+    // The blocks are copied first, so branches and phi nodes can refer to any of them.
+    std::unordered_map<const BasicBlock *, BasicBlock *> blocks;
+    std::unordered_map<const Value *, Value *> values;
+    for ( size_t i = 0; i < callee->arguments.size(); i++ )
+    {
+        values[ callee->arguments[ i ]] = call->operands[ i + 1 ];
+    }
+    std::vector<BasicBlock *> copies;
+    for ( auto original: callee->blocks )
+    {
+        auto copy = arena.create<BasicBlock>(caller, original->label);
+        blocks[ original ] = copy;
+        copies.push_back(copy);
+    }
+    for ( auto original: callee->blocks )
+    {
+        for ( auto instruction: original->instructions )
+        {
+            auto copy = arena.create<Instruction>(instruction->opcode, instruction->type);
+            copy->predicate = instruction->predicate;
+            copy->allocated = instruction->allocated;
+            copy->elementType = instruction->elementType;
+            copy->field = instruction->field;
+            copy->id = caller->valueCount++;
+            copy->block = blocks[ original ];
+            copy->block->instructions.push_back(copy);
+            values[ instruction ] = copy;
+        }
+    }
+
+    // Returns continue after the call, with their value merged by a phi node.
+    std::vector<std::pair<Value *, BasicBlock *>> returns;
+    for ( auto original: callee->blocks )
+    {
+        BasicBlock *copy = blocks[ original ];
+        for ( auto predecessor: original->predecessors )
+        {
+            copy->predecessors.push_back(blocks[ predecessor ]);
+        }
+        for ( size_t i = 0; i < original->instructions.size(); i++ )
+        {
+            Instruction *instruction = original->instructions[ i ];
+            auto instructionCopy = static_cast<Instruction *>(values[ instruction ]);
+            for ( auto operand: instruction->operands )
+            {
+                auto mapped = values.find(operand);
+                instructionCopy->addOperand(mapped != values.end() ? mapped->second : operand);
+            }
+            for ( auto target: instruction->targets )
+            {
+                instructionCopy->targets.push_back(blocks[ target ]);
+            }
+            if ( instruction->opcode == OP_RETURN )
+            {
+                returns.emplace_back(instructionCopy->operands.empty() ? nullptr : instructionCopy->operands[ 0 ], copy);
+                instructionCopy->dropOperands();
+                instructionCopy->opcode = OP_BRANCH;
+                instructionCopy->type = IR_VOID;
+                instructionCopy->targets = { continuation };
+                continuation->predecessors.push_back(copy);
+            }
+        }
+    }
+
+    Value *result = module.undefined(call->type);
+    if ( call->type != IR_VOID && returns.size() == 1 )
+    {
+        result = returns[ 0 ].first;
+    }
+    else if ( call->type != IR_VOID && returns.size() > 1 )
+    {
+        auto phi = arena.create<Instruction>(OP_PHI, call->type);
+        phi->id = caller->valueCount++;
+        phi->block = continuation;
+        continuation->instructions.insert(continuation->instructions.begin(), phi);
+        for ( auto &[ value, predecessor ]: returns )
+        {
+            phi->addIncoming(value != nullptr ? value : module.undefined(call->type), predecessor);
+        }
+        result = phi;
+    }
+    call->replaceAllUsesWith(result);
+
+    // The call becomes a branch to the copy of the entry.
+    call->dropOperands();
+    call->opcode = OP_BRANCH;
+    call->type = IR_VOID;
+    call->targets = { copies.front() };
+    copies.front()->predecessors.push_back(block);
+
+    auto blockPosition = std::find(caller->blocks.begin(), caller->blocks.end(), block) + 1;
+    copies.push_back(continuation);
+    caller->blocks.insert(blockPosition, copies.begin(), copies.end());
+}
+
+bool Inliner::run(Module &module, AnalysisManager &)
+{
+    // Calls are collected first, so calls that are inlined aren't inlined again.
+    std::vector<Instruction *> calls;
+    for ( auto function: module.functions )
+    {
+        for ( auto block: function->blocks )
+        {
+            for ( auto instruction: block->instructions )
+            {
+                if ( instruction->opcode == OP_CALL && instruction->operands[ 0 ]->kind == VALUE_FUNCTION )
+                {
+                    calls.push_back(instruction);
+                }
+            }
+        }
+    }
+
+    std::unordered_map<const Function *, bool> inlinable;
+    bool changed = false;
+    for ( auto call: calls )
+    {
+        auto callee = static_cast<Function *>(call->operands[ 0 ]);
+        if ( callee == call->block->function || callee->external || callee->variadic || callee->blocks.empty() ||
+             call->operands.size() != callee->arguments.size() + 1 )
+        {
+            continue;
+        }
+        auto known = inlinable.find(callee);
+        if ( known == inlinable.end())
+        {
+            bool small = callee->instructionCount() <= this->threshold;
+            known = inlinable.emplace(callee, small && callee->entry()->predecessors.empty() && !isRecursive(callee)).first;
+        }
+        if ( known->second )
+        {
+            inlineCall(module, call, callee);
+            changed = true;
+        }
+    }
+    return changed;
+}
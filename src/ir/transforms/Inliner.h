@@ -0,0 +1,37 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_INLINER_H
+#define STRIDE_LANGUAGE_INLINER_H
+
+#include "../PassManager.h"
+
+namespace stride::ir
+{
+
+    /**
+     * Replaces calls of small functions by a copy of the function's body.
+     * Functions that call themselves aren't inlined, nor are calls in try blocks,
+     * as their exceptions continue at a handler.
+     */
+    class Inliner : public ModulePass
+    {
+    private:
+        size_t threshold;
+
+    public:
+        /**
+         * @param threshold The largest callee that's inlined, in instructions.
+         */
+        explicit Inliner(size_t threshold) : threshold(threshold)
+        {}
+
+        [[nodiscard]] const char *name() const override
+        { return "inline"; }
+
+        bool run(Module &module, AnalysisManager &analyses) override;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_INLINER_H
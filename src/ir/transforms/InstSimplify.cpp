@@ -0,0 +1,371 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <cmath>
+#include "InstSimplify.h"
+
+using namespace stride::ir;
+
+/**
+ * Wraps an integer to the width of a type, sign extended as constants are stored.
+ */
+static int64_t wrap(EIRType type, uint64_t value)
+{
+    switch ( type )
+    {
+        case IR_BOOL:
+            return (int64_t) ( value & 1 );
+        case IR_I8:
+            return (int8_t) value;
+        case IR_I16:
+            return (int16_t) value;
+        case IR_I32:
+            return (int32_t) value;
+        default:
+            return (int64_t) value;
+    }
+}
+
+/**
+ * Returns the value of an integer constant as unsigned, without the sign extension.
+ */
+static uint64_t unsignedValue(EIRType type, int64_t value)
+{
+    uint32_t bits = type == IR_BOOL ? 1 : sizeOf(type) * 8;
+    return bits == 64 ? (uint64_t) value : (uint64_t) value & (( 1ULL << bits ) - 1 );
+}
+
+static bool isConstantInteger(const Value *value)
+{
+    return value->kind == VALUE_CONSTANT && isInteger(value->type);
+}
+
+static bool isConstantInteger(const Value *value, int64_t expected)
+{
+    return isConstantInteger(value) && static_cast<const Constant *>(value)->integer == expected;
+}
+
+static bool isCommutative(EOpcode opcode)
+{
+    switch ( opcode )
+    {
+        case OP_ADD:
+        case OP_MUL:
+        case OP_AND:
+        case OP_OR:
+        case OP_XOR:
+        case OP_FADD:
+        case OP_FMUL:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Computes an integer operation on constants.
+ * @return The result, or nullptr if it's undefined, e.g. for a division by zero.
+ */
+static Value *foldInteger(Module &module, Instruction *instruction, int64_t left, int64_t right)
+{
+    EIRType type = instruction->type;
+    uint64_t unsignedLeft = unsignedValue(type, left), unsignedRight = unsignedValue(type, right);
+    uint32_t bits = type == IR_BOOL ? 1 : sizeOf(type) * 8;
+    switch ( instruction->opcode )
+    {
+        case OP_ADD: return module.integer(type, wrap(type, (uint64_t) left + (uint64_t) right));
+        case OP_SUB: return module.integer(type, wrap(type, (uint64_t) left - (uint64_t) right));
+        case OP_MUL: return module.integer(type, wrap(type, (uint64_t) left * (uint64_t) right));
+        case OP_AND: return module.integer(type, left & right);
+        case OP_OR: return module.integer(type, left | right);
+        case OP_XOR: return module.integer(type, wrap(type, left ^ right));
+        case OP_SDIV:
+        case OP_SREM:
+            // The quotient of the smallest value and -1 doesn't fit.
+            if ( right == 0 || ( right == -1 && left == wrap(type, 1ULL << ( bits - 1 ))))
+            {
+                return nullptr;
+            }
+            return module.integer(type, instruction->opcode == OP_SDIV ? left / right : left % right);
+        case OP_UDIV:
+        case OP_UREM:
+            if ( unsignedRight == 0 )
+            {
+                return nullptr;
+            }
+            return module.integer(type, wrap(type, instruction->opcode == OP_UDIV ? unsignedLeft / unsignedRight
+                                                                                  : unsignedLeft % unsignedRight));
+        case OP_SHL:
+        case OP_LSHR:
+        case OP_ASHR:
+            if ( unsignedRight >= bits )
+            {
+                return nullptr;
+            }
+            if ( instruction->opcode == OP_SHL )
+            {
+                return module.integer(type, wrap(type, unsignedLeft << unsignedRight));
+            }
+            return module.integer(type, instruction->opcode == OP_LSHR ? wrap(type, unsignedLeft >> unsignedRight)
+                                                                       : left >> unsignedRight);
+        default:
+            return nullptr;
+    }
+}
+
+static Value *foldFloat(Module &module, Instruction *instruction, double left, double right)
+{
+    double result;
+    switch ( instruction->opcode )
+    {
+        case OP_FADD: result = left + right; break;
+        case OP_FSUB: result = left - right; break;
+        case OP_FMUL: result = left * right; break;
+        case OP_FDIV: result = left / right; break;
+        case OP_FREM: result = std::fmod(left, right); break;
+        default: return nullptr;
+    }
+    return module.floating(instruction->type, instruction->type == IR_F32 ? (double) (float) result : result);
+}
+
+static bool compare(EPredicate predicate, int64_t left, int64_t right, uint64_t unsignedLeft, uint64_t unsignedRight)
+{
+    switch ( predicate )
+    {
+        case PREDICATE_EQ: return left == right;
+        case PREDICATE_NE: return left != right;
+        case PREDICATE_LT: return left < right;
+        case PREDICATE_LE: return left <= right;
+        case PREDICATE_GT: return left > right;
+        case PREDICATE_GE: return left >= right;
+        case PREDICATE_ULT: return unsignedLeft < unsignedRight;
+        case PREDICATE_ULE: return unsignedLeft <= unsignedRight;
+        case PREDICATE_UGT: return unsignedLeft > unsignedRight;
+        default: return unsignedLeft >= unsignedRight;
+    }
+}
+
+static bool compareFloat(EPredicate predicate, double left, double right)
+{
+    switch ( predicate )
+    {
+        case PREDICATE_EQ: return left == right;
+        case PREDICATE_NE: return left != right;
+        case PREDICATE_LT:
+        case PREDICATE_ULT: return left < right;
+        case PREDICATE_LE:
+        case PREDICATE_ULE: return left <= right;
+        case PREDICATE_GT:
+        case PREDICATE_UGT: return left > right;
+        default: return left >= right;
+    }
+}
+
+static Value *foldConversion(Module &module, Instruction *instruction, const Constant *operand)
+{
+    EIRType type = instruction->type;
+    switch ( instruction->opcode )
+    {
+        case OP_TRUNC:
+        case OP_SEXT:
+            return module.integer(type, wrap(type, (uint64_t) operand->integer));
+        case OP_ZEXT:
+            return module.integer(type, (int64_t) unsignedValue(operand->type, operand->integer));
+        case OP_SITOFP:
+            return module.floating(type, type == IR_F32 ? (double) (float) operand->integer : (double) operand->integer);
+        case OP_UITOFP:
+        {
+            uint64_t value = unsignedValue(operand->type, operand->integer);
+            return module.floating(type, type == IR_F32 ? (double) (float) value : (double) value);
+        }
+        case OP_FPTRUNC:
+            return module.floating(type, (double) (float) operand->floating);
+        case OP_FPEXT:
+            return module.floating(type, operand->floating);
+        case OP_FPTOSI:
+        case OP_FPTOUI:
+            // Conversions of values that don't fit are undefined, and are left to run time.
+            if ( !std::isfinite(operand->floating) || std::fabs(operand->floating) >= 9.2e18 )
+            {
+                return nullptr;
+            }
+            return module.integer(type, wrap(type, (uint64_t) (int64_t) operand->floating));
+        default:
+            return nullptr;
+    }
+}
+
+/**
+ * Returns a simpler value that's equal to an instruction, or nullptr if there's none.
+ */
+static Value *simplify(Module &module, Instruction *instruction)
+{
+    EOpcode opcode = instruction->opcode;
+    if ( opcode == OP_PHI )
+    {
+        Value *same = nullptr;
+        for ( auto operand: instruction->operands )
+        {
+            if ( operand == instruction || operand == same )
+            {
+                continue;
+            }
+            if ( same != nullptr )
+            {
+                return nullptr;
+            }
+            same = operand;
+        }
+        return same != nullptr ? same : module.undefined(instruction->type);
+    }
+    if ( opcode >= OP_TRUNC && opcode <= OP_FPTOUI )
+    {
+        Value *operand = instruction->operands[ 0 ];
+        return operand->kind == VALUE_CONSTANT ? foldConversion(module, instruction, static_cast<Constant *>(operand))
+                                               : nullptr;
+    }
+    if ( opcode < OP_ADD || opcode > OP_FCMP )
+    {
+        return nullptr;
+    }
+
+    Value *left = instruction->operands[ 0 ];
+    Value *right = instruction->operands[ 1 ];
+    if ( left->kind == VALUE_CONSTANT && right->kind == VALUE_CONSTANT )
+    {
+        auto leftConstant = static_cast<Constant *>(left);
+        auto rightConstant = static_cast<Constant *>(right);
+        if ( leftConstant->isString || rightConstant->isString )
+        {
+            return nullptr;
+        }
+        if ( opcode == OP_ICMP )
+        {
+            return module.integer(IR_BOOL, compare(instruction->predicate, leftConstant->integer, rightConstant->integer,
+                                                   unsignedValue(left->type, leftConstant->integer),
+                                                   unsignedValue(right->type, rightConstant->integer)));
+        }
+        if ( opcode == OP_FCMP )
+        {
+            return module.integer(IR_BOOL, compareFloat(instruction->predicate, leftConstant->floating,
+                                                        rightConstant->floating));
+        }
+        return isFloat(instruction->type) ? foldFloat(module, instruction, leftConstant->floating, rightConstant->floating)
+                                          : foldInteger(module, instruction, leftConstant->integer, rightConstant->integer);
+    }
+
+    if ( opcode == OP_ICMP && left == right )
+    {
+        EPredicate predicate = instruction->predicate;
+        bool reflexive = predicate == PREDICATE_EQ || predicate == PREDICATE_LE || predicate == PREDICATE_GE ||
+                         predicate == PREDICATE_ULE || predicate == PREDICATE_UGE;
+        return module.integer(IR_BOOL, reflexive);
+    }
+    if ( isFloat(instruction->type) || opcode == OP_FCMP || opcode == OP_ICMP )
+    {
+        // Floating point identities don't hold for NaN and negative zero.
+        return nullptr;
+    }
+
+    int64_t allOnes = wrap(instruction->type, ~0ULL);
+    switch ( opcode )
+    {
+        case OP_ADD:
+        case OP_OR:
+        case OP_XOR:
+        case OP_SHL:
+        case OP_LSHR:
+        case OP_ASHR:
+            if ( isConstantInteger(right, 0))
+            {
+                return left;
+            }
+            break;
+        case OP_SUB:
+            if ( isConstantInteger(right, 0))
+            {
+                return left;
+            }
+            if ( left == right )
+            {
+                return module.integer(instruction->type, 0);
+            }
+            break;
+        case OP_MUL:
+            if ( isConstantInteger(right, 1))
+            {
+                return left;
+            }
+            if ( isConstantInteger(right, 0))
+            {
+                return right;
+            }
+            break;
+        case OP_SDIV:
+        case OP_UDIV:
+            if ( isConstantInteger(right, 1))
+            {
+                return left;
+            }
+            break;
+        case OP_AND:
+            if ( isConstantInteger(right, allOnes) || left == right )
+            {
+                return left;
+            }
+            if ( isConstantInteger(right, 0))
+            {
+                return right;
+            }
+            break;
+        default:
+            break;
+    }
+    if ( opcode == OP_OR && ( left == right || isConstantInteger(right, allOnes)))
+    {
+        return right;
+    }
+    if ( opcode == OP_XOR && left == right )
+    {
+        return module.integer(instruction->type, 0);
+    }
+    return nullptr;
+}
+
+bool InstSimplify::run(Function &function, AnalysisManager &)
+{
+    Module &module = *function.module;
+    bool changed = false;
+    for ( bool iterationChanged = true; iterationChanged; )
+    {
+        iterationChanged = false;
+        for ( auto block: function.blocks )
+        {
+            for ( size_t i = 0; i < block->instructions.size(); )
+            {
+                Instruction *instruction = block->instructions[ i ];
+
+                // Constants go to the right, so only one side has to be checked.
+                if ( isCommutative(instruction->opcode) && instruction->operands[ 0 ]->kind == VALUE_CONSTANT &&
+                     instruction->operands[ 1 ]->kind != VALUE_CONSTANT )
+                {
+                    std::swap(instruction->operands[ 0 ], instruction->operands[ 1 ]);
+                    iterationChanged = true;
+                }
+
+                Value *replacement = simplify(module, instruction);
+                if ( replacement == nullptr || replacement == instruction )
+                {
+                    i++;
+                    continue;
+                }
+                instruction->replaceAllUsesWith(replacement);
+                block->erase(instruction);
+                iterationChanged = true;
+            }
+        }
+        changed |= iterationChanged;
+    }
+    return changed;
+}
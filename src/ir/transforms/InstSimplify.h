@@ -0,0 +1,31 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_INSTSIMPLIFY_H
+#define STRIDE_LANGUAGE_INSTSIMPLIFY_H
+
+#include "../PassManager.h"
+
+namespace stride::ir
+{
+
+    /**
+     * Folds instructions whose operands are constant, applies algebraic identities
+     * such as <code>x + 0 = x</code>, and removes phi nodes that merge a single value.
+     * Constant operands of commutative operations are moved to the right.
+     */
+    class InstSimplify : public FunctionPass
+    {
+    public:
+        [[nodiscard]] const char *name() const override
+        { return "instsimplify"; }
+
+        [[nodiscard]] uint32_t preservedAnalyses() const override
+        { return ANALYSIS_CFG; }
+
+        bool run(Function &function, AnalysisManager &analyses) override;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_INSTSIMPLIFY_H
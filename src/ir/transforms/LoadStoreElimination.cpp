@@ -0,0 +1,101 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include <unordered_map>
+#include "LoadStoreElimination.h"
+
+using namespace stride::ir;
+
+namespace
+{
+    /**
+     * The value memory at an address is known to have.
+     */
+    struct KnownValue
+    {
+        Value *address;
+        Value *value;
+    };
+
+    /**
+     * Forgets the values of memory an instruction may write to.
+     */
+    void clobber(std::vector<KnownValue> &known, const AliasInfo &aliases, const Instruction *instruction)
+    {
+        known.erase(std::remove_if(known.begin(), known.end(), [ & ](const KnownValue &entry)
+        { return aliases.mayWrite(instruction, entry.address); }), known.end());
+    }
+}
+
+bool LoadStoreElimination::run(Function &function, AnalysisManager &analyses)
+{
+    DominatorTree &dominators = analyses.dominators(function);
+    AliasInfo &aliases = analyses.aliases(function);
+    std::unordered_map<BasicBlock *, std::vector<KnownValue>> knownAtEnd;
+    bool changed = false;
+
+    for ( auto block: dominators.reversePostOrder())
+    {
+        // A single predecessor is visited before the block, as it dominates it.
+        std::vector<KnownValue> known;
+        if ( block->predecessors.size() == 1 && knownAtEnd.count(block->predecessors[ 0 ]) > 0 )
+        {
+            known = knownAtEnd[ block->predecessors[ 0 ]];
+        }
+
+        // Stores that haven't been read since; they're dead if overwritten.
+        std::vector<Instruction *> pendingStores;
+
+        for ( size_t i = 0; i < block->instructions.size(); )
+        {
+            Instruction *instruction = block->instructions[ i ];
+            if ( instruction->opcode == OP_LOAD )
+            {
+                Value *address = instruction->operands[ 0 ];
+                auto entry = std::find_if(known.begin(), known.end(), [ & ](const KnownValue &candidate)
+                {
+                    return aliases.alias(candidate.address, address) == MUST_ALIAS &&
+                           candidate.value->type == instruction->type;
+                });
+                if ( entry != known.end())
+                {
+                    instruction->replaceAllUsesWith(entry->value);
+                    block->erase(instruction);
+                    changed = true;
+                    continue;
+                }
+                pendingStores.erase(std::remove_if(pendingStores.begin(), pendingStores.end(), [ & ](Instruction *store)
+                { return aliases.mayRead(instruction, store->operands[ 0 ]); }), pendingStores.end());
+                known.push_back({ address, instruction });
+            }
+            else if ( instruction->opcode == OP_STORE )
+            {
+                Value *address = instruction->operands[ 0 ];
+                auto overwritten = std::find_if(pendingStores.begin(), pendingStores.end(), [ & ](Instruction *store)
+                { return aliases.alias(store->operands[ 0 ], address) == MUST_ALIAS; });
+                if ( overwritten != pendingStores.end())
+                {
+                    // The overwritten store precedes this one in the block.
+                    block->erase(*overwritten);
+                    pendingStores.erase(overwritten);
+                    changed = true;
+                    i--;
+                }
+                clobber(known, aliases, instruction);
+                known.push_back({ address, instruction->operands[ 1 ] });
+                pendingStores.push_back(instruction);
+            }
+            else
+            {
+                pendingStores.erase(std::remove_if(pendingStores.begin(), pendingStores.end(), [ & ](Instruction *store)
+                { return aliases.mayRead(instruction, store->operands[ 0 ]); }), pendingStores.end());
+                clobber(known, aliases, instruction);
+            }
+            i++;
+        }
+        knownAtEnd[ block ] = std::move(known);
+    }
+    return changed;
+}
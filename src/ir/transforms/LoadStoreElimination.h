@@ -0,0 +1,32 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_LOADSTOREELIMINATION_H
+#define STRIDE_LANGUAGE_LOADSTOREELIMINATION_H
+
+#include "../PassManager.h"
+
+namespace stride::ir
+{
+
+    /**
+     * Removes redundant memory accesses with the alias analysis. Loads of memory whose
+     * value is known, from an earlier load or store, reuse that value. Stores that are
+     * overwritten before the memory can be read are removed. Known values are carried
+     * into blocks that have a single predecessor.
+     */
+    class LoadStoreElimination : public FunctionPass
+    {
+    public:
+        [[nodiscard]] const char *name() const override
+        { return "load-store-elimination"; }
+
+        [[nodiscard]] uint32_t preservedAnalyses() const override
+        { return ANALYSIS_CFG; }
+
+        bool run(Function &function, AnalysisManager &analyses) override;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_LOADSTOREELIMINATION_H
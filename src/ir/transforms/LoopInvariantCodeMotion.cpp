@@ -0,0 +1,103 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include "LoopInvariantCodeMotion.h"
+
+using namespace stride::ir;
+
+/**
+ * Whether a value is the same in every iteration of a loop.
+ */
+static bool isInvariant(const Loop &loop, const Value *value)
+{
+    return value->kind != VALUE_INSTRUCTION || !loop.contains(static_cast<const Instruction *>(value)->block);
+}
+
+/**
+ * Whether an instruction can run when the loop wouldn't have run it, without failing or changing memory.
+ */
+static bool isSpeculatable(const Instruction *instruction)
+{
+    switch ( instruction->opcode )
+    {
+        case OP_SDIV:
+        case OP_UDIV:
+        case OP_SREM:
+        case OP_UREM:
+        {
+            // Only divisions by a constant can't fail; the quotient of the smallest value and -1 doesn't fit.
+            const Value *divisor = instruction->operands[ 1 ];
+            return divisor->kind == VALUE_CONSTANT && static_cast<const Constant *>(divisor)->integer != 0 &&
+                   static_cast<const Constant *>(divisor)->integer != -1;
+        }
+        case OP_FIELD_ADDRESS:
+            return true;
+        default:
+            return instruction->opcode >= OP_ADD && instruction->opcode <= OP_FPTOUI;
+    }
+}
+
+/**
+ * Whether no instruction of a loop may write to an address.
+ */
+static bool isUnmodified(const Loop &loop, const AliasInfo &aliases, const Value *address)
+{
+    for ( auto block: loop.blocks )
+    {
+        for ( auto instruction: block->instructions )
+        {
+            if ( aliases.mayWrite(instruction, address))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool LoopInvariantCodeMotion::run(Function &function, AnalysisManager &analyses)
+{
+    LoopInfo &loops = analyses.loops(function);
+    DominatorTree &dominators = analyses.dominators(function);
+    AliasInfo &aliases = analyses.aliases(function);
+    bool changed = false;
+
+    // Inner loops come first, so invariants move out as far as they can, one loop at a time.
+    for ( auto &loop: loops.loops())
+    {
+        BasicBlock *preheader = loop->preheader();
+        if ( preheader == nullptr )
+        {
+            continue;
+        }
+
+        // Blocks are visited in reverse postorder, so operands are hoisted before their users.
+        for ( auto block: dominators.reversePostOrder())
+        {
+            if ( !loop->contains(block))
+            {
+                continue;
+            }
+            for ( size_t i = 0; i < block->instructions.size(); )
+            {
+                Instruction *instruction = block->instructions[ i ];
+                bool hoistable = isSpeculatable(instruction) ||
+                                 ( instruction->opcode == OP_LOAD && instruction->operands[ 0 ]->kind == VALUE_GLOBAL &&
+                                   isUnmodified(*loop, aliases, instruction->operands[ 0 ]));
+                for ( size_t j = 0; j < instruction->operands.size() && hoistable; j++ )
+                {
+                    hoistable = isInvariant(*loop, instruction->operands[ j ]);
+                }
+                if ( !hoistable )
+                {
+                    i++;
+                    continue;
+                }
+                instruction->moveBefore(preheader->terminator());
+                changed = true;
+            }
+        }
+    }
+    return changed;
+}
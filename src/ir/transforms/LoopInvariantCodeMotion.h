@@ -0,0 +1,32 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_LOOPINVARIANTCODEMOTION_H
+#define STRIDE_LANGUAGE_LOOPINVARIANTCODEMOTION_H
+
+#include "../PassManager.h"
+
+namespace stride::ir
+{
+
+    /**
+     * Moves computations whose operands don't change in a loop to its preheader,
+     * so they run once rather than every iteration. Loads are moved if nothing
+     * in the loop may write to their address, and the address is a global,
+     * so loading it can't fail when the loop doesn't run.
+     */
+    class LoopInvariantCodeMotion : public FunctionPass
+    {
+    public:
+        [[nodiscard]] const char *name() const override
+        { return "licm"; }
+
+        [[nodiscard]] uint32_t preservedAnalyses() const override
+        { return ANALYSIS_CFG; }
+
+        bool run(Function &function, AnalysisManager &analyses) override;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_LOOPINVARIANTCODEMOTION_H
@@ -0,0 +1,231 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include <unordered_set>
+#include "SimplifyCFG.h"
+
+using namespace stride::ir;
+
+/**
+ * Replaces the terminator of a block by a branch to one of its targets.
+ * The block is removed from the predecessors of the other targets.
+ */
+static void replaceByBranch(BasicBlock *block, BasicBlock *target)
+{
+    Instruction *terminator = block->terminator();
+    bool kept = false;
+    for ( auto successor: terminator->targets )
+    {
+        if ( successor == target && !kept )
+        {
+            kept = true;
+            continue;
+        }
+        successor->removePredecessor(block);
+    }
+    terminator->dropOperands();
+    terminator->opcode = OP_BRANCH;
+    terminator->targets = { target };
+}
+
+/**
+ * Makes branches whose destination is known unconditional.
+ */
+static bool foldBranches(Function &function)
+{
+    bool changed = false;
+    for ( auto block: function.blocks )
+    {
+        Instruction *terminator = block->terminator();
+        if ( terminator->opcode == OP_CONDITIONAL_BRANCH )
+        {
+            Value *condition = terminator->operands[ 0 ];
+            if ( condition->kind == VALUE_CONSTANT )
+            {
+                replaceByBranch(block, terminator->targets[ static_cast<Constant *>(condition)->integer != 0 ? 0 : 1 ]);
+                changed = true;
+            }
+            else if ( terminator->targets[ 0 ] == terminator->targets[ 1 ] )
+            {
+                replaceByBranch(block, terminator->targets[ 0 ]);
+                changed = true;
+            }
+        }
+        else if ( terminator->opcode == OP_SWITCH && terminator->operands[ 0 ]->kind == VALUE_CONSTANT &&
+                  isInteger(terminator->operands[ 0 ]->type))
+        {
+            int64_t value = static_cast<Constant *>(terminator->operands[ 0 ])->integer;
+            BasicBlock *target = terminator->targets[ 0 ];
+            for ( size_t i = 1; i < terminator->operands.size(); i++ )
+            {
+                if ( static_cast<Constant *>(terminator->operands[ i ])->integer == value )
+                {
+                    target = terminator->targets[ i ];
+                    break;
+                }
+            }
+            replaceByBranch(block, target);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+/**
+ * Removes the blocks that can't be reached from the entry.
+ */
+static bool removeUnreachableBlocks(Function &function)
+{
+    std::unordered_set<BasicBlock *> reachable = { function.entry() };
+    std::vector<BasicBlock *> worklist = { function.entry() };
+    while ( !worklist.empty())
+    {
+        BasicBlock *block = worklist.back();
+        worklist.pop_back();
+        for ( auto successor: block->successors())
+        {
+            if ( reachable.insert(successor).second )
+            {
+                worklist.push_back(successor);
+            }
+        }
+    }
+    if ( reachable.size() == function.blocks.size())
+    {
+        return false;
+    }
+
+    std::vector<BasicBlock *> unreachable;
+    for ( auto block: function.blocks )
+    {
+        if ( reachable.count(block) == 0 )
+        {
+            unreachable.push_back(block);
+        }
+    }
+    for ( auto block: unreachable )
+    {
+        for ( auto successor: block->successors())
+        {
+            successor->removePredecessor(block);
+        }
+    }
+    // Values of unreachable blocks can only be used by other unreachable blocks.
+    for ( auto block: unreachable )
+    {
+        for ( auto instruction: block->instructions )
+        {
+            instruction->dropOperands();
+            instruction->block = nullptr;
+        }
+    }
+    for ( auto block: unreachable )
+    {
+        block->instructions.clear();
+    }
+    function.blocks.erase(std::remove_if(function.blocks.begin(), function.blocks.end(), [ &reachable ](BasicBlock *block)
+    { return reachable.count(block) == 0; }), function.blocks.end());
+    return true;
+}
+
+/**
+ * Merges blocks into their predecessor, if it's their only predecessor and they're its only successor.
+ */
+static bool mergeBlocks(Function &function)
+{
+    bool changed = false;
+    for ( size_t i = 1; i < function.blocks.size(); )
+    {
+        BasicBlock *block = function.blocks[ i ];
+        if ( block->predecessors.size() != 1 )
+        {
+            i++;
+            continue;
+        }
+        BasicBlock *predecessor = block->predecessors[ 0 ];
+        Instruction *branch = predecessor->terminator();
+        if ( predecessor == block || branch->opcode != OP_BRANCH )
+        {
+            i++;
+            continue;
+        }
+
+        // Phi nodes of a block with a single predecessor have a single value.
+        while ( !block->instructions.empty() && block->instructions.front()->opcode == OP_PHI )
+        {
+            Instruction *phi = block->instructions.front();
+            phi->replaceAllUsesWith(phi->operands[ 0 ]);
+            block->erase(phi);
+        }
+        predecessor->erase(branch);
+        for ( auto instruction: block->instructions )
+        {
+            instruction->block = predecessor;
+            predecessor->instructions.push_back(instruction);
+        }
+        block->instructions.clear();
+        for ( auto successor: predecessor->successors())
+        {
+            successor->replacePredecessor(block, predecessor);
+        }
+        function.blocks.erase(function.blocks.begin() + (long) i);
+        changed = true;
+    }
+    return changed;
+}
+
+/**
+ * Redirects branches to blocks that only branch elsewhere. Targets with phi nodes
+ * are left as they are, since their values would have to be merged.
+ */
+static bool bypassEmptyBlocks(Function &function)
+{
+    bool changed = false;
+    for ( size_t i = 1; i < function.blocks.size(); i++ )
+    {
+        BasicBlock *block = function.blocks[ i ];
+        Instruction *branch = block->terminator();
+        if ( block->instructions.size() != 1 || branch->opcode != OP_BRANCH )
+        {
+            continue;
+        }
+        BasicBlock *target = branch->targets[ 0 ];
+        if ( target == block || ( !target->instructions.empty() && target->instructions.front()->opcode == OP_PHI ))
+        {
+            continue;
+        }
+
+        std::vector<BasicBlock *> predecessors = block->predecessors;
+        for ( auto predecessor: predecessors )
+        {
+            Instruction *terminator = predecessor->terminator();
+            for ( auto &successor: terminator->targets )
+            {
+                if ( successor == block )
+                {
+                    successor = target;
+                    block->removePredecessor(predecessor);
+                    target->predecessors.push_back(predecessor);
+                    changed = true;
+                }
+            }
+        }
+    }
+    return changed;
+}
+
+bool SimplifyCFG::run(Function &function, AnalysisManager &)
+{
+    bool changed = false;
+    for ( bool iterationChanged = true; iterationChanged; )
+    {
+        iterationChanged = foldBranches(function);
+        iterationChanged |= bypassEmptyBlocks(function);
+        iterationChanged |= removeUnreachableBlocks(function);
+        iterationChanged |= mergeBlocks(function);
+        changed |= iterationChanged;
+    }
+    return changed;
+}
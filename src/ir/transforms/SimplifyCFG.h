@@ -0,0 +1,28 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_SIMPLIFYCFG_H
+#define STRIDE_LANGUAGE_SIMPLIFYCFG_H
+
+#include "../PassManager.h"
+
+namespace stride::ir
+{
+
+    /**
+     * Simplifies the control flow graph. Branches on constants become unconditional,
+     * blocks that can't be reached are removed, blocks are merged into their only
+     * predecessor, and blocks that only branch elsewhere are bypassed.
+     */
+    class SimplifyCFG : public FunctionPass
+    {
+    public:
+        [[nodiscard]] const char *name() const override
+        { return "simplifycfg"; }
+
+        bool run(Function &function, AnalysisManager &analyses) override;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_SIMPLIFYCFG_H
@@ -1,12 +1,78 @@
+#include <algorithm>
 #include <iostream>
 #include "StrideFile.h"
+#include "CompilerOptions.h"
+#include "daemon/CompileClient.h"
+#include "daemon/CompileServer.h"
+#include "daemon/Protocol.h"
+#include "modules/ModuleScheduler.h"
 
 using namespace stride;
 
+/**
+ * Runs the compile server until it's stopped.
+ * The server accepts the 'jobs' option, the amount of concurrently handled
+ * requests, and 'cache-memory', the size of the in-memory cache in megabytes.
+ */
+int serve(const std::string &socketPath, std::vector<std::string> &arguments)
+{
+    unsigned int workerCount = 0;
+    size_t memoryCapacity = DAEMON_DEFAULT_MEMORY_CAPACITY;
+    std::string value;
+    if ( extractOption(arguments, "jobs", value))
+    {
+        workerCount = (unsigned int) strtoul(value.c_str(), nullptr, 10);
+    }
+    if ( extractOption(arguments, "cache-memory", value))
+    {
+        memoryCapacity = (size_t) strtoull(value.c_str(), nullptr, 10) << 20;
+    }
+
+    daemon::CompileServer server(socketPath, workerCount, memoryCapacity);
+    if ( !server.start(std::cerr))
+    {
+        return 1;
+    }
+    std::cout << "Compile server listening on " << socketPath << std::endl;
+    server.serve();
+    return 0;
+}
+
 int main(const int argc, const char **argv)
 {
+    std::vector<std::string> arguments(argv + 1, argv + argc);
+    std::string socketPath;
 
-    if ( argc < 2 )
+    // '--serve[=socket]' starts a compile server. '--remote[=socket]' forwards the
+    // compilation to a running server, and compiles locally if none is reachable.
+    // '--stop-server[=socket]' stops a running server.
+    if ( extractOption(arguments, "serve", socketPath))
+    {
+        return serve(socketPath.empty() ? daemon::defaultSocketPath() : socketPath, arguments);
+    }
+    if ( extractOption(arguments, "stop-server", socketPath))
+    {
+        auto exitCode = daemon::forwardToServer(socketPath.empty() ? daemon::defaultSocketPath() : socketPath,
+                                                { "--stop-server" }, std::cout, std::cerr);
+        if ( !exitCode )
+        {
+            std::cerr << "No compile server is running." << std::endl;
+        }
+        return exitCode.value_or(1);
+    }
+    // Programs are interpreted locally; the server has neither the terminal nor the environment of the program.
+    bool interprets = std::find(arguments.begin(), arguments.end(), "--interpret") != arguments.end();
+    if ( extractOption(arguments, "remote", socketPath) && !interprets )
+    {
+        auto exitCode = daemon::forwardToServer(socketPath.empty() ? daemon::defaultSocketPath() : socketPath,
+                                                arguments, std::cout, std::cerr);
+        if ( exitCode )
+        {
+            return *exitCode;
+        }
+    }
+
+    if ( arguments.empty())
     {
         std::cerr << "No input file provided" << std::endl;
         std::cerr << "Run the program as followed:" << std::endl;
@@ -14,10 +80,25 @@ int main(const int argc, const char **argv)
         exit(1);
     }
 
-    auto *file = new stride::StrideFile(argv[ 1 ]);
-    file->compile();
+    auto *file = new stride::StrideFile(arguments.back().c_str());
+    arguments.pop_back();
 
-    return 0;
-}
+    // Options are provided as '--flag' or '--flag=value' before the input file.
+    if ( !applyCompilerOptions(*file, arguments, std::cerr))
+    {
+        delete file;
+        return 1;
+    }
 
+    // '--interpret' runs the file with the bytecode interpreter, rather than compiling it.
+    if ( file->hasCompilerFlag("interpret"))
+    {
+        int exitCode = stride::modules::interpretProgram(*file);
+        delete file;
+        return exitCode;
+    }
+    bool success = stride::modules::compileProgram(*file);
+    delete file;
 
+    return success ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include "ImportResolver.h"
+
+using namespace stride::modules;
+
+void ImportResolver::addSearchPath(const std::filesystem::path &directory)
+{
+    this->searchPaths.push_back(directory);
+}
+
+void ImportResolver::addSearchPaths(const std::string &directories)
+{
+    size_t start = 0;
+    while ( start <= directories.size())
+    {
+        size_t end = directories.find(':', start);
+        if ( end == std::string::npos )
+        {
+            end = directories.size();
+        }
+        if ( end > start )
+        {
+            this->addSearchPath(directories.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+}
+
+const std::vector<std::filesystem::path> &ImportResolver::getSearchPaths() const
+{
+    return this->searchPaths;
+}
+
+std::string ImportResolver::toRelativePath(const std::string &importName)
+{
+    std::string name = importName;
+    if ( name.size() >= 2 && name.front() == '"' && name.back() == '"' )
+    {
+        name = name.substr(1, name.size() - 2);
+    }
+    if ( name.empty())
+    {
+        return name;
+    }
+
+    if ( std::filesystem::path(name).extension() != STRIDE_SOURCE_EXTENSION )
+    {
+        name.append(STRIDE_SOURCE_EXTENSION);
+    }
+    return name;
+}
+
+std::string ImportResolver::canonicalize(const std::filesystem::path &path)
+{
+    std::error_code error;
+    auto canonical = std::filesystem::weakly_canonical(path, error);
+    return error ? std::filesystem::absolute(path).lexically_normal().string() : canonical.string();
+}
+
+std::optional<std::string> ImportResolver::resolve(const std::string &importName,
+                                                   const std::string &importingFile) const
+{
+    std::string relativePath = toRelativePath(importName);
+    if ( relativePath.empty())
+    {
+        return std::nullopt;
+    }
+
+    std::vector<std::filesystem::path> candidates;
+    if ( std::filesystem::path(relativePath).is_absolute())
+    {
+        candidates.emplace_back(relativePath);
+    }
+    else
+    {
+        candidates.push_back(std::filesystem::path(importingFile).parent_path() / relativePath);
+        for ( auto &directory: this->searchPaths )
+        {
+            candidates.push_back(directory / relativePath);
+        }
+    }
+
+    for ( auto &candidate: candidates )
+    {
+        std::error_code error;
+        if ( std::filesystem::is_regular_file(candidate, error))
+        {
+            return canonicalize(candidate);
+        }
+    }
+    return std::nullopt;
+}
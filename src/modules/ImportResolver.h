@@ -0,0 +1,74 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_IMPORTRESOLVER_H
+#define STRIDE_LANGUAGE_IMPORTRESOLVER_H
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#define STRIDE_SOURCE_EXTENSION ".sr"
+
+namespace stride::modules
+{
+
+    /**
+     * Maps the names used in import statements to source files.
+     * An import name is a path relative to the importing file, or to one of
+     * the search paths, with or without the source file extension:
+     * <code>
+     * import "math/vector";
+     * </code>
+     * Resolved paths are canonical, so a file that is imported through
+     * different names is only loaded once.
+     */
+    class ImportResolver
+    {
+    private:
+        std::vector<std::filesystem::path> searchPaths;
+
+    public:
+
+        ImportResolver() = default;
+
+        /**
+         * Adds a directory in which imports are looked up, after the
+         * directory of the importing file. Directories are searched in the
+         * order in which they were added.
+         */
+        void addSearchPath(const std::filesystem::path &directory);
+
+        /**
+         * Adds every directory in a list separated by ':'.
+         */
+        void addSearchPaths(const std::string &directories);
+
+        [[nodiscard]] const std::vector<std::filesystem::path> &getSearchPaths() const;
+
+        /**
+         * Converts the name of an import statement into a relative file path.
+         * Surrounding quotes are removed, and the source file extension is added if missing.
+         * @return The relative path, or an empty string if the name is empty.
+         */
+        static std::string toRelativePath(const std::string &importName);
+
+        /**
+         * Returns the canonical form of a path, used to identify modules.
+         */
+        static std::string canonicalize(const std::filesystem::path &path);
+
+        /**
+         * Resolves an import.
+         * @param importName The name as written in the import statement.
+         * @param importingFile The path of the file that contains the import.
+         * @return The canonical path of the imported file, or nothing if no file matches.
+         */
+        [[nodiscard]] std::optional<std::string> resolve(const std::string &importName,
+                                                         const std::string &importingFile) const;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_IMPORTRESOLVER_H
@@ -0,0 +1,224 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include "ModuleGraph.h"
+#include "../syntax_tree/ASTNodes.h"
+#include "../syntax_tree/node_types/definitions/NImportStatement.h"
+#include "../syntax_tree/node_types/definitions/NModuleDeclaration.h"
+
+using namespace stride::modules;
+
+ModuleGraph::ModuleGraph(ImportResolver resolver, std::function<void(StrideFile &)> configure) :
+        resolver(std::move(resolver)),
+        configure(std::move(configure)),
+        entry(nullptr)
+{}
+
+ModuleGraph::~ModuleGraph()
+{
+    for ( auto module: this->modules )
+    {
+        if ( module != this->entry )
+        {
+            delete module->file;
+        }
+        delete module;
+    }
+}
+
+void ModuleGraph::collectImports(ast::Node *node, std::vector<NImportStatement *> &dst)
+{
+    for ( size_t i = 0; i < node->getChildCount(); i++ )
+    {
+        ast::Node *child = node->getChild(i);
+        switch ( child->getType())
+        {
+            case ast::IMPORT_STATEMENT:
+                dst.push_back(dynamic_cast<NImportStatement *>(child));
+                break;
+            case ast::MODULE_DECLARATION:
+            {
+                auto body = dynamic_cast<NModuleDeclaration *>(child)->getBody();
+                if ( body != nullptr )
+                {
+                    collectImports(body, dst);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+Module *ModuleGraph::getOrCreate(const std::string &path, bool &created)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    auto existing = this->modulesByPath.find(path);
+    if ( existing != this->modulesByPath.end())
+    {
+        created = false;
+        return existing->second;
+    }
+
+    auto module = new Module { (unsigned int) this->modules.size(), path, nullptr, {}, {}, {}, false };
+    this->modules.push_back(module);
+    this->modulesByPath[ path ] = module;
+    created = true;
+    return module;
+}
+
+void ModuleGraph::discover(Module *module, ThreadPool &pool)
+{
+    ast::Node *root = module->file->parse();
+    if ( root == nullptr )
+    {
+        return;
+    }
+
+    std::vector<NImportStatement *> imports;
+    collectImports(root, imports);
+
+    try
+    {
+        for ( auto import: imports )
+        {
+            int start = std::max(import->getSourceStart(), 0);
+            int length = import->hasSourceRange() ? import->getSourceEnd() - start : 0;
+
+            auto path = this->resolver.resolve(import->getModuleName(), module->path);
+            if ( !path )
+            {
+                module->file->diagnostics().report(
+                        error::ERROR, start, length,
+                        "Unable to resolve import " + import->getModuleName() + ".");
+                continue;
+            }
+
+            bool created;
+            Module *dependency = this->getOrCreate(*path, created);
+            if ( created )
+            {
+                // The file is only read and parsed by the worker, so the
+                // lock isn't held whilst reading from disk.
+                dependency->file = new StrideFile(path->c_str());
+                this->configure(*dependency->file);
+                pool.submit([ this, dependency, &pool ] { this->discover(dependency, pool); });
+            }
+
+            if ( std::find(module->dependencies.begin(), module->dependencies.end(), dependency) !=
+                 module->dependencies.end())
+            {
+                module->file->diagnostics().report(
+                        error::WARNING, start, length,
+                        "Module " + import->getModuleName() + " is imported multiple times.");
+                continue;
+            }
+            module->dependencies.push_back(dependency);
+            module->importStatements.push_back(import);
+
+            std::lock_guard<std::mutex> lock(this->mutex);
+            dependency->dependents.push_back(module);
+        }
+    }
+    catch ( const error::FatalError & )
+    {
+        // The error limit of the file is reached; the error is already recorded.
+    }
+}
+
+void ModuleGraph::sort()
+{
+    enum
+    {
+        UNVISITED, ACTIVE, DONE
+    };
+    std::vector<int> states(this->modules.size(), UNVISITED);
+
+    // Iterative depth-first search, so deep import chains can't overflow the stack.
+    // Every frame holds a module and the index of the next dependency to visit.
+    std::vector<std::pair<Module *, size_t>> stack;
+    stack.emplace_back(this->entry, 0);
+    states[ this->entry->id ] = ACTIVE;
+
+    while ( !stack.empty())
+    {
+        auto &[ module, next ] = stack.back();
+        if ( next == module->dependencies.size())
+        {
+            states[ module->id ] = DONE;
+            this->order.push_back(module);
+            stack.pop_back();
+            continue;
+        }
+
+        Module *dependency = module->dependencies[ next ];
+        NImportStatement *import = module->importStatements[ next ];
+        next++;
+
+        if ( states[ dependency->id ] == UNVISITED )
+        {
+            states[ dependency->id ] = ACTIVE;
+            stack.emplace_back(dependency, 0);
+            continue;
+        }
+        if ( states[ dependency->id ] == DONE )
+        {
+            continue;
+        }
+
+        // The dependency is still on the stack, so this import closes a cycle.
+        std::string cycle;
+        size_t first = 0;
+        while ( stack[ first ].first != dependency )
+        {
+            first++;
+        }
+        for ( size_t i = first; i < stack.size(); i++ )
+        {
+            stack[ i ].first->cyclic = true;
+            cycle.append(stack[ i ].first->file->path()).append(" -> ");
+        }
+        cycle.append(dependency->file->path());
+
+        int start = std::max(import->getSourceStart(), 0);
+        try
+        {
+            module->file->diagnostics().report(
+                    error::ERROR, start, import->hasSourceRange() ? import->getSourceEnd() - start : 0,
+                    "Import cycle detected: " + cycle);
+        }
+        catch ( const error::FatalError & )
+        {}
+    }
+}
+
+void ModuleGraph::build(StrideFile &entryFile, ThreadPool &pool)
+{
+    bool created;
+    this->entry = this->getOrCreate(ImportResolver::canonicalize(entryFile.path()), created);
+    this->entry->file = &entryFile;
+
+    pool.submit([ this, &pool ] { this->discover(this->entry, pool); });
+    pool.wait();
+
+    this->sort();
+}
+
+Module *ModuleGraph::getEntry() const
+{
+    return this->entry;
+}
+
+const std::vector<Module *> &ModuleGraph::getModules() const
+{
+    return this->modules;
+}
+
+const std::vector<Module *> &ModuleGraph::getDependencyOrder() const
+{
+    return this->order;
+}
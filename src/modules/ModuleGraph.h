@@ -0,0 +1,140 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_MODULEGRAPH_H
+#define STRIDE_LANGUAGE_MODULEGRAPH_H
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ImportResolver.h"
+#include "ThreadPool.h"
+#include "../StrideFile.h"
+
+class NImportStatement;
+
+namespace stride::modules
+{
+
+    /**
+     * A source file in the import graph.
+     */
+    struct Module
+    {
+        unsigned int id;
+
+        /**
+         * Canonical path of the source file, which identifies the module.
+         */
+        std::string path;
+        StrideFile *file;
+
+        /**
+         * Modules imported by this module, in order of their import statements.
+         * Every module appears once, even if it's imported multiple times.
+         */
+        std::vector<Module *> dependencies;
+
+        /**
+         * The import statement of every dependency, used for diagnostics.
+         */
+        std::vector<NImportStatement *> importStatements;
+
+        /**
+         * Modules that import this module.
+         */
+        std::vector<Module *> dependents;
+
+        /**
+         * Whether the module is part of an import cycle.
+         * Such modules can't be compiled, as there's no valid order to do so in.
+         */
+        bool cyclic;
+    };
+
+    /**
+     * Dependency graph of a program.
+     * The graph is built by parsing the entry file, and then every file it
+     * imports, transitively. Files are parsed in parallel as soon as they are
+     * discovered.
+     */
+    class ModuleGraph
+    {
+    private:
+        ImportResolver resolver;
+        std::function<void(StrideFile &)> configure;
+
+        std::vector<Module *> modules;
+        std::unordered_map<std::string, Module *> modulesByPath;
+        std::vector<Module *> order;
+        std::mutex mutex;
+
+        Module *entry;
+
+        /**
+         * Returns the module of the provided path, creating it if it doesn't exist yet.
+         * @param created Set to whether the module was created by this call.
+         */
+        Module *getOrCreate(const std::string &path, bool &created);
+
+        /**
+         * Parses a module, resolves its imports and schedules the discovery
+         * of every newly found module.
+         */
+        void discover(Module *module, ThreadPool &pool);
+
+        /**
+         * Computes the dependency order and marks every module that
+         * is part of a cycle. Every cycle is reported once.
+         */
+        void sort();
+
+    public:
+
+        /**
+         * @param resolver The resolver used to locate imported files.
+         * @param configure Called for every imported file before it's parsed,
+         * e.g. to apply the compiler flags of the entry file.
+         */
+        ModuleGraph(ImportResolver resolver, std::function<void(StrideFile &)> configure);
+
+        ~ModuleGraph();
+
+        ModuleGraph(const ModuleGraph &) = delete;
+
+        ModuleGraph &operator=(const ModuleGraph &) = delete;
+
+        /**
+         * Builds the graph of the program with the provided entry file.
+         * The entry file is not owned by the graph; all imported files are.
+         * Unresolvable imports and import cycles are reported to the
+         * diagnostics of the importing file.
+         */
+        void build(StrideFile &entryFile, ThreadPool &pool);
+
+        [[nodiscard]] Module *getEntry() const;
+
+        /**
+         * Returns all modules, in order of discovery.
+         */
+        [[nodiscard]] const std::vector<Module *> &getModules() const;
+
+        /**
+         * Returns all modules in dependency order; every module comes after
+         * the modules it imports. The order only depends on the order of
+         * the import statements, not on the order in which files were parsed.
+         */
+        [[nodiscard]] const std::vector<Module *> &getDependencyOrder() const;
+
+        /**
+         * Collects the import statements of a syntax tree,
+         * including those in module declarations.
+         */
+        static void collectImports(ast::Node *node, std::vector<NImportStatement *> &dst);
+    };
+}
+
+#endif //STRIDE_LANGUAGE_MODULEGRAPH_H
@@ -0,0 +1,249 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include "ModuleScheduler.h"
+#include "../cache/CompilationCache.h"
+#include "../vm/Interpreter.h"
+
+using namespace stride;
+using namespace stride::modules;
+
+ModuleScheduler::ModuleScheduler(ModuleGraph &graph, ThreadPool &pool, std::function<bool(Module &)> compileModule) :
+        graph(graph),
+        pool(pool),
+        compileModule(std::move(compileModule))
+{
+    size_t moduleCount = graph.getModules().size();
+    this->remainingDependencies = std::make_unique<std::atomic<unsigned int>[]>(moduleCount);
+    this->states = std::make_unique<std::atomic<int>[]>(moduleCount);
+
+    for ( auto module: graph.getModules())
+    {
+        this->remainingDependencies[ module->id ] = (unsigned int) module->dependencies.size();
+        this->states[ module->id ] = MODULE_PENDING;
+    }
+}
+
+void ModuleScheduler::schedule(Module *module)
+{
+    this->pool.submit([ this, module ]
+                      {
+                          // A module is only scheduled once all its dependencies finished,
+                          // so a failed dependency is visible here.
+                          for ( auto dependency: module->dependencies )
+                          {
+                              if ( this->states[ dependency->id ] != MODULE_COMPILED )
+                              {
+                                  this->finish(module, MODULE_SKIPPED);
+                                  return;
+                              }
+                          }
+                          this->finish(module, this->compileModule(*module) ? MODULE_COMPILED : MODULE_FAILED);
+                      });
+}
+
+void ModuleScheduler::finish(Module *module, EModuleState state)
+{
+    this->states[ module->id ] = state;
+
+    for ( auto dependent: module->dependents )
+    {
+        // Modules in a cycle are never scheduled; their dependencies can't all finish.
+        if ( !dependent->cyclic && --this->remainingDependencies[ dependent->id ] == 0 )
+        {
+            this->schedule(dependent);
+        }
+    }
+}
+
+bool ModuleScheduler::run()
+{
+    std::vector<Module *> ready;
+    for ( auto module: this->graph.getDependencyOrder())
+    {
+        if ( module->cyclic )
+        {
+            this->finish(module, MODULE_FAILED);
+        }
+        else if ( module->dependencies.empty())
+        {
+            ready.push_back(module);
+        }
+    }
+    for ( auto module: ready )
+    {
+        this->schedule(module);
+    }
+    this->pool.wait();
+
+    bool success = true;
+    for ( auto module: this->graph.getModules())
+    {
+        success &= this->states[ module->id ] == MODULE_COMPILED;
+    }
+    return success;
+}
+
+EModuleState ModuleScheduler::getState(const Module &module) const
+{
+    return (EModuleState) this->states[ module.id ].load();
+}
+
+/**
+ * Flags with the path of an output file as value.
+ */
+static const std::string outputPathFlags[] = {
+        "emit-asm",
+        "emit-ast",
+        "emit-c"
+};
+
+/**
+ * Builds a program; the entry file, and every file it imports, each with buildFile.
+ * The reports that a file writes are collected per file, and written to out in dependency order along
+ * with the diagnostics, so those of concurrently built files don't interleave.
+ * Once all files are built, built is called with the modules in dependency order, while they're still alive.
+ * @return Whether all modules built without errors.
+ */
+static bool buildProgram(StrideFile &entryFile, std::ostream &out, std::ostream &err,
+                         const std::function<bool(StrideFile &, std::ostream &)> &buildFile,
+                         const std::function<void(const std::vector<Module *> &)> &built)
+{
+    ImportResolver resolver;
+    if ( entryFile.hasCompilerFlag("import-path") &&
+         std::holds_alternative<std::string>(entryFile.getCompilerFlag("import-path")))
+    {
+        resolver.addSearchPaths(std::get<std::string>(entryFile.getCompilerFlag("import-path")));
+    }
+    const char *environmentPaths = entryFile.environmentVariable("STRIDE_PATH");
+    if ( environmentPaths != nullptr )
+    {
+        resolver.addSearchPaths(environmentPaths);
+    }
+
+    unsigned int jobs = 0;
+    if ( entryFile.hasCompilerFlag("jobs") &&
+         std::holds_alternative<long int>(entryFile.getCompilerFlag("jobs")))
+    {
+        jobs = (unsigned int) std::max(std::get<long int>(entryFile.getCompilerFlag("jobs")), 0L);
+    }
+
+    // All modules share the cache of the entry file.
+    cache::CompilationCache *cache = entryFile.getCompilationCache();
+
+    ModuleGraph graph(resolver, [ &entryFile, cache ](StrideFile &file)
+    {
+        for ( auto &[ flag, value ]: entryFile.getCompilerFlags())
+        {
+            std::string name = flag;
+
+            // An explicit output path only applies to the entry file; imported files write next to their source.
+            bool isOutputPath = std::find(std::begin(outputPathFlags), std::end(outputPathFlags), flag) !=
+                                std::end(outputPathFlags);
+            if ( isOutputPath && std::holds_alternative<std::string>(value))
+            {
+                file.setCompilerFlag(name, 1L);
+                continue;
+            }
+            file.setCompilerFlag(name, value);
+        }
+        file.setCompilationCache(cache);
+        file.setEnvironment(entryFile.getEnvironment());
+    });
+
+    bool success;
+    {
+        ThreadPool pool(jobs);
+        graph.build(entryFile, pool);
+        std::vector<std::ostringstream> reports(graph.getModules().size());
+
+        // A module is only built once its dependencies are, so their declarations are complete.
+        ModuleScheduler scheduler(graph, pool, [ &buildFile, &reports ](Module &module)
+        {
+            std::vector<StrideFile *> imports;
+            for ( auto dependency: module.dependencies )
+            {
+                imports.push_back(dependency->file);
+            }
+            module.file->setImports(imports);
+            return buildFile(*module.file, reports[ module.id ]);
+        });
+        success = scheduler.run();
+
+        for ( auto module: graph.getDependencyOrder())
+        {
+            out << reports[ module->id ].str();
+            module->file->diagnostics().render(err);
+
+            if ( scheduler.getState(*module) == MODULE_SKIPPED )
+            {
+                err << module->file->path() << " was not compiled, as one of its imports failed to compile."
+                    << std::endl;
+            }
+        }
+        if ( success && built )
+        {
+            built(graph.getDependencyOrder());
+        }
+    }
+
+    if ( cache && entryFile.hasCompilerFlag("cache-stats"))
+    {
+        cache->getStatistics().print(out);
+    }
+    return success;
+}
+
+bool stride::modules::compileProgram(StrideFile &entryFile, std::ostream &out, std::ostream &err)
+{
+    return buildProgram(entryFile, out, err, [](StrideFile &file, std::ostream &reports)
+    {
+        return file.build(reports);
+    }, nullptr);
+}
+
+int stride::modules::interpretProgram(StrideFile &entryFile, std::ostream &out, std::ostream &err)
+{
+    std::unique_ptr<vm::BytecodeModule> program;
+    bool success = buildProgram(entryFile, out, err, [](StrideFile &file, std::ostream &reports)
+    {
+        return file.buildBytecode(reports);
+    }, [ &entryFile, &program, &err ](const std::vector<Module *> &order)
+    {
+        std::vector<const vm::BytecodeModule *> units;
+        for ( auto module: order )
+        {
+            units.push_back(module->file->getBytecode());
+        }
+        try
+        {
+            program = std::make_unique<vm::BytecodeModule>(vm::linkModules(entryFile.path(), units));
+        }
+        catch ( const std::runtime_error &error )
+        {
+            err << error.what() << std::endl;
+        }
+    });
+    if ( !success || program == nullptr )
+    {
+        return 1;
+    }
+
+    // The reports of the compilation precede the output of the program.
+    out.flush();
+    try
+    {
+        vm::Interpreter interpreter(*program, !entryFile.hasCompilerFlag("no-jit"));
+        return interpreter.run();
+    }
+    catch ( const vm::RuntimeError &error )
+    {
+        std::cout.flush();
+        err << "Runtime error: " << error.what() << std::endl;
+        return 1;
+    }
+}
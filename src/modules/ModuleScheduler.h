@@ -0,0 +1,100 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_MODULESCHEDULER_H
+#define STRIDE_LANGUAGE_MODULESCHEDULER_H
+
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include "ModuleGraph.h"
+#include "ThreadPool.h"
+
+namespace stride::modules
+{
+
+    enum EModuleState
+    {
+        MODULE_PENDING,
+        MODULE_COMPILED,
+        MODULE_FAILED,
+
+        /* Not compiled, because one of its dependencies failed. */
+        MODULE_SKIPPED
+    };
+
+    /**
+     * Compiles the modules of a graph in dependency order.
+     * A module is submitted to the thread pool as soon as all of its
+     * dependencies are compiled, so independent modules are compiled
+     * concurrently, and no module waits on modules it doesn't import.
+     */
+    class ModuleScheduler
+    {
+    private:
+        ModuleGraph &graph;
+        ThreadPool &pool;
+        std::function<bool(Module &)> compileModule;
+
+        /**
+         * Per module, indexed by id: the amount of dependencies that
+         * haven't finished yet, and the state of the module.
+         */
+        std::unique_ptr<std::atomic<unsigned int>[]> remainingDependencies;
+        std::unique_ptr<std::atomic<int>[]> states;
+
+        void schedule(Module *module);
+
+        void finish(Module *module, EModuleState state);
+
+    public:
+
+        /**
+         * @param compileModule Compiles a single module.
+         * Returns whether the module compiled successfully.
+         */
+        ModuleScheduler(ModuleGraph &graph, ThreadPool &pool, std::function<bool(Module &)> compileModule);
+
+        /**
+         * Compiles all modules of the graph, and waits for them to finish.
+         * @return Whether all modules compiled successfully.
+         */
+        bool run();
+
+        [[nodiscard]] EModuleState getState(const Module &module) const;
+    };
+
+    /**
+     * Compiles a program; the entry file, and every file it imports.
+     * Imported files inherit the compiler flags and the compilation cache
+     * of the entry file. The following flags are used:
+     * <ul>
+     *  <li>jobs: the amount of worker threads. Defaults to one per hardware thread.</li>
+     *  <li>import-path: directories, separated by ':', in which imports are looked up
+     *      after the directory of the importing file. The STRIDE_PATH environment
+     *      variable is searched afterwards.</li>
+     * </ul>
+     * Diagnostics are rendered once all modules have finished, in dependency order.
+     * @param out The stream to write compiler statistics to.
+     * @param err The stream to render diagnostics to.
+     * @return Whether all modules compiled without errors.
+     */
+    bool compileProgram(StrideFile &entryFile, std::ostream &out = std::cout, std::ostream &err = std::cerr);
+
+    /**
+     * Interprets a program; the entry file, and every file it imports, are compiled to bytecode like
+     * in compileProgram, and linked in dependency order. The initializers of all modules run first,
+     * in that order, and then 'main', if the program defines it.
+     * Functions that aren't defined in the program are called as native functions of the same name,
+     * and the runtime is provided by the interpreter. Hot functions are compiled to machine code,
+     * unless '--no-jit' is given.
+     * @param out The stream to write compiler statistics to.
+     * @param err The stream to render diagnostics and runtime errors to.
+     * @return The exit code of the program, or 1 if it doesn't compile or fails.
+     */
+    int interpretProgram(StrideFile &entryFile, std::ostream &out = std::cout, std::ostream &err = std::cerr);
+}
+
+#endif //STRIDE_LANGUAGE_MODULESCHEDULER_H
@@ -0,0 +1,102 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include "ThreadPool.h"
+
+using namespace stride::modules;
+
+ThreadPool::ThreadPool(unsigned int threadCount) : pendingTasks(0), stopping(false)
+{
+    if ( threadCount == 0 )
+    {
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    this->workers.reserve(threadCount);
+    for ( unsigned int i = 0; i < threadCount; i++ )
+    {
+        this->workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->idle.wait(lock, [this] { return this->pendingTasks == 0; });
+        this->stopping = true;
+    }
+    this->taskAvailable.notify_all();
+
+    for ( auto &worker: this->workers )
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::work()
+{
+    while ( true )
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->taskAvailable.wait(lock, [this] { return this->stopping || !this->queue.empty(); });
+            if ( this->queue.empty())
+            {
+                return;
+            }
+            task = std::move(this->queue.front());
+            this->queue.pop_front();
+        }
+
+        std::exception_ptr exception;
+        try
+        {
+            task();
+        }
+        catch ( ... )
+        {
+            exception = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if ( exception && !this->failure )
+        {
+            this->failure = exception;
+        }
+        if ( --this->pendingTasks == 0 )
+        {
+            this->idle.notify_all();
+        }
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->queue.push_back(std::move(task));
+        this->pendingTasks++;
+    }
+    this->taskAvailable.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->idle.wait(lock, [this] { return this->pendingTasks == 0; });
+
+    if ( this->failure )
+    {
+        std::exception_ptr exception = this->failure;
+        this->failure = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+unsigned int ThreadPool::size() const
+{
+    return (unsigned int) this->workers.size();
+}
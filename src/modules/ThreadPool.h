@@ -0,0 +1,71 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_THREADPOOL_H
+#define STRIDE_LANGUAGE_THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace stride::modules
+{
+
+    /**
+     * Fixed size pool of worker threads.
+     * Tasks are executed in the order in which they were submitted. Tasks may
+     * submit other tasks; <code>wait</code> only returns once those have
+     * finished as well.
+     */
+    class ThreadPool
+    {
+    private:
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> queue;
+        std::mutex mutex;
+        std::condition_variable taskAvailable;
+        std::condition_variable idle;
+        size_t pendingTasks;
+        bool stopping;
+        std::exception_ptr failure;
+
+        void work();
+
+    public:
+
+        /**
+         * Creates a pool with the provided amount of workers.
+         * If the amount is 0, one worker per hardware thread is created.
+         */
+        explicit ThreadPool(unsigned int threadCount = 0);
+
+        /**
+         * Waits for all submitted tasks, then stops the workers.
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /**
+         * Schedules a task for execution on one of the workers.
+         */
+        void submit(std::function<void()> task);
+
+        /**
+         * Blocks until all submitted tasks have finished.
+         * If a task threw an exception, the first one is rethrown here.
+         */
+        void wait();
+
+        [[nodiscard]] unsigned int size() const;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_THREADPOOL_H
@@ -0,0 +1,794 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <cmath>
+#include <limits>
+#include "ConstantFolding.h"
+#include "NodeAttributes.h"
+#include "../syntax_tree/ASTTraversal.h"
+#include "../syntax_tree/NodeProperties.h"
+#include "../syntax_tree/node_types/definitions/NBinaryOperation.h"
+#include "../syntax_tree/node_types/definitions/NFunctionCall.h"
+#include "../syntax_tree/node_types/definitions/NFunctionDeclaration.h"
+#include "../syntax_tree/node_types/definitions/NIdentifier.h"
+#include "../syntax_tree/node_types/definitions/NLiteral.h"
+#include "../syntax_tree/node_types/definitions/NReturnStatement.h"
+#include "../syntax_tree/node_types/definitions/NUnaryOperator.h"
+#include "../syntax_tree/node_types/definitions/NVariableDeclaration.h"
+#include "../tokens/TokenTraits.h"
+
+using namespace stride;
+using namespace stride::passes;
+
+/**
+ * The type of expressions without a declared type.
+ */
+static const ConstantType DEFAULT_TYPE = { CONSTANT_INTEGER, 64, true };
+
+std::string ConstantType::name() const
+{
+    switch ( this->kind )
+    {
+        case CONSTANT_INTEGER:
+            return ( this->isSigned ? "i" : "u" ) + std::to_string(this->bits);
+        case CONSTANT_FLOAT:
+            return "f" + std::to_string(this->bits);
+        case CONSTANT_BOOLEAN:
+            return "bool";
+        default:
+            return "string";
+    }
+}
+
+/**
+ * Returns the type of a declared primitive, or the default type if
+ * the primitive can't hold a constant.
+ */
+static ConstantType declaredType(token_type_t primitive)
+{
+    switch ( primitive )
+    {
+        case TOKEN_PRIMITIVE_INT8:
+        case TOKEN_PRIMITIVE_INT16:
+        case TOKEN_PRIMITIVE_INT32:
+        case TOKEN_PRIMITIVE_INT64:
+            return { CONSTANT_INTEGER, (uint8_t) ( token_traits(primitive).byteSize * 8 ), true };
+        case TOKEN_PRIMITIVE_UINT8:
+        case TOKEN_PRIMITIVE_UINT16:
+        case TOKEN_PRIMITIVE_UINT32:
+        case TOKEN_PRIMITIVE_UINT64:
+        case TOKEN_PRIMITIVE_CHAR:
+            return { CONSTANT_INTEGER, (uint8_t) ( token_traits(primitive).byteSize * 8 ), false };
+        case TOKEN_PRIMITIVE_FLOAT32:
+        case TOKEN_PRIMITIVE_FLOAT64:
+            return { CONSTANT_FLOAT, (uint8_t) ( token_traits(primitive).byteSize * 8 ), true };
+        case TOKEN_PRIMITIVE_BOOL:
+            return { CONSTANT_BOOLEAN, 8, false };
+        case TOKEN_PRIMITIVE_STRING:
+            return { CONSTANT_STRING, 64, false };
+        default:
+            return DEFAULT_TYPE;
+    }
+}
+
+/**
+ * Returns the type of a primitive that is written by its keyword, e.g. the return
+ * type of a function, or the default type if it isn't a primitive.
+ */
+static ConstantType declaredType(const std::string &name)
+{
+    static const std::pair<const char *, token_type_t> keywords[] = {
+            { "i8",     TOKEN_PRIMITIVE_INT8 },
+            { "i16",    TOKEN_PRIMITIVE_INT16 },
+            { "i32",    TOKEN_PRIMITIVE_INT32 },
+            { "i64",    TOKEN_PRIMITIVE_INT64 },
+            { "u8",     TOKEN_PRIMITIVE_UINT8 },
+            { "u16",    TOKEN_PRIMITIVE_UINT16 },
+            { "u32",    TOKEN_PRIMITIVE_UINT32 },
+            { "u64",    TOKEN_PRIMITIVE_UINT64 },
+            { "f32",    TOKEN_PRIMITIVE_FLOAT32 },
+            { "f64",    TOKEN_PRIMITIVE_FLOAT64 },
+            { "bool",   TOKEN_PRIMITIVE_BOOL },
+            { "char",   TOKEN_PRIMITIVE_CHAR },
+            { "string", TOKEN_PRIMITIVE_STRING }
+    };
+    for ( auto &[ keyword, token ]: keywords )
+    {
+        if ( name == keyword )
+        {
+            return declaredType(token);
+        }
+    }
+    return DEFAULT_TYPE;
+}
+
+/**
+ * Returns the declared type of a variable or parameter.
+ */
+static ConstantType declaredType(const NVariableDeclaration *declaration)
+{
+    auto &declared = declaration->getVariableType();
+    if ( !std::holds_alternative<token_type_t>(declared))
+    {
+        return DEFAULT_TYPE;
+    }
+    return declaredType(std::get<token_type_t>(declared));
+}
+
+/**
+ * Truncates an integer to the width of its type, and sign-extends it if the type is signed.
+ */
+static int64_t truncate(int64_t value, const ConstantType &type)
+{
+    if ( type.bits >= 64 )
+    {
+        return value;
+    }
+    uint64_t mask = ( 1ULL << type.bits ) - 1;
+    uint64_t raw = (uint64_t) value & mask;
+    if ( type.isSigned && ( raw >> ( type.bits - 1 )) & 1 )
+    {
+        raw |= ~mask;
+    }
+    return (int64_t) raw;
+}
+
+/**
+ * Rounds a float to the precision of its type.
+ */
+static double round(double value, const ConstantType &type)
+{
+    return type.bits == 32 ? (double) (float) value : value;
+}
+
+static double toFloat(const ConstantValue &value)
+{
+    if ( value.type.kind == CONSTANT_FLOAT )
+    {
+        return value.floating;
+    }
+    return value.type.isSigned ? (double) value.integer : (double) (uint64_t) value.integer;
+}
+
+static bool isTruthy(const ConstantValue &value)
+{
+    return value.type.kind == CONSTANT_FLOAT ? value.floating != 0 : value.integer != 0;
+}
+
+static ConstantValue makeBoolean(bool value)
+{
+    return { { CONSTANT_BOOLEAN, 8, false }, value ? 1 : 0, 0, "" };
+}
+
+/**
+ * Compares two values of the same integer type, or two floats.
+ * @return Whether the comparison holds.
+ */
+template<typename T>
+static bool compare(enum EBinaryOperator operation, T left, T right)
+{
+    switch ( operation )
+    {
+        case EQUALS:
+            return left == right;
+        case NOT_EQUALS:
+            return left != right;
+        case LESS_THAN:
+            return left < right;
+        case GREATER_THAN:
+            return left > right;
+        case LESS_THAN_EQUALS:
+            return left <= right;
+        default:
+            return left >= right;
+    }
+}
+
+/**
+ * Performs an arithmetic operation on two integers, with 64 bit overflow detection.
+ * Unsigned integers are computed as unsigned 64 bit values.
+ */
+template<typename T>
+static bool arithmetic(enum EBinaryOperator operation, int64_t left, int64_t right, int64_t *result)
+{
+    T value;
+    bool overflowed;
+    switch ( operation )
+    {
+        case ADD:
+            overflowed = __builtin_add_overflow((T) left, (T) right, &value);
+            break;
+        case SUBTRACT:
+            overflowed = __builtin_sub_overflow((T) left, (T) right, &value);
+            break;
+        default:
+            overflowed = __builtin_mul_overflow((T) left, (T) right, &value);
+            break;
+    }
+    *result = (int64_t) value;
+    return overflowed;
+}
+
+/**
+ * Raises an integer to a non-negative power by repeated squaring.
+ * The result wraps in 64 bits; overflow is reported through the return value.
+ */
+template<typename T>
+static bool power(int64_t base, int64_t exponent, int64_t *result)
+{
+    T value = 1;
+    T factor = (T) base;
+    bool overflowed = false;
+    for ( ; exponent > 0; exponent >>= 1 )
+    {
+        if ( exponent & 1 )
+        {
+            overflowed |= __builtin_mul_overflow(value, factor, &value);
+        }
+        if ( exponent > 1 )
+        {
+            overflowed |= __builtin_mul_overflow(factor, factor, &factor);
+        }
+    }
+    *result = (int64_t) value;
+    return overflowed;
+}
+
+ConstantFolder::ConstantFolder(StrideFile &file) : file(file), foldedCount(0), returnType(DEFAULT_TYPE)
+{
+    this->overflowBehavior = OVERFLOW_WRAP;
+    if ( file.hasCompilerFlag("overflow"))
+    {
+        auto flag = file.getCompilerFlag("overflow");
+        if ( std::holds_alternative<std::string>(flag) && std::get<std::string>(flag) == "trap" )
+        {
+            this->overflowBehavior = OVERFLOW_TRAP;
+        }
+    }
+}
+
+void ConstantFolder::run(ast::Node &root)
+{
+    computeAttributes(&root);
+    this->fold(&root, nullptr, DEFAULT_TYPE);
+
+    // Update the attributes of the folded expressions and their ancestors.
+    computeAttributes(&root);
+}
+
+const ConstantValue *ConstantFolder::valueOf(ast::Node *node) const
+{
+    auto entry = this->values.find(node);
+    if ( entry == this->values.end() || !entry->second )
+    {
+        return nullptr;
+    }
+    return &*entry->second;
+}
+
+size_t ConstantFolder::getFoldedCount() const
+{
+    return this->foldedCount;
+}
+
+void ConstantFolder::wrap(ast::Node *node)
+{
+    auto entry = this->values.find(node);
+    if ( entry == this->values.end() || !entry->second || entry->second->type.kind != CONSTANT_INTEGER )
+    {
+        return;
+    }
+
+    // The value is updated in place, so wrapping it again has no effect.
+    ConstantValue &value = *entry->second;
+    int64_t wrapped = truncate(value.integer, value.type);
+    bool overflowed = value.overflowed || wrapped != value.integer;
+    value.integer = wrapped;
+    value.overflowed = false;
+
+    auto literal = dynamic_cast<NLiteral *>(node);
+    if ( literal != nullptr && std::holds_alternative<int64_t>(literal->value) &&
+         std::get<int64_t>(literal->value) != wrapped )
+    {
+        literal->setValue(wrapped, value.type.bits / 8);
+    }
+    if ( !overflowed )
+    {
+        return;
+    }
+
+    int length = node->hasSourceRange() ? node->getSourceEnd() - node->getSourceStart() : 0;
+    if ( this->overflowBehavior == OVERFLOW_TRAP )
+    {
+        this->file.diagnostics().report(error::ERROR, node->getSourceStart(), length,
+                                        "Constant expression overflows " + value.type.name() + ".");
+        return;
+    }
+
+    std::string result = value.type.isSigned ? std::to_string(value.integer) :
+                         std::to_string((uint64_t) value.integer);
+    this->file.diagnostics().report(error::WARNING, node->getSourceStart(), length,
+                                    "Constant expression overflows " + value.type.name() +
+                                    "; the result wraps to " + result + ".");
+}
+
+std::optional<ConstantValue> ConstantFolder::foldLiteral(NLiteral *literal, const ConstantType &context)
+{
+    ConstantValue value { context, 0, 0, "" };
+    switch ( literal->value.index())
+    {
+        case 0:
+            value.integer = std::get<int64_t>(literal->value);
+            if ( context.kind == CONSTANT_FLOAT )
+            {
+                value.floating = round((double) value.integer, context);
+                return value;
+            }
+            if ( context.kind != CONSTANT_INTEGER )
+            {
+                value.type = DEFAULT_TYPE;
+            }
+
+            // A literal that doesn't fit the declared type is wrapped along with the
+            // expression it's part of, which may bring it back into range.
+            return value;
+        case 1:
+            if ( context.kind != CONSTANT_FLOAT )
+            {
+                value.type = { CONSTANT_FLOAT, 64, true };
+            }
+            value.floating = round(std::get<double_t>(literal->value), value.type);
+            return value;
+        default:
+            value.type = { CONSTANT_STRING, 64, false };
+            value.string = std::get<const char *>(literal->value);
+            return value;
+    }
+}
+
+std::optional<ConstantValue> ConstantFolder::foldBinary(ast::Node *node, const ConstantValue &left,
+                                                        const ConstantValue &right, const ConstantType &context)
+{
+    auto operation = dynamic_cast<NBinaryOperation *>(node)->operation;
+    int length = node->hasSourceRange() ? node->getSourceEnd() - node->getSourceStart() : 0;
+
+    // Strings can only be concatenated and compared.
+    if ( left.type.kind == CONSTANT_STRING || right.type.kind == CONSTANT_STRING )
+    {
+        if ( left.type.kind != CONSTANT_STRING || right.type.kind != CONSTANT_STRING )
+        {
+            return std::nullopt;
+        }
+        switch ( operation )
+        {
+            case ADD:
+                return ConstantValue { left.type, 0, 0, left.string + right.string };
+            case EQUALS:
+                return makeBoolean(left.string == right.string);
+            case NOT_EQUALS:
+                return makeBoolean(left.string != right.string);
+            default:
+                return std::nullopt;
+        }
+    }
+
+    if ( operation == AND || operation == OR )
+    {
+        return makeBoolean(operation == AND ? isTruthy(left) && isTruthy(right) :
+                           isTruthy(left) || isTruthy(right));
+    }
+
+    // If either operand is a float, the operation is performed in floating point.
+    if ( left.type.kind == CONSTANT_FLOAT || right.type.kind == CONSTANT_FLOAT )
+    {
+        if ( left.type.kind == CONSTANT_BOOLEAN || right.type.kind == CONSTANT_BOOLEAN )
+        {
+            return std::nullopt;
+        }
+
+        ConstantType type = context.kind == CONSTANT_FLOAT ? context : ConstantType { CONSTANT_FLOAT, 64, true };
+        double a = round(toFloat(left), type);
+        double b = round(toFloat(right), type);
+        ConstantValue value { type, 0, 0, "" };
+        switch ( operation )
+        {
+            case ADD:
+                value.floating = a + b;
+                break;
+            case SUBTRACT:
+                value.floating = a - b;
+                break;
+            case MULTIPLY:
+                value.floating = a * b;
+                break;
+            case DIVIDE:
+                value.floating = a / b;
+                break;
+            case MODULO:
+                value.floating = std::fmod(a, b);
+                break;
+            case POWER:
+                value.floating = std::pow(a, b);
+                break;
+            case EQUALS:
+            case NOT_EQUALS:
+            case LESS_THAN:
+            case GREATER_THAN:
+            case LESS_THAN_EQUALS:
+            case GREATER_THAN_EQUALS:
+                return makeBoolean(compare(operation, a, b));
+            default:
+                return std::nullopt;
+        }
+        value.floating = round(value.floating, type);
+        return value;
+    }
+
+    // Booleans only support logical and bitwise operations, and comparison for equality.
+    if ( left.type.kind == CONSTANT_BOOLEAN || right.type.kind == CONSTANT_BOOLEAN )
+    {
+        if ( left.type.kind != right.type.kind )
+        {
+            return std::nullopt;
+        }
+        switch ( operation )
+        {
+            case BITWISE_AND:
+                return makeBoolean(left.integer & right.integer);
+            case BITWISE_OR:
+                return makeBoolean(left.integer | right.integer);
+            case XOR:
+            case NOT_EQUALS:
+                return makeBoolean(left.integer != right.integer);
+            case EQUALS:
+                return makeBoolean(left.integer == right.integer);
+            default:
+                return std::nullopt;
+        }
+    }
+
+    // Both operands are integers of the same type, as they're evaluated in the same context.
+    ConstantValue value { left.type, 0, 0, "" };
+    const ConstantType &type = left.type;
+    int64_t a = left.integer;
+    int64_t b = right.integer;
+    bool overflowed = false;
+
+    switch ( operation )
+    {
+        case ADD:
+        case SUBTRACT:
+        case MULTIPLY:
+            overflowed = type.isSigned ? arithmetic<int64_t>(operation, a, b, &value.integer) :
+                         arithmetic<uint64_t>(operation, a, b, &value.integer);
+            break;
+        case DIVIDE:
+        case MODULO:
+            if ( b == 0 )
+            {
+                this->file.diagnostics().report(error::ERROR, node->getSourceStart(), length,
+                                                "Division by zero in constant expression.");
+                return std::nullopt;
+            }
+            if ( !type.isSigned )
+            {
+                value.integer = (int64_t) ( operation == DIVIDE ? (uint64_t) a / (uint64_t) b :
+                                            (uint64_t) a % (uint64_t) b );
+            }
+            else if ( a == std::numeric_limits<int64_t>::min() && b == -1 )
+            {
+                // The only signed division that overflows in 64 bits.
+                overflowed = true;
+                value.integer = operation == DIVIDE ? a : 0;
+            }
+            else
+            {
+                value.integer = operation == DIVIDE ? a / b : a % b;
+            }
+            break;
+        case POWER:
+            // Negative exponents don't result in an integer; left to the runtime.
+            if ( b < 0 )
+            {
+                return std::nullopt;
+            }
+            overflowed = type.isSigned ? power<int64_t>(a, b, &value.integer) :
+                         power<uint64_t>(a, b, &value.integer);
+            break;
+        case SHIFT_LEFT:
+        case SHIFT_RIGHT:
+            if ( b < 0 || b >= type.bits )
+            {
+                this->file.diagnostics().report(error::ERROR, node->getSourceStart(), length,
+                                                "Shift amount " + std::to_string(b) + " is out of range for " +
+                                                type.name() + ".");
+                return std::nullopt;
+            }
+            if ( operation == SHIFT_LEFT )
+            {
+                // Bits shifted out of the type are discarded; this isn't an overflow.
+                value.integer = truncate((int64_t) ((uint64_t) a << b ), type);
+            }
+            else
+            {
+                value.integer = type.isSigned ? a >> b :
+                                (int64_t) ( (uint64_t) truncate(a, { CONSTANT_INTEGER, type.bits, false }) >> b );
+            }
+            break;
+        case BITWISE_AND:
+            value.integer = a & b;
+            break;
+        case BITWISE_OR:
+            value.integer = a | b;
+            break;
+        case XOR:
+            value.integer = a ^ b;
+            break;
+        case EQUALS:
+        case NOT_EQUALS:
+        case LESS_THAN:
+        case GREATER_THAN:
+        case LESS_THAN_EQUALS:
+        case GREATER_THAN_EQUALS:
+            return makeBoolean(type.isSigned ? compare(operation, a, b) :
+                               compare(operation, (uint64_t) a, (uint64_t) b));
+        default:
+            return std::nullopt;
+    }
+
+    value.overflowed = overflowed || left.overflowed || right.overflowed;
+    return value;
+}
+
+std::optional<ConstantValue> ConstantFolder::foldUnary(ast::Node *node, const ConstantValue &operand)
+{
+    switch ( dynamic_cast<NUnaryOperator *>(node)->operation )
+    {
+        case NEGATE:
+            if ( operand.type.kind == CONSTANT_STRING )
+            {
+                return std::nullopt;
+            }
+            return makeBoolean(!isTruthy(operand));
+        case BITWISE_NOT:
+            if ( operand.type.kind != CONSTANT_INTEGER )
+            {
+                return std::nullopt;
+            }
+            return ConstantValue { operand.type, truncate(~operand.integer, operand.type), 0, "", operand.overflowed };
+        default:
+            // Increments and decrements modify a variable.
+            return std::nullopt;
+    }
+}
+
+ast::Node *ConstantFolder::replace(ast::Node *node, ast::Node *parent, NLiteral *literal, const ConstantValue &value)
+{
+    ast::Node *replacement;
+    if ( value.type.kind == CONSTANT_BOOLEAN )
+    {
+        // Booleans are written as identifiers, which every later phase recognizes.
+        delete literal;
+        replacement = new NIdentifier(value.integer != 0 ? "__true" : "__false");
+    }
+    else
+    {
+        if ( literal == nullptr )
+        {
+            literal = new NLiteral((int64_t) 0);
+        }
+        this->assign(literal, value);
+        replacement = literal;
+    }
+
+    replacement->setSourceRange(node->getSourceStart(), node->getSourceEnd());
+    if ( !ast::replaceSubnode(parent, node, replacement))
+    {
+        throw std::runtime_error("Failed to replace folded expression in its parent.");
+    }
+    this->foldedCount++;
+    return replacement;
+}
+
+void ConstantFolder::assign(NLiteral *literal, const ConstantValue &value)
+{
+    LiteralValue literalValue;
+    int byteCount;
+    switch ( value.type.kind )
+    {
+        case CONSTANT_FLOAT:
+            literalValue = value.floating;
+            byteCount = value.type.bits / 8;
+            break;
+        case CONSTANT_STRING:
+        {
+            char *string = (char *) malloc(value.string.size() + 1);
+            memcpy(string, value.string.c_str(), value.string.size() + 1);
+            literalValue = (const char *) string;
+            byteCount = (int) value.string.size();
+        }
+            break;
+        default:
+            literalValue = value.integer;
+            byteCount = value.type.bits / 8;
+            break;
+    }
+    literal->setValue(literalValue, byteCount);
+}
+
+std::optional<ConstantValue> ConstantFolder::fold(ast::Node *node, ast::Node *parent, const ConstantType &context)
+{
+    if ( node == nullptr )
+    {
+        return std::nullopt;
+    }
+
+    auto cached = this->values.find(node);
+    if ( cached != this->values.end())
+    {
+        return cached->second;
+    }
+
+    // Subtrees without any constant have nothing to fold.
+    if ( !( attributesOf(node).flags & NODE_ATTRIBUTE_HAS_CONSTANT ))
+    {
+        this->values[ node ] = std::nullopt;
+        return std::nullopt;
+    }
+
+    std::optional<ConstantValue> value;
+    switch ( node->getType())
+    {
+        case ast::LITERAL:
+            value = this->foldLiteral(dynamic_cast<NLiteral *>(node), context);
+            break;
+
+        case ast::IDENTIFIER:
+        {
+            std::vector<std::string> path = ast::splitIdentifier(dynamic_cast<NIdentifier *>(node)->name);
+            if ( path.size() == 1 && ( path[ 0 ] == "true" || path[ 0 ] == "false" ))
+            {
+                value = makeBoolean(path[ 0 ] == "true");
+            }
+        }
+            break;
+
+        case ast::BINARY_OPERATOR:
+        {
+            auto binary = dynamic_cast<NBinaryOperation *>(node);
+
+            // Comparisons and logical operations don't pass their type on to their operands,
+            // and neither do types that don't support arithmetic.
+            bool passesContext = !binary->isComparison() && binary->operation != AND && binary->operation != OR &&
+                                 ( context.kind == CONSTANT_INTEGER || context.kind == CONSTANT_FLOAT );
+            const ConstantType &operandContext = passesContext ? context : DEFAULT_TYPE;
+
+            // The value that is assigned is evaluated in the declared type of the variable.
+            ConstantType assignedType = DEFAULT_TYPE;
+            auto assigned = dynamic_cast<NIdentifier *>(binary->left);
+            if ( binary->isAssignment() && assigned != nullptr && assigned->declaration != nullptr &&
+                 assigned->declaration->getType() == ast::VARIABLE_DECLARATION )
+            {
+                assignedType = declaredType(dynamic_cast<NVariableDeclaration *>(assigned->declaration));
+            }
+
+            auto left = this->fold(binary->left, binary, binary->isAssignment() ? DEFAULT_TYPE : operandContext);
+            auto right = this->fold(binary->right, binary, binary->isAssignment() ? assignedType : operandContext);
+            if ( !left || !right || binary->isAssignment() || parent == nullptr )
+            {
+                break;
+            }
+
+            value = this->foldBinary(binary, *left, *right, operandContext);
+            if ( !value )
+            {
+                break;
+            }
+
+            // Reuse a literal operand for the result, and delete the operation.
+            auto literal = dynamic_cast<NLiteral *>(binary->left);
+            if ( literal != nullptr )
+            {
+                this->values.erase(binary->left);
+                binary->left = nullptr;
+            }
+            else if (( literal = dynamic_cast<NLiteral *>(binary->right)) != nullptr )
+            {
+                this->values.erase(binary->right);
+                binary->right = nullptr;
+            }
+            ast::Node *replacement = this->replace(binary, parent, literal, *value);
+
+            this->values.erase(binary->left);
+            this->values.erase(binary->right);
+            delete binary->left;
+            delete binary->right;
+            delete binary;
+            this->values[ replacement ] = value;
+            return value;
+        }
+
+        case ast::UNARY_OPERATOR:
+        {
+            auto unary = dynamic_cast<NUnaryOperator *>(node);
+            bool passesContext = unary->operation == BITWISE_NOT && context.kind == CONSTANT_INTEGER;
+            auto operand = this->fold(unary->expression.get(), unary, passesContext ? context : DEFAULT_TYPE);
+            if ( !operand || parent == nullptr || !( value = this->foldUnary(unary, *operand)))
+            {
+                break;
+            }
+
+            auto literal = dynamic_cast<NLiteral *>(unary->expression.get());
+            if ( literal != nullptr )
+            {
+                this->values.erase(literal);
+                unary->expression.release();
+            }
+            ast::Node *replacement = this->replace(unary, parent, literal, *value);
+
+            this->values.erase(unary->expression.get());
+            delete unary;
+            this->values[ replacement ] = value;
+            return value;
+        }
+
+        case ast::VARIABLE_DECLARATION:
+        {
+            // The value of a variable is evaluated in its declared type.
+            auto declaration = dynamic_cast<NVariableDeclaration *>(node);
+            this->fold(declaration->getValue(), declaration, declaredType(declaration));
+        }
+            break;
+
+        case ast::FUNCTION_DECLARATION:
+        case ast::OPERATOR_OVERLOAD:
+        {
+            // Returned values are evaluated in the return type of the function they're returned from.
+            ConstantType enclosing = this->returnType;
+            auto function = dynamic_cast<NFunctionDeclaration *>(node);
+            this->returnType = function != nullptr && function->returnType != nullptr ?
+                               declaredType(function->returnType->name) : DEFAULT_TYPE;
+            ast::forEachSubnode(node, [ this, node ](ast::Node *subnode)
+            {
+                this->fold(subnode, node, DEFAULT_TYPE);
+            });
+            this->returnType = enclosing;
+        }
+            break;
+
+        case ast::RETURN_STATEMENT:
+            this->fold(dynamic_cast<NReturnStatement *>(node)->getExpression(), node, this->returnType);
+            break;
+
+        case ast::FUNCTION_CALL:
+        {
+            // Arguments are evaluated in the type of the parameter they're passed to.
+            auto call = dynamic_cast<NFunctionCall *>(node);
+            auto function = dynamic_cast<NFunctionDeclaration *>(call->declaration);
+            for ( size_t i = 0; i < call->arguments.size(); i++ )
+            {
+                bool typed = function != nullptr && i < function->arguments.size() &&
+                             !function->arguments[ i ]->isVariadicParameter();
+                this->fold(call->arguments[ i ], call, typed ? declaredType(function->arguments[ i ]) : DEFAULT_TYPE);
+            }
+        }
+            break;
+
+        default:
+            ast::forEachSubnode(node, [ this, node ](ast::Node *subnode)
+            {
+                this->fold(subnode, node, DEFAULT_TYPE);
+            });
+            break;
+    }
+
+    // The node didn't fold into its parent, so the values of its subnodes are final.
+    ast::forEachSubnode(node, [ this ](ast::Node *subnode)
+    {
+        this->wrap(subnode);
+    });
+
+    this->values[ node ] = value;
+    return value;
+}
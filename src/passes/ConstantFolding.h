@@ -0,0 +1,166 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_CONSTANTFOLDING_H
+#define STRIDE_LANGUAGE_CONSTANTFOLDING_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include "../StrideFile.h"
+#include "../syntax_tree/ASTNodes.h"
+
+class NLiteral;
+
+namespace stride::passes
+{
+
+    enum EConstantKind
+    {
+        CONSTANT_INTEGER,
+        CONSTANT_FLOAT,
+        CONSTANT_BOOLEAN,
+        CONSTANT_STRING
+    };
+
+    /**
+     * The type a constant is evaluated in.
+     * Integers are stored in 64 bits, and are wrapped to their width once
+     * the whole expression is folded. Floats are rounded to their width
+     * after every operation.
+     */
+    struct ConstantType
+    {
+        EConstantKind kind;
+        uint8_t bits;
+        bool isSigned;
+
+        /**
+         * Returns the name of the type, e.g. 'i32'.
+         */
+        [[nodiscard]] std::string name() const;
+    };
+
+    /**
+     * The value of a constant expression.
+     * Only the field that corresponds to the kind of its type is used;
+     * booleans are stored as an integer.
+     */
+    struct ConstantValue
+    {
+        ConstantType type;
+        int64_t integer;
+        double floating;
+        std::string string;
+
+        /**
+         * Whether the exact value of the integer doesn't fit in 64 bits.
+         * Operands aren't wrapped to their width, so this is checked on the result.
+         */
+        bool overflowed = false;
+    };
+
+    /**
+     * How integer overflow in constant expressions is handled.
+     */
+    enum EOverflowBehavior
+    {
+        OVERFLOW_WRAP, // Wrap around, and report a warning
+        OVERFLOW_TRAP  // Report an error
+    };
+
+    /**
+     * Folds constant expressions into literals.
+     *
+     * The tree is visited once, bottom-up. The value of every visited expression
+     * is cached, so the value of an operation is computed from the cached values
+     * of its operands, rather than by evaluating them again. Operations with
+     * constant operands are replaced by a literal in their parent; the literal of
+     * an operand is reused for this where possible.
+     *
+     * Integer arithmetic is exact in 64 bits. Only the result of an expression is
+     * wrapped to the width of the type it's evaluated in, so an overflow is reported
+     * once, if that result doesn't fit. The type is the declared type of the variable
+     * it initializes or is assigned to, of the parameter it's passed to, or the return
+     * type of the function it's returned from, or i64 if there is none. Floats are
+     * evaluated in f64, or in f32 if the declared type is f32.
+     *
+     * Booleans are folded into the 'true' and 'false' identifiers, which is how
+     * they're written in the source.
+     *
+     * Assignments and calls are matched to their declarations by name resolution,
+     * so the folder runs after the NameResolver.
+     *
+     * Subtrees that contain no constants, according to their node attributes,
+     * aren't visited.
+     */
+    class ConstantFolder
+    {
+    private:
+        StrideFile &file;
+        EOverflowBehavior overflowBehavior;
+        std::unordered_map<ast::Node *, std::optional<ConstantValue>> values;
+        size_t foldedCount;
+
+        /**
+         * The return type of the function that is being folded.
+         */
+        ConstantType returnType;
+
+        std::optional<ConstantValue> fold(ast::Node *node, ast::Node *parent, const ConstantType &context);
+
+        std::optional<ConstantValue> foldLiteral(NLiteral *literal, const ConstantType &context);
+
+        std::optional<ConstantValue> foldBinary(ast::Node *node, const ConstantValue &left,
+                                                const ConstantValue &right, const ConstantType &context);
+
+        std::optional<ConstantValue> foldUnary(ast::Node *node, const ConstantValue &operand);
+
+        /**
+         * Wraps the integer value of an expression to the width of its type, once
+         * its parent doesn't fold it any further, and reports an overflow if the
+         * exact value doesn't fit.
+         */
+        void wrap(ast::Node *node);
+
+        /**
+         * Replaces a folded expression in its parent.
+         * @param literal A literal to reuse for the value, or nullptr to allocate one.
+         * @return The node that holds the value.
+         */
+        ast::Node *replace(ast::Node *node, ast::Node *parent, NLiteral *literal, const ConstantValue &value);
+
+        /**
+         * Stores a value that isn't a boolean in a literal.
+         */
+        static void assign(NLiteral *literal, const ConstantValue &value);
+
+    public:
+
+        /**
+         * Creates a constant folder for the provided file.
+         * Integer overflow wraps, unless the 'overflow' flag of the file is set to 'trap'.
+         */
+        explicit ConstantFolder(StrideFile &file);
+
+        /**
+         * Folds all constant expressions in the provided tree.
+         */
+        void run(ast::Node &root);
+
+        /**
+         * Returns the value of a visited expression.
+         * @return The value, or nullptr if the expression isn't constant.
+         */
+        [[nodiscard]] const ConstantValue *valueOf(ast::Node *node) const;
+
+        /**
+         * Returns the amount of operations that were replaced by a literal.
+         */
+        [[nodiscard]] size_t getFoldedCount() const;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_CONSTANTFOLDING_H
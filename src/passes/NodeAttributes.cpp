@@ -0,0 +1,135 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include "NodeAttributes.h"
+#include "../syntax_tree/ASTTraversal.h"
+#include "../syntax_tree/NodeProperties.h"
+#include "../syntax_tree/node_types/definitions/NBinaryOperation.h"
+#include "../syntax_tree/node_types/definitions/NIdentifier.h"
+#include "../syntax_tree/node_types/definitions/NUnaryOperator.h"
+
+using namespace stride;
+using namespace stride::ast;
+
+/**
+ * Derives the attributes of a node from the attributes of its subnodes,
+ * which have to be up to date.
+ */
+static NodeAttributes derive(Node *node)
+{
+    NodeAttributes attributes { 0 };
+    bool allConstant = true;
+    forEachSubnode(node, [ & ](Node *subnode)
+    {
+        const NodeAttributes &subnodeAttributes = subnode->getAttributes();
+        attributes.flags |= subnodeAttributes.flags & NODE_ATTRIBUTE_HAS_CONSTANT;
+        allConstant &= ( subnodeAttributes.flags & NODE_ATTRIBUTE_CONSTANT ) != 0;
+    });
+
+    switch ( node->getType())
+    {
+        case LITERAL:
+            attributes.flags |= NODE_ATTRIBUTE_CONSTANT;
+            break;
+        case IDENTIFIER:
+        {
+            // Booleans are written as identifiers.
+            std::vector<std::string> path = splitIdentifier(dynamic_cast<NIdentifier *>(node)->name);
+            if ( path.size() == 1 && ( path[ 0 ] == "true" || path[ 0 ] == "false" ))
+            {
+                attributes.flags |= NODE_ATTRIBUTE_CONSTANT;
+            }
+        }
+            break;
+        case BINARY_OPERATOR:
+            if ( allConstant && !dynamic_cast<NBinaryOperation *>(node)->isAssignment())
+            {
+                attributes.flags |= NODE_ATTRIBUTE_CONSTANT;
+            }
+            break;
+        case UNARY_OPERATOR:
+        {
+            auto unary = dynamic_cast<NUnaryOperator *>(node);
+            if ( allConstant && ( unary->operation == NEGATE || unary->operation == BITWISE_NOT ))
+            {
+                attributes.flags |= NODE_ATTRIBUTE_CONSTANT;
+            }
+        }
+            break;
+        case EXPRESSION:
+            // A generic expression that wraps a single operand is constant if that operand is.
+            if ( node->getChildCount() == 1 )
+            {
+                attributes.flags |= node->getChild(0)->getAttributes().flags & NODE_ATTRIBUTE_CONSTANT;
+            }
+            break;
+        case ARRAY:
+            attributes.flags |= allConstant ? NODE_ATTRIBUTE_CONSTANT : 0;
+            break;
+        default:
+            break;
+    }
+
+    if ( attributes.flags & NODE_ATTRIBUTE_CONSTANT )
+    {
+        attributes.flags |= NODE_ATTRIBUTE_HAS_CONSTANT;
+    }
+    attributes.flags |= NODE_ATTRIBUTE_VALID;
+    return attributes;
+}
+
+bool stride::passes::computeAttributes(Node *root)
+{
+    struct Frame
+    {
+        Node *node;
+        size_t parent;
+        bool expanded;
+        bool subnodeChanged;
+    };
+
+    // Explicit stack, as deeply nested expressions could overflow the call stack.
+    // Frames stay on the stack until all of their subnodes are done, so the index
+    // of the parent frame remains valid.
+    std::vector<Frame> stack = {{ root, SIZE_MAX, false, false }};
+    bool changed = false;
+
+    while ( !stack.empty())
+    {
+        size_t index = stack.size() - 1;
+        if ( !stack[ index ].expanded )
+        {
+            stack[ index ].expanded = true;
+            forEachSubnode(stack[ index ].node, [ &stack, index ](Node *subnode)
+            {
+                stack.push_back({ subnode, index, false, false });
+            });
+            continue;
+        }
+
+        Frame frame = stack.back();
+        stack.pop_back();
+
+        // Only nodes that were mutated, or that have a mutated descendant, are computed again.
+        if ( frame.subnodeChanged || !( frame.node->getAttributes().flags & NODE_ATTRIBUTE_VALID ))
+        {
+            frame.node->setAttributes(derive(frame.node));
+            changed = true;
+            if ( frame.parent != SIZE_MAX )
+            {
+                stack[ frame.parent ].subnodeChanged = true;
+            }
+        }
+    }
+    return changed;
+}
+
+const NodeAttributes &stride::passes::attributesOf(Node *node)
+{
+    if ( !( node->getAttributes().flags & NODE_ATTRIBUTE_VALID ))
+    {
+        computeAttributes(node);
+    }
+    return node->getAttributes();
+}
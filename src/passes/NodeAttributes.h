@@ -0,0 +1,41 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_NODEATTRIBUTES_H
+#define STRIDE_LANGUAGE_NODEATTRIBUTES_H
+
+#include "../syntax_tree/ASTNodes.h"
+
+namespace stride::passes
+{
+
+    /**
+     * Computes the attributes of all nodes in a tree, in a single post-order pass.
+     *
+     * The attributes of a node are derived from the attributes of its subnodes,
+     * so each node is computed once. Nodes whose attributes are still valid, and
+     * whose subnodes didn't change, are skipped. After a mutation, computing the
+     * attributes again only updates the mutated nodes and their ancestors.
+     *
+     * @param root The root of the tree.
+     * @return Whether any attributes were updated.
+     */
+    bool computeAttributes(ast::Node *root);
+
+    /**
+     * Returns the attributes of a node, computing them first if the node was mutated.
+     * Mutations deeper in the tree are only picked up by computing the attributes of the root.
+     */
+    const ast::NodeAttributes &attributesOf(ast::Node *node);
+
+    /**
+     * Whether the value of the expression is known at compile time.
+     */
+    inline bool isConstant(ast::Node *node)
+    {
+        return attributesOf(node).flags & NODE_ATTRIBUTE_CONSTANT;
+    }
+}
+
+#endif //STRIDE_LANGUAGE_NODEATTRIBUTES_H
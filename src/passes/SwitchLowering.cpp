@@ -0,0 +1,424 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include "SwitchLowering.h"
+#include "../cache/Hash.h"
+#include "../syntax_tree/ASTTraversal.h"
+#include "../syntax_tree/node_types/definitions/NSwitchStatement.h"
+
+using namespace stride;
+using namespace stride::passes;
+
+/**
+ * The amount of seeds that are tried for a bucket of the perfect hash,
+ * before the table is grown.
+ */
+#define PERFECT_HASH_SEED_ATTEMPTS 4096
+
+/**
+ * A case value, with the case it selects.
+ */
+template<typename T>
+struct CaseValue
+{
+    T value;
+    int32_t target;
+    NLiteral *literal;
+};
+
+SwitchLowering::SwitchLowering(StrideFile &file) : file(file)
+{}
+
+void SwitchLowering::report(ast::Node *node, const std::string &message)
+{
+    int start = node != nullptr && node->hasSourceRange() ? node->getSourceStart() : 0;
+    int length = node != nullptr && node->hasSourceRange() ? node->getSourceEnd() - start : 0;
+    this->file.diagnostics().report(error::ERROR, start, length, message);
+}
+
+size_t PerfectHash::slotOf(const char *string) const
+{
+    uint64_t bucket = cache::hash(std::string_view(string)) & ( this->seeds.size() - 1 );
+    return cache::hash(std::string_view(string), this->seeds[ bucket ]) & ( this->keys.size() - 1 );
+}
+
+/**
+ * Returns the amount of values from low to high, inclusive.
+ * This is computed unsigned, so the full range of an i64 doesn't overflow.
+ */
+static uint64_t spanOf(int64_t low, int64_t high)
+{
+    return (uint64_t) high - (uint64_t) low + 1;
+}
+
+/**
+ * Returns the amount of range clusters the values from first to last would form,
+ * which is the amount of comparisons a bit test replaces.
+ */
+static size_t rangesIn(const std::vector<std::pair<int64_t, int32_t>> &values, size_t first, size_t last)
+{
+    size_t ranges = 1;
+    for ( size_t i = first + 1; i <= last; i++ )
+    {
+        if ( values[ i ].first != values[ i - 1 ].first + 1 || values[ i ].second != values[ i - 1 ].second )
+        {
+            ranges++;
+        }
+    }
+    return ranges;
+}
+
+void SwitchLowering::cluster(SwitchPlan &plan, const std::vector<std::pair<int64_t, int32_t>> &values)
+{
+    size_t i = 0;
+    while ( i < values.size())
+    {
+        int64_t low = values[ i ].first;
+
+        // The largest dense range that starts at this value can become a jump table.
+        size_t tableLast = i;
+        for ( size_t j = i + 1; j < values.size(); j++ )
+        {
+            uint64_t span = spanOf(low, values[ j ].first);
+            if ( span > SWITCH_MAX_JUMP_TABLE_ENTRIES )
+            {
+                break;
+            }
+            if (( j - i + 1 ) * 100 >= span * SWITCH_MIN_JUMP_TABLE_DENSITY )
+            {
+                tableLast = j;
+            }
+        }
+
+        // Values that fit in a 64-bit mask, and select at most three cases, can become bit tests.
+        // These must save enough comparisons; three for one case, five for two and six for three.
+        std::vector<int32_t> targets;
+        size_t testLast = i;
+        for ( size_t j = i; j < values.size() && spanOf(low, values[ j ].first) <= 64; j++ )
+        {
+            if ( std::find(targets.begin(), targets.end(), values[ j ].second) == targets.end())
+            {
+                if ( targets.size() == 3 )
+                {
+                    break;
+                }
+                targets.push_back(values[ j ].second);
+            }
+            testLast = j;
+        }
+        size_t required = targets.size() == 1 ? 3 : targets.size() == 2 ? 5 : 6;
+        bool testable = rangesIn(values, i, testLast) >= required;
+
+        // Bit tests don't load from memory, so they're preferred if they cover as many values.
+        if ( tableLast - i + 1 >= SWITCH_MIN_JUMP_TABLE_ENTRIES && !( testable && testLast >= tableLast ))
+        {
+            SwitchCluster cluster = { CLUSTER_JUMP_TABLE, low, values[ tableLast ].first, SWITCH_DEFAULT_TARGET };
+            cluster.table.assign(spanOf(low, cluster.high), SWITCH_DEFAULT_TARGET);
+            for ( size_t j = i; j <= tableLast; j++ )
+            {
+                cluster.table[ (uint64_t) values[ j ].first - (uint64_t) low ] = values[ j ].second;
+            }
+            plan.clusters.push_back(std::move(cluster));
+            i = tableLast + 1;
+            continue;
+        }
+        if ( testable )
+        {
+            SwitchCluster cluster = { CLUSTER_BIT_TEST, low, values[ testLast ].first, SWITCH_DEFAULT_TARGET };
+            for ( auto target: targets )
+            {
+                cluster.tests.push_back({ 0, target });
+            }
+            for ( size_t j = i; j <= testLast; j++ )
+            {
+                auto test = std::find_if(cluster.tests.begin(), cluster.tests.end(),
+                                         [ &values, j ](const BitTest &test)
+                                         { return test.target == values[ j ].second; });
+                test->mask |= 1ULL << ((uint64_t) values[ j ].first - (uint64_t) low );
+            }
+            // The case with the most values is tested first.
+            std::stable_sort(cluster.tests.begin(), cluster.tests.end(), [](const BitTest &a, const BitTest &b)
+            { return std::popcount(a.mask) > std::popcount(b.mask); });
+            plan.clusters.push_back(std::move(cluster));
+            i = testLast + 1;
+            continue;
+        }
+
+        // Otherwise, consecutive values that select the same case are compared as a range.
+        size_t last = i;
+        while ( last + 1 < values.size() && values[ last ].first != INT64_MAX &&
+                values[ last + 1 ].first == values[ last ].first + 1 &&
+                values[ last + 1 ].second == values[ i ].second )
+        {
+            last++;
+        }
+        plan.clusters.push_back({ CLUSTER_RANGE, low, values[ last ].first, values[ i ].second });
+        i = last + 1;
+    }
+}
+
+int32_t SwitchLowering::buildTree(SwitchPlan &plan, uint32_t first, uint32_t last)
+{
+    auto index = (int32_t) plan.tree.size();
+    plan.tree.push_back({ 0, -1, -1, first, last });
+    if ( last - first <= SWITCH_MAX_LINEAR_CLUSTERS )
+    {
+        return index;
+    }
+
+    // Values between two clusters go to the left, where no cluster matches them.
+    uint32_t middle = first + ( last - first ) / 2;
+    int32_t less = this->buildTree(plan, first, middle);
+    int32_t greaterOrEqual = this->buildTree(plan, middle, last);
+    plan.tree[ index ] = { plan.clusters[ middle ].low, less, greaterOrEqual, first, last };
+    return index;
+}
+
+/**
+ * Tries to place every string in its own slot, with a seed per bucket.
+ * Buckets with the most strings are placed first, while most slots are still free.
+ * @return Whether a seed was found for every bucket.
+ */
+static bool placeStrings(PerfectHash &hash, const std::vector<std::pair<const char *, int32_t>> &values)
+{
+    std::vector<std::vector<size_t>> buckets(hash.seeds.size());
+    for ( size_t i = 0; i < values.size(); i++ )
+    {
+        buckets[ cache::hash(std::string_view(values[ i ].first)) & ( buckets.size() - 1 ) ].push_back(i);
+    }
+    std::vector<size_t> order(buckets.size());
+    for ( size_t i = 0; i < order.size(); i++ )
+    {
+        order[ i ] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [ &buckets ](size_t a, size_t b)
+    { return buckets[ a ].size() > buckets[ b ].size(); });
+
+    std::vector<size_t> slots;
+    for ( auto bucket: order )
+    {
+        if ( buckets[ bucket ].empty())
+        {
+            break;
+        }
+        bool placed = false;
+        for ( uint64_t seed = 1; seed <= PERFECT_HASH_SEED_ATTEMPTS && !placed; seed++ )
+        {
+            slots.clear();
+            placed = true;
+            for ( auto value: buckets[ bucket ] )
+            {
+                size_t slot = cache::hash(std::string_view(values[ value ].first), seed) & ( hash.keys.size() - 1 );
+                if ( hash.keys[ slot ] != nullptr || std::find(slots.begin(), slots.end(), slot) != slots.end())
+                {
+                    placed = false;
+                    break;
+                }
+                slots.push_back(slot);
+            }
+            if ( placed )
+            {
+                hash.seeds[ bucket ] = seed;
+            }
+        }
+        if ( !placed )
+        {
+            return false;
+        }
+        for ( size_t i = 0; i < slots.size(); i++ )
+        {
+            hash.keys[ slots[ i ]] = values[ buckets[ bucket ][ i ]].first;
+            hash.targets[ slots[ i ]] = values[ buckets[ bucket ][ i ]].second;
+        }
+    }
+    return true;
+}
+
+void SwitchLowering::buildHash(SwitchPlan &plan, const std::vector<std::pair<const char *, int32_t>> &values)
+{
+    // A quarter of the slots is kept free, and there are about two strings per bucket.
+    size_t slotCount = std::bit_ceil(std::max<size_t>(values.size() + values.size() / 4, 1));
+    size_t bucketCount = std::bit_ceil(std::max<size_t>(values.size() / 2, 1));
+    for ( ;; slotCount *= 2 )
+    {
+        plan.hash.seeds.assign(bucketCount, 0);
+        plan.hash.keys.assign(slotCount, nullptr);
+        plan.hash.targets.assign(slotCount, SWITCH_DEFAULT_TARGET);
+        if ( placeStrings(plan.hash, values))
+        {
+            return;
+        }
+    }
+}
+
+void SwitchLowering::lower(NSwitchStatement *statement)
+{
+    std::vector<CaseValue<int64_t>> integers;
+    std::vector<CaseValue<const char *>> strings;
+    const std::vector<NSwitchCase *> &cases = statement->getCases();
+    for ( size_t i = 0; i < cases.size(); i++ )
+    {
+        for ( auto literal: cases[ i ]->values )
+        {
+            if ( std::holds_alternative<int64_t>(literal->value))
+            {
+                integers.push_back({ std::get<int64_t>(literal->value), (int32_t) i, literal });
+            }
+            else if ( std::holds_alternative<const char *>(literal->value))
+            {
+                strings.push_back({ std::get<const char *>(literal->value), (int32_t) i, literal });
+            }
+            else
+            {
+                this->report(literal, "Case values must be integers, characters or strings.");
+            }
+        }
+    }
+    if ( !integers.empty() && !strings.empty())
+    {
+        // Already reported as a type mismatch.
+        return;
+    }
+
+    auto plan = std::make_unique<SwitchPlan>();
+    plan->statement = statement;
+    plan->strategy = SWITCH_LINEAR;
+
+    if ( !strings.empty())
+    {
+        std::stable_sort(strings.begin(), strings.end(), [](const auto &a, const auto &b)
+        { return strcmp(a.value, b.value) < 0; });
+        std::vector<std::pair<const char *, int32_t>> values;
+        for ( size_t i = 0; i < strings.size(); i++ )
+        {
+            if ( i > 0 && strcmp(strings[ i ].value, strings[ i - 1 ].value) == 0 )
+            {
+                this->report(strings[ i ].literal, "Duplicate case value \"" + std::string(strings[ i ].value) + "\".");
+                continue;
+            }
+            values.emplace_back(strings[ i ].value, strings[ i ].target);
+        }
+        plan->strategy = SWITCH_PERFECT_HASH;
+        plan->valueCount = values.size();
+        this->buildHash(*plan, values);
+    }
+    else
+    {
+        std::stable_sort(integers.begin(), integers.end(), [](const auto &a, const auto &b)
+        { return a.value < b.value; });
+        std::vector<std::pair<int64_t, int32_t>> values;
+        for ( size_t i = 0; i < integers.size(); i++ )
+        {
+            if ( i > 0 && integers[ i ].value == integers[ i - 1 ].value )
+            {
+                this->report(integers[ i ].literal, "Duplicate case value '" + std::to_string(integers[ i ].value) + "'.");
+                continue;
+            }
+            values.emplace_back(integers[ i ].value, integers[ i ].target);
+        }
+        plan->valueCount = values.size();
+        this->cluster(*plan, values);
+
+        if ( plan->clusters.size() == 1 && plan->clusters[ 0 ].kind == CLUSTER_JUMP_TABLE )
+        {
+            plan->strategy = SWITCH_JUMP_TABLE;
+        }
+        else if ( plan->clusters.size() == 1 && plan->clusters[ 0 ].kind == CLUSTER_BIT_TEST )
+        {
+            plan->strategy = SWITCH_BIT_TEST;
+        }
+        else if ( plan->clusters.size() > SWITCH_MAX_LINEAR_CLUSTERS )
+        {
+            plan->strategy = SWITCH_BINARY_TREE;
+            this->buildTree(*plan, 0, (uint32_t) plan->clusters.size());
+        }
+    }
+
+    this->planOrder.push_back(plan.get());
+    this->plans[ statement ] = std::move(plan);
+}
+
+void SwitchLowering::run(ast::Node &root)
+{
+    ast::walk(&root, [ this ](ast::Node *node)
+    {
+        if ( node->getType() == ast::SWITCH_STATEMENT )
+        {
+            this->lower(dynamic_cast<NSwitchStatement *>(node));
+        }
+        return true;
+    });
+}
+
+const SwitchPlan *SwitchLowering::planOf(NSwitchStatement *statement) const
+{
+    auto plan = this->plans.find(statement);
+    return plan != this->plans.end() ? plan->second.get() : nullptr;
+}
+
+/**
+ * Returns the name of a target, e.g. 'case 2' or 'default'.
+ */
+static std::string targetName(int32_t target)
+{
+    return target == SWITCH_DEFAULT_TARGET ? "default" : "case " + std::to_string(target);
+}
+
+void SwitchLowering::printReport(std::ostream &out)
+{
+    static const char *strategyNames[] = { "linear", "binary tree", "jump table", "bit test", "perfect hash" };
+
+    for ( size_t i = 0; i < this->planOrder.size(); i++ )
+    {
+        const SwitchPlan *plan = this->planOrder[ i ];
+        out << "switch " << i + 1 << ": " << strategyNames[ plan->strategy ] << ", " << plan->valueCount
+            << " values in " << plan->statement->getCases().size() << " cases";
+        if ( plan->strategy == SWITCH_PERFECT_HASH )
+        {
+            out << ", " << plan->hash.keys.size() << " slots in " << plan->hash.seeds.size() << " buckets" << std::endl;
+            for ( size_t slot = 0; slot < plan->hash.keys.size(); slot++ )
+            {
+                if ( plan->hash.keys[ slot ] != nullptr )
+                {
+                    out << "    slot " << slot << ": \"" << plan->hash.keys[ slot ] << "\" -> "
+                        << targetName(plan->hash.targets[ slot ]) << std::endl;
+                }
+            }
+            continue;
+        }
+
+        out << ", " << plan->clusters.size() << " clusters";
+        if ( plan->strategy == SWITCH_BINARY_TREE )
+        {
+            out << ", " << plan->tree.size() << " tree nodes";
+        }
+        out << std::endl;
+        for ( auto &cluster: plan->clusters )
+        {
+            out << "    [" << cluster.low << ", " << cluster.high << "] ";
+            switch ( cluster.kind )
+            {
+                case CLUSTER_RANGE:
+                    out << "range -> " << targetName(cluster.target);
+                    break;
+                case CLUSTER_JUMP_TABLE:
+                    out << "jump table of " << cluster.table.size() << " entries, "
+                        << std::count_if(cluster.table.begin(), cluster.table.end(), [](int32_t target)
+                        { return target != SWITCH_DEFAULT_TARGET; }) << " used";
+                    break;
+                case CLUSTER_BIT_TEST:
+                    out << "bit test";
+                    for ( auto &test: cluster.tests )
+                    {
+                        out << ", " << std::popcount(test.mask) << " values -> " << targetName(test.target);
+                    }
+                    break;
+            }
+            out << std::endl;
+        }
+    }
+}
@@ -0,0 +1,220 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_SWITCHLOWERING_H
+#define STRIDE_LANGUAGE_SWITCHLOWERING_H
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../StrideFile.h"
+#include "../syntax_tree/ASTNodes.h"
+
+class NSwitchStatement;
+
+/** The target of values that match no case; the default case, or the end of the switch if there is none. */
+#define SWITCH_DEFAULT_TARGET (-1)
+
+/** The minimum percentage of values in the range of a jump table that must have a case. */
+#define SWITCH_MIN_JUMP_TABLE_DENSITY 40
+
+/** The minimum amount of values a jump table covers. Fewer are compared directly. */
+#define SWITCH_MIN_JUMP_TABLE_ENTRIES 4
+
+/** The maximum amount of entries in a jump table. */
+#define SWITCH_MAX_JUMP_TABLE_ENTRIES 4096
+
+/** The maximum amount of clusters that are compared one after the other, rather than by binary search. */
+#define SWITCH_MAX_LINEAR_CLUSTERS 3
+
+namespace stride::passes
+{
+
+    /**
+     * How the value of a switch statement selects its case.
+     */
+    enum ESwitchStrategy
+    {
+        SWITCH_LINEAR,       // Every cluster is compared in order
+        SWITCH_BINARY_TREE,  // The clusters are searched with a balanced tree of comparisons
+        SWITCH_JUMP_TABLE,   // A single jump table covers all cases
+        SWITCH_BIT_TEST,     // A single set of bit tests covers all cases
+        SWITCH_PERFECT_HASH  // String cases, selected by a perfect hash
+    };
+
+    enum EClusterKind
+    {
+        CLUSTER_RANGE,      // A range of consecutive values that select the same case
+        CLUSTER_JUMP_TABLE, // The value minus 'low' indexes a table of cases
+        CLUSTER_BIT_TEST    // Bit 'value - low' is tested in the mask of each case
+    };
+
+    /**
+     * The values in a bit test cluster that select one case, as bits relative to the start of the cluster.
+     */
+    struct BitTest
+    {
+        uint64_t mask;
+        int32_t target;
+    };
+
+    /**
+     * A range of sorted case values that's tested at once.
+     * Values in the range that have no case, which only occurs in jump tables
+     * and bit tests, select the default target.
+     */
+    struct SwitchCluster
+    {
+        EClusterKind kind;
+
+        /**
+         * The lowest and highest value of the cluster, inclusive.
+         */
+        int64_t low;
+        int64_t high;
+
+        /**
+         * The case a range cluster selects.
+         */
+        int32_t target;
+
+        /**
+         * The case of each value of a jump table, from low to high.
+         */
+        std::vector<int32_t> table {};
+
+        /**
+         * The tests of a bit test cluster, by descending amount of values.
+         */
+        std::vector<BitTest> tests {};
+    };
+
+    /**
+     * A node of the binary decision tree of a switch.
+     * Inner nodes compare the value to their pivot; values below it continue
+     * at 'less', others at 'greaterOrEqual'. Leaves have no subnodes,
+     * and test clusters 'first' to 'last' (exclusive) in order.
+     */
+    struct SwitchTreeNode
+    {
+        int64_t pivot;
+        int32_t less;
+        int32_t greaterOrEqual;
+        uint32_t first;
+        uint32_t last;
+
+        [[nodiscard]] bool isLeaf() const
+        { return this->less < 0; }
+    };
+
+    /**
+     * A perfect hash of the string cases of a switch, built with hash and displace.
+     *
+     * A string is hashed with seed 0 to find its bucket, and hashed again with the seed
+     * of the bucket to find its slot. The seeds are chosen so no two cases share a slot,
+     * so a lookup takes two hashes and a single string comparison, however many cases
+     * there are. Strings are hashed with <code>cache::hash</code>; code generated for the
+     * switch must use the same function.
+     */
+    struct PerfectHash
+    {
+        std::vector<uint64_t> seeds;
+
+        /**
+         * The case string of each slot, or nullptr for empty slots.
+         */
+        std::vector<const char *> keys;
+        std::vector<int32_t> targets;
+
+        /**
+         * Returns the slot a string would occupy. Its key must still be compared.
+         */
+        [[nodiscard]] size_t slotOf(const char *string) const;
+    };
+
+    /**
+     * How a switch statement is lowered.
+     * Targets are indices into the cases of the statement, or SWITCH_DEFAULT_TARGET.
+     */
+    struct SwitchPlan
+    {
+        NSwitchStatement *statement;
+        ESwitchStrategy strategy;
+
+        /**
+         * The clusters of integer cases, by ascending value.
+         */
+        std::vector<SwitchCluster> clusters;
+
+        /**
+         * The decision tree of a binary tree switch; its root is the first node.
+         */
+        std::vector<SwitchTreeNode> tree;
+
+        PerfectHash hash;
+
+        /**
+         * The amount of case values.
+         */
+        size_t valueCount;
+    };
+
+    /**
+     * Decides how every switch statement selects its case.
+     *
+     * Integer and character cases are sorted and grouped into clusters. Where enough
+     * of the values in a range have a case, the range becomes a jump table, which
+     * selects a case with one bounds check and an indexed jump. Smaller ranges with at
+     * most three distinct cases, that fit in 64 values, become bit tests; a shift and
+     * a mask per case. The remaining values form ranges of consecutive values with the
+     * same case. A few clusters are compared in order; more are searched with a balanced
+     * binary tree, so the amount of comparisons grows logarithmically with the cases.
+     *
+     * String cases are selected by a perfect hash, in constant time.
+     *
+     * Case values that occur more than once are reported.
+     */
+    class SwitchLowering
+    {
+    private:
+        StrideFile &file;
+        std::unordered_map<NSwitchStatement *, std::unique_ptr<SwitchPlan>> plans;
+        std::vector<SwitchPlan *> planOrder;
+
+        void lower(NSwitchStatement *statement);
+
+        void cluster(SwitchPlan &plan, const std::vector<std::pair<int64_t, int32_t>> &values);
+
+        int32_t buildTree(SwitchPlan &plan, uint32_t first, uint32_t last);
+
+        void buildHash(SwitchPlan &plan, const std::vector<std::pair<const char *, int32_t>> &values);
+
+        void report(ast::Node *node, const std::string &message);
+
+    public:
+
+        explicit SwitchLowering(StrideFile &file);
+
+        /**
+         * Lowers every switch statement in the provided tree.
+         */
+        void run(ast::Node &root);
+
+        /**
+         * Returns how a switch statement is lowered.
+         * @return The plan, or nullptr if the statement wasn't lowered.
+         */
+        [[nodiscard]] const SwitchPlan *planOf(NSwitchStatement *statement) const;
+
+        /**
+         * Prints the strategy and clusters of every lowered switch statement.
+         */
+        void printReport(std::ostream &out);
+    };
+}
+
+#endif //STRIDE_LANGUAGE_SWITCHLOWERING_H
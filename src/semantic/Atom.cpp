@@ -0,0 +1,79 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include "Atom.h"
+#include "../cache/Hash.h"
+
+using namespace stride::semantic;
+
+/**
+ * The initial amount of slots in the table. Must be a power of two.
+ */
+#define INITIAL_CAPACITY 256
+
+AtomTable::AtomTable() : slots(INITIAL_CAPACITY, ATOM_NONE)
+{}
+
+void AtomTable::grow()
+{
+    std::vector<Atom> grown(this->slots.size() * 2, ATOM_NONE);
+    size_t mask = grown.size() - 1;
+    for ( Atom atom = 1; atom <= this->strings.size(); atom++ )
+    {
+        size_t slot = this->hashes[ atom - 1 ] & mask;
+        while ( grown[ slot ] != ATOM_NONE )
+        {
+            slot = ( slot + 1 ) & mask;
+        }
+        grown[ slot ] = atom;
+    }
+    this->slots = std::move(grown);
+}
+
+Atom AtomTable::intern(std::string_view value)
+{
+    uint64_t hash = cache::hash(value);
+    size_t mask = this->slots.size() - 1;
+    size_t slot = hash & mask;
+    for ( ; this->slots[ slot ] != ATOM_NONE; slot = ( slot + 1 ) & mask )
+    {
+        Atom atom = this->slots[ slot ];
+        if ( this->hashes[ atom - 1 ] == hash && this->strings[ atom - 1 ] == value )
+        {
+            return atom;
+        }
+    }
+
+    this->strings.emplace_back(value);
+    this->hashes.push_back(hash);
+    auto atom = (Atom) this->strings.size();
+    this->slots[ slot ] = atom;
+
+    // Keep the load factor below one half, so probe sequences stay short.
+    if ( this->strings.size() * 2 > this->slots.size())
+    {
+        this->grow();
+    }
+    return atom;
+}
+
+Atom AtomTable::find(std::string_view value) const
+{
+    uint64_t hash = cache::hash(value);
+    size_t mask = this->slots.size() - 1;
+    for ( size_t slot = hash & mask; this->slots[ slot ] != ATOM_NONE; slot = ( slot + 1 ) & mask )
+    {
+        Atom atom = this->slots[ slot ];
+        if ( this->hashes[ atom - 1 ] == hash && this->strings[ atom - 1 ] == value )
+        {
+            return atom;
+        }
+    }
+    return ATOM_NONE;
+}
+
+const std::string &AtomTable::str(Atom atom) const
+{
+    return this->strings[ atom - 1 ];
+}
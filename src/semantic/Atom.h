@@ -0,0 +1,71 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_ATOM_H
+#define STRIDE_LANGUAGE_ATOM_H
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace stride::semantic
+{
+
+    /**
+     * An interned string.
+     * Two atoms of the same table are equal if and only if their strings are,
+     * so names can be compared and hashed as integers.
+     */
+    typedef uint32_t Atom;
+
+    /**
+     * The atom that represents no string.
+     */
+    constexpr Atom ATOM_NONE = 0;
+
+    /**
+     * Interns strings into atoms.
+     * Strings are looked up in an open-addressing hash table with linear probing,
+     * which stores the atoms themselves. Atoms are assigned sequentially, starting at 1.
+     */
+    class AtomTable
+    {
+    private:
+        std::deque<std::string> strings;
+        std::vector<uint64_t> hashes;
+        std::vector<Atom> slots;
+
+        void grow();
+
+    public:
+
+        AtomTable();
+
+        /**
+         * Returns the atom of a string, interning it if it wasn't yet.
+         */
+        Atom intern(std::string_view value);
+
+        /**
+         * Returns the atom of a string, without interning it.
+         * @return The atom, or ATOM_NONE if the string was never interned.
+         */
+        [[nodiscard]] Atom find(std::string_view value) const;
+
+        /**
+         * Returns the string of an atom.
+         */
+        [[nodiscard]] const std::string &str(Atom atom) const;
+
+        /**
+         * Returns the amount of interned strings.
+         */
+        [[nodiscard]] size_t size() const
+        { return strings.size(); }
+    };
+}
+
+#endif //STRIDE_LANGUAGE_ATOM_H
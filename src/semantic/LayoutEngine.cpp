@@ -0,0 +1,515 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include <iomanip>
+#include <numeric>
+#include "LayoutEngine.h"
+#include "../syntax_tree/ASTTraversal.h"
+#include "../syntax_tree/node_types/definitions/NClassDeclaration.h"
+#include "../syntax_tree/node_types/definitions/NEnumerableDeclaration.h"
+#include "../syntax_tree/node_types/definitions/NFunctionDeclaration.h"
+#include "../syntax_tree/node_types/definitions/NStructureDeclaration.h"
+
+using namespace stride;
+using namespace stride::semantic;
+
+/** The size of references; classes, strings, functions, and values of unknown types. */
+#define LAYOUT_POINTER_SIZE 8
+
+/** Arrays are references to their elements, followed by their length. */
+#define LAYOUT_ARRAY_SIZE 16
+
+static uint32_t alignUp(uint32_t offset, uint32_t alignment)
+{
+    return ( offset + alignment - 1 ) / alignment * alignment;
+}
+
+/**
+ * Places fields in the order they're provided in.
+ * @return The size of the type, including tail padding.
+ */
+static uint32_t place(std::vector<FieldLayout> &fields, uint32_t alignment)
+{
+    uint32_t offset = 0;
+    for ( auto &field: fields )
+    {
+        field.offset = alignUp(offset, field.alignment);
+        offset = field.offset + field.size;
+    }
+    return alignUp(offset, alignment);
+}
+
+static std::string bytes(uint32_t count)
+{
+    return std::to_string(count) + ( count == 1 ? " byte" : " bytes" );
+}
+
+/**
+ * Whether a type is a structure or class, of which the layout is computed.
+ */
+static bool isComposite(const Type *type)
+{
+    return ( type->kind == TYPE_NAMED || type->kind == TYPE_INSTANCE ) &&
+           ( type->declaration->getType() == ast::STRUCTURE_DECLARATION ||
+             type->declaration->getType() == ast::CLASS_DECLARATION );
+}
+
+uint32_t TypeLayout::padding() const
+{
+    uint32_t used = 0;
+    for ( auto &field: this->fields )
+    {
+        used += field.size;
+    }
+    return this->size - used;
+}
+
+LayoutEngine::LayoutEngine(StrideFile &file, TypeTable &types, const TypeChecker &checker,
+                           Monomorphizer &monomorphizer) :
+        file(file), types(types), checker(checker), monomorphizer(monomorphizer)
+{}
+
+void LayoutEngine::report(ast::Node *node, const std::string &message)
+{
+    int start = node != nullptr && node->hasSourceRange() ? node->getSourceStart() : 0;
+    int length = node != nullptr && node->hasSourceRange() ? node->getSourceEnd() - start : 0;
+    this->file.diagnostics().report(error::ERROR, start, length, message);
+}
+
+std::vector<InstanceMember> LayoutEngine::fieldsOf(const Type *type)
+{
+    std::vector<InstanceMember> fields;
+    if ( type->kind == TYPE_INSTANCE )
+    {
+        Instantiation *instantiation = this->monomorphizer.instantiate(type);
+        if ( instantiation == nullptr )
+        {
+            return fields;
+        }
+        for ( auto &member: instantiation->members )
+        {
+            if ( member.declaration->getType() == ast::VARIABLE_DECLARATION )
+            {
+                fields.push_back(member);
+            }
+        }
+        return fields;
+    }
+
+    std::vector<ast::Node *> declarations;
+    if ( type->declaration->getType() == ast::STRUCTURE_DECLARATION )
+    {
+        auto &structureFields = dynamic_cast<NStructureDeclaration *>(type->declaration)->getFields();
+        declarations.assign(structureFields.begin(), structureFields.end());
+    }
+    else if ( dynamic_cast<NClassDeclaration *>(type->declaration)->getBody() != nullptr )
+    {
+        ast::forEachSubnode(dynamic_cast<NClassDeclaration *>(type->declaration)->getBody(),
+                            [ &declarations ](ast::Node *member)
+                            {
+                                if ( member->getType() == ast::VARIABLE_DECLARATION )
+                                {
+                                    declarations.push_back(member);
+                                }
+                            });
+    }
+    for ( auto declaration: declarations )
+    {
+        const Type *fieldType = this->checker.typeOfDeclaration(declaration);
+        fields.push_back({ declaration, fieldType != nullptr ? fieldType : this->types.unknown() });
+    }
+    return fields;
+}
+
+std::vector<const Type *> LayoutEngine::basesOf(const Type *type)
+{
+    if ( type->declaration->getType() != ast::CLASS_DECLARATION )
+    {
+        return {};
+    }
+    if ( type->kind == TYPE_INSTANCE )
+    {
+        Instantiation *instantiation = this->monomorphizer.instantiate(type);
+        return instantiation != nullptr ? instantiation->bases : std::vector<const Type *>();
+    }
+    return this->checker.basesOf(type->declaration);
+}
+
+void LayoutEngine::requireCompatible(const Type *type)
+{
+    // Elements of arrays are shared as well; classes are only shared by reference.
+    while ( type->kind == TYPE_ARRAY || type->kind == TYPE_VARIADIC )
+    {
+        type = type->element;
+    }
+    if ( !isComposite(type) || type->declaration->getType() != ast::STRUCTURE_DECLARATION ||
+         !Monomorphizer::isConcrete(type) || !this->cCompatible.insert(type).second )
+    {
+        return;
+    }
+    for ( auto &field: this->fieldsOf(type))
+    {
+        this->requireCompatible(field.type);
+    }
+}
+
+void LayoutEngine::split(const Type *type, const std::string &prefix, SoaLayout &layout,
+                         std::unordered_set<const Type *> &enclosing)
+{
+    // Structures that contain themselves are reported by their layout.
+    if ( !enclosing.insert(type).second )
+    {
+        return;
+    }
+    for ( auto &field: this->fieldsOf(type))
+    {
+        auto variable = dynamic_cast<NVariableDeclaration *>(field.declaration);
+        std::string path = prefix + ( variable->getVariableName() != nullptr ? *variable->getVariableName() : "?" );
+        if ( isComposite(field.type) && field.type->declaration->getType() == ast::STRUCTURE_DECLARATION )
+        {
+            this->split(field.type, path + ".", layout, enclosing);
+        }
+        else
+        {
+            layout.streams.push_back({ path, field.type, this->sizeOf(field.type), this->alignmentOf(field.type) });
+        }
+    }
+    enclosing.erase(type);
+}
+
+const SoaLayout *LayoutEngine::soaLayoutOf(const Type *element)
+{
+    if ( !isComposite(element) || element->declaration->getType() != ast::STRUCTURE_DECLARATION ||
+         this->layoutOf(element) == nullptr )
+    {
+        return nullptr;
+    }
+    auto cached = this->soaLayouts.find(element);
+    if ( cached != this->soaLayouts.end())
+    {
+        return cached->second.get();
+    }
+
+    auto layout = std::make_unique<SoaLayout>();
+    layout->element = element;
+    std::unordered_set<const Type *> enclosing;
+    this->split(element, "", *layout, enclosing);
+    layout->size = (uint32_t) ( layout->streams.size() + 1 ) * LAYOUT_POINTER_SIZE;
+
+    SoaLayout *created = layout.get();
+    this->soaLayouts[ element ] = std::move(layout);
+    this->soaOrder.push_back(created);
+    return created;
+}
+
+uint32_t LayoutEngine::sizeOf(const Type *type)
+{
+    const SoaLayout *soaLayout;
+    switch ( type->kind )
+    {
+        case TYPE_VOID:
+            return 0;
+        case TYPE_SOA_ARRAY:
+            soaLayout = this->soaLayoutOf(type->element);
+            return soaLayout != nullptr ? soaLayout->size : LAYOUT_POINTER_SIZE;
+        case TYPE_BOOL:
+        case TYPE_CHAR:
+        case TYPE_INTEGER:
+        case TYPE_FLOAT:
+            return type->bits / 8;
+        case TYPE_ARRAY:
+        case TYPE_VARIADIC:
+            return LAYOUT_ARRAY_SIZE;
+        case TYPE_NAMED:
+        case TYPE_INSTANCE:
+            if ( type->declaration->getType() == ast::STRUCTURE_DECLARATION )
+            {
+                const TypeLayout *layout = this->layoutOf(type);
+                return layout != nullptr ? layout->size : 0;
+            }
+            if ( type->declaration->getType() == ast::ENUMERABLE_DECLARATION )
+            {
+                // Enumerables are as wide as a C enum, unless their values don't fit.
+                for ( auto &[ member, value ]: dynamic_cast<NEnumerableDeclaration *>(type->declaration)->values )
+                {
+                    if ( value < INT32_MIN || value > INT32_MAX )
+                    {
+                        return 8;
+                    }
+                }
+                return 4;
+            }
+            return LAYOUT_POINTER_SIZE;
+        default:
+            return LAYOUT_POINTER_SIZE;
+    }
+}
+
+uint32_t LayoutEngine::alignmentOf(const Type *type)
+{
+    switch ( type->kind )
+    {
+        case TYPE_VOID:
+            return 1;
+        case TYPE_ARRAY:
+        case TYPE_VARIADIC:
+        case TYPE_SOA_ARRAY:
+            return LAYOUT_POINTER_SIZE;
+        case TYPE_NAMED:
+        case TYPE_INSTANCE:
+            if ( type->declaration->getType() == ast::STRUCTURE_DECLARATION )
+            {
+                const TypeLayout *layout = this->layoutOf(type);
+                return layout != nullptr ? layout->alignment : 1;
+            }
+            return this->sizeOf(type);
+        default:
+            return std::max(this->sizeOf(type), 1u);
+    }
+}
+
+const TypeLayout *LayoutEngine::layoutOf(const Type *type)
+{
+    if ( !isComposite(type) || !Monomorphizer::isConcrete(type))
+    {
+        return nullptr;
+    }
+    auto cached = this->layouts.find(type);
+    if ( cached != this->layouts.end())
+    {
+        return cached->second.get();
+    }
+    if ( !this->inProgress.insert(type).second )
+    {
+        // The size and alignment of the field are both requested; it's reported once.
+        if ( this->recursive.insert(type).second )
+        {
+                this->report(type->declaration, "'" + type->toString() + "' contains itself; use a class to refer to it.");
+        }
+        return nullptr;
+    }
+
+    auto layout = std::make_unique<TypeLayout>();
+    layout->type = type;
+    layout->alignment = 1;
+    layout->cCompatible = this->cCompatible.count(type) > 0 ||
+                          ( type->declaration->getType() == ast::STRUCTURE_DECLARATION &&
+                            dynamic_cast<NStructureDeclaration *>(type->declaration)->isExternal());
+
+    // The members of the bases come first, in order of inheritance.
+    size_t baseCount = 0;
+    for ( auto base: this->basesOf(type))
+    {
+        const TypeLayout *baseLayout = this->layoutOf(base);
+        if ( baseLayout != nullptr )
+        {
+            layout->fields.push_back({ nullptr, base->toString(), base, 0, baseLayout->size, baseLayout->alignment });
+            baseCount++;
+        }
+    }
+    for ( auto &field: this->fieldsOf(type))
+    {
+        auto variable = dynamic_cast<NVariableDeclaration *>(field.declaration);
+        std::string name = variable->getVariableName() != nullptr ? *variable->getVariableName() : "?";
+        layout->fields.push_back({ field.declaration, name, field.type, 0, this->sizeOf(field.type),
+                                   this->alignmentOf(field.type) });
+    }
+    for ( auto &field: layout->fields )
+    {
+        layout->alignment = std::max(layout->alignment, field.alignment);
+    }
+
+    layout->declaredSize = place(layout->fields, layout->alignment);
+    if ( !layout->cCompatible )
+    {
+        std::stable_sort(layout->fields.begin() + (long) baseCount, layout->fields.end(),
+                         [](const FieldLayout &a, const FieldLayout &b)
+                         {
+                             return a.alignment != b.alignment ? a.alignment > b.alignment : a.size > b.size;
+                         });
+    }
+    layout->size = place(layout->fields, layout->alignment);
+    for ( auto &field: layout->fields )
+    {
+        if ( field.declaration != nullptr )
+        {
+            this->fieldOffsets.emplace(field.declaration, field.offset);
+        }
+    }
+
+    this->inProgress.erase(type);
+    TypeLayout *created = layout.get();
+    this->layouts[ type ] = std::move(layout);
+    this->layoutOrder.push_back(created);
+    return created;
+}
+
+uint32_t LayoutEngine::fieldOffset(ast::Node *field) const
+{
+    auto offset = this->fieldOffsets.find(field);
+    return offset != this->fieldOffsets.end() ? offset->second : 0;
+}
+
+std::vector<const FieldLayout *> LayoutEngine::declaredFields(const Type *type)
+{
+    std::vector<const FieldLayout *> declared;
+    const TypeLayout *layout = this->layoutOf(type);
+    if ( layout == nullptr )
+    {
+        return declared;
+    }
+    for ( auto &member: this->fieldsOf(type))
+    {
+        for ( auto &field: layout->fields )
+        {
+            if ( field.declaration == member.declaration )
+            {
+                declared.push_back(&field);
+            }
+        }
+    }
+    return declared;
+}
+
+void LayoutEngine::run(ast::Node &root)
+{
+    // The structures that cross into C code are collected first; their layout
+    // is fixed before it's used in any other type.
+    std::vector<ast::Node *> declarations;
+    std::vector<const Type *> soaArrays;
+    ast::walk(&root, [ this, &declarations, &soaArrays ](ast::Node *node)
+    {
+        const Type *declared = this->checker.typeOfDeclaration(node);
+        if ( declared != nullptr && declared->kind == TYPE_SOA_ARRAY && Monomorphizer::isConcrete(declared))
+        {
+            soaArrays.push_back(declared);
+        }
+
+        if ( node->getType() == ast::FUNCTION_DECLARATION && dynamic_cast<NFunctionDeclaration *>(node)->external )
+        {
+            const Type *function = this->checker.typeOfDeclaration(node);
+            for ( auto parameter: function != nullptr ? function->arguments : std::vector<const Type *>())
+            {
+                this->requireCompatible(parameter);
+            }
+            if ( function != nullptr )
+            {
+                this->requireCompatible(function->element);
+            }
+        }
+        else if ( node->getType() == ast::STRUCTURE_DECLARATION &&
+                  dynamic_cast<NStructureDeclaration *>(node)->getGenerics().empty())
+        {
+            declarations.push_back(node);
+            if ( dynamic_cast<NStructureDeclaration *>(node)->isExternal())
+            {
+                this->requireCompatible(this->types.named(node));
+            }
+        }
+        else if ( node->getType() == ast::CLASS_DECLARATION &&
+                  dynamic_cast<NClassDeclaration *>(node)->getGenerics().empty())
+        {
+            declarations.push_back(node);
+        }
+        return true;
+    });
+    for ( auto instantiation: this->monomorphizer.getInstantiations())
+    {
+        auto structure = dynamic_cast<NStructureDeclaration *>(instantiation->type->declaration);
+        if ( structure != nullptr && structure->isExternal())
+        {
+            this->requireCompatible(instantiation->type);
+        }
+    }
+
+    for ( auto declaration: declarations )
+    {
+        this->layoutOf(this->types.named(declaration));
+    }
+    for ( size_t i = 0; i < this->monomorphizer.getInstantiations().size(); i++ )
+    {
+        this->layoutOf(this->monomorphizer.getInstantiations()[ i ]->type);
+    }
+    for ( auto array: soaArrays )
+    {
+        this->soaLayoutOf(array->element);
+    }
+}
+
+void LayoutEngine::printReport(std::ostream &out)
+{
+    for ( auto layout: this->layoutOrder )
+    {
+        bool isClass = layout->type->declaration->getType() == ast::CLASS_DECLARATION;
+        out << ( isClass ? "class " : "struct " ) << layout->type->toString() << ": "
+            << bytes(layout->size) << ", aligned to " << layout->alignment << ", "
+            << bytes(layout->padding()) << " of padding";
+        if ( layout->cCompatible )
+        {
+            out << ", C layout";
+        }
+        else if ( layout->declaredSize != layout->size )
+        {
+            out << ", reordered from " << bytes(layout->declaredSize);
+        }
+        out << std::endl;
+
+        uint32_t offset = 0;
+        for ( auto &field: layout->fields )
+        {
+            if ( field.offset > offset )
+            {
+                out << "    " << std::setw(6) << offset << "  (hole of " << bytes(field.offset - offset) << ")" << std::endl;
+            }
+            out << "    " << std::setw(6) << field.offset << "  " << ( field.declaration == nullptr ? "base " : "" )
+                << field.name << ": " << field.type->toString() << " (" << bytes(field.size) << ")";
+            if ( field.size > 0 && field.offset / LAYOUT_CACHE_LINE_SIZE !=
+                                   ( field.offset + field.size - 1 ) / LAYOUT_CACHE_LINE_SIZE )
+            {
+                out << ", straddles a cache line";
+            }
+            out << std::endl;
+            offset = field.offset + field.size;
+        }
+        if ( layout->size > offset )
+        {
+            out << "    " << std::setw(6) << offset << "  (tail padding of " << bytes(layout->size - offset) << ")"
+                << std::endl;
+        }
+
+        // Consecutive elements of an array repeat the same placement relative to
+        // the cache lines after a period of lcm(size, line) bytes.
+        if ( !isClass && layout->size > 0 )
+        {
+            uint32_t period = std::lcm(layout->size, (uint32_t) LAYOUT_CACHE_LINE_SIZE) / layout->size;
+            uint32_t straddling = 0;
+            for ( uint32_t i = 0; i < period; i++ )
+            {
+                uint32_t start = i * layout->size;
+                if ( start / LAYOUT_CACHE_LINE_SIZE != ( start + layout->size - 1 ) / LAYOUT_CACHE_LINE_SIZE )
+                {
+                    straddling++;
+                }
+            }
+            if ( straddling > 0 )
+            {
+                out << "    " << straddling << " of every " << period
+                    << " array elements straddle a cache line" << std::endl;
+            }
+        }
+    }
+
+    for ( auto layout: this->soaOrder )
+    {
+        out << "soa " << layout->element->toString() << "[]: descriptor of " << bytes(layout->size) << ", "
+            << layout->streams.size() << ( layout->streams.size() == 1 ? " stream" : " streams" ) << ", elements of " << bytes(this->sizeOf(layout->element))
+            << " as an array of structures" << std::endl;
+        for ( auto &stream: layout->streams )
+        {
+            out << "    " << stream.path << ": " << stream.type->toString() << " (" << bytes(stream.size)
+                << " per element)" << std::endl;
+        }
+    }
+}
@@ -0,0 +1,200 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_LAYOUTENGINE_H
+#define STRIDE_LANGUAGE_LAYOUTENGINE_H
+
+#include <memory>
+#include <ostream>
+#include <unordered_map>
+#include <unordered_set>
+#include "Monomorphizer.h"
+#include "TypeChecker.h"
+#include "Types.h"
+#include "../StrideFile.h"
+
+/** The size of a cache line, for reporting fields and elements that straddle one. */
+#define LAYOUT_CACHE_LINE_SIZE 64
+
+namespace stride::semantic
+{
+
+    /**
+     * The placement of a field, or of the members inherited from a base class.
+     */
+    struct FieldLayout
+    {
+        /**
+         * The declaration of the field, or nullptr for a base class.
+         */
+        ast::Node *declaration;
+        std::string name;
+        const Type *type;
+        uint32_t offset;
+        uint32_t size;
+        uint32_t alignment;
+    };
+
+    /**
+     * The memory layout of a structure, or of the object a class reference points to.
+     */
+    struct TypeLayout
+    {
+        const Type *type;
+        uint32_t size;
+        uint32_t alignment;
+
+        /**
+         * Whether the fields are laid out in order of declaration, as a C compiler would.
+         */
+        bool cCompatible;
+
+        /**
+         * The size the type would have with its fields in order of declaration.
+         */
+        uint32_t declaredSize;
+
+        /**
+         * The fields, in order of their offset.
+         */
+        std::vector<FieldLayout> fields;
+
+        /**
+         * Returns the number of bytes that don't belong to any field, including tail padding.
+         */
+        [[nodiscard]] uint32_t padding() const;
+    };
+
+    /**
+     * One of the arrays an array with the 'soa' layout is split into.
+     */
+    struct SoaStream
+    {
+        /**
+         * The path of the field in the element, e.g. 'position.x' for fields of nested structures.
+         */
+        std::string path;
+        const Type *type;
+        uint32_t size;
+        uint32_t alignment;
+    };
+
+    /**
+     * The layout of an array of structures that stores each field in an array of its own.
+     *
+     * Fields of nested structures are split as well, so every stream holds a
+     * primitive or a reference. The array itself is a descriptor of its length,
+     * followed by a reference to each stream. Element i of a stream is at
+     * i * size bytes from its start, so a loop over one field reads it contiguously.
+     */
+    struct SoaLayout
+    {
+        const Type *element;
+        std::vector<SoaStream> streams;
+
+        /**
+         * The size of the descriptor; the length and a reference per stream.
+         */
+        uint32_t size;
+    };
+
+    /**
+     * Computes the size, alignment and field offsets of structures and classes.
+     *
+     * Fields are reordered to minimize padding; by descending alignment, then by
+     * descending size, keeping the order of declaration for fields that are alike.
+     * Since every size is a multiple of its alignment, this leaves no holes between
+     * fields, only tail padding. Classes place the members of their bases first,
+     * so a reference to a class can be used as a reference to its base.
+     *
+     * Structures that are passed to or returned from an external function, declared
+     * with 'define external', must match the layout a C compiler would choose. These,
+     * structures declared as 'external struct', and all structures nested in them,
+     * keep their fields in order of declaration instead.
+     *
+     * Structures are values and are nested in the types that contain them; classes,
+     * strings, arrays and functions are references. Arrays declared with the 'soa'
+     * layout are split into an array per field, see SoaLayout.
+     */
+    class LayoutEngine
+    {
+    private:
+        StrideFile &file;
+        TypeTable &types;
+        const TypeChecker &checker;
+        Monomorphizer &monomorphizer;
+
+        std::unordered_map<const Type *, std::unique_ptr<TypeLayout>> layouts;
+        std::vector<TypeLayout *> layoutOrder;
+        std::unordered_map<ast::Node *, uint32_t> fieldOffsets;
+        std::unordered_map<const Type *, std::unique_ptr<SoaLayout>> soaLayouts;
+        std::vector<SoaLayout *> soaOrder;
+        std::unordered_set<const Type *> cCompatible;
+        std::unordered_set<const Type *> inProgress;
+        std::unordered_set<const Type *> recursive;
+
+        std::vector<InstanceMember> fieldsOf(const Type *type);
+
+        std::vector<const Type *> basesOf(const Type *type);
+
+        void requireCompatible(const Type *type);
+
+        void split(const Type *type, const std::string &prefix, SoaLayout &layout,
+                   std::unordered_set<const Type *> &enclosing);
+
+        void report(ast::Node *node, const std::string &message);
+
+    public:
+
+        LayoutEngine(StrideFile &file, TypeTable &types, const TypeChecker &checker, Monomorphizer &monomorphizer);
+
+        /**
+         * Lays out every structure and class that isn't generic, every instantiation,
+         * and the elements of every array with the 'soa' layout.
+         */
+        void run(ast::Node &root);
+
+        /**
+         * Returns the layout of a structure or class type, computing it if it's used for the first time.
+         * @return The layout, or nullptr if the type isn't a concrete structure or class.
+         */
+        const TypeLayout *layoutOf(const Type *type);
+
+        /**
+         * Returns the layout of an array with the 'soa' layout, computing it if it's used for the first time.
+         * @return The layout, or nullptr if the elements aren't concrete structures.
+         */
+        const SoaLayout *soaLayoutOf(const Type *element);
+
+        /**
+         * Returns the offset of a field in the first laid out type that declares it, or 0 if there is none.
+         * Fields of a base class have the same offset in the classes that derive from it.
+         */
+        [[nodiscard]] uint32_t fieldOffset(ast::Node *field) const;
+
+        /**
+         * Returns the layouts of the fields a structure or class declares itself, in order of declaration.
+         */
+        std::vector<const FieldLayout *> declaredFields(const Type *type);
+
+        /**
+         * Returns the number of bytes a value of a type occupies in a field or array element.
+         */
+        uint32_t sizeOf(const Type *type);
+
+        /**
+         * Returns the alignment of a value of a type, in bytes.
+         */
+        uint32_t alignmentOf(const Type *type);
+
+        /**
+         * Prints the size, alignment, fields and holes of every laid out type,
+         * which fields and array elements straddle a cache line, and the streams
+         * of arrays with the 'soa' layout.
+         */
+        void printReport(std::ostream &out);
+    };
+}
+
+#endif //STRIDE_LANGUAGE_LAYOUTENGINE_H
@@ -0,0 +1,258 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include "Monomorphizer.h"
+#include "../syntax_tree/ASTTraversal.h"
+#include "../syntax_tree/node_types/definitions/NClassDeclaration.h"
+#include "../syntax_tree/node_types/definitions/NStructureDeclaration.h"
+
+using namespace stride;
+using namespace stride::semantic;
+
+/**
+ * The maximum nesting of types in an instance type, e.g. 3 for 'A<A<i32[]>>'.
+ * Deeper types are the result of a declaration that instantiates itself with
+ * ever larger arguments, e.g. 'struct A<T> { next: A<T[]>; }', which never ends.
+ */
+#define MAX_INSTANTIATION_DEPTH 32
+
+Monomorphizer::Monomorphizer(StrideFile &file, SymbolTable &symbols, TypeTable &types, const TypeChecker &checker) :
+        file(file), symbols(symbols), types(types), checker(checker), requestCount(0)
+{}
+
+bool Monomorphizer::isConcrete(const Type *type)
+{
+    if ( type->kind == TYPE_PARAMETER || type->kind == TYPE_UNKNOWN || type->hasVariables )
+    {
+        return false;
+    }
+    if ( type->element != nullptr && !isConcrete(type->element))
+    {
+        return false;
+    }
+    for ( auto argument: type->arguments )
+    {
+        if ( !isConcrete(argument))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Returns how deeply types are nested in a type, e.g. 2 for 'A<i32[]>'.
+ */
+static size_t depthOf(const Type *type)
+{
+    size_t depth = type->element != nullptr ? depthOf(type->element) + 1 : 0;
+    for ( auto argument: type->arguments )
+    {
+        depth = std::max(depth, depthOf(argument) + 1);
+    }
+    return depth;
+}
+
+const Type *Monomorphizer::substitute(const Type *type, const Type *instance)
+{
+    if ( type->kind == TYPE_PARAMETER && type->declaration == instance->declaration )
+    {
+        return instance->arguments[ type->index ];
+    }
+
+    const Type *element = type->element != nullptr ? this->substitute(type->element, instance) : nullptr;
+    std::vector<const Type *> arguments;
+    for ( auto argument: type->arguments )
+    {
+        arguments.push_back(this->substitute(argument, instance));
+    }
+    switch ( type->kind )
+    {
+        case TYPE_ARRAY:
+            return this->types.array(element);
+        case TYPE_VARIADIC:
+            return this->types.variadic(element);
+        case TYPE_SOA_ARRAY:
+            return this->types.soaArray(element);
+        case TYPE_INSTANCE:
+            return this->types.instance(type->declaration, arguments);
+        case TYPE_FUNCTION:
+            return this->types.function(arguments, element);
+        default:
+            return type;
+    }
+}
+
+std::string Monomorphizer::qualifiedName(ast::Node *declaration)
+{
+    std::string name = declaration->getType() == ast::CLASS_DECLARATION ?
+                       dynamic_cast<NClassDeclaration *>(declaration)->getClassName() :
+                       dynamic_cast<NStructureDeclaration *>(declaration)->getName();
+
+    // Redeclared classes and structures don't have a scope of their own.
+    Scope *members = this->symbols.scopeOf(declaration);
+    for ( Scope *scope = members != nullptr ? members->parent : nullptr; scope != nullptr; scope = scope->parent )
+    {
+        if ( scope->module != nullptr )
+        {
+            for ( ModuleNode *module = scope->module; module->symbol != nullptr; module = module->parent )
+            {
+                name.insert(0, this->symbols.atoms().str(module->symbol->name) + "::");
+            }
+            break;
+        }
+        if ( scope->owner != nullptr && scope->owner->getType() == ast::CLASS_DECLARATION )
+        {
+            name.insert(0, dynamic_cast<NClassDeclaration *>(scope->owner)->getClassName() + "::");
+        }
+    }
+    return name;
+}
+
+std::string Monomorphizer::symbolOf(const Type *type)
+{
+    std::string symbol;
+    switch ( type->kind )
+    {
+        case TYPE_ARRAY:
+            return this->symbolOf(type->element) + "[]";
+        case TYPE_NAMED:
+            return type->declaration->getType() == ast::ENUMERABLE_DECLARATION ? type->toString() :
+                   this->qualifiedName(type->declaration);
+        case TYPE_INSTANCE:
+            symbol = this->qualifiedName(type->declaration) + "<";
+            for ( size_t i = 0; i < type->arguments.size(); i++ )
+            {
+                symbol.append(i > 0 ? "," : "").append(this->symbolOf(type->arguments[ i ]));
+            }
+            return symbol + ">";
+        default:
+            return type->toString();
+    }
+}
+
+Instantiation *Monomorphizer::request(const Type *type, ast::Node *location)
+{
+    if ( type == nullptr || !isConcrete(type))
+    {
+        return nullptr;
+    }
+
+    // The components are instantiated as well, e.g. 'Vector<i32>' for 'Vector<Vector<i32>>'.
+    if ( type->element != nullptr )
+    {
+        this->request(type->element, location);
+    }
+    for ( auto argument: type->arguments )
+    {
+        this->request(argument, location);
+    }
+    if ( type->kind != TYPE_INSTANCE )
+    {
+        return nullptr;
+    }
+
+    this->requestCount++;
+    auto cached = this->cache.find(type);
+    if ( cached != this->cache.end())
+    {
+        return cached->second.get();
+    }
+    if ( depthOf(type) > MAX_INSTANTIATION_DEPTH )
+    {
+        int start = location != nullptr && location->hasSourceRange() ? location->getSourceStart() : 0;
+        int length = location != nullptr && location->hasSourceRange() ? location->getSourceEnd() - start : 0;
+        this->file.diagnostics().report(error::ERROR, start, length,
+                                        "Instantiation of '" + this->qualifiedName(type->declaration) +
+                                        "' never ends; its type arguments keep growing.");
+        return nullptr;
+    }
+
+    // The instantiation is cached before it's specialized, so types that refer to themselves end.
+    auto instantiation = std::make_unique<Instantiation>();
+    instantiation->type = type;
+    instantiation->symbol = this->symbolOf(type);
+    Instantiation *created = instantiation.get();
+    this->cache[ type ] = std::move(instantiation);
+    this->instantiations.push_back(created);
+    this->pending.push_back(type);
+    return created;
+}
+
+void Monomorphizer::specialize(Instantiation *instantiation)
+{
+    const Type *instance = instantiation->type;
+    ast::Node *declaration = instance->declaration;
+
+    for ( auto base: this->checker.basesOf(declaration))
+    {
+        const Type *specialized = this->substitute(base, instance);
+        instantiation->bases.push_back(specialized);
+        this->request(specialized, declaration);
+    }
+
+    std::vector<ast::Node *> members;
+    if ( declaration->getType() == ast::STRUCTURE_DECLARATION )
+    {
+        for ( auto field: dynamic_cast<NStructureDeclaration *>(declaration)->getFields())
+        {
+            members.push_back(field);
+        }
+    }
+    else if ( dynamic_cast<NClassDeclaration *>(declaration)->getBody() != nullptr )
+    {
+        ast::forEachSubnode(dynamic_cast<NClassDeclaration *>(declaration)->getBody(), [ &members ](ast::Node *member)
+        {
+            if ( member->getType() == ast::VARIABLE_DECLARATION || member->getType() == ast::FUNCTION_DECLARATION )
+            {
+                members.push_back(member);
+            }
+        });
+    }
+
+    for ( auto member: members )
+    {
+        const Type *type = this->checker.typeOfDeclaration(member);
+        if ( type == nullptr )
+        {
+            continue;
+        }
+        const Type *specialized = this->substitute(type, instance);
+        instantiation->members.push_back({ member, specialized });
+        this->request(specialized, member->hasSourceRange() ? member : declaration);
+    }
+}
+
+void Monomorphizer::drain()
+{
+    // Specializing may request new instantiations, which are specialized in turn.
+    while ( !this->pending.empty())
+    {
+        const Type *type = this->pending.back();
+        this->pending.pop_back();
+        this->specialize(this->cache[ type ].get());
+    }
+}
+
+Instantiation *Monomorphizer::instantiate(const Type *instance)
+{
+    Instantiation *instantiation = this->request(instance, nullptr);
+    this->drain();
+    return instantiation;
+}
+
+void Monomorphizer::run(ast::Node &root)
+{
+    ast::walk(&root, [ this ](ast::Node *node)
+    {
+        this->request(this->checker.typeOf(node), node);
+        this->request(this->checker.typeOfDeclaration(node), node);
+        for ( auto base: this->checker.basesOf(node))
+        {
+            this->request(base, node);
+        }
+        return true;
+    });
+    this->drain();
+}
@@ -0,0 +1,136 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_MONOMORPHIZER_H
+#define STRIDE_LANGUAGE_MONOMORPHIZER_H
+
+#include <memory>
+#include <unordered_map>
+#include "SymbolTable.h"
+#include "TypeChecker.h"
+#include "Types.h"
+#include "../StrideFile.h"
+
+namespace stride::semantic
+{
+
+    /**
+     * A member of an instantiated class or structure, with its type specialized
+     * to the type arguments of the instantiation.
+     */
+    struct InstanceMember
+    {
+        ast::Node *declaration;
+        const Type *type;
+    };
+
+    /**
+     * A specialized copy of a generic class or structure, for one tuple of type arguments.
+     */
+    struct Instantiation
+    {
+        /**
+         * The canonical instance type, e.g. 'Vector<i32>'.
+         * Since types are canonical, this identifies the instantiation.
+         */
+        const Type *type;
+
+        /**
+         * The qualified name of the instantiation, e.g. 'geometry::Vector<i32>'.
+         * This name is the same in every compilation unit that uses the instantiation,
+         * so the code generated for it can be merged when linking.
+         */
+        std::string symbol;
+
+        /**
+         * The specialized types of the classes this class inherits from.
+         */
+        std::vector<const Type *> bases;
+
+        /**
+         * The fields and methods, in order of declaration.
+         */
+        std::vector<InstanceMember> members;
+    };
+
+    /**
+     * Creates one specialized copy of a generic class or structure per distinct
+     * tuple of type arguments.
+     *
+     * Instantiations are memoized by their canonical instance type. As instance
+     * types are interned by declaration and argument types, an instantiation that
+     * is used many times in a file is only specialized once. Every file has a
+     * monomorphizer and type table of its own; types of imported declarations are
+     * external to the file, so its instantiations only use its own declarations.
+     * Specializing a type may require other instantiations, e.g. the fields of a
+     * 'List<i32>' may be of type 'Node<i32>'; these are instantiated as well.
+     *
+     * Instance types that still contain generic parameters, e.g. 'Node<T>' within
+     * the declaration of 'List<T>', aren't instantiated by themselves, but through
+     * the instantiations of the declaration they're used in.
+     */
+    class Monomorphizer
+    {
+    private:
+        StrideFile &file;
+        SymbolTable &symbols;
+        TypeTable &types;
+        const TypeChecker &checker;
+
+        std::unordered_map<const Type *, std::unique_ptr<Instantiation>> cache;
+        std::vector<Instantiation *> instantiations;
+        std::vector<const Type *> pending;
+        size_t requestCount;
+
+        Instantiation *request(const Type *type, ast::Node *location);
+
+        void specialize(Instantiation *instantiation);
+
+        void drain();
+
+        std::string qualifiedName(ast::Node *declaration);
+
+        std::string symbolOf(const Type *type);
+
+    public:
+
+        Monomorphizer(StrideFile &file, SymbolTable &symbols, TypeTable &types, const TypeChecker &checker);
+
+        /**
+         * Instantiates every concrete instance type used in the provided tree.
+         */
+        void run(ast::Node &root);
+
+        /**
+         * Returns the instantiation of a concrete instance type, specializing it if it's used for the first time.
+         * @return The instantiation, or nullptr if the type isn't a concrete instance type.
+         */
+        Instantiation *instantiate(const Type *instance);
+
+        /**
+         * Replaces the generic parameters of the declaration of an instance type by its type arguments.
+         * This gives the type a member or an expression in a generic declaration has in the instantiation.
+         */
+        const Type *substitute(const Type *type, const Type *instance);
+
+        /**
+         * Whether a type contains neither generic parameters nor unknown types.
+         */
+        [[nodiscard]] static bool isConcrete(const Type *type);
+
+        /**
+         * Returns all instantiations, in the order they were created.
+         */
+        [[nodiscard]] const std::vector<Instantiation *> &getInstantiations() const
+        { return this->instantiations; }
+
+        /**
+         * Returns how many times an instantiation was requested, including those served from the cache.
+         */
+        [[nodiscard]] size_t getRequestCount() const
+        { return this->requestCount; }
+    };
+}
+
+#endif //STRIDE_LANGUAGE_MONOMORPHIZER_H
@@ -0,0 +1,483 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include "NameResolver.h"
+#include "../syntax_tree/ASTTraversal.h"
+#include "../syntax_tree/NodeProperties.h"
+#include "../syntax_tree/node_types/definitions/NClassDeclaration.h"
+#include "../syntax_tree/node_types/definitions/NEnumerableDeclaration.h"
+#include "../syntax_tree/node_types/definitions/NForLoop.h"
+#include "../syntax_tree/node_types/definitions/NFunctionCall.h"
+#include "../syntax_tree/node_types/definitions/NFunctionDeclaration.h"
+#include "../syntax_tree/node_types/definitions/NModuleDeclaration.h"
+#include "../syntax_tree/node_types/definitions/NStructureDeclaration.h"
+#include "../syntax_tree/node_types/definitions/NTryCatchStatement.h"
+
+using namespace stride;
+using namespace stride::semantic;
+
+/**
+ * Splits a module name, e.g. 'outer::inner', into its segments.
+ */
+static std::vector<std::string> splitModuleName(const std::string &name)
+{
+    std::vector<std::string> segments;
+    size_t start = 0;
+    size_t separator;
+    while (( separator = name.find("::", start)) != std::string::npos )
+    {
+        segments.push_back(name.substr(start, separator - start));
+        start = separator + 2;
+    }
+    segments.push_back(name.substr(start));
+    return segments;
+}
+
+NameResolver::NameResolver(StrideFile &file, SymbolTable &table) :
+        file(file), table(table), located(nullptr), boundCount(0), externalCount(0)
+{}
+
+void NameResolver::report(const std::string &message)
+{
+    int start = this->located != nullptr ? this->located->getSourceStart() : 0;
+    int length = this->located != nullptr ? this->located->getSourceEnd() - start : 0;
+    this->file.diagnostics().report(error::ERROR, start, length, message);
+}
+
+/**
+ * Declares a symbol, and reports an error if the name is already declared in the scope.
+ * @return The symbol, or nullptr if the name was already declared.
+ */
+static Symbol *declareUnique(SymbolTable &table, Scope *scope, ESymbolKind kind, const std::string &name,
+                             ast::Node *declaration, std::string *conflict)
+{
+    Symbol *symbol = table.declare(scope, kind, table.atoms().intern(name), declaration);
+    if ( symbol->declaration != declaration )
+    {
+        *conflict = "'" + name + "' is already declared in this scope.";
+        return nullptr;
+    }
+    return symbol;
+}
+
+/**
+ * Whether the variables of a scope are declared before it's resolved, so they can be referred to
+ * before their declaration; those of modules and classes. Others are declared as they're encountered.
+ */
+static bool declaresUpfront(const Scope *scope)
+{
+    return scope->owner == nullptr || scope->owner->getType() == ast::CLASS_DECLARATION;
+}
+
+void NameResolver::declareVariable(ast::Node *declaration, Scope *scope, ESymbolKind kind)
+{
+    auto variable = dynamic_cast<NVariableDeclaration *>(declaration);
+    if ( variable->getVariableName() == nullptr )
+    {
+        return;
+    }
+
+    std::string conflict;
+    if ( declareUnique(this->table, scope, kind, *variable->getVariableName(), variable, &conflict) == nullptr )
+    {
+        ast::Node *previous = this->located;
+        this->located = variable->hasSourceRange() ? variable : previous;
+        this->report(conflict);
+        this->located = previous;
+    }
+}
+
+void NameResolver::declare(ast::Node *node, Scope *scope)
+{
+    std::string conflict;
+    switch ( node->getType())
+    {
+        case ast::MODULE_DECLARATION:
+        {
+            auto module = dynamic_cast<NModuleDeclaration *>(node);
+            std::vector<Atom> path;
+            for ( auto &segment: splitModuleName(module->getModuleName()))
+            {
+                path.push_back(this->table.atoms().intern(segment));
+            }
+
+            // Declaring a module again adds to the members of the existing one.
+            ModuleNode *moduleNode = this->table.declareModule(scope, path, module);
+            if ( module->getBody() != nullptr )
+            {
+                this->declareAll(module->getBody(), moduleNode->symbol->members);
+            }
+        }
+            return;
+
+        case ast::CLASS_DECLARATION:
+        {
+            auto declaration = dynamic_cast<NClassDeclaration *>(node);
+            Symbol *symbol = declareUnique(this->table, scope, SYMBOL_CLASS, declaration->getClassName(),
+                                           declaration, &conflict);
+            if ( symbol != nullptr )
+            {
+                symbol->members = this->table.createScope(scope, declaration);
+                if ( declaration->getBody() != nullptr )
+                {
+                    this->declareAll(declaration->getBody(), symbol->members);
+                }
+            }
+        }
+            break;
+
+        case ast::STRUCTURE_DECLARATION:
+        {
+            auto structure = dynamic_cast<NStructureDeclaration *>(node);
+            Symbol *symbol = declareUnique(this->table, scope, SYMBOL_STRUCTURE, structure->getName(),
+                                           structure, &conflict);
+            if ( symbol != nullptr )
+            {
+                symbol->members = this->table.createScope(scope, structure);
+                for ( auto field: structure->getFields())
+                {
+                    this->declareVariable(field, symbol->members, SYMBOL_VARIABLE);
+                }
+            }
+        }
+            break;
+
+        case ast::ENUMERABLE_DECLARATION:
+        {
+            auto enumerable = dynamic_cast<NEnumerableDeclaration *>(node);
+            Symbol *symbol = declareUnique(this->table, scope, SYMBOL_ENUMERABLE, enumerable->getName(),
+                                           enumerable, &conflict);
+            if ( symbol != nullptr )
+            {
+                symbol->members = this->table.createScope(scope, enumerable);
+                for ( auto &[ member, value ]: enumerable->values )
+                {
+                    this->table.declare(symbol->members, SYMBOL_ENUM_MEMBER, this->table.atoms().intern(member),
+                                        enumerable);
+                }
+            }
+        }
+            break;
+
+        case ast::FUNCTION_DECLARATION:
+        {
+            auto function = dynamic_cast<NFunctionDeclaration *>(node);
+            if ( function->functionName != nullptr )
+            {
+                declareUnique(this->table, scope, SYMBOL_FUNCTION, function->functionName->name, function, &conflict);
+            }
+        }
+            break;
+
+        case ast::VARIABLE_DECLARATION:
+            // Variables in blocks are declared when they're encountered.
+            if ( declaresUpfront(scope))
+            {
+                this->declareVariable(node, scope, SYMBOL_VARIABLE);
+            }
+            return;
+
+        default:
+            return;
+    }
+
+    if ( !conflict.empty())
+    {
+        ast::Node *previous = this->located;
+        this->located = node->hasSourceRange() ? node : previous;
+        this->report(conflict);
+        this->located = previous;
+    }
+}
+
+void NameResolver::declareAll(ast::Node *container, Scope *scope)
+{
+    for ( size_t i = 0; i < container->getChildCount(); i++ )
+    {
+        this->declare(container->getChild(i), scope);
+    }
+}
+
+void NameResolver::declareImport(ast::Node *container, Scope *scope)
+{
+    for ( size_t i = 0; i < container->getChildCount(); i++ )
+    {
+        ast::Node *node = container->getChild(i);
+        if ( node->getType() == ast::FUNCTION_DECLARATION )
+        {
+            auto function = dynamic_cast<NFunctionDeclaration *>(node);
+            if ( function->functionName != nullptr )
+            {
+                // The first import that declares a name wins; the native linker rejects duplicate symbols anyway.
+                this->table.declare(scope, SYMBOL_FUNCTION, this->table.atoms().intern(function->functionName->name),
+                                    function);
+            }
+        }
+        else if ( node->getType() == ast::MODULE_DECLARATION )
+        {
+            auto module = dynamic_cast<NModuleDeclaration *>(node);
+            std::vector<Atom> path;
+            for ( auto &segment: splitModuleName(module->getModuleName()))
+            {
+                path.push_back(this->table.atoms().intern(segment));
+            }
+            ModuleNode *moduleNode = this->table.declareModule(scope, path, module);
+            if ( module->getBody() != nullptr )
+            {
+                this->declareImport(module->getBody(), moduleNode->symbol->members);
+            }
+        }
+    }
+}
+
+ast::Node *NameResolver::bind(const std::string &name, Scope *scope, const char *description)
+{
+    std::vector<std::string> path = ast::splitIdentifier(name);
+
+    // 'null' is parsed as an identifier, as are the boolean literals and the
+    // implicit 'this' and 'super' of classes.
+    if ( path.size() == 1 && ( path[ 0 ] == "null" || path[ 0 ] == "true" || path[ 0 ] == "false" ||
+                               path[ 0 ] == "this" || path[ 0 ] == "super" ))
+    {
+        return nullptr;
+    }
+
+    size_t resolvedCount;
+    Symbol *symbol = this->table.lookupPath(scope, path, &resolvedCount);
+    if ( symbol != nullptr )
+    {
+        this->boundCount++;
+        return symbol->declaration;
+    }
+
+    if ( resolvedCount == 0 && path.size() > 1 )
+    {
+        this->externalCount++;
+        return nullptr;
+    }
+
+    // Only the functions of imported modules are declared; their other members are left to the linker.
+    if ( resolvedCount > 0 )
+    {
+        Symbol *parent = this->table.lookupPath(scope, { path.begin(), path.begin() + (long) resolvedCount });
+        if ( parent != nullptr && parent->imported )
+        {
+            this->externalCount++;
+            return nullptr;
+        }
+    }
+
+    if ( resolvedCount == 0 )
+    {
+        this->report(std::string("Unknown ") + description + " '" + path[ 0 ] + "'.");
+        return nullptr;
+    }
+
+    std::string parent = path[ 0 ];
+    for ( size_t i = 1; i < resolvedCount; i++ )
+    {
+        parent.append("::").append(path[ i ]);
+    }
+    this->report("'" + path[ resolvedCount ] + "' is not a member of '" + parent + "'.");
+    return nullptr;
+}
+
+void NameResolver::resolveChildren(ast::Node *container, Scope *scope)
+{
+    for ( size_t i = 0; i < container->getChildCount(); i++ )
+    {
+        this->resolve(container->getChild(i), scope);
+    }
+}
+
+void NameResolver::resolve(ast::Node *node, Scope *scope)
+{
+    ast::Node *previous = this->located;
+    if ( node->hasSourceRange())
+    {
+        this->located = node;
+    }
+
+    switch ( node->getType())
+    {
+        case ast::IDENTIFIER:
+        {
+            auto identifier = dynamic_cast<NIdentifier *>(node);
+            identifier->declaration = this->bind(identifier->name, scope, "identifier");
+        }
+            break;
+
+        case ast::FUNCTION_CALL:
+        {
+            auto call = dynamic_cast<NFunctionCall *>(node);
+            if ( call->functionName != nullptr )
+            {
+                call->declaration = this->bind(*call->functionName, scope, "function");
+            }
+            for ( auto argument: call->arguments )
+            {
+                this->resolve(argument, scope);
+            }
+        }
+            break;
+
+        case ast::MODULE_DECLARATION:
+        {
+            auto module = dynamic_cast<NModuleDeclaration *>(node);
+            if ( module->getBody() != nullptr )
+            {
+                this->resolveChildren(module->getBody(), this->table.scopeOf(module));
+            }
+        }
+            break;
+
+        case ast::CLASS_DECLARATION:
+        {
+            auto declaration = dynamic_cast<NClassDeclaration *>(node);
+            // Redeclared classes don't have a scope of their own.
+            Scope *members = this->table.scopeOf(declaration);
+            for ( auto parent: declaration->getParents())
+            {
+                // The type arguments of a parent are resolved by the type checker.
+                std::vector<std::string> arguments;
+                std::string parentName = ast::splitTypeArguments(parent->name, arguments);
+                parent->declaration = this->bind(parentName, scope, "class");
+                if ( parent->declaration == nullptr || members == nullptr )
+                {
+                    continue;
+                }
+                if ( parent->declaration->getType() != ast::CLASS_DECLARATION )
+                {
+                    this->report("'" + ast::splitIdentifier(parentName).back() + "' is not a class.");
+                }
+                else if ( !this->table.addBase(members, this->table.scopeOf(parent->declaration)))
+                {
+                    this->report("Class '" + declaration->getClassName() + "' inherits from itself.");
+                }
+            }
+            if ( members != nullptr && declaration->getBody() != nullptr )
+            {
+                this->resolveChildren(declaration->getBody(), members);
+            }
+        }
+            break;
+
+        case ast::STRUCTURE_DECLARATION:
+        case ast::ENUMERABLE_DECLARATION:
+            break;
+
+        case ast::FUNCTION_DECLARATION:
+        {
+            auto function = dynamic_cast<NFunctionDeclaration *>(node);
+            Scope *functionScope = this->table.createScope(scope, function);
+            for ( auto parameter: function->arguments )
+            {
+                if ( parameter->getValue() != nullptr )
+                {
+                    this->resolve(parameter->getValue(), scope);
+                }
+                this->declareVariable(parameter, functionScope, SYMBOL_PARAMETER);
+            }
+            if ( function->body != nullptr )
+            {
+                this->resolve(function->body, functionScope);
+            }
+        }
+            break;
+
+        case ast::BLOCK:
+        {
+            Scope *blockScope = this->table.createScope(scope, node);
+            this->declareAll(node, blockScope);
+            this->resolveChildren(node, blockScope);
+        }
+            break;
+
+        case ast::VARIABLE_DECLARATION:
+        {
+            // The value is resolved first, so it can't refer to the variable itself.
+            auto variable = dynamic_cast<NVariableDeclaration *>(node);
+            if ( variable->getValue() != nullptr )
+            {
+                this->resolve(variable->getValue(), scope);
+            }
+
+            // Variables of modules and classes are already declared, including redeclarations.
+            if ( !declaresUpfront(scope))
+            {
+                this->declareVariable(variable, scope, SYMBOL_VARIABLE);
+            }
+        }
+            break;
+
+        case ast::FOR_LOOP:
+        {
+            // Variables declared in the header of a loop are only visible in the loop.
+            auto loop = dynamic_cast<NForLoop *>(node);
+            Scope *loopScope = this->table.createScope(scope, loop);
+            for ( auto initializer: loop->getInitializers())
+            {
+                this->resolve(initializer, loopScope);
+            }
+            if ( loop->condition != nullptr )
+            {
+                this->resolve(loop->condition, loopScope);
+            }
+            for ( auto incrementor: loop->getIncrementors())
+            {
+                this->resolve(incrementor, loopScope);
+            }
+            if ( loop->body != nullptr )
+            {
+                this->resolve(loop->body, loopScope);
+            }
+        }
+            break;
+
+        case ast::TRY_CATCH_CLAUSE:
+        {
+            auto tryCatch = dynamic_cast<NTryCatchStatement *>(node);
+            if ( tryCatch->getTryBlock() != nullptr )
+            {
+                this->resolve(tryCatch->getTryBlock(), scope);
+            }
+
+            // The exception is only visible in the catch block.
+            Scope *catchScope = this->table.createScope(scope, tryCatch);
+            if ( tryCatch->getException() != nullptr )
+            {
+                this->declareVariable(tryCatch->getException(), catchScope, SYMBOL_VARIABLE);
+            }
+            if ( tryCatch->getCatchBlock() != nullptr )
+            {
+                this->resolve(tryCatch->getCatchBlock(), catchScope);
+            }
+        }
+            break;
+
+        default:
+            ast::forEachSubnode(node, [ this, scope ](ast::Node *subnode)
+            {
+                this->resolve(subnode, scope);
+            });
+            break;
+    }
+
+    this->located = previous;
+}
+
+void NameResolver::run(ast::Node &root)
+{
+    // The functions of imported files are visible, unless this file declares the same name.
+    for ( auto import: this->file.getImports())
+    {
+        ast::Node *importRoot = import->parse();
+        if ( importRoot != nullptr )
+        {
+            this->declareImport(importRoot, this->table.imports());
+        }
+    }
+    this->declareAll(&root, this->table.global());
+    this->resolveChildren(&root, this->table.global());
+}
@@ -0,0 +1,80 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_NAMERESOLVER_H
+#define STRIDE_LANGUAGE_NAMERESOLVER_H
+
+#include "SymbolTable.h"
+#include "../StrideFile.h"
+
+namespace stride::semantic
+{
+
+    /**
+     * Binds every identifier and function call to its declaration.
+     *
+     * Resolution happens in two steps. First, all modules, classes, structures,
+     * enumerables, functions and top-level variables are declared, so they can be
+     * referred to before their declaration. Then, the tree is visited in order;
+     * local variables and parameters are declared as they are encountered, so they
+     * are only visible after their declaration.
+     *
+     * The functions of imported files, and the modules that contain them, are declared
+     * in a scope that encloses the global scope. Paths of which the first segment isn't
+     * declared, or refers to an imported module, are assumed to refer to another
+     * compilation unit, and are left unbound. Other names that can't be resolved are
+     * reported as errors.
+     */
+    class NameResolver
+    {
+    private:
+        StrideFile &file;
+        SymbolTable &table;
+        ast::Node *located;
+        size_t boundCount;
+        size_t externalCount;
+
+        void declare(ast::Node *node, Scope *scope);
+
+        void declareAll(ast::Node *container, Scope *scope);
+
+        /**
+         * Declares the functions and modules of an imported file.
+         */
+        void declareImport(ast::Node *container, Scope *scope);
+
+        void declareVariable(ast::Node *declaration, Scope *scope, ESymbolKind kind);
+
+        void resolve(ast::Node *node, Scope *scope);
+
+        void resolveChildren(ast::Node *container, Scope *scope);
+
+        ast::Node *bind(const std::string &name, Scope *scope, const char *description);
+
+        void report(const std::string &message);
+
+    public:
+
+        NameResolver(StrideFile &file, SymbolTable &table);
+
+        /**
+         * Resolves all names in the provided tree.
+         */
+        void run(ast::Node &root);
+
+        /**
+         * Returns the amount of identifiers and calls that were bound to a declaration.
+         */
+        [[nodiscard]] size_t getBoundCount() const
+        { return boundCount; }
+
+        /**
+         * Returns the amount of identifiers and calls that refer to another compilation unit.
+         */
+        [[nodiscard]] size_t getExternalCount() const
+        { return externalCount; }
+    };
+}
+
+#endif //STRIDE_LANGUAGE_NAMERESOLVER_H
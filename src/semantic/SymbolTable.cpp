@@ -0,0 +1,207 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include "SymbolTable.h"
+
+using namespace stride;
+using namespace stride::semantic;
+
+SymbolTable::SymbolTable()
+{
+    // Imported modules have a trie of their own, so they don't merge with the modules of the file.
+    this->importScope = this->createScope(nullptr, nullptr);
+    this->modules.push_back(std::make_unique<ModuleNode>(ModuleNode { nullptr, {}, nullptr }));
+    this->importScope->module = this->modules.back().get();
+
+    this->globalScope = this->createScope(this->importScope, nullptr);
+    this->modules.push_back(std::make_unique<ModuleNode>(ModuleNode { nullptr, {}, nullptr }));
+    this->rootModule = this->modules.back().get();
+    this->globalScope->module = this->rootModule;
+}
+
+bool SymbolTable::isImported(const Scope *scope) const
+{
+    for ( ; scope != nullptr; scope = scope->parent )
+    {
+        if ( scope == this->globalScope )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+Scope *SymbolTable::createScope(Scope *parent, ast::Node *owner)
+{
+    this->scopes.push_back(std::make_unique<Scope>(Scope { parent, owner, nullptr, {}, {}}));
+    Scope *scope = this->scopes.back().get();
+    if ( owner != nullptr )
+    {
+        this->nodeScopes[ owner ] = scope;
+    }
+    return scope;
+}
+
+Scope *SymbolTable::scopeOf(ast::Node *node) const
+{
+    auto entry = this->nodeScopes.find(node);
+    return entry == this->nodeScopes.end() ? nullptr : entry->second;
+}
+
+Symbol *SymbolTable::declare(Scope *scope, ESymbolKind kind, Atom name, ast::Node *declaration)
+{
+    Symbol *existing = scope->symbols.find(name);
+    if ( existing != nullptr )
+    {
+        return existing;
+    }
+    this->symbols.push_back(std::make_unique<Symbol>(Symbol { kind, name, declaration, nullptr, this->isImported(scope) }));
+    return scope->symbols.insert(name, this->symbols.back().get());
+}
+
+ModuleNode *SymbolTable::declareModule(Scope *scope, const std::vector<Atom> &path, ast::Node *declaration)
+{
+    // Modules declared in a block, rather than in another module, are declared at the top level.
+    Scope *moduleScope = scope;
+    while ( moduleScope->module == nullptr )
+    {
+        moduleScope = moduleScope->parent;
+    }
+
+    ModuleNode *node = moduleScope->module;
+    for ( Atom segment: path )
+    {
+        ModuleNode *child = node->children.find(segment);
+        if ( child == nullptr )
+        {
+            Scope *parentScope = node->symbol != nullptr ? node->symbol->members : moduleScope;
+            this->symbols.push_back(std::make_unique<Symbol>(Symbol { SYMBOL_MODULE, segment, declaration, nullptr,
+                                                                      this->isImported(moduleScope) }));
+            this->modules.push_back(std::make_unique<ModuleNode>(ModuleNode { node, {}, this->symbols.back().get() }));
+            child = node->children.insert(segment, this->modules.back().get());
+
+            // The members of the module are visible in the modules it's nested in.
+            child->symbol->members = this->createScope(parentScope, nullptr);
+            child->symbol->members->module = child;
+        }
+        node = child;
+    }
+    this->nodeScopes[ declaration ] = node->symbol->members;
+    return node;
+}
+
+/**
+ * Looks up a name in the symbols of a scope, and in the scopes of its base classes.
+ */
+static Symbol *findInScope(const Scope *scope, Atom name)
+{
+    Symbol *symbol = scope->symbols.find(name);
+    for ( size_t i = 0; symbol == nullptr && i < scope->bases.size(); i++ )
+    {
+        symbol = findInScope(scope->bases[ i ], name);
+    }
+    return symbol;
+}
+
+static bool inheritsFrom(const Scope *scope, const Scope *base)
+{
+    if ( scope == base )
+    {
+        return true;
+    }
+    for ( auto inherited: scope->bases )
+    {
+        if ( inheritsFrom(inherited, base))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SymbolTable::addBase(Scope *members, Scope *base)
+{
+    if ( inheritsFrom(base, members))
+    {
+        return false;
+    }
+    members->bases.push_back(base);
+    return true;
+}
+
+Symbol *SymbolTable::lookup(Scope *scope, Atom name) const
+{
+    for ( ; scope != nullptr; scope = scope->parent )
+    {
+        Symbol *symbol = findInScope(scope, name);
+        if ( symbol != nullptr )
+        {
+            return symbol;
+        }
+        if ( scope->module != nullptr )
+        {
+            ModuleNode *module = scope->module->children.find(name);
+            if ( module != nullptr )
+            {
+                return module->symbol;
+            }
+        }
+    }
+    return nullptr;
+}
+
+Symbol *SymbolTable::lookupMember(Symbol *symbol, Atom name) const
+{
+    if ( symbol->members == nullptr )
+    {
+        return nullptr;
+    }
+    if ( symbol->kind == SYMBOL_MODULE )
+    {
+        ModuleNode *module = symbol->members->module->children.find(name);
+        if ( module != nullptr )
+        {
+            return module->symbol;
+        }
+    }
+    return findInScope(symbol->members, name);
+}
+
+Symbol *SymbolTable::lookupPath(Scope *scope, const std::vector<std::string> &path, size_t *resolvedCount) const
+{
+    Symbol *symbol = nullptr;
+    size_t resolved = 0;
+    for ( ; resolved < path.size(); resolved++ )
+    {
+        // Names that were never interned can't have been declared.
+        Atom segment = this->atomTable.find(path[ resolved ]);
+        Symbol *next = segment == ATOM_NONE ? nullptr :
+                       resolved == 0 ? this->lookup(scope, segment) : this->lookupMember(symbol, segment);
+        if ( next == nullptr )
+        {
+            symbol = nullptr;
+            break;
+        }
+        symbol = next;
+    }
+    if ( resolvedCount != nullptr )
+    {
+        *resolvedCount = resolved;
+    }
+    return symbol;
+}
+
+ModuleNode *SymbolTable::findModule(const std::vector<std::string> &path) const
+{
+    ModuleNode *node = this->rootModule;
+    for ( auto &segment: path )
+    {
+        Atom atom = this->atomTable.find(segment);
+        if ( atom == ATOM_NONE || ( node = node->children.find(atom)) == nullptr )
+        {
+            return nullptr;
+        }
+    }
+    return node;
+}
@@ -0,0 +1,300 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_SYMBOLTABLE_H
+#define STRIDE_LANGUAGE_SYMBOLTABLE_H
+
+#include <memory>
+#include <unordered_map>
+#include "Atom.h"
+#include "../syntax_tree/ASTNodes.h"
+
+namespace stride::semantic
+{
+
+    /**
+     * Open-addressing hash map from atoms to pointers.
+     * As atoms are small sequential integers, they are hashed with a single
+     * multiplication. ATOM_NONE marks an empty slot, so it can't be used as key.
+     */
+    template<typename T>
+    class AtomMap
+    {
+    private:
+        struct Entry
+        {
+            Atom key;
+            T *value;
+        };
+
+        std::vector<Entry> entries;
+        size_t count = 0;
+
+        static size_t slotOf(Atom key, size_t mask)
+        {
+            return ( key * 0x9E3779B1u ) & mask;
+        }
+
+        void grow()
+        {
+            std::vector<Entry> previous = std::move(this->entries);
+            this->entries.assign(previous.empty() ? 8 : previous.size() * 2, { ATOM_NONE, nullptr });
+            size_t mask = this->entries.size() - 1;
+            for ( auto &entry: previous )
+            {
+                if ( entry.key != ATOM_NONE )
+                {
+                    size_t slot = slotOf(entry.key, mask);
+                    while ( this->entries[ slot ].key != ATOM_NONE )
+                    {
+                        slot = ( slot + 1 ) & mask;
+                    }
+                    this->entries[ slot ] = entry;
+                }
+            }
+        }
+
+    public:
+
+        /**
+         * Returns the value of a key, or nullptr if it isn't present.
+         */
+        T *find(Atom key) const
+        {
+            if ( this->entries.empty())
+            {
+                return nullptr;
+            }
+            size_t mask = this->entries.size() - 1;
+            for ( size_t slot = slotOf(key, mask); this->entries[ slot ].key != ATOM_NONE; slot = ( slot + 1 ) & mask )
+            {
+                if ( this->entries[ slot ].key == key )
+                {
+                    return this->entries[ slot ].value;
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * Inserts a value, unless the key is already present.
+         * @return The value of the key after inserting.
+         */
+        T *insert(Atom key, T *value)
+        {
+            if (( this->count + 1 ) * 2 > this->entries.size())
+            {
+                this->grow();
+            }
+            size_t mask = this->entries.size() - 1;
+            size_t slot = slotOf(key, mask);
+            for ( ; this->entries[ slot ].key != ATOM_NONE; slot = ( slot + 1 ) & mask )
+            {
+                if ( this->entries[ slot ].key == key )
+                {
+                    return this->entries[ slot ].value;
+                }
+            }
+            this->entries[ slot ] = { key, value };
+            this->count++;
+            return value;
+        }
+
+        [[nodiscard]] size_t size() const
+        { return count; }
+
+        template<typename F>
+        void forEach(F visitor) const
+        {
+            for ( auto &entry: this->entries )
+            {
+                if ( entry.key != ATOM_NONE )
+                {
+                    visitor(entry.key, entry.value);
+                }
+            }
+        }
+    };
+
+    enum ESymbolKind
+    {
+        SYMBOL_MODULE,
+        SYMBOL_CLASS,
+        SYMBOL_STRUCTURE,
+        SYMBOL_ENUMERABLE,
+        SYMBOL_ENUM_MEMBER,
+        SYMBOL_FUNCTION,
+        SYMBOL_VARIABLE,
+        SYMBOL_PARAMETER
+    };
+
+    struct Scope;
+    struct ModuleNode;
+
+    /**
+     * A declared name.
+     */
+    struct Symbol
+    {
+        ESymbolKind kind;
+        Atom name;
+
+        /**
+         * The node that declares the symbol.
+         * For enum members, this is the declaration of the enumerable.
+         */
+        ast::Node *declaration;
+
+        /**
+         * The scope of the members of a module, class, structure or enumerable.
+         */
+        Scope *members;
+
+        /**
+         * Whether the symbol is declared by an imported file.
+         */
+        bool imported;
+    };
+
+    /**
+     * A lexical scope.
+     * Names are looked up in the scope itself first, and then in its parents.
+     */
+    struct Scope
+    {
+        Scope *parent;
+
+        /**
+         * The node that introduces the scope.
+         */
+        ast::Node *owner;
+
+        /**
+         * The module this scope holds the members of, if any.
+         * Submodules are looked up in the module trie, rather than in the symbols of the scope.
+         */
+        ModuleNode *module;
+
+        /**
+         * The member scopes of the classes a class inherits from.
+         * Names that aren't declared in the class itself are looked up in these.
+         */
+        std::vector<Scope *> bases;
+
+        AtomMap<Symbol> symbols;
+    };
+
+    /**
+     * A node of the module trie.
+     * Every module path, e.g. 'outer::inner', has one node, regardless of how many
+     * times the module is declared. Its members are merged into a single scope.
+     */
+    struct ModuleNode
+    {
+        ModuleNode *parent;
+        AtomMap<ModuleNode> children;
+        Symbol *symbol;
+    };
+
+    /**
+     * The symbols of a compilation unit.
+     * All scopes, symbols and module nodes are owned by the table.
+     */
+    class SymbolTable
+    {
+    private:
+        AtomTable atomTable;
+        std::vector<std::unique_ptr<Scope>> scopes;
+        std::vector<std::unique_ptr<Symbol>> symbols;
+        std::vector<std::unique_ptr<ModuleNode>> modules;
+        std::unordered_map<ast::Node *, Scope *> nodeScopes;
+        ModuleNode *rootModule;
+        Scope *globalScope;
+        Scope *importScope;
+
+        /**
+         * Whether a scope holds declarations of imported files, rather than of the file itself.
+         */
+        [[nodiscard]] bool isImported(const Scope *scope) const;
+
+    public:
+
+        SymbolTable();
+
+        [[nodiscard]] AtomTable &atoms()
+        { return atomTable; }
+
+        [[nodiscard]] const AtomTable &atoms() const
+        { return atomTable; }
+
+        /**
+         * Returns the outermost scope, which holds the top-level declarations.
+         */
+        [[nodiscard]] Scope *global() const
+        { return globalScope; }
+
+        /**
+         * Returns the scope of the top-level declarations of imported files, which encloses the
+         * global scope; the declarations of the file itself shadow the imported ones.
+         */
+        [[nodiscard]] Scope *imports() const
+        { return importScope; }
+
+        /**
+         * Creates a scope, and associates it with the node that introduces it.
+         */
+        Scope *createScope(Scope *parent, ast::Node *owner);
+
+        /**
+         * Returns the scope that a node introduces, or nullptr if it doesn't introduce any.
+         */
+        [[nodiscard]] Scope *scopeOf(ast::Node *node) const;
+
+        /**
+         * Declares a symbol in a scope.
+         * @return The symbol, or the symbol that was already declared with the same name.
+         */
+        Symbol *declare(Scope *scope, ESymbolKind kind, Atom name, ast::Node *declaration);
+
+        /**
+         * Makes the members of a base class visible in a class.
+         * @return Whether the base was added; it isn't if the base inherits from the class itself.
+         */
+        bool addBase(Scope *members, Scope *base);
+
+        /**
+         * Returns the trie node of a module path, relative to the module of the provided scope.
+         * Nodes that don't exist yet are created.
+         */
+        ModuleNode *declareModule(Scope *scope, const std::vector<Atom> &path, ast::Node *declaration);
+
+        /**
+         * Looks up a name in a scope and its parents.
+         * @return The symbol, or nullptr if no symbol with this name is visible.
+         */
+        [[nodiscard]] Symbol *lookup(Scope *scope, Atom name) const;
+
+        /**
+         * Looks up a member of a module, class, structure or enumerable.
+         */
+        [[nodiscard]] Symbol *lookupMember(Symbol *symbol, Atom name) const;
+
+        /**
+         * Looks up a path, e.g. 'outer::inner::function'.
+         * The first segment is looked up in the scope and its parents; every
+         * following segment is a member of the symbol before it.
+         * @param resolvedCount Receives the amount of segments that were resolved.
+         * @return The symbol of the last segment, or nullptr if any segment couldn't be resolved.
+         */
+        Symbol *lookupPath(Scope *scope, const std::vector<std::string> &path, size_t *resolvedCount = nullptr) const;
+
+        /**
+         * Looks up an absolute module path, starting at the top-level modules.
+         * @return The trie node of the module, or nullptr if it isn't declared.
+         */
+        [[nodiscard]] ModuleNode *findModule(const std::vector<std::string> &path) const;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_SYMBOLTABLE_H
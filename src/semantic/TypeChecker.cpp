@@ -0,0 +1,772 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include "TypeChecker.h"
+#include "../syntax_tree/ASTTraversal.h"
+#include "../syntax_tree/NodeProperties.h"
+#include "../syntax_tree/node_types/definitions/NArray.h"
+#include "../syntax_tree/node_types/definitions/NBinaryOperation.h"
+#include "../syntax_tree/node_types/definitions/NClassDeclaration.h"
+#include "../syntax_tree/node_types/definitions/NConditionalStatement.h"
+#include "../syntax_tree/node_types/definitions/NForLoop.h"
+#include "../syntax_tree/node_types/definitions/NFunctionCall.h"
+#include "../syntax_tree/node_types/definitions/NFunctionDeclaration.h"
+#include "../syntax_tree/node_types/definitions/NLiteral.h"
+#include "../syntax_tree/node_types/definitions/NModuleDeclaration.h"
+#include "../syntax_tree/node_types/definitions/NReturnStatement.h"
+#include "../syntax_tree/node_types/definitions/NStructureDeclaration.h"
+#include "../syntax_tree/node_types/definitions/NSwitchStatement.h"
+#include "../syntax_tree/node_types/definitions/NUnaryOperator.h"
+#include "../syntax_tree/node_types/definitions/NWhileLoop.h"
+
+using namespace stride;
+using namespace stride::semantic;
+
+TypeChecker::TypeChecker(StrideFile &file, SymbolTable &symbols, TypeTable &types) :
+        file(file), symbols(symbols), types(types), unifier(types), scope(symbols.global()), located(nullptr),
+        importing(false)
+{}
+
+void TypeChecker::report(ast::Node *node, const std::string &message)
+{
+    if ( this->importing )
+    {
+        return;
+    }
+    ast::Node *location = node != nullptr && node->hasSourceRange() ? node : this->located;
+    int start = location != nullptr ? location->getSourceStart() : 0;
+    int length = location != nullptr ? location->getSourceEnd() - start : 0;
+    this->file.diagnostics().report(error::ERROR, start, length, message);
+}
+
+void TypeChecker::expect(ast::Node *node, const Type *expected, const Type *actual)
+{
+    if ( !this->unifier.unify(expected, actual))
+    {
+        this->report(node, "Type mismatch: expected '" + this->unifier.describe(expected) +
+                           "', but found '" + this->unifier.describe(actual) + "'.");
+    }
+}
+
+/**
+ * Returns a mangled name as it's written in source, e.g. 'outer::function'.
+ */
+static std::string writtenName(const std::string &name)
+{
+    std::vector<std::string> path = ast::splitIdentifier(name);
+    std::string written = path[ 0 ];
+    for ( size_t i = 1; i < path.size(); i++ )
+    {
+        written.append("::").append(path[ i ]);
+    }
+    return written;
+}
+
+const Type *TypeChecker::resolveTypeName(const std::string &name)
+{
+    // Primitive return types are stored by their keyword.
+    if ( name == "auto" )
+    {
+        return this->unifier.fresh();
+    }
+    const Type *primitive = this->types.primitive(name);
+    if ( primitive != nullptr )
+    {
+        return primitive;
+    }
+
+    // Type arguments may be arrays, e.g. 'Vector<i32[]>'.
+    if ( name.size() > 2 && name.compare(name.size() - 2, 2, "[]") == 0 )
+    {
+        return this->types.array(this->resolveTypeName(name.substr(0, name.size() - 2)));
+    }
+
+    std::vector<std::string> argumentNames;
+    std::string baseName = ast::splitTypeArguments(name, argumentNames);
+    std::vector<const Type *> arguments;
+    for ( auto &argumentName: argumentNames )
+    {
+        arguments.push_back(this->resolveTypeName(argumentName));
+    }
+
+    // Generic parameters of the enclosing classes and structures.
+    std::vector<std::string> path = ast::splitIdentifier(baseName);
+    if ( path.size() == 1 )
+    {
+        for ( auto owner = this->genericOwners.rbegin(); owner != this->genericOwners.rend(); owner++ )
+        {
+            auto &generics = ( *owner )->getType() == ast::CLASS_DECLARATION ?
+                             dynamic_cast<NClassDeclaration *>(*owner)->getGenerics() :
+                             dynamic_cast<NStructureDeclaration *>(*owner)->getGenerics();
+            for ( uint32_t i = 0; i < generics.size(); i++ )
+            {
+                if ( *generics[ i ] == path[ 0 ] )
+                {
+                    return this->types.parameter(*owner, i);
+                }
+            }
+        }
+    }
+
+    size_t resolvedCount;
+    Symbol *symbol = this->symbols.lookupPath(this->scope, path, &resolvedCount);
+    std::string written = writtenName(baseName);
+    if ( symbol != nullptr && ( symbol->kind == SYMBOL_CLASS || symbol->kind == SYMBOL_STRUCTURE ))
+    {
+        return this->instantiate(symbol->declaration, arguments, written);
+    }
+    if ( symbol != nullptr && symbol->kind == SYMBOL_ENUMERABLE )
+    {
+        if ( !arguments.empty())
+        {
+            this->report(nullptr, "'" + written + "' doesn't have type arguments.");
+        }
+        return this->types.named(symbol->declaration);
+    }
+
+    // Types of modules that aren't declared in this file, or of imported ones, of which only functions are declared.
+    if ( symbol == nullptr && resolvedCount == 0 && path.size() > 1 )
+    {
+        return this->types.external(written);
+    }
+    if ( symbol == nullptr && resolvedCount > 0 )
+    {
+        Symbol *parent = this->symbols.lookupPath(this->scope, { path.begin(), path.begin() + (long) resolvedCount });
+        if ( parent != nullptr && parent->imported )
+        {
+            return this->types.external(written);
+        }
+    }
+    this->report(nullptr, symbol == nullptr ? "Unknown type '" + written + "'." : "'" + written + "' is not a type.");
+    return this->types.unknown();
+}
+
+const Type *TypeChecker::instantiate(ast::Node *declaration, std::vector<const Type *> arguments,
+                                     const std::string &written)
+{
+    size_t genericCount = declaration->getType() == ast::CLASS_DECLARATION ?
+                          dynamic_cast<NClassDeclaration *>(declaration)->getGenerics().size() :
+                          dynamic_cast<NStructureDeclaration *>(declaration)->getGenerics().size();
+    if ( genericCount == 0 && arguments.empty())
+    {
+        return this->types.named(declaration);
+    }
+
+    // The arguments of a generic type that's used without them are inferred, e.g. 'let v: Vector = Vector();'.
+    if ( arguments.empty())
+    {
+        for ( size_t i = 0; i < genericCount; i++ )
+        {
+            arguments.push_back(this->unifier.fresh());
+        }
+    }
+    if ( arguments.size() != genericCount )
+    {
+        this->report(nullptr, "'" + written + "' expects " + std::to_string(genericCount) + " type argument" +
+                              ( genericCount == 1 ? "" : "s" ) + ", but received " + std::to_string(arguments.size()) + ".");
+        return this->types.unknown();
+    }
+    return this->types.instance(declaration, arguments);
+}
+
+const Type *TypeChecker::variableType(NVariableDeclaration *variable)
+{
+    auto &declared = variable->getVariableType();
+    const Type *type;
+    if ( std::holds_alternative<token_type_t>(declared))
+    {
+        type = std::get<token_type_t>(declared) == TOKEN_PRIMITIVE_AUTO ? this->unifier.fresh() :
+               this->types.primitive(std::get<token_type_t>(declared));
+    }
+    else
+    {
+        type = std::get<std::string *>(declared) != nullptr ? this->resolveTypeName(*std::get<std::string *>(declared))
+                                                            : this->unifier.fresh();
+    }
+    if ( type == nullptr )
+    {
+        type = this->types.unknown();
+    }
+
+    if ( variable->isVariadicParameter())
+    {
+        return this->types.variadic(type);
+    }
+    if ( variable->hasSoaLayout())
+    {
+        // Only the fields of structures can be split into arrays of their own.
+        const Type *element = this->unifier.prune(type);
+        bool isStructure = ( element->kind == TYPE_NAMED || element->kind == TYPE_INSTANCE ) &&
+                           element->declaration->getType() == ast::STRUCTURE_DECLARATION;
+        if ( !variable->isArrayType())
+        {
+            this->report(variable, "The 'soa' layout only applies to arrays.");
+        }
+        else if ( !isStructure && element->kind != TYPE_PARAMETER && element->kind != TYPE_UNKNOWN )
+        {
+            this->report(variable, "The 'soa' layout requires an array of structures, but the elements are '" +
+                                   this->unifier.describe(element) + "'.");
+        }
+        else
+        {
+            return this->types.soaArray(type);
+        }
+    }
+    return variable->isArrayType() ? this->types.array(type) : type;
+}
+
+/**
+ * Returns the function type of a function, and declares the types of its parameters.
+ * @param result The return type, if the function doesn't declare one.
+ */
+const Type *TypeChecker::functionType(NFunctionDeclaration *function, const Type *result)
+{
+    std::vector<const Type *> parameters;
+    for ( auto parameter: function->arguments )
+    {
+        const Type *type = this->variableType(parameter);
+        this->declarationTypes[ parameter ] = type;
+        if ( !this->importing )
+        {
+            this->declarationOrder.push_back(parameter);
+        }
+        parameters.push_back(type);
+    }
+    if ( function->returnType != nullptr )
+    {
+        result = this->resolveTypeName(function->returnType->name);
+    }
+    return this->types.function(parameters, result);
+}
+
+void TypeChecker::declare(ast::Node *node)
+{
+    ast::Node *previousLocated = this->located;
+    Scope *previousScope = this->scope;
+    size_t genericDepth = this->genericOwners.size();
+
+    if ( node->hasSourceRange())
+    {
+        this->located = node;
+    }
+    Scope *inner = this->symbols.scopeOf(node);
+    if ( inner != nullptr )
+    {
+        this->scope = inner;
+    }
+
+    switch ( node->getType())
+    {
+        case ast::CLASS_DECLARATION:
+        {
+            // Parents are resolved in the scope the class is declared in, and may use its generic parameters.
+            this->genericOwners.push_back(node);
+            this->scope = previousScope;
+            std::vector<const Type *> &bases = this->baseTypes[ node ];
+            for ( auto parent: dynamic_cast<NClassDeclaration *>(node)->getParents())
+            {
+                if ( parent->declaration != nullptr && parent->declaration->getType() == ast::CLASS_DECLARATION )
+                {
+                    bases.push_back(this->resolveTypeName(parent->name));
+                }
+            }
+            this->scope = inner != nullptr ? inner : previousScope;
+        }
+            break;
+
+        case ast::STRUCTURE_DECLARATION:
+            this->genericOwners.push_back(node);
+            break;
+
+        case ast::VARIABLE_DECLARATION:
+            this->declarationTypes[ node ] = this->variableType(dynamic_cast<NVariableDeclaration *>(node));
+            this->declarationOrder.push_back(node);
+            break;
+
+        case ast::FUNCTION_DECLARATION:
+        {
+            // The type of the parameters is resolved in the scope the function is declared in.
+            auto function = dynamic_cast<NFunctionDeclaration *>(node);
+            this->scope = previousScope;
+            this->declarationTypes[ function ] = this->functionType(function, this->unifier.fresh());
+            this->declarationOrder.push_back(function);
+            this->scope = inner != nullptr ? inner : previousScope;
+
+            if ( function->body != nullptr )
+            {
+                this->declare(function->body);
+            }
+        }
+            this->scope = previousScope;
+            this->located = previousLocated;
+            return;
+
+        default:
+            break;
+    }
+
+    ast::forEachSubnode(node, [ this ](ast::Node *subnode)
+    {
+        this->declare(subnode);
+    });
+
+    this->genericOwners.resize(genericDepth);
+    this->scope = previousScope;
+    this->located = previousLocated;
+}
+
+const Type *TypeChecker::checkBinary(ast::Node *node)
+{
+    auto binary = dynamic_cast<NBinaryOperation *>(node);
+    const Type *left = this->check(binary->left);
+    const Type *right = this->check(binary->right);
+
+    if ( binary->operation == AND || binary->operation == OR )
+    {
+        this->expect(binary->left, this->types.boolean(), left);
+        this->expect(binary->right, this->types.boolean(), right);
+        return this->types.boolean();
+    }
+
+    this->expect(binary->right, left, right);
+    if ( binary->isComparison())
+    {
+        if ( binary->operation != EQUALS && binary->operation != NOT_EQUALS )
+        {
+            this->operandChecks.push_back({ node, left, false });
+        }
+        return this->types.boolean();
+    }
+    if ( binary->operation != ASSIGN )
+    {
+        this->operandChecks.push_back({ node, left, binary->operation == ADD || binary->operation == ADD_ASSIGN });
+    }
+    return left;
+}
+
+const Type *TypeChecker::checkUnary(ast::Node *node)
+{
+    auto unary = dynamic_cast<NUnaryOperator *>(node);
+    const Type *operand = this->check(unary->expression.get());
+    if ( unary->operation == NEGATE )
+    {
+        this->expect(unary->expression.get(), this->types.boolean(), operand);
+        return this->types.boolean();
+    }
+    this->operandChecks.push_back({ node, operand, false });
+    return operand;
+}
+
+const Type *TypeChecker::checkCall(ast::Node *node)
+{
+    auto call = dynamic_cast<NFunctionCall *>(node);
+    std::vector<const Type *> arguments;
+    for ( auto argument: call->arguments )
+    {
+        arguments.push_back(this->check(argument));
+    }
+
+    if ( call->declaration == nullptr )
+    {
+        return this->types.unknown();
+    }
+
+    switch ( call->declaration->getType())
+    {
+        case ast::FUNCTION_DECLARATION:
+        {
+            const Type *function = this->declarationTypes[ call->declaration ];
+            auto &parameters = function->arguments;
+            bool variadic = !parameters.empty() && parameters.back()->kind == TYPE_VARIADIC;
+            size_t required = variadic ? parameters.size() - 1 : parameters.size();
+
+            if ( arguments.size() < required || ( !variadic && arguments.size() > required ))
+            {
+                this->report(node, "Function '" + writtenName(*call->functionName) + "' expects " + std::to_string(required) +
+                                   ( variadic ? " or more" : "" ) + " arguments, but received " +
+                                   std::to_string(arguments.size()) + ".");
+                return function->element;
+            }
+            for ( size_t i = 0; i < arguments.size(); i++ )
+            {
+                const Type *parameter = i < required ? parameters[ i ] : parameters.back()->element;
+                this->expect(call->arguments[ i ], parameter, arguments[ i ]);
+            }
+            return function->element;
+        }
+
+        case ast::CLASS_DECLARATION:
+        case ast::STRUCTURE_DECLARATION:
+            // Constructing an instance; the type arguments of generic types are inferred.
+            return this->instantiate(call->declaration, {}, writtenName(*call->functionName));
+
+        case ast::VARIABLE_DECLARATION:
+        {
+            const Type *result = this->unifier.fresh();
+            this->expect(node, this->declarationTypes[ call->declaration ], this->types.function(arguments, result));
+            return result;
+        }
+
+        default:
+            this->report(node, "'" + writtenName(*call->functionName) + "' is not a function.");
+            return this->types.unknown();
+    }
+}
+
+const Type *TypeChecker::check(ast::Node *node)
+{
+    ast::Node *previousLocated = this->located;
+    Scope *previousScope = this->scope;
+    size_t genericDepth = this->genericOwners.size();
+
+    if ( node->hasSourceRange())
+    {
+        this->located = node;
+    }
+    Scope *inner = this->symbols.scopeOf(node);
+    if ( inner != nullptr )
+    {
+        this->scope = inner;
+    }
+
+    const Type *type = nullptr;
+    switch ( node->getType())
+    {
+        case ast::LITERAL:
+        {
+            auto literal = dynamic_cast<NLiteral *>(node);
+            type = std::holds_alternative<const char *>(literal->value) ? this->types.string() :
+                   this->unifier.fresh(std::holds_alternative<int64_t>(literal->value) ? LITERAL_INTEGER : LITERAL_FLOAT);
+        }
+            break;
+
+        case ast::IDENTIFIER:
+        {
+            auto identifier = dynamic_cast<NIdentifier *>(node);
+            std::vector<std::string> path = ast::splitIdentifier(identifier->name);
+            if ( path.size() == 1 && ( path[ 0 ] == "true" || path[ 0 ] == "false" ))
+            {
+                type = this->types.boolean();
+            }
+            else if ( identifier->declaration == nullptr )
+            {
+                type = this->types.unknown();
+            }
+            else
+            {
+                switch ( identifier->declaration->getType())
+                {
+                    case ast::VARIABLE_DECLARATION:
+                    case ast::FUNCTION_DECLARATION:
+                        type = this->declarationTypes[ identifier->declaration ];
+                        break;
+                    case ast::ENUMERABLE_DECLARATION:
+                        type = this->types.named(identifier->declaration);
+                        break;
+                    default:
+                        this->report(node, "'" + path.back() + "' is not a value.");
+                        type = this->types.unknown();
+                        break;
+                }
+            }
+        }
+            break;
+
+        case ast::BINARY_OPERATOR:
+            type = this->checkBinary(node);
+            break;
+
+        case ast::UNARY_OPERATOR:
+            type = this->checkUnary(node);
+            break;
+
+        case ast::FUNCTION_CALL:
+            type = this->checkCall(node);
+            break;
+
+        case ast::ARRAY:
+        {
+            const Type *element = this->unifier.fresh();
+            for ( auto item: dynamic_cast<NArray *>(node)->elements )
+            {
+                this->expect(item, element, this->check(item));
+            }
+            type = this->types.array(element);
+        }
+            break;
+
+        case ast::EXPRESSION:
+            for ( size_t i = 0; i < node->getChildCount(); i++ )
+            {
+                type = this->check(node->getChild(i));
+            }
+            if ( node->getChildCount() != 1 )
+            {
+                type = nullptr;
+            }
+            break;
+
+        case ast::CLASS_DECLARATION:
+            // The parents are types, not values; they're resolved when declaring.
+            this->genericOwners.push_back(node);
+            if ( dynamic_cast<NClassDeclaration *>(node)->getBody() != nullptr )
+            {
+                this->check(dynamic_cast<NClassDeclaration *>(node)->getBody());
+            }
+            break;
+
+        case ast::STRUCTURE_DECLARATION:
+            this->genericOwners.push_back(node);
+            ast::forEachSubnode(node, [ this ](ast::Node *subnode) { this->check(subnode); });
+            break;
+
+        case ast::VARIABLE_DECLARATION:
+        {
+            auto variable = dynamic_cast<NVariableDeclaration *>(node);
+            if ( variable->getValue() != nullptr )
+            {
+                // Array literals are split into the fields of their elements when they're stored.
+                const Type *declared = this->declarationTypes[ variable ];
+                ast::Node *value = variable->getValue();
+                while ( value->getType() == ast::EXPRESSION && value->getChildCount() == 1 )
+                {
+                    value = value->getChild(0);
+                }
+                if ( declared->kind == TYPE_SOA_ARRAY && value->getType() == ast::ARRAY )
+                {
+                    declared = this->types.array(declared->element);
+                }
+                this->expect(variable->getValue(), declared, this->check(variable->getValue()));
+            }
+        }
+            break;
+
+        case ast::FUNCTION_DECLARATION:
+        {
+            auto function = dynamic_cast<NFunctionDeclaration *>(node);
+            this->functions.push_back(function);
+            for ( auto parameter: function->arguments )
+            {
+                this->check(parameter);
+            }
+            if ( function->body != nullptr )
+            {
+                this->check(function->body);
+            }
+            this->functions.pop_back();
+
+            // Functions without a return type that don't return a value, return void.
+            const Type *result = this->unifier.prune(this->declarationTypes[ function ]->element);
+            if ( result->kind == TYPE_VARIABLE )
+            {
+                this->unifier.unify(result, this->types.voidType());
+            }
+        }
+            break;
+
+        case ast::RETURN_STATEMENT:
+        {
+            auto statement = dynamic_cast<NReturnStatement *>(node);
+            const Type *value = statement->getExpression() != nullptr ? this->check(statement->getExpression()) :
+                                this->types.voidType();
+            if ( !this->functions.empty())
+            {
+                this->expect(statement->getExpression() != nullptr ? statement->getExpression() : node,
+                             this->declarationTypes[ this->functions.back() ]->element, value);
+            }
+        }
+            break;
+
+        case ast::CONDITIONAL_STATEMENT:
+        {
+            auto conditional = dynamic_cast<NConditionalStatement *>(node);
+            if ( conditional->getCondition() != nullptr )
+            {
+                this->expect(conditional->getCondition(), this->types.boolean(), this->check(conditional->getCondition()));
+            }
+            if ( conditional->getThen() != nullptr )
+            {
+                this->check(conditional->getThen());
+            }
+            if ( conditional->getElse() != nullptr )
+            {
+                this->check(conditional->getElse());
+            }
+        }
+            break;
+
+        case ast::WHILE_LOOP:
+        case ast::DO_WHILE_LOOP:
+        case ast::FOR_LOOP:
+        {
+            // The condition of a loop must be a boolean; for loops have initializers and incrementors as well.
+            NExpression *condition = node->getType() == ast::FOR_LOOP ? dynamic_cast<NForLoop *>(node)->condition :
+                                     dynamic_cast<NWhileLoop *>(node)->condition;
+            ast::forEachSubnode(node, [ this, condition ](ast::Node *subnode)
+            {
+                const Type *subnodeType = this->check(subnode);
+                if ( subnode == condition )
+                {
+                    this->expect(condition, this->types.boolean(), subnodeType);
+                }
+            });
+        }
+            break;
+
+        case ast::SWITCH_STATEMENT:
+        {
+            auto statement = dynamic_cast<NSwitchStatement *>(node);
+            const Type *value = statement->getExpression() != nullptr ?
+                                this->check(statement->getExpression()) : this->types.unknown();
+            for ( auto switchCase: statement->getCases())
+            {
+                for ( auto caseValue: switchCase->values )
+                {
+                    this->expect(caseValue, value, this->check(caseValue));
+                }
+                if ( switchCase->body != nullptr )
+                {
+                    this->check(switchCase->body);
+                }
+            }
+            if ( statement->getDefaultCase() != nullptr )
+            {
+                this->check(statement->getDefaultCase());
+            }
+        }
+            break;
+
+        default:
+            ast::forEachSubnode(node, [ this ](ast::Node *subnode) { this->check(subnode); });
+            break;
+    }
+
+    this->genericOwners.resize(genericDepth);
+    this->scope = previousScope;
+    this->located = previousLocated;
+    if ( type != nullptr )
+    {
+        this->nodeTypes[ node ] = type;
+    }
+    return type;
+}
+
+void TypeChecker::finish()
+{
+    for ( auto &check: this->operandChecks )
+    {
+        const Type *type = this->unifier.finalize(check.type);
+        if ( type->kind == TYPE_UNKNOWN || type->kind == TYPE_EXTERNAL || type->kind == TYPE_PARAMETER ||
+             type->isNumeric() || ( check.allowsString && type->kind == TYPE_STRING ))
+        {
+            continue;
+        }
+        this->report(check.node, "Operator can't be applied to a value of type '" + type->toString() + "'.");
+    }
+
+    for ( auto declaration: this->declarationOrder )
+    {
+        const Type *&type = this->declarationTypes[ declaration ];
+        bool complete = true;
+        type = this->unifier.finalize(type, &complete);
+        if ( !complete && declaration->getType() == ast::VARIABLE_DECLARATION )
+        {
+            auto variable = dynamic_cast<NVariableDeclaration *>(declaration);
+            this->report(declaration, "Unable to infer the type of '" +
+                                      ( variable->getVariableName() ? *variable->getVariableName() : "" ) + "'.");
+        }
+    }
+    for ( auto &[ node, type ]: this->nodeTypes )
+    {
+        type = this->unifier.finalize(type);
+    }
+    for ( auto &[ node, bases ]: this->baseTypes )
+    {
+        for ( auto &base: bases )
+        {
+            base = this->unifier.finalize(base);
+        }
+    }
+}
+
+/**
+ * Whether a node contains a return statement with a value.
+ */
+static bool returnsValue(ast::Node *node)
+{
+    if ( node->getType() == ast::RETURN_STATEMENT )
+    {
+        return dynamic_cast<NReturnStatement *>(node)->getExpression() != nullptr;
+    }
+    bool returns = false;
+    ast::forEachSubnode(node, [ &returns ](ast::Node *subnode)
+    {
+        returns = returns || returnsValue(subnode);
+    });
+    return returns;
+}
+
+void TypeChecker::declareImport(ast::Node *container)
+{
+    for ( size_t i = 0; i < container->getChildCount(); i++ )
+    {
+        ast::Node *node = container->getChild(i);
+        if ( node->getType() == ast::MODULE_DECLARATION )
+        {
+            auto module = dynamic_cast<NModuleDeclaration *>(node);
+            if ( module->getBody() != nullptr )
+            {
+                this->declareImport(module->getBody());
+            }
+        }
+        else if ( node->getType() == ast::FUNCTION_DECLARATION )
+        {
+            // Like in the file that declares it, a function without a return type that doesn't return a value, returns void.
+            auto function = dynamic_cast<NFunctionDeclaration *>(node);
+            bool returns = function->body != nullptr && returnsValue(function->body);
+            this->declarationTypes[ function ] = this->functionType(function, returns ? this->unifier.fresh() :
+                                                                              this->types.voidType());
+            this->declarationOrder.push_back(function);
+        }
+    }
+}
+
+void TypeChecker::run(ast::Node &root)
+{
+    // Types that imported signatures refer to, but that aren't visible in this file, are unknown.
+    this->importing = true;
+    this->scope = this->symbols.imports();
+    for ( auto import: this->file.getImports())
+    {
+        if ( import->parse() != nullptr )
+        {
+            this->declareImport(import->parse());
+        }
+    }
+    this->scope = this->symbols.global();
+    this->importing = false;
+
+    this->declare(&root);
+    this->check(&root);
+    this->finish();
+}
+
+const Type *TypeChecker::typeOf(ast::Node *node) const
+{
+    auto entry = this->nodeTypes.find(node);
+    return entry == this->nodeTypes.end() ? nullptr : entry->second;
+}
+
+const Type *TypeChecker::typeOfDeclaration(ast::Node *declaration) const
+{
+    auto entry = this->declarationTypes.find(declaration);
+    return entry == this->declarationTypes.end() ? nullptr : entry->second;
+}
+
+const std::vector<const Type *> &TypeChecker::basesOf(ast::Node *declaration) const
+{
+    static const std::vector<const Type *> none;
+    auto entry = this->baseTypes.find(declaration);
+    return entry == this->baseTypes.end() ? none : entry->second;
+}
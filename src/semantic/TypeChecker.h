@@ -0,0 +1,117 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_TYPECHECKER_H
+#define STRIDE_LANGUAGE_TYPECHECKER_H
+
+#include <unordered_map>
+#include "SymbolTable.h"
+#include "Types.h"
+#include "Unifier.h"
+#include "../StrideFile.h"
+
+class NFunctionDeclaration;
+class NVariableDeclaration;
+
+namespace stride::semantic
+{
+
+    /**
+     * Infers and checks the types of all expressions and declarations.
+     *
+     * Names must be resolved before. The declared types of all variables and
+     * functions are collected first, so they can be used before their declaration.
+     * Then, every expression is given a type, which may be a type variable, and the
+     * constraints between them are unified as they are encountered. Variables declared
+     * as 'auto' and functions without a return type are inferred this way.
+     *
+     * Once all constraints are unified, the types of all nodes are resolved. Integer
+     * literals that aren't constrained default to i64, and float literals to f64,
+     * so every value has an exact width afterwards.
+     */
+    class TypeChecker
+    {
+    private:
+        struct OperandCheck
+        {
+            ast::Node *node;
+            const Type *type;
+            bool allowsString;
+        };
+
+        StrideFile &file;
+        SymbolTable &symbols;
+        TypeTable &types;
+        Unifier unifier;
+
+        Scope *scope;
+        ast::Node *located;
+        /**
+         * Whether the signatures of imported functions are being declared.
+         * Their types are checked by the file that declares them, so errors aren't reported again.
+         */
+        bool importing;
+        std::vector<ast::Node *> genericOwners;
+        std::vector<NFunctionDeclaration *> functions;
+        std::vector<OperandCheck> operandChecks;
+
+        std::unordered_map<ast::Node *, const Type *> nodeTypes;
+        std::unordered_map<ast::Node *, const Type *> declarationTypes;
+        std::vector<ast::Node *> declarationOrder;
+        std::unordered_map<ast::Node *, std::vector<const Type *>> baseTypes;
+
+        const Type *resolveTypeName(const std::string &name);
+
+        const Type *instantiate(ast::Node *declaration, std::vector<const Type *> arguments, const std::string &written);
+
+        const Type *variableType(NVariableDeclaration *variable);
+
+        const Type *functionType(NFunctionDeclaration *function, const Type *result);
+
+        void declare(ast::Node *node);
+
+        void declareImport(ast::Node *container);
+
+        const Type *check(ast::Node *node);
+
+        const Type *checkBinary(ast::Node *node);
+
+        const Type *checkUnary(ast::Node *node);
+
+        const Type *checkCall(ast::Node *node);
+
+        void expect(ast::Node *node, const Type *expected, const Type *actual);
+
+        void report(ast::Node *node, const std::string &message);
+
+        void finish();
+
+    public:
+
+        TypeChecker(StrideFile &file, SymbolTable &symbols, TypeTable &types);
+
+        /**
+         * Checks all types in the provided tree.
+         */
+        void run(ast::Node &root);
+
+        /**
+         * Returns the type of an expression, after checking.
+         * @return The type, or nullptr if the node isn't an expression.
+         */
+        [[nodiscard]] const Type *typeOf(ast::Node *node) const;
+
+        /**
+         * Returns the type of a variable, or the function type of a function, after checking.
+         */
+        [[nodiscard]] const Type *typeOfDeclaration(ast::Node *declaration) const;
+
+        /**
+         * Returns the types of the classes a class inherits from, including their type arguments.
+         */
+        [[nodiscard]] const std::vector<const Type *> &basesOf(ast::Node *declaration) const;
+    };
+}
+
+#endif //STRIDE_LANGUAGE_TYPECHECKER_H
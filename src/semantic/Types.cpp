@@ -0,0 +1,256 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include "Types.h"
+#include "../cache/Hash.h"
+#include "../syntax_tree/node_types/definitions/NClassDeclaration.h"
+#include "../syntax_tree/node_types/definitions/NEnumerableDeclaration.h"
+#include "../syntax_tree/node_types/definitions/NStructureDeclaration.h"
+
+using namespace stride;
+using namespace stride::semantic;
+
+/**
+ * Returns the name of a class, structure or enumerable.
+ */
+static std::string declarationName(ast::Node *declaration)
+{
+    switch ( declaration->getType())
+    {
+        case ast::CLASS_DECLARATION:
+            return dynamic_cast<NClassDeclaration *>(declaration)->getClassName();
+        case ast::STRUCTURE_DECLARATION:
+            return dynamic_cast<NStructureDeclaration *>(declaration)->getName();
+        case ast::ENUMERABLE_DECLARATION:
+            return dynamic_cast<NEnumerableDeclaration *>(declaration)->getName();
+        default:
+            return "?";
+    }
+}
+
+std::string Type::toString() const
+{
+    std::string result;
+    switch ( this->kind )
+    {
+        case TYPE_UNKNOWN:
+            return "unknown";
+        case TYPE_VOID:
+            return "void";
+        case TYPE_BOOL:
+            return "bool";
+        case TYPE_CHAR:
+            return "char";
+        case TYPE_INTEGER:
+            return ( this->isSigned ? "i" : "u" ) + std::to_string(this->bits);
+        case TYPE_FLOAT:
+            return "f" + std::to_string(this->bits);
+        case TYPE_STRING:
+            return "string";
+        case TYPE_ARRAY:
+            return this->element->toString() + "[]";
+        case TYPE_VARIADIC:
+            return this->element->toString() + "...";
+        case TYPE_SOA_ARRAY:
+            return "soa " + this->element->toString() + "[]";
+        case TYPE_NAMED:
+            return declarationName(this->declaration);
+        case TYPE_INSTANCE:
+            result = declarationName(this->declaration) + "<";
+            for ( size_t i = 0; i < this->arguments.size(); i++ )
+            {
+                result.append(i > 0 ? ", " : "").append(this->arguments[ i ]->toString());
+            }
+            return result + ">";
+        case TYPE_PARAMETER:
+        {
+            auto &generics = this->declaration->getType() == ast::CLASS_DECLARATION ?
+                             dynamic_cast<NClassDeclaration *>(this->declaration)->getGenerics() :
+                             dynamic_cast<NStructureDeclaration *>(this->declaration)->getGenerics();
+            return *generics[ this->index ];
+        }
+        case TYPE_FUNCTION:
+            result = "(";
+            for ( size_t i = 0; i < this->arguments.size(); i++ )
+            {
+                result.append(i > 0 ? ", " : "").append(this->arguments[ i ]->toString());
+            }
+            return result + ") -> " + this->element->toString();
+        case TYPE_EXTERNAL:
+            return this->name;
+        case TYPE_VARIABLE:
+            return "?" + std::to_string(this->index);
+    }
+    return "?";
+}
+
+size_t TypeTable::TypeHash::operator()(const Type *type) const
+{
+    cache::Hasher hasher;
+    hasher.update((uint64_t) type->kind | ((uint64_t) type->bits << 8) | ((uint64_t) type->isSigned << 16))
+            .update((uint64_t) (uintptr_t) type->element)
+            .update((uint64_t) (uintptr_t) type->declaration)
+            .update((uint64_t) type->index)
+            .update(type->name);
+    for ( auto argument: type->arguments )
+    {
+        hasher.update((uint64_t) (uintptr_t) argument);
+    }
+    return (size_t) hasher.digest();
+}
+
+bool TypeTable::TypeEquals::operator()(const Type *a, const Type *b) const
+{
+    return a->kind == b->kind && a->bits == b->bits && a->isSigned == b->isSigned &&
+           a->element == b->element && a->declaration == b->declaration && a->index == b->index &&
+           a->name == b->name && a->arguments == b->arguments;
+}
+
+const Type *TypeTable::intern(Type type)
+{
+    auto existing = this->canonical.find(&type);
+    if ( existing != this->canonical.end())
+    {
+        return *existing;
+    }
+
+    type.hasVariables = type.kind == TYPE_VARIABLE || ( type.element != nullptr && type.element->hasVariables );
+    for ( auto argument: type.arguments )
+    {
+        type.hasVariables |= argument->hasVariables;
+    }
+    this->types.push_back(std::make_unique<Type>(std::move(type)));
+    this->canonical.insert(this->types.back().get());
+    return this->types.back().get();
+}
+
+const Type *TypeTable::unknown()
+{
+    return this->intern({ .kind = TYPE_UNKNOWN });
+}
+
+const Type *TypeTable::voidType()
+{
+    return this->intern({ .kind = TYPE_VOID });
+}
+
+const Type *TypeTable::boolean()
+{
+    return this->intern({ .kind = TYPE_BOOL, .bits = 8 });
+}
+
+const Type *TypeTable::character()
+{
+    return this->intern({ .kind = TYPE_CHAR, .bits = 8 });
+}
+
+const Type *TypeTable::string()
+{
+    return this->intern({ .kind = TYPE_STRING });
+}
+
+const Type *TypeTable::integer(uint8_t bits, bool isSigned)
+{
+    return this->intern({ .kind = TYPE_INTEGER, .bits = bits, .isSigned = isSigned });
+}
+
+const Type *TypeTable::floating(uint8_t bits)
+{
+    return this->intern({ .kind = TYPE_FLOAT, .bits = bits, .isSigned = true });
+}
+
+const Type *TypeTable::array(const Type *element)
+{
+    return this->intern({ .kind = TYPE_ARRAY, .element = element });
+}
+
+const Type *TypeTable::variadic(const Type *element)
+{
+    return this->intern({ .kind = TYPE_VARIADIC, .element = element });
+}
+
+const Type *TypeTable::soaArray(const Type *element)
+{
+    return this->intern({ .kind = TYPE_SOA_ARRAY, .element = element });
+}
+
+const Type *TypeTable::named(ast::Node *declaration)
+{
+    return this->intern({ .kind = TYPE_NAMED, .declaration = declaration });
+}
+
+const Type *TypeTable::instance(ast::Node *declaration, const std::vector<const Type *> &arguments)
+{
+    return this->intern({ .kind = TYPE_INSTANCE, .declaration = declaration, .arguments = arguments });
+}
+
+const Type *TypeTable::parameter(ast::Node *declaration, uint32_t index)
+{
+    return this->intern({ .kind = TYPE_PARAMETER, .declaration = declaration, .index = index });
+}
+
+const Type *TypeTable::function(const std::vector<const Type *> &parameters, const Type *result)
+{
+    return this->intern({ .kind = TYPE_FUNCTION, .element = result, .arguments = parameters });
+}
+
+const Type *TypeTable::external(const std::string &name)
+{
+    return this->intern({ .kind = TYPE_EXTERNAL, .name = name });
+}
+
+const Type *TypeTable::variable(uint32_t id)
+{
+    return this->intern({ .kind = TYPE_VARIABLE, .index = id });
+}
+
+const Type *TypeTable::primitive(token_type_t token)
+{
+    switch ( token )
+    {
+        case TOKEN_PRIMITIVE_INT8: return this->integer(8, true);
+        case TOKEN_PRIMITIVE_INT16: return this->integer(16, true);
+        case TOKEN_PRIMITIVE_INT32: return this->integer(32, true);
+        case TOKEN_PRIMITIVE_INT64: return this->integer(64, true);
+        case TOKEN_PRIMITIVE_UINT8: return this->integer(8, false);
+        case TOKEN_PRIMITIVE_UINT16: return this->integer(16, false);
+        case TOKEN_PRIMITIVE_UINT32: return this->integer(32, false);
+        case TOKEN_PRIMITIVE_UINT64: return this->integer(64, false);
+        case TOKEN_PRIMITIVE_FLOAT32: return this->floating(32);
+        case TOKEN_PRIMITIVE_FLOAT64: return this->floating(64);
+        case TOKEN_PRIMITIVE_BOOL: return this->boolean();
+        case TOKEN_PRIMITIVE_CHAR: return this->character();
+        case TOKEN_PRIMITIVE_STRING: return this->string();
+        case TOKEN_PRIMITIVE_VOID: return this->voidType();
+        default: return nullptr;
+    }
+}
+
+const Type *TypeTable::primitive(const std::string &name)
+{
+    static const std::pair<const char *, token_type_t> keywords[] = {
+            { "i8",  TOKEN_PRIMITIVE_INT8 },
+            { "i16", TOKEN_PRIMITIVE_INT16 },
+            { "i32", TOKEN_PRIMITIVE_INT32 },
+            { "i64", TOKEN_PRIMITIVE_INT64 },
+            { "u8",  TOKEN_PRIMITIVE_UINT8 },
+            { "u16", TOKEN_PRIMITIVE_UINT16 },
+            { "u32", TOKEN_PRIMITIVE_UINT32 },
+            { "u64", TOKEN_PRIMITIVE_UINT64 },
+            { "f32", TOKEN_PRIMITIVE_FLOAT32 },
+            { "f64", TOKEN_PRIMITIVE_FLOAT64 },
+            { "bool", TOKEN_PRIMITIVE_BOOL },
+            { "char", TOKEN_PRIMITIVE_CHAR },
+            { "string", TOKEN_PRIMITIVE_STRING },
+            { "void", TOKEN_PRIMITIVE_VOID }
+    };
+    for ( auto &[ keyword, token ]: keywords )
+    {
+        if ( name == keyword )
+        {
+            return this->primitive(token);
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,170 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_TYPES_H
+#define STRIDE_LANGUAGE_TYPES_H
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "../syntax_tree/ASTNodes.h"
+#include "../tokens/token.h"
+
+namespace stride::semantic
+{
+
+    enum ETypeKind
+    {
+        TYPE_UNKNOWN,   // The type of a value of another compilation unit
+        TYPE_VOID,
+        TYPE_BOOL,
+        TYPE_CHAR,
+        TYPE_INTEGER,
+        TYPE_FLOAT,
+        TYPE_STRING,
+        TYPE_ARRAY,
+        TYPE_VARIADIC,
+        TYPE_SOA_ARRAY, // An array of structures that stores each field in an array of its own
+        TYPE_NAMED,     // A class, structure or enumerable
+        TYPE_INSTANCE,  // A generic class or structure with type arguments
+        TYPE_PARAMETER, // A generic parameter of a class or structure
+        TYPE_FUNCTION,
+        TYPE_EXTERNAL,  // A named type of another compilation unit
+        TYPE_VARIABLE   // A type that is yet to be inferred
+    };
+
+    /**
+     * A type.
+     * Types are canonical: every distinct type exists once in its type table,
+     * so two types are equal if and only if their pointers are.
+     */
+    struct Type
+    {
+        ETypeKind kind;
+
+        /**
+         * The width of integers and floats, in bits.
+         */
+        uint8_t bits = 0;
+        bool isSigned = false;
+
+        /**
+         * The element type of arrays and variadics, or the result type of functions.
+         */
+        const Type *element = nullptr;
+
+        /**
+         * The declaration of named types, instances and generic parameters.
+         */
+        ast::Node *declaration = nullptr;
+
+        /**
+         * The index of generic parameters, or the id of type variables.
+         */
+        uint32_t index = 0;
+
+        /**
+         * The name of external types.
+         */
+        std::string name {};
+
+        /**
+         * The type arguments of instances, or the parameter types of functions.
+         */
+        std::vector<const Type *> arguments {};
+
+        /**
+         * Whether the type contains a type variable.
+         */
+        bool hasVariables = false;
+
+        /**
+         * Returns the name of the type as it's written in source, e.g. 'i32[]'.
+         */
+        [[nodiscard]] std::string toString() const;
+
+        [[nodiscard]] bool isNumeric() const
+        { return kind == TYPE_INTEGER || kind == TYPE_FLOAT || kind == TYPE_CHAR; }
+    };
+
+    /**
+     * Creates canonical types.
+     * Types are hash-consed: a type is looked up by its kind, width, element,
+     * declaration and arguments before it's created. As the components of a type are
+     * canonical themselves, hashing and comparing them is shallow.
+     */
+    class TypeTable
+    {
+    private:
+        struct TypeHash
+        {
+            size_t operator()(const Type *type) const;
+        };
+
+        struct TypeEquals
+        {
+            bool operator()(const Type *a, const Type *b) const;
+        };
+
+        std::vector<std::unique_ptr<Type>> types;
+        std::unordered_set<const Type *, TypeHash, TypeEquals> canonical;
+
+        const Type *intern(Type type);
+
+    public:
+
+        const Type *unknown();
+
+        const Type *voidType();
+
+        const Type *boolean();
+
+        const Type *character();
+
+        const Type *string();
+
+        const Type *integer(uint8_t bits, bool isSigned);
+
+        const Type *floating(uint8_t bits);
+
+        const Type *array(const Type *element);
+
+        const Type *variadic(const Type *element);
+
+        const Type *soaArray(const Type *element);
+
+        const Type *named(ast::Node *declaration);
+
+        const Type *instance(ast::Node *declaration, const std::vector<const Type *> &arguments);
+
+        const Type *parameter(ast::Node *declaration, uint32_t index);
+
+        const Type *function(const std::vector<const Type *> &parameters, const Type *result);
+
+        const Type *external(const std::string &name);
+
+        const Type *variable(uint32_t id);
+
+        /**
+         * Returns the type of a primitive type token, e.g. TOKEN_PRIMITIVE_INT32.
+         * @return The type, or nullptr for 'auto' and tokens that aren't types.
+         */
+        const Type *primitive(token_type_t token);
+
+        /**
+         * Returns the type of a primitive type keyword, e.g. 'i32'.
+         * @return The type, or nullptr if the name isn't a primitive type.
+         */
+        const Type *primitive(const std::string &name);
+
+        /**
+         * Returns the amount of distinct types.
+         */
+        [[nodiscard]] size_t size() const
+        { return types.size(); }
+    };
+}
+
+#endif //STRIDE_LANGUAGE_TYPES_H
@@ -0,0 +1,230 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include "Unifier.h"
+
+using namespace stride::semantic;
+
+/**
+ * Whether a type is in a literal class.
+ */
+static bool fits(ELiteralClass literal, const Type *type)
+{
+    switch ( literal )
+    {
+        case LITERAL_INTEGER:
+            return type->kind == TYPE_INTEGER || type->kind == TYPE_FLOAT || type->kind == TYPE_CHAR;
+        case LITERAL_FLOAT:
+            return type->kind == TYPE_FLOAT;
+        default:
+            return true;
+    }
+}
+
+const Type *Unifier::fresh(ELiteralClass literal)
+{
+    auto id = (uint32_t) this->variables.size();
+    this->variables.push_back({ id, 0, literal, nullptr });
+    return this->types.variable(id);
+}
+
+uint32_t Unifier::find(uint32_t id)
+{
+    // Path halving: every visited variable is pointed at its grandparent.
+    while ( this->variables[ id ].parent != id )
+    {
+        uint32_t parent = this->variables[ id ].parent;
+        this->variables[ id ].parent = this->variables[ parent ].parent;
+        id = parent;
+    }
+    return id;
+}
+
+const Type *Unifier::prune(const Type *type)
+{
+    while ( type->kind == TYPE_VARIABLE )
+    {
+        uint32_t root = this->find(type->index);
+        if ( this->variables[ root ].bound == nullptr )
+        {
+            return this->types.variable(root);
+        }
+        type = this->variables[ root ].bound;
+    }
+    return type;
+}
+
+bool Unifier::occurs(uint32_t id, const Type *type)
+{
+    type = this->prune(type);
+    if ( !type->hasVariables )
+    {
+        return false;
+    }
+    if ( type->kind == TYPE_VARIABLE )
+    {
+        return type->index == id;
+    }
+    if ( type->element != nullptr && this->occurs(id, type->element))
+    {
+        return true;
+    }
+    for ( auto argument: type->arguments )
+    {
+        if ( this->occurs(id, argument))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Unifier::bind(uint32_t id, const Type *type)
+{
+    Variable &variable = this->variables[ id ];
+    if ( type->kind != TYPE_UNKNOWN && ( !fits(variable.literal, type) || this->occurs(id, type)))
+    {
+        return false;
+    }
+    variable.bound = type;
+    return true;
+}
+
+bool Unifier::merge(uint32_t a, uint32_t b)
+{
+    // The literal class of the merged set is the narrowest of both.
+    auto literal = (ELiteralClass) std::max(this->variables[ a ].literal, this->variables[ b ].literal);
+    if ( this->variables[ a ].rank < this->variables[ b ].rank )
+    {
+        std::swap(a, b);
+    }
+    this->variables[ b ].parent = a;
+    this->variables[ a ].literal = literal;
+    if ( this->variables[ a ].rank == this->variables[ b ].rank )
+    {
+        this->variables[ a ].rank++;
+    }
+    return true;
+}
+
+bool Unifier::unify(const Type *a, const Type *b)
+{
+    a = this->prune(a);
+    b = this->prune(b);
+    if ( a == b )
+    {
+        return true;
+    }
+    if ( a->kind == TYPE_VARIABLE && b->kind == TYPE_VARIABLE )
+    {
+        return this->merge(a->index, b->index);
+    }
+    if ( a->kind == TYPE_VARIABLE )
+    {
+        return this->bind(a->index, b);
+    }
+    if ( b->kind == TYPE_VARIABLE )
+    {
+        return this->bind(b->index, a);
+    }
+    if ( a->kind == TYPE_UNKNOWN || b->kind == TYPE_UNKNOWN )
+    {
+        return true;
+    }
+    if ( a->kind != b->kind || a->declaration != b->declaration || a->arguments.size() != b->arguments.size() ||
+         ( !a->hasVariables && !b->hasVariables ))
+    {
+        return false;
+    }
+
+    // Both types have the same shape, and contain variables; unify their components.
+    if (( a->element != nullptr ) != ( b->element != nullptr ) ||
+        ( a->element != nullptr && !this->unify(a->element, b->element)))
+    {
+        return false;
+    }
+    for ( size_t i = 0; i < a->arguments.size(); i++ )
+    {
+        if ( !this->unify(a->arguments[ i ], b->arguments[ i ]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+const Type *Unifier::substitute(const Type *type, bool finalize, bool *complete)
+{
+    type = this->prune(type);
+    if ( !type->hasVariables )
+    {
+        return type;
+    }
+    if ( type->kind == TYPE_VARIABLE )
+    {
+        if ( !finalize )
+        {
+            return type;
+        }
+        switch ( this->variables[ type->index ].literal )
+        {
+            case LITERAL_INTEGER:
+                return this->types.integer(64, true);
+            case LITERAL_FLOAT:
+                return this->types.floating(64);
+            default:
+                if ( complete != nullptr )
+                {
+                    *complete = false;
+                }
+                return this->types.unknown();
+        }
+    }
+
+    const Type *element = type->element != nullptr ? this->substitute(type->element, finalize, complete) : nullptr;
+    std::vector<const Type *> arguments;
+    for ( auto argument: type->arguments )
+    {
+        arguments.push_back(this->substitute(argument, finalize, complete));
+    }
+    switch ( type->kind )
+    {
+        case TYPE_ARRAY:
+            return this->types.array(element);
+        case TYPE_VARIADIC:
+            return this->types.variadic(element);
+        case TYPE_SOA_ARRAY:
+            return this->types.soaArray(element);
+        case TYPE_INSTANCE:
+            return this->types.instance(type->declaration, arguments);
+        case TYPE_FUNCTION:
+            return this->types.function(arguments, element);
+        default:
+            return type;
+    }
+}
+
+const Type *Unifier::finalize(const Type *type, bool *complete)
+{
+    return this->substitute(type, true, complete);
+}
+
+std::string Unifier::describe(const Type *type)
+{
+    type = this->substitute(type, false, nullptr);
+    if ( type->kind != TYPE_VARIABLE )
+    {
+        return type->toString();
+    }
+    switch ( this->variables[ type->index ].literal )
+    {
+        case LITERAL_INTEGER:
+            return "integer literal";
+        case LITERAL_FLOAT:
+            return "float literal";
+        default:
+            return "auto";
+    }
+}
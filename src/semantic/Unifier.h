@@ -0,0 +1,94 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_UNIFIER_H
+#define STRIDE_LANGUAGE_UNIFIER_H
+
+#include "Types.h"
+
+namespace stride::semantic
+{
+
+    /**
+     * Constrains which types a type variable can be bound to.
+     * The variables of literals can be bound to any type of their class,
+     * and default to i64 and f64 respectively if they remain unbound.
+     */
+    enum ELiteralClass : uint8_t
+    {
+        LITERAL_NONE,
+        LITERAL_INTEGER, // Any integer, float or character type
+        LITERAL_FLOAT    // Any float type
+    };
+
+    /**
+     * Infers types by unification.
+     *
+     * Type variables are kept in a union-find forest, with union by rank and
+     * path halving, so a sequence of unifications runs in near-linear time.
+     * The root of each set holds the type the set is bound to, if any.
+     * Composite types, e.g. arrays of a variable, are unified structurally.
+     */
+    class Unifier
+    {
+    private:
+        struct Variable
+        {
+            uint32_t parent;
+            uint8_t rank;
+            ELiteralClass literal;
+            const Type *bound;
+        };
+
+        TypeTable &types;
+        std::vector<Variable> variables;
+
+        uint32_t find(uint32_t id);
+
+        bool occurs(uint32_t id, const Type *type);
+
+        bool bind(uint32_t id, const Type *type);
+
+        bool merge(uint32_t a, uint32_t b);
+
+        const Type *substitute(const Type *type, bool finalize, bool *complete);
+
+    public:
+
+        explicit Unifier(TypeTable &types) : types(types)
+        {}
+
+        /**
+         * Creates a new type variable.
+         */
+        const Type *fresh(ELiteralClass literal = LITERAL_NONE);
+
+        /**
+         * Follows the bindings of a type variable, until an unbound variable or another type is found.
+         */
+        const Type *prune(const Type *type);
+
+        /**
+         * Unifies two types. The unknown type unifies with every type.
+         * If composite types can't be unified, the components that were unified before stay bound.
+         * @return Whether the types could be unified.
+         */
+        bool unify(const Type *a, const Type *b);
+
+        /**
+         * Substitutes all type variables in a type by the type they're bound to.
+         * Unbound literal variables are replaced by their default type, and other
+         * unbound variables by the unknown type.
+         * @param complete Set to false if an unbound variable was replaced by the unknown type.
+         */
+        const Type *finalize(const Type *type, bool *complete = nullptr);
+
+        /**
+         * Returns a description of a type for diagnostics, e.g. 'i32', or 'integer literal'.
+         */
+        std::string describe(const Type *type);
+    };
+}
+
+#endif //STRIDE_LANGUAGE_UNIFIER_H
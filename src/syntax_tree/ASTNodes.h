@@ -5,10 +5,23 @@
 #ifndef STRIDE_LANGUAGE_ASTNODES_H
 #define STRIDE_LANGUAGE_ASTNODES_H
 
+#include <cstdint>
 #include <vector>
 #include "../tokens/TokenSet.h"
 #include "../tokens/token.h"
 
+/* Node attributes, see NodeAttributes */
+#define NODE_ATTRIBUTE_VALID     (1 << 0) // The attributes are up to date
+#define NODE_ATTRIBUTE_CONSTANT  (1 << 1) // The value is known at compile time
+#define NODE_ATTRIBUTE_HAS_CONSTANT (1 << 2) // The node, or one of its descendants, is constant
+
+namespace stride::ir
+{
+    class Value;
+
+    class IRGenerator;
+}
+
 namespace stride::ast
 {
 
@@ -42,14 +55,14 @@ namespace stride::ast
         FOR_LOOP, WHILE_LOOP, DO_WHILE_LOOP
     };
 
-    class IRValue
+    /**
+     * Attributes of a node that are derived from its subtree.
+     * These are computed once by <code>passes::computeAttributes</code>
+     * and stored on the node, and are invalidated when the node is mutated.
+     */
+    struct NodeAttributes
     {
-    public:
-        void *value;
-
-        explicit IRValue(void *value) : value(value)
-        {}
-
+        uint16_t flags;     // NODE_ATTRIBUTE_*
     };
 
     /**
@@ -61,6 +74,15 @@ namespace stride::ast
     private:
         std::vector<Node *> children;
 
+        /**
+         * Source range of the node, as character indices in the source file.
+         * The end index is exclusive. Both are -1 if the range is unknown.
+         */
+        int sourceStart = -1;
+        int sourceEnd = -1;
+
+        NodeAttributes attributes {};
+
     public:
 
         /**
@@ -73,10 +95,9 @@ namespace stride::ast
 
         /**
          * Generates the IR code for this node.
-         * @return The IR code for this node.
+         * @return The value of an expression, or nullptr for other nodes.
          */
-        virtual IRValue *codegen()
-        { return nullptr; }
+        virtual ir::Value *codegen(ir::IRGenerator &generator);
 
         /**
          * Converts the node to a string.
@@ -93,6 +114,7 @@ namespace stride::ast
         {
             if ( child != nullptr )
                 children.push_back(child);
+            invalidateAttributes();
         }
 
         /**
@@ -104,10 +126,83 @@ namespace stride::ast
             return children;
         }
 
+        /**
+         * Returns the amount of children of this node.
+         */
+        [[nodiscard]] size_t getChildCount() const
+        {
+            return children.size();
+        }
+
+        /**
+         * Returns the child at the provided index.
+         */
+        [[nodiscard]] Node *getChild(size_t index) const
+        {
+            return children[ index ];
+        }
+
+        /**
+         * Replaces a range of children.
+         * The replaced children are detached, not deleted.
+         * @param first The index of the first child to replace.
+         * @param count The amount of children to replace.
+         * @param replacement The children to insert at the index of the first replaced child.
+         */
+        void replaceChildren(size_t first, size_t count, const std::vector<Node *> &replacement)
+        {
+            children.erase(children.begin() + (long) first, children.begin() + (long) ( first + count ));
+            children.insert(children.begin() + (long) first, replacement.begin(), replacement.end());
+            invalidateAttributes();
+        }
+
+        /**
+         * Updates the source range of this node.
+         * @param start The character index of the first character of the node.
+         * @param end The character index after the last character of the node.
+         */
+        void setSourceRange(int start, int end)
+        {
+            this->sourceStart = start;
+            this->sourceEnd = end;
+        }
+
+        [[nodiscard]] int getSourceStart() const
+        { return sourceStart; }
+
+        [[nodiscard]] int getSourceEnd() const
+        { return sourceEnd; }
+
+        /**
+         * Whether the source range of this node is known.
+         */
+        [[nodiscard]] bool hasSourceRange() const
+        { return sourceStart >= 0; }
+
+        /**
+         * Returns the attributes of this node, as last computed.
+         * Check NODE_ATTRIBUTE_VALID before relying on them.
+         */
+        [[nodiscard]] const NodeAttributes &getAttributes() const
+        { return attributes; }
+
+        void setAttributes(const NodeAttributes &nodeAttributes)
+        { this->attributes = nodeAttributes; }
+
+        /**
+         * Marks the attributes of this node as outdated.
+         * This has to be called whenever a node is mutated; the attributes of
+         * its ancestors are refreshed when they're computed again. Subnodes that
+         * are stored in fields are replaced with <code>ast::replaceSubnode</code>,
+         * which does so for the parent.
+         */
+        void invalidateAttributes()
+        { this->attributes.flags &= ~NODE_ATTRIBUTE_VALID; }
+
         /**
          * Destructor for the node.s
          */
-        ~Node()
+        virtual ~Node()
         {
             for ( auto &child: children )
             {
@@ -133,6 +228,15 @@ namespace stride::ast
          * @param root The root node to append the generated node_types to.
          */
         void parse(TokenSet &tokenSet, Node &root);
+
+        /**
+         * Parses a single statement from the token set, and appends the
+         * generated node to the provided root node.
+         * Errors are not recovered from here; this is done by the caller.
+         * @param tokenSet The token set to parse
+         * @param root The root node to append the generated node to.
+         */
+        void parseStatement(TokenSet &tokenSet, Node &root);
     }
 }
 
@@ -3,6 +3,7 @@
 //
 
 #include "ASTNodes.h"
+#include "../error/Diagnostics.h"
 #include "node_types/definitions/NFunctionDeclaration.h"
 #include "node_types/definitions/NConditionalStatement.h"
 #include "node_types/definitions/NImportStatement.h"
@@ -27,69 +28,105 @@ stride::ast::Node *stride::ast::parser::parse(TokenSet &tokenSet)
 
 void stride::ast::parser::parse(TokenSet &tokenSet, stride::ast::Node &root)
 {
-    for ( ; tokenSet.hasNext(); )
+    for ( ; !tokenSet.end(); )
     {
-        tokenSet.consume(static_cast<token_type_t>(0)); // skip whitespace and comments
+        // Skip comments, of which there may be several in a row.
+        while ( tokenSet.consume(TOKEN_COMMENT))
+        {}
+        if ( tokenSet.end())
+        {
+            break;
+        }
+
+        int statementStart = tokenSet.getIndex();
+        size_t childCount = root.getChildCount();
+        int sourceStart = tokenSet.current().index;
 
-        switch ( tokenSet.current().type )
+        try
+        {
+            parseStatement(tokenSet, root);
+
+            // Assign the source range of the statement to the node_types it produced.
+            token_t last = tokenSet.peek(-1);
+            int sourceEnd = last.index + (int) strlen(last.value);
+            for ( size_t i = childCount; i < root.getChildCount(); i++ )
+            {
+                if ( !root.getChild(i)->hasSourceRange())
+                {
+                    root.getChild(i)->setSourceRange(sourceStart, sourceEnd);
+                }
+            }
+        }
+        catch ( const stride::error::ParseError & )
         {
-            case TOKEN_KEYWORD_DEFINE:
-                NFunctionDeclaration::parse(tokenSet, root);
-                break;
-            case TOKEN_KEYWORD_IF:
-                NConditionalStatement::parse(tokenSet, root);
-                break;
-            case TOKEN_KEYWORD_LET:
-            case TOKEN_KEYWORD_CONST:
-                NVariableDeclaration::parse(tokenSet, root);
-                break;
-            case TOKEN_KEYWORD_IMPORT:
-                NImportStatement::parse(tokenSet, root);
-                break;
-            case TOKEN_KEYWORD_PUBLIC:
-            case TOKEN_KEYWORD_CLASS:
-                NClassDeclaration::parse(tokenSet, root);
-                break;
-            case TOKEN_KEYWORD_STRUCT:
-                NStructureDeclaration::parse(tokenSet, root);
-                break;
-            case TOKEN_KEYWORD_SWITCH:
-                NSwitchStatement::parse(tokenSet, root);
-                break;
-            case TOKEN_KEYWORD_TRY:
-                NTryCatchStatement::parse(tokenSet, root);
-                break;
-            case TOKEN_KEYWORD_ENUM:
-                NEnumerableDeclaration::parse(tokenSet, root);
-                break;
-            case TOKEN_KEYWORD_DO:
-                NDoWhileLoop::parse(tokenSet, root);
-                break;
-            case TOKEN_KEYWORD_WHILE:
-                NWhileLoop::parse(tokenSet, root);
-                break;
-            case TOKEN_KEYWORD_FOR:
-                NForLoop::parse(tokenSet, root);
-                break;
-            case TOKEN_KEYWORD_RETURN:
-                NReturnStatement::parse(tokenSet, root);
-                break;
-            case TOKEN_KEYWORD_THROW:
-                NThrowStatement::parse(tokenSet, root);
-                break;
-            case TOKEN_KEYWORD_MODULE:
-                NModuleDeclaration::parse(tokenSet, root);
-                break;
-            case TOKEN_SEMICOLON:
-                tokenSet.next();
-                break;
-            case TOKEN_LBRACE:
-                root.addChild(NBlock::capture(tokenSet));
-                break;
-            default:
-                // Attempt to parse expression.
-                NExpression::parse(tokenSet, root);
-                break;
+            // The error is already reported, skip to the next statement
+            // so the remainder of the file is still checked.
+            tokenSet.synchronize(statementStart);
         }
     }
+}
+
+void stride::ast::parser::parseStatement(TokenSet &tokenSet, stride::ast::Node &root)
+{
+    switch ( tokenSet.current().type )
+    {
+        case TOKEN_KEYWORD_DEFINE:
+            NFunctionDeclaration::parse(tokenSet, root);
+            break;
+        case TOKEN_KEYWORD_IF:
+            NConditionalStatement::parse(tokenSet, root);
+            break;
+        case TOKEN_KEYWORD_LET:
+        case TOKEN_KEYWORD_CONST:
+            NVariableDeclaration::parse(tokenSet, root);
+            break;
+        case TOKEN_KEYWORD_IMPORT:
+            NImportStatement::parse(tokenSet, root);
+            break;
+        case TOKEN_KEYWORD_PUBLIC:
+        case TOKEN_KEYWORD_CLASS:
+            NClassDeclaration::parse(tokenSet, root);
+            break;
+        case TOKEN_KEYWORD_EXTERNAL:
+        case TOKEN_KEYWORD_STRUCT:
+            NStructureDeclaration::parse(tokenSet, root);
+            break;
+        case TOKEN_KEYWORD_SWITCH:
+            NSwitchStatement::parse(tokenSet, root);
+            break;
+        case TOKEN_KEYWORD_TRY:
+            NTryCatchStatement::parse(tokenSet, root);
+            break;
+        case TOKEN_KEYWORD_ENUM:
+            NEnumerableDeclaration::parse(tokenSet, root);
+            break;
+        case TOKEN_KEYWORD_DO:
+            NDoWhileLoop::parse(tokenSet, root);
+            break;
+        case TOKEN_KEYWORD_WHILE:
+            NWhileLoop::parse(tokenSet, root);
+            break;
+        case TOKEN_KEYWORD_FOR:
+            NForLoop::parse(tokenSet, root);
+            break;
+        case TOKEN_KEYWORD_RETURN:
+            NReturnStatement::parse(tokenSet, root);
+            break;
+        case TOKEN_KEYWORD_THROW:
+            NThrowStatement::parse(tokenSet, root);
+            break;
+        case TOKEN_KEYWORD_MODULE:
+            NModuleDeclaration::parse(tokenSet, root);
+            break;
+        case TOKEN_SEMICOLON:
+            tokenSet.next();
+            break;
+        case TOKEN_LBRACE:
+            root.addChild(NBlock::capture(tokenSet));
+            break;
+        default:
+            // Attempt to parse expression.
+            NExpression::parse(tokenSet, root);
+            break;
+    }
 }
\ No newline at end of file
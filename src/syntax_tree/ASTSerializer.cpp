@@ -0,0 +1,847 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "ASTSerializer.h"
+#include "ASTTraversal.h"
+#include "node_types/definitions/NArray.h"
+#include "node_types/definitions/NBinaryOperation.h"
+#include "node_types/definitions/NClassDeclaration.h"
+#include "node_types/definitions/NConditionalStatement.h"
+#include "node_types/definitions/NDoWhileLoop.h"
+#include "node_types/definitions/NEnumerableDeclaration.h"
+#include "node_types/definitions/NForLoop.h"
+#include "node_types/definitions/NFunctionCall.h"
+#include "node_types/definitions/NFunctionDeclaration.h"
+#include "node_types/definitions/NImportStatement.h"
+#include "node_types/definitions/NModuleDeclaration.h"
+#include "node_types/definitions/NOperatorOverload.h"
+#include "node_types/definitions/NReturnStatement.h"
+#include "node_types/definitions/NStructureDeclaration.h"
+#include "node_types/definitions/NSwitchStatement.h"
+#include "node_types/definitions/NThrowStatement.h"
+#include "node_types/definitions/NTryCatchStatement.h"
+#include "node_types/definitions/NUnaryOperator.h"
+
+using namespace stride::ast;
+using namespace stride::ast::serialization;
+
+#define ALIGN_8(value) (((value) + 7) & ~((size_t) 7))
+
+/**
+ * Collects the sections of a serialized syntax tree.
+ */
+class ASTWriter
+{
+private:
+    std::vector<ast_node_record_t> nodes;
+    std::vector<uint32_t> edges;
+    std::vector<uint32_t> extra;
+    std::vector<ast_literal_record_t> literals;
+    std::vector<ast_string_record_t> strings;
+    std::string stringData;
+    std::unordered_map<std::string, uint32_t> stringIndices;
+
+    uint32_t intern(const std::string &value)
+    {
+        auto existing = stringIndices.find(value);
+        if ( existing != stringIndices.end())
+        {
+            return existing->second;
+        }
+
+        auto index = (uint32_t) strings.size();
+        strings.push_back({ (uint32_t) stringData.size(), (uint32_t) value.size() });
+        stringData.append(value).push_back('\0');
+        stringIndices.emplace(value, index);
+        return index;
+    }
+
+    uint32_t internOptional(const std::string *value)
+    {
+        return value == nullptr ? AST_NONE : intern(*value);
+    }
+
+    uint32_t writeGenerics(const std::vector<std::string *> &generics)
+    {
+        auto offset = (uint32_t) extra.size();
+        extra.push_back((uint32_t) generics.size());
+        for ( auto generic: generics )
+        {
+            extra.push_back(intern(*generic));
+        }
+        return offset;
+    }
+
+    uint32_t writeLiteral(NLiteral *literal)
+    {
+        ast_literal_record_t record {};
+        record.byteCount = (uint16_t) literal->bytes();
+        record.string = AST_NONE;
+
+        switch ( literal->value.index())
+        {
+            case 0:
+                record.tag = AST_LITERAL_INTEGER;
+                record.bits = std::get<int64_t>(literal->value);
+                break;
+            case 1:
+            {
+                record.tag = AST_LITERAL_FLOAT;
+                double_t value = std::get<double_t>(literal->value);
+                memcpy(&record.bits, &value, sizeof(double_t));
+            }
+                break;
+            default:
+                record.tag = AST_LITERAL_STRING;
+                record.string = intern(std::get<const char *>(literal->value));
+                break;
+        }
+
+        literals.push_back(record);
+        return (uint32_t) literals.size() - 1;
+    }
+
+public:
+
+    /**
+     * Writes a node and all of its descendants.
+     * @return The index of the node, or AST_NONE for null nodes.
+     */
+    uint32_t write(Node *node)
+    {
+        if ( node == nullptr )
+        {
+            return AST_NONE;
+        }
+
+        auto index = (uint32_t) nodes.size();
+        nodes.push_back({});
+
+        ast_node_record_t record {};
+        record.kind = (uint8_t) node->getType();
+        record.name = AST_NONE;
+        record.aux = AST_NONE;
+        record.extra = AST_NONE;
+        record.sourceStart = node->getSourceStart();
+        record.sourceEnd = node->getSourceEnd();
+
+        switch ( node->getType())
+        {
+            case LITERAL:
+                record.aux = writeLiteral(dynamic_cast<NLiteral *>(node));
+                break;
+            case IDENTIFIER:
+                record.name = intern(dynamic_cast<NIdentifier *>(node)->name);
+                break;
+            case BINARY_OPERATOR:
+                record.op = (uint16_t) dynamic_cast<NBinaryOperation *>(node)->operation;
+                break;
+            case UNARY_OPERATOR:
+                record.op = (uint16_t) dynamic_cast<NUnaryOperator *>(node)->operation;
+                break;
+            case FUNCTION_CALL:
+                record.name = internOptional(dynamic_cast<NFunctionCall *>(node)->functionName);
+                break;
+            case OPERATOR_OVERLOAD:
+                record.op = (uint16_t) dynamic_cast<NOperatorOverload *>(node)->operation;
+                break;
+            case VARIABLE_DECLARATION:
+            {
+                auto declaration = dynamic_cast<NVariableDeclaration *>(node);
+                record.name = internOptional(declaration->getVariableName());
+                auto &type = declaration->getVariableType();
+                if ( std::holds_alternative<token_type_t>(type))
+                {
+                    record.op = (uint16_t) std::get<token_type_t>(type);
+                }
+                else
+                {
+                    record.aux = internOptional(std::get<std::string *>(type));
+                }
+                record.flags = ( declaration->isConstant() ? AST_FLAG_CONST : 0 ) |
+                               ( declaration->isArrayType() ? AST_FLAG_ARRAY : 0 ) |
+                               ( declaration->isVariadicParameter() ? AST_FLAG_VARIADIC : 0 ) |
+                               ( declaration->hasSoaLayout() ? AST_FLAG_SOA : 0 );
+            }
+                break;
+            case FUNCTION_DECLARATION:
+            {
+                auto function = dynamic_cast<NFunctionDeclaration *>(node);
+                record.name = function->functionName ? intern(function->functionName->name) : AST_NONE;
+                record.aux = function->returnType ? intern(function->returnType->name) : AST_NONE;
+                record.flags = ( function->isPublic ? AST_FLAG_PUBLIC : 0 ) |
+                               ( function->external ? AST_FLAG_EXTERNAL : 0 ) |
+                               ( function->async ? AST_FLAG_ASYNC : 0 );
+            }
+                break;
+            case MODULE_DECLARATION:
+                record.name = intern(dynamic_cast<NModuleDeclaration *>(node)->getModuleName());
+                break;
+            case STRUCTURE_DECLARATION:
+            {
+                auto structure = dynamic_cast<NStructureDeclaration *>(node);
+                record.name = intern(structure->getName());
+                record.flags = structure->isExternal() ? AST_FLAG_EXTERNAL : 0;
+                record.extra = writeGenerics(structure->getGenerics());
+            }
+                break;
+            case ENUMERABLE_DECLARATION:
+            {
+                auto enumerable = dynamic_cast<NEnumerableDeclaration *>(node);
+                record.name = intern(enumerable->getName());
+                record.extra = (uint32_t) extra.size();
+                extra.push_back((uint32_t) enumerable->values.size());
+                for ( auto &[ member, value ]: enumerable->values )
+                {
+                    auto bits = (uint64_t) value;
+                    extra.push_back(intern(member));
+                    extra.push_back((uint32_t) bits);
+                    extra.push_back((uint32_t) ( bits >> 32 ));
+                }
+            }
+                break;
+            case CLASS_DECLARATION:
+            {
+                auto declaration = dynamic_cast<NClassDeclaration *>(node);
+                record.name = intern(declaration->getClassName());
+                record.flags = declaration->isPublicClass() ? AST_FLAG_PUBLIC : 0;
+                record.extra = writeGenerics(declaration->getGenerics());
+            }
+                break;
+            case IMPORT_STATEMENT:
+                record.name = intern(dynamic_cast<NImportStatement *>(node)->getModuleName());
+                break;
+            case FOR_LOOP:
+                record.aux = (uint32_t) dynamic_cast<NForLoop *>(node)->getInitializers().size();
+                break;
+            default:
+                break;
+        }
+
+        // Named fields of the node, in the order documented in the header.
+        std::vector<Node *> slots = getSlots(node);
+
+        // Write all referenced nodes before allocating our own edges,
+        // so the edges of this node end up contiguous.
+        std::vector<uint32_t> nodeEdges;
+        nodeEdges.reserve(slots.size() + node->getChildCount());
+        for ( auto slot: slots )
+        {
+            nodeEdges.push_back(write(slot));
+        }
+        for ( size_t i = 0; i < node->getChildCount(); i++ )
+        {
+            nodeEdges.push_back(write(node->getChild(i)));
+        }
+
+        record.edges = (uint32_t) edges.size();
+        record.slotCount = (uint32_t) slots.size();
+        record.childCount = (uint32_t) node->getChildCount();
+        edges.insert(edges.end(), nodeEdges.begin(), nodeEdges.end());
+
+        nodes[ index ] = record;
+        return index;
+    }
+
+    std::vector<uint8_t> finish(uint64_t sourceHash)
+    {
+        ast_file_header_t header {};
+        memcpy(header.magic, AST_FORMAT_MAGIC, 4);
+        header.version = AST_FORMAT_VERSION;
+        header.byteOrder = AST_BYTE_ORDER_MARK;
+        header.rootIndex = 0;
+        header.sourceHash = sourceHash;
+        header.nodeCount = (uint32_t) nodes.size();
+        header.edgeCount = (uint32_t) edges.size();
+        header.extraCount = (uint32_t) extra.size();
+        header.literalCount = (uint32_t) literals.size();
+        header.stringCount = (uint32_t) strings.size();
+        header.stringDataSize = (uint32_t) stringData.size();
+
+        size_t offset = ALIGN_8(sizeof(ast_file_header_t));
+        header.nodesOffset = (uint32_t) offset;
+        offset = ALIGN_8(offset + nodes.size() * sizeof(ast_node_record_t));
+        header.edgesOffset = (uint32_t) offset;
+        offset = ALIGN_8(offset + edges.size() * sizeof(uint32_t));
+        header.extraOffset = (uint32_t) offset;
+        offset = ALIGN_8(offset + extra.size() * sizeof(uint32_t));
+        header.literalsOffset = (uint32_t) offset;
+        offset = ALIGN_8(offset + literals.size() * sizeof(ast_literal_record_t));
+        header.stringsOffset = (uint32_t) offset;
+        offset = ALIGN_8(offset + strings.size() * sizeof(ast_string_record_t));
+        header.stringDataOffset = (uint32_t) offset;
+        offset = ALIGN_8(offset + stringData.size());
+
+        std::vector<uint8_t> buffer(offset, 0);
+        memcpy(buffer.data(), &header, sizeof(header));
+        memcpy(buffer.data() + header.nodesOffset, nodes.data(), nodes.size() * sizeof(ast_node_record_t));
+        memcpy(buffer.data() + header.edgesOffset, edges.data(), edges.size() * sizeof(uint32_t));
+        memcpy(buffer.data() + header.extraOffset, extra.data(), extra.size() * sizeof(uint32_t));
+        memcpy(buffer.data() + header.literalsOffset, literals.data(), literals.size() * sizeof(ast_literal_record_t));
+        memcpy(buffer.data() + header.stringsOffset, strings.data(), strings.size() * sizeof(ast_string_record_t));
+        memcpy(buffer.data() + header.stringDataOffset, stringData.data(), stringData.size());
+        return buffer;
+    }
+};
+
+std::vector<uint8_t> stride::ast::serialization::serialize(Node &root, uint64_t sourceHash)
+{
+    ASTWriter writer;
+    writer.write(&root);
+    return writer.finish(sourceHash);
+}
+
+bool stride::ast::serialization::write(Node &root, const std::string &path, uint64_t sourceHash)
+{
+    auto buffer = serialize(root, sourceHash);
+
+    // Write to a temporary file first, so readers never observe a partially written file.
+    std::string temporaryPath = path + ".tmp";
+    std::ofstream file_out(temporaryPath, std::ios::binary | std::ios::trunc);
+    if ( !file_out )
+    {
+        return false;
+    }
+    file_out.write(reinterpret_cast<const char *>(buffer.data()), (std::streamsize) buffer.size());
+    file_out.close();
+
+    if ( !file_out || rename(temporaryPath.c_str(), path.c_str()) != 0 )
+    {
+        unlink(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Reading
+ */
+
+ASTView::~ASTView()
+{
+    if ( this->mapped && this->data != nullptr )
+    {
+        munmap((void *) this->data, this->size);
+    }
+}
+
+bool ASTView::validateHeader() const
+{
+    if ( this->size < sizeof(ast_file_header_t) || ((uintptr_t) this->data & 7 ) != 0 )
+    {
+        return false;
+    }
+
+    auto &h = this->header();
+    if ( memcmp(h.magic, AST_FORMAT_MAGIC, 4) != 0 ||
+         h.version != AST_FORMAT_VERSION ||
+         h.byteOrder != AST_BYTE_ORDER_MARK ||
+         h.nodeCount == 0 || h.rootIndex >= h.nodeCount )
+    {
+        return false;
+    }
+
+    // Validate the section bounds, so node accessors only have to check indices.
+    auto fits = [ this ](uint64_t offset, uint64_t count, uint64_t elementSize)
+    {
+        return ( offset & 7 ) == 0 && offset + count * elementSize <= this->size;
+    };
+
+    return fits(h.nodesOffset, h.nodeCount, sizeof(ast_node_record_t)) &&
+           fits(h.edgesOffset, h.edgeCount, sizeof(uint32_t)) &&
+           fits(h.extraOffset, h.extraCount, sizeof(uint32_t)) &&
+           fits(h.literalsOffset, h.literalCount, sizeof(ast_literal_record_t)) &&
+           fits(h.stringsOffset, h.stringCount, sizeof(ast_string_record_t)) &&
+           fits(h.stringDataOffset, h.stringDataSize, 1);
+}
+
+ASTView *ASTView::open(const std::string &path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if ( fd < 0 )
+    {
+        return nullptr;
+    }
+
+    struct stat fileStat {};
+    if ( fstat(fd, &fileStat) != 0 || fileStat.st_size < (off_t) sizeof(ast_file_header_t))
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    void *mapping = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if ( mapping == MAP_FAILED )
+    {
+        return nullptr;
+    }
+
+    auto view = new ASTView((const uint8_t *) mapping, fileStat.st_size, true);
+    if ( !view->validateHeader())
+    {
+        delete view;
+        return nullptr;
+    }
+    return view;
+}
+
+ASTView *ASTView::fromBuffer(const void *buffer, size_t size)
+{
+    auto view = new ASTView((const uint8_t *) buffer, size, false);
+    if ( !view->validateHeader())
+    {
+        delete view;
+        return nullptr;
+    }
+    return view;
+}
+
+const ast_file_header_t &ASTView::header() const
+{
+    return *reinterpret_cast<const ast_file_header_t *>(this->data);
+}
+
+NodeRef ASTView::root() const
+{
+    return { this, this->header().rootIndex };
+}
+
+uint32_t ASTView::nodeCount() const
+{
+    return this->header().nodeCount;
+}
+
+const ast_node_record_t &ASTView::node(uint32_t index) const
+{
+    if ( index >= this->header().nodeCount )
+    {
+        throw std::out_of_range("Node index out of range in serialized syntax tree.");
+    }
+    return reinterpret_cast<const ast_node_record_t *>(this->data + this->header().nodesOffset)[ index ];
+}
+
+uint32_t ASTView::edge(uint32_t index) const
+{
+    if ( index >= this->header().edgeCount )
+    {
+        throw std::out_of_range("Edge index out of range in serialized syntax tree.");
+    }
+    return reinterpret_cast<const uint32_t *>(this->data + this->header().edgesOffset)[ index ];
+}
+
+uint32_t ASTView::extra(uint32_t index) const
+{
+    if ( index >= this->header().extraCount )
+    {
+        throw std::out_of_range("Extra data index out of range in serialized syntax tree.");
+    }
+    return reinterpret_cast<const uint32_t *>(this->data + this->header().extraOffset)[ index ];
+}
+
+const ast_literal_record_t &ASTView::literal(uint32_t index) const
+{
+    if ( index >= this->header().literalCount )
+    {
+        throw std::out_of_range("Literal index out of range in serialized syntax tree.");
+    }
+    return reinterpret_cast<const ast_literal_record_t *>(this->data + this->header().literalsOffset)[ index ];
+}
+
+std::string_view ASTView::string(uint32_t index) const
+{
+    if ( index >= this->header().stringCount )
+    {
+        throw std::out_of_range("String index out of range in serialized syntax tree.");
+    }
+    auto &record = reinterpret_cast<const ast_string_record_t *>(this->data + this->header().stringsOffset)[ index ];
+    if ((uint64_t) record.offset + record.length >= this->header().stringDataSize )
+    {
+        throw std::out_of_range("String data out of range in serialized syntax tree.");
+    }
+    return { (const char *) this->data + this->header().stringDataOffset + record.offset, record.length };
+}
+
+const ast_node_record_t &NodeRef::record() const
+{
+    return this->view->node(this->index);
+}
+
+ENodeType NodeRef::kind() const
+{
+    return (ENodeType) this->record().kind;
+}
+
+std::string_view NodeRef::name() const
+{
+    uint32_t name = this->record().name;
+    return name == AST_NONE ? std::string_view() : this->view->string(name);
+}
+
+uint32_t NodeRef::slotCount() const
+{
+    return this->record().slotCount;
+}
+
+uint32_t NodeRef::childCount() const
+{
+    return this->record().childCount;
+}
+
+NodeRef NodeRef::slot(uint32_t slotIndex) const
+{
+    auto &node = this->record();
+    if ( slotIndex >= node.slotCount )
+    {
+        return { this->view, AST_NONE };
+    }
+    return { this->view, this->view->edge(node.edges + slotIndex) };
+}
+
+NodeRef NodeRef::child(uint32_t childIndex) const
+{
+    auto &node = this->record();
+    if ( childIndex >= node.childCount )
+    {
+        return { this->view, AST_NONE };
+    }
+    return { this->view, this->view->edge(node.edges + node.slotCount + childIndex) };
+}
+
+/*
+ * Materialization
+ */
+
+Node *build(const ASTView &view, uint32_t index, uint32_t parentIndex);
+
+/**
+ * Builds the node in the provided slot, and checks whether it is of the expected type.
+ */
+template<typename T>
+T *buildSlot(const ASTView &view, NodeRef node, uint32_t slotIndex)
+{
+    NodeRef slot = node.slot(slotIndex);
+    if ( slot.isNull())
+    {
+        return nullptr;
+    }
+
+    Node *built = build(view, slot.getIndex(), node.getIndex());
+    auto typed = dynamic_cast<T *>(built);
+    if ( typed == nullptr )
+    {
+        throw std::runtime_error("Unexpected node type in serialized syntax tree.");
+    }
+    return typed;
+}
+
+std::string *optionalString(const ASTView &view, uint32_t index)
+{
+    return index == AST_NONE ? nullptr : new std::string(view.string(index));
+}
+
+void readGenerics(const ASTView &view, uint32_t offset, std::vector<std::string *> &genericsDst)
+{
+    if ( offset == AST_NONE )
+    {
+        return;
+    }
+    uint32_t count = view.extra(offset);
+    for ( uint32_t i = 0; i < count; i++ )
+    {
+        genericsDst.push_back(new std::string(view.string(view.extra(offset + 1 + i))));
+    }
+}
+
+NLiteral *buildLiteral(const ASTView &view, const ast_literal_record_t &literal)
+{
+    switch ( literal.tag )
+    {
+        case AST_LITERAL_INTEGER:
+            return new NLiteral(LiteralValue(literal.bits), literal.byteCount);
+        case AST_LITERAL_FLOAT:
+        {
+            double_t value;
+            memcpy(&value, &literal.bits, sizeof(double_t));
+            return new NLiteral(LiteralValue(value), literal.byteCount);
+        }
+        case AST_LITERAL_STRING:
+        {
+            // The literal outlives the view, so the string has to be copied.
+            std::string_view value = view.string(literal.string);
+            char *copy = (char *) malloc(value.size() + 1);
+            memcpy(copy, value.data(), value.size() + 1);
+            return new NLiteral(LiteralValue((const char *) copy), literal.byteCount);
+        }
+        default:
+            throw std::runtime_error("Invalid literal in serialized syntax tree.");
+    }
+}
+
+Node *build(const ASTView &view, uint32_t index, uint32_t parentIndex)
+{
+    // Nodes are stored in pre-order, so every reference has to point forward.
+    // This also guarantees malformed input can't cause infinite recursion.
+    if ( parentIndex != AST_NONE && index <= parentIndex )
+    {
+        throw std::runtime_error("Invalid node reference in serialized syntax tree.");
+    }
+
+    NodeRef ref(&view, index);
+    auto &record = ref.record();
+    Node *node;
+
+    switch ((ENodeType) record.kind )
+    {
+        case GENERIC:
+            node = new Node();
+            break;
+        case LITERAL:
+            node = buildLiteral(view, view.literal(record.aux));
+            break;
+        case IDENTIFIER:
+            node = new NIdentifier(std::string(ref.name()));
+            break;
+        case BLOCK:
+            node = new NBlock();
+            break;
+        case EXPRESSION:
+            node = new NExpression();
+            break;
+        case ARRAY:
+        {
+            auto array = new NArray();
+            for ( uint32_t i = 0; i < record.slotCount; i++ )
+            {
+                array->addElement(buildSlot<NExpression>(view, ref, i));
+            }
+            node = array;
+        }
+            break;
+        case BINARY_OPERATOR:
+            node = new NBinaryOperation(buildSlot<NExpression>(view, ref, 0),
+                                        (EBinaryOperator) record.op,
+                                        buildSlot<NExpression>(view, ref, 1));
+            break;
+        case UNARY_OPERATOR:
+            node = new NUnaryOperator((EUnaryOperator) record.op,
+                                      std::unique_ptr<NExpression>(buildSlot<NExpression>(view, ref, 0)));
+            break;
+        case FUNCTION_CALL:
+        {
+            auto call = new NFunctionCall();
+            call->functionName = optionalString(view, record.name);
+            for ( uint32_t i = 0; i < record.slotCount; i++ )
+            {
+                call->addArgument(buildSlot<NExpression>(view, ref, i));
+            }
+            node = call;
+        }
+            break;
+        case OPERATOR_OVERLOAD:
+            node = new NOperatorOverload((EBinaryOperator) record.op,
+                                         buildSlot<NFunctionDeclaration>(view, ref, 0));
+            break;
+        case VARIABLE_DECLARATION:
+        {
+            auto declaration = new NVariableDeclaration();
+            if ( record.name != AST_NONE )
+            {
+                declaration->setVariableName(std::string(view.string(record.name)));
+            }
+            declaration->setVariableType(
+                    record.aux != AST_NONE ?
+                    std::variant<std::string *, token_type_t>(optionalString(view, record.aux)) :
+                    record.op != 0 ?
+                    std::variant<std::string *, token_type_t>((token_type_t) record.op) :
+                    std::variant<std::string *, token_type_t>(nullptr));
+            declaration->setConst(record.flags & AST_FLAG_CONST);
+            declaration->setIsArray(record.flags & AST_FLAG_ARRAY);
+            declaration->setVariadic(record.flags & AST_FLAG_VARIADIC);
+            declaration->setSoaLayout(record.flags & AST_FLAG_SOA);
+            declaration->setValue(buildSlot<NExpression>(view, ref, 0));
+            node = declaration;
+        }
+            break;
+        case FUNCTION_DECLARATION:
+        {
+            auto function = new NFunctionDeclaration();
+            if ( record.name != AST_NONE )
+            {
+                function->setFunctionName(std::string(view.string(record.name)));
+            }
+            if ( record.aux != AST_NONE )
+            {
+                function->returnType = new NIdentifier(std::string(view.string(record.aux)));
+            }
+            function->isPublic = record.flags & AST_FLAG_PUBLIC;
+            function->external = record.flags & AST_FLAG_EXTERNAL;
+            function->async = record.flags & AST_FLAG_ASYNC;
+            function->body = buildSlot<NBlock>(view, ref, 0);
+            for ( uint32_t i = 1; i < record.slotCount; i++ )
+            {
+                function->addParameter(buildSlot<NVariableDeclaration>(view, ref, i));
+            }
+            node = function;
+        }
+            break;
+        case MODULE_DECLARATION:
+        {
+            auto module = new NModuleDeclaration(std::string(ref.name()));
+            module->setBody(buildSlot<NBlock>(view, ref, 0));
+            node = module;
+        }
+            break;
+        case STRUCTURE_DECLARATION:
+        {
+            auto structure = new NStructureDeclaration();
+            structure->setName(ref.name().data());
+            structure->setExternal(record.flags & AST_FLAG_EXTERNAL);
+            readGenerics(view, record.extra, structure->getGenerics());
+            for ( uint32_t i = 0; i < record.slotCount; i++ )
+            {
+                structure->addField(buildSlot<NVariableDeclaration>(view, ref, i));
+            }
+            node = structure;
+        }
+            break;
+        case ENUMERABLE_DECLARATION:
+        {
+            auto enumerable = new NEnumerableDeclaration();
+            enumerable->setName(std::string(ref.name()));
+            if ( record.extra != AST_NONE )
+            {
+                uint32_t count = view.extra(record.extra);
+                for ( uint32_t i = 0; i < count; i++ )
+                {
+                    uint32_t entry = record.extra + 1 + i * 3;
+                    std::string member(view.string(view.extra(entry)));
+                    uint64_t bits = view.extra(entry + 1) | ((uint64_t) view.extra(entry + 2) << 32 );
+                    enumerable->addValue(member, (long int) bits);
+                }
+            }
+            node = enumerable;
+        }
+            break;
+        case CLASS_DECLARATION:
+        {
+            auto declaration = new NClassDeclaration();
+            declaration->setClassName(std::string(ref.name()));
+            declaration->setPublic(record.flags & AST_FLAG_PUBLIC);
+            readGenerics(view, record.extra, declaration->getGenerics());
+            declaration->setBody(buildSlot<NBlock>(view, ref, 0));
+            for ( uint32_t i = 1; i < record.slotCount; i++ )
+            {
+                declaration->addParent(buildSlot<NIdentifier>(view, ref, i));
+            }
+            node = declaration;
+        }
+            break;
+        case THROW_STATEMENT:
+            node = new NThrowStatement(buildSlot<NExpression>(view, ref, 0));
+            break;
+        case RETURN_STATEMENT:
+        {
+            auto statement = new NReturnStatement();
+            statement->setExpression(buildSlot<NExpression>(view, ref, 0));
+            node = statement;
+        }
+            break;
+        case CONDITIONAL_STATEMENT:
+        {
+            auto conditional = new NConditionalStatement();
+            conditional->setCondition(buildSlot<NExpression>(view, ref, 0));
+            conditional->setThen(buildSlot<NBlock>(view, ref, 1));
+            conditional->setElse(buildSlot<NBlock>(view, ref, 2));
+            node = conditional;
+        }
+            break;
+        case SWITCH_STATEMENT:
+        {
+            auto switchStatement = new NSwitchStatement();
+            switchStatement->setExpression(buildSlot<NExpression>(view, ref, 0));
+            switchStatement->setDefaultCase(buildSlot<NSwitchCase>(view, ref, 1));
+            for ( uint32_t i = 2; i < record.slotCount; i++ )
+            {
+                switchStatement->addCase(buildSlot<NSwitchCase>(view, ref, i));
+            }
+            node = switchStatement;
+        }
+            break;
+        case SWITCH_CASE:
+        {
+            auto switchCase = new NSwitchCase();
+            switchCase->body = buildSlot<NBlock>(view, ref, 0);
+            for ( uint32_t i = 1; i < record.slotCount; i++ )
+            {
+                switchCase->values.push_back(buildSlot<NLiteral>(view, ref, i));
+            }
+            node = switchCase;
+        }
+            break;
+        case IMPORT_STATEMENT:
+            node = new NImportStatement(std::string(ref.name()));
+            break;
+        case FOR_LOOP:
+        {
+            auto loop = new NForLoop();
+            loop->setCondition(buildSlot<NExpression>(view, ref, 0));
+            loop->body = buildSlot<NBlock>(view, ref, 1);
+            for ( uint32_t i = 2; i < record.slotCount; i++ )
+            {
+                auto declaration = buildSlot<NVariableDeclaration>(view, ref, i);
+                if ( i - 2 < record.aux )
+                {
+                    loop->addInitializer(declaration);
+                }
+                else
+                {
+                    loop->addIncrementor(declaration);
+                }
+            }
+            node = loop;
+        }
+            break;
+        case WHILE_LOOP:
+            node = new NWhileLoop(buildSlot<NExpression>(view, ref, 0), buildSlot<NBlock>(view, ref, 1));
+            break;
+        case DO_WHILE_LOOP:
+            node = new NDoWhileLoop(buildSlot<NExpression>(view, ref, 0), buildSlot<NBlock>(view, ref, 1));
+            break;
+        case TRY_CATCH_CLAUSE:
+        {
+            auto tryCatch = new NTryCatchStatement();
+            tryCatch->setTryBlock(buildSlot<NBlock>(view, ref, 0));
+            tryCatch->setException(buildSlot<NVariableDeclaration>(view, ref, 1));
+            tryCatch->setCatchBlock(buildSlot<NBlock>(view, ref, 2));
+            node = tryCatch;
+        }
+            break;
+        default:
+            throw std::runtime_error("Unknown node kind in serialized syntax tree.");
+    }
+
+    node->setSourceRange(record.sourceStart, record.sourceEnd);
+
+    for ( uint32_t i = 0; i < record.childCount; i++ )
+    {
+        node->addChild(build(view, ref.child(i).getIndex(), index));
+    }
+
+    return node;
+}
+
+Node *stride::ast::serialization::materialize(const ASTView &view)
+{
+    return build(view, view.header().rootIndex, AST_NONE);
+}
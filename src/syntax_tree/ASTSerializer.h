@@ -0,0 +1,234 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_ASTSERIALIZER_H
+#define STRIDE_LANGUAGE_ASTSERIALIZER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ASTNodes.h"
+
+/**
+ * Binary format of serialized syntax trees.
+ *
+ * A serialized tree consists of a header, followed by the following sections,
+ * each aligned to 8 bytes:
+ * <ul>
+ *  <li>nodes: one ast_node_record_t per node, in pre-order. The root is node 0.</li>
+ *  <li>edges: node indices referenced by the nodes. Every node owns a range of
+ *      <code>slotCount</code> slots (its named fields, which may be AST_NONE),
+ *      followed by <code>childCount</code> generic children.</li>
+ *  <li>extra: variable length data, e.g. generic parameter names.
+ *      Every list starts with its length.</li>
+ *  <li>literals: one ast_literal_record_t per literal node.</li>
+ *  <li>strings: one ast_string_record_t per interned string.</li>
+ *  <li>string data: NUL-terminated string contents.</li>
+ * </ul>
+ * All values are stored in the byte order of the machine that wrote the file;
+ * files with a different byte order are rejected when loaded.
+ */
+#define AST_FORMAT_MAGIC "SAST"
+#define AST_FORMAT_VERSION 3
+#define AST_BYTE_ORDER_MARK 0x01020304u
+
+#define AST_NONE 0xFFFFFFFFu
+
+/* Node record flags */
+#define AST_FLAG_PUBLIC     (1 << 0)
+#define AST_FLAG_EXTERNAL   (1 << 1)
+#define AST_FLAG_ASYNC      (1 << 2)
+#define AST_FLAG_CONST      (1 << 3)
+#define AST_FLAG_ARRAY      (1 << 4)
+#define AST_FLAG_VARIADIC   (1 << 5)
+#define AST_FLAG_SOA        (1 << 6)
+
+/* Literal record tags */
+#define AST_LITERAL_INTEGER 0
+#define AST_LITERAL_FLOAT   1
+#define AST_LITERAL_STRING  2
+
+typedef struct
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t rootIndex;
+
+    /**
+     * Hash of the source the tree was generated from.
+     * This is not used by the format itself, but allows callers to
+     * check whether a serialized tree is still up-to-date.
+     */
+    uint64_t sourceHash;
+
+    uint32_t nodeCount, edgeCount, extraCount, literalCount, stringCount, stringDataSize;
+    uint32_t nodesOffset, edgesOffset, extraOffset, literalsOffset, stringsOffset, stringDataOffset;
+} ast_file_header_t;
+
+typedef struct
+{
+    uint8_t kind;       // stride::ast::ENodeType
+    uint8_t flags;      // AST_FLAG_*
+    uint16_t op;        // Operator or primitive type token
+    uint32_t name;      // String index
+    uint32_t aux;       // Kind specific; literal index, type name or count
+    uint32_t extra;     // Offset into the extra section
+    uint32_t edges;     // Offset into the edges section
+    uint32_t slotCount;
+    uint32_t childCount;
+    int32_t sourceStart;
+    int32_t sourceEnd;
+} ast_node_record_t;
+
+typedef struct
+{
+    uint8_t tag;        // AST_LITERAL_*
+    uint8_t reserved;
+    uint16_t byteCount;
+    uint32_t string;    // String index for string literals
+    int64_t bits;       // Integer value, or the bits of a floating point value
+} ast_literal_record_t;
+
+typedef struct
+{
+    uint32_t offset;
+    uint32_t length;
+} ast_string_record_t;
+
+namespace stride::ast::serialization
+{
+
+    class ASTView;
+
+    /**
+     * Lightweight reference to a node in a serialized syntax tree.
+     * Accessing the node reads directly from the underlying buffer.
+     */
+    class NodeRef
+    {
+    private:
+        const ASTView *view;
+        uint32_t index;
+
+    public:
+        NodeRef(const ASTView *view, uint32_t index) : view(view), index(index)
+        {}
+
+        /**
+         * Whether this reference points to a node.
+         * Empty slots are represented by a null reference.
+         */
+        [[nodiscard]] bool isNull() const
+        { return index == AST_NONE; }
+
+        [[nodiscard]] uint32_t getIndex() const
+        { return index; }
+
+        [[nodiscard]] const ast_node_record_t &record() const;
+
+        [[nodiscard]] ENodeType kind() const;
+
+        [[nodiscard]] std::string_view name() const;
+
+        [[nodiscard]] uint32_t slotCount() const;
+
+        [[nodiscard]] uint32_t childCount() const;
+
+        /**
+         * Returns the named field of the node at the provided slot.
+         */
+        [[nodiscard]] NodeRef slot(uint32_t slotIndex) const;
+
+        /**
+         * Returns the generic child at the provided index.
+         */
+        [[nodiscard]] NodeRef child(uint32_t childIndex) const;
+    };
+
+    /**
+     * Read-only view of a serialized syntax tree.
+     * The view can either be backed by a memory mapped file, or by a buffer
+     * owned by the caller. Opening a view only validates the header,
+     * so loading costs roughly as much as mapping the file.
+     */
+    class ASTView
+    {
+    private:
+        const uint8_t *data;
+        size_t size;
+        bool mapped;
+
+        ASTView(const uint8_t *data, size_t size, bool mapped) : data(data), size(size), mapped(mapped)
+        {}
+
+        [[nodiscard]] bool validateHeader() const;
+
+    public:
+
+        ~ASTView();
+
+        ASTView(const ASTView &) = delete;
+
+        ASTView &operator=(const ASTView &) = delete;
+
+        /**
+         * Memory maps a serialized syntax tree.
+         * @param path The path of the file to map.
+         * @return The view, or nullptr if the file couldn't be opened
+         * or isn't a valid serialized tree.
+         */
+        static ASTView *open(const std::string &path);
+
+        /**
+         * Creates a view over an existing buffer.
+         * The buffer must outlive the view, and must be aligned to 8 bytes.
+         * @return The view, or nullptr if the buffer isn't a valid serialized tree.
+         */
+        static ASTView *fromBuffer(const void *buffer, size_t size);
+
+        [[nodiscard]] const ast_file_header_t &header() const;
+
+        [[nodiscard]] NodeRef root() const;
+
+        [[nodiscard]] uint32_t nodeCount() const;
+
+        [[nodiscard]] const ast_node_record_t &node(uint32_t index) const;
+
+        [[nodiscard]] uint32_t edge(uint32_t index) const;
+
+        [[nodiscard]] uint32_t extra(uint32_t index) const;
+
+        [[nodiscard]] const ast_literal_record_t &literal(uint32_t index) const;
+
+        /**
+         * Returns the interned string at the provided index.
+         * The returned view is NUL-terminated, and is valid for the lifetime of this view.
+         */
+        [[nodiscard]] std::string_view string(uint32_t index) const;
+    };
+
+    /**
+     * Serializes a syntax tree into a buffer.
+     * @param root The root of the tree to serialize.
+     * @param sourceHash The hash of the source the tree was generated from.
+     * @return The serialized tree.
+     */
+    std::vector<uint8_t> serialize(Node &root, uint64_t sourceHash = 0);
+
+    /**
+     * Serializes a syntax tree and writes it to the provided path.
+     * @return Whether the file was written successfully.
+     */
+    bool write(Node &root, const std::string &path, uint64_t sourceHash = 0);
+
+    /**
+     * Reconstructs the syntax tree from a serialized view.
+     * @throws std::exception if the serialized tree is malformed; out-of-range indices throw std::out_of_range.
+     */
+    Node *materialize(const ASTView &view);
+}
+
+#endif //STRIDE_LANGUAGE_ASTSERIALIZER_H
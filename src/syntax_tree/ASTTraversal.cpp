@@ -0,0 +1,309 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include "ASTTraversal.h"
+#include "node_types/definitions/NArray.h"
+#include "node_types/definitions/NBinaryOperation.h"
+#include "node_types/definitions/NClassDeclaration.h"
+#include "node_types/definitions/NConditionalStatement.h"
+#include "node_types/definitions/NDoWhileLoop.h"
+#include "node_types/definitions/NForLoop.h"
+#include "node_types/definitions/NFunctionCall.h"
+#include "node_types/definitions/NFunctionDeclaration.h"
+#include "node_types/definitions/NModuleDeclaration.h"
+#include "node_types/definitions/NOperatorOverload.h"
+#include "node_types/definitions/NReturnStatement.h"
+#include "node_types/definitions/NStructureDeclaration.h"
+#include "node_types/definitions/NSwitchStatement.h"
+#include "node_types/definitions/NThrowStatement.h"
+#include "node_types/definitions/NTryCatchStatement.h"
+#include "node_types/definitions/NUnaryOperator.h"
+
+using namespace stride::ast;
+
+std::vector<Node *> stride::ast::getSlots(Node *node)
+{
+    std::vector<Node *> slots;
+
+    switch ( node->getType())
+    {
+        case ARRAY:
+            for ( auto element: dynamic_cast<NArray *>(node)->elements )
+            {
+                slots.push_back(element);
+            }
+            break;
+        case BINARY_OPERATOR:
+        {
+            auto binary = dynamic_cast<NBinaryOperation *>(node);
+            slots = { binary->left, binary->right };
+        }
+            break;
+        case UNARY_OPERATOR:
+            slots = { dynamic_cast<NUnaryOperator *>(node)->expression.get() };
+            break;
+        case FUNCTION_CALL:
+            for ( auto argument: dynamic_cast<NFunctionCall *>(node)->arguments )
+            {
+                slots.push_back(argument);
+            }
+            break;
+        case OPERATOR_OVERLOAD:
+            slots = { dynamic_cast<NOperatorOverload *>(node)->overloaded_function };
+            break;
+        case VARIABLE_DECLARATION:
+            slots = { dynamic_cast<NVariableDeclaration *>(node)->getValue() };
+            break;
+        case FUNCTION_DECLARATION:
+        {
+            auto function = dynamic_cast<NFunctionDeclaration *>(node);
+            slots.push_back(function->body);
+            for ( auto argument: function->arguments )
+            {
+                slots.push_back(argument);
+            }
+        }
+            break;
+        case MODULE_DECLARATION:
+            slots = { dynamic_cast<NModuleDeclaration *>(node)->getBody() };
+            break;
+        case STRUCTURE_DECLARATION:
+            for ( auto field: dynamic_cast<NStructureDeclaration *>(node)->getFields())
+            {
+                slots.push_back(field);
+            }
+            break;
+        case CLASS_DECLARATION:
+        {
+            auto declaration = dynamic_cast<NClassDeclaration *>(node);
+            slots.push_back(declaration->getBody());
+            for ( auto parent: declaration->getParents())
+            {
+                slots.push_back(parent);
+            }
+        }
+            break;
+        case THROW_STATEMENT:
+            slots = { dynamic_cast<NThrowStatement *>(node)->expression };
+            break;
+        case RETURN_STATEMENT:
+            slots = { dynamic_cast<NReturnStatement *>(node)->getExpression() };
+            break;
+        case CONDITIONAL_STATEMENT:
+        {
+            auto conditional = dynamic_cast<NConditionalStatement *>(node);
+            slots = { conditional->getCondition(), conditional->getThen(), conditional->getElse() };
+        }
+            break;
+        case SWITCH_STATEMENT:
+        {
+            auto switchStatement = dynamic_cast<NSwitchStatement *>(node);
+            slots = { switchStatement->getExpression(), switchStatement->getDefaultCase() };
+            for ( auto switchCase: switchStatement->getCases())
+            {
+                slots.push_back(switchCase);
+            }
+        }
+            break;
+        case SWITCH_CASE:
+        {
+            auto switchCase = dynamic_cast<NSwitchCase *>(node);
+            slots = { switchCase->body };
+            for ( auto value: switchCase->values )
+            {
+                slots.push_back(value);
+            }
+        }
+            break;
+        case FOR_LOOP:
+        {
+            auto loop = dynamic_cast<NForLoop *>(node);
+            slots = { loop->condition, loop->body };
+            for ( auto initializer: loop->getInitializers())
+            {
+                slots.push_back(initializer);
+            }
+            for ( auto incrementor: loop->getIncrementors())
+            {
+                slots.push_back(incrementor);
+            }
+        }
+            break;
+        case WHILE_LOOP:
+        case DO_WHILE_LOOP:
+        {
+            auto loop = dynamic_cast<NWhileLoop *>(node);
+            slots = { loop->condition, loop->body };
+        }
+            break;
+        case TRY_CATCH_CLAUSE:
+        {
+            auto tryCatch = dynamic_cast<NTryCatchStatement *>(node);
+            slots = { tryCatch->getTryBlock(), tryCatch->getException(), tryCatch->getCatchBlock() };
+        }
+            break;
+        default:
+            break;
+    }
+    return slots;
+}
+
+void stride::ast::forEachSubnode(Node *node, const std::function<void(Node *)> &visitor)
+{
+    for ( auto slot: getSlots(node))
+    {
+        if ( slot != nullptr )
+        {
+            visitor(slot);
+        }
+    }
+    for ( size_t i = 0; i < node->getChildCount(); i++ )
+    {
+        visitor(node->getChild(i));
+    }
+}
+
+/**
+ * Replaces an expression slot if it refers to the provided node.
+ */
+template<typename T>
+static bool replaceSlot(T *&slot, Node *subnode, Node *replacement)
+{
+    if ( slot != subnode )
+    {
+        return false;
+    }
+    slot = dynamic_cast<T *>(replacement);
+    return true;
+}
+
+bool stride::ast::replaceSubnode(Node *parent, Node *subnode, Node *replacement)
+{
+    parent->invalidateAttributes();
+
+    for ( size_t i = 0; i < parent->getChildCount(); i++ )
+    {
+        if ( parent->getChild(i) == subnode )
+        {
+            parent->replaceChildren(i, 1, { replacement });
+            return true;
+        }
+    }
+
+    switch ( parent->getType())
+    {
+        case ARRAY:
+            for ( auto &element: dynamic_cast<NArray *>(parent)->elements )
+            {
+                if ( replaceSlot(element, subnode, replacement))
+                {
+                    return true;
+                }
+            }
+            return false;
+        case BINARY_OPERATOR:
+        {
+            auto binary = dynamic_cast<NBinaryOperation *>(parent);
+            return replaceSlot(binary->left, subnode, replacement) ||
+                   replaceSlot(binary->right, subnode, replacement);
+        }
+        case UNARY_OPERATOR:
+        {
+            auto unary = dynamic_cast<NUnaryOperator *>(parent);
+            if ( unary->expression.get() != subnode )
+            {
+                return false;
+            }
+            unary->expression.release();
+            unary->expression.reset(dynamic_cast<NExpression *>(replacement));
+            return true;
+        }
+        case FUNCTION_CALL:
+            for ( auto &argument: dynamic_cast<NFunctionCall *>(parent)->arguments )
+            {
+                if ( replaceSlot(argument, subnode, replacement))
+                {
+                    return true;
+                }
+            }
+            return false;
+        case VARIABLE_DECLARATION:
+        {
+            auto declaration = dynamic_cast<NVariableDeclaration *>(parent);
+            if ( declaration->getValue() != subnode )
+            {
+                return false;
+            }
+            declaration->setValue(dynamic_cast<NExpression *>(replacement));
+            return true;
+        }
+        case THROW_STATEMENT:
+            return replaceSlot(dynamic_cast<NThrowStatement *>(parent)->expression, subnode, replacement);
+        case RETURN_STATEMENT:
+        {
+            auto returnStatement = dynamic_cast<NReturnStatement *>(parent);
+            if ( returnStatement->getExpression() != subnode )
+            {
+                return false;
+            }
+            returnStatement->setExpression(dynamic_cast<NExpression *>(replacement));
+            return true;
+        }
+        case CONDITIONAL_STATEMENT:
+        {
+            auto conditional = dynamic_cast<NConditionalStatement *>(parent);
+            if ( conditional->getCondition() != subnode )
+            {
+                return false;
+            }
+            conditional->setCondition(dynamic_cast<NExpression *>(replacement));
+            return true;
+        }
+        case SWITCH_STATEMENT:
+        {
+            auto switchStatement = dynamic_cast<NSwitchStatement *>(parent);
+            if ( switchStatement->getExpression() != subnode )
+            {
+                return false;
+            }
+            switchStatement->setExpression(dynamic_cast<NExpression *>(replacement));
+            return true;
+        }
+        case SWITCH_CASE:
+            for ( auto &value: dynamic_cast<NSwitchCase *>(parent)->values )
+            {
+                if ( replaceSlot(value, subnode, replacement))
+                {
+                    return true;
+                }
+            }
+            return false;
+        case FOR_LOOP:
+        case WHILE_LOOP:
+        case DO_WHILE_LOOP:
+            return replaceSlot(dynamic_cast<NWhileLoop *>(parent)->condition, subnode, replacement);
+        default:
+            return false;
+    }
+}
+
+void stride::ast::walk(Node *node, const std::function<bool(Node *)> &visitor)
+{
+    // Explicit stack, as deeply nested expressions could overflow the call stack.
+    std::vector<Node *> stack = { node };
+    std::vector<Node *> subnodes;
+    while ( !stack.empty())
+    {
+        Node *current = stack.back();
+        stack.pop_back();
+        if ( !visitor(current))
+        {
+            continue;
+        }
+
+        subnodes.clear();
+        forEachSubnode(current, [ &subnodes ](Node *subnode) { subnodes.push_back(subnode); });
+        stack.insert(stack.end(), subnodes.rbegin(), subnodes.rend());
+    }
+}
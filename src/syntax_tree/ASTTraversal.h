@@ -0,0 +1,56 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_ASTTRAVERSAL_H
+#define STRIDE_LANGUAGE_ASTTRAVERSAL_H
+
+#include <functional>
+#include <vector>
+#include "ASTNodes.h"
+
+namespace stride::ast
+{
+
+    /**
+     * Returns the named fields of a node that refer to other nodes,
+     * such as the body and parameters of a function.
+     * Fields that aren't set are included as nullptr, so the position of
+     * a field only depends on the kind of the node:
+     * <ul>
+     *  <li>function: body, parameters...</li>
+     *  <li>variable declaration: value</li>
+     *  <li>class: body, parents...</li>
+     *  <li>structure: fields...</li>
+     *  <li>conditional: condition, then, else</li>
+     *  <li>switch: expression, default case, cases...</li>
+     *  <li>switch case: body, values...</li>
+     *  <li>for loop: condition, body, initializers..., incrementors...</li>
+     *  <li>try-catch: try block, exception, catch block</li>
+     * </ul>
+     * Generic children, see <code>Node::getChildren</code>, are not included.
+     */
+    std::vector<Node *> getSlots(Node *node);
+
+    /**
+     * Calls the visitor for every node directly referenced by the provided
+     * node; first its set slots, then its children.
+     */
+    void forEachSubnode(Node *node, const std::function<void(Node *)> &visitor);
+
+    /**
+     * Replaces a node that is directly referenced by the provided parent,
+     * either through a slot or as a generic child. The replaced node is detached, not deleted.
+     * Only slots that hold expressions can be replaced.
+     * @return Whether the node was found and replaced.
+     */
+    bool replaceSubnode(Node *parent, Node *subnode, Node *replacement);
+
+    /**
+     * Visits a node and all of its descendants in pre-order.
+     * If the visitor returns false, the descendants of that node are skipped.
+     */
+    void walk(Node *node, const std::function<bool(Node *)> &visitor);
+}
+
+#endif //STRIDE_LANGUAGE_ASTTRAVERSAL_H
@@ -0,0 +1,301 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include <unordered_set>
+#include "IncrementalParser.h"
+#include "ASTTraversal.h"
+#include "../tokens/tokenizer.h"
+
+using namespace stride::ast;
+using namespace stride::ast::incremental;
+
+/**
+ * Characters after which inserted text can't merge with the following token.
+ */
+static bool isTokenSeparator(char character)
+{
+    return character == ' ' || character == '\n' || character == '\t' || character == '\r' ||
+           character == ';' || character == '{' || character == '}';
+}
+
+/**
+ * Whether the edit affects a node, either because they overlap, or because
+ * the edit touches the node and could change the tokens at its boundary.
+ */
+static bool affects(Node *node, const TextEdit &edit, const std::string &content)
+{
+    int editEnd = edit.start + edit.removedLength;
+    if ( node->getSourceStart() < editEnd && node->getSourceEnd() > edit.start )
+    {
+        return true;
+    }
+
+    // Text inserted directly after a node can only extend its last token,
+    // if that token isn't a terminator.
+    if ( node->getSourceEnd() == edit.start )
+    {
+        return !isTokenSeparator(content[ node->getSourceEnd() - 1 ]);
+    }
+
+    // Likewise, text directly before a node can merge with its first token.
+    if ( node->getSourceStart() == editEnd )
+    {
+        char preceding = !edit.insertedText.empty() ? edit.insertedText.back() :
+                         edit.start > 0 ? content[ edit.start - 1 ] : ' ';
+        return !isTokenSeparator(preceding);
+    }
+    return false;
+}
+
+/**
+ * Returns the block of a node whose content strictly contains the edit,
+ * so the edit doesn't touch the braces of the block.
+ */
+static Node *findEnclosingBlock(Node *node, const TextEdit &edit)
+{
+    int editEnd = edit.start + edit.removedLength;
+    std::vector<Node *> candidates;
+    if ( node->getType() == BLOCK )
+    {
+        candidates.push_back(node);
+    }
+    else
+    {
+        forEachSubnode(node, [ &candidates ](Node *subnode)
+        {
+            if ( subnode->getType() == BLOCK )
+            {
+                candidates.push_back(subnode);
+            }
+        });
+    }
+
+    for ( auto block: candidates )
+    {
+        if ( block->hasSourceRange() &&
+             block->getSourceStart() < edit.start &&
+             editEnd < block->getSourceEnd() - 1 )
+        {
+            return block;
+        }
+    }
+    return nullptr;
+}
+
+static void freeTokens(std::vector<token_t> &tokens, size_t first, size_t last)
+{
+    for ( size_t i = first; i < last; i++ )
+    {
+        free(tokens[ i ].value);
+    }
+}
+
+/**
+ * Whether every brace in a range of tokens is closed within the range.
+ */
+static bool bracesBalanced(const std::vector<token_t> &tokens)
+{
+    int depth = 0;
+    for ( auto &token: tokens )
+    {
+        depth += token.type == TOKEN_LBRACE ? 1 : token.type == TOKEN_RBRACE ? -1 : 0;
+        if ( depth < 0 )
+        {
+            return false;
+        }
+    }
+    return depth == 0;
+}
+
+/**
+ * Parses a range of tokens, and returns the resulting top-level nodes.
+ */
+static std::vector<Node *> parseTokens(stride::StrideFile &file, std::vector<token_t> &tokens,
+                                       size_t first, size_t count)
+{
+    Node container;
+    if ( count > 0 )
+    {
+        TokenSet tokenSet(&tokens, &file);
+        TokenSet *subset = tokenSet.subset((int) first, (int) count);
+        parser::parse(*subset, container);
+        delete subset;
+    }
+
+    // Detach the nodes, as the container deletes its children when it goes out of scope.
+    std::vector<Node *> nodes = container.getChildren();
+    container.replaceChildren(0, nodes.size(), {});
+    return nodes;
+}
+
+/**
+ * Replaces all tokens and top-level declarations of a file.
+ * The content of the file must already be updated.
+ */
+static ReparseResult reparseFully(stride::StrideFile &file, Node &root, std::vector<token_t> &tokens,
+                                  int oldContentSize)
+{
+    int newContentSize = (int) file.getContent().size();
+    file.diagnostics().applyEdit(0, oldContentSize + 1, newContentSize - oldContentSize);
+
+    freeTokens(tokens, 0, tokens.size());
+    std::vector<token_t> *newTokens = stride::tokenizeRange(&file, 0, newContentSize);
+    tokens = std::move(*newTokens);
+    delete newTokens;
+
+    ReparseResult result;
+    result.container = &root;
+    result.firstChild = 0;
+    result.removedNodes = root.getChildren();
+    result.insertedNodes = parseTokens(file, tokens, 0, tokens.size());
+    result.regionStart = 0;
+    result.regionEnd = newContentSize;
+    result.fullReparse = true;
+
+    root.replaceChildren(0, root.getChildCount(), result.insertedNodes);
+    return result;
+}
+
+ReparseResult stride::ast::incremental::reparse(StrideFile &file, Node &root, std::vector<token_t> &tokens,
+                                                const TextEdit &edit)
+{
+    const std::string &content = file.getContent();
+    auto oldContentSize = (int) content.size();
+    int editEnd = edit.start + edit.removedLength;
+    int delta = (int) edit.insertedText.size() - edit.removedLength;
+
+    // Descend into the smallest block that strictly contains the edit.
+    Node *container = &root;
+    int contentStart = 0;
+    int contentEnd = oldContentSize;
+    size_t first, last;
+    bool confined = true;
+
+    while ( true )
+    {
+        first = container->getChildCount();
+        last = 0;
+        for ( size_t i = 0; i < container->getChildCount(); i++ )
+        {
+            Node *child = container->getChild(i);
+            if ( !child->hasSourceRange())
+            {
+                confined = false;
+                break;
+            }
+            if ( affects(child, edit, content))
+            {
+                first = std::min(first, i);
+                last = i + 1;
+            }
+        }
+        if ( !confined || last != first + 1 )
+        {
+            break;
+        }
+
+        Node *block = findEnclosingBlock(container->getChild(first), edit);
+        if ( block == nullptr )
+        {
+            break;
+        }
+        container = block;
+        contentStart = block->getSourceStart() + 1;
+        contentEnd = block->getSourceEnd() - 1;
+    }
+
+    // If no child is affected, the edit is located in between two children.
+    if ( confined && first > last )
+    {
+        first = 0;
+        while ( first < container->getChildCount() && container->getChild(first)->getSourceEnd() <= edit.start )
+        {
+            first++;
+        }
+        last = first;
+    }
+
+    // The region spans from the end of the last unaffected child before the edit,
+    // to the start of the first unaffected child after it.
+    int regionStart = first > 0 ? container->getChild(first - 1)->getSourceEnd() : contentStart;
+    int regionEnd = last < container->getChildCount() ? container->getChild(last)->getSourceStart() : contentEnd;
+
+    file.replaceContent(edit.start, edit.removedLength, edit.insertedText);
+
+    // Drop the diagnostics of the region before tokenizing it, as the tokenizer reports new ones.
+    file.diagnostics().applyEdit(regionStart, regionEnd, delta);
+
+    if ( !confined || regionStart > edit.start || regionEnd < editEnd )
+    {
+        return reparseFully(file, root, tokens, oldContentSize);
+    }
+
+    // Tokenize the region. If its last token extends past the region, e.g. because
+    // the edit opened a string literal, the edit isn't confined to the region.
+    // Neither is it if the braces of the region don't pair up, as that changes
+    // which blocks the nodes after the region belong to.
+    std::vector<token_t> *regionTokens = tokenizeRange(&file, regionStart, regionEnd + delta);
+    bool extendsPastRegion = !regionTokens->empty() &&
+                             regionTokens->back().index + (int) strlen(regionTokens->back().value) > regionEnd + delta;
+    if ( extendsPastRegion || !bracesBalanced(*regionTokens))
+    {
+        freeTokens(*regionTokens, 0, regionTokens->size());
+        delete regionTokens;
+        return reparseFully(file, root, tokens, oldContentSize);
+    }
+
+    // Replace the tokens of the region, and move the tokens after it.
+    auto byIndex = [](const token_t &token, int index) { return token.index < index; };
+    auto tokenFirst = (size_t) ( std::lower_bound(tokens.begin(), tokens.end(), regionStart, byIndex) - tokens.begin());
+    auto tokenLast = (size_t) ( std::lower_bound(tokens.begin(), tokens.end(), regionEnd, byIndex) - tokens.begin());
+
+    freeTokens(tokens, tokenFirst, tokenLast);
+    tokens.erase(tokens.begin() + (long) tokenFirst, tokens.begin() + (long) tokenLast);
+    tokens.insert(tokens.begin() + (long) tokenFirst, regionTokens->begin(), regionTokens->end());
+    for ( size_t i = tokenFirst + regionTokens->size(); i < tokens.size(); i++ )
+    {
+        tokens[ i ].index += delta;
+    }
+    size_t regionTokenCount = regionTokens->size();
+    delete regionTokens;
+
+    ReparseResult result;
+    result.container = container;
+    result.firstChild = first;
+    result.regionStart = regionStart;
+    result.regionEnd = regionEnd + delta;
+    result.fullReparse = false;
+    for ( size_t i = first; i < last; i++ )
+    {
+        result.removedNodes.push_back(container->getChild(i));
+    }
+    result.insertedNodes = parseTokens(file, tokens, tokenFirst, regionTokenCount);
+    container->replaceChildren(first, last - first, result.insertedNodes);
+
+    // Move the source ranges of all reused nodes after the region. Subtrees that
+    // end before the region are unaffected, and new nodes already have the right range.
+    std::unordered_set<Node *> inserted(result.insertedNodes.begin(), result.insertedNodes.end());
+    walk(&root, [ & ](Node *node)
+    {
+        if ( inserted.count(node))
+        {
+            return false;
+        }
+        if ( !node->hasSourceRange())
+        {
+            return true;
+        }
+        if ( node->getSourceEnd() <= regionStart )
+        {
+            return false;
+        }
+
+        int start = node->getSourceStart();
+        node->setSourceRange(start >= regionEnd ? start + delta : start, node->getSourceEnd() + delta);
+        return true;
+    });
+
+    return result;
+}
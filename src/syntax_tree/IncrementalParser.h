@@ -0,0 +1,92 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_INCREMENTALPARSER_H
+#define STRIDE_LANGUAGE_INCREMENTALPARSER_H
+
+#include <string>
+#include <vector>
+#include "ASTNodes.h"
+#include "../tokens/token.h"
+
+namespace stride::ast::incremental
+{
+
+    /**
+     * A single change to the content of a source file.
+     * Indices refer to the content before the edit.
+     */
+    struct TextEdit
+    {
+        int start;
+        int removedLength;
+        std::string insertedText;
+    };
+
+    /**
+     * Describes which part of the syntax tree was replaced by a reparse.
+     * All nodes outside of the replaced range keep their identity;
+     * only their source ranges are updated.
+     */
+    struct ReparseResult
+    {
+        /**
+         * The node whose children were replaced; the root of the tree,
+         * or a block in which the edit took place.
+         */
+        Node *container;
+
+        /**
+         * The index of the first replaced child in the container.
+         */
+        size_t firstChild;
+
+        /**
+         * The new children, in order. They're located at <code>firstChild</code>.
+         */
+        std::vector<Node *> insertedNodes;
+
+        /**
+         * The replaced children. These are detached from the tree but not
+         * deleted, so callers can evict them from caches that are keyed on them.
+         */
+        std::vector<Node *> removedNodes;
+
+        /**
+         * The reparsed source range, in the content after the edit.
+         */
+        int regionStart;
+        int regionEnd;
+
+        /**
+         * Whether the edit couldn't be confined, and all top-level
+         * declarations were replaced.
+         */
+        bool fullReparse;
+    };
+
+    /**
+     * Applies an edit to a file and updates its syntax tree and tokens,
+     * reparsing as little as possible.
+     *
+     * The smallest node that contains the edit is looked up first: either the
+     * root of the tree, or a block nested in a declaration or statement.
+     * The children of that node that overlap the edit are replaced by parsing
+     * the source between their unaffected siblings again; every other node is
+     * reused. If the edit can't be confined, e.g. because it opens a string
+     * literal that extends past the affected declarations, or leaves a brace
+     * unmatched, all top-level declarations are reparsed instead. The root node is reused in both cases.
+     *
+     * The diagnostics of the file within the reparsed range are replaced as well.
+     *
+     * @param file The file to edit. Its content is updated.
+     * @param root The root of the syntax tree of the file, before the edit.
+     * @param tokens The tokens of the file, before the edit. These are updated in place.
+     * @param edit The edit to apply.
+     * @throws FatalError if the error limit of the file is exceeded whilst reparsing.
+     */
+    ReparseResult reparse(StrideFile &file, Node &root, std::vector<token_t> &tokens, const TextEdit &edit);
+}
+
+#endif //STRIDE_LANGUAGE_INCREMENTALPARSER_H
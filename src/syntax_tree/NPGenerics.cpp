@@ -19,4 +19,81 @@ void stride::ast::parseGenerics(TokenSet &tokenSet, std::vector<std::string *> &
         }
         tokenSet.consumeRequired(TOKEN_RARROW, "Expected '>' after generic declaration.");
     }
-}
\ No newline at end of file
+}
+std::string stride::ast::parseTypeArguments(TokenSet &tokenSet)
+{
+    if ( !tokenSet.consume(TOKEN_LARROW))
+    {
+        return "";
+    }
+
+    std::string arguments = "<";
+    do
+    {
+        if ( !validateVariableType(tokenSet))
+        {
+            tokenSet.error("Expected type argument.");
+        }
+        if ( arguments.size() > 1 )
+        {
+            arguments.append(",");
+        }
+        if ( tokenSet.canConsume(TOKEN_IDENTIFIER))
+        {
+            std::string *typeName = parseTypeName(tokenSet);
+            arguments.append(*typeName);
+            delete typeName;
+        }
+        else
+        {
+            arguments.append(tokenSet.next().value);
+        }
+        if ( tokenSet.consume(TOKEN_LSQUARE_BRACKET))
+        {
+            tokenSet.consumeRequired(TOKEN_RSQUARE_BRACKET, "Expected ']' after '[' in type argument.");
+            arguments.append("[]");
+        }
+    } while ( tokenSet.consume(TOKEN_COMMA));
+    tokenSet.consumeRequired(TOKEN_RARROW, "Expected '>' after type arguments.");
+    return arguments + ">";
+}
+
+std::string *stride::ast::parseTypeName(TokenSet &tokenSet)
+{
+    NIdentifier *identifier = parseIdentifier(tokenSet);
+    auto *typeName = new std::string(std::move(identifier->name));
+    delete identifier;
+    typeName->append(parseTypeArguments(tokenSet));
+    return typeName;
+}
+
+std::string stride::ast::splitTypeArguments(const std::string &typeName, std::vector<std::string> &argumentsDst)
+{
+    size_t open = typeName.find('<');
+    if ( open == std::string::npos )
+    {
+        return typeName;
+    }
+
+    // Arguments are separated by the commas that aren't nested in the arguments of another type.
+    size_t depth = 0;
+    size_t start = open + 1;
+    for ( size_t i = start; i < typeName.size(); i++ )
+    {
+        char character = typeName[ i ];
+        if ( character == '<' )
+        {
+            depth++;
+        }
+        else if ( character == '>' && depth > 0 )
+        {
+            depth--;
+        }
+        else if ( depth == 0 && ( character == ',' || character == '>' ))
+        {
+            argumentsDst.push_back(typeName.substr(start, i - start));
+            start = i + 1;
+        }
+    }
+    return typeName.substr(0, open);
+}
@@ -20,4 +20,23 @@ NIdentifier *stride::ast::parseIdentifier(TokenSet &tokenSet)
         identifierName.append("__").append(next_token.value);
     } while ( tokenSet.consume(TOKEN_DOUBLE_COLON));
     return new NIdentifier(identifierName);
-}
\ No newline at end of file
+}
+
+std::vector<std::string> stride::ast::splitIdentifier(const std::string &name)
+{
+    if ( name.compare(0, 2, "__") != 0 )
+    {
+        return { name };
+    }
+
+    std::vector<std::string> segments;
+    size_t start = 2;
+    size_t separator;
+    while (( separator = name.find("__", start)) != std::string::npos )
+    {
+        segments.push_back(name.substr(start, separator - start));
+        start = separator + 2;
+    }
+    segments.push_back(name.substr(start));
+    return segments;
+}
@@ -3,49 +3,29 @@
 //
 
 #include "NodeProperties.h"
+#include "../tokens/TokenTraits.h"
 
 bool stride::ast::validateLiteralValue(TokenSet &tokenSet)
 {
-    token_type_t type = tokenSet.current().type;
-    switch ( type )
-    {
-        case TOKEN_BOOLEAN_LITERAL:
-        case TOKEN_STRING_LITERAL:
-        case TOKEN_CHAR_LITERAL:
-        case TOKEN_NUMBER_INTEGER:
-        case TOKEN_NUMBER_FLOAT:
-            return true;
-        default:
-            return false;
-    }
+    return token_is_literal(tokenSet.current().type);
 }
 
 bool stride::ast::validateVariableType(TokenSet &tokenSet)
 {
     token_type_t type = tokenSet.current().type;
-    switch ( type )
+    return type == TOKEN_IDENTIFIER || token_is_primitive(type);
+}
+bool stride::ast::parseLayoutModifier(TokenSet &tokenSet)
+{
+    if ( !tokenSet.canConsume(TOKEN_IDENTIFIER) || strcmp(tokenSet.current().value, "soa") != 0 )
     {
-        case TOKEN_IDENTIFIER:
-
-        case TOKEN_PRIMITIVE_UINT8:
-        case TOKEN_PRIMITIVE_UINT16:
-        case TOKEN_PRIMITIVE_UINT32:
-        case TOKEN_PRIMITIVE_UINT64:
-
-        case TOKEN_PRIMITIVE_INT8:
-        case TOKEN_PRIMITIVE_INT16:
-        case TOKEN_PRIMITIVE_INT32:
-        case TOKEN_PRIMITIVE_INT64:
-
-        case TOKEN_PRIMITIVE_FLOAT32:
-        case TOKEN_PRIMITIVE_FLOAT64:
-
-        case TOKEN_PRIMITIVE_AUTO:
-        case TOKEN_PRIMITIVE_VOID:
-        case TOKEN_PRIMITIVE_BOOL:
-        case TOKEN_PRIMITIVE_CHAR:
-            return true;
-        default:
-            return false;
+        return false;
     }
-}
\ No newline at end of file
+    token_type_t next = tokenSet.peek(1).type;
+    if ( next != TOKEN_IDENTIFIER && !token_is_primitive(next))
+    {
+        return false;
+    }
+    tokenSet.next();
+    return true;
+}
@@ -21,6 +21,29 @@ namespace stride::ast
      */
     void parseGenerics(TokenSet &tokenSet, std::vector<std::string *> &genericsDst);
 
+    /**
+     * Parses the type arguments of a generic type, e.g. <code>&lt;i32, Vector&lt;u8&gt; &gt;</code>.
+     * The arguments are returned as they're stored in type names: primitives by their
+     * keyword and named types by their internal name, e.g. <code>&lt;i32,__Vector&lt;u8&gt;&gt;</code>.
+     * Nested argument lists must be closed with separate '>' tokens, since '>>' is a shift.
+     * @return The arguments, or an empty string if no arguments follow.
+     */
+    std::string parseTypeArguments(TokenSet &tokenSet);
+
+    /**
+     * Parses a named type; an identifier (sequence) optionally followed by type arguments.
+     * @return The internal name of the type, including its arguments.
+     */
+    std::string *parseTypeName(TokenSet &tokenSet);
+
+    /**
+     * Splits the type arguments off a type name, as generated by <code>parseTypeName</code>.
+     * The name <code>__Map&lt;i32,__Vector&lt;u8&gt;&gt;</code> results in <code>__Map</code>,
+     * with the arguments <code>{ "i32", "__Vector&lt;u8&gt;" }</code>.
+     * @return The type name without its arguments.
+     */
+    std::string splitTypeArguments(const std::string &typeName, std::vector<std::string> &argumentsDst);
+
     /**
      * Parses a sequence of identifiers and converts it to an internal name.
      * An example of this is as followed: <br /> <br />
@@ -35,6 +58,15 @@ namespace stride::ast
      */
     NIdentifier *parseIdentifier(TokenSet &tokenSet);
 
+    /**
+     * Splits an internal name, as generated by <code>parseIdentifier</code>, into its segments.
+     * The name <code>__modulename__classname</code> results in <code>{ "modulename", "classname" }</code>.
+     * Names that aren't mangled result in a single segment.
+     * As with the internal names themselves, an identifier that contains a double
+     * underscore can't be told apart from a path.
+     */
+    std::vector<std::string> splitIdentifier(const std::string &name);
+
 
     /**
      * Validates whether the next token in the token set is a valid variable type.
@@ -46,6 +78,13 @@ namespace stride::ast
      */
     bool validateVariableType(TokenSet &tokenSet);
 
+    /**
+     * Consumes the 'soa' layout modifier of an array type, e.g. <code>let points: soa Point[];</code>
+     * 'soa' isn't reserved; it's only a modifier when it's followed by a type.
+     * @return Whether the modifier was present.
+     */
+    bool parseLayoutModifier(TokenSet &tokenSet);
+
     /**
      * Validates whether the next token in the token set is a valid literal value.
      * These values can be used in variable declarations, function parameters, etc.
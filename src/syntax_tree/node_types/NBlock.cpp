@@ -13,12 +13,14 @@ TokenSet *NBlock::captureRaw(TokenSet &set)
 NBlock *NBlock::capture(TokenSet &set)
 {
     auto block = new NBlock();
+    int sourceStart = set.current().index;
     auto subset = NBlock::captureRaw(set);
     if (subset->size() == 0)
     {
         delete block;
         return nullptr;
     }
+    block->setSourceRange(sourceStart, set.peek(-1).index + 1);
     stride::ast::parser::parse(*subset, *block);
     return block;
 }
\ No newline at end of file
@@ -52,7 +52,10 @@ void NClassDeclaration::parse(TokenSet &tokens, Node &parent)
     {
         do
         {
-            nstClassDecl->addParent(stride::ast::parseIdentifier(tokens));
+            // The type arguments of a parent are kept in its name, e.g. '__First<i8,i32>'.
+            NIdentifier *parentClass = stride::ast::parseIdentifier(tokens);
+            parentClass->name.append(stride::ast::parseTypeArguments(tokens));
+            nstClassDecl->addParent(parentClass);
         } while ( tokens.consume(TOKEN_KEYWORD_AND));
     }
 
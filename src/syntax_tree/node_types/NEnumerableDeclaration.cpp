@@ -10,43 +10,47 @@ void NEnumerableDeclaration::parse(TokenSet &tokenSet, Node &parent)
 {
     tokenSet.consumeRequired(TOKEN_KEYWORD_ENUM, "Enumerable declaration requires 'enum' keyword.");
 
+    auto nstEnumDecl = new NEnumerableDeclaration();
+    nstEnumDecl->setName(tokenSet.consumeRequired(TOKEN_IDENTIFIER, "Enumerable declaration requires a name.").value);
+
     auto enumSubSet = stride::ast::captureBlock(tokenSet, TOKEN_LBRACE, TOKEN_RBRACE);
 
     if ( enumSubSet == nullptr )
     {
+        delete nstEnumDecl;
         tokenSet.error("Enumerable requires opening and closing brackets after declaration.");
         return;
     }
 
-    auto nstEnumDecl = new NEnumerableDeclaration();
-
     int enumMemberId = 0;
 
     do
     {
-        token_t identifier = tokenSet.consumeRequired(TOKEN_IDENTIFIER,
-                                                      "Enumerable member declaration requires identifier.");
+        token_t identifier = enumSubSet->consumeRequired(TOKEN_IDENTIFIER,
+                                                         "Enumerable member declaration requires identifier.");
         // If enum member has assignment, the value must be of integer type.
-        if ( tokenSet.consume(TOKEN_EQUALS))
+        if ( enumSubSet->consume(TOKEN_EQUALS))
         {
-            token_t value = tokenSet.consumeRequired(TOKEN_NUMBER_INTEGER,
-                                                     "Enumerable member value declaration must be of integer type.");
+            token_t value = enumSubSet->consumeRequired(TOKEN_NUMBER_INTEGER,
+                                                        "Enumerable member value declaration must be of integer type.");
             enumMemberId = atoi(value.value);
         }
 
         nstEnumDecl->addValue(identifier.value, enumMemberId++);
 
-        tokenSet.consumeRequired(TOKEN_SEMICOLON, "Enumerable members must be ");
-
     } while ( enumSubSet->consume(TOKEN_COMMA));
 
+    // The last member may be terminated by a semicolon.
+    enumSubSet->consume(TOKEN_SEMICOLON);
+
     // Since all members must have been processed, there's not supposed
     // to be any tokens remaining in the subset.
     if ( enumSubSet->hasNext())
     {
-        tokenSet.error("Illegal trailing token.");
-        return;
+        delete nstEnumDecl;
+        enumSubSet->error("Illegal trailing token.");
     }
+    delete enumSubSet;
 
     parent.addChild(nstEnumDecl);
-}
\ No newline at end of file
+}
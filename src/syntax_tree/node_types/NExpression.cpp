@@ -6,154 +6,72 @@
 #include "definitions/NExpression.h"
 #include "../Lookahead.h"
 #include "../NodeProperties.h"
+#include "definitions/NArray.h"
+#include "definitions/NBinaryOperation.h"
 #include "definitions/NFunctionCall.h"
-#include <queue>
+#include "definitions/NIdentifier.h"
+#include "definitions/NLiteral.h"
+#include "definitions/NUnaryOperator.h"
+#include "../../tokens/TokenTraits.h"
 
-bool isValidExpressionToken(TokenSet &set)
-{
-    switch ( set.current().type )
-    {
-        case TOKEN_KEYWORD_NULL:
-        case TOKEN_COMMA:
-        case TOKEN_IDENTIFIER:
-        case TOKEN_STRING_LITERAL:
-        case TOKEN_NUMBER_INTEGER:
-        case TOKEN_NUMBER_FLOAT:
-        case TOKEN_BOOLEAN_LITERAL:
-        case TOKEN_CHAR_LITERAL:
-        case TOKEN_LPAREN:
-        case TOKEN_RPAREN:
-        case TOKEN_LSQUARE_BRACKET:
-        case TOKEN_RSQUARE_BRACKET:
-        case TOKEN_STAR:
-        case TOKEN_SLASH:
-        case TOKEN_PLUS:
-        case TOKEN_MINUS:
-        case TOKEN_QUESTION:
-        case TOKEN_COLON:
-        case TOKEN_DOUBLE_STAR:
-        case TOKEN_DOUBLE_RARROW:
-        case TOKEN_DOUBLE_LARROW:
-        case TOKEN_DOUBLE_PIPE:
-        case TOKEN_DOUBLE_AMPERSAND:
-        case TOKEN_CARET:
-        case TOKEN_AMPERSAND:
-        case TOKEN_TILDE:
-        case TOKEN_PIPE:
-        case TOKEN_BANG:
-        case TOKEN_PERCENT:
-        case TOKEN_STAR_EQUALS:
-        case TOKEN_SLASH_EQUALS:
-        case TOKEN_PLUS_EQUALS:
-        case TOKEN_MINUS_EQUALS:
-        case TOKEN_AMPERSAND_EQUALS:
-        case TOKEN_PERCENT_EQUALS:
-        case TOKEN_BANG_EQUALS:
-        case TOKEN_PIPE_EQUALS:
-        case TOKEN_TILDE_EQUALS:
-        case TOKEN_DOUBLE_LARROW_EQUALS:
-        case TOKEN_DOUBLE_RARROW_EQUALS:
-        case TOKEN_DOUBLE_STAR_EQUALS:
-        case TOKEN_CARET_EQUALS:
-        case TOKEN_DOUBLE_PLUS:
-        case TOKEN_DOUBLE_MINUS:
-        case TOKEN_LARROW:
-        case TOKEN_RARROW:
-        case TOKEN_LEQUALS:
-        case TOKEN_GEQUALS:
-        case TOKEN_DOUBLE_EQUALS:
-        case TOKEN_NOT_EQUALS:
-        case TOKEN_EQUALS:
-            return true;
-        default:
-            return false;
-    }
-}
+/**
+ * Precedence of prefix operators. These bind tighter than all binary
+ * operators except exponentiation, so -a ** b is parsed as -(a ** b).
+ */
+#define PREFIX_PRECEDENCE 60
 
+static NExpression *parseBinary(TokenSet &tokenSet, int minimumPrecedence);
 
-#define ASSOCIATIVITY_NONE      (0)
-#define ASSOCIATIVITY_LEFT      (1)
-#define ASSOCIATIVITY_RIGHT     (2)
-#define ASSOCIATIVITY_OPTIONAL  (4) // Meaning the associativity is optional
+/**
+ * Assigns the source range of a node, from the provided token
+ * up to and including the last consumed token.
+ */
+static void setRangeFrom(stride::ast::Node *node, const token_t &first, TokenSet &tokenSet)
+{
+    token_t last = tokenSet.peek(-1);
+    node->setSourceRange(first.index, last.index + (int) strlen(last.value));
+}
 
 /**
- * A segment of an expression.
+ * Whether the token is a number with a sign, e.g. '-1'.
+ * The tokenizer includes the sign in numbers, so 'a -1' doesn't contain
+ * a separate operator token.
  */
-struct expression_segment_t
+static bool isSignedNumber(const token_t &token)
 {
+    return ( token.type == TOKEN_NUMBER_INTEGER || token.type == TOKEN_NUMBER_FLOAT ) &&
+           ( token.value[ 0 ] == '-' || token.value[ 0 ] == '+' );
+}
 
-    /**
-     * The associativity of the operator.
-     * This determines whether it is required for a variable (keyword)
-     * to be on the left or right side of the operator, both or neither.
-     */
-    int associativity;
-
-    /**
-     * The precedence of the operator.
-     * This is used to determine the order of operations.
-     */
-    int precedence;
-};
-
-const std::map<token_type_t, struct expression_segment_t> tokenPrecedenceMap = {
-        /* High precedence operators */
-        { TOKEN_STAR,                 { .associativity = ASSOCIATIVITY_LEFT, .precedence = 50 }}, // *
-        { TOKEN_SLASH,                { .associativity = ASSOCIATIVITY_LEFT, .precedence = 50 }}, // /
-        { TOKEN_PLUS,                 { .associativity = ASSOCIATIVITY_LEFT | ASSOCIATIVITY_RIGHT | ASSOCIATIVITY_OPTIONAL, .precedence = 45,  }}, // + (unary and binary)
-        { TOKEN_MINUS,                { .associativity = ASSOCIATIVITY_LEFT | ASSOCIATIVITY_RIGHT | ASSOCIATIVITY_OPTIONAL, .precedence = 45,  }}, // - (unary and binary)
-        { TOKEN_PERCENT,              { .associativity = ASSOCIATIVITY_LEFT, .precedence = 40 }}, // %
-        { TOKEN_DOUBLE_STAR,          { .associativity = ASSOCIATIVITY_LEFT, .precedence = 40 }}, // **
-        
-        /* Bitwise operators */
-        { TOKEN_DOUBLE_RARROW,        { .associativity = ASSOCIATIVITY_LEFT, .precedence = 30 }}, // >>
-        { TOKEN_DOUBLE_LARROW,        { .associativity = ASSOCIATIVITY_LEFT, .precedence = 30 }}, // <<
-        { TOKEN_DOUBLE_PIPE,          { .associativity = ASSOCIATIVITY_LEFT, .precedence = 30 }}, // ||
-        { TOKEN_DOUBLE_AMPERSAND,     { .associativity = ASSOCIATIVITY_LEFT, .precedence = 30 }}, // &&
-        { TOKEN_CARET,                { .associativity = ASSOCIATIVITY_LEFT, .precedence = 30 }}, // ^
-        { TOKEN_AMPERSAND,            { .associativity = ASSOCIATIVITY_LEFT, .precedence = 30 }}, // &
-        { TOKEN_TILDE,                { .associativity = ASSOCIATIVITY_LEFT, .precedence = 30 }}, // ~
-        { TOKEN_PIPE,                 { .associativity = ASSOCIATIVITY_LEFT, .precedence = 30 }}, // |
-        { TOKEN_BANG,                 { .associativity = ASSOCIATIVITY_LEFT, .precedence = 30 }}, // !
-        { TOKEN_PERCENT,              { .associativity = ASSOCIATIVITY_LEFT, .precedence = 30 }}, // %
-
-        /* Left associative operators */
-        { TOKEN_STAR_EQUALS,          { .associativity = ASSOCIATIVITY_LEFT, .precedence = 50 }},  // *=
-        { TOKEN_SLASH_EQUALS,         { .associativity = ASSOCIATIVITY_LEFT, .precedence = 50 }},  // /=
-        { TOKEN_PLUS_EQUALS,          { .associativity = ASSOCIATIVITY_LEFT, .precedence = 45 }},  // +=
-        { TOKEN_MINUS_EQUALS,         { .associativity = ASSOCIATIVITY_LEFT, .precedence = 45 }},  // -=
-        { TOKEN_AMPERSAND_EQUALS,     { .associativity = ASSOCIATIVITY_LEFT, .precedence = 45 }},  // &=
-        { TOKEN_PERCENT_EQUALS,       { .associativity = ASSOCIATIVITY_LEFT, .precedence = 45 }},  // %=
-        { TOKEN_BANG_EQUALS,          { .associativity = ASSOCIATIVITY_LEFT, .precedence = 45 }},  // !=
-        { TOKEN_PIPE_EQUALS,          { .associativity = ASSOCIATIVITY_LEFT, .precedence = 45 }},  // |=
-        { TOKEN_TILDE_EQUALS,         { .associativity = ASSOCIATIVITY_LEFT, .precedence = 45 }},  // ~=
-        { TOKEN_DOUBLE_LARROW_EQUALS, { .associativity = ASSOCIATIVITY_LEFT, .precedence = 45 }},  // <<=
-        { TOKEN_DOUBLE_RARROW_EQUALS, { .associativity = ASSOCIATIVITY_LEFT, .precedence = 45 }},  // >>=
-        { TOKEN_DOUBLE_STAR_EQUALS,   { .associativity = ASSOCIATIVITY_LEFT, .precedence = 50 }},  // **=
-        { TOKEN_CARET_EQUALS,         { .associativity = ASSOCIATIVITY_LEFT, .precedence = 45 }},  //  ^=
-
-        { TOKEN_DOUBLE_PLUS,   { .associativity = ASSOCIATIVITY_LEFT |
-                                                  ASSOCIATIVITY_RIGHT, .precedence = 55 }}, // ++
-        { TOKEN_DOUBLE_MINUS,  { .associativity = ASSOCIATIVITY_LEFT |
-                                                  ASSOCIATIVITY_RIGHT, .precedence = 55 }}, // --
-
-        /* Comparison operators */
-        { TOKEN_LARROW,        { .associativity = ASSOCIATIVITY_NONE, .precedence = 10 }}, // <
-        { TOKEN_RARROW,        { .associativity = ASSOCIATIVITY_NONE, .precedence = 10 }}, // >
-        { TOKEN_LEQUALS,       { .associativity = ASSOCIATIVITY_NONE, .precedence = 10 }}, // <=
-        { TOKEN_GEQUALS,       { .associativity = ASSOCIATIVITY_NONE, .precedence = 10 }}, // >=
-        { TOKEN_DOUBLE_EQUALS, { .associativity = ASSOCIATIVITY_NONE, .precedence = 10 }}, // ==
-        { TOKEN_NOT_EQUALS,    { .associativity = ASSOCIATIVITY_NONE, .precedence = 10 }}, // !=
-        { TOKEN_EQUALS,        { .associativity = ASSOCIATIVITY_NONE, .precedence = 10 }}, // = (assignment)
-};
+/**
+ * Returns the binary operator token at the current position, if there is one.
+ * Signed numbers are treated as an addition or subtraction.
+ */
+static bool currentOperator(TokenSet &tokenSet, token_type_t *operatorToken)
+{
+    if ( tokenSet.end())
+    {
+        return false;
+    }
+    token_t token = tokenSet.current();
+    if ( isSignedNumber(token))
+    {
+        *operatorToken = token.value[ 0 ] == '-' ? TOKEN_MINUS : TOKEN_PLUS;
+        return true;
+    }
+    *operatorToken = token.type;
+    return token_is_operator(token.type);
+}
 
 /**
  * Parses an identifier.
  * This function can parse both regular identifiers and function calls.
  * @param tokenSet The token set to parse.
  */
-stride::ast::Node *parseIdentifier(TokenSet &tokenSet)
+static NExpression *parseIdentifier(TokenSet &tokenSet)
 {
+    token_t first = tokenSet.current();
+
     // Parses an identifier; accepts nested::identifiers
     auto identifier = stride::ast::parseIdentifier(tokenSet);
 
@@ -161,219 +79,253 @@ stride::ast::Node *parseIdentifier(TokenSet &tokenSet)
     {
         auto argumentsSubset = stride::ast::captureBlock(tokenSet, TOKEN_LPAREN, TOKEN_RPAREN);
 
-        printf("[NExpression] Parsing function call.\n");
         auto *functionCall = new NFunctionCall();
-        functionCall->functionName = &identifier->name;
+        functionCall->functionName = new std::string(identifier->name);
+        delete identifier;
 
-        if ( argumentsSubset->size() > 0 )
+        while ( !argumentsSubset->end())
         {
-            printf("[NExpression] Parsing function call argument, next token: %s.\n", argumentsSubset->current().value);
-            do
+            functionCall->addArgument(parseBinary(*argumentsSubset, 0));
+            if ( !argumentsSubset->consume(TOKEN_COMMA) && !argumentsSubset->end())
             {
-                printf("[NExpression] Parsing function call argument.\n");
-                functionCall->addChild(NExpression::parse(*argumentsSubset, false));
-
-            } while ( !argumentsSubset->end() && argumentsSubset->hasNext());
+                argumentsSubset->error("Expected comma between function call arguments.");
+            }
         }
+        delete argumentsSubset;
+
+        setRangeFrom(functionCall, first, tokenSet);
         return functionCall;
     }
+    setRangeFrom(identifier, first, tokenSet);
     return identifier;
 }
 
-NExpression *NExpression::parse(TokenSet &tokenSet, bool explicitExpression)
+/**
+ * Parses the tokens within a pair of brackets as a complete expression.
+ */
+static NExpression *parseParenthesized(TokenSet &tokenSet)
 {
-    auto nstExpression = new NExpression();
+    token_t first = tokenSet.current();
+    auto subset = stride::ast::captureBlock(tokenSet, TOKEN_LPAREN, TOKEN_RPAREN);
+    NExpression *expression = parseBinary(*subset, 0);
+    if ( !subset->end())
+    {
+        subset->error("Unexpected token in expression.");
+    }
+    delete subset;
 
-    printf("[NExpression] Parsing expression.\n");
+    // The brackets are part of the expression.
+    setRangeFrom(expression, first, tokenSet);
+    return expression;
+}
 
-    if ( explicitExpression && !tokenSet.canConsume(TOKEN_IDENTIFIER))
+/**
+ * Parses an array, e.g. [1, 2, 3].
+ */
+static NExpression *parseArray(TokenSet &tokenSet)
+{
+    token_t first = tokenSet.current();
+    auto subset = stride::ast::captureBlock(tokenSet, TOKEN_LSQUARE_BRACKET, TOKEN_RSQUARE_BRACKET);
+    auto array = new NArray();
+    while ( !subset->end())
     {
-        tokenSet.error("Explicit expression must either be a function call or variable modification.");
-        return nullptr;
+        array->addElement(parseBinary(*subset, 0));
+        if ( !subset->consume(TOKEN_COMMA) && !subset->end())
+        {
+            subset->error("Expected comma between array elements.");
+        }
     }
+    delete subset;
+    setRangeFrom(array, first, tokenSet);
+    return array;
+}
 
-    int sqBrace = 0,
-            brackets = 0,
-            parens = 0;
+/**
+ * Parses a single operand, including its prefix and postfix operators.
+ */
+static NExpression *parseOperand(TokenSet &tokenSet)
+{
+    if ( tokenSet.end())
+    {
+        tokenSet.error("Expected expression.");
+    }
 
-    // Queues for shunting yard.
-    std::queue<token_t> operatorQueue;
-    std::queue<token_t> literalQueue;
+    token_t first = tokenSet.current();
+    NExpression *operand;
 
-    while ( !tokenSet.end())
+    switch ( first.type )
     {
-        printf("[NExpression] Parsing expression token: %s.\n", tokenSet.current().value);
-
-        if (( tokenSet.consume(TOKEN_SEMICOLON) ||
-              ( tokenSet.consume(TOKEN_COMMA)) && !parens && !sqBrace && !brackets ))
-        {
-            printf("[NExpression] Expression parsing complete.\n");
+        case TOKEN_LPAREN:
+            operand = parseParenthesized(tokenSet);
             break;
-        }
-
-        if ( !isValidExpressionToken(tokenSet))
+        case TOKEN_LSQUARE_BRACKET:
+            operand = parseArray(tokenSet);
+            break;
+        case TOKEN_IDENTIFIER:
+            operand = parseIdentifier(tokenSet);
+            break;
+        case TOKEN_KEYWORD_NULL:
+            tokenSet.next();
+            operand = new NIdentifier(first.value);
+            setRangeFrom(operand, first, tokenSet);
+            break;
+        case TOKEN_MINUS:
+        case TOKEN_PLUS:
         {
-            tokenSet.error("Invalid token in expression.");
-            return nullptr;
-        }
-
+            tokenSet.next();
+            NExpression *value = parseBinary(tokenSet, PREFIX_PRECEDENCE);
+            if ( first.type == TOKEN_PLUS )
+            {
+                return value;
+            }
 
-        switch ( tokenSet.current().type )
+            // Arithmetic negation is represented as a subtraction from zero.
+            auto zero = new NLiteral((int64_t) 0);
+            zero->setSourceRange(first.index, first.index + 1);
+            operand = new NBinaryOperation(zero, SUBTRACT, value);
+            setRangeFrom(operand, first, tokenSet);
+            return operand;
+        }
+        case TOKEN_BANG:
+        case TOKEN_TILDE:
+        case TOKEN_DOUBLE_PLUS:
+        case TOKEN_DOUBLE_MINUS:
         {
-            case TOKEN_IDENTIFIER:
-                nstExpression->addChild(parseIdentifier(tokenSet));
-                break;
-            case TOKEN_LPAREN:
-                parens++;
-                break;
-            case TOKEN_RPAREN:
-                parens--;
-                break;
-            case TOKEN_LSQUARE_BRACKET:
-                sqBrace++;
-                break;
-            case TOKEN_RSQUARE_BRACKET:
-                sqBrace--;
-                break;
-            case TOKEN_LBRACE:
-                brackets++;
-                break;
-            case TOKEN_RBRACE:
-                brackets--;
-                break;
-            case TOKEN_BOOLEAN_LITERAL:
-            case TOKEN_STRING_LITERAL:
-            case TOKEN_CHAR_LITERAL:
-            case TOKEN_NUMBER_INTEGER:
-            case TOKEN_NUMBER_FLOAT:
-            default:
-                break;
+            tokenSet.next();
+            EUnaryOperator operation = first.type == TOKEN_BANG ? NEGATE :
+                                       first.type == TOKEN_TILDE ? BITWISE_NOT :
+                                       first.type == TOKEN_DOUBLE_PLUS ? INCREMENT_LHS : DECREMENT_LHS;
+            operand = new NUnaryOperator(operation, std::unique_ptr<NExpression>(
+                    parseBinary(tokenSet, PREFIX_PRECEDENCE)));
+            setRangeFrom(operand, first, tokenSet);
+            return operand;
         }
-
-        if (!tokenSet.hasNext())
+        default:
+            if ( !token_is_literal(first.type))
+            {
+                tokenSet.error("Invalid token in expression.");
+            }
+            operand = new NLiteral(tokenSet.next());
+            setRangeFrom(operand, first, tokenSet);
             break;
-
-        tokenSet.next();
     }
 
-    tokenSet.consume(TOKEN_SEMICOLON); // If there's a trailing token remaining, eat it up.
-
-    return nstExpression;
-}
-
-void NExpression::parse(TokenSet &tokenSet, Node &parent)
-{
-    parent.addChild(NExpression::parse(tokenSet, true));
+    // Postfix increments and decrements
+    if ( tokenSet.canConsume(TOKEN_DOUBLE_PLUS) || tokenSet.canConsume(TOKEN_DOUBLE_MINUS))
+    {
+        EUnaryOperator operation = tokenSet.next().type == TOKEN_DOUBLE_PLUS ? INCREMENT_RHS : DECREMENT_RHS;
+        operand = new NUnaryOperator(operation, std::unique_ptr<NExpression>(operand));
+        setRangeFrom(operand, first, tokenSet);
+    }
+    return operand;
 }
 
-NExpression *NExpression::captureParenthesis(TokenSet &tokenSet)
+/**
+ * Combines an operand with the binary operations that follow it, by precedence climbing.
+ * Only operators with at least the provided precedence are consumed;
+ * operators that bind tighter are parsed recursively as the right operand.
+ */
+static NExpression *climb(TokenSet &tokenSet, NExpression *left, int minimumPrecedence)
 {
-    auto expressionSubset = stride::ast::captureBlock(tokenSet, TOKEN_LPAREN, TOKEN_RPAREN);
+    token_type_t operatorToken;
 
-    if ( expressionSubset == nullptr )
+    while ( currentOperator(tokenSet, &operatorToken))
     {
-        tokenSet.error("Expected opening and closing brackets after 'while' keyword.");
-        return nullptr;
-    }
+        const token_traits_t &traits = token_traits(operatorToken);
+        if ( traits.precedence < minimumPrecedence )
+        {
+            break;
+        }
 
-    return NExpression::parse(*expressionSubset, false);
-}
+        NExpression *right;
+        if ( isSignedNumber(tokenSet.current()))
+        {
+            // The sign is the operator, the remainder of the number is the operand.
+            token_t number = tokenSet.next();
+            token_t magnitude = number;
+            magnitude.value++;
+            magnitude.index++;
+            right = new NLiteral(magnitude);
+            right->setSourceRange(magnitude.index, number.index + (int) strlen(number.value));
+        }
+        else
+        {
+            tokenSet.next();
+            right = parseOperand(tokenSet);
+        }
 
-bool NExpression::isReducible()
-{
-    // The expression is reducible if it contains a reducible child,
-    // which has to be an expression.
-    for ( auto child: this->getChildren())
-    {
-        if ( child->getType() == stride::ast::EXPRESSION )
+        // Operators that bind tighter than this one belong to the right operand,
+        // as do right associative operators with the same precedence.
+        token_type_t nextToken;
+        while ( currentOperator(tokenSet, &nextToken))
         {
-            if ( dynamic_cast<NExpression *>(child)->isReducible())
+            const token_traits_t &nextTraits = token_traits(nextToken);
+            if ( nextTraits.precedence > traits.precedence )
             {
-                return true;
+                right = climb(tokenSet, right, traits.precedence + 1);
+            }
+            else if ( nextTraits.precedence == traits.precedence &&
+                      traits.associativity == ASSOCIATIVITY_RIGHT )
+            {
+                right = climb(tokenSet, right, traits.precedence);
+            }
+            else
+            {
+                break;
             }
         }
+
+        if ( traits.associativity == ASSOCIATIVITY_NONE && currentOperator(tokenSet, &nextToken) &&
+             token_traits(nextToken).precedence == traits.precedence )
+        {
+            tokenSet.error("Comparison operators can't be chained.");
+        }
+
+        auto operation = new NBinaryOperation(left, NBinaryOperation::fromToken(operatorToken), right);
+        operation->setSourceRange(left->getSourceStart(), right->getSourceEnd());
+        left = operation;
     }
+    return left;
+}
 
-    // The expression is reducible if it has one child that's a literal (value)
-    // or an identifier (variable reference)
-    return this->getChildren().size() == 1 &&
-           ( this->getChildren().at(0)->getType() == stride::ast::LITERAL ||
-             this->getChildren().at(0)->getType() == stride::ast::IDENTIFIER );
+static NExpression *parseBinary(TokenSet &tokenSet, int minimumPrecedence)
+{
+    return climb(tokenSet, parseOperand(tokenSet), minimumPrecedence);
 }
 
-/**
- * Reduction of expressions.
- *
- * A visual example of node reduction is given below: <br />
- *
- *        (reducible)                     (reducible)                 (irreducible)
- *       EXPRESSION (+)                  EXPRESSION (+)
- *      /         \              ->       /       \              ->   LITERAL(num)
- * LITERAL(num) EXPRESSION (*)      LITERAL(num)  LITERAL(num)
- *               /      \
- *       LITERAL(num)   LITERAL(num)
- *
- * Expressions are reducible if one if their children is reducible.
- * In the example given above, we start with an expression composed of another expression and a literal
- * This literal can be reduced, therefore the parent can too. This will recursively continue until the parent node
- * is irreducible, e.g. when the parent node is returned as a literal, or the children are irreducible.
- */
-std::variant<NExpression *, NLiteral *> NExpression::reduce()
+NExpression *NExpression::parse(TokenSet &tokenSet, bool explicitExpression)
 {
-    // If the expression is not reducible, return itself.
-    if ( !isReducible())
+    if ( explicitExpression && !tokenSet.canConsume(TOKEN_IDENTIFIER))
     {
-        return this;
+        tokenSet.error("Explicit expression must either be a function call or variable modification.");
     }
 
-    // If the expression is reducible and has one child that's a literal, convert
-    // the expression to a literal.
-    if ( this->getChildren().size() == 1 )
+    NExpression *expression = parseBinary(tokenSet, 0);
+
+    // Tokens that can't continue the expression, such as the opening brace after
+    // the condition of an if statement, are left to the caller.
+    if ( !tokenSet.end() && token_is_expression(tokenSet.current().type) &&
+         !tokenSet.canConsume(TOKEN_COMMA))
     {
-        switch ( this->getChildren().at(0)->getType())
-        {
-            // If the expression is composed of a single literal child,
-            // we return the child as reduced node.
-            case stride::ast::LITERAL:
-                return dynamic_cast<NLiteral *>(this->getChildren().at(0));
-
-                // If the expression is composed of a single expression child,
-                // we return the reduced child, if it can be reduced.
-            case stride::ast::EXPRESSION:
-                return dynamic_cast<NExpression *>(this->getChildren().at(0))->reduce();
-
-                // If the expression is composed of a single non-literal, non-expression child,
-                // we return the expression itself. This can be the case if the expression is
-                // composed of a single identifier, for example.
-            default:
-                return this;
-        }
+        tokenSet.error("Unexpected token in expression.");
     }
 
-    // If the expression is reducible and has a reducible child, reduce the child.
+    tokenSet.consume(TOKEN_SEMICOLON); // If there's a trailing token remaining, eat it up.
 
-    auto children = this->getChildren();
-    for ( int i = 0; i < children.size(); i++ )
-    {
-        // Skip non-expression entries that aren't reducible.
-        if ( children.at(i)->getType() != stride::ast::EXPRESSION ||
-             !dynamic_cast<NExpression *>(children.at(i))->isReducible())
-        {
-            continue;
-        }
+    return expression;
+}
 
-        // If the expression is reducible, we replace it
-        // with its reduced version.
-        auto expression = dynamic_cast<NExpression *>(children.at(i));
-        if ( expression->isReducible())
-        {
-            auto reduced = expression->reduce();
-            children[ i ] = std::get<NLiteral *>(reduced);
-        }
-    }
-    if ( this->isReducible())
+void NExpression::parse(TokenSet &tokenSet, Node &parent)
+{
+    parent.addChild(NExpression::parse(tokenSet, true));
+}
+
+NExpression *NExpression::captureParenthesis(TokenSet &tokenSet)
+{
+    if ( !tokenSet.canConsume(TOKEN_LPAREN))
     {
-        return reduce();
+        tokenSet.error("Expected opening and closing brackets after 'while' keyword.");
     }
-    return this;
-}
\ No newline at end of file
+
+    return parseParenthesized(tokenSet);
+}
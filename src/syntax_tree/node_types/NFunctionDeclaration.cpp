@@ -50,7 +50,7 @@ void NFunctionDeclaration::parse(TokenSet &tokenSet, Node &parent)
             {
                 tokenSet.error("Double 'external' keyword.");
             }
-            nstFunctionDecl->external = false;
+            nstFunctionDecl->external = true;
         }
         else if ( tokenSet.consume(TOKEN_KEYWORD_ASYNC))
         {
@@ -103,6 +103,8 @@ void NFunctionDeclaration::parse(TokenSet &tokenSet, Node &parent)
             fnParameterSet->consumeRequired(TOKEN_COLON,
                                             "Expected colon after parameter name in function definition.\nThis is required to denote the parameter_type_token of the parameter.");
 
+            nstFnParameter->setSoaLayout(stride::ast::parseLayoutModifier(*fnParameterSet));
+
             // Validate parameter type
             if ( !stride::ast::validateVariableType(*fnParameterSet))
             {
@@ -113,20 +115,22 @@ void NFunctionDeclaration::parse(TokenSet &tokenSet, Node &parent)
             // Otherwise, we'll use the token value as the type.
             nstFnParameter->setVariableType(
                     fnParameterSet->canConsume(TOKEN_IDENTIFIER) ?
-                    std::variant<std::string *, token_type_t>(&stride::ast::parseIdentifier(*fnParameterSet)->name) :
+                    std::variant<std::string *, token_type_t>(stride::ast::parseTypeName(*fnParameterSet)) :
                     std::variant<std::string *, token_type_t>(fnParameterSet->next().type)
             );
 
             // Check if function parameter is of array type.
-            if ( fnParameterSet->consume(TOKEN_LSQUARE_BRACKET) && fnParameterSet->consume(TOKEN_LSQUARE_BRACKET))
+            if ( fnParameterSet->consume(TOKEN_LSQUARE_BRACKET) && fnParameterSet->consume(TOKEN_RSQUARE_BRACKET))
             {
                 nstFnParameter->setIsArray(true);
             }
             else if ( fnParameterSet->consume(TOKEN_THREE_DOTS))
             {
                 nstFnParameter->setIsArray(true);
+                nstFnParameter->setVariadic(true);
                 hasVariadic = true;
             }
+            nstFunctionDecl->addParameter(nstFnParameter);
 
         } while ( fnParameterSet->hasNext() && fnParameterSet->consume(TOKEN_COMMA));
 
@@ -140,6 +144,26 @@ void NFunctionDeclaration::parse(TokenSet &tokenSet, Node &parent)
         }
     }
 
+    // The return type is optional, and is inferred from the return statements if absent.
+    // Primitive types are stored by their keyword, e.g. 'i32'.
+    if ( tokenSet.consume(TOKEN_DASH_RARROW))
+    {
+        if ( !stride::ast::validateVariableType(tokenSet))
+        {
+            tokenSet.error("Expected return type after arrow in function definition.");
+        }
+        if ( tokenSet.canConsume(TOKEN_IDENTIFIER))
+        {
+            std::string *typeName = stride::ast::parseTypeName(tokenSet);
+            nstFunctionDecl->returnType = new NIdentifier(*typeName);
+            delete typeName;
+        }
+        else
+        {
+            nstFunctionDecl->returnType = new NIdentifier(tokenSet.next().value);
+        }
+    }
+
     if ( !nstFunctionDecl->external )
     {
         nstFunctionDecl->body = NBlock::capture(tokenSet);
@@ -19,21 +19,58 @@ NLiteral::NLiteral(token_t token)
             break;
         case TOKEN_NUMBER_INTEGER:
         {
-            int64_t intValue = strtoll(token.value, nullptr, 10);
-            this->value = { value };
-            this->byteCount = intValue & ~INT32_MASK ? 8 :
-                              intValue & ~INT16_MASK ? 4 :
-                              intValue & ~INT8_MASK ? 2 : 1;
+            // Integers may have an exponent, e.g. 1e6.
+            char *exponent;
+            int64_t intValue = strtoll(token.value, &exponent, 10);
+            if ( *exponent == 'e' || *exponent == 'E' )
+            {
+                for ( long i = strtol(exponent + 1, nullptr, 10); i > 0; i-- )
+                {
+                    intValue *= 10;
+                }
+            }
+            int64_t magnitude = intValue < 0 ? ~intValue : intValue;
+            this->value = { intValue };
+            this->byteCount = magnitude & ~INT32_MASK ? 8 :
+                              magnitude & ~INT16_MASK ? 4 :
+                              magnitude & ~INT8_MASK ? 2 : 1;
         }
             break;
         case TOKEN_STRING_LITERAL:
-            byteCount = strlen(token.value);
-            this->value = { token.value };
+        {
+            // The value is copied without its quotes, as the token
+            // is freed when the file is tokenized again.
+            size_t length = strlen(token.value) - 2;
+            char *string = (char *) malloc(length + 1);
+            memcpy(string, token.value + 1, length);
+            string[ length ] = '\0';
+
+            byteCount = (int) length;
+            this->value = { (const char *) string };
+        }
             break;
 
         case TOKEN_CHAR_LITERAL:
+        {
+            char character = token.value[ 1 ];
+            if ( character == '\\' )
+            {
+                switch ( token.value[ 2 ] )
+                {
+                    case 'n': character = '\n'; break;
+                    case 't': character = '\t'; break;
+                    case 'r': character = '\r'; break;
+                    case '0': character = '\0'; break;
+                    default: character = token.value[ 2 ]; break;
+                }
+            }
+            byteCount = 1;
+            this->value = { (int64_t) character };
+        }
+            break;
+        case TOKEN_BOOLEAN_LITERAL:
             byteCount = 1;
-            this->value = { (int8_t) token.value[ 0 ] };
+            this->value = { (int64_t) ( strcmp(token.value, "true") == 0 ) };
             break;
         default:
             throw std::runtime_error("Invalid token type for literal.");
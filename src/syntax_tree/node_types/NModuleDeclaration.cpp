@@ -9,9 +9,16 @@ void NModuleDeclaration::parse(TokenSet &tokenSet, stride::ast::Node &parent)
 {
     tokenSet.consumeRequired(TOKEN_KEYWORD_MODULE, "Module declaration requires 'module' keyword.");
 
-    auto nstModuleDecl = new NModuleDeclaration(
-            tokenSet.consumeRequired(TOKEN_IDENTIFIER, "Module requires identifier after declaration.").value
-            );
+    // Nested modules can be declared at once, e.g. 'module outer::inner'.
+    std::string moduleName = tokenSet.consumeRequired(TOKEN_IDENTIFIER,
+                                                      "Module requires identifier after declaration.").value;
+    while ( tokenSet.consume(TOKEN_DOUBLE_COLON))
+    {
+        moduleName.append("::").append(
+                tokenSet.consumeRequired(TOKEN_IDENTIFIER, "Expected module name after double colon.").value);
+    }
+
+    auto nstModuleDecl = new NModuleDeclaration(moduleName);
 
     nstModuleDecl->body = NBlock::capture(tokenSet);
     parent.addChild(nstModuleDecl);
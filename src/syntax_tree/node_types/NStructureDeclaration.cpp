@@ -9,9 +9,10 @@
 
 void NStructureDeclaration::parse(TokenSet &tokenSet, stride::ast::Node &parent)
 {
-    tokenSet.consumeRequired(TOKEN_KEYWORD_STRUCT, "Structure declaration requires 'struct' keyword.");
-
     auto *nstStructureDecl = new NStructureDeclaration();
+    nstStructureDecl->external = tokenSet.consume(TOKEN_KEYWORD_EXTERNAL);
+
+    tokenSet.consumeRequired(TOKEN_KEYWORD_STRUCT, "Structure declaration requires 'struct' keyword.");
 
     // Consume structure name
     nstStructureDecl->setName(
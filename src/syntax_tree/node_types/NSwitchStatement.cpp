@@ -14,23 +14,36 @@ void NSwitchStatement::parse(TokenSet &tokenSet, stride::ast::Node &parent)
     nstSwitch->expression = NExpression::captureParenthesis(tokenSet);
 
     auto switchBodySet = NBlock::captureRaw(tokenSet);
-    do
+    while ( switchBodySet->hasNext())
     {
-        if ( switchBodySet->consume(TOKEN_KEYWORD_CASE))
+        auto nstCase = new NSwitchCase();
+        if ( switchBodySet->consume(TOKEN_KEYWORD_DEFAULT))
         {
-            if ( !stride::ast::validateLiteralValue(*switchBodySet))
+            if ( nstSwitch->defaultCase != nullptr )
             {
-                switchBodySet->error("Expected valid literal value after 'case' keyword.");
-                return;
+                switchBodySet->error("A switch statement can only have one default case.");
             }
-
-            auto nstCase = new NSwitchCase();
-            nstCase->conditionalValue = new NLiteral(switchBodySet->next());
-            switchBodySet->consumeRequired(TOKEN_DASH_RARROW, "Expected '->' after case value.");
-            nstCase->body = NBlock::capture(*switchBodySet);
+            nstSwitch->setDefaultCase(nstCase);
         }
-
-    } while ( switchBodySet->hasNext());
+        else
+        {
+            switchBodySet->consumeRequired(TOKEN_KEYWORD_CASE, "Expected 'case' or 'default' in switch statement.");
+            do
+            {
+                if ( !stride::ast::validateLiteralValue(*switchBodySet))
+                {
+                    switchBodySet->error("Expected valid literal value after 'case' keyword.");
+                }
+                token_t token = switchBodySet->next();
+                auto value = new NLiteral(token);
+                value->setSourceRange(token.index, token.index + (int) strlen(token.value));
+                nstCase->values.push_back(value);
+            } while ( switchBodySet->consume(TOKEN_COMMA));
+            nstSwitch->addCase(nstCase);
+        }
+        switchBodySet->consumeRequired(TOKEN_DASH_RARROW, "Expected '->' after case value.");
+        nstCase->body = NBlock::capture(*switchBodySet);
+    }
 
     parent.addChild(nstSwitch);
-}
\ No newline at end of file
+}
@@ -8,8 +8,7 @@ void NThrowStatement::parse(TokenSet &tokenSet, stride::ast::Node &parent)
 {
     tokenSet.consumeRequired(TOKEN_KEYWORD_THROW, "Throw statement requires 'throw' keyword.");
 
-    auto nstExpression = new NExpression();
-    auto nstThrow = new NThrowStatement(nstExpression);
+    auto nstThrow = new NThrowStatement(NExpression::parse(tokenSet));
 
     parent.addChild(nstThrow);
 }
\ No newline at end of file
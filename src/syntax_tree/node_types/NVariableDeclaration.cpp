@@ -51,6 +51,9 @@ NVariableDeclaration::parseSingular(TokenSet &tokenSet, bool allowAssignment, bo
 
     tokenSet.consumeRequired(TOKEN_COLON, "Expected colon after variable name, but received none.");
 
+    // Arrays can store each field of their elements in an array of its own.
+    nstVariableDecl->setSoaLayout(stride::ast::parseLayoutModifier(tokenSet));
+
     // Check if the type is a valid variable type.
     // This can be either a primitive type or an identifier. After this,
     // we'll check whether it's a primitive of identifier (sequence)
@@ -64,7 +67,7 @@ NVariableDeclaration::parseSingular(TokenSet &tokenSet, bool allowAssignment, bo
     // and continue parsing the variable declaration.
     nstVariableDecl->setVariableType(
             tokenSet.canConsume(TOKEN_IDENTIFIER) ?
-            std::variant<std::string *, token_type_t>(&stride::ast::parseIdentifier(tokenSet)->name) :
+            std::variant<std::string *, token_type_t>(stride::ast::parseTypeName(tokenSet)) :
             std::variant<std::string *, token_type_t>(tokenSet.next().type)
     );
 
@@ -131,6 +134,9 @@ void NVariableDeclaration::parse(TokenSet &tokens, stride::ast::Node &parent)
 
         tokens.consumeRequired(TOKEN_COLON, "Expected colon after variable name, but received none.");
 
+        // Arrays can store each field of their elements in an array of its own.
+        nstVariableDecl->setSoaLayout(stride::ast::parseLayoutModifier(tokens));
+
         // Check if the type is a valid variable type.
         // This can be either a primitive type or an identifier. After this,
         // we'll check whether it's a primitive of identifier (sequence)
@@ -144,7 +150,7 @@ void NVariableDeclaration::parse(TokenSet &tokens, stride::ast::Node &parent)
         // and continue parsing the variable declaration.
         nstVariableDecl->setVariableType(
                 tokens.canConsume(TOKEN_IDENTIFIER) ?
-                std::variant<std::string *, token_type_t>(&stride::ast::parseIdentifier(tokens)->name) :
+                std::variant<std::string *, token_type_t>(stride::ast::parseTypeName(tokens)) :
                 std::variant<std::string *, token_type_t>(tokens.next().type)
         );
 
@@ -12,4 +12,6 @@ void NWhileLoop::parse(TokenSet &tokenSet, stride::ast::Node &parent)
     nstWhileLoop->condition = NExpression::captureParenthesis(tokenSet);
     nstWhileLoop->body = NBlock::capture(tokenSet);
     tokenSet.consumeRequired(TOKEN_SEMICOLON, "Expected semicolon after while loop.");
+
+    parent.addChild(nstWhileLoop);
 }
\ No newline at end of file
@@ -5,7 +5,6 @@
 #include "../../../tokens/TokenSet.h"
 #include "../../../tokens/token.h"
 #include "NExpression.h"
-#include "../../Reducible.h"
 
 /**
  * Represents a block.
@@ -30,7 +29,7 @@ enum EBinaryOperator
     EQUALS = TOKEN_DOUBLE_EQUALS,                               // ==
     NOT_EQUALS = TOKEN_NOT_EQUALS,                              // !=
     LESS_THAN = TOKEN_LARROW,                                   // <
-    GREATER_THAN = TOKEN_GEQUALS,                               // >
+    GREATER_THAN = TOKEN_RARROW,                                // >
     LESS_THAN_EQUALS = TOKEN_LEQUALS,                           // <=
     SHIFT_LEFT = TOKEN_DOUBLE_LARROW,                           // <<
     GREATER_THAN_EQUALS = TOKEN_GEQUALS,                        // >=
@@ -72,17 +71,20 @@ public:
     }
 
     /**
-     * Checks if the binary operation is reducible.
-     * This is the case if both the left and right expressions are reducible,
-     * or they're both literals.
+     * Returns the operator that corresponds to the provided token.
+     * The token must be a binary operator, see <code>token_is_operator</code>.
      */
-    bool isReducible() override;
+    static enum EBinaryOperator fromToken(token_type_t token);
 
     /**
-     * Reduces the binary operation into a single literal.
-     * This is done by reducing the left and right expressions, and then performing the operation.
+     * Whether the operation assigns to its left operand, e.g. '=' or '+='.
      */
-    std::variant<NExpression *, NLiteral *> reduce() override;
+    [[nodiscard]] bool isAssignment() const;
+
+    /**
+     * Whether the operation compares its operands, and results in a boolean.
+     */
+    [[nodiscard]] bool isComparison() const;
 
 };
 
@@ -40,6 +40,30 @@ public:
 
     ~NClassDeclaration();
 
+    [[nodiscard]] const std::string &getClassName() const
+    { return className; }
+
+    void setClassName(std::string name)
+    { className = std::move(name); }
+
+    [[nodiscard]] std::vector<NIdentifier *> &getParents() const
+    { return *parents; }
+
+    [[nodiscard]] std::vector<std::string *> &getGenerics() const
+    { return *generics; }
+
+    [[nodiscard]] NBlock *getBody() const
+    { return body; }
+
+    void setBody(NBlock *block)
+    { body = block; }
+
+    [[nodiscard]] bool isPublicClass() const
+    { return isPublic; }
+
+    void setPublic(bool isPublicClass)
+    { isPublic = isPublicClass; }
+
     /**
      * Add a parent class to the class declaration.
      * @param parent The parent class.
@@ -58,6 +58,15 @@ public:
         NConditionalStatement::otherwise = otherwise;
     }
 
+    [[nodiscard]] NExpression *getCondition() const
+    { return condition; }
+
+    [[nodiscard]] NBlock *getThen() const
+    { return truthyBlock; }
+
+    [[nodiscard]] NBlock *getElse() const
+    { return otherwise; }
+
     static void parse(TokenSet &tokenSet, Node &parent);/**/
 
     enum stride::ast::ENodeType getType() override
@@ -9,11 +9,20 @@ class NEnumerableDeclaration : public stride::ast::Node
 {
 public:
 
+    std::string name;
     std::map<std::string, long int> values;
 
     NEnumerableDeclaration() : values()
     {};
 
+    void setName(std::string enumerableName)
+    {
+        name = std::move(enumerableName);
+    }
+
+    [[nodiscard]] const std::string &getName() const
+    { return name; }
+
     void addValue(const char *key, long int value)
     {
         values[ key ] = value;
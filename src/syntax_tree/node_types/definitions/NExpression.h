@@ -4,22 +4,18 @@
 #include "../../ASTNodes.h"
 #include "../../../tokens/TokenSet.h"
 #include "../../../tokens/token.h"
-#include "NLiteral.h"
-#include "../../Reducible.h"
 
 
 /**
  * Represents an expression.
  * Expressions are used to evaluate values.
+ * Operands, such as literals, identifiers and function calls, are expressions
+ * themselves, so binary and unary operations can refer to them directly.
  */
-class NExpression :
-        public stride::ast::Node,
-        public Reducible<NExpression *, NLiteral *>
+class NExpression : public stride::ast::Node
 {
 public:
 
-    typedef std::variant<NExpression *, NLiteral *> ExpressionReducible;
-
     NExpression() = default;
 
     virtual ~NExpression() = default;
@@ -35,8 +31,11 @@ public:
 
     /**
      * Parses an expression.
-     * This function automatically stops parsing when it encounters a semicolon,
-     * and does not consume it. This allows the parser to check for the end of the expression.
+     * Binary operators are combined by precedence climbing, using the precedence
+     * and associativity of the token traits, so the result is a tree of operations.
+     * Parsing stops at the first token that can't continue the expression.
+     * A terminating semicolon is consumed; a separating comma is left to the caller,
+     * e.g. when several variables are declared at once.
      * @param tokenSet The set of tokens to parse.
      * @param explicitExpression Whether the expression is explicit or not. If set to true,
      * the expression must start with a keyword and have a left associative operator after it,
@@ -47,37 +46,11 @@ public:
 
     static void parse(TokenSet &tokenSet, Node &parent);
 
-    /**
-     * Reduces the expression.
-     * @return
-     */
-    ExpressionReducible reduce() override;
-
-    /**
-     * Whether the expression is reducible.
-     * This is the case when the expression has reducible children,
-     * or when the expression has a singular child that is reducible.
-     */
-    bool isReducible() override;
-
     enum stride::ast::ENodeType getType() override
     {
         return stride::ast::EXPRESSION;
     }
 
-private:
-
-/*
-    void parseFunctionCall(TokenSet &tokenSet);
-
-    void parseArgumentList(TokenSet &tokenSet);
-
-    void parseUnaryOperation(TokenSet &tokenSet);
-
-*/
-
-
-
 };
 
 #endif
\ No newline at end of file
@@ -59,6 +59,12 @@ public:
         increments.push_back(incrementor);
     }
 
+    [[nodiscard]] const std::vector<NVariableDeclaration *> &getInitializers() const
+    { return initializers; }
+
+    [[nodiscard]] const std::vector<NVariableDeclaration *> &getIncrementors() const
+    { return increments; }
+
     enum stride::ast::ENodeType getType() override
     { return stride::ast::FOR_LOOP; }
 
@@ -21,6 +21,11 @@ public:
     std::vector<NExpression *> arguments;
     std::basic_string<char> *functionName;
 
+    /**
+     * The declaration of the called function, bound during name resolution.
+     */
+    stride::ast::Node *declaration = nullptr;
+
     /**
      * Create a new function call with the given function name.
      * @param function_name The name of the function.
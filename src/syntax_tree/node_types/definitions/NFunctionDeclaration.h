@@ -22,13 +22,13 @@
 class NFunctionDeclaration : public stride::ast::Node
 {
 public:
-    NIdentifier *functionName;
-    NIdentifier *returnType;
-    NBlock *body;
+    NIdentifier *functionName = nullptr;
+    NIdentifier *returnType = nullptr;
+    NBlock *body = nullptr;
     std::vector<NVariableDeclaration *> arguments;
-    bool isPublic;
-    bool external;
-    bool async;
+    bool isPublic = false;
+    bool external = false;
+    bool async = false;
 
     /**
      * Add a parameter to the function declaration.
@@ -2,17 +2,25 @@
 #define STRIDE_LANGUAGE_NIDENTIFIER_H
 
 #include "../../ASTNodes.h"
+#include "NExpression.h"
 
 /**
      * Represents an identifier.
      * Identifiers are used to represent names.
      * For example, in the expression "let x = 1", the identifier is "x".
      */
-class NIdentifier : public stride::ast::Node
+class NIdentifier : public NExpression
 {
 public:
     std::string name;
 
+    /**
+     * The declaration this identifier refers to.
+     * This is bound during name resolution, and is nullptr before,
+     * or when the identifier refers to a symbol of another compilation unit.
+     */
+    stride::ast::Node *declaration = nullptr;
+
     explicit NIdentifier(std::string name) :
             name(std::move(name))
     {}
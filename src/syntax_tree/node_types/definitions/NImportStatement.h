@@ -25,6 +25,9 @@ public:
             importedModuleName(std::move(module_name))
     {}
 
+    [[nodiscard]] const std::string &getModuleName() const
+    { return importedModuleName; }
+
     enum stride::ast::ENodeType getType() override
     {
         return stride::ast::IMPORT_STATEMENT;
@@ -7,6 +7,7 @@
 
 #include "../../../tokens/TokenSet.h"
 #include "../../../tokens/token.h"
+#include "NExpression.h"
 
 #define INT8_MASK 0x7F
 #define INT16_MASK 0x7FFF
@@ -23,7 +24,7 @@ typedef std::variant<
  * Literals are used to represent fixed values.
  * For example, in the expression "1 + 2", the literals are "1" and "2", respectively.
  */
-class NLiteral : public stride::ast::Node
+class NLiteral : public NExpression
 {
 private:
     int byteCount;
@@ -39,6 +40,13 @@ public:
      */
     explicit NLiteral(token_t token);
 
+    /**
+     * Create a new literal node with an explicit byte count.
+     * This is used when restoring literals, e.g. from a serialized syntax tree.
+     */
+    NLiteral(LiteralValue value, int byteCount) : value(std::move(value)), byteCount(byteCount)
+    {}
+
     explicit NLiteral(int64_t value) : value(value), byteCount(8)
     {}
 
@@ -87,6 +95,16 @@ public:
      * Whether the literal is an integer.
      */
     bool isInteger();
+
+    /**
+     * Replaces the value of the literal, e.g. with the result of a folded operation.
+     */
+    void setValue(LiteralValue newValue, int newByteCount)
+    {
+        this->value = std::move(newValue);
+        this->byteCount = newByteCount;
+        this->invalidateAttributes();
+    }
 };
 
 #endif
\ No newline at end of file
@@ -16,6 +16,15 @@ public:
             moduleName(std::move(module_name)), body(nullptr)
     {}
 
+    [[nodiscard]] const std::string &getModuleName() const
+    { return moduleName; }
+
+    [[nodiscard]] NBlock *getBody() const
+    { return body; }
+
+    void setBody(NBlock *block)
+    { body = block; }
+
     enum stride::ast::ENodeType getType() override
     { return stride::ast::MODULE_DECLARATION; }
 
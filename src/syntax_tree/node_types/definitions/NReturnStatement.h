@@ -21,6 +21,12 @@ public:
 
     explicit NReturnStatement() : expression(nullptr){}
 
+    [[nodiscard]] NExpression *getExpression() const
+    { return expression; }
+
+    void setExpression(NExpression *returnValue)
+    { expression = returnValue; }
+
     enum stride::ast::ENodeType getType() override
     { return stride::ast::RETURN_STATEMENT; }
 
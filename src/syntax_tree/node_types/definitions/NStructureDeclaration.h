@@ -11,9 +11,12 @@
  * Structure declaration.
  * Structures are defined using the following format: <br />
  * <code>
- * struct &lt;name&gt; {
+ * (external?) struct &lt;name&gt; {
  *  &nbsp;&lt;field&gt; ...
  *  }
+ * </code>
+ * External structures keep their fields in order of declaration, so they
+ * can be shared with C code.
  */
 class NStructureDeclaration : public stride::ast::Node
 {
@@ -22,6 +25,7 @@ private:
     std::string name;
     std::vector<NVariableDeclaration *> fields = {};
     std::vector<std::string *> generics = {};
+    bool external = false;
 
 public:
 
@@ -36,11 +40,26 @@ public:
         fields.push_back(field);
     }
 
-    void setName(const char *name)
+    void setName(const char *structureName)
     {
-        name = name;
+        this->name = structureName;
     }
 
+    [[nodiscard]] const std::string &getName() const
+    { return name; }
+
+    [[nodiscard]] const std::vector<NVariableDeclaration *> &getFields() const
+    { return fields; }
+
+    [[nodiscard]] std::vector<std::string *> &getGenerics()
+    { return generics; }
+
+    [[nodiscard]] bool isExternal() const
+    { return external; }
+
+    void setExternal(bool isExternal)
+    { external = isExternal; }
+
 
     enum stride::ast::ENodeType getType() override
     {
@@ -12,21 +12,23 @@
     * Switch case.
     * Switch cases are defined using the following format: <br />
     * <code>
-    * case &lt;literal&gt; -&gt; { ... }
+    * case &lt;literal&gt;, &lt;literal&gt; ... -&gt; { ... } <br />
+    * default -&gt; { ... }
     * </code>
     */
 class NSwitchCase : public stride::ast::Node
 {
 public:
-    NLiteral *conditionalValue;
+    /**
+     * The values that select this case. The default case has none.
+     */
+    std::vector<NLiteral *> values;
     NBlock *body;
 
     /**
      * Create a new switch case.
-     * @param condition The conditionalValue of the case.
-     * @param body The body of the case.
      */
-    NSwitchCase() : conditionalValue(nullptr), body(nullptr){}
+    NSwitchCase() : values(), body(nullptr){}
 
     enum stride::ast::ENodeType getType() override
     {
@@ -76,6 +78,18 @@ public:
         defaultCase = switchCase;
     }
 
+    [[nodiscard]] NExpression *getExpression() const
+    { return expression; }
+
+    void setExpression(NExpression *switchValue)
+    { expression = switchValue; }
+
+    [[nodiscard]] const std::vector<NSwitchCase *> &getCases() const
+    { return cases; }
+
+    [[nodiscard]] NSwitchCase *getDefaultCase() const
+    { return defaultCase; }
+
     enum stride::ast::ENodeType getType() override
     {
         return stride::ast::SWITCH_STATEMENT;
@@ -58,6 +58,15 @@ public:
         this->catchBlock = catch_block;
     }
 
+    [[nodiscard]] NBlock *getTryBlock() const
+    { return tryBlock; }
+
+    [[nodiscard]] NBlock *getCatchBlock() const
+    { return catchBlock; }
+
+    [[nodiscard]] NVariableDeclaration *getException() const
+    { return exception; }
+
     enum stride::ast::ENodeType getType() override
     { return stride::ast::TRY_CATCH_CLAUSE; }
 
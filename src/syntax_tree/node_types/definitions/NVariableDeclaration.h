@@ -36,6 +36,8 @@ private:
     bool isPrimitiveType;
     bool isConst;
     bool isArray;
+    bool isVariadic = false;
+    bool isSoa = false;
 
 public:
 
@@ -71,7 +73,7 @@ public:
     void setVariableType(std::variant<std::string *, token_type_t> type)
     {
         this->varType = type;
-        this->isPrimitiveType = std::holds_alternative<std::string *>(type);
+        this->isPrimitiveType = std::holds_alternative<token_type_t>(type);
     }
 
     /**
@@ -83,6 +85,23 @@ public:
         this->isArray = isVariableArray;
     }
 
+    /**
+     * Updates whether this parameter is variadic. Variadic parameters are arrays as well.
+     */
+    void setVariadic(bool isVariadicParameter)
+    {
+        this->isVariadic = isVariadicParameter;
+    }
+
+    /**
+     * Updates whether this array stores each field of its elements in an array of its own,
+     * as declared with <code>let points: soa Point[];</code>
+     */
+    void setSoaLayout(bool isSoaLayout)
+    {
+        this->isSoa = isSoaLayout;
+    }
+
     /**
      * Changes whether this variable is mutable or not (constant)
      * @param isConst Whether the variable is mutable or not.
@@ -92,6 +111,27 @@ public:
         this->isConst = isConstant;
     }
 
+    [[nodiscard]] const std::variant<std::string *, token_type_t> &getVariableType() const
+    { return varType; }
+
+    [[nodiscard]] std::string *getVariableName() const
+    { return varName; }
+
+    [[nodiscard]] NExpression *getValue() const
+    { return value; }
+
+    [[nodiscard]] bool isConstant() const
+    { return isConst; }
+
+    [[nodiscard]] bool isArrayType() const
+    { return isArray; }
+
+    [[nodiscard]] bool isVariadicParameter() const
+    { return isVariadic; }
+
+    [[nodiscard]] bool hasSoaLayout() const
+    { return isSoa; }
+
     enum stride::ast::ENodeType getType() override
     {
         return stride::ast::VARIABLE_DECLARATION;
@@ -2,6 +2,7 @@
 // Created by Luca Warmenhoven on 10/09/2024.
 //
 
+#include <algorithm>
 #include "TokenSet.h"
 #include "../error/ast_error_handling.h"
 
@@ -14,15 +15,14 @@ TokenSet::TokenSet(std::vector<token_t> *tokens, stride::StrideFile *source)
 
     if ( this->tokens == nullptr )
     {
-        this->error("Token stream is null.");
-        exit(1);
+        throw std::invalid_argument("Token stream is null.");
     }
 
     this->length = tokens->size();
 
     if ( this->length == 0 )
     {
-        this->error("Token stream is empty.");
+        source->diagnostics().report(stride::error::WARNING, 0, 0, "Token stream is empty.");
     }
 }
 
@@ -138,6 +138,11 @@ TokenSet *TokenSet::subset(int start, int subLength)
     return subset;
 }
 
+const std::vector<token_t> &TokenSet::getTokens() const
+{
+    return *this->tokens;
+}
+
 stride::StrideFile &TokenSet::getSource() const
 {
     return *this->source;
@@ -145,7 +150,84 @@ stride::StrideFile &TokenSet::getSource() const
 
 void TokenSet::error(const char *message)
 {
-    stride::error::error(*this->source, this->current().index, strlen(this->current().value), message);
+    // At the end of the stream, point to the last token of the set instead.
+    int relativeIndex = std::min(this->index, this->length - 1);
+    int absoluteIndex = this->startOffset + relativeIndex;
+
+    if ( relativeIndex < 0 || absoluteIndex >= this->tokens->size())
+    {
+        stride::error::error(*this->source, 0, 0, message);
+    }
+
+    token_t faulty = ( *this->tokens )[ absoluteIndex ];
+    stride::error::error(*this->source, faulty.index, (int) strlen(faulty.value), message);
+}
+
+/**
+ * Whether the provided token starts a new top-level declaration.
+ */
+bool isSynchronizationKeyword(token_type_t type)
+{
+    switch ( type )
+    {
+        case TOKEN_KEYWORD_DEFINE:
+        case TOKEN_KEYWORD_CLASS:
+        case TOKEN_KEYWORD_PUBLIC:
+        case TOKEN_KEYWORD_STRUCT:
+        case TOKEN_KEYWORD_ENUM:
+        case TOKEN_KEYWORD_MODULE:
+        case TOKEN_KEYWORD_IMPORT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void TokenSet::synchronize(int statementStart)
+{
+    // If the error occurred before anything was consumed,
+    // skip the offending token so we're guaranteed to make progress.
+    if ( this->index <= statementStart )
+    {
+        this->index = statementStart + 1;
+    }
+
+    int depth = 0;
+    for ( ; !this->end(); this->index++ )
+    {
+        token_type_t type = ( *this->tokens )[ this->startOffset + this->index ].type;
+
+        if ( depth == 0 && isSynchronizationKeyword(type))
+        {
+            return;
+        }
+
+        switch ( type )
+        {
+            case TOKEN_LBRACE:
+                depth++;
+                break;
+            case TOKEN_RBRACE:
+                // Either the block the faulty statement opened is closed,
+                // or we're leaving the enclosing block altogether.
+                if ( depth <= 1 )
+                {
+                    this->index++;
+                    return;
+                }
+                depth--;
+                break;
+            case TOKEN_SEMICOLON:
+                if ( depth == 0 )
+                {
+                    this->index++;
+                    return;
+                }
+                break;
+            default:
+                break;
+        }
+    }
 }
 
 token_t TokenSet::peek(int offset)
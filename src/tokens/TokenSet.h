@@ -58,7 +58,28 @@ public:
      */
     [[nodiscard]] int getIndex() const;
 
-    void error(const char *message);
+    /**
+     * Returns the underlying tokens of the stream.
+     * For subsets, this includes the tokens outside of the subset range.
+     */
+    [[nodiscard]] const std::vector<token_t> &getTokens() const;
+
+    /**
+     * Reports an error at the current token, and interrupts parsing
+     * by throwing a ParseError.
+     * @param message The message to report.
+     */
+    [[noreturn]] void error(const char *message);
+
+    /**
+     * Skips tokens until a synchronization point is found, so parsing
+     * can continue after an error. Synchronization points are a semicolon or
+     * closing brace at the nesting depth of the faulty statement (both consumed),
+     * or a keyword that starts a new top-level declaration (not consumed).
+     * The stream always advances past the provided statement start.
+     * @param statementStart The index at which the faulty statement started.
+     */
+    void synchronize(int statementStart);
 
     /**
      * Checks if there are more tokens in the stream,
@@ -0,0 +1,279 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_TOKENTRAITS_H
+#define STRIDE_LANGUAGE_TOKENTRAITS_H
+
+#include <array>
+#include <cstddef>
+#include "token.h"
+
+/* Token categories */
+#define TOKEN_TRAIT_EXPRESSION  (1 << 0) // Token may appear inside an expression
+#define TOKEN_TRAIT_OPERATOR    (1 << 1) // Binary operator
+#define TOKEN_TRAIT_UNARY       (1 << 2) // Can be used as a prefix operator
+#define TOKEN_TRAIT_ASSIGNMENT  (1 << 3) // Assignment or compound assignment
+#define TOKEN_TRAIT_PRIMITIVE   (1 << 4) // Primitive type
+#define TOKEN_TRAIT_LITERAL     (1 << 5) // Literal value
+#define TOKEN_TRAIT_INTEGER     (1 << 6) // Integer primitive type
+#define TOKEN_TRAIT_FLOAT       (1 << 7) // Floating point primitive type
+
+/* Operator associativity */
+#define ASSOCIATIVITY_NONE      (0) // Non-associative, e.g. comparisons
+#define ASSOCIATIVITY_LEFT      (1) // a - b - c == (a - b) - c
+#define ASSOCIATIVITY_RIGHT     (2) // a = b = c == a = (b = c)
+
+/**
+ * Properties of a single token type.
+ * These are stored in a table that is indexed by the token type,
+ * so every query is a single array load.
+ */
+typedef struct
+{
+    token_type_t token;
+
+    /**
+     * Bit set of TOKEN_TRAIT_* categories.
+     */
+    unsigned short flags;
+
+    /**
+     * The precedence of the binary operator.
+     * Operators with a higher precedence bind tighter.
+     * 0 for tokens that aren't binary operators.
+     */
+    unsigned char precedence;
+
+    /**
+     * The associativity of the binary operator.
+     */
+    unsigned char associativity;
+
+    /**
+     * The size of the primitive type in bytes.
+     * This is used for the code generation.
+     */
+    unsigned char byteSize;
+} token_traits_t;
+
+#define EXPR_OPERATOR (TOKEN_TRAIT_EXPRESSION | TOKEN_TRAIT_OPERATOR)
+#define EXPR_ASSIGNMENT (TOKEN_TRAIT_EXPRESSION | TOKEN_TRAIT_OPERATOR | TOKEN_TRAIT_ASSIGNMENT)
+#define INT_PRIMITIVE (TOKEN_TRAIT_PRIMITIVE | TOKEN_TRAIT_INTEGER)
+#define FLOAT_PRIMITIVE (TOKEN_TRAIT_PRIMITIVE | TOKEN_TRAIT_FLOAT)
+
+/**
+ * All tokens with non-default properties.
+ * Every token may only occur once; duplicates fail to compile.
+ */
+inline constexpr token_traits_t token_trait_entries[] = {
+        /* Assignment, lowest precedence */
+        { TOKEN_EQUALS,                EXPR_ASSIGNMENT,                          5,  ASSOCIATIVITY_RIGHT, 0 }, // =
+        { TOKEN_PLUS_EQUALS,           EXPR_ASSIGNMENT,                          5,  ASSOCIATIVITY_RIGHT, 0 }, // +=
+        { TOKEN_MINUS_EQUALS,          EXPR_ASSIGNMENT,                          5,  ASSOCIATIVITY_RIGHT, 0 }, // -=
+        { TOKEN_STAR_EQUALS,           EXPR_ASSIGNMENT,                          5,  ASSOCIATIVITY_RIGHT, 0 }, // *=
+        { TOKEN_SLASH_EQUALS,          EXPR_ASSIGNMENT,                          5,  ASSOCIATIVITY_RIGHT, 0 }, // /=
+        { TOKEN_PERCENT_EQUALS,        EXPR_ASSIGNMENT,                          5,  ASSOCIATIVITY_RIGHT, 0 }, // %=
+        { TOKEN_AMPERSAND_EQUALS,      EXPR_ASSIGNMENT,                          5,  ASSOCIATIVITY_RIGHT, 0 }, // &=
+        { TOKEN_PIPE_EQUALS,           EXPR_ASSIGNMENT,                          5,  ASSOCIATIVITY_RIGHT, 0 }, // |=
+        { TOKEN_CARET_EQUALS,          EXPR_ASSIGNMENT,                          5,  ASSOCIATIVITY_RIGHT, 0 }, // ^=
+        { TOKEN_TILDE_EQUALS,          EXPR_ASSIGNMENT,                          5,  ASSOCIATIVITY_RIGHT, 0 }, // ~=
+        { TOKEN_DOUBLE_LARROW_EQUALS,  EXPR_ASSIGNMENT,                          5,  ASSOCIATIVITY_RIGHT, 0 }, // <<=
+        { TOKEN_DOUBLE_RARROW_EQUALS,  EXPR_ASSIGNMENT,                          5,  ASSOCIATIVITY_RIGHT, 0 }, // >>=
+        { TOKEN_DOUBLE_STAR_EQUALS,    EXPR_ASSIGNMENT,                          5,  ASSOCIATIVITY_RIGHT, 0 }, // **=
+
+        /* Ternary */
+        { TOKEN_QUESTION,              TOKEN_TRAIT_EXPRESSION,                   8,  ASSOCIATIVITY_RIGHT, 0 }, // ?
+        { TOKEN_COLON,                 TOKEN_TRAIT_EXPRESSION,                   0,  ASSOCIATIVITY_NONE,  0 }, // :
+
+        /* Logical operators */
+        { TOKEN_DOUBLE_PIPE,           EXPR_OPERATOR,                            10, ASSOCIATIVITY_LEFT,  0 }, // ||
+        { TOKEN_DOUBLE_AMPERSAND,      EXPR_OPERATOR,                            15, ASSOCIATIVITY_LEFT,  0 }, // &&
+
+        /* Bitwise operators */
+        { TOKEN_PIPE,                  EXPR_OPERATOR,                            20, ASSOCIATIVITY_LEFT,  0 }, // |
+        { TOKEN_CARET,                 EXPR_OPERATOR,                            25, ASSOCIATIVITY_LEFT,  0 }, // ^
+        { TOKEN_AMPERSAND,             EXPR_OPERATOR,                            30, ASSOCIATIVITY_LEFT,  0 }, // &
+
+        /* Comparison operators */
+        { TOKEN_DOUBLE_EQUALS,         EXPR_OPERATOR,                            35, ASSOCIATIVITY_NONE,  0 }, // ==
+        { TOKEN_NOT_EQUALS,            EXPR_OPERATOR,                            35, ASSOCIATIVITY_NONE,  0 }, // !=
+        { TOKEN_BANG_EQUALS,           EXPR_OPERATOR,                            35, ASSOCIATIVITY_NONE,  0 }, // != (as produced by the tokenizer)
+        { TOKEN_LARROW,                EXPR_OPERATOR,                            40, ASSOCIATIVITY_NONE,  0 }, // <
+        { TOKEN_RARROW,                EXPR_OPERATOR,                            40, ASSOCIATIVITY_NONE,  0 }, // >
+        { TOKEN_LEQUALS,               EXPR_OPERATOR,                            40, ASSOCIATIVITY_NONE,  0 }, // <=
+        { TOKEN_GEQUALS,               EXPR_OPERATOR,                            40, ASSOCIATIVITY_NONE,  0 }, // >=
+
+        /* Shift operators */
+        { TOKEN_DOUBLE_LARROW,         EXPR_OPERATOR,                            45, ASSOCIATIVITY_LEFT,  0 }, // <<
+        { TOKEN_DOUBLE_RARROW,         EXPR_OPERATOR,                            45, ASSOCIATIVITY_LEFT,  0 }, // >>
+
+        /* Arithmetic operators */
+        { TOKEN_PLUS,                  EXPR_OPERATOR | TOKEN_TRAIT_UNARY,        50, ASSOCIATIVITY_LEFT,  0 }, // + (unary and binary)
+        { TOKEN_MINUS,                 EXPR_OPERATOR | TOKEN_TRAIT_UNARY,        50, ASSOCIATIVITY_LEFT,  0 }, // - (unary and binary)
+        { TOKEN_STAR,                  EXPR_OPERATOR,                            55, ASSOCIATIVITY_LEFT,  0 }, // *
+        { TOKEN_SLASH,                 EXPR_OPERATOR,                            55, ASSOCIATIVITY_LEFT,  0 }, // /
+        { TOKEN_PERCENT,               EXPR_OPERATOR,                            55, ASSOCIATIVITY_LEFT,  0 }, // %
+        { TOKEN_DOUBLE_STAR,           EXPR_OPERATOR,                            60, ASSOCIATIVITY_RIGHT, 0 }, // **
+
+        /* Prefix and postfix operators */
+        { TOKEN_BANG,                  TOKEN_TRAIT_EXPRESSION | TOKEN_TRAIT_UNARY, 0, ASSOCIATIVITY_NONE, 0 }, // !
+        { TOKEN_TILDE,                 TOKEN_TRAIT_EXPRESSION | TOKEN_TRAIT_UNARY, 0, ASSOCIATIVITY_NONE, 0 }, // ~
+        { TOKEN_DOUBLE_PLUS,           TOKEN_TRAIT_EXPRESSION | TOKEN_TRAIT_UNARY, 0, ASSOCIATIVITY_NONE, 0 }, // ++
+        { TOKEN_DOUBLE_MINUS,          TOKEN_TRAIT_EXPRESSION | TOKEN_TRAIT_UNARY, 0, ASSOCIATIVITY_NONE, 0 }, // --
+
+        /* Other expression tokens */
+        { TOKEN_LPAREN,                TOKEN_TRAIT_EXPRESSION,                   0,  ASSOCIATIVITY_NONE,  0 },
+        { TOKEN_RPAREN,                TOKEN_TRAIT_EXPRESSION,                   0,  ASSOCIATIVITY_NONE,  0 },
+        { TOKEN_LSQUARE_BRACKET,       TOKEN_TRAIT_EXPRESSION,                   0,  ASSOCIATIVITY_NONE,  0 },
+        { TOKEN_RSQUARE_BRACKET,       TOKEN_TRAIT_EXPRESSION,                   0,  ASSOCIATIVITY_NONE,  0 },
+        { TOKEN_COMMA,                 TOKEN_TRAIT_EXPRESSION,                   0,  ASSOCIATIVITY_NONE,  0 },
+        { TOKEN_IDENTIFIER,            TOKEN_TRAIT_EXPRESSION,                   0,  ASSOCIATIVITY_NONE,  0 },
+        { TOKEN_KEYWORD_NULL,          TOKEN_TRAIT_EXPRESSION,                   0,  ASSOCIATIVITY_NONE,  0 },
+
+        /* Literals */
+        { TOKEN_STRING_LITERAL,        TOKEN_TRAIT_EXPRESSION | TOKEN_TRAIT_LITERAL, 0, ASSOCIATIVITY_NONE, 0 },
+        { TOKEN_CHAR_LITERAL,          TOKEN_TRAIT_EXPRESSION | TOKEN_TRAIT_LITERAL, 0, ASSOCIATIVITY_NONE, 0 },
+        { TOKEN_NUMBER_INTEGER,        TOKEN_TRAIT_EXPRESSION | TOKEN_TRAIT_LITERAL, 0, ASSOCIATIVITY_NONE, 0 },
+        { TOKEN_NUMBER_FLOAT,          TOKEN_TRAIT_EXPRESSION | TOKEN_TRAIT_LITERAL, 0, ASSOCIATIVITY_NONE, 0 },
+        { TOKEN_BOOLEAN_LITERAL,       TOKEN_TRAIT_EXPRESSION | TOKEN_TRAIT_LITERAL, 0, ASSOCIATIVITY_NONE, 0 },
+
+        /* Primitive types */
+        { TOKEN_PRIMITIVE_UINT8,       INT_PRIMITIVE,                            0,  ASSOCIATIVITY_NONE,  1 },
+        { TOKEN_PRIMITIVE_UINT16,      INT_PRIMITIVE,                            0,  ASSOCIATIVITY_NONE,  2 },
+        { TOKEN_PRIMITIVE_UINT32,      INT_PRIMITIVE,                            0,  ASSOCIATIVITY_NONE,  4 },
+        { TOKEN_PRIMITIVE_UINT64,      INT_PRIMITIVE,                            0,  ASSOCIATIVITY_NONE,  8 },
+        { TOKEN_PRIMITIVE_INT8,        INT_PRIMITIVE,                            0,  ASSOCIATIVITY_NONE,  1 },
+        { TOKEN_PRIMITIVE_INT16,       INT_PRIMITIVE,                            0,  ASSOCIATIVITY_NONE,  2 },
+        { TOKEN_PRIMITIVE_INT32,       INT_PRIMITIVE,                            0,  ASSOCIATIVITY_NONE,  4 },
+        { TOKEN_PRIMITIVE_INT64,       INT_PRIMITIVE,                            0,  ASSOCIATIVITY_NONE,  8 },
+        { TOKEN_PRIMITIVE_FLOAT32,     FLOAT_PRIMITIVE,                          0,  ASSOCIATIVITY_NONE,  4 },
+        { TOKEN_PRIMITIVE_FLOAT64,     FLOAT_PRIMITIVE,                          0,  ASSOCIATIVITY_NONE,  8 },
+        { TOKEN_PRIMITIVE_BOOL,        TOKEN_TRAIT_PRIMITIVE,                    0,  ASSOCIATIVITY_NONE,  1 },
+        { TOKEN_PRIMITIVE_CHAR,        TOKEN_TRAIT_PRIMITIVE,                    0,  ASSOCIATIVITY_NONE,  1 },
+        { TOKEN_PRIMITIVE_STRING,      TOKEN_TRAIT_PRIMITIVE,                    0,  ASSOCIATIVITY_NONE,  8 }, // pointer
+        { TOKEN_PRIMITIVE_VOID,        TOKEN_TRAIT_PRIMITIVE,                    0,  ASSOCIATIVITY_NONE,  0 },
+        { TOKEN_PRIMITIVE_AUTO,        TOKEN_TRAIT_PRIMITIVE,                    0,  ASSOCIATIVITY_NONE,  0 },
+};
+
+#undef EXPR_OPERATOR
+#undef EXPR_ASSIGNMENT
+#undef INT_PRIMITIVE
+#undef FLOAT_PRIMITIVE
+
+/**
+ * Builds the densely indexed token traits table from a list of entries.
+ * Throwing during constant evaluation is not a constant expression,
+ * so invalid or duplicate entries are rejected at compile time.
+ */
+template<std::size_t N>
+constexpr std::array<token_traits_t, TOKEN_COUNT> build_token_traits_table(const token_traits_t (&entries)[N])
+{
+    std::array<token_traits_t, TOKEN_COUNT> table {};
+    std::array<bool, TOKEN_COUNT> defined {};
+
+    for ( std::size_t i = 0; i < TOKEN_COUNT; i++ )
+    {
+        table[ i ] = { static_cast<token_type_t>(i), 0, 0, ASSOCIATIVITY_NONE, 0 };
+    }
+
+    for ( const auto &entry: entries )
+    {
+        if ( entry.token < 0 || entry.token >= TOKEN_COUNT )
+        {
+            throw "Token traits entry refers to an invalid token.";
+        }
+        if ( defined[ entry.token ] )
+        {
+            throw "Token traits entry is defined more than once.";
+        }
+        if (( entry.flags & TOKEN_TRAIT_OPERATOR ) && entry.precedence == 0 )
+        {
+            throw "Binary operator requires a precedence.";
+        }
+        defined[ entry.token ] = true;
+        table[ entry.token ] = entry;
+    }
+    return table;
+}
+
+/**
+ * Table containing the traits of every token, indexed by token type.
+ */
+inline constexpr std::array<token_traits_t, TOKEN_COUNT> token_traits_table =
+        build_token_traits_table(token_trait_entries);
+
+/**
+ * Returns the traits of the provided token type.
+ */
+constexpr const token_traits_t &token_traits(token_type_t type)
+{
+    return token_traits_table[ type ];
+}
+
+constexpr bool token_has_trait(token_type_t type, unsigned short trait)
+{
+    return ( token_traits_table[ type ].flags & trait ) != 0;
+}
+
+/**
+ * Whether the token can appear inside an expression.
+ */
+constexpr bool token_is_expression(token_type_t type)
+{
+    return token_has_trait(type, TOKEN_TRAIT_EXPRESSION);
+}
+
+/**
+ * Whether the token is a binary operator.
+ */
+constexpr bool token_is_operator(token_type_t type)
+{
+    return token_has_trait(type, TOKEN_TRAIT_OPERATOR);
+}
+
+/**
+ * Whether the token is a primitive type.
+ */
+constexpr bool token_is_primitive(token_type_t type)
+{
+    return token_has_trait(type, TOKEN_TRAIT_PRIMITIVE);
+}
+
+/**
+ * Whether the token is a literal value.
+ */
+constexpr bool token_is_literal(token_type_t type)
+{
+    return token_has_trait(type, TOKEN_TRAIT_LITERAL);
+}
+
+/**
+ * Returns the precedence of a binary operator, or 0 if the token isn't one.
+ */
+constexpr int token_precedence(token_type_t type)
+{
+    return token_traits_table[ type ].precedence;
+}
+
+/**
+ * Returns the associativity of a binary operator.
+ */
+constexpr int token_associativity(token_type_t type)
+{
+    return token_traits_table[ type ].associativity;
+}
+
+/**
+ * Returns the size of a primitive type in bytes, or 0 if it has no size.
+ */
+constexpr unsigned int token_byte_size(token_type_t type)
+{
+    return token_traits_table[ type ].byteSize;
+}
+
+static_assert(token_precedence(TOKEN_STAR) > token_precedence(TOKEN_PLUS));
+static_assert(token_precedence(TOKEN_PERCENT) == token_precedence(TOKEN_SLASH));
+static_assert(token_byte_size(TOKEN_PRIMITIVE_INT32) == 4);
+
+#endif //STRIDE_LANGUAGE_TOKENTRAITS_H
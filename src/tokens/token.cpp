@@ -86,13 +86,18 @@ std::vector<token_def_t> token_definitions = {
         gen_token("i16", TOKEN_PRIMITIVE_INT16),
         gen_token("i32", TOKEN_PRIMITIVE_INT32),
         gen_token("i64", TOKEN_PRIMITIVE_INT64),
+        gen_token_kw("u8", TOKEN_PRIMITIVE_UINT8),
+        gen_token_kw("u16", TOKEN_PRIMITIVE_UINT16),
+        gen_token_kw("u32", TOKEN_PRIMITIVE_UINT32),
+        gen_token_kw("u64", TOKEN_PRIMITIVE_UINT64),
         gen_token("f32", TOKEN_PRIMITIVE_FLOAT32),
         gen_token("f64", TOKEN_PRIMITIVE_FLOAT64),
         gen_token_kw("[a-zA-Z_$][a-zA-Z0-9_$]*", TOKEN_IDENTIFIER),
+        // Floats are matched before integers, as the integer part of a float is a valid integer.
+        gen_token(R"([\+\-]?([0-9]+\.[eE][-+]?[0-9]+|[0-9]*\.[0-9]+([eE][\+\-]?[0-9]+)?))",
+                  TOKEN_NUMBER_FLOAT),
         gen_token(R"([\+\-]?[0-9]+([eE][0-9]+)?)", TOKEN_NUMBER_INTEGER),
         gen_token("true|false", TOKEN_BOOLEAN_LITERAL),
-        gen_token(R"([\+\-]?([0-9]+\.[eE][-+]?[0-9]+|[0-9]*\.?[0-9]+[eE][\+\-]?[0-9]+|[0-9]*\.[0-9]+|[0-9]+))",
-                  TOKEN_NUMBER_FLOAT),
         gen_token(R"("[^"]*")", TOKEN_STRING_LITERAL),
         gen_token(R"('(\\[^']|\\'|[^'])')", TOKEN_CHAR_LITERAL),
         gen_token("\\.{3}", TOKEN_THREE_DOTS),
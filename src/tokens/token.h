@@ -125,6 +125,8 @@ typedef enum
     TOKEN_NUMBER_INTEGER,
     TOKEN_NUMBER_FLOAT,
     TOKEN_BOOLEAN_LITERAL,
+
+    TOKEN_COUNT // Number of token types, not an actual token.
 } token_type_t;
 
 /**
@@ -156,10 +158,4 @@ typedef struct
  */
 extern std::vector<token_def_t> token_definitions;
 
-/**
- * Map that contains the byte sizes of the primitive types.
- * This is used for the code generation.
- */
-extern std::map<token_type_t, unsigned int> primitive_byte_sizes;
-
 #endif //STRIDE_LANGUAGE_TOKEN_H
@@ -55,13 +55,18 @@ void get_cursor_position(const char *source, size_t index, int *line, int *colum
  * @param dst The destination required_token set.
  */
 TokenSet *stride::tokenize(stride::StrideFile *source)
+{
+    return new TokenSet(tokenizeRange(source, 0, (int) source->getContent().size()), source);
+}
+
+std::vector<token_t> *stride::tokenizeRange(stride::StrideFile *source, int start, int end)
 {
     int matched, i, j;
 
     auto *tokens = new std::vector<token_t>();
     const char *src = source->getContent().c_str();
 
-    for ( i = 0; i < source->getContent().size(); )
+    for ( i = start; i < end; )
     {
         // Skip whitespaces
         if ( src[ i ] == ' ' || src[ i ] == '\n' || src[ i ] == '\t' )
@@ -101,9 +106,11 @@ TokenSet *stride::tokenize(stride::StrideFile *source)
         }
         if ( !matched )
         {
-            stride::error::error(*source, i, 1, "Illegal character found in file.");
+            // Report and skip the character, so all illegal characters are reported at once.
+            source->diagnostics().report(stride::error::ERROR, i, 1, "Illegal character found in file.");
+            i++;
         }
     }
 
-    return new TokenSet(tokens, source);
+    return tokens;
 }
\ No newline at end of file
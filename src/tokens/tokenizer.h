@@ -11,5 +11,14 @@
 
 namespace stride {
     TokenSet * tokenize(stride::StrideFile *source);
+
+    /**
+     * Tokenizes part of a source file.
+     * Token indices are relative to the start of the file. The last token may
+     * extend past the end of the range, e.g. for an unterminated string literal.
+     * @param start The character index to start at.
+     * @param end The character index to stop at, exclusive.
+     */
+    std::vector<token_t> *tokenizeRange(stride::StrideFile *source, int start, int end);
 }
 #endif //STRIDE_LANGUAGE_TOKENIZER_H
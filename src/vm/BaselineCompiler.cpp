@@ -0,0 +1,428 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <cstring>
+#include "BaselineCompiler.h"
+#include "../backend/MachineCodeEncoder.h"
+
+#if BASELINE_COMPILER_SUPPORTED
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace stride;
+using namespace stride::vm;
+using namespace stride::backend;
+
+/**
+ * Returns the memory of a register of the frame, which rbx points to.
+ */
+static MachineOperand slot(uint16_t reg, uint8_t size = 8)
+{
+    return MachineOperand::memory(RBX, (int64_t) reg * 8, size);
+}
+
+static void loadSlot(MachineBlock *block, uint16_t reg)
+{
+    block->append(MI_MOV, { slot(reg), MachineOperand::def(RAX, 8) });
+}
+
+static void storeSlot(MachineBlock *block, uint16_t reg)
+{
+    block->append(MI_MOV, { MachineOperand::use(RAX, 8), slot(reg) });
+}
+
+/**
+ * Leaves the code, returning the index of the instruction at which the interpreter continues.
+ */
+static void exitTo(MachineBlock *block, uint32_t index)
+{
+    block->append(MI_MOV, { MachineOperand::imm(index, 4), MachineOperand::def(RAX, 4) });
+    block->append(MI_POP, { MachineOperand::def(RBX, 8) });
+    block->append(MI_RET, {});
+}
+
+/**
+ * Brings the result in rax in the form the interpreter keeps values of a type in, like 'canonical' of the interpreter.
+ */
+static void canonicalize(MachineBlock *block, uint8_t type)
+{
+    switch ( type )
+    {
+        case ir::IR_BOOL:
+            block->append(MI_AND, { MachineOperand::imm(1, 8), MachineOperand::useDef(RAX, 8) });
+            break;
+        case ir::IR_I8:
+        case ir::IR_I16:
+        case ir::IR_I32:
+            block->append(MI_MOVSX, { MachineOperand::use(RAX, (uint8_t) ir::sizeOf((ir::EIRType) type)),
+                                      MachineOperand::def(RAX, 8) });
+            break;
+        case ir::IR_F32:
+            block->append(MI_MOVZX, { MachineOperand::use(RAX, 4), MachineOperand::def(RAX, 4) });
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * Stores the condition of the flags as a boolean.
+ */
+static void storeCondition(MachineBlock *block, ECondition condition, uint16_t reg)
+{
+    block->append(MI_SETCC, { MachineOperand::def(RAX, 1) })->condition = condition;
+    block->append(MI_MOVZX, { MachineOperand::use(RAX, 1), MachineOperand::def(RAX, 4) });
+    storeSlot(block, reg);
+}
+
+/**
+ * Stores the float in xmm0, with the upper bits of single precision floats cleared.
+ */
+static void storeFloat(MachineBlock *block, uint16_t reg)
+{
+    block->append(MI_MOVQ, { MachineOperand::use(XMM0, 8), MachineOperand::def(RAX, 8) });
+    storeSlot(block, reg);
+}
+
+static ECondition conditionOf(EBytecodeOpcode opcode)
+{
+    static const ECondition conditions[] = {
+            COND_E, COND_NE, COND_L, COND_LE, COND_G, COND_GE, COND_B, COND_BE, COND_A, COND_AE
+    };
+    return conditions[ opcode - BC_EQ ];
+}
+
+void BaselineCompiler::select(const BytecodeFunction &function, uint32_t index, std::vector<MachineBlock *> &blocks,
+                              MachineFunction &machine)
+{
+    const Instruction &instruction = function.code[ index ];
+    MachineBlock *block = blocks[ index ];
+    EBytecodeOpcode opcode = genericOpcode(instruction.opcode);
+    uint8_t type = instruction.type;
+    uint8_t size = (uint8_t) std::max(ir::sizeOf((ir::EIRType) type), 1u);
+    uint8_t floatSize = type == ir::IR_F32 ? 4 : 8;
+    bool isWide = type == ir::IR_I64 || type == ir::IR_PTR;
+
+    switch ( opcode )
+    {
+        case BC_MOVE:
+            loadSlot(block, instruction.b);
+            storeSlot(block, instruction.a);
+            return;
+
+        case BC_LOAD_CONSTANT:
+            block->append(MI_MOV, { MachineOperand::imm((int64_t) function.values[ instruction.wide() ], 8),
+                                    MachineOperand::def(RAX, 8) });
+            storeSlot(block, instruction.a);
+            return;
+
+        case BC_ADD:
+        case BC_SUB:
+        case BC_MUL:
+        case BC_AND:
+        case BC_OR:
+        case BC_XOR:
+        {
+            static const EMachineOpcode operations[] = { MI_ADD, MI_SUB, MI_IMUL };
+            EMachineOpcode operation = opcode <= BC_MUL ? operations[ opcode - BC_ADD ] :
+                                       opcode == BC_AND ? MI_AND : opcode == BC_OR ? MI_OR : MI_XOR;
+            loadSlot(block, instruction.b);
+            block->append(operation, { slot(instruction.c), MachineOperand::useDef(RAX, 8) });
+            canonicalize(block, type);
+            storeSlot(block, instruction.a);
+            return;
+        }
+
+        case BC_SDIV:
+        case BC_SREM:
+        {
+            // Like the quickened divisions, a divisor of 0 or -1 is left to the interpreter.
+            MachineBlock *guard = machine.createBlock("guard");
+            exitTo(guard, index);
+            block->append(MI_MOV, { slot(instruction.c), MachineOperand::def(RCX, 8) });
+            block->append(MI_LEA, { MachineOperand::memory(RCX, 1, 8), MachineOperand::def(RDX, 8) });
+            block->append(MI_CMP, { MachineOperand::imm(1, 8), MachineOperand::use(RDX, 8) });
+            block->append(MI_JCC, { MachineOperand::target(guard) })->condition = COND_BE;
+            loadSlot(block, instruction.b);
+            block->append(MI_SIGN_EXTEND_ACCUMULATOR, { MachineOperand::use(RAX, 8), MachineOperand::def(RDX, 8) });
+            block->append(MI_IDIV, { MachineOperand::use(RCX, 8) });
+            block->append(MI_MOV, { MachineOperand::use(opcode == BC_SDIV ? RAX : RDX, 8), slot(instruction.a) });
+            return;
+        }
+
+        case BC_SHL:
+        case BC_LSHR:
+        case BC_ASHR:
+        {
+            // Shifts of 32 and 64 bits mask their count like the interpreter does; narrower ones don't.
+            if ( type != ir::IR_I32 && !isWide )
+            {
+                break;
+            }
+            EMachineOpcode operation = opcode == BC_SHL ? MI_SHL : opcode == BC_LSHR ? MI_SHR : MI_SAR;
+            block->append(MI_MOV, { slot(instruction.c), MachineOperand::def(RCX, 8) });
+            loadSlot(block, instruction.b);
+            block->append(operation, { MachineOperand::use(RCX, 1), MachineOperand::useDef(RAX, size) });
+            canonicalize(block, type);
+            storeSlot(block, instruction.a);
+            return;
+        }
+
+        case BC_EQ:
+        case BC_NE:
+        case BC_LT:
+        case BC_LE:
+        case BC_GT:
+        case BC_GE:
+        case BC_ULT:
+        case BC_ULE:
+        case BC_UGT:
+        case BC_UGE:
+        {
+            // Unsigned comparisons compare the bits of the type; signed ones all bits, as they're sign extended.
+            uint8_t width = opcode >= BC_ULT ? size : 8;
+            loadSlot(block, instruction.b);
+            block->append(MI_CMP, { slot(instruction.c, width), MachineOperand::use(RAX, width) });
+            storeCondition(block, conditionOf(opcode), instruction.a);
+            return;
+        }
+
+        case BC_FADD:
+        case BC_FSUB:
+        case BC_FMUL:
+        case BC_FDIV:
+        {
+            static const EMachineOpcode operations[] = { MI_ADDF, MI_SUBF, MI_MULF, MI_DIVF };
+            block->append(MI_MOVF, { slot(instruction.b, floatSize), MachineOperand::def(XMM0, floatSize) });
+            block->append(operations[ opcode - BC_FADD ],
+                          { slot(instruction.c, floatSize), MachineOperand::useDef(XMM0, floatSize) });
+            storeFloat(block, instruction.a);
+            return;
+        }
+
+        case BC_FEQ:
+        case BC_FNE:
+        case BC_FLT:
+        case BC_FLE:
+        case BC_FGT:
+        case BC_FGE:
+        {
+            // Less than is greater than with the operands swapped; unordered operands are neither.
+            bool swap = opcode == BC_FLT || opcode == BC_FLE;
+            block->append(MI_MOVF, { slot(swap ? instruction.c : instruction.b, floatSize),
+                                     MachineOperand::def(XMM0, floatSize) });
+            block->append(MI_UCOMIF, { slot(swap ? instruction.b : instruction.c, floatSize),
+                                       MachineOperand::use(XMM0, floatSize) });
+            if ( opcode == BC_FEQ || opcode == BC_FNE )
+            {
+                bool isEqual = opcode == BC_FEQ;
+                block->append(MI_SETCC, { MachineOperand::def(RAX, 1) })->condition = isEqual ? COND_E : COND_NE;
+                block->append(MI_SETCC, { MachineOperand::def(RCX, 1) })->condition = isEqual ? COND_NP : COND_P;
+                block->append(isEqual ? MI_AND : MI_OR, { MachineOperand::use(RCX, 1), MachineOperand::useDef(RAX, 1) });
+                block->append(MI_MOVZX, { MachineOperand::use(RAX, 1), MachineOperand::def(RAX, 4) });
+                storeSlot(block, instruction.a);
+                return;
+            }
+            bool isStrict = opcode == BC_FLT || opcode == BC_FGT;
+            storeCondition(block, isStrict ? COND_A : COND_AE, instruction.a);
+            return;
+        }
+
+        case BC_TRUNC:
+            loadSlot(block, instruction.b);
+            canonicalize(block, type);
+            storeSlot(block, instruction.a);
+            return;
+
+        case BC_ZEXT:
+            if ( instruction.c == ir::IR_I32 )
+            {
+                block->append(MI_MOV, { slot(instruction.b, 4), MachineOperand::def(RAX, 4) });
+            }
+            else if ( instruction.c == ir::IR_BOOL || instruction.c == ir::IR_I8 || instruction.c == ir::IR_I16 )
+            {
+                uint8_t width = instruction.c == ir::IR_I16 ? 2 : 1;
+                block->append(MI_MOVZX, { slot(instruction.b, width), MachineOperand::def(RAX, 4) });
+            }
+            else
+            {
+                loadSlot(block, instruction.b);
+            }
+            storeSlot(block, instruction.a);
+            return;
+
+        case BC_SEXT:
+            // Values are sign extended already; only booleans change, to 0 or -1.
+            loadSlot(block, instruction.b);
+            if ( instruction.c == ir::IR_BOOL )
+            {
+                block->append(MI_NEG, { MachineOperand::useDef(RAX, 8) });
+            }
+            storeSlot(block, instruction.a);
+            return;
+
+        case BC_SITOFP:
+            // Conversions to floats keep the upper bits of xmm0, which are cleared first.
+            block->append(MI_XORF, { MachineOperand::use(XMM0, 8), MachineOperand::useDef(XMM0, 8) });
+            block->append(MI_CVTSI2F, { slot(instruction.b), MachineOperand::def(XMM0, floatSize) });
+            storeFloat(block, instruction.a);
+            return;
+
+        case BC_FPEXT:
+        case BC_FPTRUNC:
+        {
+            bool isExtension = opcode == BC_FPEXT;
+            block->append(MI_XORF, { MachineOperand::use(XMM0, 8), MachineOperand::useDef(XMM0, 8) });
+            block->append(MI_CVTF2F, { slot(instruction.b, isExtension ? 4 : 8),
+                                       MachineOperand::def(XMM0, isExtension ? 8 : 4) });
+            storeFloat(block, instruction.a);
+            return;
+        }
+
+        case BC_FPTOSI:
+            block->append(MI_CVTF2SI, { slot(instruction.b, instruction.c == ir::IR_F32 ? 4 : 8),
+                                        MachineOperand::def(RAX, 8) });
+            canonicalize(block, type);
+            storeSlot(block, instruction.a);
+            return;
+
+        case BC_LOAD:
+        {
+            block->append(MI_MOV, { slot(instruction.b), MachineOperand::def(RCX, 8) });
+            MachineOperand field = MachineOperand::memory(RCX, instruction.c, size);
+            if ( type == ir::IR_BOOL )
+            {
+                block->append(MI_MOVZX, { field, MachineOperand::def(RAX, 4) });
+                block->append(MI_AND, { MachineOperand::imm(1, 4), MachineOperand::useDef(RAX, 4) });
+            }
+            else if ( type == ir::IR_I8 || type == ir::IR_I16 || type == ir::IR_I32 )
+            {
+                block->append(MI_MOVSX, { field, MachineOperand::def(RAX, 8) });
+            }
+            else
+            {
+                block->append(MI_MOV, { field, MachineOperand::def(RAX, size) });
+            }
+            storeSlot(block, instruction.a);
+            return;
+        }
+
+        case BC_STORE:
+            block->append(MI_MOV, { slot(instruction.a), MachineOperand::def(RCX, 8) });
+            loadSlot(block, instruction.b);
+            block->append(MI_MOV, { MachineOperand::use(RAX, size), MachineOperand::memory(RCX, instruction.c, size) });
+            return;
+
+        case BC_ADDRESS:
+            loadSlot(block, instruction.b);
+            block->append(MI_ADD, { MachineOperand::imm(instruction.c, 8), MachineOperand::useDef(RAX, 8) });
+            storeSlot(block, instruction.a);
+            return;
+
+        case BC_JUMP:
+            block->append(MI_JMP, { MachineOperand::target(blocks[ instruction.wide() ]) });
+            return;
+
+        case BC_JUMP_IF:
+        case BC_JUMP_IF_NOT:
+            loadSlot(block, instruction.a);
+            block->append(MI_TEST, { MachineOperand::use(RAX, 8), MachineOperand::use(RAX, 8) });
+            block->append(MI_JCC, { MachineOperand::target(blocks[ instruction.wide() ]) })->condition =
+                    opcode == BC_JUMP_IF ? COND_NE : COND_E;
+            return;
+
+        case BC_ARGUMENTS:
+            // The arguments of a call, which the interpreter reads.
+            return;
+
+        default:
+            break;
+    }
+    exitTo(block, index);
+}
+
+#if BASELINE_COMPILER_SUPPORTED
+
+const NativeCode *BaselineCompiler::compile(const BytecodeFunction &function)
+{
+    // The entry saves rbx, points it to the registers, and jumps to the instruction to start at.
+    MachineModule module;
+    module.sourceName = function.name;
+    module.functions.push_back(std::make_unique<MachineFunction>(function.name));
+    MachineFunction &machine = *module.functions.back();
+    MachineBlock *entry = machine.createBlock("entry");
+    entry->append(MI_PUSH, { MachineOperand::use(RBX, 8) });
+    entry->append(MI_MOV, { MachineOperand::use(RDI, 8), MachineOperand::def(RBX, 8) });
+    entry->append(MI_JMP_TABLE, { MachineOperand::use(RSI, 8) });
+
+    std::vector<MachineBlock *> blocks;
+    for ( size_t i = 0; i < function.code.size(); i++ )
+    {
+        blocks.push_back(machine.createBlock("bc"));
+    }
+    for ( uint32_t i = 0; i < function.code.size(); i++ )
+    {
+        this->select(function, i, blocks, machine);
+    }
+
+    ObjectFile object;
+    MachineCodeEncoder encoder(object);
+    encoder.encode(module);
+    auto &bytes = object.sections[ SECTION_TEXT ].bytes;
+
+    // The code is written before it's made executable; it's never writable and executable at once.
+    auto code = std::make_unique<NativeCode>();
+    auto pageSize = (size_t) sysconf(_SC_PAGESIZE);
+    size_t size = ( bytes.size() + pageSize - 1 ) / pageSize * pageSize;
+    void *memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if ( memory == MAP_FAILED )
+    {
+        return nullptr;
+    }
+    std::memcpy(memory, bytes.data(), bytes.size());
+    if ( mprotect(memory, size, PROT_READ | PROT_EXEC) != 0 )
+    {
+        munmap(memory, size);
+        return nullptr;
+    }
+    code->start = (uint8_t *) memory;
+    code->size = size;
+    for ( auto block: blocks )
+    {
+        code->offsets.push_back((uint32_t) encoder.blockOffset(block));
+    }
+    this->functions.push_back(std::move(code));
+    return this->functions.back().get();
+}
+
+uint32_t NativeCode::run(uint64_t *registers, uint32_t index) const
+{
+    using Entry = uint32_t (*)(uint64_t *registers, const uint8_t *address);
+    return ((Entry) this->start)(registers, this->start + this->offsets[ index ]);
+}
+
+NativeCode::~NativeCode()
+{
+    if ( this->start != nullptr )
+    {
+        munmap(this->start, this->size);
+    }
+}
+
+#else
+
+const NativeCode *BaselineCompiler::compile(const BytecodeFunction &)
+{
+    return nullptr;
+}
+
+uint32_t NativeCode::run(uint64_t *, uint32_t index) const
+{
+    return index;
+}
+
+NativeCode::~NativeCode() = default;
+
+#endif
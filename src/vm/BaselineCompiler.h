@@ -0,0 +1,79 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_BASELINECOMPILER_H
+#define STRIDE_LANGUAGE_BASELINECOMPILER_H
+
+#include <memory>
+#include <vector>
+#include "Bytecode.h"
+#include "../backend/MachineIR.h"
+
+/**
+ * Whether the baseline compiler generates code on this platform; it emits x86-64 code, in memory
+ * that's mapped with mmap.
+ */
+#if defined(__x86_64__) && !defined(_WIN32)
+#define BASELINE_COMPILER_SUPPORTED 1
+#else
+#define BASELINE_COMPILER_SUPPORTED 0
+#endif
+
+namespace stride::vm
+{
+
+    /**
+     * The machine code of a bytecode function. It can be entered at any instruction, with the registers
+     * of a frame, and runs until it reaches an instruction it leaves to the interpreter, such as a call.
+     */
+    struct NativeCode
+    {
+        uint8_t *start = nullptr;
+        size_t size = 0;
+
+        /**
+         * The offset of the code of every instruction of the function.
+         */
+        std::vector<uint32_t> offsets;
+
+        /**
+         * Runs the code from the instruction at an index.
+         * @return The index of the instruction at which the interpreter continues.
+         */
+        uint32_t run(uint64_t *registers, uint32_t index) const;
+
+        ~NativeCode();
+    };
+
+    /**
+     * Compiles hot bytecode functions to x86-64 machine code, one template of machine instructions per
+     * opcode, which are encoded by the encoder of the native backend.
+     *
+     * The registers of the frame stay in memory, addressed relative to rbx; every instruction loads its
+     * operands and stores its result, so the code can be entered and left at any instruction, and the
+     * interpreter sees the same registers. Jumps stay in the machine code; instructions that need the
+     * interpreter, such as calls, returns, exceptions and allocations, return their index to it, as
+     * do guards that fail, such as a division by 0 or -1.
+     */
+    class BaselineCompiler
+    {
+    private:
+        std::vector<std::unique_ptr<NativeCode>> functions;
+
+        /**
+         * Appends the template of an instruction to its block, or an exit to the interpreter if there's none.
+         */
+        void select(const BytecodeFunction &function, uint32_t index, std::vector<backend::MachineBlock *> &blocks,
+                    backend::MachineFunction &machine);
+
+    public:
+        /**
+         * Compiles a function, which the interpreter has linked.
+         * @return The code, which lives as long as the compiler, or nullptr if the platform isn't supported.
+         */
+        const NativeCode *compile(const BytecodeFunction &function);
+    };
+}
+
+#endif //STRIDE_LANGUAGE_BASELINECOMPILER_H
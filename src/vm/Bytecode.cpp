@@ -0,0 +1,251 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <iomanip>
+#include <stdexcept>
+#include <unordered_map>
+#include "Bytecode.h"
+#include "../ir/IRGenerator.h"
+
+using namespace stride::vm;
+
+const char *stride::vm::bytecodeOpcodeName(EBytecodeOpcode opcode)
+{
+    static const char *names[] = {
+            "move", "const",
+            "add", "sub", "mul", "sdiv", "udiv", "srem", "urem",
+            "fadd", "fsub", "fmul", "fdiv", "frem",
+            "shl", "lshr", "ashr", "and", "or", "xor",
+            "eq", "ne", "lt", "le", "gt", "ge", "ult", "ule", "ugt", "uge",
+            "feq", "fne", "flt", "fle", "fgt", "fge",
+            "trunc", "zext", "sext", "fptrunc", "fpext", "sitofp", "uitofp", "fptosi", "fptoui",
+            "load", "store", "address", "allocate", "array",
+            "call", "call_indirect", "invoke", "invoke_indirect", "arguments", "catch",
+            "jump", "jump_if", "jump_if_not", "switch", "ret", "raise", "throw", "unreachable",
+            "add_i32", "add_i64", "sub_i32", "sub_i64", "mul_i32", "mul_i64",
+            "sdiv_i32", "sdiv_i64", "srem_i32", "srem_i64",
+            "fadd_f32", "fadd_f64", "fsub_f32", "fsub_f64", "fmul_f32", "fmul_f64", "fdiv_f32", "fdiv_f64",
+            "feq_f32", "feq_f64", "fne_f32", "fne_f64", "flt_f32", "flt_f64",
+            "fle_f32", "fle_f64", "fgt_f32", "fgt_f64", "fge_f32", "fge_f64",
+            "load_field_bool", "load_field_i8", "load_field_i16", "load_field_i32",
+            "load_field_u32", "load_field_64",
+            "store_field_8", "store_field_16", "store_field_32", "store_field_64",
+            "call_bytecode", "call_builtin"
+    };
+    static_assert(sizeof(names) / sizeof(names[ 0 ]) == BC_OPCODE_COUNT, "Every opcode has a name");
+    return names[ opcode ];
+}
+
+EBytecodeOpcode stride::vm::genericOpcode(EBytecodeOpcode opcode)
+{
+    // The variants of an opcode are in the order of the generic opcodes.
+    static const EBytecodeOpcode generics[] = {
+            BC_ADD, BC_ADD, BC_SUB, BC_SUB, BC_MUL, BC_MUL,
+            BC_SDIV, BC_SDIV, BC_SREM, BC_SREM,
+            BC_FADD, BC_FADD, BC_FSUB, BC_FSUB, BC_FMUL, BC_FMUL, BC_FDIV, BC_FDIV,
+            BC_FEQ, BC_FEQ, BC_FNE, BC_FNE, BC_FLT, BC_FLT, BC_FLE, BC_FLE, BC_FGT, BC_FGT, BC_FGE, BC_FGE,
+            BC_LOAD, BC_LOAD, BC_LOAD, BC_LOAD, BC_LOAD, BC_LOAD,
+            BC_STORE, BC_STORE, BC_STORE, BC_STORE,
+            BC_CALL, BC_CALL
+    };
+    static_assert(sizeof(generics) / sizeof(generics[ 0 ]) == BC_OPCODE_COUNT - BC_ADD_I32,
+                  "Every quickened opcode has a generic opcode");
+    return opcode < BC_ADD_I32 ? opcode : generics[ opcode - BC_ADD_I32 ];
+}
+
+int32_t BytecodeModule::functionIndex(const std::string &name) const
+{
+    for ( size_t i = 0; i < this->functions.size(); i++ )
+    {
+        if ( this->functions[ i ].name == name )
+        {
+            return (int32_t) i;
+        }
+    }
+    return -1;
+}
+
+static void printConstant(std::ostream &out, const BytecodeModule &module, const Constant &constant)
+{
+    switch ( constant.kind )
+    {
+        case CONSTANT_STRING:
+            out << "\"" << module.strings[ constant.value ] << "\"";
+            break;
+        case CONSTANT_GLOBAL:
+            out << "@" << module.globals[ constant.value ].name;
+            break;
+        case CONSTANT_FUNCTION:
+            out << "@" << module.functions[ constant.value ].name;
+            break;
+        default:
+            out << (int64_t) constant.value;
+            break;
+    }
+}
+
+void BytecodeModule::print(std::ostream &out) const
+{
+    for ( auto &global: this->globals )
+    {
+        out << "global " << global.name << ": " << ir::typeName(global.type) << " = ";
+        printConstant(out, *this, global.initializer);
+        out << "\n";
+    }
+    for ( auto &function: this->functions )
+    {
+        if ( function.kind != FUNCTION_BYTECODE )
+        {
+            out << "\nexternal " << function.name << "\n";
+            continue;
+        }
+        out << "\nfunction " << function.name << " (" << function.argumentCount << " arguments, "
+            << function.registerCount << " registers)\n";
+        for ( size_t pc = 0; pc < function.code.size(); pc++ )
+        {
+            const Instruction &instruction = function.code[ pc ];
+            out << "  " << std::setw(5) << pc << "  " << bytecodeOpcodeName(instruction.opcode);
+            if ( instruction.type != ir::IR_VOID )
+            {
+                out << "." << ir::typeName((ir::EIRType) instruction.type);
+            }
+            switch ( genericOpcode(instruction.opcode))
+            {
+                case BC_LOAD_CONSTANT:
+                    out << " r" << instruction.a << ", ";
+                    printConstant(out, *this, function.constants[ instruction.wide() ]);
+                    break;
+                case BC_ALLOCATE:
+                case BC_ARRAY:
+                case BC_JUMP_IF:
+                case BC_JUMP_IF_NOT:
+                case BC_SWITCH:
+                    out << " r" << instruction.a << ", " << instruction.wide();
+                    break;
+                case BC_JUMP:
+                    out << " " << instruction.wide();
+                    break;
+                case BC_CALL:
+                case BC_INVOKE:
+                    out << " r" << instruction.a << ", " << this->functions[ instruction.b ].name << ", "
+                        << instruction.c;
+                    break;
+                case BC_LOAD:
+                case BC_STORE:
+                case BC_ADDRESS:
+                case BC_CALL_INDIRECT:
+                case BC_INVOKE_INDIRECT:
+                    out << " r" << instruction.a << ", r" << instruction.b << ", " << instruction.c;
+                    break;
+                case BC_ARGUMENTS:
+                    out << " " << instruction.a << " " << instruction.b << " " << instruction.c;
+                    break;
+                case BC_CATCH:
+                case BC_RETURN:
+                case BC_RAISE:
+                case BC_THROW:
+                    out << " r" << instruction.a;
+                    break;
+                case BC_UNREACHABLE:
+                    break;
+                case BC_MOVE:
+                case BC_TRUNC:
+                case BC_ZEXT:
+                case BC_SEXT:
+                case BC_FPTRUNC:
+                case BC_FPEXT:
+                case BC_SITOFP:
+                case BC_UITOFP:
+                case BC_FPTOSI:
+                case BC_FPTOUI:
+                    out << " r" << instruction.a << ", r" << instruction.b;
+                    break;
+                default:
+                    out << " r" << instruction.a << ", r" << instruction.b << ", r" << instruction.c;
+                    break;
+            }
+            out << "\n";
+        }
+    }
+}
+
+BytecodeModule stride::vm::linkModules(const std::string &name, const std::vector<const BytecodeModule *> &units)
+{
+    BytecodeModule result(name);
+    std::vector<size_t> functionBases, globalBases, stringBases;
+    for ( auto unit: units )
+    {
+        functionBases.push_back(result.functions.size());
+        globalBases.push_back(result.globals.size());
+        stringBases.push_back(result.strings.size());
+        result.functions.insert(result.functions.end(), unit->functions.begin(), unit->functions.end());
+        result.globals.insert(result.globals.end(), unit->globals.begin(), unit->globals.end());
+        result.strings.insert(result.strings.end(), unit->strings.begin(), unit->strings.end());
+    }
+    if ( result.functions.size() > 0xFFFF )
+    {
+        throw std::runtime_error("Program " + name + " has too many functions for the interpreter");
+    }
+
+    // The first definition of a name is the one external functions are bound to.
+    std::unordered_map<std::string, uint16_t> definitions;
+    for ( size_t i = 0; i < result.functions.size(); i++ )
+    {
+        if ( result.functions[ i ].kind == FUNCTION_BYTECODE && result.functions[ i ].name != MODULE_INITIALIZER_NAME )
+        {
+            definitions.emplace(result.functions[ i ].name, (uint16_t) i);
+        }
+    }
+    std::vector<uint16_t> targets(result.functions.size());
+    for ( size_t i = 0; i < result.functions.size(); i++ )
+    {
+        auto definition = result.functions[ i ].kind == FUNCTION_EXTERNAL ?
+                          definitions.find(result.functions[ i ].name) : definitions.end();
+        targets[ i ] = definition != definitions.end() ? definition->second : (uint16_t) i;
+    }
+
+    for ( size_t unit = 0; unit < units.size(); unit++ )
+    {
+        auto rebase = [ & ](Constant &constant)
+        {
+            switch ( constant.kind )
+            {
+                case CONSTANT_STRING:
+                    constant.value += stringBases[ unit ];
+                    break;
+                case CONSTANT_GLOBAL:
+                    constant.value += globalBases[ unit ];
+                    break;
+                case CONSTANT_FUNCTION:
+                    constant.value = targets[ functionBases[ unit ] + constant.value ];
+                    break;
+                default:
+                    break;
+            }
+        };
+
+        for ( size_t i = 0; i < units[ unit ]->globals.size(); i++ )
+        {
+            rebase(result.globals[ globalBases[ unit ] + i ].initializer);
+        }
+        for ( size_t i = 0; i < units[ unit ]->functions.size(); i++ )
+        {
+            BytecodeFunction &function = result.functions[ functionBases[ unit ] + i ];
+            for ( auto &constant: function.constants )
+            {
+                rebase(constant);
+            }
+            for ( auto &instruction: function.code )
+            {
+                EBytecodeOpcode opcode = genericOpcode(instruction.opcode);
+                if ( opcode == BC_CALL || opcode == BC_INVOKE )
+                {
+                    instruction.opcode = opcode;
+                    instruction.b = targets[ functionBases[ unit ] + instruction.b ];
+                }
+            }
+        }
+    }
+    return result;
+}
@@ -0,0 +1,237 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_BYTECODE_H
+#define STRIDE_LANGUAGE_BYTECODE_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "../ir/IR.h"
+
+/**
+ * The register that calls without a result write to.
+ */
+#define BYTECODE_NO_RESULT 0xFFFF
+
+namespace stride::vm
+{
+
+    /**
+     * The opcodes of the bytecode. Registers are 64 bits wide; integers are kept sign extended
+     * and floats as their bits. Operations of several types carry the type in the instruction;
+     * conversions carry the source type in 'c'.
+     */
+    enum EBytecodeOpcode : uint8_t
+    {
+        BC_MOVE,          // a = b
+        BC_LOAD_CONSTANT, // a = the constant at index wide()
+
+        BC_ADD, BC_SUB, BC_MUL, BC_SDIV, BC_UDIV, BC_SREM, BC_UREM, // a = b op c
+        BC_FADD, BC_FSUB, BC_FMUL, BC_FDIV, BC_FREM,
+        BC_SHL, BC_LSHR, BC_ASHR, BC_AND, BC_OR, BC_XOR,
+
+        BC_EQ, BC_NE, BC_LT, BC_LE, BC_GT, BC_GE, BC_ULT, BC_ULE, BC_UGT, BC_UGE, // a = b op c, of type
+        BC_FEQ, BC_FNE, BC_FLT, BC_FLE, BC_FGT, BC_FGE,
+
+        BC_TRUNC, BC_ZEXT, BC_SEXT, BC_FPTRUNC, BC_FPEXT, BC_SITOFP, BC_UITOFP, BC_FPTOSI, BC_FPTOUI, // a = b
+
+        BC_LOAD,      // a = the value at address b + c
+        BC_STORE,     // Stores b at address a + c
+        BC_ADDRESS,   // a = b + c
+        BC_ALLOCATE,  // a = a zeroed object of wide() bytes
+        BC_ARRAY,     // a = an array of wide() zeroed elements of type
+
+        BC_CALL,          // a = function b, called with c arguments, which follow in BC_ARGUMENTS
+        BC_CALL_INDIRECT, // a = the function at address b, called with c arguments
+        BC_INVOKE,        // Calls like BC_CALL; the handler follows the arguments, as wide() of a BC_ARGUMENTS
+        BC_INVOKE_INDIRECT,
+        BC_ARGUMENTS,     // Up to 3 argument registers of the preceding call; type holds their classes
+        BC_CATCH,         // a = the exception
+
+        BC_JUMP,          // Continues at wide()
+        BC_JUMP_IF,       // Continues at wide() if a is true
+        BC_JUMP_IF_NOT,
+        BC_SWITCH,        // Continues at the target of switch table wide() for a
+        BC_RETURN,        // Returns a, unless type is void
+        BC_RAISE,         // Stores a as the exception, which is thrown to a handler of this function
+        BC_THROW,         // Throws a to the nearest caller that handles it
+        BC_UNREACHABLE,
+
+        // Quickened opcodes, which the compiler never emits. The interpreter rewrites a generic instruction
+        // into one of these when it first executes it, specialized for its type or callee.
+
+        BC_ADD_I32, BC_ADD_I64, BC_SUB_I32, BC_SUB_I64, BC_MUL_I32, BC_MUL_I64,
+        BC_SDIV_I32, BC_SDIV_I64, BC_SREM_I32, BC_SREM_I64, // Guarded; a divisor of 0 or -1 takes the generic path
+        BC_FADD_F32, BC_FADD_F64, BC_FSUB_F32, BC_FSUB_F64, BC_FMUL_F32, BC_FMUL_F64, BC_FDIV_F32, BC_FDIV_F64,
+        BC_FEQ_F32, BC_FEQ_F64, BC_FNE_F32, BC_FNE_F64, BC_FLT_F32, BC_FLT_F64,
+        BC_FLE_F32, BC_FLE_F64, BC_FGT_F32, BC_FGT_F64, BC_FGE_F32, BC_FGE_F64,
+        BC_LOAD_FIELD_BOOL, BC_LOAD_FIELD_I8, BC_LOAD_FIELD_I16, BC_LOAD_FIELD_I32, // a = the value at b + c
+        BC_LOAD_FIELD_U32, BC_LOAD_FIELD_64,
+        BC_STORE_FIELD_8, BC_STORE_FIELD_16, BC_STORE_FIELD_32, BC_STORE_FIELD_64,
+        BC_CALL_BYTECODE, // Calls like BC_CALL, a function of the module
+        BC_CALL_BUILTIN,  // Calls like BC_CALL, a function of the runtime of the interpreter
+
+        BC_OPCODE_COUNT
+    };
+
+    const char *bytecodeOpcodeName(EBytecodeOpcode opcode);
+
+    /**
+     * Returns the generic opcode of a quickened opcode, or the opcode itself if it's generic.
+     */
+    EBytecodeOpcode genericOpcode(EBytecodeOpcode opcode);
+
+    /**
+     * How an argument of a call is passed to native functions; 2 bits per argument, in the type of BC_ARGUMENTS.
+     */
+    enum EArgumentClass : uint8_t
+    {
+        ARGUMENT_INTEGER = 0,
+        ARGUMENT_F32 = 1,
+        ARGUMENT_F64 = 2
+    };
+
+    /**
+     * An instruction of 8 bytes; three registers, or a register and a 32-bit index or target.
+     */
+    struct Instruction
+    {
+        EBytecodeOpcode opcode;
+        uint8_t type;
+        uint16_t a;
+        uint16_t b;
+        uint16_t c;
+
+        [[nodiscard]] uint32_t wide() const
+        { return this->b | (uint32_t) this->c << 16; }
+
+        void setWide(uint32_t value)
+        {
+            this->b = (uint16_t) value;
+            this->c = (uint16_t) ( value >> 16 );
+        }
+    };
+
+    static_assert(sizeof(Instruction) == 8, "Instructions are 8 bytes");
+
+    enum EConstantKind : uint8_t
+    {
+        CONSTANT_VALUE,    // The bits of a number
+        CONSTANT_STRING,   // The address of an interned string of the module
+        CONSTANT_GLOBAL,   // The address of a global of the module
+        CONSTANT_FUNCTION  // The address of a function of the module
+    };
+
+    /**
+     * An entry of the constant pool of a function. Addresses are stored as indices,
+     * and resolved by the interpreter when it loads the module.
+     */
+    struct Constant
+    {
+        EConstantKind kind;
+        uint64_t value;
+
+        bool operator==(const Constant &other) const
+        { return this->kind == other.kind && this->value == other.value; }
+    };
+
+    /**
+     * The cases of a switch, sorted by value, with the targets at the same index.
+     */
+    struct SwitchTable
+    {
+        std::vector<int64_t> values;
+        std::vector<uint32_t> targets;
+        uint32_t defaultTarget = 0;
+    };
+
+    /**
+     * How a function is called. Functions of other units are external, until the interpreter
+     * finds them in its runtime, or as a native function of the same name.
+     */
+    enum EFunctionKind : uint8_t
+    {
+        FUNCTION_BYTECODE,
+        FUNCTION_EXTERNAL,
+        FUNCTION_BUILTIN,
+        FUNCTION_NATIVE
+    };
+
+    struct NativeCode;
+
+    struct BytecodeFunction
+    {
+        std::string name;
+        EFunctionKind kind = FUNCTION_BYTECODE;
+        ir::EIRType returnType = ir::IR_VOID;
+        uint16_t argumentCount = 0;
+
+        /**
+         * The amount of registers of a frame; the arguments are the first ones.
+         */
+        uint16_t registerCount = 0;
+        std::vector<Instruction> code;
+        std::vector<Constant> constants;
+        std::vector<SwitchTable> switches;
+
+        /**
+         * The constants with their addresses resolved, and the address of builtin and native functions.
+         * These are set by the interpreter when it loads the module.
+         */
+        std::vector<uint64_t> values;
+        void *address = nullptr;
+
+        /**
+         * How often the function was called, and jumped back to the start of a loop; the interpreter
+         * compiles functions to machine code once either is high enough.
+         */
+        uint32_t invocations = 0;
+        uint32_t backEdges = 0;
+        const NativeCode *native = nullptr;
+    };
+
+    struct BytecodeGlobal
+    {
+        std::string name;
+        ir::EIRType type;
+        Constant initializer;
+    };
+
+    /**
+     * The bytecode of a compilation unit. Functions refer to each other by their index.
+     */
+    class BytecodeModule
+    {
+    public:
+        std::string name;
+        std::vector<BytecodeFunction> functions;
+        std::vector<BytecodeGlobal> globals;
+        std::vector<std::string> strings;
+
+        explicit BytecodeModule(std::string name) : name(std::move(name))
+        {}
+
+        /**
+         * Returns the index of a function, or -1 if the module has none of that name.
+         */
+        [[nodiscard]] int32_t functionIndex(const std::string &name) const;
+
+        /**
+         * Prints the bytecode of all functions, e.g. for '--emit-bytecode'.
+         */
+        void print(std::ostream &out) const;
+    };
+
+    /**
+     * Links the bytecode of several compilation units into a single module, in the given order.
+     * External functions are bound to the bytecode function of the same name of another unit, if any.
+     * The initializers of the units are all kept, under the same name, so they can run in order.
+     * @throws std::runtime_error If the linked module has too many functions for the interpreter.
+     */
+    BytecodeModule linkModules(const std::string &name, const std::vector<const BytecodeModule *> &units);
+}
+
+#endif //STRIDE_LANGUAGE_BYTECODE_H
@@ -0,0 +1,607 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "BytecodeCompiler.h"
+
+using namespace stride;
+using namespace stride::vm;
+
+static uint8_t argumentClassOf(ir::EIRType type)
+{
+    return type == ir::IR_F32 ? ARGUMENT_F32 : type == ir::IR_F64 ? ARGUMENT_F64 : ARGUMENT_INTEGER;
+}
+
+uint32_t BytecodeCompiler::internString(const std::string &value)
+{
+    auto known = this->stringIndices.find(value);
+    if ( known != this->stringIndices.end())
+    {
+        return known->second;
+    }
+    auto index = (uint32_t) this->module->strings.size();
+    this->module->strings.push_back(value);
+    this->stringIndices[ value ] = index;
+    return index;
+}
+
+Constant BytecodeCompiler::constantOf(ir::Value *value)
+{
+    switch ( value->kind )
+    {
+        case ir::VALUE_CONSTANT:
+        {
+            auto constant = static_cast<ir::Constant *>(value);
+            if ( constant->isString )
+            {
+                return { CONSTANT_STRING, this->internString(constant->string) };
+            }
+            uint64_t bits = constant->integer;
+            if ( value->type == ir::IR_F32 )
+            {
+                auto single = (float) constant->floating;
+                uint32_t singleBits;
+                std::memcpy(&singleBits, &single, sizeof(singleBits));
+                bits = singleBits;
+            }
+            else if ( value->type == ir::IR_F64 )
+            {
+                std::memcpy(&bits, &constant->floating, sizeof(bits));
+            }
+            return { CONSTANT_VALUE, bits };
+        }
+        case ir::VALUE_GLOBAL:
+            return { CONSTANT_GLOBAL, this->globalIndices.at(static_cast<ir::Global *>(value)) };
+        case ir::VALUE_FUNCTION:
+            return { CONSTANT_FUNCTION, this->functionIndices.at(static_cast<ir::Function *>(value)) };
+        default:
+            return { CONSTANT_VALUE, 0 };
+    }
+}
+
+uint32_t BytecodeCompiler::poolIndex(const Constant &constant)
+{
+    auto &constants = this->function->constants;
+    auto known = std::find(constants.begin(), constants.end(), constant);
+    if ( known != constants.end())
+    {
+        return (uint32_t) ( known - constants.begin());
+    }
+    constants.push_back(constant);
+    return (uint32_t) constants.size() - 1;
+}
+
+uint16_t BytecodeCompiler::registerOf(ir::Value *value)
+{
+    if ( value->kind == ir::VALUE_ARGUMENT || value->kind == ir::VALUE_INSTRUCTION )
+    {
+        return (uint16_t) value->id;
+    }
+    return this->constantRegisters.at(value);
+}
+
+uint16_t BytecodeCompiler::temporary()
+{
+    uint32_t index = this->registerCount + this->temporaryCount++;
+    if ( index >= BYTECODE_NO_RESULT )
+    {
+        throw std::runtime_error("Function " + this->function->name + " has too many values for the interpreter");
+    }
+    this->function->registerCount = std::max(this->function->registerCount, (uint16_t) ( index + 1 ));
+    return (uint16_t) index;
+}
+
+uint32_t BytecodeCompiler::emit(EBytecodeOpcode opcode, uint8_t type, uint32_t a, uint32_t b, uint32_t c)
+{
+    this->function->code.push_back({ opcode, type, (uint16_t) a, (uint16_t) b, (uint16_t) c });
+    return (uint32_t) this->function->code.size() - 1;
+}
+
+uint32_t BytecodeCompiler::emitWide(EBytecodeOpcode opcode, uint8_t type, uint32_t a, uint32_t wide)
+{
+    uint32_t position = this->emit(opcode, type, a, 0, 0);
+    this->function->code[ position ].setWide(wide);
+    return position;
+}
+
+void BytecodeCompiler::emitJump(EBytecodeOpcode opcode, uint32_t condition, const ir::BasicBlock *target)
+{
+    this->jumpFixups.emplace_back(this->emit(opcode, ir::IR_VOID, condition, 0, 0), target);
+}
+
+void BytecodeCompiler::emitMemoryAccess(EBytecodeOpcode opcode, ir::EIRType type, uint16_t base, uint64_t offset,
+                                        uint16_t value)
+{
+    if ( offset > 0xFFFF )
+    {
+        uint16_t address = this->temporary();
+        this->emitWide(BC_LOAD_CONSTANT, ir::IR_I64, address, this->poolIndex({ CONSTANT_VALUE, offset }));
+        this->emit(BC_ADD, ir::IR_PTR, address, base, address);
+        base = address;
+        offset = 0;
+    }
+    if ( opcode == BC_LOAD )
+    {
+        this->emit(BC_LOAD, type, value, base, offset);
+    }
+    else
+    {
+        this->emit(BC_STORE, type, base, value, offset);
+    }
+}
+
+bool BytecodeCompiler::isFolded(const ir::Instruction *fieldAddress)
+{
+    return std::all_of(fieldAddress->users.begin(), fieldAddress->users.end(), [ fieldAddress ](ir::Instruction *user)
+    {
+        return user->opcode == ir::OP_LOAD ||
+               ( user->opcode == ir::OP_STORE && user->operands[ 0 ] == fieldAddress &&
+                 user->operands[ 1 ] != fieldAddress );
+    });
+}
+
+// Control flow
+
+bool BytecodeCompiler::hasPhis(const ir::BasicBlock *block)
+{
+    return !block->instructions.empty() && block->instructions.front()->opcode == ir::OP_PHI;
+}
+
+void BytecodeCompiler::emitPhiCopies(const ir::BasicBlock *predecessor, const ir::BasicBlock *successor)
+{
+    std::vector<std::pair<uint16_t, uint16_t>> copies;
+    bool readsPhi = false;
+    for ( auto phi: successor->instructions )
+    {
+        if ( phi->opcode != ir::OP_PHI )
+        {
+            break;
+        }
+        auto incoming = std::find(phi->targets.begin(), phi->targets.end(), predecessor);
+        ir::Value *value = phi->operands[ incoming - phi->targets.begin() ];
+        if ( value != phi )
+        {
+            copies.emplace_back(this->registerOf(phi), this->registerOf(value));
+            readsPhi |= value->kind == ir::VALUE_INSTRUCTION &&
+                        static_cast<ir::Instruction *>(value)->opcode == ir::OP_PHI &&
+                        static_cast<ir::Instruction *>(value)->block == successor;
+        }
+    }
+
+    // Phi nodes are assigned at once; if one reads another, all values are copied to temporaries first.
+    if ( readsPhi )
+    {
+        std::vector<uint16_t> temporaries;
+        for ( auto &[ phi, value ]: copies )
+        {
+            temporaries.push_back(this->temporary());
+            this->emit(BC_MOVE, ir::IR_VOID, temporaries.back(), value, 0);
+        }
+        for ( size_t i = 0; i < copies.size(); i++ )
+        {
+            copies[ i ].second = temporaries[ i ];
+        }
+    }
+    for ( auto &[ phi, value ]: copies )
+    {
+        this->emit(BC_MOVE, ir::IR_VOID, phi, value, 0);
+    }
+}
+
+void BytecodeCompiler::emitEdge(const ir::BasicBlock *predecessor, const ir::BasicBlock *successor,
+                                const ir::BasicBlock *next)
+{
+    this->emitPhiCopies(predecessor, successor);
+    if ( successor != next )
+    {
+        this->emitJump(BC_JUMP, 0, successor);
+    }
+}
+
+// Instructions
+
+uint32_t BytecodeCompiler::emitCall(ir::Instruction *instruction, bool invokes)
+{
+    ir::Value *callee = instruction->operands[ 0 ];
+    size_t argumentCount = instruction->operands.size() - 1;
+    if ( argumentCount > 0xFFFF )
+    {
+        throw std::runtime_error("Function " + this->function->name + " has a call with too many arguments");
+    }
+
+    uint32_t result = instruction->type == ir::IR_VOID ? BYTECODE_NO_RESULT : this->registerOf(instruction);
+    if ( callee->kind == ir::VALUE_FUNCTION )
+    {
+        this->emit(invokes ? BC_INVOKE : BC_CALL, instruction->type, result,
+                   this->functionIndices.at(static_cast<ir::Function *>(callee)), argumentCount);
+    }
+    else
+    {
+        this->emit(invokes ? BC_INVOKE_INDIRECT : BC_CALL_INDIRECT, instruction->type, result,
+                   this->registerOf(callee), argumentCount);
+    }
+
+    for ( size_t i = 0; i < argumentCount; i += 3 )
+    {
+        uint16_t registers[3] = {};
+        uint8_t classes = 0;
+        for ( size_t j = 0; j < 3 && i + j < argumentCount; j++ )
+        {
+            ir::Value *argument = instruction->operands[ 1 + i + j ];
+            registers[ j ] = this->registerOf(argument);
+            classes |= argumentClassOf(argument->type) << ( j * 2 );
+        }
+        this->emit(BC_ARGUMENTS, classes, registers[ 0 ], registers[ 1 ], registers[ 2 ]);
+    }
+    return invokes ? this->emit(BC_ARGUMENTS, ir::IR_VOID, 0, 0, 0) : 0;
+}
+
+void BytecodeCompiler::compileInstruction(ir::Instruction *instruction, const ir::BasicBlock *next)
+{
+    auto &operands = instruction->operands;
+    auto &targets = instruction->targets;
+    const ir::BasicBlock *block = instruction->block;
+    auto operand = [ & ](size_t index)
+    { return this->registerOf(operands[ index ]); };
+
+    switch ( instruction->opcode )
+    {
+        case ir::OP_PHI:
+            // Assigned on the edges that lead to the block.
+            break;
+
+        case ir::OP_ADD:
+        case ir::OP_SUB:
+        case ir::OP_MUL:
+        case ir::OP_SDIV:
+        case ir::OP_UDIV:
+        case ir::OP_SREM:
+        case ir::OP_UREM:
+        case ir::OP_FADD:
+        case ir::OP_FSUB:
+        case ir::OP_FMUL:
+        case ir::OP_FDIV:
+        case ir::OP_FREM:
+        case ir::OP_SHL:
+        case ir::OP_LSHR:
+        case ir::OP_ASHR:
+        case ir::OP_AND:
+        case ir::OP_OR:
+        case ir::OP_XOR:
+            this->emit((EBytecodeOpcode) ( BC_ADD + ( instruction->opcode - ir::OP_ADD )), instruction->type,
+                       this->registerOf(instruction), operand(0), operand(1));
+            break;
+
+        case ir::OP_ICMP:
+            this->emit((EBytecodeOpcode) ( BC_EQ + (int) instruction->predicate ), operands[ 0 ]->type,
+                       this->registerOf(instruction), operand(0), operand(1));
+            break;
+
+        case ir::OP_FCMP:
+        {
+            // Floats compare unordered only when they're not equal, as the native backend does.
+            int predicate = instruction->predicate >= ir::PREDICATE_ULT ?
+                            instruction->predicate - ( ir::PREDICATE_ULT - ir::PREDICATE_LT ) : instruction->predicate;
+            this->emit((EBytecodeOpcode) ( BC_FEQ + predicate ), operands[ 0 ]->type, this->registerOf(instruction),
+                       operand(0), operand(1));
+            break;
+        }
+
+        case ir::OP_TRUNC:
+        case ir::OP_ZEXT:
+        case ir::OP_SEXT:
+        case ir::OP_FPTRUNC:
+        case ir::OP_FPEXT:
+        case ir::OP_SITOFP:
+        case ir::OP_UITOFP:
+        case ir::OP_FPTOSI:
+        case ir::OP_FPTOUI:
+            this->emit((EBytecodeOpcode) ( BC_TRUNC + ( instruction->opcode - ir::OP_TRUNC )), instruction->type,
+                       this->registerOf(instruction), operand(0), operands[ 0 ]->type);
+            break;
+
+        case ir::OP_LOAD:
+        case ir::OP_STORE:
+        {
+            // Field addresses are added by the access itself.
+            ir::Value *address = operands[ 0 ];
+            uint16_t base;
+            uint64_t offset = 0;
+            if ( address->kind == ir::VALUE_INSTRUCTION &&
+                 static_cast<ir::Instruction *>(address)->opcode == ir::OP_FIELD_ADDRESS &&
+                 isFolded(static_cast<ir::Instruction *>(address)))
+            {
+                auto field = static_cast<ir::Instruction *>(address);
+                base = this->registerOf(field->operands[ 0 ]);
+                offset = this->layouts.fieldOffset(field->field);
+            }
+            else
+            {
+                base = this->registerOf(address);
+            }
+            if ( instruction->opcode == ir::OP_LOAD )
+            {
+                this->emitMemoryAccess(BC_LOAD, instruction->type, base, offset, this->registerOf(instruction));
+            }
+            else
+            {
+                this->emitMemoryAccess(BC_STORE, operands[ 1 ]->type, base, offset, operand(1));
+            }
+            break;
+        }
+
+        case ir::OP_FIELD_ADDRESS:
+        {
+            if ( isFolded(instruction))
+            {
+                break;
+            }
+            uint32_t offset = this->layouts.fieldOffset(instruction->field);
+            if ( offset > 0xFFFF )
+            {
+                uint16_t value = this->temporary();
+                this->emitWide(BC_LOAD_CONSTANT, ir::IR_I64, value, this->poolIndex({ CONSTANT_VALUE, offset }));
+                this->emit(BC_ADD, ir::IR_PTR, this->registerOf(instruction), operand(0), value);
+                break;
+            }
+            this->emit(BC_ADDRESS, ir::IR_PTR, this->registerOf(instruction), operand(0), offset);
+            break;
+        }
+
+        case ir::OP_ALLOCATE:
+        {
+            // The arguments are assigned to the fields the type declares, in order of declaration.
+            const semantic::TypeLayout *layout = this->layouts.layoutOf(instruction->allocated);
+            uint16_t object = this->registerOf(instruction);
+            this->emitWide(BC_ALLOCATE, ir::IR_PTR, object, std::max(layout != nullptr ? layout->size : 0, 1u));
+            std::vector<const semantic::FieldLayout *> fields = this->layouts.declaredFields(instruction->allocated);
+            for ( size_t i = 0; i < operands.size() && i < fields.size(); i++ )
+            {
+                if ( fields[ i ]->size == ir::sizeOf(operands[ i ]->type))
+                {
+                    this->emitMemoryAccess(BC_STORE, operands[ i ]->type, object, fields[ i ]->offset, operand(i));
+                }
+            }
+            break;
+        }
+
+        case ir::OP_ARRAY:
+        {
+            // The descriptor refers to the elements at offset 0.
+            uint16_t array = this->registerOf(instruction);
+            uint32_t elementSize = std::max(ir::sizeOf(instruction->elementType), 1u);
+            this->emitWide(BC_ARRAY, instruction->elementType, array, operands.size());
+            if ( !operands.empty())
+            {
+                uint16_t elements = this->temporary();
+                this->emit(BC_LOAD, ir::IR_PTR, elements, array, 0);
+                for ( size_t i = 0; i < operands.size(); i++ )
+                {
+                    this->emitMemoryAccess(BC_STORE, instruction->elementType, elements, i * elementSize, operand(i));
+                }
+            }
+            break;
+        }
+
+        case ir::OP_CALL:
+            this->emitCall(instruction, false);
+            break;
+
+        case ir::OP_LANDING_PAD:
+            this->emit(BC_CATCH, instruction->type, this->registerOf(instruction), 0, 0);
+            break;
+
+        case ir::OP_BRANCH:
+            this->emitEdge(block, targets[ 0 ], next);
+            break;
+
+        case ir::OP_CONDITIONAL_BRANCH:
+            if ( hasPhis(targets[ 0 ]) || hasPhis(targets[ 1 ]))
+            {
+                uint32_t jump = this->emit(BC_JUMP_IF_NOT, ir::IR_VOID, operand(0), 0, 0);
+                this->emitEdge(block, targets[ 0 ], nullptr);
+                this->function->code[ jump ].setWide(this->function->code.size());
+                this->emitEdge(block, targets[ 1 ], next);
+            }
+            else if ( targets[ 0 ] == next )
+            {
+                this->emitJump(BC_JUMP_IF_NOT, operand(0), targets[ 1 ]);
+            }
+            else
+            {
+                this->emitJump(BC_JUMP_IF, operand(0), targets[ 0 ]);
+                this->emitEdge(block, targets[ 1 ], next);
+            }
+            break;
+
+        case ir::OP_SWITCH:
+        {
+            // The cases of a target with phi nodes continue at their assignments, which follow the switch.
+            auto table = (uint32_t) this->function->switches.size();
+            this->function->switches.emplace_back();
+            this->emitWide(BC_SWITCH, operands[ 0 ]->type, operand(0), table);
+
+            std::vector<std::pair<int64_t, const ir::BasicBlock *>> cases;
+            for ( size_t i = 1; i < operands.size(); i++ )
+            {
+                cases.emplace_back(static_cast<ir::Constant *>(operands[ i ])->integer, targets[ i ]);
+            }
+            std::sort(cases.begin(), cases.end(), [](auto &first, auto &second)
+            { return first.first < second.first; });
+
+            std::unordered_map<const ir::BasicBlock *, uint32_t> entries;
+            auto entryOf = [ & ](const ir::BasicBlock *target, int64_t index) -> uint32_t
+            {
+                if ( !hasPhis(target))
+                {
+                    this->caseFixups.push_back({ table, index, target });
+                    return 0;
+                }
+                auto known = entries.find(target);
+                if ( known != entries.end())
+                {
+                    return known->second;
+                }
+                auto entry = (uint32_t) this->function->code.size();
+                this->emitEdge(block, target, nullptr);
+                entries[ target ] = entry;
+                return entry;
+            };
+
+            SwitchTable switchTable;
+            for ( size_t i = 0; i < cases.size(); i++ )
+            {
+                switchTable.values.push_back(cases[ i ].first);
+                switchTable.targets.push_back(entryOf(cases[ i ].second, (int64_t) i));
+            }
+            switchTable.defaultTarget = entryOf(targets[ 0 ], -1);
+            this->function->switches[ table ] = std::move(switchTable);
+            break;
+        }
+
+        case ir::OP_RETURN:
+            if ( operands.empty())
+            {
+                this->emit(BC_RETURN, ir::IR_VOID, 0, 0, 0);
+            }
+            else
+            {
+                this->emit(BC_RETURN, this->function->returnType, operand(0), 0, 0);
+            }
+            break;
+
+        case ir::OP_INVOKE:
+        {
+            uint32_t handler = this->emitCall(instruction, true);
+            this->emitEdge(block, targets[ 0 ], next);
+            if ( hasPhis(targets[ 1 ]))
+            {
+                this->function->code[ handler ].setWide(this->function->code.size());
+                this->emitEdge(block, targets[ 1 ], nullptr);
+            }
+            else
+            {
+                this->jumpFixups.emplace_back(handler, targets[ 1 ]);
+            }
+            break;
+        }
+
+        case ir::OP_THROW:
+            if ( targets.empty())
+            {
+                this->emit(BC_THROW, operands[ 0 ]->type, operand(0), 0, 0);
+            }
+            else
+            {
+                this->emit(BC_RAISE, operands[ 0 ]->type, operand(0), 0, 0);
+                this->emitEdge(block, targets[ 0 ], next);
+            }
+            break;
+
+        default:
+            this->emit(BC_UNREACHABLE, ir::IR_VOID, 0, 0, 0);
+            break;
+    }
+}
+
+void BytecodeCompiler::compileFunction(ir::Function *source, BytecodeFunction &target)
+{
+    this->function = &target;
+    this->constantRegisters.clear();
+    this->jumpFixups.clear();
+    this->caseFixups.clear();
+    source->renumber();
+
+    // Constants are loaded once, before the first block; their registers follow those of the values.
+    this->registerCount = source->valueCount;
+    for ( auto block: source->blocks )
+    {
+        for ( auto instruction: block->instructions )
+        {
+            for ( auto value: instruction->operands )
+            {
+                if ( value->kind != ir::VALUE_ARGUMENT && value->kind != ir::VALUE_INSTRUCTION &&
+                     !this->constantRegisters.count(value))
+                {
+                    auto index = (uint16_t) this->registerCount++;
+                    this->constantRegisters[ value ] = index;
+                    this->emitWide(BC_LOAD_CONSTANT, value->type, index, this->poolIndex(this->constantOf(value)));
+                }
+            }
+        }
+    }
+    if ( this->registerCount >= BYTECODE_NO_RESULT )
+    {
+        throw std::runtime_error("Function " + source->name + " has too many values for the interpreter");
+    }
+    target.registerCount = (uint16_t) this->registerCount;
+
+    this->blockOffsets.assign(source->blocks.size(), 0);
+    for ( size_t i = 0; i < source->blocks.size(); i++ )
+    {
+        ir::BasicBlock *block = source->blocks[ i ];
+        const ir::BasicBlock *next = i + 1 < source->blocks.size() ? source->blocks[ i + 1 ] : nullptr;
+        this->blockOffsets[ block->id ] = (uint32_t) target.code.size();
+        for ( auto instruction: block->instructions )
+        {
+            this->temporaryCount = 0;
+            this->compileInstruction(instruction, next);
+        }
+    }
+
+    for ( auto &[ position, block ]: this->jumpFixups )
+    {
+        target.code[ position ].setWide(this->blockOffsets[ block->id ]);
+    }
+    for ( auto &fixup: this->caseFixups )
+    {
+        SwitchTable &table = target.switches[ fixup.table ];
+        ( fixup.index < 0 ? table.defaultTarget : table.targets[ fixup.index ] ) = this->blockOffsets[ fixup.target->id ];
+    }
+}
+
+std::unique_ptr<BytecodeModule> BytecodeCompiler::compile(const ir::Module &source)
+{
+    auto result = std::make_unique<BytecodeModule>(source.name);
+    this->module = result.get();
+    if ( source.functions.size() > 0xFFFF )
+    {
+        throw std::runtime_error("Module " + source.name + " has too many functions for the interpreter");
+    }
+
+    for ( auto global: source.globals )
+    {
+        this->globalIndices[ global ] = (uint32_t) result->globals.size();
+        result->globals.push_back({ global->name, global->valueType, { CONSTANT_VALUE, 0 }});
+    }
+    for ( auto function: source.functions )
+    {
+        this->functionIndices[ function ] = (uint16_t) result->functions.size();
+        BytecodeFunction bytecode;
+        bytecode.name = function->name;
+        bytecode.kind = function->external || function->blocks.empty() ? FUNCTION_EXTERNAL : FUNCTION_BYTECODE;
+        bytecode.returnType = function->returnType;
+        bytecode.argumentCount = (uint16_t) function->arguments.size();
+        result->functions.push_back(std::move(bytecode));
+    }
+
+    // Strings of initializers are interned with those of the functions.
+    for ( auto global: source.globals )
+    {
+        if ( global->initializer != nullptr )
+        {
+            result->globals[ this->globalIndices[ global ]].initializer = this->constantOf(global->initializer);
+        }
+    }
+    for ( size_t i = 0; i < source.functions.size(); i++ )
+    {
+        if ( result->functions[ i ].kind == FUNCTION_BYTECODE )
+        {
+            this->compileFunction(source.functions[ i ], result->functions[ i ]);
+        }
+    }
+    return result;
+}
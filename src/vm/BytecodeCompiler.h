@@ -0,0 +1,114 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_BYTECODECOMPILER_H
+#define STRIDE_LANGUAGE_BYTECODECOMPILER_H
+
+#include <memory>
+#include <unordered_map>
+#include "Bytecode.h"
+#include "../semantic/LayoutEngine.h"
+
+namespace stride::vm
+{
+
+    /**
+     * Compiles the IR of a module to bytecode for the interpreter.
+     *
+     * Every argument and instruction gets the register of its id, and every constant a register
+     * that's loaded once, at the start of the function. Phi nodes are assigned on the edges that
+     * lead to their block; conditional branches, switches and handlers of calls continue at a
+     * copy of these assignments if an edge has any. Objects keep the layout of the layout engine,
+     * so the interpreter can pass them to native functions.
+     */
+    class BytecodeCompiler
+    {
+    private:
+        semantic::LayoutEngine &layouts;
+        BytecodeModule *module = nullptr;
+        std::unordered_map<const ir::Function *, uint16_t> functionIndices;
+        std::unordered_map<const ir::Global *, uint32_t> globalIndices;
+        std::unordered_map<std::string, uint32_t> stringIndices;
+
+        BytecodeFunction *function = nullptr;
+        std::unordered_map<const ir::Value *, uint16_t> constantRegisters;
+        uint32_t registerCount = 0;
+        uint32_t temporaryCount = 0;
+        std::vector<uint32_t> blockOffsets;
+
+        /**
+         * The jumps to blocks, and the cases of switch tables, that are resolved once all blocks are placed.
+         */
+        struct CaseFixup
+        {
+            uint32_t table;
+            int64_t index; // -1 for the default target
+            const ir::BasicBlock *target;
+        };
+        std::vector<std::pair<uint32_t, const ir::BasicBlock *>> jumpFixups;
+        std::vector<CaseFixup> caseFixups;
+
+        uint32_t internString(const std::string &value);
+
+        Constant constantOf(ir::Value *value);
+
+        /**
+         * Returns the index of a constant in the pool of the function, which is added if it isn't there.
+         */
+        uint32_t poolIndex(const Constant &constant);
+
+        uint16_t registerOf(ir::Value *value);
+
+        /**
+         * Returns a register for intermediate values, which is free again after the instruction.
+         */
+        uint16_t temporary();
+
+        uint32_t emit(EBytecodeOpcode opcode, uint8_t type, uint32_t a, uint32_t b, uint32_t c);
+
+        uint32_t emitWide(EBytecodeOpcode opcode, uint8_t type, uint32_t a, uint32_t wide);
+
+        void emitJump(EBytecodeOpcode opcode, uint32_t condition, const ir::BasicBlock *target);
+
+        /**
+         * Emits a load or store at an offset from a base; offsets that don't fit are added to the base first.
+         */
+        void emitMemoryAccess(EBytecodeOpcode opcode, ir::EIRType type, uint16_t base, uint64_t offset,
+                              uint16_t value);
+
+        /**
+         * Whether the only users of a field address are loads and stores, which add its offset themselves.
+         */
+        static bool isFolded(const ir::Instruction *fieldAddress);
+
+        /**
+         * Assigns the phi nodes of a successor for the edge from a predecessor.
+         */
+        void emitPhiCopies(const ir::BasicBlock *predecessor, const ir::BasicBlock *successor);
+
+        static bool hasPhis(const ir::BasicBlock *block);
+
+        /**
+         * Continues at a successor; the jump is left out if the successor is the next block.
+         */
+        void emitEdge(const ir::BasicBlock *predecessor, const ir::BasicBlock *successor, const ir::BasicBlock *next);
+
+        /**
+         * Emits a call, with its arguments. Returns the position of the handler, for invocations.
+         */
+        uint32_t emitCall(ir::Instruction *instruction, bool invokes);
+
+        void compileInstruction(ir::Instruction *instruction, const ir::BasicBlock *next);
+
+        void compileFunction(ir::Function *source, BytecodeFunction &target);
+
+    public:
+        explicit BytecodeCompiler(semantic::LayoutEngine &layouts) : layouts(layouts)
+        {}
+
+        std::unique_ptr<BytecodeModule> compile(const ir::Module &source);
+    };
+}
+
+#endif //STRIDE_LANGUAGE_BYTECODECOMPILER_H
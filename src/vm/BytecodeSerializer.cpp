@@ -0,0 +1,579 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "BytecodeSerializer.h"
+#include "../cache/Hash.h"
+
+using namespace stride::vm;
+using namespace stride::vm::serialization;
+
+#define ALIGN_8(value) (((value) + 7) & ~((size_t) 7))
+
+static_assert(sizeof(Instruction) == 8, "Instructions are stored as they're laid out in memory");
+
+/**
+ * Collects the sections of serialized bytecode.
+ */
+class BytecodeWriter
+{
+private:
+    std::vector<bytecode_function_record_t> functions;
+    std::vector<bytecode_global_record_t> globals;
+    std::vector<Instruction> code;
+    std::vector<bytecode_constant_record_t> constants;
+    std::vector<bytecode_switch_record_t> switches;
+    std::vector<bytecode_case_record_t> cases;
+    std::vector<bytecode_string_record_t> strings;
+    std::string stringData;
+    std::unordered_map<std::string, uint32_t> stringIndices;
+    uint32_t moduleStringCount = 0;
+
+    uint32_t intern(const std::string &value)
+    {
+        auto existing = stringIndices.find(value);
+        if ( existing != stringIndices.end())
+        {
+            return existing->second;
+        }
+        return append(value);
+    }
+
+    uint32_t append(const std::string &value)
+    {
+        auto index = (uint32_t) strings.size();
+        strings.push_back({ (uint32_t) stringData.size(), (uint32_t) value.size() });
+        stringData.append(value).push_back('\0');
+        stringIndices.emplace(value, index);
+        return index;
+    }
+
+    static bytecode_constant_record_t constantOf(const Constant &constant)
+    {
+        bytecode_constant_record_t record {};
+        record.kind = constant.kind;
+        record.value = constant.value;
+        return record;
+    }
+
+public:
+    void write(const BytecodeModule &module)
+    {
+        // The strings of the module keep their index, even if two of them are equal.
+        for ( auto &string: module.strings )
+        {
+            append(string);
+        }
+        moduleStringCount = (uint32_t) module.strings.size();
+
+        for ( auto &function: module.functions )
+        {
+            bytecode_function_record_t record {};
+            record.name = intern(function.name);
+
+            // The interpreter finds the external functions again when it links the module.
+            record.kind = function.kind == FUNCTION_BYTECODE ? FUNCTION_BYTECODE : FUNCTION_EXTERNAL;
+            record.returnType = function.returnType;
+            record.argumentCount = function.argumentCount;
+            record.registerCount = function.registerCount;
+            record.code = (uint32_t) code.size();
+            record.codeSize = (uint32_t) function.code.size();
+            record.constants = (uint32_t) constants.size();
+            record.constantCount = (uint32_t) function.constants.size();
+            record.switches = (uint32_t) switches.size();
+            record.switchCount = (uint32_t) function.switches.size();
+            functions.push_back(record);
+
+            for ( auto instruction: function.code )
+            {
+                instruction.opcode = genericOpcode(instruction.opcode);
+                code.push_back(instruction);
+            }
+            for ( auto &constant: function.constants )
+            {
+                constants.push_back(constantOf(constant));
+            }
+            for ( auto &table: function.switches )
+            {
+                switches.push_back({ (uint32_t) cases.size(), (uint32_t) table.values.size(), table.defaultTarget, 0 });
+                for ( size_t i = 0; i < table.values.size(); i++ )
+                {
+                    cases.push_back({ table.values[ i ], table.targets[ i ], 0 });
+                }
+            }
+        }
+
+        for ( auto &global: module.globals )
+        {
+            bytecode_global_record_t record {};
+            record.name = intern(global.name);
+            record.type = global.type;
+            record.initializer = constantOf(global.initializer);
+            globals.push_back(record);
+        }
+    }
+
+    std::vector<uint8_t> finish(const std::string &name, uint64_t sourceHash)
+    {
+        bytecode_file_header_t header {};
+        memcpy(header.magic, BYTECODE_FORMAT_MAGIC, 4);
+        header.version = BYTECODE_FORMAT_VERSION;
+        header.byteOrder = BYTECODE_BYTE_ORDER_MARK;
+        header.name = intern(name);
+        header.sourceHash = sourceHash;
+        header.functionCount = (uint32_t) functions.size();
+        header.globalCount = (uint32_t) globals.size();
+        header.instructionCount = (uint32_t) code.size();
+        header.constantCount = (uint32_t) constants.size();
+        header.switchCount = (uint32_t) switches.size();
+        header.caseCount = (uint32_t) cases.size();
+        header.stringCount = (uint32_t) strings.size();
+        header.moduleStringCount = moduleStringCount;
+        header.stringDataSize = (uint32_t) stringData.size();
+
+        size_t offset = ALIGN_8(sizeof(bytecode_file_header_t));
+        header.functionsOffset = (uint32_t) offset;
+        offset = ALIGN_8(offset + functions.size() * sizeof(bytecode_function_record_t));
+        header.globalsOffset = (uint32_t) offset;
+        offset = ALIGN_8(offset + globals.size() * sizeof(bytecode_global_record_t));
+        header.codeOffset = (uint32_t) offset;
+        offset = ALIGN_8(offset + code.size() * sizeof(Instruction));
+        header.constantsOffset = (uint32_t) offset;
+        offset = ALIGN_8(offset + constants.size() * sizeof(bytecode_constant_record_t));
+        header.switchesOffset = (uint32_t) offset;
+        offset = ALIGN_8(offset + switches.size() * sizeof(bytecode_switch_record_t));
+        header.casesOffset = (uint32_t) offset;
+        offset = ALIGN_8(offset + cases.size() * sizeof(bytecode_case_record_t));
+        header.stringsOffset = (uint32_t) offset;
+        offset = ALIGN_8(offset + strings.size() * sizeof(bytecode_string_record_t));
+        header.stringDataOffset = (uint32_t) offset;
+        offset = ALIGN_8(offset + stringData.size());
+
+        std::vector<uint8_t> buffer(offset, 0);
+        memcpy(buffer.data(), &header, sizeof(header));
+        memcpy(buffer.data() + header.functionsOffset, functions.data(),
+               functions.size() * sizeof(bytecode_function_record_t));
+        memcpy(buffer.data() + header.globalsOffset, globals.data(), globals.size() * sizeof(bytecode_global_record_t));
+        memcpy(buffer.data() + header.codeOffset, code.data(), code.size() * sizeof(Instruction));
+        memcpy(buffer.data() + header.constantsOffset, constants.data(),
+               constants.size() * sizeof(bytecode_constant_record_t));
+        memcpy(buffer.data() + header.switchesOffset, switches.data(),
+               switches.size() * sizeof(bytecode_switch_record_t));
+        memcpy(buffer.data() + header.casesOffset, cases.data(), cases.size() * sizeof(bytecode_case_record_t));
+        memcpy(buffer.data() + header.stringsOffset, strings.data(), strings.size() * sizeof(bytecode_string_record_t));
+        memcpy(buffer.data() + header.stringDataOffset, stringData.data(), stringData.size());
+
+        // The checksum covers the padding as well, which is zeroed.
+        auto checksum = stride::cache::hash(buffer.data() + sizeof(header), buffer.size() - sizeof(header));
+        memcpy(buffer.data() + offsetof(bytecode_file_header_t, checksum), &checksum, sizeof(checksum));
+        return buffer;
+    }
+};
+
+std::vector<uint8_t> stride::vm::serialization::serialize(const BytecodeModule &module, uint64_t sourceHash)
+{
+    BytecodeWriter writer;
+    writer.write(module);
+    return writer.finish(module.name, sourceHash);
+}
+
+bool stride::vm::serialization::write(const BytecodeModule &module, const std::string &path, uint64_t sourceHash)
+{
+    auto buffer = serialize(module, sourceHash);
+
+    // Write to a temporary file first, so readers never observe a partially written file.
+    std::string temporaryPath = path + "." + std::to_string(getpid()) + ".tmp";
+    std::ofstream file_out(temporaryPath, std::ios::binary | std::ios::trunc);
+    if ( !file_out )
+    {
+        return false;
+    }
+    file_out.write(reinterpret_cast<const char *>(buffer.data()), (std::streamsize) buffer.size());
+    file_out.close();
+
+    if ( !file_out || rename(temporaryPath.c_str(), path.c_str()) != 0 )
+    {
+        unlink(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Reading
+ */
+
+static void malformed(const char *reason)
+{
+    throw std::runtime_error(std::string("Malformed bytecode: ") + reason + ".");
+}
+
+BytecodeView::~BytecodeView()
+{
+    if ( this->mapped && this->data != nullptr )
+    {
+        munmap((void *) this->data, this->size);
+    }
+}
+
+bool BytecodeView::validateHeader() const
+{
+    if ( this->size < sizeof(bytecode_file_header_t) || ((uintptr_t) this->data & 7 ) != 0 )
+    {
+        return false;
+    }
+
+    auto &h = this->header();
+    if ( memcmp(h.magic, BYTECODE_FORMAT_MAGIC, 4) != 0 ||
+         h.version != BYTECODE_FORMAT_VERSION ||
+         h.byteOrder != BYTECODE_BYTE_ORDER_MARK ||
+         h.moduleStringCount > h.stringCount || h.name >= h.stringCount )
+    {
+        return false;
+    }
+
+    if ( stride::cache::hash(this->data + sizeof(h), this->size - sizeof(h)) != h.checksum )
+    {
+        return false;
+    }
+
+    // Validate the section bounds, so the accessors only have to check indices.
+    auto fits = [ this ](uint64_t offset, uint64_t count, uint64_t elementSize)
+    {
+        return ( offset & 7 ) == 0 && offset + count * elementSize <= this->size;
+    };
+
+    if ( !fits(h.functionsOffset, h.functionCount, sizeof(bytecode_function_record_t)) ||
+         !fits(h.globalsOffset, h.globalCount, sizeof(bytecode_global_record_t)) ||
+         !fits(h.codeOffset, h.instructionCount, sizeof(Instruction)) ||
+         !fits(h.constantsOffset, h.constantCount, sizeof(bytecode_constant_record_t)) ||
+         !fits(h.switchesOffset, h.switchCount, sizeof(bytecode_switch_record_t)) ||
+         !fits(h.casesOffset, h.caseCount, sizeof(bytecode_case_record_t)) ||
+         !fits(h.stringsOffset, h.stringCount, sizeof(bytecode_string_record_t)) ||
+         !fits(h.stringDataOffset, h.stringDataSize, 1))
+    {
+        return false;
+    }
+
+    // Every string ends with a NUL within the string data.
+    for ( uint32_t i = 0; i < h.stringCount; i++ )
+    {
+        auto &record = reinterpret_cast<const bytecode_string_record_t *>(this->data + h.stringsOffset)[ i ];
+        if ((uint64_t) record.offset + record.length >= h.stringDataSize ||
+            this->data[ h.stringDataOffset + record.offset + record.length ] != '\0' )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+BytecodeView *BytecodeView::open(const std::string &path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if ( fd < 0 )
+    {
+        return nullptr;
+    }
+
+    struct stat fileStat {};
+    if ( fstat(fd, &fileStat) != 0 || fileStat.st_size < (off_t) sizeof(bytecode_file_header_t))
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    void *mapping = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if ( mapping == MAP_FAILED )
+    {
+        return nullptr;
+    }
+
+    auto view = new BytecodeView((const uint8_t *) mapping, fileStat.st_size, true);
+    if ( !view->validateHeader())
+    {
+        delete view;
+        return nullptr;
+    }
+    return view;
+}
+
+BytecodeView *BytecodeView::fromBuffer(const void *buffer, size_t size)
+{
+    auto view = new BytecodeView((const uint8_t *) buffer, size, false);
+    if ( !view->validateHeader())
+    {
+        delete view;
+        return nullptr;
+    }
+    return view;
+}
+
+const bytecode_file_header_t &BytecodeView::header() const
+{
+    return *reinterpret_cast<const bytecode_file_header_t *>(this->data);
+}
+
+const bytecode_function_record_t *BytecodeView::functions() const
+{
+    return reinterpret_cast<const bytecode_function_record_t *>(this->data + this->header().functionsOffset);
+}
+
+const bytecode_global_record_t *BytecodeView::globals() const
+{
+    return reinterpret_cast<const bytecode_global_record_t *>(this->data + this->header().globalsOffset);
+}
+
+const Instruction *BytecodeView::code() const
+{
+    return reinterpret_cast<const Instruction *>(this->data + this->header().codeOffset);
+}
+
+const bytecode_constant_record_t *BytecodeView::constants() const
+{
+    return reinterpret_cast<const bytecode_constant_record_t *>(this->data + this->header().constantsOffset);
+}
+
+const bytecode_switch_record_t *BytecodeView::switches() const
+{
+    return reinterpret_cast<const bytecode_switch_record_t *>(this->data + this->header().switchesOffset);
+}
+
+const bytecode_case_record_t *BytecodeView::cases() const
+{
+    return reinterpret_cast<const bytecode_case_record_t *>(this->data + this->header().casesOffset);
+}
+
+std::string_view BytecodeView::string(uint32_t index) const
+{
+    auto &h = this->header();
+    if ( index >= h.stringCount )
+    {
+        malformed("string index out of range");
+    }
+    auto &record = reinterpret_cast<const bytecode_string_record_t *>(this->data + h.stringsOffset)[ index ];
+    return { reinterpret_cast<const char *>(this->data + h.stringDataOffset + record.offset), record.length };
+}
+
+/*
+ * Materialization
+ */
+
+/**
+ * Reads a constant, of which the index refers to a string, global or function of the module.
+ */
+static Constant readConstant(const bytecode_file_header_t &header, const bytecode_constant_record_t &record)
+{
+    uint64_t limit = record.kind == CONSTANT_STRING ? header.moduleStringCount :
+                     record.kind == CONSTANT_GLOBAL ? header.globalCount : header.functionCount;
+    if ( record.kind > CONSTANT_FUNCTION || ( record.kind != CONSTANT_VALUE && record.value >= limit ))
+    {
+        malformed("constant out of range");
+    }
+    return { (EConstantKind) record.kind, record.value };
+}
+
+/**
+ * Checks the indices of the instructions of a function; the interpreter trusts them.
+ */
+static void validateCode(const bytecode_file_header_t &header, const BytecodeFunction &function)
+{
+    auto &code = function.code;
+    auto isTarget = [ &code ](uint32_t target) { return target < code.size(); };
+    auto isRegister = [ &function ](uint16_t index) { return index < function.registerCount; };
+    for ( size_t i = 0; i < code.size(); i++ )
+    {
+        const Instruction &instruction = code[ i ];
+
+        // The amount of leading operands, of a, b and c, that are registers.
+        int registers = 0;
+        switch ( instruction.opcode )
+        {
+            case BC_LOAD_CONSTANT:
+                if ( instruction.wide() >= function.constants.size())
+                {
+                    malformed("constant index out of range");
+                }
+                registers = 1;
+                break;
+            case BC_JUMP:
+            case BC_JUMP_IF:
+            case BC_JUMP_IF_NOT:
+                if ( !isTarget(instruction.wide()))
+                {
+                    malformed("jump target out of range");
+                }
+                registers = instruction.opcode == BC_JUMP ? 0 : 1;
+                break;
+            case BC_SWITCH:
+                if ( instruction.wide() >= function.switches.size())
+                {
+                    malformed("switch table out of range");
+                }
+                registers = 1;
+                break;
+            case BC_CALL:
+            case BC_CALL_INDIRECT:
+            case BC_INVOKE:
+            case BC_INVOKE_INDIRECT:
+            {
+                // The arguments follow the call, and the handler of an invoke follows those.
+                bool isInvoke = instruction.opcode == BC_INVOKE || instruction.opcode == BC_INVOKE_INDIRECT;
+                bool isDirect = instruction.opcode == BC_CALL || instruction.opcode == BC_INVOKE;
+                size_t words = ( instruction.c + 2 ) / 3 + ( isInvoke ? 1 : 0 );
+                if ( isDirect && instruction.b >= header.functionCount )
+                {
+                    malformed("function index out of range");
+                }
+                if ( i + words >= code.size() || ( isInvoke && !isTarget(code[ i + words ].wide())))
+                {
+                    malformed("call out of range");
+                }
+                if (( instruction.a != BYTECODE_NO_RESULT && !isRegister(instruction.a)) ||
+                    ( !isDirect && !isRegister(instruction.b)))
+                {
+                    malformed("register out of range");
+                }
+                for ( uint16_t argument = 0; argument < instruction.c; argument++ )
+                {
+                    const Instruction &word = code[ i + 1 + argument / 3 ];
+                    uint16_t index = argument % 3 == 0 ? word.a : argument % 3 == 1 ? word.b : word.c;
+                    if ( word.opcode != BC_ARGUMENTS || !isRegister(index))
+                    {
+                        malformed("call argument out of range");
+                    }
+                }
+                i += words;
+                continue;
+            }
+            case BC_ALLOCATE:
+            case BC_ARRAY:
+            case BC_CATCH:
+            case BC_RAISE:
+            case BC_THROW:
+                registers = 1;
+                break;
+            case BC_RETURN:
+                registers = instruction.type == stride::ir::IR_VOID ? 0 : 1;
+                break;
+            case BC_MOVE:
+            case BC_TRUNC:
+            case BC_ZEXT:
+            case BC_SEXT:
+            case BC_FPTRUNC:
+            case BC_FPEXT:
+            case BC_SITOFP:
+            case BC_UITOFP:
+            case BC_FPTOSI:
+            case BC_FPTOUI:
+            case BC_LOAD:
+            case BC_STORE:
+            case BC_ADDRESS:
+                // The offset of memory accesses, in c, isn't a register.
+                registers = 2;
+                break;
+            case BC_UNREACHABLE:
+                break;
+            default:
+                // Arithmetic and comparisons. Arguments are only valid after a call.
+                if ( instruction.opcode >= BC_ADD_I32 || instruction.opcode == BC_ARGUMENTS )
+                {
+                    malformed("unknown opcode");
+                }
+                registers = 3;
+                break;
+        }
+        if (( registers > 0 && !isRegister(instruction.a)) || ( registers > 1 && !isRegister(instruction.b)) ||
+            ( registers > 2 && !isRegister(instruction.c)))
+        {
+            malformed("register out of range");
+        }
+    }
+    for ( auto &table: function.switches )
+    {
+        for ( auto target: table.targets )
+        {
+            if ( !isTarget(target))
+            {
+                malformed("switch target out of range");
+            }
+        }
+        if ( !isTarget(table.defaultTarget))
+        {
+            malformed("switch target out of range");
+        }
+    }
+}
+
+std::unique_ptr<BytecodeModule> stride::vm::serialization::materialize(const BytecodeView &view)
+{
+    auto &h = view.header();
+    auto module = std::make_unique<BytecodeModule>(std::string(view.string(h.name)));
+    for ( uint32_t i = 0; i < h.moduleStringCount; i++ )
+    {
+        module->strings.emplace_back(view.string(i));
+    }
+
+    module->functions.resize(h.functionCount);
+    for ( uint32_t i = 0; i < h.functionCount; i++ )
+    {
+        auto &record = view.functions()[ i ];
+        if ((uint64_t) record.code + record.codeSize > h.instructionCount ||
+            (uint64_t) record.constants + record.constantCount > h.constantCount ||
+            (uint64_t) record.switches + record.switchCount > h.switchCount ||
+            ( record.kind != FUNCTION_BYTECODE && record.kind != FUNCTION_EXTERNAL ) ||
+            ( record.kind == FUNCTION_BYTECODE && record.argumentCount > record.registerCount ))
+        {
+            malformed("function out of range");
+        }
+
+        BytecodeFunction &function = module->functions[ i ];
+        function.name = view.string(record.name);
+        function.kind = (EFunctionKind) record.kind;
+        function.returnType = (ir::EIRType) record.returnType;
+        function.argumentCount = record.argumentCount;
+        function.registerCount = record.registerCount;
+        function.code.assign(view.code() + record.code, view.code() + record.code + record.codeSize);
+        for ( uint32_t j = 0; j < record.constantCount; j++ )
+        {
+            function.constants.push_back(readConstant(h, view.constants()[ record.constants + j ]));
+        }
+        for ( uint32_t j = 0; j < record.switchCount; j++ )
+        {
+            auto &switchRecord = view.switches()[ record.switches + j ];
+            if ((uint64_t) switchRecord.cases + switchRecord.caseCount > h.caseCount )
+            {
+                malformed("switch table out of range");
+            }
+            SwitchTable table;
+            table.defaultTarget = switchRecord.defaultTarget;
+            for ( uint32_t k = 0; k < switchRecord.caseCount; k++ )
+            {
+                auto &caseRecord = view.cases()[ switchRecord.cases + k ];
+                table.values.push_back(caseRecord.value);
+                table.targets.push_back(caseRecord.target);
+            }
+            function.switches.push_back(std::move(table));
+        }
+        validateCode(h, function);
+    }
+
+    for ( uint32_t i = 0; i < h.globalCount; i++ )
+    {
+        auto &record = view.globals()[ i ];
+        module->globals.push_back({ std::string(view.string(record.name)), (ir::EIRType) record.type,
+                                    readConstant(h, record.initializer) });
+    }
+    return module;
+}
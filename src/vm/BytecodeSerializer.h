@@ -0,0 +1,205 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_BYTECODESERIALIZER_H
+#define STRIDE_LANGUAGE_BYTECODESERIALIZER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Bytecode.h"
+
+/**
+ * Binary format of compiled bytecode, the '.srb' files.
+ *
+ * A file consists of a header, followed by the following sections,
+ * each aligned to 8 bytes:
+ * <ul>
+ *  <li>functions: one bytecode_function_record_t per function, in the order of the module,
+ *      as calls refer to functions by their index.</li>
+ *  <li>globals: one bytecode_global_record_t per global.</li>
+ *  <li>code: the instructions of all functions, in the layout the interpreter executes.
+ *      Quickened instructions are stored in their generic form.</li>
+ *  <li>constants: the constant pools of all functions.</li>
+ *  <li>switches: one bytecode_switch_record_t per switch table.</li>
+ *  <li>cases: one bytecode_case_record_t per case of a switch table.</li>
+ *  <li>strings: one bytecode_string_record_t per interned string. The strings of the module
+ *      come first, so string constants keep their index; the names follow.</li>
+ *  <li>string data: NUL-terminated string contents.</li>
+ * </ul>
+ * All values are stored in the byte order of the machine that wrote the file;
+ * files with a different byte order are rejected when loaded, as are files of
+ * which the checksum doesn't match the sections. The version changes whenever
+ * the instruction set does.
+ */
+#define BYTECODE_FORMAT_MAGIC "SRBC"
+#define BYTECODE_FORMAT_VERSION 2
+#define BYTECODE_BYTE_ORDER_MARK 0x01020304u
+
+typedef struct
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t name;      // String index of the name of the module
+
+    /**
+     * Hash of the source the bytecode was compiled from, and of the flags it was compiled with.
+     * This is not used by the format itself, but allows callers to check whether the bytecode
+     * is still up-to-date.
+     */
+    uint64_t sourceHash;
+
+    /**
+     * Hash of everything that follows the header, so bytecode that was truncated
+     * or corrupted on disk is rejected, rather than loaded with the wrong code.
+     */
+    uint64_t checksum;
+
+    uint32_t functionCount, globalCount, instructionCount, constantCount, switchCount, caseCount;
+    uint32_t stringCount, moduleStringCount, stringDataSize;
+    uint32_t functionsOffset, globalsOffset, codeOffset, constantsOffset, switchesOffset, casesOffset;
+    uint32_t stringsOffset, stringDataOffset;
+} bytecode_file_header_t;
+
+typedef struct
+{
+    uint32_t name;          // String index
+    uint8_t kind;           // stride::vm::EFunctionKind; bytecode or external
+    uint8_t returnType;     // stride::ir::EIRType
+    uint16_t argumentCount;
+    uint16_t registerCount;
+    uint16_t reserved;
+    uint32_t code;          // Index of the first instruction in the code section
+    uint32_t codeSize;
+    uint32_t constants;     // Index of the first constant in the constants section
+    uint32_t constantCount;
+    uint32_t switches;      // Index of the first switch table in the switches section
+    uint32_t switchCount;
+} bytecode_function_record_t;
+
+typedef struct
+{
+    uint8_t kind;           // stride::vm::EConstantKind
+    uint8_t reserved[7];
+    uint64_t value;
+} bytecode_constant_record_t;
+
+typedef struct
+{
+    uint32_t name;          // String index
+    uint8_t type;           // stride::ir::EIRType
+    uint8_t reserved[3];
+    bytecode_constant_record_t initializer;
+} bytecode_global_record_t;
+
+typedef struct
+{
+    uint32_t cases;         // Index of the first case in the cases section, which are sorted by value
+    uint32_t caseCount;
+    uint32_t defaultTarget;
+    uint32_t reserved;
+} bytecode_switch_record_t;
+
+typedef struct
+{
+    int64_t value;
+    uint32_t target;
+    uint32_t reserved;
+} bytecode_case_record_t;
+
+typedef struct
+{
+    uint32_t offset;
+    uint32_t length;
+} bytecode_string_record_t;
+
+namespace stride::vm::serialization
+{
+
+    /**
+     * Read-only view of compiled bytecode.
+     * The view can either be backed by a memory mapped file, or by a buffer
+     * owned by the caller. Opening a view validates the header, the bounds of
+     * the sections and the checksum, so loading costs roughly as much as reading the file.
+     */
+    class BytecodeView
+    {
+    private:
+        const uint8_t *data;
+        size_t size;
+        bool mapped;
+
+        BytecodeView(const uint8_t *data, size_t size, bool mapped) : data(data), size(size), mapped(mapped)
+        {}
+
+        [[nodiscard]] bool validateHeader() const;
+
+    public:
+
+        ~BytecodeView();
+
+        BytecodeView(const BytecodeView &) = delete;
+
+        BytecodeView &operator=(const BytecodeView &) = delete;
+
+        /**
+         * Memory maps a bytecode file.
+         * @param path The path of the file to map.
+         * @return The view, or nullptr if the file couldn't be opened or isn't valid bytecode.
+         */
+        static BytecodeView *open(const std::string &path);
+
+        /**
+         * Creates a view over an existing buffer.
+         * The buffer must outlive the view, and must be aligned to 8 bytes.
+         * @return The view, or nullptr if the buffer isn't valid bytecode.
+         */
+        static BytecodeView *fromBuffer(const void *buffer, size_t size);
+
+        [[nodiscard]] const bytecode_file_header_t &header() const;
+
+        [[nodiscard]] const bytecode_function_record_t *functions() const;
+
+        [[nodiscard]] const bytecode_global_record_t *globals() const;
+
+        [[nodiscard]] const Instruction *code() const;
+
+        [[nodiscard]] const bytecode_constant_record_t *constants() const;
+
+        [[nodiscard]] const bytecode_switch_record_t *switches() const;
+
+        [[nodiscard]] const bytecode_case_record_t *cases() const;
+
+        /**
+         * Returns the interned string at the provided index.
+         * The returned view is NUL-terminated, and is valid for the lifetime of this view.
+         * @throws std::runtime_error if the index is out of range.
+         */
+        [[nodiscard]] std::string_view string(uint32_t index) const;
+    };
+
+    /**
+     * Serializes the bytecode of a module into a buffer.
+     * @param sourceHash The hash of the source the module was compiled from.
+     */
+    std::vector<uint8_t> serialize(const BytecodeModule &module, uint64_t sourceHash = 0);
+
+    /**
+     * Serializes the bytecode of a module and writes it to the provided path.
+     * @return Whether the file was written successfully.
+     */
+    bool write(const BytecodeModule &module, const std::string &path, uint64_t sourceHash = 0);
+
+    /**
+     * Reconstructs a module from serialized bytecode, which the interpreter can load.
+     * @throws std::runtime_error if the bytecode refers to strings, functions, constants,
+     * switch tables or instructions that don't exist.
+     */
+    std::unique_ptr<BytecodeModule> materialize(const BytecodeView &view);
+}
+
+#endif //STRIDE_LANGUAGE_BYTECODESERIALIZER_H
@@ -0,0 +1,1058 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "Interpreter.h"
+#include "../ir/IRGenerator.h"
+
+using namespace stride;
+using namespace stride::vm;
+
+/**
+ * Returns a value of a type as the interpreter keeps it in a register; integers sign extended,
+ * booleans as 0 or 1, and single precision floats as the low 32 bits.
+ */
+static inline uint64_t canonical(uint8_t type, uint64_t value)
+{
+    switch ( type )
+    {
+        case ir::IR_BOOL:
+            return value & 1;
+        case ir::IR_I8:
+            return (uint64_t) (int64_t) (int8_t) value;
+        case ir::IR_I16:
+            return (uint64_t) (int64_t) (int16_t) value;
+        case ir::IR_I32:
+            return (uint64_t) (int64_t) (int32_t) value;
+        case ir::IR_F32:
+            return value & 0xFFFFFFFF;
+        default:
+            return value;
+    }
+}
+
+/**
+ * Returns the bits of a value of a type, for unsigned operations.
+ */
+static inline uint64_t maskOf(uint8_t type)
+{
+    static const uint64_t masks[] = { 0, 1, 0xFF, 0xFFFF, 0xFFFFFFFF, ~0ULL, 0xFFFFFFFF, ~0ULL, ~0ULL };
+    return masks[ type ];
+}
+
+static inline uint64_t shiftCount(uint8_t type, uint64_t count)
+{
+    return count & ( ir::sizeOf((ir::EIRType) type) * 8 - 1 );
+}
+
+static inline float asF32(uint64_t bits)
+{
+    auto low = (uint32_t) bits;
+    float value;
+    std::memcpy(&value, &low, sizeof(value));
+    return value;
+}
+
+static inline double asF64(uint64_t bits)
+{
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static inline uint64_t fromF32(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static inline uint64_t fromF64(double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static inline double asFloat(uint8_t type, uint64_t bits)
+{
+    return type == ir::IR_F32 ? asF32(bits) : asF64(bits);
+}
+
+static inline uint64_t fromFloat(uint8_t type, double value)
+{
+    return type == ir::IR_F32 ? fromF32((float) value) : fromF64(value);
+}
+
+template<typename T>
+static inline T read(uint64_t address)
+{
+    T value;
+    std::memcpy(&value, (const void *) address, sizeof(T));
+    return value;
+}
+
+template<typename T>
+static inline void write(uint64_t address, T value)
+{
+    std::memcpy((void *) address, &value, sizeof(T));
+}
+
+static inline uint64_t load(uint8_t type, uint64_t address)
+{
+    switch ( type )
+    {
+        case ir::IR_BOOL:
+            return read<uint8_t>(address) & 1;
+        case ir::IR_I8:
+            return (uint64_t) (int64_t) read<int8_t>(address);
+        case ir::IR_I16:
+            return (uint64_t) (int64_t) read<int16_t>(address);
+        case ir::IR_I32:
+            return (uint64_t) (int64_t) read<int32_t>(address);
+        case ir::IR_F32:
+            return read<uint32_t>(address);
+        default:
+            return read<uint64_t>(address);
+    }
+}
+
+static inline void store(uint8_t type, uint64_t address, uint64_t value)
+{
+    switch ( ir::sizeOf((ir::EIRType) type))
+    {
+        case 1:
+            write<uint8_t>(address, (uint8_t) value);
+            break;
+        case 2:
+            write<uint16_t>(address, (uint16_t) value);
+            break;
+        case 4:
+            write<uint32_t>(address, (uint32_t) value);
+            break;
+        default:
+            write<uint64_t>(address, value);
+            break;
+    }
+}
+
+/**
+ * Returns the register of an argument of a call, from the BC_ARGUMENTS that follow it.
+ */
+static inline uint16_t argumentRegister(const Instruction *arguments, size_t index)
+{
+    const Instruction &word = arguments[ index / 3 ];
+    return index % 3 == 0 ? word.a : index % 3 == 1 ? word.b : word.c;
+}
+
+static inline uint8_t argumentClass(const Instruction *arguments, size_t index)
+{
+    return ( arguments[ index / 3 ].type >> ( index % 3 * 2 )) & 3;
+}
+
+Interpreter::Interpreter(BytecodeModule &module, bool compiling) :
+        module(module), stack(INTERPRETER_STACK_SIZE), compiling(compiling)
+{
+    this->link();
+}
+
+Interpreter::~Interpreter()
+{
+    // The machine code is freed with the compiler.
+    for ( auto &function: this->module.functions )
+    {
+        function.native = nullptr;
+    }
+}
+
+void Interpreter::link()
+{
+    auto resolve = [ this ](const Constant &constant) -> uint64_t
+    {
+        switch ( constant.kind )
+        {
+            case CONSTANT_STRING:
+                return (uint64_t) this->module.strings[ constant.value ].c_str();
+            case CONSTANT_GLOBAL:
+                return (uint64_t) &this->globals[ constant.value ];
+            case CONSTANT_FUNCTION:
+                return (uint64_t) &this->module.functions[ constant.value ];
+            default:
+                return constant.value;
+        }
+    };
+
+    // Every global has a register of storage, which is large enough for any type.
+    this->globals.resize(this->module.globals.size());
+    for ( size_t i = 0; i < this->module.globals.size(); i++ )
+    {
+        this->globals[ i ] = resolve(this->module.globals[ i ].initializer);
+    }
+
+    for ( auto &function: this->module.functions )
+    {
+        function.invocations = 0;
+        function.backEdges = 0;
+        function.values.clear();
+        for ( auto &constant: function.constants )
+        {
+            function.values.push_back(resolve(constant));
+        }
+        if ( function.kind == FUNCTION_BYTECODE )
+        {
+            continue;
+        }
+
+        // The runtime of the interpreter replaces the native runtime; other functions are looked up by name.
+        if ( Builtin builtin = findBuiltin(function.name))
+        {
+            function.kind = FUNCTION_BUILTIN;
+            function.address = (void *) builtin;
+        }
+        else if ( void *address = findNativeFunction(function.name))
+        {
+            function.kind = FUNCTION_NATIVE;
+            function.address = address;
+        }
+    }
+}
+
+BytecodeFunction *Interpreter::functionAt(uint64_t address) const
+{
+    auto first = (uint64_t) this->module.functions.data();
+    auto end = (uint64_t) ( this->module.functions.data() + this->module.functions.size());
+    if ( address < first || address >= end || ( address - first ) % sizeof(BytecodeFunction) != 0 )
+    {
+        return nullptr;
+    }
+    return &this->module.functions[ ( address - first ) / sizeof(BytecodeFunction) ];
+}
+
+/**
+ * Returns the variant of 32 or 64 bits of an integer operation, which follow each other, or
+ * BC_OPCODE_COUNT if the operation has none for the type.
+ */
+static inline EBytecodeOpcode integerVariant(uint8_t type, EBytecodeOpcode variant32)
+{
+    if ( type == ir::IR_I32 )
+    {
+        return variant32;
+    }
+    return type == ir::IR_I64 || type == ir::IR_PTR ? (EBytecodeOpcode) ( variant32 + 1 ) : BC_OPCODE_COUNT;
+}
+
+/**
+ * Returns the single or double precision variant of a float operation, which follow each other.
+ */
+static inline EBytecodeOpcode floatVariant(uint8_t type, EBytecodeOpcode variant32)
+{
+    return type == ir::IR_F32 ? variant32 : (EBytecodeOpcode) ( variant32 + 1 );
+}
+
+bool Interpreter::quicken(Instruction &instruction) const
+{
+    EBytecodeOpcode variant = BC_OPCODE_COUNT;
+    switch ( instruction.opcode )
+    {
+        case BC_ADD:
+            variant = integerVariant(instruction.type, BC_ADD_I32);
+            break;
+        case BC_SUB:
+            variant = integerVariant(instruction.type, BC_SUB_I32);
+            break;
+        case BC_MUL:
+            variant = integerVariant(instruction.type, BC_MUL_I32);
+            break;
+        case BC_SDIV:
+            variant = integerVariant(instruction.type, BC_SDIV_I32);
+            break;
+        case BC_SREM:
+            variant = integerVariant(instruction.type, BC_SREM_I32);
+            break;
+        case BC_FADD:
+            variant = floatVariant(instruction.type, BC_FADD_F32);
+            break;
+        case BC_FSUB:
+            variant = floatVariant(instruction.type, BC_FSUB_F32);
+            break;
+        case BC_FMUL:
+            variant = floatVariant(instruction.type, BC_FMUL_F32);
+            break;
+        case BC_FDIV:
+            variant = floatVariant(instruction.type, BC_FDIV_F32);
+            break;
+        case BC_FEQ:
+            variant = floatVariant(instruction.type, BC_FEQ_F32);
+            break;
+        case BC_FNE:
+            variant = floatVariant(instruction.type, BC_FNE_F32);
+            break;
+        case BC_FLT:
+            variant = floatVariant(instruction.type, BC_FLT_F32);
+            break;
+        case BC_FLE:
+            variant = floatVariant(instruction.type, BC_FLE_F32);
+            break;
+        case BC_FGT:
+            variant = floatVariant(instruction.type, BC_FGT_F32);
+            break;
+        case BC_FGE:
+            variant = floatVariant(instruction.type, BC_FGE_F32);
+            break;
+        case BC_LOAD:
+        {
+            static const EBytecodeOpcode loads[] = {
+                    BC_OPCODE_COUNT, BC_LOAD_FIELD_BOOL, BC_LOAD_FIELD_I8, BC_LOAD_FIELD_I16, BC_LOAD_FIELD_I32,
+                    BC_LOAD_FIELD_64, BC_LOAD_FIELD_U32, BC_LOAD_FIELD_64, BC_LOAD_FIELD_64
+            };
+            variant = loads[ instruction.type ];
+            break;
+        }
+        case BC_STORE:
+            switch ( ir::sizeOf((ir::EIRType) instruction.type))
+            {
+                case 1:
+                    variant = BC_STORE_FIELD_8;
+                    break;
+                case 2:
+                    variant = BC_STORE_FIELD_16;
+                    break;
+                case 4:
+                    variant = BC_STORE_FIELD_32;
+                    break;
+                default:
+                    variant = BC_STORE_FIELD_64;
+                    break;
+            }
+            break;
+        case BC_CALL:
+        {
+            // Functions are linked before they run, so the kind of a callee doesn't change.
+            const BytecodeFunction &callee = this->module.functions[ instruction.b ];
+            if ( callee.kind == FUNCTION_BYTECODE )
+            {
+                variant = BC_CALL_BYTECODE;
+            }
+            else if ( callee.kind == FUNCTION_BUILTIN && instruction.c <= 16 )
+            {
+                variant = BC_CALL_BUILTIN;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    // Instructions without a variant, e.g. additions of 8 bits, stay generic.
+    if ( variant == BC_OPCODE_COUNT )
+    {
+        return false;
+    }
+    instruction.opcode = variant;
+    return true;
+}
+
+void Interpreter::compile(BytecodeFunction &function)
+{
+    if ( this->compiling )
+    {
+        function.native = this->compiler.compile(function);
+    }
+}
+
+uint64_t Interpreter::call(BytecodeFunction &function, const std::vector<uint64_t> &arguments)
+{
+    if ( function.kind != FUNCTION_BYTECODE )
+    {
+        throw RuntimeError("Function " + function.name + " isn't defined in " + this->module.name);
+    }
+    std::copy(arguments.begin(), arguments.end(), this->stack.begin());
+    return this->execute(&function, this->stack.data());
+}
+
+int Interpreter::run()
+{
+    // A linked program has the initializers of all its units, which run in the order they're linked in.
+    for ( auto &function: this->module.functions )
+    {
+        if ( function.name == MODULE_INITIALIZER_NAME && function.kind == FUNCTION_BYTECODE )
+        {
+            this->call(function, {});
+        }
+    }
+
+    // 'main' receives the arguments of the program, if it declares them; the interpreter passes none.
+    int32_t entry = this->module.functionIndex("main");
+    if ( entry < 0 )
+    {
+        return 0;
+    }
+    BytecodeFunction &main = this->module.functions[ entry ];
+    std::vector<uint64_t> arguments;
+    if ( main.argumentCount > 0 )
+    {
+        arguments.push_back(allocateArray(0, sizeof(uint64_t)));
+    }
+    arguments.resize(main.argumentCount, 0);
+    uint64_t result = this->call(main, arguments);
+    return main.returnType == ir::IR_VOID ? 0 : (int) (int32_t) result;
+}
+
+// The dispatch loop
+
+#define R(index) registers[ index ]
+
+#if INTERPRETER_COMPUTED_GOTO
+#define OPCODE(name) L_##name:
+#define DISPATCH() goto *labels[ pc->opcode ]
+#else
+#define OPCODE(name) case BC_##name:
+#define DISPATCH() goto dispatch
+#endif
+
+#define NEXT() do { pc++; DISPATCH(); } while ( 0 )
+#define QUICKEN() do { if ( this->quicken(*pc)) DISPATCH(); } while ( 0 )
+
+// Continues at an instruction; in the machine code of the function, if it's compiled.
+#define ENTER(instruction) \
+    do { \
+        pc = ( instruction ); \
+        if ( function->native != nullptr ) \
+        { \
+            pc = code + function->native->run(registers, (uint32_t) ( pc - code )); \
+        } \
+        DISPATCH(); \
+    } while ( 0 )
+
+// The quickened variants of operations of a single type.
+#define INTEGER_32(name, operator) \
+    OPCODE(name) \
+        R(pc->a) = (uint64_t) (int64_t) (int32_t) ( R(pc->b) operator R(pc->c)); \
+        NEXT();
+#define INTEGER_64(name, operator) \
+    OPCODE(name) \
+        R(pc->a) = R(pc->b) operator R(pc->c); \
+        NEXT();
+#define FLOAT_32(name, operator) \
+    OPCODE(name) \
+        R(pc->a) = fromF32(asF32(R(pc->b)) operator asF32(R(pc->c))); \
+        NEXT();
+#define FLOAT_64(name, operator) \
+    OPCODE(name) \
+        R(pc->a) = fromF64(asF64(R(pc->b)) operator asF64(R(pc->c))); \
+        NEXT();
+#define COMPARE_32(name, operator) \
+    OPCODE(name) \
+        R(pc->a) = asF32(R(pc->b)) operator asF32(R(pc->c)); \
+        NEXT();
+#define COMPARE_64(name, operator) \
+    OPCODE(name) \
+        R(pc->a) = asF64(R(pc->b)) operator asF64(R(pc->c)); \
+        NEXT();
+
+uint64_t Interpreter::execute(BytecodeFunction *function, uint64_t *registers)
+{
+    const size_t depth = this->frames.size();
+    const uint64_t *stackEnd = this->stack.data() + this->stack.size();
+    Instruction *code = function->code.data();
+    Instruction *pc = code;
+    const uint64_t *constants = function->values.data();
+    BytecodeFunction *callee;
+    Instruction *target;
+    void *nativeAddress;
+    uint64_t result;
+
+#if INTERPRETER_COMPUTED_GOTO
+    static const void *labels[] = {
+            &&L_MOVE, &&L_LOAD_CONSTANT,
+            &&L_ADD, &&L_SUB, &&L_MUL, &&L_SDIV, &&L_UDIV, &&L_SREM, &&L_UREM,
+            &&L_FADD, &&L_FSUB, &&L_FMUL, &&L_FDIV, &&L_FREM,
+            &&L_SHL, &&L_LSHR, &&L_ASHR, &&L_AND, &&L_OR, &&L_XOR,
+            &&L_EQ, &&L_NE, &&L_LT, &&L_LE, &&L_GT, &&L_GE, &&L_ULT, &&L_ULE, &&L_UGT, &&L_UGE,
+            &&L_FEQ, &&L_FNE, &&L_FLT, &&L_FLE, &&L_FGT, &&L_FGE,
+            &&L_TRUNC, &&L_ZEXT, &&L_SEXT, &&L_FPTRUNC, &&L_FPEXT, &&L_SITOFP, &&L_UITOFP, &&L_FPTOSI, &&L_FPTOUI,
+            &&L_LOAD, &&L_STORE, &&L_ADDRESS, &&L_ALLOCATE, &&L_ARRAY,
+            &&L_CALL, &&L_CALL_INDIRECT, &&L_INVOKE, &&L_INVOKE_INDIRECT, &&L_ARGUMENTS, &&L_CATCH,
+            &&L_JUMP, &&L_JUMP_IF, &&L_JUMP_IF_NOT, &&L_SWITCH, &&L_RETURN, &&L_RAISE, &&L_THROW, &&L_UNREACHABLE,
+            &&L_ADD_I32, &&L_ADD_I64, &&L_SUB_I32, &&L_SUB_I64, &&L_MUL_I32, &&L_MUL_I64,
+            &&L_SDIV_I32, &&L_SDIV_I64, &&L_SREM_I32, &&L_SREM_I64,
+            &&L_FADD_F32, &&L_FADD_F64, &&L_FSUB_F32, &&L_FSUB_F64, &&L_FMUL_F32, &&L_FMUL_F64,
+            &&L_FDIV_F32, &&L_FDIV_F64,
+            &&L_FEQ_F32, &&L_FEQ_F64, &&L_FNE_F32, &&L_FNE_F64, &&L_FLT_F32, &&L_FLT_F64,
+            &&L_FLE_F32, &&L_FLE_F64, &&L_FGT_F32, &&L_FGT_F64, &&L_FGE_F32, &&L_FGE_F64,
+            &&L_LOAD_FIELD_BOOL, &&L_LOAD_FIELD_I8, &&L_LOAD_FIELD_I16, &&L_LOAD_FIELD_I32,
+            &&L_LOAD_FIELD_U32, &&L_LOAD_FIELD_64,
+            &&L_STORE_FIELD_8, &&L_STORE_FIELD_16, &&L_STORE_FIELD_32, &&L_STORE_FIELD_64,
+            &&L_CALL_BYTECODE, &&L_CALL_BUILTIN
+    };
+    static_assert(sizeof(labels) / sizeof(labels[ 0 ]) == BC_OPCODE_COUNT, "Every opcode has a label");
+#endif
+
+    // Calls continue here, in the function they call.
+    entry:
+    if ( function->native == nullptr && ++function->invocations == INTERPRETER_HOT_INVOCATIONS )
+    {
+        this->compile(*function);
+    }
+    ENTER(code);
+
+#if !INTERPRETER_COMPUTED_GOTO
+    dispatch:
+    switch ( pc->opcode )
+#endif
+    {
+        OPCODE(MOVE)
+            R(pc->a) = R(pc->b);
+            NEXT();
+
+        OPCODE(LOAD_CONSTANT)
+            R(pc->a) = constants[ pc->wide() ];
+            NEXT();
+
+        // Integer arithmetic wraps around at the width of the type.
+
+        OPCODE(ADD)
+            QUICKEN();
+            R(pc->a) = canonical(pc->type, R(pc->b) + R(pc->c));
+            NEXT();
+
+        OPCODE(SUB)
+            QUICKEN();
+            R(pc->a) = canonical(pc->type, R(pc->b) - R(pc->c));
+            NEXT();
+
+        OPCODE(MUL)
+            QUICKEN();
+            R(pc->a) = canonical(pc->type, R(pc->b) * R(pc->c));
+            NEXT();
+
+        OPCODE(SDIV)
+        OPCODE(SREM)
+            QUICKEN();
+        signedDivision:
+        {
+            auto left = (int64_t) R(pc->b);
+            auto right = (int64_t) R(pc->c);
+            if ( right == 0 )
+            {
+                throw RuntimeError("Division by zero in " + function->name);
+            }
+            // The only quotient that doesn't fit, the minimum divided by -1, wraps around.
+            bool quotient = genericOpcode(pc->opcode) == BC_SDIV;
+            uint64_t value = right == -1 ? ( quotient ? 0 - (uint64_t) left : 0 ) :
+                             (uint64_t) ( quotient ? left / right : left % right );
+            R(pc->a) = canonical(pc->type, value);
+            NEXT();
+        }
+
+        OPCODE(UDIV)
+        OPCODE(UREM)
+        {
+            uint64_t mask = maskOf(pc->type);
+            uint64_t left = R(pc->b) & mask;
+            uint64_t right = R(pc->c) & mask;
+            if ( right == 0 )
+            {
+                throw RuntimeError("Division by zero in " + function->name);
+            }
+            R(pc->a) = canonical(pc->type, pc->opcode == BC_UDIV ? left / right : left % right);
+            NEXT();
+        }
+
+        OPCODE(FADD)
+            QUICKEN();
+            R(pc->a) = fromFloat(pc->type, asFloat(pc->type, R(pc->b)) + asFloat(pc->type, R(pc->c)));
+            NEXT();
+
+        OPCODE(FSUB)
+            QUICKEN();
+            R(pc->a) = fromFloat(pc->type, asFloat(pc->type, R(pc->b)) - asFloat(pc->type, R(pc->c)));
+            NEXT();
+
+        OPCODE(FMUL)
+            QUICKEN();
+            R(pc->a) = fromFloat(pc->type, asFloat(pc->type, R(pc->b)) * asFloat(pc->type, R(pc->c)));
+            NEXT();
+
+        OPCODE(FDIV)
+            QUICKEN();
+            R(pc->a) = fromFloat(pc->type, asFloat(pc->type, R(pc->b)) / asFloat(pc->type, R(pc->c)));
+            NEXT();
+
+        OPCODE(FREM)
+            R(pc->a) = pc->type == ir::IR_F32 ? fromF32(std::fmod(asF32(R(pc->b)), asF32(R(pc->c)))) :
+                       fromF64(std::fmod(asF64(R(pc->b)), asF64(R(pc->c))));
+            NEXT();
+
+        // Shift counts are masked to the width of the type, as x86-64 does.
+
+        OPCODE(SHL)
+            R(pc->a) = canonical(pc->type, R(pc->b) << shiftCount(pc->type, R(pc->c)));
+            NEXT();
+
+        OPCODE(LSHR)
+            R(pc->a) = canonical(pc->type, ( R(pc->b) & maskOf(pc->type)) >> shiftCount(pc->type, R(pc->c)));
+            NEXT();
+
+        OPCODE(ASHR)
+            R(pc->a) = canonical(pc->type, (uint64_t) ((int64_t) R(pc->b) >> shiftCount(pc->type, R(pc->c))));
+            NEXT();
+
+        OPCODE(AND)
+            R(pc->a) = R(pc->b) & R(pc->c);
+            NEXT();
+
+        OPCODE(OR)
+            R(pc->a) = R(pc->b) | R(pc->c);
+            NEXT();
+
+        OPCODE(XOR)
+            R(pc->a) = R(pc->b) ^ R(pc->c);
+            NEXT();
+
+        // Comparisons; integers are sign extended, so signed comparisons compare all 64 bits.
+
+        OPCODE(EQ)
+            R(pc->a) = R(pc->b) == R(pc->c);
+            NEXT();
+
+        OPCODE(NE)
+            R(pc->a) = R(pc->b) != R(pc->c);
+            NEXT();
+
+        OPCODE(LT)
+            R(pc->a) = (int64_t) R(pc->b) < (int64_t) R(pc->c);
+            NEXT();
+
+        OPCODE(LE)
+            R(pc->a) = (int64_t) R(pc->b) <= (int64_t) R(pc->c);
+            NEXT();
+
+        OPCODE(GT)
+            R(pc->a) = (int64_t) R(pc->b) > (int64_t) R(pc->c);
+            NEXT();
+
+        OPCODE(GE)
+            R(pc->a) = (int64_t) R(pc->b) >= (int64_t) R(pc->c);
+            NEXT();
+
+        OPCODE(ULT)
+            R(pc->a) = ( R(pc->b) & maskOf(pc->type)) < ( R(pc->c) & maskOf(pc->type));
+            NEXT();
+
+        OPCODE(ULE)
+            R(pc->a) = ( R(pc->b) & maskOf(pc->type)) <= ( R(pc->c) & maskOf(pc->type));
+            NEXT();
+
+        OPCODE(UGT)
+            R(pc->a) = ( R(pc->b) & maskOf(pc->type)) > ( R(pc->c) & maskOf(pc->type));
+            NEXT();
+
+        OPCODE(UGE)
+            R(pc->a) = ( R(pc->b) & maskOf(pc->type)) >= ( R(pc->c) & maskOf(pc->type));
+            NEXT();
+
+        OPCODE(FEQ)
+            QUICKEN();
+            R(pc->a) = asFloat(pc->type, R(pc->b)) == asFloat(pc->type, R(pc->c));
+            NEXT();
+
+        OPCODE(FNE)
+            QUICKEN();
+            R(pc->a) = asFloat(pc->type, R(pc->b)) != asFloat(pc->type, R(pc->c));
+            NEXT();
+
+        OPCODE(FLT)
+            QUICKEN();
+            R(pc->a) = asFloat(pc->type, R(pc->b)) < asFloat(pc->type, R(pc->c));
+            NEXT();
+
+        OPCODE(FLE)
+            QUICKEN();
+            R(pc->a) = asFloat(pc->type, R(pc->b)) <= asFloat(pc->type, R(pc->c));
+            NEXT();
+
+        OPCODE(FGT)
+            QUICKEN();
+            R(pc->a) = asFloat(pc->type, R(pc->b)) > asFloat(pc->type, R(pc->c));
+            NEXT();
+
+        OPCODE(FGE)
+            QUICKEN();
+            R(pc->a) = asFloat(pc->type, R(pc->b)) >= asFloat(pc->type, R(pc->c));
+            NEXT();
+
+        // Conversions, from the type in c to the type of the instruction.
+
+        OPCODE(TRUNC)
+            R(pc->a) = canonical(pc->type, R(pc->b));
+            NEXT();
+
+        OPCODE(ZEXT)
+            R(pc->a) = R(pc->b) & maskOf(pc->c);
+            NEXT();
+
+        OPCODE(SEXT)
+            R(pc->a) = pc->c == ir::IR_BOOL ? 0 - ( R(pc->b) & 1 ) : canonical(pc->c, R(pc->b));
+            NEXT();
+
+        OPCODE(FPTRUNC)
+            R(pc->a) = fromF32((float) asF64(R(pc->b)));
+            NEXT();
+
+        OPCODE(FPEXT)
+            R(pc->a) = fromF64((double) asF32(R(pc->b)));
+            NEXT();
+
+        OPCODE(SITOFP)
+            R(pc->a) = pc->type == ir::IR_F32 ? fromF32((float) (int64_t) canonical(pc->c, R(pc->b))) :
+                       fromF64((double) (int64_t) canonical(pc->c, R(pc->b)));
+            NEXT();
+
+        OPCODE(UITOFP)
+            R(pc->a) = pc->type == ir::IR_F32 ? fromF32((float) ( R(pc->b) & maskOf(pc->c))) :
+                       fromF64((double) ( R(pc->b) & maskOf(pc->c)));
+            NEXT();
+
+        OPCODE(FPTOSI)
+            R(pc->a) = canonical(pc->type, (uint64_t) (int64_t) asFloat(pc->c, R(pc->b)));
+            NEXT();
+
+        OPCODE(FPTOUI)
+        {
+            double value = asFloat(pc->c, R(pc->b));
+            R(pc->a) = canonical(pc->type, value < 0 ? (uint64_t) (int64_t) value : (uint64_t) value);
+            NEXT();
+        }
+
+        // Memory
+
+        OPCODE(LOAD)
+            QUICKEN();
+            R(pc->a) = load(pc->type, R(pc->b) + pc->c);
+            NEXT();
+
+        OPCODE(STORE)
+            QUICKEN();
+            store(pc->type, R(pc->a) + pc->c, R(pc->b));
+            NEXT();
+
+        OPCODE(ADDRESS)
+            R(pc->a) = R(pc->b) + pc->c;
+            NEXT();
+
+        OPCODE(ALLOCATE)
+            R(pc->a) = allocateObject(pc->wide());
+            NEXT();
+
+        OPCODE(ARRAY)
+            R(pc->a) = allocateArray(pc->wide(), std::max(ir::sizeOf((ir::EIRType) pc->type), 1u));
+            NEXT();
+
+        // Calls
+
+        OPCODE(CALL)
+            QUICKEN();
+            callee = &this->module.functions[ pc->b ];
+            nativeAddress = callee->address;
+            goto call;
+
+        OPCODE(INVOKE)
+            callee = &this->module.functions[ pc->b ];
+            nativeAddress = callee->address;
+            goto call;
+
+        OPCODE(CALL_INDIRECT)
+        OPCODE(INVOKE_INDIRECT)
+            callee = this->functionAt(R(pc->b));
+            nativeAddress = callee != nullptr ? callee->address : (void *) R(pc->b);
+            goto call;
+
+        call:
+        {
+            const Instruction *arguments = pc + 1;
+            size_t argumentCount = pc->c;
+            Instruction *next = pc + 1 + ( argumentCount + 2 ) / 3;
+            Instruction *handler = nullptr;
+            if ( pc->opcode == BC_INVOKE || pc->opcode == BC_INVOKE_INDIRECT )
+            {
+                handler = code + next->wide();
+                next++;
+            }
+
+            // The registers of the callee follow those of the caller.
+            if ( callee != nullptr && callee->kind == FUNCTION_BYTECODE )
+            {
+                uint64_t *calleeRegisters = registers + function->registerCount;
+                if ( calleeRegisters + callee->registerCount > stackEnd )
+                {
+                    throw RuntimeError("Stack overflow in " + callee->name);
+                }
+                for ( size_t i = 0; i < argumentCount; i++ )
+                {
+                    calleeRegisters[ i ] = R(argumentRegister(arguments, i));
+                }
+                this->frames.push_back({ function, registers, next, handler, pc->a });
+                function = callee;
+                registers = calleeRegisters;
+                code = function->code.data();
+                constants = function->values.data();
+                goto entry;
+            }
+
+            if ( nativeAddress == nullptr )
+            {
+                throw RuntimeError("Function " + ( callee != nullptr ? callee->name : "at address 0" ) +
+                                   " isn't defined");
+            }
+            uint64_t values[16];
+            uint8_t classes[16];
+            if ( argumentCount > 16 )
+            {
+                throw RuntimeError("Native functions are called with at most 16 arguments");
+            }
+            for ( size_t i = 0; i < argumentCount; i++ )
+            {
+                values[ i ] = R(argumentRegister(arguments, i));
+                classes[ i ] = argumentClass(arguments, i);
+            }
+            result = callee != nullptr && callee->kind == FUNCTION_BUILTIN ?
+                     ((Builtin) nativeAddress)(values) :
+                     callNative(nativeAddress, (ir::EIRType) pc->type, values, classes, argumentCount);
+            if ( pc->a != BYTECODE_NO_RESULT )
+            {
+                R(pc->a) = result;
+            }
+            ENTER(next);
+        }
+
+        OPCODE(ARGUMENTS)
+            throw RuntimeError("Invalid bytecode in " + function->name);
+
+        OPCODE(CATCH)
+            R(pc->a) = canonical(pc->type, this->exception);
+            NEXT();
+
+        // Control flow
+
+        OPCODE(JUMP)
+            target = code + pc->wide();
+            goto jump;
+
+        OPCODE(JUMP_IF)
+            target = R(pc->a) ? code + pc->wide() : pc + 1;
+            goto jump;
+
+        OPCODE(JUMP_IF_NOT)
+            target = R(pc->a) ? pc + 1 : code + pc->wide();
+            goto jump;
+
+        jump:
+            // Jumps back to the start of a loop are counted, and continue in the machine code once there is some.
+            if ( target > pc )
+            {
+                pc = target;
+                DISPATCH();
+            }
+            if ( function->native == nullptr && ++function->backEdges == INTERPRETER_HOT_BACK_EDGES )
+            {
+                this->compile(*function);
+            }
+            ENTER(target);
+
+        OPCODE(SWITCH)
+        {
+            const SwitchTable &table = function->switches[ pc->wide() ];
+            auto value = (int64_t) R(pc->a);
+            auto match = std::lower_bound(table.values.begin(), table.values.end(), value);
+            pc = code + ( match != table.values.end() && *match == value ?
+                          table.targets[ match - table.values.begin() ] : table.defaultTarget );
+            DISPATCH();
+        }
+
+        OPCODE(RETURN)
+        {
+            result = pc->type == ir::IR_VOID ? 0 : R(pc->a);
+            if ( this->frames.size() == depth )
+            {
+                return result;
+            }
+            const Frame &caller = this->frames.back();
+            function = caller.function;
+            registers = caller.registers;
+            pc = caller.returnAddress;
+            if ( caller.result != BYTECODE_NO_RESULT )
+            {
+                R(caller.result) = result;
+            }
+            this->frames.pop_back();
+            code = function->code.data();
+            constants = function->values.data();
+            ENTER(pc);
+        }
+
+        OPCODE(RAISE)
+            this->exception = R(pc->a);
+            NEXT();
+
+        OPCODE(THROW)
+        {
+            // Callers continue at their handler; those without one return the exception to their caller.
+            this->exception = R(pc->a);
+            while ( this->frames.size() > depth )
+            {
+                Frame caller = this->frames.back();
+                this->frames.pop_back();
+                if ( caller.handler != nullptr )
+                {
+                    function = caller.function;
+                    registers = caller.registers;
+                    code = function->code.data();
+                    constants = function->values.data();
+                    ENTER(caller.handler);
+                }
+            }
+            throw RuntimeError("Uncaught exception " + std::to_string((int64_t) this->exception));
+        }
+
+        OPCODE(UNREACHABLE)
+            throw RuntimeError("Reached unreachable code in " + function->name);
+
+        // Quickened instructions
+
+        INTEGER_32(ADD_I32, +)
+        INTEGER_64(ADD_I64, +)
+        INTEGER_32(SUB_I32, -)
+        INTEGER_64(SUB_I64, -)
+        INTEGER_32(MUL_I32, *)
+        INTEGER_64(MUL_I64, *)
+
+        // Divisions are guarded; the generic path raises the error of a division by zero, and wraps the
+        // quotient of the minimum divided by -1. Other quotients and remainders fit the type of their operands.
+
+        OPCODE(SDIV_I32)
+        OPCODE(SDIV_I64)
+            if ( R(pc->c) == 0 || R(pc->c) == ~0ULL )
+            {
+                goto signedDivision;
+            }
+            R(pc->a) = (uint64_t) ((int64_t) R(pc->b) / (int64_t) R(pc->c));
+            NEXT();
+
+        OPCODE(SREM_I32)
+        OPCODE(SREM_I64)
+            if ( R(pc->c) == 0 || R(pc->c) == ~0ULL )
+            {
+                goto signedDivision;
+            }
+            R(pc->a) = (uint64_t) ((int64_t) R(pc->b) % (int64_t) R(pc->c));
+            NEXT();
+
+        FLOAT_32(FADD_F32, +)
+        FLOAT_64(FADD_F64, +)
+        FLOAT_32(FSUB_F32, -)
+        FLOAT_64(FSUB_F64, -)
+        FLOAT_32(FMUL_F32, *)
+        FLOAT_64(FMUL_F64, *)
+        FLOAT_32(FDIV_F32, /)
+        FLOAT_64(FDIV_F64, /)
+
+        COMPARE_32(FEQ_F32, ==)
+        COMPARE_64(FEQ_F64, ==)
+        COMPARE_32(FNE_F32, !=)
+        COMPARE_64(FNE_F64, !=)
+        COMPARE_32(FLT_F32, <)
+        COMPARE_64(FLT_F64, <)
+        COMPARE_32(FLE_F32, <=)
+        COMPARE_64(FLE_F64, <=)
+        COMPARE_32(FGT_F32, >)
+        COMPARE_64(FGT_F64, >)
+        COMPARE_32(FGE_F32, >=)
+        COMPARE_64(FGE_F64, >=)
+
+        OPCODE(LOAD_FIELD_BOOL)
+            R(pc->a) = read<uint8_t>(R(pc->b) + pc->c) & 1;
+            NEXT();
+
+        OPCODE(LOAD_FIELD_I8)
+            R(pc->a) = (uint64_t) (int64_t) read<int8_t>(R(pc->b) + pc->c);
+            NEXT();
+
+        OPCODE(LOAD_FIELD_I16)
+            R(pc->a) = (uint64_t) (int64_t) read<int16_t>(R(pc->b) + pc->c);
+            NEXT();
+
+        OPCODE(LOAD_FIELD_I32)
+            R(pc->a) = (uint64_t) (int64_t) read<int32_t>(R(pc->b) + pc->c);
+            NEXT();
+
+        OPCODE(LOAD_FIELD_U32)
+            R(pc->a) = read<uint32_t>(R(pc->b) + pc->c);
+            NEXT();
+
+        OPCODE(LOAD_FIELD_64)
+            R(pc->a) = read<uint64_t>(R(pc->b) + pc->c);
+            NEXT();
+
+        OPCODE(STORE_FIELD_8)
+            write<uint8_t>(R(pc->a) + pc->c, (uint8_t) R(pc->b));
+            NEXT();
+
+        OPCODE(STORE_FIELD_16)
+            write<uint16_t>(R(pc->a) + pc->c, (uint16_t) R(pc->b));
+            NEXT();
+
+        OPCODE(STORE_FIELD_32)
+            write<uint32_t>(R(pc->a) + pc->c, (uint32_t) R(pc->b));
+            NEXT();
+
+        OPCODE(STORE_FIELD_64)
+            write<uint64_t>(R(pc->a) + pc->c, R(pc->b));
+            NEXT();
+
+        OPCODE(CALL_BYTECODE)
+        {
+            callee = &this->module.functions[ pc->b ];
+            uint64_t *calleeRegisters = registers + function->registerCount;
+            if ( calleeRegisters + callee->registerCount > stackEnd )
+            {
+                throw RuntimeError("Stack overflow in " + callee->name);
+            }
+            const Instruction *arguments = pc + 1;
+            for ( size_t i = 0; i < pc->c; i++ )
+            {
+                calleeRegisters[ i ] = R(argumentRegister(arguments, i));
+            }
+            this->frames.push_back({ function, registers, pc + 1 + ( pc->c + 2 ) / 3, nullptr, pc->a });
+            function = callee;
+            registers = calleeRegisters;
+            code = function->code.data();
+            constants = function->values.data();
+            goto entry;
+        }
+
+        OPCODE(CALL_BUILTIN)
+        {
+            const Instruction *arguments = pc + 1;
+            uint64_t values[16];
+            for ( size_t i = 0; i < pc->c; i++ )
+            {
+                values[ i ] = R(argumentRegister(arguments, i));
+            }
+            result = ((Builtin) this->module.functions[ pc->b ].address)(values);
+            if ( pc->a != BYTECODE_NO_RESULT )
+            {
+                R(pc->a) = result;
+            }
+            ENTER(pc + 1 + ( pc->c + 2 ) / 3);
+        }
+
+#if !INTERPRETER_COMPUTED_GOTO
+        default:
+            throw RuntimeError("Invalid bytecode in " + function->name);
+#endif
+    }
+}
@@ -0,0 +1,126 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_INTERPRETER_H
+#define STRIDE_LANGUAGE_INTERPRETER_H
+
+#include <vector>
+#include "BaselineCompiler.h"
+#include "Bytecode.h"
+#include "Runtime.h"
+
+/**
+ * The amount of registers of the stack that all frames share; 8 MB.
+ */
+#define INTERPRETER_STACK_SIZE ( 1 << 20 )
+
+/**
+ * Whether the interpreter dispatches with computed gotos, a jump through a table of labels
+ * at the end of every instruction, rather than a switch; GCC and Clang support these.
+ */
+#if defined(__GNUC__)
+#define INTERPRETER_COMPUTED_GOTO 1
+#else
+#define INTERPRETER_COMPUTED_GOTO 0
+#endif
+
+/**
+ * The amount of calls, and of jumps back to the start of a loop, after which a function is compiled to machine code.
+ */
+#define INTERPRETER_HOT_INVOCATIONS 1000
+#define INTERPRETER_HOT_BACK_EDGES 10000
+
+namespace stride::vm
+{
+
+    /**
+     * Executes the bytecode of a module.
+     *
+     * The registers of all frames are windows of one stack; a call places the registers of the
+     * callee after those of the caller, and copies its arguments into them. Calls don't recurse
+     * in the interpreter, only the records of the callers are kept, in a separate stack.
+     * Exceptions unwind these records to the nearest caller with a handler.
+     *
+     * Instructions are quickened as they execute; the bytecode of the module changes while it runs.
+     * Hot functions are compiled to machine code, which the interpreter enters when they're called,
+     * at the start of a loop, or where it continues them after a call.
+     */
+    class Interpreter
+    {
+    private:
+        /**
+         * The state of a caller, which continues when its callee returns.
+         */
+        struct Frame
+        {
+            BytecodeFunction *function;
+            uint64_t *registers;
+            Instruction *returnAddress;
+
+            /**
+             * Where the caller continues if the callee throws, or nullptr if the exception continues to its caller.
+             */
+            Instruction *handler;
+            uint16_t result;
+        };
+
+        BytecodeModule &module;
+        std::vector<uint64_t> stack;
+        std::vector<Frame> frames;
+        std::vector<uint64_t> globals;
+        uint64_t exception = 0;
+        BaselineCompiler compiler;
+        bool compiling;
+
+        /**
+         * Resolves the constants of all functions, initializes the globals, and finds external functions.
+         */
+        void link();
+
+        /**
+         * Returns the function of the module at an address, or nullptr for the address of a native function.
+         */
+        BytecodeFunction *functionAt(uint64_t address) const;
+
+        /**
+         * Rewrites a generic instruction into its variant for its type or callee, the first time it executes.
+         * The types of Stride are declared, so almost every instruction has a single type, and its variant
+         * skips the checks of the type in every later execution.
+         * @return Whether the instruction was rewritten; it's executed again if it was.
+         */
+        bool quicken(Instruction &instruction) const;
+
+        /**
+         * Compiles a hot function to machine code, unless compiling is disabled.
+         */
+        void compile(BytecodeFunction &function);
+
+        /**
+         * Runs a function until it returns, with its arguments in the first of the registers.
+         */
+        uint64_t execute(BytecodeFunction *function, uint64_t *registers);
+
+    public:
+        /**
+         * @param compiling Whether hot functions are compiled to machine code, where the platform supports it.
+         */
+        explicit Interpreter(BytecodeModule &module, bool compiling = true);
+
+        ~Interpreter();
+
+        /**
+         * Calls a function of the module.
+         * @throws RuntimeError If the program fails, or the function throws an exception.
+         */
+        uint64_t call(BytecodeFunction &function, const std::vector<uint64_t> &arguments);
+
+        /**
+         * Runs the program; the module initializer, and then 'main', if there is one.
+         * @return The exit code; what 'main' returns, or 0 if it returns nothing.
+         */
+        int run();
+    };
+}
+
+#endif //STRIDE_LANGUAGE_INTERPRETER_H
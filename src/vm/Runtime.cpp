@@ -0,0 +1,206 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <dlfcn.h>
+#include <unordered_map>
+#include "Runtime.h"
+#include "Bytecode.h"
+
+using namespace stride;
+using namespace stride::vm;
+
+uint64_t stride::vm::allocateObject(uint64_t size)
+{
+    void *object = std::calloc(1, size == 0 ? 1 : size);
+    if ( object == nullptr )
+    {
+        throw RuntimeError("Out of memory");
+    }
+    return (uint64_t) object;
+}
+
+uint64_t stride::vm::allocateArray(uint64_t length, uint64_t elementSize)
+{
+    auto descriptor = (uint64_t *) allocateObject(16);
+    descriptor[ 0 ] = allocateObject(length * elementSize);
+    descriptor[ 1 ] = length;
+    return (uint64_t) descriptor;
+}
+
+// Builtins
+
+static uint64_t builtinAllocate(const uint64_t *arguments)
+{
+    return allocateObject(arguments[ 0 ]);
+}
+
+static uint64_t builtinAllocateArray(const uint64_t *arguments)
+{
+    return allocateArray(arguments[ 0 ], arguments[ 1 ]);
+}
+
+static uint64_t builtinStringConcat(const uint64_t *arguments)
+{
+    auto left = (const char *) arguments[ 0 ];
+    auto right = (const char *) arguments[ 1 ];
+    size_t leftLength = std::strlen(left);
+    size_t rightLength = std::strlen(right);
+    auto result = (char *) allocateObject(leftLength + rightLength + 1);
+    std::memcpy(result, left, leftLength);
+    std::memcpy(result + leftLength, right, rightLength);
+    return (uint64_t) result;
+}
+
+static uint64_t builtinStringCompare(const uint64_t *arguments)
+{
+    return (uint64_t) (int64_t) std::strcmp((const char *) arguments[ 0 ], (const char *) arguments[ 1 ]);
+}
+
+static uint64_t builtinPower(const uint64_t *arguments)
+{
+    // Negative exponents yield 1, as they do in the native runtime.
+    auto base = (uint64_t) arguments[ 0 ];
+    auto exponent = (int64_t) arguments[ 1 ];
+    uint64_t result = 1;
+    for ( ; exponent > 0; exponent >>= 1 )
+    {
+        if ( exponent & 1 )
+        {
+            result *= base;
+        }
+        base *= base;
+    }
+    return result;
+}
+
+static uint64_t builtinFloatPower(const uint64_t *arguments)
+{
+    double base, exponent;
+    std::memcpy(&base, &arguments[ 0 ], sizeof(base));
+    std::memcpy(&exponent, &arguments[ 1 ], sizeof(exponent));
+    double result = std::pow(base, exponent);
+    uint64_t bits;
+    std::memcpy(&bits, &result, sizeof(bits));
+    return bits;
+}
+
+Builtin stride::vm::findBuiltin(const std::string &name)
+{
+    static const std::unordered_map<std::string, Builtin> builtins = {
+            { "__stride_allocate",       builtinAllocate },
+            { "__stride_allocate_array", builtinAllocateArray },
+            { "__stride_string_concat",  builtinStringConcat },
+            { "__stride_string_compare", builtinStringCompare },
+            { "__stride_power",          builtinPower },
+            { "pow",                     builtinFloatPower }
+    };
+    auto builtin = builtins.find(name);
+    return builtin != builtins.end() ? builtin->second : nullptr;
+}
+
+void *stride::vm::findNativeFunction(const std::string &name)
+{
+    return dlsym(RTLD_DEFAULT, ir::mangle(name).c_str());
+}
+
+// Native calls
+
+/**
+ * Returns the bits of a register of a type, as the interpreter keeps them.
+ */
+static uint64_t normalize(ir::EIRType type, uint64_t value)
+{
+    switch ( type )
+    {
+        case ir::IR_BOOL:
+            return value & 0xFF ? 1 : 0;
+        case ir::IR_I8:
+            return (uint64_t) (int64_t) (int8_t) value;
+        case ir::IR_I16:
+            return (uint64_t) (int64_t) (int16_t) value;
+        case ir::IR_I32:
+            return (uint64_t) (int64_t) (int32_t) value;
+        case ir::IR_F32:
+            return value & 0xFFFFFFFF;
+        default:
+            return value;
+    }
+}
+
+#if defined(__x86_64__) && !defined(_WIN32)
+
+/*
+ * In the System V calling convention, integer and float arguments are assigned to their own
+ * registers, in order. A variadic call with six integers followed by eight doubles therefore
+ * fills all argument registers, and sets the amount of vector registers that variadic functions
+ * read. Single precision floats are passed as the low bits of a vector register.
+ */
+using IntegerFunction = uint64_t (*)(uint64_t, ...);
+using FloatFunction = double (*)(uint64_t, ...);
+
+uint64_t stride::vm::callNative(void *address, ir::EIRType returnType, const uint64_t *arguments,
+                                const uint8_t *classes, size_t count)
+{
+    uint64_t integers[6] = {};
+    double floats[8] = {};
+    size_t integerCount = 0;
+    size_t floatCount = 0;
+    for ( size_t i = 0; i < count; i++ )
+    {
+        if ( classes[ i ] == ARGUMENT_INTEGER && integerCount < 6 )
+        {
+            integers[ integerCount++ ] = arguments[ i ];
+        }
+        else if ( classes[ i ] != ARGUMENT_INTEGER && floatCount < 8 )
+        {
+            std::memcpy(&floats[ floatCount++ ], &arguments[ i ], sizeof(double));
+        }
+        else
+        {
+            throw RuntimeError("Native functions are called with at most 6 integer and 8 float arguments");
+        }
+    }
+
+    if ( ir::isFloat(returnType))
+    {
+        double result = ((FloatFunction) address)(integers[ 0 ], integers[ 1 ], integers[ 2 ], integers[ 3 ],
+                                                  integers[ 4 ], integers[ 5 ], floats[ 0 ], floats[ 1 ], floats[ 2 ],
+                                                  floats[ 3 ], floats[ 4 ], floats[ 5 ], floats[ 6 ], floats[ 7 ]);
+        uint64_t bits;
+        std::memcpy(&bits, &result, sizeof(bits));
+        return normalize(returnType, bits);
+    }
+    uint64_t result = ((IntegerFunction) address)(integers[ 0 ], integers[ 1 ], integers[ 2 ], integers[ 3 ],
+                                                  integers[ 4 ], integers[ 5 ], floats[ 0 ], floats[ 1 ], floats[ 2 ],
+                                                  floats[ 3 ], floats[ 4 ], floats[ 5 ], floats[ 6 ], floats[ 7 ]);
+    return normalize(returnType, result);
+}
+
+#else
+
+/*
+ * Other calling conventions pass variadic arguments differently, so only functions
+ * with up to six integer arguments are called, without variadic arguments.
+ */
+uint64_t stride::vm::callNative(void *address, ir::EIRType returnType, const uint64_t *arguments,
+                                const uint8_t *classes, size_t count)
+{
+    uint64_t integers[6] = {};
+    for ( size_t i = 0; i < count; i++ )
+    {
+        if ( classes[ i ] != ARGUMENT_INTEGER || i >= 6 || ir::isFloat(returnType))
+        {
+            throw RuntimeError("Native functions are called with at most 6 integer arguments on this platform");
+        }
+        integers[ i ] = arguments[ i ];
+    }
+    using Function = uint64_t (*)(uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t);
+    return normalize(returnType, ((Function) address)(integers[ 0 ], integers[ 1 ], integers[ 2 ], integers[ 3 ],
+                                                      integers[ 4 ], integers[ 5 ]));
+}
+
+#endif
@@ -0,0 +1,61 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_RUNTIME_H
+#define STRIDE_LANGUAGE_RUNTIME_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include "../ir/IR.h"
+
+namespace stride::vm
+{
+
+    /**
+     * An error that stops the interpreted program, such as a division by zero or an uncaught exception.
+     */
+    class RuntimeError : public std::runtime_error
+    {
+    public:
+        explicit RuntimeError(const std::string &message) : std::runtime_error(message)
+        {}
+    };
+
+    /**
+     * A function of the runtime of the interpreter, which takes the registers of its arguments.
+     */
+    using Builtin = uint64_t (*)(const uint64_t *arguments);
+
+    /**
+     * Returns the function of the runtime that replaces a function of the native runtime,
+     * e.g. '__stride_allocate', or nullptr if there's none.
+     */
+    Builtin findBuiltin(const std::string &name);
+
+    /**
+     * Returns the address of a native function of the process, or nullptr if there's none.
+     */
+    void *findNativeFunction(const std::string &name);
+
+    /**
+     * Calls a native function with the C calling convention. The classes of the arguments, integer or float,
+     * decide the registers they're passed in; this is how variadic functions, such as printf, are called too.
+     * @return The result, as the bits of a register of the return type.
+     */
+    uint64_t callNative(void *address, ir::EIRType returnType, const uint64_t *arguments, const uint8_t *classes,
+                        size_t count);
+
+    /**
+     * Allocates a zeroed object, as '__stride_allocate' of the native runtime does.
+     */
+    uint64_t allocateObject(uint64_t size);
+
+    /**
+     * Allocates an array descriptor, with the address of the zeroed elements at offset 0 and the length at offset 8.
+     */
+    uint64_t allocateArray(uint64_t length, uint64_t elementSize);
+}
+
+#endif //STRIDE_LANGUAGE_RUNTIME_H
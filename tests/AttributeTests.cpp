@@ -0,0 +1,72 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include "Test.h"
+#include "../src/StrideFile.h"
+#include "../src/passes/NodeAttributes.h"
+#include "../src/syntax_tree/ASTTraversal.h"
+#include "../src/syntax_tree/node_types/definitions/NBinaryOperation.h"
+#include "../src/syntax_tree/node_types/definitions/NLiteral.h"
+#include "../src/syntax_tree/node_types/definitions/NVariableDeclaration.h"
+
+using namespace stride;
+using namespace stride::passes;
+
+static const char *source =
+        "let a: i32 = 1 + 2 * 3;\n"
+        "let b: i32 = a + 1;\n"
+        "let c: i32 = f(1);\n"
+        "let d: bool = !true;\n"
+        "let e: i32 = a;\n";
+
+/**
+ * Returns the initial value of the top-level variable at the provided index.
+ */
+static NExpression *valueOf(ast::Node *root, size_t index)
+{
+    auto declaration = dynamic_cast<NVariableDeclaration *>(root->getChild(index));
+    REQUIRE(declaration != nullptr);
+    return declaration->getValue();
+}
+
+TEST(attributes, constantsPropagateUpwards)
+{
+    StrideFile file(test::writeSource("attributes.sr", source).c_str());
+    ast::Node *root = file.parse();
+    REQUIRE(root != nullptr && root->getChildCount() == 5);
+    EXPECT(computeAttributes(root));
+
+    EXPECT(isConstant(valueOf(root, 0)));
+    EXPECT(isConstant(valueOf(root, 3)));
+
+    // Expressions with a variable or a call aren't constant, but they contain constants.
+    EXPECT(!isConstant(valueOf(root, 1)));
+    EXPECT(attributesOf(valueOf(root, 1)).flags & NODE_ATTRIBUTE_HAS_CONSTANT);
+    EXPECT(!isConstant(valueOf(root, 2)));
+    EXPECT(attributesOf(valueOf(root, 2)).flags & NODE_ATTRIBUTE_HAS_CONSTANT);
+    EXPECT(!( attributesOf(valueOf(root, 4)).flags & NODE_ATTRIBUTE_HAS_CONSTANT ));
+    EXPECT(attributesOf(root).flags & NODE_ATTRIBUTE_HAS_CONSTANT);
+}
+
+TEST(attributes, mutationsUpdateAncestors)
+{
+    StrideFile file(test::writeSource("attributes_mutation.sr", source).c_str());
+    ast::Node *root = file.parse();
+    REQUIRE(root != nullptr && root->getChildCount() == 5);
+    computeAttributes(root);
+
+    // Nothing changed, so nothing is recomputed.
+    EXPECT(!computeAttributes(root));
+
+    // Replacing the variable by a literal makes the expression constant.
+    auto binary = dynamic_cast<NBinaryOperation *>(valueOf(root, 1));
+    REQUIRE(binary != nullptr);
+    ast::Node *variable = binary->left;
+    EXPECT(ast::replaceSubnode(binary, variable, new NLiteral((int64_t) 5)));
+    delete variable;
+
+    EXPECT(computeAttributes(root));
+    EXPECT(isConstant(valueOf(root, 1)));
+    EXPECT(!isConstant(valueOf(root, 2)));
+}
@@ -0,0 +1,135 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include "Test.h"
+#include "../src/StrideFile.h"
+#include "../src/cache/Hash.h"
+#include "../src/vm/BytecodeSerializer.h"
+
+using namespace stride;
+using namespace stride::vm;
+using namespace stride::vm::serialization;
+
+static const char *source =
+        "define twice(x: i64) -> i64 {\n"
+        "    return x * 2;\n"
+        "}\n"
+        "define main() -> i32 {\n"
+        "    if twice(21) == 42 {\n"
+        "        return 0;\n"
+        "    }\n"
+        "    return 1;\n"
+        "}\n";
+
+/**
+ * Builds the bytecode of a source file, with the '.srb' file next to it rather than in a cache directory.
+ * @return Whether the build succeeded and has the functions of the source.
+ */
+static bool buildSource(const std::string &path)
+{
+    StrideFile file(path.c_str());
+    file.setEnvironment({{ "STRIDE_CACHE_DIR", "" }});
+    if ( !file.buildBytecode())
+    {
+        return false;
+    }
+    const BytecodeModule *module = file.getBytecode();
+    return module->functionIndex("twice") >= 0 && module->functionIndex("main") >= 0;
+}
+
+static std::vector<uint8_t> readFile(const std::string &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return { std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+}
+
+static void writeFile(const std::string &path, const std::vector<uint8_t> &content)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(content.data()), (std::streamsize) content.size());
+}
+
+/**
+ * Stores the checksum of the content after the header, as the writer does.
+ */
+static void updateChecksum(std::vector<uint8_t> &content)
+{
+    uint64_t checksum = cache::hash(content.data() + sizeof(bytecode_file_header_t),
+                                    content.size() - sizeof(bytecode_file_header_t));
+    std::memcpy(content.data() + offsetof(bytecode_file_header_t, checksum), &checksum, sizeof(checksum));
+}
+
+TEST(bytecode, checksumRejectsCorruption)
+{
+    std::string path = test::writeSource("bytecode_checksum.sr", source);
+    std::string bytecodePath = path.substr(0, path.size() - 3) + ".srb";
+    std::remove(bytecodePath.c_str());
+    REQUIRE(buildSource(path));
+    std::vector<uint8_t> original = readFile(bytecodePath);
+    REQUIRE(original.size() > sizeof(bytecode_file_header_t));
+
+    std::unique_ptr<BytecodeView> view(BytecodeView::fromBuffer(original.data(), original.size()));
+    EXPECT(view != nullptr);
+
+    // A flipped bit anywhere after the header, or a missing tail, fails the checksum.
+    for ( size_t offset = sizeof(bytecode_file_header_t); offset < original.size(); offset += 7 )
+    {
+        std::vector<uint8_t> corrupted = original;
+        corrupted[ offset ] ^= 0x10;
+        std::unique_ptr<BytecodeView> rejected(BytecodeView::fromBuffer(corrupted.data(), corrupted.size()));
+        EXPECT(rejected == nullptr);
+    }
+    std::vector<uint8_t> truncated(original.begin(), original.end() - 8);
+    std::unique_ptr<BytecodeView> shortened(BytecodeView::fromBuffer(truncated.data(), truncated.size()));
+    EXPECT(shortened == nullptr);
+}
+
+TEST(bytecode, malformedFilesAreCompiledAgain)
+{
+    std::string path = test::writeSource("bytecode_malformed.sr", source);
+    std::string bytecodePath = path.substr(0, path.size() - 3) + ".srb";
+    std::remove(bytecodePath.c_str());
+    REQUIRE(buildSource(path));
+    std::vector<uint8_t> original = readFile(bytecodePath);
+
+    // A corrupted file is rejected by its checksum, and overwritten with fresh bytecode.
+    std::vector<uint8_t> corrupted = original;
+    corrupted.back() ^= 0xFF;
+    writeFile(bytecodePath, corrupted);
+    EXPECT(buildSource(path));
+    EXPECT(readFile(bytecodePath) == original);
+
+    // Bytecode with a valid checksum, but with a function name that doesn't exist, fails to
+    // materialize; that's handled the same way.
+    std::vector<uint8_t> invalid = original;
+    bytecode_file_header_t header {};
+    std::memcpy(&header, invalid.data(), sizeof(header));
+    REQUIRE(header.functionCount > 0);
+    uint32_t name = header.stringCount + 100;
+    std::memcpy(invalid.data() + header.functionsOffset + offsetof(bytecode_function_record_t, name), &name,
+                sizeof(name));
+    updateChecksum(invalid);
+    std::unique_ptr<BytecodeView> view(BytecodeView::fromBuffer(invalid.data(), invalid.size()));
+    REQUIRE(view != nullptr);
+    bool thrown = false;
+    try
+    {
+        materialize(*view);
+    }
+    catch ( const std::runtime_error & )
+    {
+        thrown = true;
+    }
+    EXPECT(thrown);
+
+    writeFile(bytecodePath, invalid);
+    EXPECT(buildSource(path));
+    EXPECT(readFile(bytecodePath) == original);
+}
@@ -0,0 +1,114 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <cstdlib>
+#include <filesystem>
+#include "Test.h"
+#include "../src/StrideFile.h"
+#include "../src/cache/CompilationCache.h"
+#include "../src/tokens/tokenizer.h"
+
+using namespace stride::cache;
+
+/**
+ * Returns an empty cache directory for the provided test.
+ */
+static std::string cacheDirectory(const std::string &name)
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "stride_tests" / name;
+    std::filesystem::remove_all(directory);
+    return directory.string();
+}
+
+static uint64_t keyOf(const std::string &content, const std::string &flag = "", long int value = 0)
+{
+    stride::StrideFile file(stride::test::writeSource("cache_key.sr", content).c_str());
+    if ( !flag.empty())
+    {
+        std::string name = flag;
+        file.setCompilerFlag(name, value);
+    }
+    return CompilationCache::computeKey(file);
+}
+
+TEST(cache, keyDependsOnSemanticInputs)
+{
+    const std::string source = "let a: i32 = 1;\n";
+    EXPECT_EQ(keyOf(source), keyOf(source));
+    EXPECT(keyOf(source) != keyOf("let a: i32 = 2;\n"));
+    EXPECT(keyOf(source, "optimize", 0) != keyOf(source, "optimize", 2));
+
+    // Flags that don't influence the output, such as those of the cache itself, share their entries.
+    EXPECT_EQ(keyOf(source, "cache-stats", 1), keyOf(source));
+
+    stride::StrideFile file(stride::test::writeSource("cache_dependencies.sr", source).c_str());
+    EXPECT(CompilationCache::computeKey(file, { 1 }) != CompilationCache::computeKey(file, { 2 }));
+}
+
+TEST(cache, storesArtifactsOnDisk)
+{
+    std::string directory = cacheDirectory("cache_disk");
+    std::vector<uint8_t> object = { 0x7f, 'E', 'L', 'F', 1, 2, 3 };
+    {
+        CompilationCache cache(directory);
+        cache.store(7, ARTIFACT_OBJECT, object);
+    }
+
+    // A new cache over the same directory, e.g. of a later compilation, finds the entry.
+    CompilationCache cache(directory);
+    std::vector<uint8_t> loaded;
+    EXPECT(cache.load(7, ARTIFACT_OBJECT, loaded));
+    EXPECT(loaded == object);
+    EXPECT(!cache.load(8, ARTIFACT_OBJECT, loaded));
+    EXPECT(!cache.load(7, ARTIFACT_BYTECODE, loaded));
+    EXPECT_EQ(cache.getStatistics().hits[ ARTIFACT_OBJECT ].load(), 1u);
+    EXPECT_EQ(cache.getStatistics().misses[ ARTIFACT_OBJECT ].load(), 1u);
+}
+
+TEST(cache, keepsEntriesInMemory)
+{
+    CompilationCache cache("");
+    cache.setMemoryCapacity(1024);
+    std::vector<uint8_t> data(16, 0xAB);
+    cache.store(1, ARTIFACT_BYTECODE, data);
+
+    std::vector<uint8_t> loaded;
+    EXPECT(cache.load(1, ARTIFACT_BYTECODE, loaded));
+    EXPECT(loaded == data);
+
+    // Storing more than the capacity evicts the least recently used entry.
+    cache.store(2, ARTIFACT_BYTECODE, std::vector<uint8_t>(1020, 0));
+    EXPECT(!cache.load(1, ARTIFACT_BYTECODE, loaded));
+    EXPECT(cache.load(2, ARTIFACT_BYTECODE, loaded));
+}
+
+TEST(cache, tokensRoundTrip)
+{
+    CompilationCache cache(cacheDirectory("cache_tokens"));
+    stride::StrideFile file(stride::test::writeSource("cache_tokens.sr", "let name: string = \"text\";\n").c_str());
+    std::vector<token_t> *tokens = stride::tokenizeRange(&file, 0, (int) file.getContent().size());
+    cache.storeTokens(3, *tokens);
+
+    std::vector<token_t> *loaded = cache.loadTokens(3);
+    REQUIRE(loaded != nullptr);
+    REQUIRE(loaded->size() == tokens->size());
+    for ( size_t i = 0; i < tokens->size(); i++ )
+    {
+        EXPECT_EQ(( *loaded )[ i ].type, ( *tokens )[ i ].type);
+        EXPECT_EQ(std::string(( *loaded )[ i ].value), std::string(( *tokens )[ i ].value));
+        EXPECT_EQ(( *loaded )[ i ].index, ( *tokens )[ i ].index);
+    }
+    for ( auto list: { tokens, loaded } )
+    {
+        for ( auto &token: *list )
+        {
+            free(token.value);
+        }
+        delete list;
+    }
+
+    // Entries that aren't valid token streams are misses, rather than errors.
+    cache.store(4, ARTIFACT_TOKENS, { 'S', 'T', 'O' });
+    EXPECT(cache.loadTokens(4) == nullptr);
+}
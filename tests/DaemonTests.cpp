@@ -0,0 +1,101 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "Test.h"
+#include "../src/daemon/CompileClient.h"
+#include "../src/daemon/CompileServer.h"
+#include "../src/daemon/Protocol.h"
+
+using namespace stride::daemon;
+
+TEST(daemon, stringsRoundTrip)
+{
+    int descriptors[2];
+    REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, descriptors) == 0);
+    EXPECT(writeString(descriptors[ 0 ], "first"));
+    EXPECT(writeString(descriptors[ 0 ], ""));
+
+    std::string value;
+    EXPECT(readString(descriptors[ 1 ], value));
+    EXPECT_EQ(value, "first");
+    EXPECT(readString(descriptors[ 1 ], value));
+    EXPECT_EQ(value, "");
+
+    // Lengths beyond the limit are rejected before anything is allocated.
+    uint32_t length = DAEMON_MAX_STRING_LENGTH + 1;
+    EXPECT(writeAll(descriptors[ 0 ], &length, sizeof(length)));
+    EXPECT(!readString(descriptors[ 1 ], value));
+
+    // So are strings that end before their length.
+    length = 8;
+    EXPECT(writeAll(descriptors[ 0 ], &length, sizeof(length)));
+    EXPECT(writeAll(descriptors[ 0 ], "abc", 3));
+    close(descriptors[ 0 ]);
+    EXPECT(!readString(descriptors[ 1 ], value));
+    close(descriptors[ 1 ]);
+}
+
+/**
+ * Sends raw bytes to the server as a request.
+ * @return Whether the server replied, rather than closing the connection.
+ */
+static bool sendRaw(const std::string &socketPath, const void *data, size_t size)
+{
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    int connection = socket(AF_UNIX, SOCK_STREAM, 0);
+    if ( connection < 0 || connect(connection, (sockaddr *) &address, sizeof(address)) != 0 )
+    {
+        close(connection);
+        return false;
+    }
+    writeAll(connection, data, size);
+    shutdown(connection, SHUT_WR);
+
+    char byte;
+    bool replied = read(connection, &byte, 1) == 1;
+    close(connection);
+    return replied;
+}
+
+TEST(daemon, serverRejectsMalformedRequests)
+{
+    std::string socketPath = ( std::filesystem::temp_directory_path() / "stride_tests_daemon.sock" ).string();
+    CompileServer server(socketPath, 2, 0);
+    std::ostringstream startErrors;
+    REQUIRE(server.start(startErrors));
+    std::thread serving([ &server ]
+                        { server.serve(); });
+
+    const char garbage[] = "GET / HTTP/1.1\r\n\r\n";
+    EXPECT(!sendRaw(socketPath, garbage, sizeof(garbage)));
+
+    daemon_request_header_t header {};
+    memcpy(header.magic, DAEMON_REQUEST_MAGIC, 4);
+    header.version = DAEMON_PROTOCOL_VERSION;
+    header.argumentCount = DAEMON_MAX_ARGUMENT_COUNT + 1;
+    EXPECT(!sendRaw(socketPath, &header, sizeof(header)));
+
+    header.argumentCount = 1;
+    header.environmentCount = DAEMON_MAX_ENVIRONMENT_COUNT + 1;
+    EXPECT(!sendRaw(socketPath, &header, sizeof(header)));
+
+    // A request that's cut off halfway gets no response either.
+    header.environmentCount = 0;
+    EXPECT(!sendRaw(socketPath, &header, sizeof(header)));
+
+    // The server still handles well-formed requests afterwards.
+    std::ostringstream out, err;
+    std::optional<int> exitCode = forwardToServer(socketPath, { "--stop-server" }, out, err);
+    EXPECT(exitCode.has_value() && *exitCode == 0);
+    serving.join();
+}
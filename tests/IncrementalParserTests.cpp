@@ -0,0 +1,210 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <cstdlib>
+#include <memory>
+#include "Test.h"
+#include "../src/StrideFile.h"
+#include "../src/syntax_tree/ASTSerializer.h"
+#include "../src/syntax_tree/ASTTraversal.h"
+#include "../src/syntax_tree/IncrementalParser.h"
+#include "../src/tokens/TokenSet.h"
+#include "../src/tokens/tokenizer.h"
+
+using namespace stride::ast;
+using namespace stride::ast::incremental;
+
+static const char *source =
+        "define external puts(s: string) -> i32;\n"
+        "define first(a: i32) -> i32 {\n"
+        "    let b: i32 = a + 1;\n"
+        "    return b * 2;\n"
+        "}\n"
+        "/* The greeting is printed once. */\n"
+        "define second(x: i32) -> i32 {\n"
+        "    if x > 3 {\n"
+        "        puts(\"large\");\n"
+        "    }\n"
+        "    return x;\n"
+        "}\n"
+        "define third() -> i32 {\n"
+        "    return first(1) + second(2);\n"
+        "}\n";
+
+/**
+ * A source file, along with the tokens and the syntax tree that are edited in place.
+ */
+struct Document
+{
+    std::unique_ptr<stride::StrideFile> file;
+    std::vector<token_t> tokens;
+    Node root;
+
+    explicit Document(const std::string &name)
+    {
+        file = std::make_unique<stride::StrideFile>(stride::test::writeSource(name, source).c_str());
+        tokens = tokenize();
+        TokenSet tokenSet(&tokens, file.get());
+        parser::parse(tokenSet, root);
+    }
+
+    ~Document()
+    {
+        release(tokens);
+    }
+
+    [[nodiscard]] std::vector<token_t> tokenize() const
+    {
+        std::vector<token_t> *fresh = stride::tokenizeRange(file.get(), 0, (int) file->getContent().size());
+        std::vector<token_t> result = std::move(*fresh);
+        delete fresh;
+        return result;
+    }
+
+    static void release(std::vector<token_t> &list)
+    {
+        for ( auto &token: list )
+        {
+            free(token.value);
+        }
+    }
+
+    /**
+     * Replaces the first occurrence of a text, and reparses the affected part of the tree.
+     */
+    ReparseResult replace(const std::string &text, const std::string &replacement)
+    {
+        size_t start = file->getContent().find(text);
+        REQUIRE(start != std::string::npos);
+        ReparseResult result = reparse(*file, root, tokens, { (int) start, (int) text.size(), replacement });
+        for ( auto node: result.removedNodes )
+        {
+            delete node;
+        }
+        return result;
+    }
+
+    /**
+     * Checks that the tokens and the tree are the same as those of a fresh parse of the content.
+     */
+    void expectFreshParse()
+    {
+        std::vector<token_t> freshTokens = tokenize();
+        EXPECT_EQ(tokens.size(), freshTokens.size());
+        for ( size_t i = 0; i < tokens.size() && i < freshTokens.size(); i++ )
+        {
+            EXPECT_EQ(tokens[ i ].type, freshTokens[ i ].type);
+            EXPECT_EQ(tokens[ i ].index, freshTokens[ i ].index);
+        }
+
+        Node fresh;
+        TokenSet tokenSet(&freshTokens, file.get());
+        parser::parse(tokenSet, fresh);
+        EXPECT(serialization::serialize(root) == serialization::serialize(fresh));
+        release(freshTokens);
+    }
+};
+
+/**
+ * Returns all nodes of a subtree, in pre-order.
+ */
+static std::vector<Node *> collectNodes(Node *node)
+{
+    std::vector<Node *> nodes;
+    walk(node, [ &nodes ](Node *visited)
+    {
+        nodes.push_back(visited);
+        return true;
+    });
+    return nodes;
+}
+
+TEST(incremental, editInsideExpression)
+{
+    Document document("incremental_expression.sr");
+    std::vector<Node *> external = collectNodes(document.root.getChild(0));
+    std::vector<Node *> second = collectNodes(document.root.getChild(2));
+
+    ReparseResult result = document.replace("a + 1", "a + 42 * a");
+    EXPECT(!result.fullReparse);
+    EXPECT(result.container != &document.root);
+    EXPECT_EQ(result.insertedNodes.size(), 1u);
+    document.expectFreshParse();
+
+    // The other declarations keep their nodes; the ones after the edit are only moved.
+    EXPECT(collectNodes(document.root.getChild(0)) == external);
+    EXPECT(collectNodes(document.root.getChild(2)) == second);
+}
+
+TEST(incremental, insertAndDeleteStatements)
+{
+    Document document("incremental_statements.sr");
+    std::vector<Node *> third = collectNodes(document.root.getChild(3));
+
+    ReparseResult inserted = document.replace("    return x;\n", "    let y: i32 = x * x;\n    return y;\n");
+    EXPECT(!inserted.fullReparse);
+    document.expectFreshParse();
+
+    ReparseResult deleted = document.replace("    if x > 3 {\n        puts(\"large\");\n    }\n", "");
+    EXPECT(!deleted.fullReparse);
+    EXPECT(deleted.insertedNodes.empty());
+    document.expectFreshParse();
+
+    EXPECT(collectNodes(document.root.getChild(3)) == third);
+}
+
+TEST(incremental, unterminatedTokensReparseFully)
+{
+    // The string literal now ends at the quote of the next declaration.
+    Document strings("incremental_string.sr");
+    ReparseResult string = strings.replace("let b: i32 = a + 1;", "let b: string = \"a + 1;");
+    EXPECT(string.fullReparse);
+    strings.expectFreshParse();
+
+    // The comment now ends at the end of the comment between the declarations.
+    Document comments("incremental_comment.sr");
+    ReparseResult comment = comments.replace("return b * 2;", "/* return b * 2;");
+    EXPECT(comment.fullReparse);
+    comments.expectFreshParse();
+}
+
+TEST(incremental, editAcrossDeclarations)
+{
+    Document document("incremental_across.sr");
+    std::vector<Node *> third = collectNodes(document.root.getChild(3));
+
+    ReparseResult result = document.replace("b * 2;\n}\n/* The greeting is printed once. */\ndefine second",
+                                            "b * 3;\n}\ndefine renamed");
+    EXPECT(!result.fullReparse);
+    EXPECT(result.container == &document.root);
+    EXPECT_EQ(result.removedNodes.size(), 2u);
+    EXPECT_EQ(result.insertedNodes.size(), 2u);
+    document.expectFreshParse();
+    EXPECT(collectNodes(document.root.getChild(3)) == third);
+}
+
+TEST(incremental, braceEditsAtBlockBoundary)
+{
+    Document document("incremental_braces.sr");
+    std::vector<uint8_t> original = serialization::serialize(document.root);
+
+    // Removing the closing brace of a block merges it with the statements after it,
+    // which changes the structure outside of the region.
+    EXPECT(document.replace("        puts(\"large\");\n    }\n", "        puts(\"large\");\n").fullReparse);
+    document.expectFreshParse();
+    document.replace("        puts(\"large\");\n", "        puts(\"large\");\n    }\n");
+    document.expectFreshParse();
+    EXPECT(serialization::serialize(document.root) == original);
+
+    // The same holds for the closing brace of a declaration, followed by another one.
+    document.replace("    return x;\n}\n", "    return x;\n");
+    document.expectFreshParse();
+    document.replace("    return x;\n", "    return x;\n}\n");
+    document.expectFreshParse();
+    EXPECT(serialization::serialize(document.root) == original);
+
+    // An opening brace directly after another one opens a nested block.
+    document.replace("-> i32 {\n    let b", "-> i32 {{\n    let b");
+    document.expectFreshParse();
+}
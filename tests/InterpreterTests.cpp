@@ -0,0 +1,182 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <cstring>
+#include <string>
+#include "Test.h"
+#include "../src/StrideFile.h"
+#include "../src/vm/Interpreter.h"
+
+using namespace stride;
+using namespace stride::vm;
+
+static const char *source =
+        "define square(x: i64) -> i64 {\n"
+        "    return x * x;\n"
+        "}\n"
+        "define sumOfSquares(n: i64) -> i64 {\n"
+        "    let total: i64 = 0;\n"
+        "    let i: i64 = 0;\n"
+        "    while (i < n) {\n"
+        "        total = total + square(i);\n"
+        "        i = i + 1;\n"
+        "    };\n"
+        "    return total;\n"
+        "}\n"
+        "define average(a: f64, b: f64) -> f64 {\n"
+        "    return (a + b) / 2.0;\n"
+        "}\n"
+        "define ratio(a: i64, b: i64) -> i64 {\n"
+        "    return a / b;\n"
+        "}\n";
+
+/**
+ * Compiles the source to bytecode, and returns it as a module of its own, which the interpreter can rewrite.
+ */
+static BytecodeModule compileModule(const std::string &name)
+{
+    StrideFile file(test::writeSource(name, source).c_str());
+    std::string flag = "no-bytecode-cache";
+    file.setCompilerFlag(flag, 1L);
+    REQUIRE(file.buildBytecode());
+    return linkModules(name, { file.getBytecode() });
+}
+
+static BytecodeFunction &functionOf(BytecodeModule &module, const std::string &name)
+{
+    int32_t index = module.functionIndex(name);
+    REQUIRE(index >= 0);
+    return module.functions[ index ];
+}
+
+/**
+ * Returns the amount of instructions of a function with a quickened opcode.
+ */
+static size_t quickenedCount(const BytecodeFunction &function)
+{
+    size_t count = 0;
+    for ( auto &instruction: function.code )
+    {
+        count += genericOpcode(instruction.opcode) != instruction.opcode ? 1 : 0;
+    }
+    return count;
+}
+
+static bool hasOpcode(const BytecodeFunction &function, EBytecodeOpcode opcode)
+{
+    for ( auto &instruction: function.code )
+    {
+        if ( instruction.opcode == opcode )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST(interpreter, quickensExecutedInstructions)
+{
+    BytecodeModule module = compileModule("interpreter_quicken.sr");
+    BytecodeFunction &sum = functionOf(module, "sumOfSquares");
+    BytecodeFunction &average = functionOf(module, "average");
+    EXPECT_EQ(quickenedCount(sum), 0u);
+
+    Interpreter interpreter(module, false);
+    EXPECT_EQ(interpreter.call(sum, { 10 }), 285u);
+
+    // The instructions that ran are rewritten for their types and callees, and give the same result afterwards.
+    EXPECT(hasOpcode(sum, BC_ADD_I64));
+    EXPECT(hasOpcode(sum, BC_CALL_BYTECODE));
+    EXPECT(hasOpcode(functionOf(module, "square"), BC_MUL_I64));
+    EXPECT_EQ(interpreter.call(sum, { 10 }), 285u);
+
+    // Functions that never ran keep their generic instructions.
+    EXPECT_EQ(quickenedCount(average), 0u);
+    double a = 1.5, b = 4.5, result;
+    uint64_t arguments[ 2 ];
+    std::memcpy(&arguments[ 0 ], &a, sizeof(a));
+    std::memcpy(&arguments[ 1 ], &b, sizeof(b));
+    uint64_t bits = interpreter.call(average, { arguments[ 0 ], arguments[ 1 ] });
+    std::memcpy(&result, &bits, sizeof(result));
+    EXPECT(result == 3.0);
+    EXPECT(hasOpcode(average, BC_FADD_F64));
+    EXPECT(hasOpcode(average, BC_FDIV_F64));
+}
+
+TEST(interpreter, quickenedDivisionKeepsItsGuard)
+{
+    BytecodeModule module = compileModule("interpreter_division.sr");
+    BytecodeFunction &ratio = functionOf(module, "ratio");
+    Interpreter interpreter(module, false);
+
+    EXPECT_EQ(interpreter.call(ratio, { 7, (uint64_t) -2 }), (uint64_t) -3);
+    EXPECT(hasOpcode(ratio, BC_SDIV_I64));
+
+    // The divisors that the quickened instruction can't divide by still take the generic path.
+    EXPECT_EQ(interpreter.call(ratio, { (uint64_t) INT64_MIN, (uint64_t) -1 }), (uint64_t) INT64_MIN);
+    bool thrown = false;
+    try
+    {
+        interpreter.call(ratio, { 1, 0 });
+    }
+    catch ( const RuntimeError & )
+    {
+        thrown = true;
+    }
+    EXPECT(thrown);
+    EXPECT(hasOpcode(ratio, BC_SDIV_I64));
+}
+
+TEST(interpreter, compilesHotFunctions)
+{
+    BytecodeModule module = compileModule("interpreter_hot.sr");
+    BytecodeFunction &sum = functionOf(module, "sumOfSquares");
+    BytecodeFunction &square = functionOf(module, "square");
+    BytecodeFunction &ratio = functionOf(module, "ratio");
+    Interpreter interpreter(module);
+
+    // A short loop stays interpreted.
+    EXPECT_EQ(interpreter.call(sum, { 10 }), 285u);
+    EXPECT(sum.native == nullptr);
+    EXPECT(square.native == nullptr);
+
+    // 'square' is called often enough to be compiled, and the loop of 'sumOfSquares' runs long enough.
+    // The result is the same as that of the interpreter, which switches to the machine code halfway.
+    uint64_t n = INTERPRETER_HOT_BACK_EDGES + 10;
+    uint64_t expected = ( n - 1 ) * n * ( 2 * n - 1 ) / 6;
+    EXPECT_EQ(interpreter.call(sum, { n }), expected);
+    EXPECT_EQ(sum.native != nullptr, BASELINE_COMPILER_SUPPORTED == 1);
+    EXPECT_EQ(square.native != nullptr, BASELINE_COMPILER_SUPPORTED == 1);
+    EXPECT_EQ(interpreter.call(sum, { 10 }), 285u);
+
+    // Compiled code reports the same runtime errors.
+    for ( int i = 0; i < INTERPRETER_HOT_INVOCATIONS; i++ )
+    {
+        EXPECT_EQ(interpreter.call(ratio, { (uint64_t) i, 2 }), (uint64_t) i / 2);
+    }
+    EXPECT_EQ(ratio.native != nullptr, BASELINE_COMPILER_SUPPORTED == 1);
+    EXPECT_EQ(interpreter.call(ratio, { (uint64_t) INT64_MIN, (uint64_t) -1 }), (uint64_t) INT64_MIN);
+    bool thrown = false;
+    try
+    {
+        interpreter.call(ratio, { 1, 0 });
+    }
+    catch ( const RuntimeError & )
+    {
+        thrown = true;
+    }
+    EXPECT(thrown);
+}
+
+TEST(interpreter, compilingCanBeDisabled)
+{
+    BytecodeModule module = compileModule("interpreter_no_jit.sr");
+    BytecodeFunction &sum = functionOf(module, "sumOfSquares");
+    Interpreter interpreter(module, false);
+
+    uint64_t n = INTERPRETER_HOT_BACK_EDGES + 10;
+    EXPECT_EQ(interpreter.call(sum, { n }), ( n - 1 ) * n * ( 2 * n - 1 ) / 6);
+    EXPECT(sum.native == nullptr);
+    EXPECT(functionOf(module, "square").native == nullptr);
+}
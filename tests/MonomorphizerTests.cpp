@@ -0,0 +1,70 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <algorithm>
+#include "Test.h"
+#include "../src/StrideFile.h"
+#include "../src/semantic/Monomorphizer.h"
+#include "../src/semantic/NameResolver.h"
+
+using namespace stride;
+using namespace stride::semantic;
+
+static const char *source =
+        "struct Pair<T> {\n"
+        "    first: T;\n"
+        "    second: T;\n"
+        "}\n"
+        "struct Node<T> {\n"
+        "    value: T;\n"
+        "    next: Pair<T>;\n"
+        "}\n"
+        "define sum(p: Pair<i32>) -> i32 {\n"
+        "    return 0;\n"
+        "}\n"
+        "define main() -> i32 {\n"
+        "    let a: Pair<i32>;\n"
+        "    let b: Pair<i32>;\n"
+        "    let c: Node<f64>;\n"
+        "    let d: Pair<i8>;\n"
+        "    return 0;\n"
+        "}\n";
+
+TEST(generics, instantiatesOncePerArguments)
+{
+    StrideFile file(test::writeSource("generics.sr", source).c_str());
+    ast::Node *root = file.parse();
+    REQUIRE(root != nullptr);
+
+    SymbolTable symbols;
+    NameResolver resolver(file, symbols);
+    resolver.run(*root);
+    TypeTable types;
+    TypeChecker checker(file, symbols, types);
+    checker.run(*root);
+    Monomorphizer monomorphizer(file, symbols, types, checker);
+    monomorphizer.run(*root);
+    EXPECT(!file.diagnostics().hasErrors());
+
+    // 'Pair<i32>' is used three times, and 'Pair<f64>' only through the fields of 'Node<f64>'.
+    std::vector<std::string> names;
+    for ( auto instantiation: monomorphizer.getInstantiations())
+    {
+        names.push_back(instantiation->symbol);
+    }
+    std::sort(names.begin(), names.end());
+    std::vector<std::string> expected = { "Node<f64>", "Pair<f64>", "Pair<i32>", "Pair<i8>" };
+    EXPECT(names == expected);
+    EXPECT(monomorphizer.getRequestCount() > monomorphizer.getInstantiations().size());
+
+    // Every instantiation specializes the fields of its declaration.
+    for ( auto instantiation: monomorphizer.getInstantiations())
+    {
+        EXPECT_EQ(instantiation->members.size(), 2u);
+        for ( auto &member: instantiation->members )
+        {
+            EXPECT(Monomorphizer::isConcrete(member.type));
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#
+# Created by Luca Warmenhoven on 18/10/2026.
+#
+# Compiles every benchmark program natively at -O0 and at -O2, runs each build a
+# few times, and prints the fastest run of both, along with the speedup of -O2.
+# Both builds must print the same output, so a benchmark also checks that the
+# optimizations keep the result of the program the same.
+#
+# Usage: cmake -DSTRIDE=<compiler> -DCC=<C compiler> -DRUNTIME=<runtime library>
+#              -DBENCHMARKS=<directory of programs> -DWORK=<scratch directory>
+#              [-DREPETITIONS=<runs per build>] -P RunBenchmarks.cmake
+#
+cmake_minimum_required(VERSION 3.23)
+
+if (NOT REPETITIONS)
+    set(REPETITIONS 3)
+endif ()
+set(levels -O0 -O2)
+
+# Returns the current time in microseconds; the microseconds are always six digits.
+function(now variable)
+    string(TIMESTAMP time "%s%f" UTC)
+    set(${variable} ${time} PARENT_SCOPE)
+endfunction()
+
+# Formats a duration in microseconds as milliseconds, with one decimal.
+function(milliseconds variable duration)
+    math(EXPR whole "${duration} / 1000")
+    math(EXPR tenths "${duration} % 1000 / 100")
+    set(${variable} "${whole}.${tenths} ms" PARENT_SCOPE)
+endfunction()
+
+file(GLOB programs ${BENCHMARKS}/*.sr)
+list(SORT programs)
+foreach (program IN LISTS programs)
+    get_filename_component(name ${program} NAME_WE)
+    set(line "${name}")
+    set(expected_output)
+    set(times)
+
+    foreach (level IN LISTS levels)
+        set(directory ${WORK}/${name}${level})
+        file(REMOVE_RECURSE ${directory})
+        file(MAKE_DIRECTORY ${directory})
+        file(COPY ${program} DESTINATION ${directory})
+
+        execute_process(COMMAND ${CMAKE_COMMAND} -E env --unset=STRIDE_CACHE_DIR --unset=STRIDE_PATH CC=${CC}
+                                ${STRIDE} ${level} ${name}.sr
+                        WORKING_DIRECTORY ${directory}
+                        RESULT_VARIABLE result
+                        OUTPUT_VARIABLE output
+                        ERROR_VARIABLE output)
+        if (NOT result EQUAL 0)
+            message(FATAL_ERROR "Compiling ${name} at ${level} failed:\n${output}")
+        endif ()
+        execute_process(COMMAND ${CC} ${name}.o ${RUNTIME} -lm -o ${name}
+                        WORKING_DIRECTORY ${directory}
+                        RESULT_VARIABLE result
+                        OUTPUT_VARIABLE output
+                        ERROR_VARIABLE output)
+        if (NOT result EQUAL 0)
+            message(FATAL_ERROR "Linking ${name} at ${level} failed:\n${output}")
+        endif ()
+
+        # The fastest run is the least disturbed by the rest of the system.
+        set(fastest)
+        foreach (repetition RANGE 1 ${REPETITIONS})
+            now(start)
+            execute_process(COMMAND ${directory}/${name}
+                            WORKING_DIRECTORY ${directory}
+                            RESULT_VARIABLE result
+                            OUTPUT_VARIABLE output
+                            ERROR_VARIABLE output)
+            now(end)
+            if (NOT result EQUAL 0)
+                message(FATAL_ERROR "${name} exited with ${result} at ${level}:\n${output}")
+            endif ()
+            if (NOT DEFINED expected_output)
+                set(expected_output "${output}")
+            elseif (NOT output STREQUAL expected_output)
+                message(FATAL_ERROR "${name} printed different output at ${level}:\n${output}\n"
+                                    "rather than:\n${expected_output}")
+            endif ()
+            math(EXPR duration "${end} - ${start}")
+            if (NOT fastest OR duration LESS fastest)
+                set(fastest ${duration})
+            endif ()
+        endforeach ()
+
+        list(APPEND times ${fastest})
+        milliseconds(formatted ${fastest})
+        string(APPEND line "  ${level} ${formatted}")
+    endforeach ()
+
+    # The speedup of -O2 over -O0, in hundredths.
+    list(GET times 0 unoptimized)
+    list(GET times 1 optimized)
+    if (optimized EQUAL 0)
+        set(optimized 1)
+    endif ()
+    math(EXPR speedup "${unoptimized} * 100 / ${optimized}")
+    math(EXPR whole "${speedup} / 100")
+    math(EXPR fraction "${speedup} % 100")
+    if (fraction LESS 10)
+        set(fraction "0${fraction}")
+    endif ()
+    message(STATUS "${line}  speedup ${whole}.${fraction}x")
+endforeach ()
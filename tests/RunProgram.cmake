@@ -0,0 +1,149 @@
+#
+# Created by Luca Warmenhoven on 18/10/2026.
+#
+# Compiles and runs a regression program, and checks it against the directives
+# in its comments. Every directive is a line of its own:
+#
+#   // MODE: <mode>      How the program is run; may be given more than once.
+#                        'interpret' runs it with --interpret, which is the default.
+#                        'native' compiles it to an object file and links it with the runtime.
+#                        'c' does the same with --backend=c.
+#                        'check' only compiles it, and checks the output of the compiler.
+#   // FLAGS: <flags>    Compiler flags for every mode.
+#   // EXIT: <code>      The exit code of the program, 0 if not given.
+#   // OUTPUT: <text>    Text the program prints, after the text of the previous OUTPUT.
+#                        In 'check' mode, this is text the compiler prints instead.
+#   // ERROR: <text>     A diagnostic the compiler reports; compiling must fail.
+#   // WARNING: <text>   A diagnostic the compiler reports; compiling must succeed.
+#   // REJECT: <text>    Text the compiler must not print, e.g. a diagnostic that's reported twice.
+#
+# Programs named main.sr are copied along with the other files in their directory, which they import.
+#
+# Usage: cmake -DSTRIDE=<compiler> -DCC=<C compiler> [-DRUNTIME=<runtime library>]
+#              -DPROGRAM=<program> -DWORK=<scratch directory> -P RunProgram.cmake
+#
+cmake_minimum_required(VERSION 3.20)
+
+set(modes)
+set(flags)
+set(exit_code 0)
+set(outputs)
+set(errors)
+set(warnings)
+set(rejected)
+
+file(STRINGS ${PROGRAM} directives REGEX "^// [A-Z]+:")
+foreach (directive IN LISTS directives)
+    string(REGEX MATCH "^// ([A-Z]+): ?(.*)$" matched "${directive}")
+    set(value "${CMAKE_MATCH_2}")
+    if (CMAKE_MATCH_1 STREQUAL "MODE")
+        list(APPEND modes ${value})
+    elseif (CMAKE_MATCH_1 STREQUAL "FLAGS")
+        separate_arguments(value UNIX_COMMAND "${value}")
+        list(APPEND flags ${value})
+    elseif (CMAKE_MATCH_1 STREQUAL "EXIT")
+        set(exit_code ${value})
+    elseif (CMAKE_MATCH_1 STREQUAL "OUTPUT")
+        list(APPEND outputs "${value}")
+    elseif (CMAKE_MATCH_1 STREQUAL "ERROR")
+        list(APPEND errors "${value}")
+    elseif (CMAKE_MATCH_1 STREQUAL "WARNING")
+        list(APPEND warnings "${value}")
+    elseif (CMAKE_MATCH_1 STREQUAL "REJECT")
+        list(APPEND rejected "${value}")
+    endif ()
+endforeach ()
+if (NOT modes)
+    set(modes interpret)
+endif ()
+
+# Checks that every text of a list occurs in the output, each after the previous one.
+function(expect_in_order output list description)
+    set(position 0)
+    foreach (expected IN LISTS ${list})
+        string(SUBSTRING "${output}" ${position} -1 rest)
+        string(FIND "${rest}" "${expected}" found)
+        if (found EQUAL -1)
+            message(FATAL_ERROR "${description} lacks '${expected}':\n${output}")
+        endif ()
+        string(LENGTH "${expected}" length)
+        math(EXPR position "${position} + ${found} + ${length}")
+    endforeach ()
+endfunction()
+
+function(expect_absent output list description)
+    foreach (text IN LISTS ${list})
+        string(FIND "${output}" "${text}" found)
+        if (NOT found EQUAL -1)
+            message(FATAL_ERROR "${description} contains '${text}':\n${output}")
+        endif ()
+    endforeach ()
+endfunction()
+
+# Runs a command in the scratch directory, with a clean environment for the compiler.
+function(run result_variable output_variable)
+    execute_process(COMMAND ${CMAKE_COMMAND} -E env --unset=STRIDE_CACHE_DIR --unset=STRIDE_PATH CC=${CC} ${ARGN}
+                    WORKING_DIRECTORY ${WORK}
+                    RESULT_VARIABLE result
+                    OUTPUT_VARIABLE output
+                    ERROR_VARIABLE output)
+    set(${result_variable} "${result}" PARENT_SCOPE)
+    set(${output_variable} "${output}" PARENT_SCOPE)
+endfunction()
+
+get_filename_component(name ${PROGRAM} NAME)
+get_filename_component(directory ${PROGRAM} DIRECTORY)
+if (name STREQUAL "main.sr")
+    file(GLOB sources ${directory}/*.sr)
+else ()
+    set(sources ${PROGRAM})
+endif ()
+
+foreach (mode IN LISTS modes)
+    file(REMOVE_RECURSE ${WORK})
+    file(MAKE_DIRECTORY ${WORK})
+    file(COPY ${sources} DESTINATION ${WORK})
+
+    if (mode STREQUAL "check")
+        run(result output ${STRIDE} ${flags} ${name})
+        if (errors AND result EQUAL 0)
+            message(FATAL_ERROR "Compiling ${name} succeeded, but errors were expected:\n${output}")
+        elseif (NOT errors AND NOT result EQUAL 0)
+            message(FATAL_ERROR "Compiling ${name} failed:\n${output}")
+        endif ()
+        expect_in_order("${output}" errors "The output of the compiler")
+        expect_in_order("${output}" warnings "The output of the compiler")
+        expect_in_order("${output}" outputs "The output of the compiler")
+        expect_absent("${output}" rejected "The output of the compiler")
+        continue()
+    endif ()
+
+    if (mode STREQUAL "interpret")
+        run(result output ${STRIDE} --interpret ${flags} ${name})
+    elseif (mode STREQUAL "native" OR mode STREQUAL "c")
+        set(backend)
+        if (mode STREQUAL "c")
+            set(backend --backend=c)
+        endif ()
+        run(result output ${STRIDE} ${backend} ${flags} ${name})
+        if (NOT result EQUAL 0)
+            message(FATAL_ERROR "Compiling ${name} failed:\n${output}")
+        endif ()
+        expect_absent("${output}" rejected "The output of the compiler")
+
+        file(GLOB objects ${WORK}/*.o)
+        run(result output ${CC} ${objects} ${RUNTIME} -lm -o program)
+        if (NOT result EQUAL 0)
+            message(FATAL_ERROR "Linking ${name} failed:\n${output}")
+        endif ()
+        run(result output ${WORK}/program)
+    else ()
+        message(FATAL_ERROR "Unknown mode '${mode}' in ${name}")
+    endif ()
+
+    if (NOT result EQUAL exit_code)
+        message(FATAL_ERROR "${name} exited with ${result} in ${mode} mode, rather than ${exit_code}:\n${output}")
+    endif ()
+    expect_in_order("${output}" outputs "The output of ${name} in ${mode} mode")
+    expect_absent("${output}" rejected "The output of ${name} in ${mode} mode")
+endforeach ()
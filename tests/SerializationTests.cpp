@@ -0,0 +1,90 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <cstring>
+#include <memory>
+#include "Test.h"
+#include "../src/StrideFile.h"
+#include "../src/syntax_tree/ASTSerializer.h"
+
+using namespace stride::ast;
+
+static const char *source =
+        "define external puts(s: string) -> i32;\n"
+        "define add(a: i32, b: i32) -> i32 {\n"
+        "    let scale: f64 = 2.5;\n"
+        "    puts(\"hello\");\n"
+        "    return a + b * 2;\n"
+        "}\n";
+
+/**
+ * Parses the test source, and serializes its syntax tree.
+ */
+static std::vector<uint8_t> serializeSource(const std::string &name)
+{
+    stride::StrideFile file(stride::test::writeSource(name, source).c_str());
+    Node *root = file.parse();
+    REQUIRE(root != nullptr);
+    return serialization::serialize(*root, 42);
+}
+
+TEST(serialization, roundTrip)
+{
+    std::vector<uint8_t> buffer = serializeSource("round_trip.sr");
+    std::unique_ptr<serialization::ASTView> view(serialization::ASTView::fromBuffer(buffer.data(), buffer.size()));
+    REQUIRE(view != nullptr);
+    EXPECT_EQ(view->header().sourceHash, 42u);
+    EXPECT(view->nodeCount() > 1);
+
+    // Materializing the tree and serializing it again must reproduce the same bytes.
+    std::unique_ptr<Node> root(serialization::materialize(*view));
+    REQUIRE(root != nullptr);
+    std::vector<uint8_t> again = serialization::serialize(*root, 42);
+    EXPECT(again == buffer);
+}
+
+TEST(serialization, rejectsInvalidHeaders)
+{
+    std::vector<uint8_t> buffer = serializeSource("invalid_header.sr");
+
+    std::vector<uint8_t> truncated(buffer.begin(), buffer.begin() + (long) ( buffer.size() / 2 ));
+    EXPECT(serialization::ASTView::fromBuffer(truncated.data(), truncated.size()) == nullptr);
+
+    std::vector<uint8_t> wrongVersion = buffer;
+    reinterpret_cast<ast_file_header_t *>(wrongVersion.data())->version++;
+    EXPECT(serialization::ASTView::fromBuffer(wrongVersion.data(), wrongVersion.size()) == nullptr);
+
+    std::vector<uint8_t> wrongMagic = buffer;
+    wrongMagic[ 0 ] = 'X';
+    EXPECT(serialization::ASTView::fromBuffer(wrongMagic.data(), wrongMagic.size()) == nullptr);
+}
+
+TEST(serialization, rejectsInvalidReferences)
+{
+    std::vector<uint8_t> buffer = serializeSource("invalid_reference.sr");
+    auto &header = *reinterpret_cast<ast_file_header_t *>(buffer.data());
+
+    // Every edge points past the last node, so the root can't be materialized.
+    auto edges = reinterpret_cast<uint32_t *>(buffer.data() + header.edgesOffset);
+    for ( uint32_t i = 0; i < header.edgeCount; i++ )
+    {
+        if ( edges[ i ] != AST_NONE )
+        {
+            edges[ i ] = header.nodeCount + 1;
+        }
+    }
+
+    std::unique_ptr<serialization::ASTView> view(serialization::ASTView::fromBuffer(buffer.data(), buffer.size()));
+    REQUIRE(view != nullptr);
+    bool rejected = false;
+    try
+    {
+        delete serialization::materialize(*view);
+    }
+    catch ( const std::exception & )
+    {
+        rejected = true;
+    }
+    EXPECT(rejected);
+}
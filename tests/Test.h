@@ -0,0 +1,89 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#ifndef STRIDE_LANGUAGE_TEST_H
+#define STRIDE_LANGUAGE_TEST_H
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace stride::test
+{
+
+    /**
+     * A test case, registered with the TEST macro before main runs.
+     */
+    struct TestCase
+    {
+        const char *suite;
+        const char *name;
+        void (*run)();
+    };
+
+    /**
+     * Returns all registered test cases, in the order of registration.
+     */
+    std::vector<TestCase> &testCases();
+
+    struct Registration
+    {
+        Registration(const char *suite, const char *name, void (*run)())
+        { testCases().push_back({ suite, name, run }); }
+    };
+
+    /**
+     * Thrown by REQUIRE to abort the running test case.
+     */
+    class TestFailure : public std::runtime_error
+    {
+    public:
+        explicit TestFailure(const std::string &message) : std::runtime_error(message)
+        {}
+    };
+
+    /**
+     * Records a failed expectation of the running test case.
+     */
+    void fail(const std::string &message, const char *file, int line);
+
+    template<typename A, typename B>
+    bool expectEqual(const A &actual, const B &expected, const char *expression, const char *file, int line)
+    {
+        if ( actual == expected )
+        {
+            return true;
+        }
+        std::ostringstream message;
+        message << "Expected " << expression << " to be " << expected << ", but it's " << actual;
+        fail(message.str(), file, line);
+        return false;
+    }
+
+    /**
+     * Writes a source file to the scratch directory of the tests.
+     * @return The path of the file.
+     */
+    std::string writeSource(const std::string &name, const std::string &content);
+}
+
+#define TEST(suite, name) \
+    static void test_##suite##_##name(); \
+    static stride::test::Registration registration_##suite##_##name(#suite, #name, test_##suite##_##name); \
+    static void test_##suite##_##name()
+
+/** Checks a condition, and continues the test case if it doesn't hold. */
+#define EXPECT(condition) \
+    do { if ( !( condition )) stride::test::fail("Expected " #condition, __FILE__, __LINE__); } while ( 0 )
+
+#define EXPECT_EQ(actual, expected) \
+    stride::test::expectEqual((actual), (expected), #actual, __FILE__, __LINE__)
+
+/** Checks a condition, and aborts the test case if it doesn't hold. */
+#define REQUIRE(condition) \
+    do { if ( !( condition )) { stride::test::fail("Required " #condition, __FILE__, __LINE__); \
+         throw stride::test::TestFailure(#condition); }} while ( 0 )
+
+#endif //STRIDE_LANGUAGE_TEST_H
@@ -0,0 +1,80 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include "Test.h"
+
+using namespace stride::test;
+
+/**
+ * Whether the running test case has failed an expectation.
+ */
+static bool failed = false;
+
+std::vector<TestCase> &stride::test::testCases()
+{
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+void stride::test::fail(const std::string &message, const char *file, int line)
+{
+    std::cerr << "    " << file << ":" << line << ": " << message << std::endl;
+    failed = true;
+}
+
+std::string stride::test::writeSource(const std::string &name, const std::string &content)
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "stride_tests";
+    std::filesystem::create_directories(directory);
+    std::filesystem::path path = directory / name;
+    std::ofstream out(path, std::ios::binary);
+    out << content;
+    return path.string();
+}
+
+/**
+ * Runs the test cases of the suites that are provided as arguments, or all of them if there are none.
+ * @return 0 if all of them passed, 1 otherwise.
+ */
+int main(int argc, const char **argv)
+{
+    size_t runCount = 0;
+    size_t failureCount = 0;
+    for ( auto &testCase: testCases())
+    {
+        bool selected = argc < 2;
+        for ( int i = 1; i < argc; i++ )
+        {
+            selected |= std::strcmp(argv[ i ], testCase.suite) == 0;
+        }
+        if ( !selected )
+        {
+            continue;
+        }
+
+        failed = false;
+        try
+        {
+            testCase.run();
+        }
+        catch ( const TestFailure & )
+        {
+            // The failure is already reported.
+        }
+        catch ( const std::exception &exception )
+        {
+            fail(std::string("Unexpected exception: ") + exception.what(), testCase.name, 0);
+        }
+        runCount++;
+        failureCount += failed ? 1 : 0;
+        std::cout << ( failed ? "[FAIL] " : "[ OK ] " ) << testCase.suite << "." << testCase.name << std::endl;
+    }
+
+    std::cout << runCount - failureCount << " of " << runCount << " test cases passed." << std::endl;
+    return failureCount == 0 && runCount > 0 ? 0 : 1;
+}
@@ -0,0 +1,69 @@
+//
+// Created by Luca Warmenhoven on 18/10/2026.
+//
+
+#include <cstdlib>
+#include "Test.h"
+#include "../src/StrideFile.h"
+#include "../src/tokens/TokenTraits.h"
+#include "../src/tokens/tokenizer.h"
+
+/**
+ * Tokenizes a source, and returns the types of its tokens.
+ * The source is terminated with a newline, as source files are.
+ */
+static std::vector<token_type_t> tokenTypes(const std::string &source)
+{
+    stride::StrideFile file(stride::test::writeSource("tokens.sr", source + "\n").c_str());
+    std::vector<token_t> *tokens = stride::tokenizeRange(&file, 0, (int) file.getContent().size());
+    std::vector<token_type_t> types;
+    for ( auto &token: *tokens )
+    {
+        types.push_back(token.type);
+        free(token.value);
+    }
+    delete tokens;
+    return types;
+}
+
+TEST(tokens, keywordsAreWholeWords)
+{
+    auto types = tokenTypes("letter let lets");
+    REQUIRE(types.size() == 3);
+    EXPECT_EQ(types[ 0 ], TOKEN_IDENTIFIER);
+    EXPECT_EQ(types[ 1 ], TOKEN_KEYWORD_LET);
+    EXPECT_EQ(types[ 2 ], TOKEN_IDENTIFIER);
+}
+
+TEST(tokens, operatorPrecedence)
+{
+    auto types = tokenTypes("a % b * c + d < e && f = g");
+    REQUIRE(types.size() == 13);
+
+    // '%' ranks with '*', which binds tighter than '+', which binds tighter than comparisons.
+    EXPECT_EQ(token_precedence(types[ 1 ]), token_precedence(types[ 3 ]));
+    EXPECT(token_precedence(types[ 3 ]) > token_precedence(types[ 5 ]));
+    EXPECT(token_precedence(types[ 5 ]) > token_precedence(types[ 7 ]));
+
+    // Logical operators bind looser than comparisons, and assignments are the loosest, grouping right.
+    EXPECT(token_precedence(types[ 7 ]) > token_precedence(types[ 9 ]));
+    EXPECT(token_precedence(types[ 9 ]) > token_precedence(types[ 11 ]));
+    EXPECT_EQ(token_associativity(types[ 11 ]), ASSOCIATIVITY_RIGHT);
+    EXPECT_EQ(token_associativity(types[ 5 ]), ASSOCIATIVITY_LEFT);
+    EXPECT(token_has_trait(types[ 11 ], TOKEN_TRAIT_ASSIGNMENT));
+    EXPECT(!token_has_trait(types[ 7 ], TOKEN_TRAIT_ASSIGNMENT));
+}
+
+TEST(tokens, primitiveSizes)
+{
+    auto types = tokenTypes("i8 u16 i32 u64 f32 f64 bool");
+    REQUIRE(types.size() == 7);
+    unsigned int sizes[] = { 1, 2, 4, 8, 4, 8, 1 };
+    for ( size_t i = 0; i < types.size(); i++ )
+    {
+        EXPECT(token_is_primitive(types[ i ]));
+        EXPECT_EQ(token_byte_size(types[ i ]), sizes[ i ]);
+    }
+    EXPECT(token_has_trait(types[ 2 ], TOKEN_TRAIT_INTEGER));
+    EXPECT(token_has_trait(types[ 5 ], TOKEN_TRAIT_FLOAT));
+}